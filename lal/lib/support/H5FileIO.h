@@ -156,6 +156,13 @@ int XLALH5DatasetQueryNDim(LALH5Dataset *dset);
 UINT4Vector * XLALH5DatasetQueryDims(LALH5Dataset *dset);
 int XLALH5DatasetQueryData(void *data, LALH5Dataset *dset);
 
+LALH5Dataset * XLALH5DatasetAllocChunked(LALH5File *file, const char *name, LALTYPECODE dtype, UINT4Vector *dimLength, UINT4Vector *chunkLength, int deflate, int shuffle);
+LALH5Dataset * XLALH5DatasetReadCached(LALH5File *file, const char *name, size_t cacheBytes, size_t cacheSlots);
+int XLALH5DatasetExtend(LALH5Dataset *dset, size_t length);
+int XLALH5DatasetWriteHyperslab(LALH5Dataset *dset, const UINT4Vector *start, const UINT4Vector *count, const void *data);
+int XLALH5DatasetAppend(LALH5Dataset *dset, const void *data, size_t nrows);
+int XLALH5DatasetQueryHyperslab(void *data, LALH5Dataset *dset, const UINT4Vector *start, const UINT4Vector *count);
+
 /* these routines are deprecated */
 int XLALH5DatasetAddScalarAttribute(LALH5Dataset *dset, const char *key, const void *value, LALTYPECODE dtype);
 int XLALH5DatasetAddStringAttribute(LALH5Dataset *dset, const char *key, const char *value);
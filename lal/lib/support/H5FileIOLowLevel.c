@@ -335,6 +335,125 @@ static LALH5File * XLALH5FileOpenRead(const char *path)
 	return file;
 }
 
+/* opens an existing dataset for reading with dataset access property list dapl_id */
+static LALH5Dataset * XLALH5DatasetOpenRead(LALH5File *file, const char *name, hid_t dapl_id)
+{
+	hid_t dtype_id;
+	LALH5Dataset *dset;
+	size_t namelen;
+	if (name == NULL || file == NULL)
+		XLAL_ERROR_NULL(XLAL_EFAULT);
+	if (file->mode != LAL_H5_FILE_MODE_READ)
+		XLAL_ERROR_NULL(XLAL_EINVAL, "Attempting to read a write-only HDF5 file");
+
+	namelen = strlen(name);
+	dset = LALCalloc(1, sizeof(*dset) + namelen + 1);  /* use flexible array member to record name */
+	if (!dset)
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+
+	dset->dataset_id = threadsafe_H5Dopen2(file->file_id, name, dapl_id);
+	if (dset->dataset_id < 0) {
+		LALFree(dset);
+		XLAL_ERROR_NULL(XLAL_EIO, "Could not read dataset `%s'", name);
+	}
+
+	dset->space_id = threadsafe_H5Dget_space(dset->dataset_id);
+	if (dset->space_id < 0) {
+		LALFree(dset);
+		XLAL_ERROR_NULL(XLAL_EIO, "Could not read dataspace of dataset `%s'", name);
+	}
+
+	dtype_id = threadsafe_H5Dget_type(dset->dataset_id);
+	if (dtype_id < 0) {
+		threadsafe_H5Sclose(dset->space_id);
+		LALFree(dset);
+		XLAL_ERROR_NULL(XLAL_EIO, "Could not read datatype of dataset `%s'", name);
+	}
+
+	/* convert type to native type */
+	dset->dtype_id = threadsafe_H5Tget_native_type(dtype_id, H5T_DIR_ASCEND);
+	threadsafe_H5Tclose(dtype_id);
+	if (dset->dtype_id < 0) {
+		threadsafe_H5Sclose(dset->space_id);
+		LALFree(dset);
+		XLAL_ERROR_NULL(XLAL_EIO, "Could not get native type for dataset `%s'", name);
+	}
+
+	/* record name of dataset and parent id */
+	snprintf(dset->name, namelen + 1, "%s", name);
+	dset->parent_id = file->file_id;
+	return dset;
+}
+
+/*
+ * gets a copy of the file dataspace of a dataset with a hyperslab
+ * selected with offset start and extent count in each dimension;
+ * also creates a simple memory dataspace of extent count;
+ * use H5Sclose() to free both dataspaces
+ */
+static hid_t XLALH5DatasetSelectHyperslab(hid_t *mspace_id, const LALH5Dataset *dset, const UINT4Vector *start, const UINT4Vector *count)
+{
+	hsize_t *offset;
+	hsize_t *extent;
+	hsize_t *dims;
+	hid_t fspace_id;
+	int rank;
+	int dim;
+
+	fspace_id = threadsafe_H5Dget_space(dset->dataset_id);
+	if (fspace_id < 0)
+		XLAL_ERROR(XLAL_EIO, "Could not read dataspace of dataset `%s'", dset->name);
+
+	rank = threadsafe_H5Sget_simple_extent_ndims(fspace_id);
+	if (rank < 0) {
+		threadsafe_H5Sclose(fspace_id);
+		XLAL_ERROR(XLAL_EIO, "Could not read rank of dataset `%s'", dset->name);
+	}
+	if (start->length != (UINT4)rank || count->length != (UINT4)rank) {
+		threadsafe_H5Sclose(fspace_id);
+		XLAL_ERROR(XLAL_EBADLEN, "Hyperslab rank does not match rank %d of dataset `%s'", rank, dset->name);
+	}
+
+	offset = LALCalloc(3 * rank, sizeof(*offset));
+	if (!offset) {
+		threadsafe_H5Sclose(fspace_id);
+		XLAL_ERROR(XLAL_ENOMEM);
+	}
+	extent = offset + rank;
+	dims = extent + rank;
+
+	if (threadsafe_H5Sget_simple_extent_dims(fspace_id, dims, NULL) < 0) {
+		LALFree(offset);
+		threadsafe_H5Sclose(fspace_id);
+		XLAL_ERROR(XLAL_EIO, "Could not read dimensions of dataset `%s'", dset->name);
+	}
+
+	for (dim = 0; dim < rank; ++dim) {
+		offset[dim] = start->data[dim];
+		extent[dim] = count->data[dim];
+		if (offset[dim] + extent[dim] > dims[dim]) {
+			LALFree(offset);
+			threadsafe_H5Sclose(fspace_id);
+			XLAL_ERROR(XLAL_EDOM, "Hyperslab exceeds dimension %d of dataset `%s'", dim, dset->name);
+		}
+	}
+
+	if (threadsafe_H5Sselect_hyperslab(fspace_id, H5S_SELECT_SET, offset, NULL, extent, NULL) < 0) {
+		LALFree(offset);
+		threadsafe_H5Sclose(fspace_id);
+		XLAL_ERROR(XLAL_EIO, "Could not select hyperslab of dataset `%s'", dset->name);
+	}
+
+	*mspace_id = threadsafe_H5Screate_simple(rank, extent, NULL);
+	LALFree(offset);
+	if (*mspace_id < 0) {
+		threadsafe_H5Sclose(fspace_id);
+		XLAL_ERROR(XLAL_EIO, "Could not create memory dataspace for hyperslab");
+	}
+
+	return fspace_id;
+}
+
 #if 0
 static hid_t XLALGetObjectIdentifier(const void *ptr)
 {
@@ -1127,50 +1246,10 @@ LALH5Dataset * XLALH5DatasetRead(LALH5File UNUSED *file, const char UNUSED *name
 #ifndef HAVE_HDF5
 	XLAL_ERROR_NULL(XLAL_EFAILED, "HDF5 support not implemented");
 #else
-	hid_t dtype_id;
 	LALH5Dataset *dset;
-	size_t namelen;
-	if (name == NULL || file == NULL)
-		XLAL_ERROR_NULL(XLAL_EFAULT);
-	if (file->mode != LAL_H5_FILE_MODE_READ)
-		XLAL_ERROR_NULL(XLAL_EINVAL, "Attempting to read a write-only HDF5 file");
-
-	namelen = strlen(name);
-	dset = LALCalloc(1, sizeof(*dset) + namelen + 1);  /* use flexible array member to record name */
+	dset = XLALH5DatasetOpenRead(file, name, H5P_DEFAULT);
 	if (!dset)
-		XLAL_ERROR_NULL(XLAL_ENOMEM);
-
-	dset->dataset_id = threadsafe_H5Dopen2(file->file_id, name, H5P_DEFAULT);
-	if (dset->dataset_id < 0) {
-		LALFree(dset);
-		XLAL_ERROR_NULL(XLAL_EIO, "Could not read dataset `%s'", name);
-	}
-
-	dset->space_id = threadsafe_H5Dget_space(dset->dataset_id);
-	if (dset->space_id < 0) {
-		LALFree(dset);
-		XLAL_ERROR_NULL(XLAL_EIO, "Could not read dataspace of dataset `%s'", name);
-	}
-
-	dtype_id = threadsafe_H5Dget_type(dset->dataset_id);
-	if (dtype_id < 0) {
-		threadsafe_H5Sclose(dset->space_id);
-		LALFree(dset);
-		XLAL_ERROR_NULL(XLAL_EIO, "Could not read datatype of dataset `%s'", name);
-	}
-
-	/* convert type to native type */
-	dset->dtype_id = threadsafe_H5Tget_native_type(dtype_id, H5T_DIR_ASCEND);
-	threadsafe_H5Tclose(dtype_id);
-	if (dset->dtype_id < 0) {
-		threadsafe_H5Sclose(dset->space_id);
-		LALFree(dset);
-		XLAL_ERROR_NULL(XLAL_EIO, "Could not get native type for dataset `%s'", name);
-	}
-
-	/* record name of dataset and parent id */
-	snprintf(dset->name, namelen + 1, "%s", name);
-	dset->parent_id = file->file_id;
+		XLAL_ERROR_NULL(XLAL_EFUNC);
 	return dset;
 #endif
 }
@@ -1343,6 +1422,413 @@ int XLALH5DatasetQueryData(void UNUSED *data, LALH5Dataset UNUSED *dset)
 
 /** @} */
 
+/**
+ * @name Partial and Chunked Dataset Routines
+ * @anchor partial_dataset_routines
+ * @details
+ * These routines allow for reading or writing portions (hyperslabs)
+ * of a ::LALH5Dataset, and for creating chunked datasets that can be
+ * compressed and extended along their first dimension.  This is useful
+ * for large datasets, e.g. tabulated waveform models, of which only
+ * a small block is required, or for output which is accumulated
+ * incrementally, e.g. posterior samples or checkpoints.
+ *
+ * A hyperslab is specified by the offset @p start of its first point
+ * in each dimension and its extent @p count in each dimension; the
+ * data buffer is a contiguous row-major block of the hyperslab.
+ * @code
+ * LALH5File *file = XLALH5FileOpen("example.h5", "w");
+ * UINT4Vector *dims = XLALCreateUINT4Vector(2);
+ * UINT4Vector *chunk = XLALCreateUINT4Vector(2);
+ * dims->data[0] = 0; dims->data[1] = 3;
+ * chunk->data[0] = 1024; chunk->data[1] = 3;
+ * LALH5Dataset *dset = XLALH5DatasetAllocChunked(file, "samples", LAL_D_TYPE_CODE, dims, chunk, 6, 1);
+ * ...
+ * // append nrows rows of 3 REAL8 values each
+ * XLALH5DatasetAppend(dset, rows, nrows);
+ * ...
+ * XLALH5DatasetFree(dset);
+ * XLALH5FileClose(file);
+ * @endcode
+ * @{
+ */
+
+/**
+ * @brief Allocates a chunked, optionally compressed, extendible ::LALH5Dataset
+ * @details
+ * Creates a new HDF5 dataset with name @p name within a HDF5 file
+ * associated with the ::LALH5File @p file structure and allocates a
+ * ::LALH5Dataset structure associated with the dataset.  The dataset
+ * is stored in chunks with dimensions given by the UINT4Vector
+ * @p chunkLength, which must have the same length as the UINT4Vector
+ * @p dimLength giving the initial dimensions of the dataset.
+ *
+ * The first dimension of the dataset is unlimited: the dataset can be
+ * grown along this dimension with XLALH5DatasetExtend() or
+ * XLALH5DatasetAppend().  The initial length of the first dimension
+ * may be zero.  The remaining dimensions are fixed.
+ *
+ * If @p deflate is between 1 and 9 the chunks are compressed with the
+ * gzip (deflate) filter at that compression level; a value of 0
+ * disables compression.  If @p shuffle is non-zero the byte shuffle
+ * filter is applied before compression, which usually improves the
+ * compression ratio of floating-point data.
+ *
+ * The ::LALH5File @p file passed to this routine must be a file
+ * opened for writing.
+ *
+ * @param file Pointer to a ::LALH5File structure in which to create the dataset.
+ * @param name Pointer to a string with the name of the dataset to create.
+ * @param dtype \c LALTYPECODE value specifying the data type.
+ * @param dimLength Pointer to a UINT4Vector specifying the initial
+ * dataspace dimensions.
+ * @param chunkLength Pointer to a UINT4Vector specifying the chunk
+ * dimensions.
+ * @param deflate Compression level 0 (no compression) to 9.
+ * @param shuffle Non-zero to apply the shuffle filter.
+ * @returns A pointer to a ::LALH5Dataset structure associated with the
+ * specified dataset within a HDF5 file.
+ * @retval NULL An error occurred creating the dataset.
+ */
+LALH5Dataset * XLALH5DatasetAllocChunked(LALH5File UNUSED *file, const char UNUSED *name, LALTYPECODE UNUSED dtype, UINT4Vector UNUSED *dimLength, UINT4Vector UNUSED *chunkLength, int UNUSED deflate, int UNUSED shuffle)
+{
+#ifndef HAVE_HDF5
+	XLAL_ERROR_NULL(XLAL_EFAILED, "HDF5 support not implemented");
+#else
+	LALH5Dataset *dset;
+	hsize_t *dims;
+	hsize_t *maxdims;
+	hsize_t *chunk;
+	hid_t dcpl_id;
+	UINT4 dim;
+	size_t namelen;
+
+	if (name == NULL || file == NULL || dimLength == NULL || chunkLength == NULL)
+		XLAL_ERROR_NULL(XLAL_EFAULT);
+	if (file->mode != LAL_H5_FILE_MODE_WRITE)
+		XLAL_ERROR_NULL(XLAL_EINVAL, "Attempting to write to a read-only HDF5 file");
+	if (dimLength->length == 0 || chunkLength->length != dimLength->length)
+		XLAL_ERROR_NULL(XLAL_EBADLEN, "Chunk rank must equal dataset rank");
+	if (deflate < 0 || deflate > 9)
+		XLAL_ERROR_NULL(XLAL_EINVAL, "Invalid compression level %d: must be between 0 and 9", deflate);
+	for (dim = 0; dim < chunkLength->length; ++dim)
+		if (chunkLength->data[dim] == 0)
+			XLAL_ERROR_NULL(XLAL_EINVAL, "Chunk dimensions must be positive");
+	if (deflate > 0 && threadsafe_H5Zfilter_avail(H5Z_FILTER_DEFLATE) <= 0)
+		XLAL_ERROR_NULL(XLAL_EFAILED, "HDF5 deflate filter not available");
+
+	namelen = strlen(name);
+	dset = LALCalloc(1, sizeof(*dset) + namelen + 1);  /* use flexible array member to record name */
+	if (!dset)
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+
+	/* create datatype */
+	dset->dtype_id = XLALH5TypeFromLALType(dtype);
+	if (dset->dtype_id < 0) {
+		LALFree(dset);
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	}
+
+	/* copy dimensions to HDF5 type; first dimension is unlimited */
+	dims = LALCalloc(3 * dimLength->length, sizeof(*dims));
+	if (!dims) {
+		threadsafe_H5Tclose(dset->dtype_id);
+		LALFree(dset);
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	}
+	maxdims = dims + dimLength->length;
+	chunk = maxdims + dimLength->length;
+	for (dim = 0; dim < dimLength->length; ++dim) {
+		dims[dim] = dimLength->data[dim];
+		maxdims[dim] = dim == 0 ? H5S_UNLIMITED : dims[dim];
+		chunk[dim] = chunkLength->data[dim];
+		if (dim > 0 && chunk[dim] > dims[dim])
+			chunk[dim] = dims[dim] > 0 ? dims[dim] : 1;
+	}
+
+	/* create dataset creation property list */
+	dcpl_id = threadsafe_H5Pcreate(H5P_DATASET_CREATE);
+	if (dcpl_id < 0 || threadsafe_H5Pset_chunk(dcpl_id, dimLength->length, chunk) < 0
+		|| (shuffle && threadsafe_H5Pset_shuffle(dcpl_id) < 0)
+		|| (deflate > 0 && threadsafe_H5Pset_deflate(dcpl_id, deflate) < 0)) {
+		if (dcpl_id >= 0)
+			threadsafe_H5Pclose(dcpl_id);
+		LALFree(dims);
+		threadsafe_H5Tclose(dset->dtype_id);
+		LALFree(dset);
+		XLAL_ERROR_NULL(XLAL_EIO, "Could not create chunked dataset properties for dataset `%s'", name);
+	}
+
+	/* create dataspace */
+	dset->space_id = threadsafe_H5Screate_simple(dimLength->length, dims, maxdims);
+	LALFree(dims);
+	if (dset->space_id < 0) {
+		threadsafe_H5Pclose(dcpl_id);
+		threadsafe_H5Tclose(dset->dtype_id);
+		LALFree(dset);
+		XLAL_ERROR_NULL(XLAL_EIO, "Could not create dataspace for dataset `%s'", name);
+	}
+
+	/* create dataset */
+	dset->dataset_id = threadsafe_H5Dcreate2(file->file_id, name, dset->dtype_id, dset->space_id, H5P_DEFAULT, dcpl_id, H5P_DEFAULT);
+	threadsafe_H5Pclose(dcpl_id);
+	if (dset->dataset_id < 0) {
+		threadsafe_H5Tclose(dset->dtype_id);
+		threadsafe_H5Sclose(dset->space_id);
+		LALFree(dset);
+		XLAL_ERROR_NULL(XLAL_EIO, "Could not create dataset `%s'", name);
+	}
+
+	/* record name of dataset and parent id */
+	snprintf(dset->name, namelen + 1, "%s", name);
+	dset->parent_id = file->file_id;
+
+	return dset;
+#endif
+}
+
+/**
+ * @brief Reads a ::LALH5Dataset with a specified chunk cache
+ * @details
+ * This routine is the same as XLALH5DatasetRead() except that the
+ * chunk cache used by the HDF5 library for this dataset is set to
+ * hold @p cacheBytes bytes in @p cacheSlots hash table slots.
+ * A large cache avoids repeatedly decompressing chunks when a chunked
+ * dataset is read in many small hyperslabs with
+ * XLALH5DatasetQueryHyperslab().  For best performance @p cacheSlots
+ * should be a prime number about 100 times larger than the number of
+ * chunks that fit into @p cacheBytes.  If either value is zero then
+ * the HDF5 library default is used for it.
+ *
+ * @param file Pointer to a ::LALH5File structure containing the dataset
+ * to be opened.
+ * @param name Pointer to a string with the name of the dataset to open.
+ * @param cacheBytes Size of the chunk cache in bytes.
+ * @param cacheSlots Number of slots in the chunk cache hash table.
+ * @returns A pointer to a ::LALH5Dataset structure associated with the
+ * specified dataset within a HDF5 file.
+ * @retval NULL An error occurred opening the dataset.
+ */
+LALH5Dataset * XLALH5DatasetReadCached(LALH5File UNUSED *file, const char UNUSED *name, size_t UNUSED cacheBytes, size_t UNUSED cacheSlots)
+{
+#ifndef HAVE_HDF5
+	XLAL_ERROR_NULL(XLAL_EFAILED, "HDF5 support not implemented");
+#else
+	LALH5Dataset *dset;
+	hid_t dapl_id;
+
+	dapl_id = threadsafe_H5Pcreate(H5P_DATASET_ACCESS);
+	if (dapl_id < 0)
+		XLAL_ERROR_NULL(XLAL_EIO, "Could not create dataset access properties");
+	if (threadsafe_H5Pset_chunk_cache(dapl_id, cacheSlots > 0 ? cacheSlots : H5D_CHUNK_CACHE_NSLOTS_DEFAULT, cacheBytes > 0 ? cacheBytes : H5D_CHUNK_CACHE_NBYTES_DEFAULT, H5D_CHUNK_CACHE_W0_DEFAULT) < 0) {
+		threadsafe_H5Pclose(dapl_id);
+		XLAL_ERROR_NULL(XLAL_EIO, "Could not set chunk cache properties");
+	}
+
+	dset = XLALH5DatasetOpenRead(file, name, dapl_id);
+	threadsafe_H5Pclose(dapl_id);
+	if (!dset)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	return dset;
+#endif
+}
+
+/**
+ * @brief Changes the length of the first dimension of a ::LALH5Dataset
+ * @details
+ * Sets the length of the first dimension of a dataset allocated with
+ * XLALH5DatasetAllocChunked() to @p length.  If the dataset grows, the
+ * new points are filled with zeros until written; if it shrinks, the
+ * points beyond @p length are discarded.
+ * @param dset Pointer to a ::LALH5Dataset structure to extend.
+ * @param length New length of the first dimension.
+ * @retval 0 Success.
+ * @retval -1 Failure.
+ */
+int XLALH5DatasetExtend(LALH5Dataset UNUSED *dset, size_t UNUSED length)
+{
+#ifndef HAVE_HDF5
+	XLAL_ERROR(XLAL_EFAILED, "HDF5 support not implemented");
+#else
+	hsize_t *dims;
+	hid_t space_id;
+	int rank;
+
+	if (dset == NULL)
+		XLAL_ERROR(XLAL_EFAULT);
+
+	rank = XLALH5DatasetQueryNDim(dset);
+	if (rank < 1)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	dims = LALCalloc(rank, sizeof(*dims));
+	if (!dims)
+		XLAL_ERROR(XLAL_ENOMEM);
+	if (threadsafe_H5Sget_simple_extent_dims(dset->space_id, dims, NULL) < 0) {
+		LALFree(dims);
+		XLAL_ERROR(XLAL_EIO, "Could not read dimensions of dataspace");
+	}
+
+	dims[0] = length;
+	if (threadsafe_H5Dset_extent(dset->dataset_id, dims) < 0) {
+		LALFree(dims);
+		XLAL_ERROR(XLAL_EIO, "Could not extend dataset `%s'; was it allocated with XLALH5DatasetAllocChunked()?", dset->name);
+	}
+	LALFree(dims);
+
+	/* refresh the dataspace to reflect the new extent */
+	space_id = threadsafe_H5Dget_space(dset->dataset_id);
+	if (space_id < 0)
+		XLAL_ERROR(XLAL_EIO, "Could not read dataspace of dataset `%s'", dset->name);
+	threadsafe_H5Sclose(dset->space_id);
+	dset->space_id = space_id;
+
+	return 0;
+#endif
+}
+
+/**
+ * @brief Writes data to a hyperslab of a ::LALH5Dataset
+ * @details
+ * Writes the data contained in @p data to the hyperslab of the HDF5
+ * dataset associated with the ::LALH5Dataset @p dset structure
+ * that starts at offsets @p start and has extents @p count in each
+ * dimension.  The hyperslab must lie within the current dimensions
+ * of the dataset.
+ * @param dset Pointer to a ::LALH5Dataset structure to which to write the data.
+ * @param start Pointer to a UINT4Vector with the offset of the hyperslab.
+ * @param count Pointer to a UINT4Vector with the extent of the hyperslab.
+ * @param data Pointer to the data buffer to be written.
+ * @retval 0 Success.
+ * @retval -1 Failure.
+ */
+int XLALH5DatasetWriteHyperslab(LALH5Dataset UNUSED *dset, const UINT4Vector UNUSED *start, const UINT4Vector UNUSED *count, const void UNUSED *data)
+{
+#ifndef HAVE_HDF5
+	XLAL_ERROR(XLAL_EFAILED, "HDF5 support not implemented");
+#else
+	hid_t fspace_id;
+	hid_t mspace_id;
+	herr_t status;
+
+	if (dset == NULL || start == NULL || count == NULL || data == NULL)
+		XLAL_ERROR(XLAL_EFAULT);
+
+	fspace_id = XLALH5DatasetSelectHyperslab(&mspace_id, dset, start, count);
+	if (fspace_id < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	status = threadsafe_H5Dwrite(dset->dataset_id, dset->dtype_id, mspace_id, fspace_id, H5P_DEFAULT, data);
+	threadsafe_H5Sclose(mspace_id);
+	threadsafe_H5Sclose(fspace_id);
+	if (status < 0)
+		XLAL_ERROR(XLAL_EIO, "Could not write hyperslab to dataset `%s'", dset->name);
+
+	return 0;
+#endif
+}
+
+/**
+ * @brief Appends data to a ::LALH5Dataset
+ * @details
+ * Extends the first dimension of a dataset allocated with
+ * XLALH5DatasetAllocChunked() by @p nrows and writes the data
+ * contained in @p data to the new rows.  The buffer @p data
+ * must hold @p nrows times the number of points in the remaining
+ * dimensions of the dataset.
+ * @param dset Pointer to a ::LALH5Dataset structure to which to append the data.
+ * @param data Pointer to the data buffer to be appended.
+ * @param nrows Number of rows (along the first dimension) to append.
+ * @retval 0 Success.
+ * @retval -1 Failure.
+ */
+int XLALH5DatasetAppend(LALH5Dataset UNUSED *dset, const void UNUSED *data, size_t UNUSED nrows)
+{
+#ifndef HAVE_HDF5
+	XLAL_ERROR(XLAL_EFAILED, "HDF5 support not implemented");
+#else
+	UINT4Vector *start;
+	UINT4Vector *count;
+	int retval;
+
+	if (dset == NULL || data == NULL)
+		XLAL_ERROR(XLAL_EFAULT);
+	if (nrows == 0)
+		return 0;
+
+	start = XLALH5DatasetQueryDims(dset);
+	if (start == NULL)
+		XLAL_ERROR(XLAL_EFUNC);
+	count = XLALH5DatasetQueryDims(dset);
+	if (count == NULL) {
+		XLALDestroyUINT4Vector(start);
+		XLAL_ERROR(XLAL_EFUNC);
+	}
+
+	/* new rows start at the current end of the first dimension */
+	if (XLALH5DatasetExtend(dset, start->data[0] + nrows) < 0) {
+		XLALDestroyUINT4Vector(count);
+		XLALDestroyUINT4Vector(start);
+		XLAL_ERROR(XLAL_EFUNC);
+	}
+	memset(start->data + 1, 0, (start->length - 1) * sizeof(*start->data));
+	count->data[0] = nrows;
+
+	retval = XLALH5DatasetWriteHyperslab(dset, start, count, data);
+	XLALDestroyUINT4Vector(count);
+	XLALDestroyUINT4Vector(start);
+	if (retval < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	return 0;
+#endif
+}
+
+/**
+ * @brief Gets the data contained in a hyperslab of a ::LALH5Dataset
+ * @details
+ * This routine reads data from the hyperslab of the HDF5 dataset
+ * associated with the ::LALH5Dataset @p dset that starts at offsets
+ * @p start and has extents @p count in each dimension, and stores
+ * the data in the buffer @p data.  This buffer should be sufficiently
+ * large to hold the product of the elements of @p count times the
+ * size of the datatype.  Only the chunks of the dataset which
+ * intersect the hyperslab are read from the file.
+ * @param data Pointer to a memory in which to store the data.
+ * @param dset Pointer to a ::LALH5Dataset from which to extract the data.
+ * @param start Pointer to a UINT4Vector with the offset of the hyperslab.
+ * @param count Pointer to a UINT4Vector with the extent of the hyperslab.
+ * @retval 0 Success.
+ * @retval -1 Failure.
+ */
+int XLALH5DatasetQueryHyperslab(void UNUSED *data, LALH5Dataset UNUSED *dset, const UINT4Vector UNUSED *start, const UINT4Vector UNUSED *count)
+{
+#ifndef HAVE_HDF5
+	XLAL_ERROR(XLAL_EFAILED, "HDF5 support not implemented");
+#else
+	hid_t fspace_id;
+	hid_t mspace_id;
+	herr_t status;
+
+	if (data == NULL || dset == NULL || start == NULL || count == NULL)
+		XLAL_ERROR(XLAL_EFAULT);
+
+	fspace_id = XLALH5DatasetSelectHyperslab(&mspace_id, dset, start, count);
+	if (fspace_id < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	status = threadsafe_H5Dread(dset->dataset_id, dset->dtype_id, mspace_id, fspace_id, H5P_DEFAULT, data);
+	threadsafe_H5Sclose(mspace_id);
+	threadsafe_H5Sclose(fspace_id);
+	if (status < 0)
+		XLAL_ERROR(XLAL_EIO, "Could not read hyperslab from dataset `%s'", dset->name);
+
+	return 0;
+#endif
+}
+
+/** @} */
+
 /**
  * @name Attribute Routines
  * @anchor attribute_routines
@@ -291,6 +291,69 @@ DEFINE_FREQUENCY_SERIES_FUNCTIONS(COMPLEX8FrequencySeries)
 DEFINE_FREQUENCY_SERIES_FUNCTIONS(COMPLEX16FrequencySeries)
 #undef GENERATE_DATA
 
+/* CHUNKED DATASET AND HYPERSLAB ROUTINES */
+
+static void test_ChunkedHyperslab(void)
+{
+	REAL8 orig[DIM0 * DIM1][DIM2];
+	REAL8 copy[DIM1][2];
+	LALH5File *file;
+	LALH5Dataset *dset;
+	UINT4Vector *dims;
+	UINT4Vector *start;
+	UINT4Vector *count;
+	size_t i, j;
+
+	fprintf(stderr, "Testing Append/Hyperslab Read of chunked REAL8 dataset...");
+
+	for (i = 0; i < DIM0 * DIM1; ++i)
+		for (j = 0; j < DIM2; ++j)
+			orig[i][j] = generate_float_data();
+
+	dims = XLALCreateUINT4Vector(2);
+	start = XLALCreateUINT4Vector(2);
+	count = XLALCreateUINT4Vector(2);
+
+	/* write rows in blocks of DIM1 to an initially empty dataset */
+	dims->data[0] = 0;
+	dims->data[1] = DIM2;
+	count->data[0] = 3;
+	count->data[1] = DIM2;
+	file = XLALH5FileOpen(FNAME, "w");
+	dset = XLALH5DatasetAllocChunked(file, DSET, LAL_D_TYPE_CODE, dims, count, 6, 1);
+	for (i = 0; i < DIM0; ++i)
+		XLALH5DatasetAppend(dset, orig[i * DIM1], DIM1);
+	XLALH5DatasetFree(dset);
+	XLALH5FileClose(file);
+
+	/* read back a block of rows and columns */
+	start->data[0] = DIM1 / 2;
+	start->data[1] = 1;
+	count->data[0] = DIM1;
+	count->data[1] = 2;
+	file = XLALH5FileOpen(FNAME, "r");
+	dset = XLALH5DatasetReadCached(file, DSET, 1 << 16, 521);
+	if (XLALH5DatasetQueryNPoints(dset) != DIM0 * DIM1 * DIM2) {
+		fprintf(stderr, " FAIL\n");
+		exit(1); /* fail */
+	}
+	XLALH5DatasetQueryHyperslab(copy, dset, start, count);
+	XLALH5DatasetFree(dset);
+	XLALH5FileClose(file);
+
+	for (i = 0; i < DIM1; ++i)
+		for (j = 0; j < 2; ++j)
+			if (copy[i][j] != orig[start->data[0] + i][start->data[1] + j]) {
+				fprintf(stderr, " FAIL\n");
+				exit(1); /* fail */
+			}
+
+	XLALDestroyUINT4Vector(count);
+	XLALDestroyUINT4Vector(start);
+	XLALDestroyUINT4Vector(dims);
+	fprintf(stderr, " PASS\n");
+}
+
 int main(void)
 {
 	XLALSetErrorHandler(XLALAbortErrorHandler);
@@ -334,6 +397,8 @@ int main(void)
 	test_COMPLEX8FrequencySeries();
 	test_COMPLEX16FrequencySeries();
 
+	test_ChunkedHyperslab();
+
 	LALCheckMemoryLeaks();
 	return 0;
 }
@@ -0,0 +1,131 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*  MA  02110-1301  USA
+*/
+
+/**
+ * \file
+ * \ingroup lalapps_pulsar_Tools
+ * \brief
+ * Convert (gzipped) ASCII Earth, Sun and time correction ephemeris files, as read by
+ * XLALInitBarycenter() and XLALInitTimeCorrections(), into binary ephemeris files.
+ *
+ * Binary ephemeris files can be given to XLALInitBarycenter() and XLALInitTimeCorrections()
+ * in place of the ASCII files. They are memory-mapped rather than parsed, which makes
+ * loading them much faster, and lets all processes on a machine share one copy of the
+ * ephemeris tables in memory. The tables themselves are identical to those read from the
+ * ASCII files, so results of barycentring are unchanged.
+ *
+ * Binary ephemeris files are specific to the byte order of the machine that wrote them.
+ */
+
+/* ---------- includes ---------- */
+#include "config.h"
+
+#include <stdio.h>
+
+#include <lal/LALStdlib.h>
+#include <lal/UserInput.h>
+#include <lal/LALInitBarycenter.h>
+
+#include <LALAppsVCSInfo.h>
+
+/* User variables */
+typedef struct {
+  CHAR *ephemEarth;
+  CHAR *ephemSun;
+  CHAR *timeCorrections;
+  CHAR *outputEarth;
+  CHAR *outputSun;
+  CHAR *outputTimeCorrections;
+} UserVar;
+
+/* ----- local prototypes ----- */
+int initUserVars ( UserVar *uvar );
+
+/*----------------------------------------------------------------------
+ * main function
+ *----------------------------------------------------------------------*/
+int
+main(int argc, char *argv[])
+{
+  /* register all user-variables */
+  UserVar XLAL_INIT_DECL(uvar);
+  XLAL_CHECK_MAIN ( initUserVars ( &uvar ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  /* read cmdline & cfgfile  */
+  BOOLEAN should_exit = 0;
+  XLAL_CHECK_MAIN( XLALUserVarReadAllInput( &should_exit, argc, argv, lalAppsVCSInfoList ) == XLAL_SUCCESS, XLAL_EFUNC );
+  if ( should_exit ) {
+    exit (1);
+  }
+
+  /* check user input */
+  XLAL_CHECK_MAIN ( XLALUserVarWasSet ( &uvar.ephemEarth ) == XLALUserVarWasSet ( &uvar.outputEarth ), XLAL_EINVAL,
+                    "--ephemEarth and --outputEarth must be given together\n" );
+  XLAL_CHECK_MAIN ( XLALUserVarWasSet ( &uvar.ephemSun ) == XLALUserVarWasSet ( &uvar.outputSun ), XLAL_EINVAL,
+                    "--ephemSun and --outputSun must be given together\n" );
+  XLAL_CHECK_MAIN ( XLALUserVarWasSet ( &uvar.ephemEarth ) == XLALUserVarWasSet ( &uvar.ephemSun ), XLAL_EINVAL,
+                    "--ephemEarth and --ephemSun must be given together\n" );
+  XLAL_CHECK_MAIN ( XLALUserVarWasSet ( &uvar.timeCorrections ) == XLALUserVarWasSet ( &uvar.outputTimeCorrections ), XLAL_EINVAL,
+                    "--timeCorrections and --outputTimeCorrections must be given together\n" );
+  XLAL_CHECK_MAIN ( XLALUserVarWasSet ( &uvar.ephemEarth ) || XLALUserVarWasSet ( &uvar.timeCorrections ), XLAL_EINVAL,
+                    "Nothing to convert: give --ephemEarth and --ephemSun, and/or --timeCorrections\n" );
+
+  /* convert Earth and Sun ephemerides */
+  if ( XLALUserVarWasSet ( &uvar.ephemEarth ) ) {
+    EphemerisData *edat;
+    XLAL_CHECK_MAIN ( ( edat = XLALInitBarycenter ( uvar.ephemEarth, uvar.ephemSun ) ) != NULL, XLAL_EFUNC,
+                      "XLALInitBarycenter('%s', '%s') failed\n", uvar.ephemEarth, uvar.ephemSun );
+    XLAL_CHECK_MAIN ( XLALWriteBinaryEphemerisFiles ( edat, uvar.outputEarth, uvar.outputSun ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLALPrintInfo ( "Wrote %d Earth entries to '%s' and %d Sun entries to '%s'\n", edat->nentriesE, uvar.outputEarth, edat->nentriesS, uvar.outputSun );
+    XLALDestroyEphemerisData ( edat );
+  }
+
+  /* convert time corrections */
+  if ( XLALUserVarWasSet ( &uvar.timeCorrections ) ) {
+    TimeCorrectionData *tdat;
+    XLAL_CHECK_MAIN ( ( tdat = XLALInitTimeCorrections ( uvar.timeCorrections ) ) != NULL, XLAL_EFUNC,
+                      "XLALInitTimeCorrections('%s') failed\n", uvar.timeCorrections );
+    XLAL_CHECK_MAIN ( XLALWriteBinaryTimeCorrectionFile ( tdat, uvar.outputTimeCorrections ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLALPrintInfo ( "Wrote %u time corrections to '%s'\n", tdat->nentriesT, uvar.outputTimeCorrections );
+    XLALDestroyTimeCorrectionData ( tdat );
+  }
+
+  /* free memory */
+  XLALDestroyUserVars();
+
+  LALCheckMemoryLeaks();
+
+  return XLAL_SUCCESS;
+
+} /* main */
+
+
+/*----------------------------------------------------------------------*/
+/* register all our "user-variables" */
+int
+initUserVars ( UserVar *uvar )
+{
+  /* now register all our user-variable */
+  XLALRegisterUvarMember( ephemEarth,			STRING, 'E', OPTIONAL, "Input Earth ephemeris file (ASCII, optionally gzipped)");
+  XLALRegisterUvarMember( ephemSun,			STRING, 'S', OPTIONAL, "Input Sun ephemeris file (ASCII, optionally gzipped)");
+  XLALRegisterUvarMember( timeCorrections,		STRING, 'T', OPTIONAL, "Input time correction file (ASCII, optionally gzipped)");
+  XLALRegisterUvarMember( outputEarth,			STRING, 'e', OPTIONAL, "Output binary Earth ephemeris file");
+  XLALRegisterUvarMember( outputSun,			STRING, 's', OPTIONAL, "Output binary Sun ephemeris file");
+  XLALRegisterUvarMember( outputTimeCorrections,	STRING, 't', OPTIONAL, "Output binary time correction file");
+
+  return XLAL_SUCCESS;
+} /* initUserVars() */
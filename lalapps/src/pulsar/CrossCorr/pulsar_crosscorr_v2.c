@@ -102,6 +102,7 @@ typedef struct tagUserInput_t {
   BOOLEAN inclSameDetector;      /**< include cross-correlations of detector with itself */
   BOOLEAN treatWarningsAsErrors; /**< treat any warnings as errors and abort */
   LALStringVector *injectionSources; /**< CSV file list containing sources to inject or '{Alpha=0;Delta=0;...}' */
+  UINT4   numThreads;            /**< number of OpenMP threads over which to distribute SFT pairs */
 } UserInput_t;
 
 /* struct to store useful variables */
@@ -1135,6 +1136,7 @@ int XLALInitUserVars (UserInput_t *uvar)
   uvar->treatWarningsAsErrors = TRUE;
   uvar->testShortFunctions = FALSE;
   uvar->testResampNoTShort = FALSE;
+  uvar->numThreads = 1;
 
   /* register  user-variables */
   XLALRegisterUvarMember( startTime,       INT4, 0,  REQUIRED, "Desired start time of analysis in GPS seconds (SFT timestamps must be >= this)");
@@ -1185,6 +1187,7 @@ int XLALInitUserVars (UserInput_t *uvar)
   XLALRegisterUvarMember( inclSameDetector, BOOLEAN, 0, OPTIONAL, "Cross-correlate a detector with itself at a different time (if inclAutoCorr, then also same time)");
   XLALRegisterUvarMember( treatWarningsAsErrors, BOOLEAN, 0, OPTIONAL, "Abort program if any warnings arise (for e.g., zero-maxLag radiometer mode)");
   XLALRegisterUvarMember( injectionSources, STRINGVector, 0 , OPTIONAL, "CSV file list containing sources to inject or '{Alpha=0;Delta=0;...}'");
+  XLALRegisterUvarMember( numThreads, UINT4, 0, OPTIONAL, "Number of threads over which to distribute SFT pairs (0=use all available threads)");
   if ( xlalErrno ) {
     XLALPrintError ("%s: user variable initialization failed with errno = %d.\n", __func__, xlalErrno );
     XLAL_ERROR ( XLAL_EFUNC );
@@ -1575,6 +1578,13 @@ int demodLoopCrossCorr(MultiSSBtimes *multiBinaryTimes, MultiSSBtimes *multiSSBT
     XLAL_ERROR( XLAL_EFUNC );
   } /*Need to apply additional doppler shifting before the loop, or the first point in parameter space will be lost and return a wrong SNR when fBand!=0*/
 
+  /* flatten the SFT pair list once, for reuse by all templates */
+  CrossCorrPairEngine *pairEngine = NULL;
+  if ( ( XLALCreateCrossCorrPairEngine( &pairEngine, sftPairs, sftIndices, inputSFTs, GammaAve, uvar.numThreads ) != XLAL_SUCCESS ) ) {
+    LogPrintf ( LOG_CRITICAL, "%s: XLALCreateCrossCorrPairEngine() failed with errno=%d\n", __func__, xlalErrno );
+    XLAL_ERROR( XLAL_EFUNC );
+  }
+
   //fprintf(stdout, "Resampling? %s \n", uvar.resamp ? "true" : "false");
 
   while ( GetNextCrossCorrTemplate(&dopplerShiftFlag, &firstPoint, &dopplerpos, &binaryTemplateSpacings, &minBinaryTemplate, &maxBinaryTemplate, &fCount, &aCount, &tCount, &pCount, fSpacingNum, aSpacingNum, tSpacingNum, pSpacingNum) == 0)
@@ -1587,17 +1597,20 @@ int demodLoopCrossCorr(MultiSSBtimes *multiBinaryTimes, MultiSSBtimes *multiSSBT
 	{
 	  if ( (XLALAddMultiBinaryTimes( &multiBinaryTimes, multiSSBTimes, &dopplerpos )  != XLAL_SUCCESS ) ) {
 	    LogPrintf ( LOG_CRITICAL, "%s: XLALAddMultiBinaryTimes() failed with errno=%d\n", __func__, xlalErrno );
+	    XLALDestroyCrossCorrPairEngine( pairEngine );
 	    XLAL_ERROR( XLAL_EFUNC );
 	  }
 	}
 
       if ( (XLALGetDopplerShiftedFrequencyInfo( shiftedFreqs, lowestBins, expSignalPhases, sincList, uvar.numBins, &dopplerpos, sftIndices, inputSFTs, multiBinaryTimes, badBins, Tsft )  != XLAL_SUCCESS ) ) {
 	LogPrintf ( LOG_CRITICAL, "%s: XLALGetDopplerShiftedFrequencyInfo() failed with errno=%d\n", __func__, xlalErrno );
+	XLALDestroyCrossCorrPairEngine( pairEngine );
 	XLAL_ERROR( XLAL_EFUNC );
       }
 
-      if ( (XLALCalculatePulsarCrossCorrStatistic( &ccStat, &evSquared, GammaAve, expSignalPhases, lowestBins, sincList, sftPairs, sftIndices, inputSFTs, multiWeights, uvar.numBins)  != XLAL_SUCCESS ) ) {
-	LogPrintf ( LOG_CRITICAL, "%s: XLALCalculatePulsarCrossCorrStatistic() failed with errno=%d\n", __func__, xlalErrno );
+      if ( (XLALCalculatePulsarCrossCorrStatisticEngine( &ccStat, &evSquared, pairEngine, expSignalPhases, lowestBins, sincList, multiWeights, uvar.numBins)  != XLAL_SUCCESS ) ) {
+	LogPrintf ( LOG_CRITICAL, "%s: XLALCalculatePulsarCrossCorrStatisticEngine() failed with errno=%d\n", __func__, xlalErrno );
+	XLALDestroyCrossCorrPairEngine( pairEngine );
 	XLAL_ERROR( XLAL_EFUNC );
       }
 
@@ -1617,6 +1630,7 @@ int demodLoopCrossCorr(MultiSSBtimes *multiBinaryTimes, MultiSSBtimes *multiSSBT
       //fprintf(stdout,"Inner loop: freq %f , tp %f , asini %f \n", thisCandidate.freq, thisCandidate.tp, thisCandidate.asini);
 
     } /* end while loop over templates */
+    XLALDestroyCrossCorrPairEngine( pairEngine );
     return 0;
 } /* end demodLoopCrossCorr */
 
@@ -1780,19 +1794,28 @@ int resampForLoopCrossCorr(PulsarDopplerParams dopplerpos, BOOLEAN dopplerShiftF
   MultiCOMPLEX8TimeSeries *multiTimeSeries_SRC_a = NULL;
   MultiCOMPLEX8TimeSeries *multiTimeSeries_SRC_b = NULL;
 
+  /* The engine below has its own per-thread Fa/Fb holders, so the
+   * workspace need not allocate those used by
+   * XLALCalculatePulsarCrossCorrStatisticResamp() */
   ResampCrossCorrWorkspace *ws = NULL;
-  COMPLEX8 *ws1KFaX_k = NULL;
-  COMPLEX8 *ws1KFbX_k = NULL;
-  COMPLEX8 *ws2LFaX_k = NULL;
-  COMPLEX8 *ws2LFbX_k = NULL;
+  ResampCrossCorrEngine *resampEngine = NULL;
+  int errnum = 0;
   REAL8 Tcoh = 2*resampMultiPairs->maxLag + tShort;
-  if ( ( XLALCreateCrossCorrWorkspace( &ws, &ws1KFaX_k, &ws1KFbX_k, &ws2LFaX_k, &ws2LFbX_k, &multiTimeSeries_SRC_a, &multiTimeSeries_SRC_b, binaryTemplateSpacings, resampFstatInput, numFreqBins, Tcoh, uvar.treatWarningsAsErrors )!= XLAL_SUCCESS ) ) {
+  if ( ( XLALCreateCrossCorrWorkspace( &ws, NULL, NULL, NULL, NULL, &multiTimeSeries_SRC_a, &multiTimeSeries_SRC_b, binaryTemplateSpacings, resampFstatInput, numFreqBins, Tcoh, uvar.treatWarningsAsErrors )!= XLAL_SUCCESS ) ) {
     LogPrintf ( LOG_CRITICAL, "%s: XLALCreateCrossCorrWorkspace() failed with errno=%d\n", __func__, xlalErrno );
-    XLAL_ERROR( XLAL_EFUNC );
+    errnum = XLAL_EFUNC;
+    goto failed;
   }
 
   printf("numSamplesFFT: %u\n", ws->numSamplesFFT);
 
+  /* flatten the SFT pair list once, for reuse by all orbital templates */
+  if ( ( XLALCreateResampCrossCorrEngine( &resampEngine, ws, resampMultiPairs, resampGammaAve, uvar.numThreads ) != XLAL_SUCCESS ) ) {
+    LogPrintf ( LOG_CRITICAL, "%s: XLALCreateResampCrossCorrEngine() failed with errno=%d\n", __func__, xlalErrno );
+    errnum = XLAL_EFUNC;
+    goto failed;
+  }
+
   for (tCount = 0; tCount <= tSpacingNum; tCount++)
     {
       for (pCount = 0; pCount <= pSpacingNum; pCount++)
@@ -1804,19 +1827,27 @@ int resampForLoopCrossCorr(PulsarDopplerParams dopplerpos, BOOLEAN dopplerShiftF
       
               if ( (GetNextCrossCorrTemplateForResamp(&dopplerShiftFlag, &dopplerpos, &binaryTemplateSpacings, &minBinaryTemplate, &maxBinaryTemplate, &fCount, &aCount, &tCount, &pCount) )  != 0 ) {
                 LogPrintf ( LOG_CRITICAL, "%s: XLALGetNextCrossCorrTemplateForResamp() failed with errno=%d\n", __func__, xlalErrno );
-                XLAL_ERROR( XLAL_EFUNC );
+                errnum = XLAL_EFUNC;
+                goto failed;
               }
  
               /* Call ComputeFstat to make the resampled time series; given the
                * "none" whatToCompute flag, will skip the F-stat computation */
-              XLAL_CHECK( ( XLALComputeFstat ( Fstats, resampFstatInput, &dopplerpos, fCountResamp, whatToCompute ) == XLAL_SUCCESS ), XLAL_EFUNC );
+              if ( XLALComputeFstat ( Fstats, resampFstatInput, &dopplerpos, fCountResamp, whatToCompute ) != XLAL_SUCCESS ) {
+                errnum = XLAL_EFUNC;
+                goto failed;
+              }
               /* Return a resampled time series */
-              XLAL_CHECK( ( XLALExtractResampledTimeseries ( &multiTimeSeries_SRC_a, &multiTimeSeries_SRC_b, resampFstatInput ) == XLAL_SUCCESS ), XLAL_EFUNC );
+              if ( XLALExtractResampledTimeseries ( &multiTimeSeries_SRC_a, &multiTimeSeries_SRC_b, resampFstatInput ) != XLAL_SUCCESS ) {
+                errnum = XLAL_EFUNC;
+                goto failed;
+              }
 
               /* Calculate the CrossCorr rho statistic using resampling */
-              if ( (XLALCalculatePulsarCrossCorrStatisticResamp( ccStatVector, evSquaredVector, numeEquivAve, numeEquivCirc, resampGammaAve, resampMultiPairs, multiWeights, &binaryTemplateSpacings, &dopplerpos, multiTimeSeries_SRC_a, multiTimeSeries_SRC_b, ws, ws1KFaX_k, ws1KFbX_k, ws2LFaX_k, ws2LFbX_k)  != XLAL_SUCCESS ) ) {
-	        LogPrintf ( LOG_CRITICAL, "%s: XLALCalculatePulsarCrossCorrStatisticResamp() failed with errno=%d\n", __func__, xlalErrno );
-	        XLAL_ERROR( XLAL_EFUNC );
+              if ( (XLALCalculatePulsarCrossCorrStatisticResampEngine( ccStatVector, evSquaredVector, numeEquivAve, numeEquivCirc, resampEngine, multiWeights, &binaryTemplateSpacings, &dopplerpos, multiTimeSeries_SRC_a, multiTimeSeries_SRC_b)  != XLAL_SUCCESS ) ) {
+	        LogPrintf ( LOG_CRITICAL, "%s: XLALCalculatePulsarCrossCorrStatisticResampEngine() failed with errno=%d\n", __func__, xlalErrno );
+	        errnum = XLAL_EFUNC;
+	        goto failed;
               }
               for (fCount = 0; fCount <= fSpacingNum; fCount++)
               {
@@ -1837,16 +1868,19 @@ int resampForLoopCrossCorr(PulsarDopplerParams dopplerpos, BOOLEAN dopplerShiftF
         } // end pCount
     } /* end tCount, and with it, for loop over templates */
 
-    XLALDestroyResampCrossCorrWorkspace ( ws );
-    XLALFree ( ws1KFaX_k );
-    XLALFree ( ws1KFbX_k );
-    XLALFree ( ws2LFaX_k );
-    XLALFree ( ws2LFbX_k );
+failed:
+    XLALDestroyResampCrossCorrEngine ( resampEngine );
+    if ( ws != NULL ) {
+      XLALDestroyResampCrossCorrWorkspace ( ws );
+    }
 
     /* Destroy Fstat input */
     XLALDestroyFstatInput( resampFstatInput );
     /* Destroy resampled input and time structures, which use much memory */
     XLALDestroyFstatResults( Fstat_results );
+    if ( errnum != 0 ) {
+      XLAL_ERROR( errnum );
+    }
     return 0;
 } /* end resampForLoopCrossCorr */
 
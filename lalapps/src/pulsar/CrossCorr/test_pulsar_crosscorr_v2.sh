@@ -67,14 +67,40 @@ else
     echo "OK."
 fi
 
-## ---------- Run PulsarCrossCorr_v2 ----------
-cmdline="$pcc_code $pcc_CL"
-echo $cmdline
-echo -n "Running ${pcc_code} ... "
-if ! tmp=`eval $cmdline 2> /dev/null`; then
-    echo "FAILED:"
-    echo $cmdline
-    exit 1;
-else
-    echo "OK."
-fi
+## ---------- Run PulsarCrossCorr_v2 serially and distributing SFT pairs over threads,
+## ---------- with and without resampling, and check that the toplists agree ----------
+pcc_CL="${pcc_CL} --numCand=10000"
+
+for resamp in FALSE TRUE; do
+
+    for numThreads in 1 2; do
+        cmdline="$pcc_code $pcc_CL --resamp=$resamp --numThreads=$numThreads --toplistFilename=toplist_resamp${resamp}_threads${numThreads}.dat"
+        echo $cmdline
+        echo -n "Running ${pcc_code} with resamp=${resamp} and ${numThreads} thread(s) ... "
+        if ! tmp=`eval $cmdline 2> /dev/null`; then
+            echo "FAILED:"
+            echo $cmdline
+            exit 1;
+        else
+            echo "OK."
+        fi
+    done
+
+    ## sort toplists by template parameters, and compare all columns to relative tolerance
+    echo -n "Comparing toplists with resamp=${resamp} from 1 and 2 threads ... "
+    sort_toplist="grep -v '^%' | sort -g -k1,1 -k2,2 -k4,4 -k6,6"
+    eval "cat toplist_resamp${resamp}_threads1.dat | ${sort_toplist}" > toplist_threads1_sorted.dat
+    eval "cat toplist_resamp${resamp}_threads2.dat | ${sort_toplist}" > toplist_threads2_sorted.dat
+    if ! paste toplist_threads1_sorted.dat toplist_threads2_sorted.dat | awk -v tol=1e-5 '
+        function abs(x) { return x < 0 ? -x : x }
+        NF != 18 { print "toplists have different lengths or formats"; exit 1 }
+        { for ( i = 1; i <= 9; ++i ) { a = $i; b = $(i + 9); s = abs(a) > abs(b) ? abs(a) : abs(b); if ( s < 1 ) { s = 1 }; if ( abs(a - b) > tol * s ) { printf "line %d column %d: %.10g != %.10g\n", NR, i, a, b; exit 1 } } }
+        END { if ( NR == 0 ) { print "toplists are empty"; exit 1 } }
+    '; then
+        echo "FAILED."
+        exit 1
+    else
+        echo "OK."
+    fi
+
+done
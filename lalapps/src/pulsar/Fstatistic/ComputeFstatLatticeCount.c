@@ -37,6 +37,7 @@
 #include <lal/DopplerFullScan.h>
 #include <lal/PtoleMetric.h>
 #include <lal/GSLHelpers.h>
+#include <lal/FITSFileIO.h>
 
 #include <LALAppsVCSInfo.h>
 
@@ -47,6 +48,9 @@ typedef struct {
   REAL8 max_mismatch;
   int lattice;
   int metric;
+  UINT4 threads;
+  CHAR *input_counts;
+  CHAR *output_counts;
 } UserVariables;
 
 enum { SPINDOWN, EYE } MetricType;
@@ -59,6 +63,7 @@ int main(int argc, char *argv[])
   UserVariables uvar_struct = {
     .lattice = TILING_LATTICE_ANSTAR,
     .metric = SPINDOWN,
+    .threads = 1,
   };
   UserVariables *const uvar = &uvar_struct;
 
@@ -69,6 +74,9 @@ int main(int argc, char *argv[])
   XLAL_CHECK_MAIN(XLALRegisterUvarMember(max_mismatch, REAL8, 'X', REQUIRED, "Maximum allowed mismatch between the templates") == XLAL_SUCCESS, XLAL_EFUNC);
   XLAL_CHECK_MAIN(XLALRegisterUvarAuxDataMember(lattice, UserEnum, &TilingLatticeChoices, 'L', REQUIRED, "Type of lattice to use") == XLAL_SUCCESS, XLAL_EFUNC);
   XLAL_CHECK_MAIN(XLALRegisterUvarAuxDataMember(metric, UserEnum, &MetricTypeChoices, 'M', OPTIONAL, "Type of metric to use") == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK_MAIN(XLALRegisterUvarMember(threads, UINT4, 0, OPTIONAL, "Count templates using this number of threads (0 = OpenMP default)") == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK_MAIN(XLALRegisterUvarMember(input_counts, STRING, 0, OPTIONAL, "Read per-dimension template counts from this FITS file instead of counting templates") == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK_MAIN(XLALRegisterUvarMember(output_counts, STRING, 0, OPTIONAL, "Write per-dimension template counts to this FITS file, for use with " UVAR_STR(input_counts)) == XLAL_SUCCESS, XLAL_EFUNC);
 
   // Parse user input
   BOOLEAN should_exit = 0;
@@ -129,6 +137,15 @@ int main(int argc, char *argv[])
   }
   XLAL_CHECK_MAIN(XLALSetTilingLatticeAndMetric(tiling, uvar->lattice, metric, uvar->max_mismatch)  == XLAL_SUCCESS, XLAL_EFUNC);
   gsl_matrix_free(metric);
+  XLAL_CHECK_MAIN(XLALSetLatticeTilingCallbackThreads(tiling, uvar->threads) == XLAL_SUCCESS, XLAL_EFUNC);
+
+  // Restore template counts, if requested
+  if (UVAR_SET(input_counts)) {
+    FITSFile *file = XLALFITSFileOpenRead(uvar->input_counts);
+    XLAL_CHECK_MAIN(file != NULL, XLAL_EFUNC);
+    XLAL_CHECK_MAIN(XLALRestoreLatticeTilingPointCounts(tiling, file, "counts") == XLAL_SUCCESS, XLAL_EFUNC);
+    XLALFITSFileClose(file);
+  }
 
   // Create a lattice iterator
   LatticeTilingIterator *itr = XLALCreateLatticeTilingIterator(tiling, n);
@@ -139,6 +156,14 @@ int main(int argc, char *argv[])
   XLAL_CHECK_MAIN(ntemplates > 0, XLAL_EFUNC);
   printf("%" LAL_UINT8_FORMAT "\n", ntemplates);
 
+  // Save template counts, if requested
+  if (UVAR_SET(output_counts)) {
+    FITSFile *file = XLALFITSFileOpenWrite(uvar->output_counts);
+    XLAL_CHECK_MAIN(file != NULL, XLAL_EFUNC);
+    XLAL_CHECK_MAIN(XLALSaveLatticeTilingPointCounts(tiling, file, "counts") == XLAL_SUCCESS, XLAL_EFUNC);
+    XLALFITSFileClose(file);
+  }
+
   // Cleanup
   XLALDestroyLatticeTilingIterator(itr);
   XLALDestroyLatticeTiling(tiling);
@@ -309,6 +309,7 @@ typedef struct {
 
   BOOLEAN resampFFTPowerOf2;	//!< in Resamp: enforce FFT length to be a power of two (by rounding up)
   REAL8 allowedMismatchFromSFTLength; /**< maximum allowed mismatch from SFTs being too long */
+  INT4 numThreads;		//!< number of threads used to compute the F-statistic (0 = OpenMP default)
 
   LALStringVector *injectionSources;    /**< Source parameters to inject: comma-separated list of file-patterns and/or direct config-strings ('{...}') */
   LALStringVector *injectSqrtSX; 	/**< Add Gaussian noise: list of respective detectors' noise-floors sqrt{Sn}" */
@@ -1040,6 +1041,7 @@ initUserVars ( UserInput_t *uvar )
   uvar->transient_useFReg = 0;
   uvar->resampFFTPowerOf2 = FstatOptionalArgsDefaults.resampFFTPowerOf2;
   uvar->allowedMismatchFromSFTLength = 0;
+  uvar->numThreads = FstatOptionalArgsDefaults.numThreads;
   uvar->injectionSources = NULL;
   uvar->injectSqrtSX = NULL;
   uvar->IFOs = NULL;
@@ -1169,6 +1171,7 @@ initUserVars ( UserInput_t *uvar )
   XLALRegisterUvarMember(resampFFTPowerOf2,  BOOLEAN, 0,  DEVELOPER, "For Resampling methods: enforce FFT length to be a power of two (by rounding up)" );
 
   XLALRegisterUvarMember(allowedMismatchFromSFTLength, REAL8, 0, DEVELOPER, "Maximum allowed mismatch from SFTs being too long [Default: what's hardcoded in XLALFstatMaximumSFTLength]" );
+  XLALRegisterUvarMember(numThreads,       INT4, 0,  DEVELOPER, "Number of threads used to compute the F-statistic (0 = OpenMP default; requires OpenMP support in LALPulsar)" );
 
   /* inject signals into the data being analyzed */
   XLALRegisterUvarMember(injectionSources,  STRINGVector, 0, DEVELOPER, "%s", InjectionSourcesHelpString );
@@ -1210,7 +1213,7 @@ InitFstat ( ConfigVariables *cfg, const UserInput_t *uvar )
   XLAL_CHECK ( chdir ( uvar->workingDir ) == 0, XLAL_EINVAL, "Unable to change directory to workinDir '%s'\n", uvar->workingDir );
 
   /* ----- set computational parameters for F-statistic from User-input ----- */
-  cfg->useResamp = ( uvar->FstatMethod >= FMETHOD_RESAMP_GENERIC ); // use resampling;
+  cfg->useResamp = ( uvar->FstatMethod == FMETHOD_RESAMP_GENERIC || uvar->FstatMethod == FMETHOD_RESAMP_BEST ); // use resampling;
 
   /* check that resampling is compatible with gridType */
   if ( cfg->useResamp && uvar->gridType > GRID_SKY_LAST /* end-marker for factored grid types */ ) {
@@ -1490,6 +1493,8 @@ InitFstat ( ConfigVariables *cfg, const UserInput_t *uvar )
   optionalArgs.resampFFTPowerOf2 = uvar->resampFFTPowerOf2;
   optionalArgs.collectTiming = XLALUserVarWasSet ( &uvar->outputFstatTiming );
   optionalArgs.allowedMismatchFromSFTLength = uvar->allowedMismatchFromSFTLength;
+  XLAL_CHECK ( uvar->numThreads >= 0, XLAL_EDOM, "Invalid value numThreads = %d, must be >= 0\n", uvar->numThreads );
+  optionalArgs.numThreads = (UINT4) uvar->numThreads;
 
 
   XLAL_CHECK ( (cfg->Fstat_in = XLALCreateFstatInput( catalog, fCoverMin, fCoverMax, cfg->dFreq, cfg->ephemeris, &optionalArgs )) != NULL, XLAL_EFUNC );
@@ -0,0 +1,671 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+/*---------- INCLUDES ----------*/
+#include "GCTHotloop.h"
+
+#include <lal/LALSIMD.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef GC_SSE2_OPT
+#include <gc_hotloop_sse2.h>
+#else
+#define ALRealloc LALRealloc
+#define ALFree LALFree
+#endif
+
+/* AVX2/AVX-512F kernels are compiled with per-function target attributes,
+   so that they are available regardless of the compiler flags used */
+#if defined(__GNUC__) && ( defined(__x86_64__) || defined(__i386__) )
+#define GC_HOTLOOP_HAVE_AVX 1
+#include <immintrin.h>
+#endif
+
+/*---------- local DEFINES ----------*/
+#define TRUE (1==1)
+#define FALSE (1==0)
+
+/* tile lengths are a multiple of this number of fine-grid bins, so that
+   tiles of every fine-grid array start on a cache line boundary */
+#define TILE_ALIGN 64
+
+/*---------- internal types ----------*/
+
+/** Kernels which work on one tile of the fine grid for one segment */
+typedef struct {
+  void (*sum_nc) ( REAL4 *fgrid2F, const REAL4 *cgrid2F, FINEGRID_NC_T *fgridnc, REAL4 TwoFthreshold, UINT4 length );
+  void (*sum) ( REAL4 *fgrid2F, const REAL4 *cgrid2F, UINT4 length );
+  void (*max) ( REAL4 *fgrid2Fmax, UINT4 *fgrid2FmaxIdx, const REAL4 *cgrid2F, UINT4 k, UINT4 length );
+} TileKernels;
+
+/*---------- Global variables ----------*/
+
+const UserChoices GCTHotloopKernelChoices = {
+  { GCT_HOTLOOP_AUTO,           "auto" },
+  { GCT_HOTLOOP_SEGMENTWISE,    "segmentwise" },
+  { GCT_HOTLOOP_GENERIC,        "generic" },
+  { GCT_HOTLOOP_AVX2,           "avx2" },
+  { GCT_HOTLOOP_AVX512F,        "avx512f" },
+};
+
+/*==================== TILE KERNELS ====================*/
+
+/*
+ * The max-tracking kernels follow gc_hotloop_2Fmax_tracking(): the first
+ * segment initialises the maximum, and later segments replace it if they are
+ * at least as loud.
+ */
+
+static void tile_sum_nc_generic ( REAL4 *fgrid2F, const REAL4 *cgrid2F, FINEGRID_NC_T *fgridnc, REAL4 TwoFthreshold, UINT4 length )
+{
+  for ( UINT4 i = 0; i < length; i++ ) {
+    fgrid2F[i] += cgrid2F[i];
+    fgridnc[i] += (TwoFthreshold < cgrid2F[i]);
+  }
+}
+
+static void tile_sum_generic ( REAL4 *fgrid2F, const REAL4 *cgrid2F, UINT4 length )
+{
+  for ( UINT4 i = 0; i < length; i++ ) {
+    fgrid2F[i] += cgrid2F[i];
+  }
+}
+
+static void tile_max_generic ( REAL4 *fgrid2Fmax, UINT4 *fgrid2FmaxIdx, const REAL4 *cgrid2F, UINT4 k, UINT4 length )
+{
+  if ( k == 0 ) {
+    memcpy( fgrid2Fmax, cgrid2F, length * sizeof(REAL4) );
+    memset( fgrid2FmaxIdx, 0, length * sizeof(UINT4) );
+    return;
+  }
+  for ( UINT4 i = 0; i < length; i++ ) {
+    const int isLouder = (fgrid2Fmax[i] <= cgrid2F[i]);
+    fgrid2Fmax[i] = isLouder ? cgrid2F[i] : fgrid2Fmax[i];
+    fgrid2FmaxIdx[i] = isLouder ? k : fgrid2FmaxIdx[i];
+  }
+}
+
+static const TileKernels tile_kernels_generic = { tile_sum_nc_generic, tile_sum_generic, tile_max_generic };
+
+#ifdef GC_HOTLOOP_HAVE_AVX
+
+__attribute__ ((target ("avx2")))
+static void tile_sum_nc_avx2 ( REAL4 *fgrid2F, const REAL4 *cgrid2F, FINEGRID_NC_T *fgridnc, REAL4 TwoFthreshold, UINT4 length )
+{
+  const __m256 thr = _mm256_set1_ps( TwoFthreshold );
+  UINT4 i = 0;
+#ifdef GC_SSE2_OPT
+  /* 8-bit number counts: pack four comparison masks (-1 where above threshold) into one vector of bytes */
+  const __m256i order = _mm256_setr_epi32( 0, 4, 1, 5, 2, 6, 3, 7 );
+  for ( ; i + 32 <= length; i += 32 ) {
+    __m256i mask[4];
+    for ( int j = 0; j < 4; j++ ) {
+      const __m256 c = _mm256_loadu_ps( cgrid2F + i + 8*j );
+      _mm256_storeu_ps( fgrid2F + i + 8*j, _mm256_add_ps( _mm256_loadu_ps( fgrid2F + i + 8*j ), c ) );
+      mask[j] = _mm256_castps_si256( _mm256_cmp_ps( thr, c, _CMP_LT_OQ ) );
+    }
+    __m256i mask8 = _mm256_packs_epi16( _mm256_packs_epi32( mask[0], mask[1] ), _mm256_packs_epi32( mask[2], mask[3] ) );
+    mask8 = _mm256_permutevar8x32_epi32( mask8, order );
+    const __m256i nc = _mm256_loadu_si256( (const __m256i *) (fgridnc + i) );
+    _mm256_storeu_si256( (__m256i *) (fgridnc + i), _mm256_sub_epi8( nc, mask8 ) );
+  }
+#else
+  /* 32-bit number counts: subtract comparison masks (-1 where above threshold) */
+  for ( ; i + 8 <= length; i += 8 ) {
+    const __m256 c = _mm256_loadu_ps( cgrid2F + i );
+    _mm256_storeu_ps( fgrid2F + i, _mm256_add_ps( _mm256_loadu_ps( fgrid2F + i ), c ) );
+    const __m256i mask = _mm256_castps_si256( _mm256_cmp_ps( thr, c, _CMP_LT_OQ ) );
+    const __m256i nc = _mm256_loadu_si256( (const __m256i *) (fgridnc + i) );
+    _mm256_storeu_si256( (__m256i *) (fgridnc + i), _mm256_sub_epi32( nc, mask ) );
+  }
+#endif
+  tile_sum_nc_generic( fgrid2F + i, cgrid2F + i, fgridnc + i, TwoFthreshold, length - i );
+}
+
+__attribute__ ((target ("avx2")))
+static void tile_sum_avx2 ( REAL4 *fgrid2F, const REAL4 *cgrid2F, UINT4 length )
+{
+  UINT4 i = 0;
+  for ( ; i + 16 <= length; i += 16 ) {
+    const __m256 c0 = _mm256_loadu_ps( cgrid2F + i );
+    const __m256 c1 = _mm256_loadu_ps( cgrid2F + i + 8 );
+    _mm256_storeu_ps( fgrid2F + i, _mm256_add_ps( _mm256_loadu_ps( fgrid2F + i ), c0 ) );
+    _mm256_storeu_ps( fgrid2F + i + 8, _mm256_add_ps( _mm256_loadu_ps( fgrid2F + i + 8 ), c1 ) );
+  }
+  tile_sum_generic( fgrid2F + i, cgrid2F + i, length - i );
+}
+
+__attribute__ ((target ("avx2")))
+static void tile_max_avx2 ( REAL4 *fgrid2Fmax, UINT4 *fgrid2FmaxIdx, const REAL4 *cgrid2F, UINT4 k, UINT4 length )
+{
+  if ( k == 0 ) {
+    tile_max_generic( fgrid2Fmax, fgrid2FmaxIdx, cgrid2F, k, length );
+    return;
+  }
+  const __m256i vk = _mm256_set1_epi32( k );
+  UINT4 i = 0;
+  for ( ; i + 8 <= length; i += 8 ) {
+    const __m256 c = _mm256_loadu_ps( cgrid2F + i );
+    const __m256 m = _mm256_loadu_ps( fgrid2Fmax + i );
+    const __m256 isLouder = _mm256_cmp_ps( m, c, _CMP_LE_OS );
+    const __m256i idx = _mm256_loadu_si256( (const __m256i *) (fgrid2FmaxIdx + i) );
+    _mm256_storeu_ps( fgrid2Fmax + i, _mm256_blendv_ps( m, c, isLouder ) );
+    _mm256_storeu_si256( (__m256i *) (fgrid2FmaxIdx + i), _mm256_blendv_epi8( idx, vk, _mm256_castps_si256( isLouder ) ) );
+  }
+  tile_max_generic( fgrid2Fmax + i, fgrid2FmaxIdx + i, cgrid2F + i, k, length - i );
+}
+
+static const TileKernels tile_kernels_avx2 = { tile_sum_nc_avx2, tile_sum_avx2, tile_max_avx2 };
+
+__attribute__ ((target ("avx512f")))
+static void tile_sum_nc_avx512f ( REAL4 *fgrid2F, const REAL4 *cgrid2F, FINEGRID_NC_T *fgridnc, REAL4 TwoFthreshold, UINT4 length )
+{
+  const __m512 thr = _mm512_set1_ps( TwoFthreshold );
+  const __m512i one = _mm512_set1_epi32( 1 );
+  UINT4 i = 0;
+  for ( ; i + 16 <= length; i += 16 ) {
+    const __m512 c = _mm512_loadu_ps( cgrid2F + i );
+    _mm512_storeu_ps( fgrid2F + i, _mm512_add_ps( _mm512_loadu_ps( fgrid2F + i ), c ) );
+    const __mmask16 above = _mm512_cmp_ps_mask( thr, c, _CMP_LT_OQ );
+#ifdef GC_SSE2_OPT
+    /* 8-bit number counts: narrow the masked increments to bytes */
+    const __m128i inc = _mm512_cvtepi32_epi8( _mm512_maskz_mov_epi32( above, one ) );
+    const __m128i nc = _mm_loadu_si128( (const __m128i *) (fgridnc + i) );
+    _mm_storeu_si128( (__m128i *) (fgridnc + i), _mm_add_epi8( nc, inc ) );
+#else
+    const __m512i nc = _mm512_loadu_si512( fgridnc + i );
+    _mm512_storeu_si512( fgridnc + i, _mm512_mask_add_epi32( nc, above, nc, one ) );
+#endif
+  }
+  tile_sum_nc_generic( fgrid2F + i, cgrid2F + i, fgridnc + i, TwoFthreshold, length - i );
+}
+
+__attribute__ ((target ("avx512f")))
+static void tile_sum_avx512f ( REAL4 *fgrid2F, const REAL4 *cgrid2F, UINT4 length )
+{
+  UINT4 i = 0;
+  for ( ; i + 32 <= length; i += 32 ) {
+    const __m512 c0 = _mm512_loadu_ps( cgrid2F + i );
+    const __m512 c1 = _mm512_loadu_ps( cgrid2F + i + 16 );
+    _mm512_storeu_ps( fgrid2F + i, _mm512_add_ps( _mm512_loadu_ps( fgrid2F + i ), c0 ) );
+    _mm512_storeu_ps( fgrid2F + i + 16, _mm512_add_ps( _mm512_loadu_ps( fgrid2F + i + 16 ), c1 ) );
+  }
+  tile_sum_generic( fgrid2F + i, cgrid2F + i, length - i );
+}
+
+__attribute__ ((target ("avx512f")))
+static void tile_max_avx512f ( REAL4 *fgrid2Fmax, UINT4 *fgrid2FmaxIdx, const REAL4 *cgrid2F, UINT4 k, UINT4 length )
+{
+  if ( k == 0 ) {
+    tile_max_generic( fgrid2Fmax, fgrid2FmaxIdx, cgrid2F, k, length );
+    return;
+  }
+  const __m512i vk = _mm512_set1_epi32( k );
+  UINT4 i = 0;
+  for ( ; i + 16 <= length; i += 16 ) {
+    const __m512 c = _mm512_loadu_ps( cgrid2F + i );
+    const __m512 m = _mm512_loadu_ps( fgrid2Fmax + i );
+    const __mmask16 isLouder = _mm512_cmp_ps_mask( m, c, _CMP_LE_OS );
+    const __m512i idx = _mm512_loadu_si512( fgrid2FmaxIdx + i );
+    _mm512_storeu_ps( fgrid2Fmax + i, _mm512_mask_mov_ps( m, isLouder, c ) );
+    _mm512_storeu_si512( fgrid2FmaxIdx + i, _mm512_mask_mov_epi32( idx, isLouder, vk ) );
+  }
+  tile_max_generic( fgrid2Fmax + i, fgrid2FmaxIdx + i, cgrid2F + i, k, length - i );
+}
+
+static const TileKernels tile_kernels_avx512f = { tile_sum_nc_avx512f, tile_sum_avx512f, tile_max_avx512f };
+
+#endif // GC_HOTLOOP_HAVE_AVX
+
+/*==================== FUNCTION DEFINITIONS ====================*/
+
+/** Resolve the requested fine-grid summation kernel, checking that it is supported by this CPU */
+int XLALGCTHotloopSelect ( GCTHotloopKernel *selected,		/**< [out] kernel to use; never GCT_HOTLOOP_AUTO */
+                           const GCTHotloopKernel requested	/**< [in] kernel requested by the user */
+                           )
+{
+  XLAL_CHECK ( selected != NULL, XLAL_EFAULT );
+
+  switch ( requested ) {
+
+  case GCT_HOTLOOP_AUTO:
+    /* the generic tiled kernel is not faster than the segment-wise SSE2 kernel, so is never auto-selected */
+    *selected = GCT_HOTLOOP_SEGMENTWISE;
+#ifdef GC_HOTLOOP_HAVE_AVX
+    if ( LAL_HAVE_AVX512F_RUNTIME() ) {
+      *selected = GCT_HOTLOOP_AVX512F;
+    } else if ( LAL_HAVE_AVX2_RUNTIME() ) {
+      *selected = GCT_HOTLOOP_AVX2;
+    }
+#endif
+    break;
+
+  case GCT_HOTLOOP_SEGMENTWISE:
+  case GCT_HOTLOOP_GENERIC:
+    *selected = requested;
+    break;
+
+  case GCT_HOTLOOP_AVX2:
+#ifdef GC_HOTLOOP_HAVE_AVX
+    XLAL_CHECK ( LAL_HAVE_AVX2_RUNTIME(), XLAL_EINVAL, "AVX2 fine-grid summation kernel is not supported by this CPU" );
+    *selected = requested;
+    break;
+#else
+    XLAL_ERROR ( XLAL_EINVAL, "AVX2 fine-grid summation kernel was not compiled" );
+#endif
+
+  case GCT_HOTLOOP_AVX512F:
+#ifdef GC_HOTLOOP_HAVE_AVX
+    XLAL_CHECK ( LAL_HAVE_AVX512F_RUNTIME(), XLAL_EINVAL, "AVX-512F fine-grid summation kernel is not supported by this CPU" );
+    *selected = requested;
+    break;
+#else
+    XLAL_ERROR ( XLAL_EINVAL, "AVX-512F fine-grid summation kernel was not compiled" );
+#endif
+
+  default:
+    XLAL_ERROR ( XLAL_EINVAL, "Invalid fine-grid summation kernel %i", requested );
+
+  }
+
+  return XLAL_SUCCESS;
+
+} /* XLALGCTHotloopSelect() */
+
+
+/** Return the name of a fine-grid summation kernel */
+const char *XLALGCTHotloopName ( const GCTHotloopKernel kernel )
+{
+  for ( size_t i = 0; i < XLAL_NUM_ELEM( GCTHotloopKernelChoices ); i++ ) {
+    if ( GCTHotloopKernelChoices[i].name != NULL && GCTHotloopKernelChoices[i].val == (int) kernel ) {
+      return GCTHotloopKernelChoices[i].name;
+    }
+  }
+  return "unknown";
+} /* XLALGCTHotloopName() */
+
+
+/**
+ * Add the coarse-grid 2F values of segment 'k', starting at coarse-grid frequency index 'U1idx',
+ * to the whole fine grid. Segments must be added in ascending order.
+ */
+int XLALGCTHotloopSumSegment ( FineGrid *finegrid, const CoarseGrid *coarsegrid, const UINT4 k, const INT4 U1idx,
+                               const REAL4 TwoFthreshold, const BOOLEAN getMaxFperSeg, const BOOLEAN computeBSGL )
+{
+  XLAL_CHECK ( finegrid != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( coarsegrid != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( U1idx >= 0 && U1idx + finegrid->freqlength <= coarsegrid->freqlength, XLAL_EDOM );
+#ifdef EXP_NO_NUM_COUNT
+  (void) TwoFthreshold;
+#endif
+
+  /* coarse grid over frequency for this stack */
+  REAL4 * cgrid2F = coarsegrid->TwoF + CG_INDEX(*coarsegrid, k, U1idx);
+
+  /* fine grid over frequency */
+  REAL4 * fgrid2F = finegrid->sumTwoF + FG_INDEX(*finegrid, 0);
+#ifndef EXP_NO_NUM_COUNT
+  FINEGRID_NC_T * fgridnc = finegrid->nc + FG_INDEX(*finegrid, 0);
+#endif
+
+#ifdef GC_SSE2_OPT
+  if ( getMaxFperSeg ) {
+    /* disables number count keeping */
+    REAL4 * fgrid2Fmax = finegrid->maxTwoFl + FG_INDEX(*finegrid, 0);
+    UINT4 * fgrid2FmaxIdx = finegrid->maxTwoFlIdx + FG_INDEX(*finegrid, 0);
+
+    gc_hotloop_2Fmax_tracking (fgrid2F, fgrid2Fmax, fgrid2FmaxIdx, cgrid2F, k, finegrid->freqlength);
+  } else {
+#ifndef EXP_NO_NUM_COUNT
+    gc_hotloop( fgrid2F, cgrid2F, fgridnc, TwoFthreshold, finegrid->freqlength );
+#else
+    gc_hotloop_no_nc ( fgrid2F, cgrid2F, finegrid->freqlength );
+#endif
+  }
+  if ( computeBSGL ) {
+    for (UINT4 X = 0; X < finegrid->numDetectors; X++) {
+      REAL4 * cgrid2FX = coarsegrid->TwoFX + CG_FX_INDEX(*coarsegrid, X, k, U1idx);
+      REAL4 * fgrid2FX = finegrid->sumTwoFX + FG_FX_INDEX(*finegrid, X, 0);
+
+      if ( getMaxFperSeg ) {
+        REAL4 * fgrid2FXmax = finegrid->maxTwoFXl + FG_FX_INDEX(*finegrid, X, 0);
+        UINT4 * fgrid2FXmaxIdx = finegrid->maxTwoFXlIdx + FG_FX_INDEX(*finegrid, X, 0);
+
+        gc_hotloop_2Fmax_tracking (fgrid2FX, fgrid2FXmax, fgrid2FXmaxIdx, cgrid2FX, k, finegrid->freqlength );
+      } else {
+        gc_hotloop_no_nc( fgrid2FX, cgrid2FX, finegrid->freqlength );
+      }
+    } /* for  X  */
+  }
+#else // GC_SSE2_OPT
+  for(UINT4 ifreq_fg=0; ifreq_fg < finegrid->freqlength; ifreq_fg++) {
+    fgrid2F[0] += cgrid2F[0];
+#ifndef EXP_NO_NUM_COUNT
+    fgridnc[0] += (TwoFthreshold < cgrid2F[0]);
+    fgridnc++;
+#endif // EXP_NO_NUM_COUNT
+    fgrid2F++;
+    cgrid2F++;
+  }
+  if ( computeBSGL ) {
+    for (UINT4 X = 0; X < finegrid->numDetectors; X++) {
+      REAL4 * cgrid2FX = coarsegrid->TwoFX + CG_FX_INDEX(*coarsegrid, X, k, U1idx);
+      REAL4 * fgrid2FX = finegrid->sumTwoFX + FG_FX_INDEX(*finegrid, X, 0);
+      for(UINT4 ifreq_fg=0; ifreq_fg < finegrid->freqlength; ifreq_fg++) {
+        fgrid2FX[0] += cgrid2FX[0];
+        fgrid2FX++;
+        cgrid2FX++;
+      }
+    }
+  }
+
+  if ( getMaxFperSeg ) {
+    cgrid2F = coarsegrid->TwoF + CG_INDEX(*coarsegrid, k, U1idx);
+    REAL4 * fgridMax2Fl = finegrid->maxTwoFl + FG_INDEX(*finegrid, 0);
+    UINT4 * fgrid2FmaxIdx = finegrid->maxTwoFlIdx + FG_INDEX(*finegrid, 0);
+    int isLouder;
+    for (UINT4 ifreq_fg=0; ifreq_fg < finegrid->freqlength; ifreq_fg++) {
+      isLouder=(fgridMax2Fl[0] <= cgrid2F[0]);
+      fgridMax2Fl[0] = fmaxf ( fgridMax2Fl[0], cgrid2F[0] );
+      fgrid2FmaxIdx[0]= isLouder*k + (1-isLouder)*fgrid2FmaxIdx[0];
+      fgridMax2Fl++;
+      fgrid2FmaxIdx++;
+      cgrid2F++;
+    }
+    /* per-detector maxima are only allocated with computeBSGL, as in the GC_SSE2_OPT build */
+    if ( computeBSGL ) {
+      for (UINT4 X = 0; X < finegrid->numDetectors; X++) {
+        REAL4 * cgrid2FX = coarsegrid->TwoFX + CG_FX_INDEX(*coarsegrid, X, k, U1idx);
+        REAL4 * fgridMax2FXl = finegrid->maxTwoFXl + FG_FX_INDEX(*finegrid, X, 0);
+        UINT4 * fgrid2FXmaxIdx = finegrid->maxTwoFXlIdx + FG_FX_INDEX(*finegrid, X, 0);
+
+        for(UINT4 ifreq_fg=0; ifreq_fg < finegrid->freqlength; ifreq_fg++) {
+          isLouder=(fgridMax2FXl[0] <= cgrid2FX[0]);
+          fgridMax2FXl[0] = fmaxf ( fgridMax2FXl[0], cgrid2FX[0] );
+          fgrid2FXmaxIdx[0] = isLouder*k + (1-isLouder)*fgrid2FXmaxIdx[0];
+          fgrid2FXmaxIdx++;
+          fgridMax2FXl++;
+          cgrid2FX++;
+        }
+      }
+    }
+  }
+#endif // GC_SSE2_OPT
+
+  return XLAL_SUCCESS;
+
+} /* XLALGCTHotloopSumSegment() */
+
+
+/**
+ * Add the coarse-grid 2F values of all 'nStacks' segments, starting at coarse-grid frequency
+ * indices 'U1idx[k]', to the fine grid, using one of the tiled kernels. The fine grid is split
+ * into frequency tiles of 'tileLength' bins (0 selects a length which fits the L2 cache),
+ * and tiles are distributed over 'numThreads' OpenMP threads (0 uses all available threads).
+ * The fine grid is expected to be zeroed, as for XLALGCTHotloopSumSegment().
+ */
+int XLALGCTHotloopSumFineGrid ( FineGrid *finegrid, const CoarseGrid *coarsegrid, const UINT4 nStacks, const INT4 *U1idx,
+                                const REAL4 TwoFthreshold, const BOOLEAN getMaxFperSeg, const BOOLEAN computeBSGL,
+                                const GCTHotloopKernel kernel, UINT4 tileLength, UINT4 numThreads )
+{
+  XLAL_CHECK ( finegrid != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( coarsegrid != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( U1idx != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( nStacks <= coarsegrid->nStacks, XLAL_EINVAL );
+  for ( UINT4 k = 0; k < nStacks; k++ ) {
+    XLAL_CHECK ( U1idx[k] >= 0 && U1idx[k] + finegrid->freqlength <= coarsegrid->freqlength, XLAL_EDOM,
+                 "Fine grid of length %u at coarse-grid index %i in segment %u exceeds coarse grid of length %u",
+                 finegrid->freqlength, U1idx[k], k, coarsegrid->freqlength );
+  }
+
+  /* select tile kernels */
+  const TileKernels *kern = NULL;
+  switch ( kernel ) {
+  case GCT_HOTLOOP_GENERIC:
+    kern = &tile_kernels_generic;
+    break;
+#ifdef GC_HOTLOOP_HAVE_AVX
+  case GCT_HOTLOOP_AVX2:
+    kern = &tile_kernels_avx2;
+    break;
+  case GCT_HOTLOOP_AVX512F:
+    kern = &tile_kernels_avx512f;
+    break;
+#endif
+  default:
+    XLAL_ERROR ( XLAL_EINVAL, "Fine-grid summation kernel '%s' is not a tiled kernel", XLALGCTHotloopName( kernel ) );
+  }
+
+  /* follow the number count conventions of XLALGCTHotloopSumSegment() */
+#if defined(EXP_NO_NUM_COUNT)
+  const BOOLEAN countNC = FALSE;
+#elif defined(GC_SSE2_OPT)
+  const BOOLEAN countNC = !getMaxFperSeg;	/* max-tracking disables number count keeping */
+#else
+  const BOOLEAN countNC = TRUE;
+#endif
+  const UINT4 numDetectors = computeBSGL ? finegrid->numDetectors : 0;
+
+#ifdef _OPENMP
+  if ( numThreads == 0 ) {
+    numThreads = omp_get_max_threads();
+  }
+#else
+  numThreads = 1;
+#endif
+
+  /* choose a tile length such that the fine-grid arrays of one tile fill at most half the L2 cache,
+     with at least as many tiles as threads */
+  if ( tileLength == 0 ) {
+    size_t bytesPerBin = sizeof( REAL4 );
+    if ( countNC ) {
+      bytesPerBin += sizeof( FINEGRID_NC_T );
+    }
+    if ( getMaxFperSeg ) {
+      bytesPerBin += sizeof( REAL4 ) + sizeof( UINT4 );
+    }
+    bytesPerBin += numDetectors * ( sizeof( REAL4 ) + ( getMaxFperSeg ? sizeof( REAL4 ) + sizeof( UINT4 ) : 0 ) );
+    tileLength = ( GCT_HOTLOOP_L2_BYTES / 2 ) / bytesPerBin;
+    const UINT4 perThreadLength = ( finegrid->freqlength + numThreads - 1 ) / numThreads;
+    if ( tileLength > perThreadLength ) {
+      tileLength = perThreadLength;
+    }
+    tileLength = ( ( tileLength + TILE_ALIGN - 1 ) / TILE_ALIGN ) * TILE_ALIGN;
+  }
+  const UINT4 numTiles = ( finegrid->freqlength + tileLength - 1 ) / tileLength;
+
+  /* sum all segments tile by tile */
+#pragma omp parallel for schedule(static) num_threads(numThreads) if(numThreads > 1 && numTiles > 1)
+  for ( UINT4 t = 0; t < numTiles; t++ ) {
+    const UINT4 f0 = t * tileLength;
+    const UINT4 length = ( f0 + tileLength <= finegrid->freqlength ) ? tileLength : finegrid->freqlength - f0;
+
+    for ( UINT4 k = 0; k < nStacks; k++ ) {
+
+      const REAL4 *cgrid2F = coarsegrid->TwoF + CG_INDEX(*coarsegrid, k, U1idx[k] + f0);
+      REAL4 *fgrid2F = finegrid->sumTwoF + FG_INDEX(*finegrid, f0);
+      if ( countNC ) {
+        kern->sum_nc( fgrid2F, cgrid2F, finegrid->nc + FG_INDEX(*finegrid, f0), TwoFthreshold, length );
+      } else {
+        kern->sum( fgrid2F, cgrid2F, length );
+      }
+      if ( getMaxFperSeg ) {
+        kern->max( finegrid->maxTwoFl + FG_INDEX(*finegrid, f0), finegrid->maxTwoFlIdx + FG_INDEX(*finegrid, f0), cgrid2F, k, length );
+      }
+
+      for ( UINT4 X = 0; X < numDetectors; X++ ) {
+        const REAL4 *cgrid2FX = coarsegrid->TwoFX + CG_FX_INDEX(*coarsegrid, X, k, U1idx[k] + f0);
+        kern->sum( finegrid->sumTwoFX + FG_FX_INDEX(*finegrid, X, f0), cgrid2FX, length );
+        if ( getMaxFperSeg ) {
+          kern->max( finegrid->maxTwoFXl + FG_FX_INDEX(*finegrid, X, f0), finegrid->maxTwoFXlIdx + FG_FX_INDEX(*finegrid, X, f0), cgrid2FX, k, length );
+        }
+      }
+
+    } /* for k < nStacks */
+
+  } /* for t < numTiles */
+
+  return XLAL_SUCCESS;
+
+} /* XLALGCTHotloopSumFineGrid() */
+
+
+/* allocate and zero the arrays of a fine grid, aligned as in HierarchSearchGCT.c */
+static int CheckFineGridAlloc ( FineGrid *fg )
+{
+  fg->nc = (FINEGRID_NC_T *)ALRealloc( NULL, fg->length * sizeof(FINEGRID_NC_T) );
+  fg->sumTwoF = (REAL4 *)ALRealloc( NULL, fg->length * sizeof(REAL4) );
+  fg->maxTwoFl = (REAL4 *)ALRealloc( NULL, fg->length * sizeof(REAL4) );
+  fg->maxTwoFlIdx = (UINT4 *)ALRealloc( NULL, fg->length * sizeof(UINT4) );
+  fg->sumTwoFX = (REAL4 *)ALRealloc( NULL, fg->numDetectors * fg->freqlengthAL * sizeof(REAL4) );
+  fg->maxTwoFXl = (REAL4 *)ALRealloc( NULL, fg->numDetectors * fg->freqlengthAL * sizeof(REAL4) );
+  fg->maxTwoFXlIdx = (UINT4 *)ALRealloc( NULL, fg->numDetectors * fg->freqlengthAL * sizeof(UINT4) );
+  XLAL_CHECK ( fg->nc && fg->sumTwoF && fg->maxTwoFl && fg->maxTwoFlIdx && fg->sumTwoFX && fg->maxTwoFXl && fg->maxTwoFXlIdx, XLAL_ENOMEM );
+  memset( fg->nc, 0, fg->length * sizeof(FINEGRID_NC_T) );
+  memset( fg->sumTwoF, 0, fg->length * sizeof(REAL4) );
+  memset( fg->maxTwoFl, 0, fg->length * sizeof(REAL4) );
+  memset( fg->maxTwoFlIdx, 0, fg->length * sizeof(UINT4) );
+  memset( fg->sumTwoFX, 0, fg->numDetectors * fg->freqlengthAL * sizeof(REAL4) );
+  memset( fg->maxTwoFXl, 0, fg->numDetectors * fg->freqlengthAL * sizeof(REAL4) );
+  memset( fg->maxTwoFXlIdx, 0, fg->numDetectors * fg->freqlengthAL * sizeof(UINT4) );
+  return XLAL_SUCCESS;
+}
+
+static void CheckFineGridFree ( FineGrid *fg )
+{
+  if ( fg->nc ) ALFree( fg->nc );
+  if ( fg->sumTwoF ) ALFree( fg->sumTwoF );
+  if ( fg->maxTwoFl ) ALFree( fg->maxTwoFl );
+  if ( fg->maxTwoFlIdx ) ALFree( fg->maxTwoFlIdx );
+  if ( fg->sumTwoFX ) ALFree( fg->sumTwoFX );
+  if ( fg->maxTwoFXl ) ALFree( fg->maxTwoFXl );
+  if ( fg->maxTwoFXlIdx ) ALFree( fg->maxTwoFXlIdx );
+}
+
+/* compare fine-grid arrays computed by two kernels */
+static int CheckFineGridCompare ( const FineGrid *fg_tiled, const FineGrid *fg_ref, const BOOLEAN getMaxFperSeg, const char *kernel_name )
+{
+  const REAL4 tol = 1e-6;
+  for ( UINT4 i = 0; i < fg_ref->freqlength; i++ ) {
+    XLAL_CHECK ( fabsf( fg_tiled->sumTwoF[i] - fg_ref->sumTwoF[i] ) <= tol * fabsf( fg_ref->sumTwoF[i] ), XLAL_ETOL,
+                 "Kernel '%s': sumTwoF[%u] = %.9g differs from segment-wise result %.9g", kernel_name, i, fg_tiled->sumTwoF[i], fg_ref->sumTwoF[i] );
+    XLAL_CHECK ( fg_tiled->nc[i] == fg_ref->nc[i], XLAL_ETOL,
+                 "Kernel '%s': nc[%u] = %u differs from segment-wise result %u", kernel_name, i, (UINT4) fg_tiled->nc[i], (UINT4) fg_ref->nc[i] );
+    if ( getMaxFperSeg ) {
+      XLAL_CHECK ( fg_tiled->maxTwoFl[i] == fg_ref->maxTwoFl[i] && fg_tiled->maxTwoFlIdx[i] == fg_ref->maxTwoFlIdx[i], XLAL_ETOL,
+                   "Kernel '%s': maxTwoFl[%u] = %.9g (segment %u) differs from segment-wise result %.9g (segment %u)", kernel_name, i,
+                   fg_tiled->maxTwoFl[i], fg_tiled->maxTwoFlIdx[i], fg_ref->maxTwoFl[i], fg_ref->maxTwoFlIdx[i] );
+    }
+    for ( UINT4 X = 0; X < fg_ref->numDetectors; X++ ) {
+      const UINT4 j = FG_FX_INDEX(*fg_ref, X, i);
+      XLAL_CHECK ( fabsf( fg_tiled->sumTwoFX[j] - fg_ref->sumTwoFX[j] ) <= tol * fabsf( fg_ref->sumTwoFX[j] ), XLAL_ETOL,
+                   "Kernel '%s': sumTwoFX[%u][%u] = %.9g differs from segment-wise result %.9g", kernel_name, X, i, fg_tiled->sumTwoFX[j], fg_ref->sumTwoFX[j] );
+      if ( getMaxFperSeg ) {
+        XLAL_CHECK ( fg_tiled->maxTwoFXl[j] == fg_ref->maxTwoFXl[j] && fg_tiled->maxTwoFXlIdx[j] == fg_ref->maxTwoFXlIdx[j], XLAL_ETOL,
+                     "Kernel '%s': maxTwoFXl[%u][%u] = %.9g (segment %u) differs from segment-wise result %.9g (segment %u)", kernel_name, X, i,
+                     fg_tiled->maxTwoFXl[j], fg_tiled->maxTwoFXlIdx[j], fg_ref->maxTwoFXl[j], fg_ref->maxTwoFXlIdx[j] );
+      }
+    }
+  }
+  return XLAL_SUCCESS;
+}
+
+/**
+ * Check a tiled fine-grid summation kernel against the segment-wise kernel (i.e. the SSE2
+ * hotloops when compiled with GC_SSE2_OPT), using pseudo-random coarse-grid 2F values.
+ * Returns XLAL_ETOL if the results differ.
+ */
+int XLALGCTHotloopCheck ( const GCTHotloopKernel kernel, const UINT4 numThreads )
+{
+
+  /* sizes are chosen so that tiles and vector loops have remainders */
+  const UINT4 nStacks = 7;
+  const UINT4 numDetectors = 2;
+  const UINT4 fg_freqlength = 1003;
+  const UINT4 tileLength = 3 * TILE_ALIGN;
+  const REAL4 TwoFthreshold = 2.0 * 2.6;
+
+  int retn = XLAL_FAILURE;
+  CoarseGrid XLAL_INIT_DECL(cg);
+  FineGrid XLAL_INIT_DECL(fg_ref);
+  FineGrid XLAL_INIT_DECL(fg_tiled);
+  INT4 *U1idx = NULL;
+
+  /* create coarse grid with pseudo-random 2F values and offsets */
+  cg.nStacks = nStacks;
+  cg.freqlength = fg_freqlength + 37;
+  cg.length = cg.nStacks * cg.freqlength;
+  cg.numDetectors = numDetectors;
+  XLAL_CHECK_FAIL ( ( cg.TwoF = XLALCalloc( cg.length, sizeof(REAL4) ) ) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK_FAIL ( ( cg.TwoFX = XLALCalloc( cg.numDetectors * cg.length, sizeof(REAL4) ) ) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK_FAIL ( ( U1idx = XLALCalloc( nStacks, sizeof(INT4) ) ) != NULL, XLAL_ENOMEM );
+  UINT4 seed = 20170901;
+#define CHECK_RAND() ( seed = 1664525 * seed + 1013904223, (REAL4) ( seed >> 8 ) / (REAL4) ( 1 << 24 ) )
+  for ( UINT4 i = 0; i < cg.length; i++ ) {
+    cg.TwoF[i] = 12.0 * CHECK_RAND();
+  }
+  for ( UINT4 i = 0; i < cg.numDetectors * cg.length; i++ ) {
+    cg.TwoFX[i] = 8.0 * CHECK_RAND();
+  }
+  for ( UINT4 k = 0; k < nStacks; k++ ) {
+    U1idx[k] = (INT4) ( ( cg.freqlength - fg_freqlength ) * CHECK_RAND() );
+  }
+#undef CHECK_RAND
+
+  for ( int getMaxFperSeg = 0; getMaxFperSeg <= 1; getMaxFperSeg++ ) {
+
+    /* create fine grids */
+    fg_ref.length = fg_ref.freqlength = fg_freqlength;
+    fg_ref.freqlengthAL = ( ( fg_freqlength + 3 ) / 4 ) * 4;
+    fg_ref.numDetectors = numDetectors;
+    fg_tiled = fg_ref;
+    XLAL_CHECK_FAIL ( CheckFineGridAlloc( &fg_ref ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_FAIL ( CheckFineGridAlloc( &fg_tiled ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    /* sum fine grids */
+    for ( UINT4 k = 0; k < nStacks; k++ ) {
+      XLAL_CHECK_FAIL ( XLALGCTHotloopSumSegment( &fg_ref, &cg, k, U1idx[k], TwoFthreshold, getMaxFperSeg, TRUE ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+    XLAL_CHECK_FAIL ( XLALGCTHotloopSumFineGrid( &fg_tiled, &cg, nStacks, U1idx, TwoFthreshold, getMaxFperSeg, TRUE, kernel, tileLength, numThreads ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    /* compare fine grids */
+    XLAL_CHECK_FAIL ( CheckFineGridCompare( &fg_tiled, &fg_ref, getMaxFperSeg, XLALGCTHotloopName( kernel ) ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    CheckFineGridFree( &fg_ref );
+    CheckFineGridFree( &fg_tiled );
+    XLAL_INIT_MEM( fg_ref );
+    XLAL_INIT_MEM( fg_tiled );
+
+  }
+
+  retn = XLAL_SUCCESS;
+
+XLAL_FAIL:
+
+  /* cleanup */
+  CheckFineGridFree( &fg_ref );
+  CheckFineGridFree( &fg_tiled );
+  XLALFree( cg.TwoF );
+  XLALFree( cg.TwoFX );
+  XLALFree( U1idx );
+
+  return retn;
+
+} /* XLALGCTHotloopCheck() */
@@ -0,0 +1,83 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+/**
+ * \file
+ * \ingroup lalapps_pulsar_GCT
+ *
+ * \brief Kernels which sum coarse-grid 2F values onto the GCT fine grid
+ *
+ * The segment-wise kernel adds the coarse-grid 2F values of one segment to the
+ * whole fine grid, and is called once per segment; it uses the SSE2 hotloops
+ * in gc_hotloop_sse2.h when compiled with GC_SSE2_OPT. The tiled kernels
+ * instead split the fine grid into frequency tiles which fit into the L2 cache,
+ * and add all segments to one tile before moving on to the next tile; tiles are
+ * independent and are distributed over OpenMP threads. All kernels add segments
+ * to each fine-grid bin in the same order, and so give identical results.
+ */
+
+#ifndef _GCTHOTLOOP_H  /* Double-include protection. */
+#define _GCTHOTLOOP_H
+
+#include "HierarchSearchGCT.h"
+
+/* C++ protection. */
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+/*---------- exported DEFINES ----------*/
+
+/** Size in bytes of the L2 cache that fine-grid tiles are sized to fit into */
+#define GCT_HOTLOOP_L2_BYTES (256 * 1024)
+
+/*---------- exported types ----------*/
+
+/** Kernels used to sum coarse-grid 2F values onto the fine grid */
+typedef enum tagGCTHotloopKernel {
+  GCT_HOTLOOP_AUTO,		/**< select the fastest AVX tiled kernel supported by this CPU, otherwise the segment-wise kernel */
+  GCT_HOTLOOP_SEGMENTWISE,	/**< walk the whole fine grid once per segment */
+  GCT_HOTLOOP_GENERIC,		/**< tiled kernel in plain C */
+  GCT_HOTLOOP_AVX2,		/**< tiled kernel using AVX2 instructions */
+  GCT_HOTLOOP_AVX512F,		/**< tiled kernel using AVX-512F instructions */
+} GCTHotloopKernel;
+
+/*---------- exported Global variables ----------*/
+
+/** Names of fine-grid summation kernels, for use with UserInput */
+extern const UserChoices GCTHotloopKernelChoices;
+
+/*---------- exported prototypes [API] ----------*/
+
+int XLALGCTHotloopSelect ( GCTHotloopKernel *selected, const GCTHotloopKernel requested );
+
+const char *XLALGCTHotloopName ( const GCTHotloopKernel kernel );
+
+int XLALGCTHotloopSumSegment ( FineGrid *finegrid, const CoarseGrid *coarsegrid, const UINT4 k, const INT4 U1idx,
+                               const REAL4 TwoFthreshold, const BOOLEAN getMaxFperSeg, const BOOLEAN computeBSGL );
+
+int XLALGCTHotloopSumFineGrid ( FineGrid *finegrid, const CoarseGrid *coarsegrid, const UINT4 nStacks, const INT4 *U1idx,
+                                const REAL4 TwoFthreshold, const BOOLEAN getMaxFperSeg, const BOOLEAN computeBSGL,
+                                const GCTHotloopKernel kernel, UINT4 tileLength, UINT4 numThreads );
+
+int XLALGCTHotloopCheck ( const GCTHotloopKernel kernel, const UINT4 numThreads );
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif  /* Double-include protection. */
@@ -44,6 +44,7 @@
 #include <RecalcToplistStats.h>
 
 #include "HierarchSearchGCT.h"
+#include "GCTHotloop.h"
 
 #ifdef GC_SSE2_OPT
 #include <gc_hotloop_sse2.h>
@@ -436,6 +437,9 @@ int main( int argc, char *argv[]) {
   int uvar_FstatMethod = FstatOptionalArgsDefaults.FstatMethod;
   int uvar_FstatMethodRecalc = FstatOptionalArgsDefaults.FstatMethod;
 
+  int uvar_hotloop = GCT_HOTLOOP_AUTO;
+  UINT4 uvar_numThreads = 1;
+
   timingInfo_t XLAL_INIT_DECL(timing);
 
   LALStringVector *uvar_injectionSources = NULL;
@@ -532,6 +536,8 @@ int main( int argc, char *argv[]) {
   XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_Dterms,              "Dterms",              INT4,         0,   DEVELOPER,  "Number of kernel terms (single-sided) to use in\na) Dirichlet kernel if FstatMethod=Demod*\nb) sinc-interpolation kernel if FstatMethod=Resamp*" ) == XLAL_SUCCESS, XLAL_EFUNC);
   XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_DtermsRecalc,        "DtermsRecalc",        INT4,         0,   DEVELOPER,  "Same as 'Dterms', applies to 'Recalc' step" ) == XLAL_SUCCESS, XLAL_EFUNC);
   XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_skyPointIndex,       "skyPointIndex",       INT4,         0,   DEVELOPER,  "Only analyze this skypoint in grid" ) == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK_MAIN( XLALRegisterNamedUvarAuxData( &uvar_hotloop,      "hotloop",      UserEnum, &GCTHotloopKernelChoices, 0, DEVELOPER, "Kernel summing coarse-grid 2F values onto the fine grid: 'segmentwise' walks the whole fine grid once per segment; 'generic', 'avx2' and 'avx512f' sum all segments within L2-sized frequency tiles of the fine grid; 'auto' selects the fastest supported AVX kernel, otherwise 'segmentwise'") == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_numThreads,          "numThreads",          UINT4,        0,   DEVELOPER,  "Number of threads over which tiled 'hotloop' kernels distribute fine-grid tiles (0=use all available threads)" ) == XLAL_SUCCESS, XLAL_EFUNC);
 
   XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_outputTiming,        "outputTiming",        STRING,       0,   DEVELOPER,  "Append timing information into this file") == XLAL_SUCCESS, XLAL_EFUNC);
   XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_outputTimingDetails, "outputTimingDetails", STRING,       0,   DEVELOPER,  "Append detailed averaged F-stat timing information to this file") == XLAL_SUCCESS, XLAL_EFUNC);
@@ -557,6 +563,14 @@ int main( int argc, char *argv[]) {
   LogPrintfVerbatim( LOG_DEBUG, "Code-version: %s\n", VCSInfoString );
   // LogPrintfVerbatim( LOG_DEBUG, "CFS Hotloop variant: %s\n", OptimisedHotloopSource );
 
+  /* select kernel for summing the fine grid, and check tiled kernels against the segment-wise kernel */
+  GCTHotloopKernel hotloopKernel;
+  XLAL_CHECK_MAIN( XLALGCTHotloopSelect( &hotloopKernel, uvar_hotloop ) == XLAL_SUCCESS, XLAL_EFUNC );
+  if ( hotloopKernel != GCT_HOTLOOP_SEGMENTWISE ) {
+    XLAL_CHECK_MAIN( XLALGCTHotloopCheck( hotloopKernel, uvar_numThreads ) == XLAL_SUCCESS, XLAL_EFUNC, "Fine-grid summation kernel '%s' failed accuracy check", XLALGCTHotloopName( hotloopKernel ) );
+  }
+  LogPrintf( LOG_DEBUG, "Fine-grid summation kernel: %s\n", XLALGCTHotloopName( hotloopKernel ) );
+
   /* some basic sanity checks on user vars */
   if ( uvar_nStacksMax < 1) {
     fprintf(stderr, "Invalid number of segments!\n");
@@ -878,6 +892,10 @@ int main( int argc, char *argv[]) {
       loudestTwoFPerSeg = XLALCalloc ( nStacks, sizeof(REAL4) );
     } // if loudestTwoFPerSeg
 
+  /* coarse-grid frequency offsets of the fine grid in each segment, for tiled fine-grid summation */
+  INT4 *U1idxSeg = NULL;
+  XLAL_CHECK_MAIN( ( U1idxSeg = XLALCalloc ( nStacks, sizeof(*U1idxSeg) ) ) != NULL, XLAL_ENOMEM );
+
   /* free segment list */
   if ( usefulParams.segmentList )
     if ( XLALSegListClear( usefulParams.segmentList ) != XLAL_SUCCESS )
@@ -1607,100 +1625,22 @@ int main( int argc, char *argv[]) {
                   return(HIERARCHICALSEARCH_ECG);
                 }
 
-                /* coarse grid over frequency for this stack */
-                REAL4 * cgrid2F = coarsegrid.TwoF + CG_INDEX(coarsegrid, k, U1idx);
-
-                /* fine grid over frequency */
-                REAL4 * fgrid2F = finegrid.sumTwoF + FG_INDEX(finegrid, 0);
-#ifndef EXP_NO_NUM_COUNT
-                FINEGRID_NC_T * fgridnc = finegrid.nc + FG_INDEX(finegrid, 0);
-#endif
-
-#ifdef GC_SSE2_OPT
-                if ( uvar_getMaxFperSeg ) {
-                  /* disables number count keeping */
-                  REAL4 * fgrid2Fmax = finegrid.maxTwoFl + FG_INDEX(finegrid, 0);
-                  UINT4 * fgrid2FmaxIdx = finegrid.maxTwoFlIdx + FG_INDEX(finegrid, 0);
-
-                  gc_hotloop_2Fmax_tracking (fgrid2F, fgrid2Fmax, fgrid2FmaxIdx, cgrid2F, k, finegrid.freqlength);
+                if ( hotloopKernel == GCT_HOTLOOP_SEGMENTWISE ) {
+                  XLAL_CHECK_MAIN( XLALGCTHotloopSumSegment( &finegrid, &coarsegrid, k, U1idx, TwoFthreshold, uvar_getMaxFperSeg, uvar_computeBSGL ) == XLAL_SUCCESS, XLAL_EFUNC );
                 } else {
-#ifndef EXP_NO_NUM_COUNT
-                  gc_hotloop( fgrid2F, cgrid2F, fgridnc, TwoFthreshold, finegrid.freqlength );
-#else
-                  gc_hotloop_no_nc ( fgrid2F, cgrid2F, finegrid.freqlength );
-#endif
-		}
-                if ( uvar_computeBSGL ) {
-                  for (UINT4 X = 0; X < finegrid.numDetectors; X++) {
-                    REAL4 * cgrid2FX = coarsegrid.TwoFX + CG_FX_INDEX(coarsegrid, X, k, U1idx);
-                    REAL4 * fgrid2FX = finegrid.sumTwoFX + FG_FX_INDEX(finegrid, X, 0);
-
-                    if ( uvar_getMaxFperSeg ) {
-                      REAL4 * fgrid2FXmax = finegrid.maxTwoFXl + FG_FX_INDEX(finegrid,X, 0);
-                      UINT4 * fgrid2FXmaxIdx = finegrid.maxTwoFXlIdx + FG_FX_INDEX(finegrid,X, 0);
-
-                      gc_hotloop_2Fmax_tracking (fgrid2FX, fgrid2FXmax, fgrid2FXmaxIdx, cgrid2FX, k, finegrid.freqlength  );
-                    } else {
-                      gc_hotloop_no_nc( fgrid2FX, cgrid2FX, finegrid.freqlength );
-                    }
-                  } /* for  X  */
+                  /* tiled kernels sum all segments after this loop */
+                  U1idxSeg[k] = U1idx;
                 }
-#else // GC_SSE2_OPT
-                for(UINT4 ifreq_fg=0; ifreq_fg < finegrid.freqlength; ifreq_fg++) {
-                  fgrid2F[0] += cgrid2F[0];
-#ifndef EXP_NO_NUM_COUNT
-                  fgridnc[0] += (TwoFthreshold < cgrid2F[0]);
-                  fgridnc++;
-#endif // EXP_NO_NUM_COUNT
-                  fgrid2F++;
-                  cgrid2F++;
-                }
-                if ( uvar_computeBSGL ) {
-                  for (UINT4 X = 0; X < finegrid.numDetectors; X++) {
-                    REAL4 * cgrid2FX = coarsegrid.TwoFX + CG_FX_INDEX(coarsegrid, X, k, U1idx);
-                    REAL4 * fgrid2FX = finegrid.sumTwoFX + FG_FX_INDEX(finegrid, X, 0);
-                    for(UINT4 ifreq_fg=0; ifreq_fg < finegrid.freqlength; ifreq_fg++) {
-                      fgrid2FX[0] += cgrid2FX[0];
-                      fgrid2FX++;
-                      cgrid2FX++;
-                    }
-                  }
-                }
-
-
-                if ( uvar_getMaxFperSeg ) {
-                  cgrid2F = coarsegrid.TwoF + CG_INDEX(coarsegrid, k, U1idx);
-                  REAL4 * fgridMax2Fl = finegrid.maxTwoFl + FG_INDEX(finegrid, 0);
-                  UINT4 * fgrid2FmaxIdx = finegrid.maxTwoFlIdx + FG_INDEX(finegrid, 0);
-                  int isLouder;
-                  for (UINT4 ifreq_fg=0; ifreq_fg < finegrid.freqlength; ifreq_fg++) {
-                    isLouder=(fgridMax2Fl[0] <= cgrid2F[0]);
-                    fgridMax2Fl[0] = fmaxf ( fgridMax2Fl[0], cgrid2F[0] );
-                    fgrid2FmaxIdx[0]= isLouder*k + (1-isLouder)*fgrid2FmaxIdx[0];
-                    fgridMax2Fl++;
-                    fgrid2FmaxIdx++;
-                    cgrid2F++;
-                  }
-                  for (UINT4 X = 0; X < finegrid.numDetectors; X++) {
-                    REAL4 * cgrid2FX = coarsegrid.TwoFX + CG_FX_INDEX(coarsegrid, X, k, U1idx);
-                    REAL4 * fgridMax2FXl = finegrid.maxTwoFXl + FG_FX_INDEX(finegrid, X, 0);
-                    UINT4 * fgrid2FXmaxIdx = finegrid.maxTwoFXlIdx + FG_FX_INDEX(finegrid,X, 0);
-
-                    for(UINT4 ifreq_fg=0; ifreq_fg < finegrid.freqlength; ifreq_fg++) {
-                      isLouder=(fgridMax2FXl[0] <= cgrid2FX[0]);
-                      fgridMax2FXl[0] = fmaxf ( fgridMax2FXl[0], cgrid2FX[0] );
-                      fgrid2FXmaxIdx[0] = isLouder*k + (1-isLouder)*fgrid2FXmaxIdx[0];
-                      fgrid2FXmaxIdx++;
-                      fgridMax2FXl++;
-                      cgrid2FX++;
-                    }
-                  }
-                }
-#endif // GC_SSE2_OPT
                 time_SumFine += ( GETTIME() - tic_SumFine );
 
               } /* end: ------------- MAIN LOOP over Segments --------------------*/
 
+              if ( hotloopKernel != GCT_HOTLOOP_SEGMENTWISE ) {
+                tic_SumFine = GETTIME();
+                XLAL_CHECK_MAIN( XLALGCTHotloopSumFineGrid( &finegrid, &coarsegrid, nStacks, U1idxSeg, TwoFthreshold, uvar_getMaxFperSeg, uvar_computeBSGL, hotloopKernel, 0, uvar_numThreads ) == XLAL_SUCCESS, XLAL_EFUNC );
+                time_SumFine += ( GETTIME() - tic_SumFine );
+              }
+
               /* ############################################################### */
 
               tic_ExtraStats = GETTIME();
@@ -2022,6 +1962,7 @@ int main( int argc, char *argv[]) {
   XLALFree ( VCSInfoString );
 
   XLALFree ( loudestTwoFPerSeg );
+  XLALFree ( U1idxSeg );
 
   LALCheckMemoryLeaks();
 
@@ -437,6 +437,32 @@ if ! eval "diff ./GCT_RS_triple_3.txt ./GCT_RS_triple2-BtSGLtL.txt"; then
     exit 1
 fi
 
+echo
+echo "----------------------------------------------------------------------------------------------------"
+echo " STEP 8: run HierarchSearchGCT using LALDemod and max-2F tracking over segments without BSGL,"
+echo "          where per-detector 2F values are not summed, compared with the default 2F toplist"
+echo "----------------------------------------------------------------------------------------------------"
+echo
+
+rm -f checkpoint.cpt # delete checkpoint to start correctly
+outfile_GCT_DM_maxF="./GCT_DM_maxF.dat"
+
+cmdline="$gct_code $gct_CL_common --FstatMethod=DemodBest --getMaxFperSeg --fnameout='$outfile_GCT_DM_maxF'"
+
+echo $cmdline
+if ! eval "$cmdline"; then
+    echo "Error.. something failed when running '$gct_code' ..."
+    exit 1
+fi
+
+## candidates, number counts and 2F values should be unchanged by max-2F tracking
+egrep -v "^%" ${outfile_GCT_DM} | awk '{print $1, $2, $3, $4, $5, $6, $7}' | sort > ./GCT_DM_cols.txt
+egrep -v "^%" ${outfile_GCT_DM_maxF} | awk '{print $1, $2, $3, $4, $5, $6, $7}' | sort > ./GCT_DM_maxF_cols.txt
+if ! eval "diff ./GCT_DM_cols.txt ./GCT_DM_maxF_cols.txt"; then
+    echo "Error: toplist with max-2F tracking over segments differs from default 2F toplist"
+    exit 1
+fi
+
 ## ---------- compute relative differences and check against tolerance --------------------
 awk_reldev='{printf "%.2e", sqrt(($1-$2)*($1-$2))/(0.5*($1+$2)) }'
 
@@ -1460,6 +1460,144 @@ void sum_data( LALInferenceRunState *runState ){
   return;
 }
 
+
+/**
+ * \brief Set up the cache used to evaluate the likelihood from pre-summed values when searching over phase parameters
+ *
+ * When searching over phase parameters the signal model at each data point is
+ * \f[
+ * h(t) = \left(M_p a(t) + M_c b(t)\right) e^{2\pi i \Delta\phi(t)},
+ * \f]
+ * (plus equivalent vector and scalar terms for non-GR models) where \f$M_p\f$ and \f$M_c\f$ depend only on the
+ * amplitude parameters, and \f$\Delta\phi(t)\f$ only on the phase parameters. As \f$|e^{2\pi i \Delta\phi(t)}|=1\f$ the
+ * sums over the model squared for each chunk are the same as those for a fixed phase (as already computed by
+ * \c sum_data), and only the sums over the data and model, e.g. \f$\sum_t B(t)a(t)e^{-2\pi i \Delta\phi(t)}\f$, depend on
+ * the phase parameters. This function stores the products of the data with the antenna patterns (divided by the
+ * variance if using the Gaussian likelihood) for each data point, from which \c pulsar_model recomputes the data/model
+ * sums (\c sumDataP, \c sumDataC, etc) only when the phase parameters change. The likelihood is then calculated from
+ * the pre-summed values, so that a change in only the amplitude parameters requires just a handful of multiplications
+ * per chunk.
+ *
+ * The cache is not used when searching over phase parameters with reduced order quadrature, or if the
+ * \c no-phase-cache command line argument is given. This must be called after \c sum_data and after any injection has
+ * been made.
+ *
+ * \param runState [in] The analysis information structure
+ */
+void setup_phase_cache( LALInferenceRunState *runState ){
+  LALInferenceIFOData *data = runState->data;
+  LALInferenceIFOModel *ifomodel = runState->threads[0].model->ifo;
+
+  UINT4 gaussianLike = 0, nonGR = 0, phasecache = 1;
+
+  if ( LALInferenceGetProcParamVal( runState->commandLine, "--roq" ) ){ return; }
+  if ( LALInferenceGetProcParamVal( runState->commandLine, "--no-phase-cache" ) ){ return; }
+  if ( LALInferenceGetProcParamVal( runState->commandLine, "--gaussian-like" ) ){ gaussianLike = 1; }
+  if ( LALInferenceGetProcParamVal( runState->commandLine, "--nonGR" ) ){ nonGR = 1; }
+
+  while( data ){
+    if ( !LALInferenceCheckVariable( ifomodel->params, "varyphase" ) ){
+      data = data->next;
+      ifomodel = ifomodel->next;
+      continue;
+    }
+
+    /* products of the data and the antenna pattern functions */
+    COMPLEX16Vector *dataP = NULL, *dataC = NULL, *dataX = NULL, *dataY = NULL, *dataB = NULL, *dataL = NULL;
+
+    REAL8Vector *arespT = *(REAL8Vector **)LALInferenceGetVariable( ifomodel->params, "a_response_tensor" );
+    REAL8Vector *brespT = *(REAL8Vector **)LALInferenceGetVariable( ifomodel->params, "b_response_tensor" );
+    REAL8Vector *arespV = NULL, *brespV = NULL, *arespS = NULL, *brespS = NULL;
+
+    if ( nonGR ){
+      arespV = *(REAL8Vector **)LALInferenceGetVariable( ifomodel->params, "a_response_vector" );
+      brespV = *(REAL8Vector **)LALInferenceGetVariable( ifomodel->params, "b_response_vector" );
+      arespS = *(REAL8Vector **)LALInferenceGetVariable( ifomodel->params, "a_response_scalar" );
+      brespS = *(REAL8Vector **)LALInferenceGetVariable( ifomodel->params, "b_response_scalar" );
+    }
+
+    INT4 tsteps = *(INT4 *)LALInferenceGetVariable( ifomodel->params, "timeSteps" );
+    REAL8 tsv = LAL_DAYSID_SI / tsteps;
+
+    REAL8Vector *sidDayFrac = *(REAL8Vector**)LALInferenceGetVariable( ifomodel->params, "siderealDay" );
+
+    UINT4 length = data->compTimeData->data->length;
+
+    dataP = XLALCreateCOMPLEX16Vector( length );
+    dataC = XLALCreateCOMPLEX16Vector( length );
+
+    if ( nonGR ){
+      dataX = XLALCreateCOMPLEX16Vector( length );
+      dataY = XLALCreateCOMPLEX16Vector( length );
+      dataB = XLALCreateCOMPLEX16Vector( length );
+      dataL = XLALCreateCOMPLEX16Vector( length );
+    }
+
+    for ( UINT4 j = 0; j < length; j++ ){
+      REAL8 vari = 1., a0 = 0., a1 = 0., b0 = 0., b1 = 0.;
+      COMPLEX16 B = data->compTimeData->data->data[j];
+
+      if ( gaussianLike ) { vari = data->varTimeData->data->data[j]; }
+
+      /* set the time bin for the lookup table and interpolate between bins */
+      REAL8 T = sidDayFrac->data[j];
+      INT4 timebinMin = (INT4)fmod( floor(T / tsv), tsteps );
+      REAL8 timeMin = timebinMin*tsv;
+      INT4 timebinMax = (INT4)fmod( timebinMin + 1, tsteps );
+      REAL8 timeMax = timeMin + tsv;
+      REAL8 timeScaled = (T - timeMin)/(timeMax - timeMin);
+
+      a0 = arespT->data[timebinMin];
+      a1 = arespT->data[timebinMax];
+      b0 = brespT->data[timebinMin];
+      b1 = brespT->data[timebinMax];
+
+      dataP->data[j] = B*(a0 + (a1-a0)*timeScaled)/vari;
+      dataC->data[j] = B*(b0 + (b1-b0)*timeScaled)/vari;
+
+      if ( nonGR ){
+        a0 = arespV->data[timebinMin];
+        a1 = arespV->data[timebinMax];
+        b0 = brespV->data[timebinMin];
+        b1 = brespV->data[timebinMax];
+
+        dataX->data[j] = B*(a0 + (a1-a0)*timeScaled)/vari;
+        dataY->data[j] = B*(b0 + (b1-b0)*timeScaled)/vari;
+
+        a0 = arespS->data[timebinMin];
+        a1 = arespS->data[timebinMax];
+        b0 = brespS->data[timebinMin];
+        b1 = brespS->data[timebinMax];
+
+        dataB->data[j] = B*(a0 + (a1-a0)*timeScaled)/vari;
+        dataL->data[j] = B*(b0 + (b1-b0)*timeScaled)/vari;
+      }
+    }
+
+    check_and_add_fixed_variable( ifomodel->params, "phaseCacheDataP", &dataP, LALINFERENCE_COMPLEX16Vector_t );
+    check_and_add_fixed_variable( ifomodel->params, "phaseCacheDataC", &dataC, LALINFERENCE_COMPLEX16Vector_t );
+
+    if ( nonGR ){
+      check_and_add_fixed_variable( ifomodel->params, "phaseCacheDataX", &dataX, LALINFERENCE_COMPLEX16Vector_t );
+      check_and_add_fixed_variable( ifomodel->params, "phaseCacheDataY", &dataY, LALINFERENCE_COMPLEX16Vector_t );
+      check_and_add_fixed_variable( ifomodel->params, "phaseCacheDataB", &dataB, LALINFERENCE_COMPLEX16Vector_t );
+      check_and_add_fixed_variable( ifomodel->params, "phaseCacheDataL", &dataL, LALINFERENCE_COMPLEX16Vector_t );
+    }
+
+    /* remove any previously cached phase parameters, so that the data/model sums get recomputed */
+    if ( LALInferenceCheckVariable( ifomodel->params, "phaseCacheKey" ) ){
+      LALInferenceRemoveVariable( ifomodel->params, "phaseCacheKey" );
+    }
+
+    check_and_add_fixed_variable( ifomodel->params, "phasecache", &phasecache, LALINFERENCE_UINT4_t );
+
+    data = data->next;
+    ifomodel = ifomodel->next;
+  }
+
+  return;
+}
+
 /**
  * \brief Parse data from a prior file containing Gaussian Mixture Model mean values
  *
@@ -49,6 +49,7 @@ void add_correlation_matrix( LALInferenceVariables *ini,
                              LALInferenceVariables *priors, REAL8Array *corMat,
                              LALStringVector *parMat );
 void sum_data( LALInferenceRunState *runState );
+void setup_phase_cache( LALInferenceRunState *runState );
 void LogSampleToFile(LALInferenceVariables *algorithmParams, LALInferenceVariables *vars);
 void LogSampleToArray(LALInferenceVariables *algorithmParams, LALInferenceVariables *vars);
 REAL8Vector** parse_gmm_means(CHAR *meanstr, UINT4 npars, UINT4 nmodes);
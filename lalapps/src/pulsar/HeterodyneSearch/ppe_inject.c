@@ -494,7 +494,8 @@ REAL8 calculate_time_domain_snr( LALInferenceIFOData *data, LALInferenceIFOModel
   REAL8Vector *sumYB = NULL, *sumYL = NULL;
   REAL8Vector *sumBL = NULL;
 
-  if ( LALInferenceCheckVariable( ifo_model->params, "varyphase" ) ){ varyphase = 1; }
+  /* if using the phase cache the model is in the pre-summed form (the SNR does not depend on the phase) */
+  if ( LALInferenceCheckVariable( ifo_model->params, "varyphase" ) && !LALInferenceCheckVariable( ifo_model->params, "phasecache" ) ){ varyphase = 1; }
   if ( LALInferenceCheckVariable( ifo_model->params, "nonGR" ) ){ nonGR = 1; }
   if ( LALInferenceCheckVariable( ifo_model->params, "roq" ) ){ roq = 1; }
 
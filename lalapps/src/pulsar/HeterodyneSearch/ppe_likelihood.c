@@ -109,7 +109,8 @@ REAL8 pulsar_log_likelihood( LALInferenceVariables *vars, LALInferenceIFOData *d
       COMPLEX16Vector *sumDataP = NULL, *sumDataC = NULL, *sumDataX = NULL, *sumDataY = NULL, *sumDataB = NULL, *sumDataL = NULL;
       INT4 varyphase = 0;
 
-      if ( LALInferenceCheckVariable( ifomodeltemp->params, "varyphase" ) ){ varyphase = 1; }
+      /* if using the phase cache the data/model sums for the current phase parameters have been pre-computed */
+      if ( LALInferenceCheckVariable( ifomodeltemp->params, "varyphase" ) && !LALInferenceCheckVariable( ifomodeltemp->params, "phasecache" ) ){ varyphase = 1; }
 
       length = tempdata->compTimeData->data->length;
 
@@ -398,6 +398,10 @@ void add_variable_parameter( PulsarParameters *params, LALInferenceVariables *va
  * This does not try to undo the signal modulation in the data, but instead replicates the modulation in the model,
  * hence the positive phase difference rather than a negative phase in the exponential function.
  *
+ * If the phase cache has been set up (see \c setup_phase_cache) the model is instead kept in the pre-summed form used
+ * when not searching over phase parameters, and the phase is applied to the cached data/model sums, which are only
+ * recomputed when the phase parameters have changed.
+ *
  * \param params [in] A \c PulsarParameters structure containing the model parameters
  * \param ifo [in] The ifo model structure containing the detector paramters and buffers
  *
@@ -415,7 +419,23 @@ void pulsar_model( PulsarParameters *params, LALInferenceIFOModel *ifo ){
   /* check whether to search over the phase parameters or not - this only needs to be set for the
    * first ifo linked list in at set for a given detector (i.e. it doesn't need to be set for
    * different frequency streams */
-  if ( LALInferenceCheckVariable( ifomodel2->params, "varyphase" ) ) {
+  if ( LALInferenceCheckVariable( ifomodel2->params, "varyphase" ) && LALInferenceCheckVariable( ifomodel2->params, "phasecache" ) ) {
+    /* update the cached data/model sums (these only need recomputing if the phase parameters have changed) */
+    REAL8Vector *freqFactors = NULL;
+    freqFactors = *(REAL8Vector **)LALInferenceGetVariable( ifo->params, "freqfactors" );
+
+    REAL8Vector *phasekey = get_phase_parameter_key( params );
+
+    while ( ifomodel2 ){
+      for( j = 0; j < freqFactors->length; j++ ){
+        update_phase_cache( params, phasekey, ifomodel2, freqFactors->data[j] );
+        ifomodel2 = ifomodel2->next;
+      }
+    }
+
+    XLALDestroyREAL8Vector( phasekey );
+  }
+  else if ( LALInferenceCheckVariable( ifomodel2->params, "varyphase" ) ) {
     /* get difference in phase for f component and perform extra heterodyne */
     REAL8Vector *freqFactors = NULL;
     freqFactors = *(REAL8Vector **)LALInferenceGetVariable( ifo->params, "freqfactors" );
@@ -451,6 +471,181 @@ void pulsar_model( PulsarParameters *params, LALInferenceIFOModel *ifo ){
 }
 
 
+/**
+ * \brief Check whether a parameter is an amplitude parameter
+ *
+ * Amplitude parameters are those given in \c amppars, or those with an \c _F suffix (for the emission at the rotation
+ * frequency in non-GR models) whose base name is given in \c amppars.
+ *
+ * \param name [in] The parameter name
+ *
+ * \return 1 if the parameter is an amplitude parameter and 0 otherwise
+ */
+INT4 is_amplitude_parameter( const CHAR *name ){
+  CHAR basename[PULSAR_PARNAME_MAX];
+  size_t len = strlen( name );
+
+  snprintf( basename, sizeof(basename), "%s", name );
+  if ( len > 2 && len < PULSAR_PARNAME_MAX && !strcmp( name + len - 2, "_F" ) ){ basename[len-2] = '\0'; }
+
+  for ( UINT4 i = 0; i < NUMAMPPARS; i++ ){
+    if ( !strcmp( name, amppars[i] ) || !strcmp( basename, amppars[i] ) ){ return 1; }
+  }
+
+  return 0;
+}
+
+
+/**
+ * \brief Get the values of all the parameters on which the signal phase depends
+ *
+ * All \c REAL8 and \c REAL8Vector parameters that are not amplitude parameters (see \c amppars) are concatenated, in
+ * the order in which they are stored, into a single vector. Two sets of parameters (created in the same way by
+ * \c get_pulsar_model) give the same phase model if these vectors are identical.
+ *
+ * \param params [in] A set of pulsar parameters
+ *
+ * \return A vector of the phase parameter values
+ *
+ * \sa update_phase_cache
+ */
+REAL8Vector *get_phase_parameter_key( PulsarParameters *params ){
+  REAL8Vector *key = NULL;
+  UINT4 n = 0;
+
+  /* get the number of values */
+  for ( PulsarParam *item = params->head; item != NULL; item = item->next ){
+    if ( is_amplitude_parameter( item->name ) ){ continue; }
+
+    if ( item->type == PULSARTYPE_REAL8_t ){ n++; }
+    else if ( item->type == PULSARTYPE_REAL8Vector_t ){ n += (*(REAL8Vector **)item->value)->length; }
+  }
+
+  key = XLALCreateREAL8Vector( n );
+
+  n = 0;
+  for ( PulsarParam *item = params->head; item != NULL; item = item->next ){
+    if ( is_amplitude_parameter( item->name ) ){ continue; }
+
+    if ( item->type == PULSARTYPE_REAL8_t ){ key->data[n++] = *(REAL8 *)item->value; }
+    else if ( item->type == PULSARTYPE_REAL8Vector_t ){
+      const REAL8Vector *vec = *(REAL8Vector **)item->value;
+      for ( UINT4 i = 0; i < vec->length; i++ ){ key->data[n++] = vec->data[i]; }
+    }
+  }
+
+  return key;
+}
+
+
+/**
+ * \brief Update the cached data/model sums for the current phase parameters
+ *
+ * If the phase parameters (as given by \c get_phase_parameter_key) differ from those for which the cached sums in
+ * \c ifo were last computed, the phase model is recalculated with \c get_phase_model and the sums of the data
+ * multiplied by the antenna patterns and the conjugate of the phase factor, e.g.
+ * \f$\sum_t B(t)a(t)e^{-2\pi i \Delta\phi(t)}\f$, are recomputed for each chunk. Otherwise nothing is done, as the
+ * cached sums are still valid. See \c setup_phase_cache for details.
+ *
+ * \param params [in] A set of pulsar parameters
+ * \param phasekey [in] The phase parameter values returned by \c get_phase_parameter_key for \c params
+ * \param ifo [in] The ifo model structure for a single detector and frequency factor
+ * \param freqFactor [in] the multiplicative factor on the pulsar frequency for a particular model
+ *
+ * \sa setup_phase_cache
+ */
+void update_phase_cache( PulsarParameters *params, REAL8Vector *phasekey, LALInferenceIFOModel *ifo, REAL8 freqFactor ){
+  UINT4 nonGR = 0;
+
+  /* check if the sums are for the current phase parameters */
+  if ( LALInferenceCheckVariable( ifo->params, "phaseCacheKey" ) ){
+    REAL8Vector **cachekey = (REAL8Vector **)LALInferenceGetVariable( ifo->params, "phaseCacheKey" );
+
+    UINT4 k = 0;
+    if ( (*cachekey)->length == phasekey->length ){
+      for ( k = 0; k < phasekey->length; k++ ){
+        if ( (*cachekey)->data[k] != phasekey->data[k] ){ break; }
+      }
+    }
+    if ( (*cachekey)->length == phasekey->length && k == phasekey->length ){ return; }
+
+    /* store the new phase parameters */
+    if ( (*cachekey)->length != phasekey->length ){
+      XLALDestroyREAL8Vector( *cachekey );
+      *cachekey = XLALCreateREAL8Vector( phasekey->length );
+    }
+    for ( k = 0; k < phasekey->length; k++ ){ (*cachekey)->data[k] = phasekey->data[k]; }
+  }
+  else{
+    REAL8Vector *cachekey = XLALCreateREAL8Vector( phasekey->length );
+    for ( UINT4 k = 0; k < phasekey->length; k++ ){ cachekey->data[k] = phasekey->data[k]; }
+    LALInferenceAddVariable( ifo->params, "phaseCacheKey", &cachekey, LALINFERENCE_REAL8Vector_t, LALINFERENCE_PARAM_FIXED );
+  }
+
+  if ( LALInferenceCheckVariable( ifo->params, "nonGR" ) ){ nonGR = 1; }
+
+  UINT4Vector *chunkLengths = *(UINT4Vector **)LALInferenceGetVariable( ifo->params, "chunkLength" );
+
+  COMPLEX16Vector *dataP = *(COMPLEX16Vector **)LALInferenceGetVariable( ifo->params, "phaseCacheDataP" );
+  COMPLEX16Vector *dataC = *(COMPLEX16Vector **)LALInferenceGetVariable( ifo->params, "phaseCacheDataC" );
+  COMPLEX16Vector *sumDataP = *(COMPLEX16Vector **)LALInferenceGetVariable( ifo->params, "sumDataP" );
+  COMPLEX16Vector *sumDataC = *(COMPLEX16Vector **)LALInferenceGetVariable( ifo->params, "sumDataC" );
+
+  COMPLEX16Vector *dataX = NULL, *dataY = NULL, *dataB = NULL, *dataL = NULL;
+  COMPLEX16Vector *sumDataX = NULL, *sumDataY = NULL, *sumDataB = NULL, *sumDataL = NULL;
+
+  if ( nonGR ){
+    dataX = *(COMPLEX16Vector **)LALInferenceGetVariable( ifo->params, "phaseCacheDataX" );
+    dataY = *(COMPLEX16Vector **)LALInferenceGetVariable( ifo->params, "phaseCacheDataY" );
+    dataB = *(COMPLEX16Vector **)LALInferenceGetVariable( ifo->params, "phaseCacheDataB" );
+    dataL = *(COMPLEX16Vector **)LALInferenceGetVariable( ifo->params, "phaseCacheDataL" );
+    sumDataX = *(COMPLEX16Vector **)LALInferenceGetVariable( ifo->params, "sumDataX" );
+    sumDataY = *(COMPLEX16Vector **)LALInferenceGetVariable( ifo->params, "sumDataY" );
+    sumDataB = *(COMPLEX16Vector **)LALInferenceGetVariable( ifo->params, "sumDataB" );
+    sumDataL = *(COMPLEX16Vector **)LALInferenceGetVariable( ifo->params, "sumDataL" );
+  }
+
+  /* get the phase model (if this is NULL the phase is the same as that used for the heterodyne) */
+  REAL8Vector *dphi = get_phase_model( params, ifo, freqFactor );
+
+  UINT4 length = dataP->length, i = 0, count = 0, chunkLength = 0;
+
+  for ( i = 0, count = 0; i < length; i += chunkLength, count++ ){
+    chunkLength = chunkLengths->data[count];
+
+    COMPLEX16 sP = 0., sC = 0., sX = 0., sY = 0., sB = 0., sL = 0.;
+
+    for ( UINT4 j = i; j < i + chunkLength; j++ ){
+      /* conjugate of the phase factor by which the (almost) DC signal model is multiplied in pulsar_model */
+      COMPLEX16 expm = 1.;
+      if ( dphi != NULL ){ expm = cexp( -LAL_TWOPI * I * dphi->data[j] ); }
+
+      sP += dataP->data[j]*expm;
+      sC += dataC->data[j]*expm;
+
+      if ( nonGR ){
+        sX += dataX->data[j]*expm;
+        sY += dataY->data[j]*expm;
+        sB += dataB->data[j]*expm;
+        sL += dataL->data[j]*expm;
+      }
+    }
+
+    sumDataP->data[count] = sP;
+    sumDataC->data[count] = sC;
+
+    if ( nonGR ){
+      sumDataX->data[count] = sX;
+      sumDataY->data[count] = sY;
+      sumDataB->data[count] = sB;
+      sumDataL->data[count] = sL;
+    }
+  }
+
+  if ( dphi != NULL ){ XLALDestroyREAL8Vector( dphi ); }
+}
+
+
 /**
  * \brief The phase evolution of a source
  *
@@ -896,7 +1091,8 @@ void get_amplitude_model( PulsarParameters *pars, LALInferenceIFOModel *ifo ){
 
   freqFactors = *(REAL8Vector**)LALInferenceGetVariable( ifo->params, "freqfactors" );
 
-  if( LALInferenceCheckVariable( ifo->params, "varyphase" ) ){ varyphase = 1; }
+  /* if the phase cache is in use the pre-summed form of the model is used even when searching over phase */
+  if( LALInferenceCheckVariable( ifo->params, "varyphase" ) && !LALInferenceCheckVariable( ifo->params, "phasecache" ) ){ varyphase = 1; }
   if( LALInferenceCheckVariable( ifo->params, "roq" ) ){ roq = 1; }
 
   twopsi = 2.*PulsarGetREAL8ParamOrZero( pars, "PSI" );
@@ -46,6 +46,12 @@ void set_nonGR_model_parameters( PulsarParameters *pars, char* nonGRmodel );
 
 REAL8Vector *get_phase_model( PulsarParameters *params, LALInferenceIFOModel *ifo, REAL8 freqFactor );
 
+INT4 is_amplitude_parameter( const CHAR *name );
+
+REAL8Vector *get_phase_parameter_key( PulsarParameters *params );
+
+void update_phase_cache( PulsarParameters *params, REAL8Vector *phasekey, LALInferenceIFOModel *ifo, REAL8 freqFactor );
+
 REAL8Vector *get_ssb_delay( PulsarParameters *pars, LIGOTimeGPSVector *datatimes, EphemerisData *ephem,
                             TimeCorrectionData *tdat, TimeCorrectionType ttype, LALDetector *detector);
 
@@ -28,6 +28,7 @@
 
 #include "config.h"
 #include "ppe_testing.h"
+#include "ppe_models.h"
 
 /* *****************************************************************************/
 /*                          TESTING FUNCTIONS                                 */
@@ -37,6 +38,9 @@
 static double ul_gauss_cdf_function( double x, void *params );
 static double ul_gauss_CDFRoot( double mu, double sigma, double min, double max );
 
+/* phase cache test helper function prototype */
+static void set_phase_cache( LALInferenceIFOModel *ifo, UINT4 usecache );
+
 /**
  * \brief A test function to calculate a 1D posterior on a grid
  *
@@ -506,4 +510,99 @@ void compare_likelihoods( LALInferenceRunState *rs ){
   XLALDestroyTokenList( paramNames );
 }
 
+
+/**
+ * \brief Switch the phase parameter cache on or off
+ *
+ * \param ifo [in] The ifo model structure, for which the phase cache has been set up with \c setup_phase_cache
+ * \param usecache [in] Set to 1 to use the cached data/model sums, or 0 to use the full time series
+ */
+static void set_phase_cache( LALInferenceIFOModel *ifo, UINT4 usecache ){
+  UINT4 phasecache = 1;
+
+  for ( LALInferenceIFOModel *ifomodel = ifo; ifomodel != NULL; ifomodel = ifomodel->next ){
+    if ( !LALInferenceCheckVariable( ifomodel->params, "varyphase" ) ){ continue; }
+
+    if ( usecache ){ check_and_add_fixed_variable( ifomodel->params, "phasecache", &phasecache, LALINFERENCE_UINT4_t ); }
+    else if ( LALInferenceCheckVariable( ifomodel->params, "phasecache" ) ){ LALInferenceRemoveVariable( ifomodel->params, "phasecache" ); }
+  }
+}
+
+
+/**
+ * \brief Compare the log likelihoods calculated with and without the phase parameter cache
+ *
+ * This function will be run if the \c test-phase-cache command line argument is present. For each of the initial
+ * live points (drawn from the prior), and for the same point with its amplitude parameters replaced by those of the
+ * next live point, the log likelihood is calculated using the cached data/model sums (see \c setup_phase_cache), and
+ * then using the full time series. The second point has the same phase parameters as the first, so for it the cached
+ * sums get reused rather than recomputed. The likelihoods are output to the file \c phaseCacheComp.txt, and an error
+ * is raised if any differ by more than a relative tolerance.
+ *
+ * \param rs [in] The analysis information structure
+ */
+void compare_phase_cache_likelihoods( LALInferenceRunState *rs ){
+  const REAL8 tolerance = 1e-8;
+  LALInferenceIFOModel *ifo = rs->threads[0].model->ifo;
+  INT4 Nlive = *(INT4 *)LALInferenceGetVariable( rs->algorithmParams, "Nlive" );
+  INT4 i = 0;
+  UINT4 k = 0, nfail = 0;
+  REAL8 maxerr = 0.;
+  FILE *fp = NULL;
+
+  if ( !LALInferenceCheckVariable( ifo->params, "phasecache" ) ){
+    XLAL_ERROR_VOID( XLAL_EINVAL, "Error... the phase cache is not being used (it requires searching over phase parameters, and is not used with --roq or --no-phase-cache).\n" );
+  }
+
+  if( ( fp = fopen("phaseCacheComp.txt", "w") ) == NULL ){
+    XLAL_ERROR_VOID( XLAL_EIO, "Error... could not open phase cache comparison file.\n" );
+  }
+
+  for ( i = 0; i < Nlive; i++ ){
+    LALInferenceVariables *points[2] = { NULL, NULL };
+    REAL8 logL[2][2];
+
+    /* copy the live point, and the live point with the amplitude parameters of the next live point */
+    for ( k = 0; k < 2; k++ ){
+      points[k] = XLALCalloc( 1, sizeof(LALInferenceVariables) );
+      LALInferenceCopyVariables( rs->livePoints[i], points[k] );
+    }
+
+    for ( LALInferenceVariableItem *item = rs->livePoints[(i+1) % Nlive]->head; item != NULL; item = item->next ){
+      if ( LALInferenceCheckVariableNonFixed( points[1], item->name ) && is_amplitude_parameter( item->name ) ){
+        LALInferenceSetVariable( points[1], item->name, item->value );
+      }
+    }
+
+    /* calculate the log likelihoods with and without the cache */
+    set_phase_cache( ifo, 1 );
+    for ( k = 0; k < 2; k++ ){ logL[k][0] = rs->likelihood( points[k], rs->data, rs->threads[0].model ); }
+
+    set_phase_cache( ifo, 0 );
+    for ( k = 0; k < 2; k++ ){ logL[k][1] = rs->likelihood( points[k], rs->data, rs->threads[0].model ); }
+
+    for ( k = 0; k < 2; k++ ){
+      REAL8 err = fabs( logL[k][0] - logL[k][1] ) / fmax( 1., fabs( logL[k][1] ) );
+
+      fprintf(fp, "%.16le\t%.16le\t%.16le\n", logL[k][0], logL[k][1], logL[k][0] - logL[k][1]);
+      if ( err > maxerr ){ maxerr = err; }
+      if ( err > tolerance ){ nfail++; }
+
+      LALInferenceClearVariables( points[k] );
+      XLALFree( points[k] );
+    }
+  }
+
+  /* leave the cache switched on */
+  set_phase_cache( ifo, 1 );
+
+  fclose(fp);
+
+  fprintf(stderr, "Compared %d pairs of log likelihoods with and without the phase cache: maximum relative difference %le\n", 2*Nlive, maxerr);
+
+  if ( nfail > 0 ){
+    XLAL_ERROR_VOID( XLAL_ETOL, "Error... %u log likelihoods with and without the phase cache differ by more than %le.\n", nfail, tolerance );
+  }
+}
+
 /*----------------------- END OF TESTING FUNCTIONS ---------------------------*/
@@ -63,6 +63,8 @@ void outputPriorSamples( LALInferenceRunState *runState );
 
 void compare_likelihoods( LALInferenceRunState *rs );
 
+void compare_phase_cache_likelihoods( LALInferenceRunState *rs );
+
 #ifdef __cplusplus
 }
 #endif
@@ -228,6 +228,11 @@ INT4 main( INT4 argc, CHAR *argv[] ){
     sum_data( &runState );
   }
 
+  /* set up cached data/model sums for phase parameter searches */
+  if( !testgausslike ){
+    setup_phase_cache( &runState );
+  }
+
   /* check whether using reduced order quadrature */
   if( !testgausslike ){
     generate_interpolant( &runState );
@@ -258,6 +263,12 @@ INT4 main( INT4 argc, CHAR *argv[] ){
   /* Set up threads */
   initialise_threads( &runState, 1 );
 
+  /* compare likelihoods with and without the phase parameter cache */
+  if( LALInferenceGetProcParamVal(param_table, "--test-phase-cache") ){
+    compare_phase_cache_likelihoods( &runState );
+    return 0;
+  }
+
   if( !LALInferenceGetProcParamVal(param_table, "--compare-likelihoods") ){
     /* Call the nested sampling algorithm */
     runState.algorithm( &runState );
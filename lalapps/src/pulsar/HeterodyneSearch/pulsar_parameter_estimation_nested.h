@@ -333,6 +333,15 @@ extern "C" {
                     \"_timings\" will contain the timings\n"\
 " --sampleprior      (UINT4) Set this to be a number of samples generated from\n\
                     the prior. The nested sampling will not be performed\n"\
+" --no-phase-cache   Set this to calculate the likelihood from the full time\n\
+                    series when searching over phase parameters, rather than\n\
+                    from data/model sums that are cached until the phase\n\
+                    parameters change\n"\
+" --test-phase-cache Set this to compare the likelihoods calculated with and\n\
+                    without the phase parameter cache for the initial live\n\
+                    points (drawn from the prior). The code will exit with an\n\
+                    error if they differ, and nested sampling will not be\n\
+                    performed\n"\
 "\n"
 
 /**
@@ -0,0 +1,68 @@
+# Check that the targeted pulsar likelihood is the same with and without the
+# phase parameter cache, when searching over the frequency and its derivative
+
+CODENAME=lalapps_pulsar_parameter_estimation_nested
+
+# create a pulsar par file, also used for the injection
+PSRNAME=J0000+0000
+FREQ=245.678910
+FDOT=-9.87654321e-12
+PFILE=$PSRNAME.par
+
+if [ -f $PFILE ]; then
+  rm -f $PFILE
+fi
+
+echo PSR     $PSRNAME > $PFILE
+echo F0      $FREQ >> $PFILE
+echo F1      $FDOT >> $PFILE
+echo RAJ     00:00:00.0 >> $PFILE
+echo DECJ    00:00:00.0 >> $PFILE
+echo PEPOCH  54000 >> $PFILE
+echo H0      5e-25 >> $PFILE
+echo COSIOTA 0.3 >> $PFILE
+echo PSI     0.5 >> $PFILE
+echo PHI0    1.2 >> $PFILE
+
+if [ $? != "0" ]; then
+  echo Error writing parameter file!
+  exit 2
+fi
+
+# create a prior file, including phase parameters
+PRIORFILE=$PSRNAME.prior
+
+if [ -f $PRIORFILE ]; then
+  rm -f $PRIORFILE
+fi
+
+echo H0      uniform 0 1e-23 > $PRIORFILE
+echo PHI0    uniform 0 3.141592653589793 >> $PRIORFILE
+echo COSIOTA uniform -1 1 >> $PRIORFILE
+echo PSI     uniform 0 1.5707963267948966 >> $PRIORFILE
+echo F0      uniform 245.67890 245.67892 >> $PRIORFILE
+echo F1      uniform -9.88e-12 -9.87e-12 >> $PRIORFILE
+
+if [ $? != "0" ]; then
+  echo Error writing prior file!
+  exit 2
+fi
+
+# compare the likelihoods with and without the phase cache for points drawn
+# from the prior, for a signal injected into fake data of two detectors
+echo Comparing likelihoods with and without the phase parameter cache...
+$CODENAME --fake-data H1,L1 --fake-psd 1e-48,1e-48 --fake-starts 900000000,900000000 --fake-lengths 86400,86400 --fake-dt 60 --par-file $PFILE --prior-file $PRIORFILE --inject-file $PFILE --outfile test_ppe_phase_cache.hdf --Nlive 100 --Nmcmcinitial 0 --randomseed 1618 --test-phase-cache
+
+if [ $? != "0" ]; then
+  echo Error! Likelihoods with and without the phase parameter cache differ!
+  exit 1
+fi
+
+if [ ! -s phaseCacheComp.txt ]; then
+  echo Error! Phase cache likelihood comparison file was not written!
+  exit 1
+fi
+
+echo Likelihoods with and without the phase parameter cache agree.
+
+exit 0
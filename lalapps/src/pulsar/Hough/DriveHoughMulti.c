@@ -285,6 +285,12 @@ int main(int argc, char *argv[]){
     static HOUGHDemodPar   parDem;  /* demodulation parameters or  */
     static HOUGHSizePar    parSize;
     static HOUGHMapTotal   ht;   /* the total Hough map */
+    UINT4 nSpinMaps = 0;   /* number of spindowns searched at each frequency */
+    HOUGHMapTotal *htSpin = NULL;   /* weighted Hough maps of all spindowns at one frequency */
+    UINT8FrequencyIndexVector *freqIndSpin = NULL;   /* trajectories of all spindowns at one frequency */
+    HOUGHMapTotal **htSpinP = NULL;
+    const UINT8FrequencyIndexVector **freqIndSpinP = NULL;
+    const PHMDVectorSequence **phmdVSP = NULL;
     static UINT8Vector     *hist; /* histogram of number counts for a single map */
     static UINT8Vector     *histTotal; /* number count histogram for all maps */
     static HoughStats      stats;  /* statistical information about a Hough map */
@@ -345,6 +351,7 @@ int main(int argc, char *argv[]){
     INT4     uvar_chiSqBins;
     
     INT4     uvar_spindownJump;
+    INT4     uvar_numThreads;
     
     INT4 uvar_nfLUTvalidity = 0;
     INT4 uvar_numSkyPartitions = 0;
@@ -379,6 +386,7 @@ int main(int argc, char *argv[]){
     uvar_EnableChi2=FALSE;
     uvar_chiSqBins = NBLOCKSTEST;
     uvar_spindownJump = SPINDOWNJUMP;
+    uvar_numThreads = 1;
 
     uvar_EnableToplistPatch = FALSE;
 
@@ -430,6 +438,7 @@ int main(int argc, char *argv[]){
     XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_chiSqBins,          "chiSqBins",          INT4,         0,   OPTIONAL,  "Number of chi-square bins for veto tests") == XLAL_SUCCESS, XLAL_EFUNC);
     XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_EnableChi2,         "enableChi2",         BOOLEAN,      0,   OPTIONAL,  "Print Chi2 value for each element in the Toplist") == XLAL_SUCCESS, XLAL_EFUNC);
     XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_spindownJump,       "spindownJump",       INT4,         0,   OPTIONAL,  "Jump to the next spin-down being analyzed (to avoid doing them all)") == XLAL_SUCCESS, XLAL_EFUNC);
+    XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_numThreads,         "numThreads",         INT4,         0,   OPTIONAL,  "Number of threads used to construct weighted Hough maps (0 = OpenMP default)") == XLAL_SUCCESS, XLAL_EFUNC);
     XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_numSkyPartitions,   "numSkyPartitions",  INT4,          0,   OPTIONAL,  "Number of (equi-)partitions to split skygrid into") == XLAL_SUCCESS, XLAL_EFUNC);
     XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_partitionIndex,     "partitionIndex",    INT4,          0,   OPTIONAL,  "Index [0,xnumSkyPartitions-1] of sky-partition to generate") == XLAL_SUCCESS, XLAL_EFUNC);
     XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_refTime,            "refTime",            REAL8,        0,   OPTIONAL,  "GPS reference time of observation") == XLAL_SUCCESS, XLAL_EFUNC);
@@ -479,6 +488,11 @@ int main(int argc, char *argv[]){
         exit(1);
     }
     
+    if ( uvar_numThreads < 0 ) {
+        LogPrintf(LOG_CRITICAL, "Number of threads must be non-negative\n");
+        exit(1);
+    }
+    
     if ( uvar_keepBestSFTs < 1 ) {
         LogPrintf(LOG_CRITICAL, "must keep at least 1 SFT\n");
         exit(1);
@@ -878,6 +892,23 @@ int main(int argc, char *argv[]){
         /* ***** for spin-down case ****/
         nSpin1Max = uvar_nfSizeCylinder - 1 - uvar_nSpinUp;
         /* nSpin1Max = floor(uvar_nfSizeCylinder/2.0) ;*/
+
+        /* weighted Hough maps of all spindowns at one search frequency are constructed together */
+        if (uvar_weighAM || uvar_weighNoise) {
+            UINT4 s;
+            nSpinMaps = floor(uvar_nSpinUp/uvar_spindownJump) + floor(nSpin1Max/uvar_spindownJump) + 1;
+            htSpin = (HOUGHMapTotal *)LALCalloc(nSpinMaps, sizeof(HOUGHMapTotal));
+            freqIndSpin = (UINT8FrequencyIndexVector *)LALCalloc(nSpinMaps, sizeof(UINT8FrequencyIndexVector));
+            htSpinP = (HOUGHMapTotal **)LALCalloc(nSpinMaps, sizeof(HOUGHMapTotal *));
+            freqIndSpinP = (const UINT8FrequencyIndexVector **)LALCalloc(nSpinMaps, sizeof(UINT8FrequencyIndexVector *));
+            phmdVSP = (const PHMDVectorSequence **)LALCalloc(nSpinMaps, sizeof(PHMDVectorSequence *));
+            for (s = 0; s < nSpinMaps; ++s) {
+                LAL_CALL( LALHOUGHCreateFreqIndVector( &status, &freqIndSpin[s], mObsCohBest, deltaF), &status);
+                htSpinP[s] = &htSpin[s];
+                freqIndSpinP[s] = &freqIndSpin[s];
+                phmdVSP[s] = &phmdVS;
+            }
+        }
         
         
         if ( XLALUserVarWasSet( &uvar_deltaF1dot ) )
@@ -951,6 +982,9 @@ int main(int argc, char *argv[]){
             /* ************ initializing the Total Hough map space *********** */
             
             LAL_CALL( LALHOUGHCreateHT( &status, &ht, xSide, ySide), &status);
+            for (j = 0; j < nSpinMaps; ++j) {
+                LAL_CALL( LALHOUGHCreateHT( &status, &htSpin[j], xSide, ySide), &status);
+            }
             ht.mObsCoh = mObsCohBest;
             ht.deltaF = deltaF;
             
@@ -969,13 +1003,25 @@ int main(int argc, char *argv[]){
                 /**** study 1 spin-down. at  fBinSearch ****/
                 
                 INT4   n;
+                UINT4  s;
                 REAL8  f1dis;
                 
+                /* construct the weighted Hough maps of all spindowns together */
+                if (uvar_weighAM || uvar_weighNoise) {
+                    for ( s = 0, n = floor(uvar_nSpinUp/uvar_spindownJump); n >= - floor(nSpin1Max/uvar_spindownJump); --n, ++s) {
+                        f1dis = + n * f1jump;
+                        for (j = 0 ; j < mObsCohBest; ++j){
+                            freqIndSpin[s].data[j] = fBinSearch + floor(best.timeDiffV->data[j]*f1dis + 0.5);
+                        }
+                    }
+                    XLAL_CHECK_MAIN( XLALHOUGHConstructHMTs_W( htSpinP, nSpinMaps, freqIndSpinP, phmdVSP, uvar_numThreads ) == XLAL_SUCCESS, XLAL_EFUNC );
+                }
+                
                 ht.f0Bin = fBinSearch;
                 ht.spinRes.length = 1;
                 ht.spinRes.data = NULL;
                 ht.spinRes.data = (REAL8 *)LALCalloc(ht.spinRes.length, sizeof(REAL8));
-                for ( n = floor(uvar_nSpinUp/uvar_spindownJump); n >= - floor(nSpin1Max/uvar_spindownJump); --n) {
+                for ( s = 0, n = floor(uvar_nSpinUp/uvar_spindownJump); n >= - floor(nSpin1Max/uvar_spindownJump); --n, ++s) {
                     /*for ( n = 0; n <= floor(nSpin1Max/uvar_spindownJump); ++n) {*/
                     /* f1dis = - n * f1jump; */
                     /*loop over all spindown values */
@@ -989,7 +1035,7 @@ int main(int argc, char *argv[]){
                     }
                     
                     if (uvar_weighAM || uvar_weighNoise) {
-                        LAL_CALL( LALHOUGHConstructHMT_W( &status, &ht, &freqInd, &phmdVS ), &status );
+                        memcpy( ht.map, htSpin[s].map, xSide*ySide*sizeof(HoughTT) );
                     }
                     else {
                         LAL_CALL( LALHOUGHConstructHMT( &status, &ht, &freqInd, &phmdVS ), &status );
@@ -1048,6 +1094,9 @@ int main(int argc, char *argv[]){
             LALFree(patch.xCoor);
             LALFree(patch.yCoor);
             LALFree(ht.map);
+            for (j = 0; j < nSpinMaps; ++j) {
+                LALFree(htSpin[j].map);
+            }
             
             LALHOUGHDestroyLUTs( &status, &lutV);
             
@@ -1087,6 +1136,19 @@ int main(int argc, char *argv[]){
         LALFree(freqInd.data);
         freqInd.data = NULL;
         
+        if (nSpinMaps > 0) {
+            UINT4 s;
+            for (s = 0; s < nSpinMaps; ++s) {
+                LALFree(freqIndSpin[s].data);
+            }
+            LALFree(htSpin);
+            LALFree(freqIndSpin);
+            LALFree(htSpinP);
+            LALFree(freqIndSpinP);
+            LALFree(phmdVSP);
+            nSpinMaps = 0;
+        }
+        
         if ( uvar_EnableExtraInfo ) {
             XLALDestroyUINT8Vector (hist);
             XLALDestroyUINT8Vector (histTotal);
@@ -365,6 +365,7 @@ int MAIN( int argc, char *argv[]) {
   BOOLEAN uvar_printCand1 = FALSE; 	/* if 1st stage candidates are to be printed */
   BOOLEAN uvar_printFstat1 = FALSE;
   BOOLEAN uvar_useToplist1 = FALSE;
+  UINT4 uvar_numThreads = 1;
   BOOLEAN uvar_useWeights  = FALSE;
   BOOLEAN uvar_semiCohToplist = FALSE; /* if overall first stage candidates are to be output */
 
@@ -488,6 +489,7 @@ int MAIN( int argc, char *argv[]) {
   XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_skyPointIndex,    "skyPointIndex",   INT4,     0,   DEVELOPER, "Only analyze this skypoint in grid" ) == XLAL_SUCCESS, XLAL_EFUNC);
   XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_dopplerMax,       "dopplerMax",       REAL8,   0,   DEVELOPER, "Max Doppler shift") == XLAL_SUCCESS, XLAL_EFUNC);
   XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_useToplist1,      "useToplist1",      BOOLEAN, 0,   DEVELOPER, "Use toplist for 1st stage candidates?" ) == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_numThreads,       "numThreads",       UINT4,   0,   DEVELOPER, "Number of threads used to construct Hough maps (0 = OpenMP default)" ) == XLAL_SUCCESS, XLAL_EFUNC);
   XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_df1dotRes,        "df1dotRes",        REAL8,   0,   DEVELOPER, "Resolution in residual fdot values (default=df1dot/nf1dotRes)") == XLAL_SUCCESS, XLAL_EFUNC);
   XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_correctFreqs,     "correctFreqs",     BOOLEAN, 0,   DEVELOPER, "Correct candidate output frequencies (ie fix bug #147). Allows reproducing 'historical results'") == XLAL_SUCCESS, XLAL_EFUNC);
   XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_gpu_device,       "device",           INT4,    0,   DEVELOPER, "GPU device id" ) == XLAL_SUCCESS, XLAL_EFUNC);
@@ -775,6 +777,7 @@ int MAIN( int argc, char *argv[]) {
 
   /* set up some semiCoherent parameters */
   semiCohPar.useToplist = uvar_useToplist1;
+  semiCohPar.numThreads = uvar_numThreads;
   semiCohPar.tsMid = midTstack;
   /* semiCohPar.refTime = tStartGPS; */
   semiCohPar.refTime = tMidGPS;
@@ -1497,12 +1500,17 @@ void ComputeFstatHoughMap(LALStatus *status,		/**< pointer to LALStatus structur
   HOUGHMapTotal ht;
   HOUGHptfLUTVector   lutV; /* the Look Up Table vector*/
   PHMDVectorSequence  phmdVS;  /* the partial Hough map derivatives */
-  UINT8FrequencyIndexVector freqInd; /* for trajectory in time-freq plane */
   HOUGHResolutionPar parRes;   /* patch grid information */
   HOUGHPatchGrid  patch;   /* Patch description */
   HOUGHParamPLUT  parLut;  /* parameters needed to build lut  */
   HOUGHDemodPar   parDem;  /* demodulation parameters */
   HOUGHSizePar    parSize;
+  UINT4 nSpinMaps;   /* number of residual spindowns */
+  HOUGHMapTotal *htSpin = NULL;   /* Hough maps of all residual spindowns at one frequency */
+  UINT8FrequencyIndexVector *freqIndSpin = NULL;   /* trajectories in time-freq plane of all residual spindowns */
+  HOUGHMapTotal **htSpinP = NULL;
+  const UINT8FrequencyIndexVector **freqIndSpinP = NULL;
+  const PHMDVectorSequence **phmdVSP = NULL;
 
   UINT2  xSide, ySide, maxNBins, maxNBorders;
   INT8  fBinIni, fBinFin, fBin;
@@ -1622,14 +1630,29 @@ void ComputeFstatHoughMap(LALStatus *status,		/**< pointer to LALStatus structur
     ABORT ( status, HIERARCHICALSEARCH_EMEM, HIERARCHICALSEARCH_MSGEMEM );
   }
 
-  /* residual spindown trajectory */
-  freqInd.deltaF = deltaF;
-  freqInd.length = nStacks;
-  freqInd.data = LALCalloc(1, alloc_len = nStacks*sizeof(UINT8));
-  if ( freqInd.data == NULL ) {
-    XLALPrintError ("Failed to LALCalloc(1,%d)\n", alloc_len );
+  /* Hough maps and residual spindown trajectories, which are constructed together */
+  nSpinMaps = 2*(nfdot/2) + 1;
+  htSpin = LALCalloc(nSpinMaps, sizeof(*htSpin));
+  freqIndSpin = LALCalloc(nSpinMaps, sizeof(*freqIndSpin));
+  htSpinP = LALCalloc(nSpinMaps, sizeof(*htSpinP));
+  freqIndSpinP = LALCalloc(nSpinMaps, sizeof(*freqIndSpinP));
+  phmdVSP = LALCalloc(nSpinMaps, sizeof(*phmdVSP));
+  if ( htSpin == NULL || freqIndSpin == NULL || htSpinP == NULL || freqIndSpinP == NULL || phmdVSP == NULL ) {
+    XLALPrintError ("Failed to allocate memory for %u Hough maps\n", nSpinMaps );
     ABORT ( status, HIERARCHICALSEARCH_EMEM, HIERARCHICALSEARCH_MSGEMEM );
   }
+  for (k = 0; k < nSpinMaps; k++) {
+    freqIndSpin[k].deltaF = deltaF;
+    freqIndSpin[k].length = nStacks;
+    freqIndSpin[k].data = LALCalloc(1, alloc_len = nStacks*sizeof(UINT8));
+    if ( freqIndSpin[k].data == NULL ) {
+      XLALPrintError ("Failed to LALCalloc(1,%d)\n", alloc_len );
+      ABORT ( status, HIERARCHICALSEARCH_EMEM, HIERARCHICALSEARCH_MSGEMEM );
+    }
+    htSpinP[k] = &htSpin[k];
+    freqIndSpinP[k] = &freqIndSpin[k];
+    phmdVSP[k] = &phmdVS;
+  }
 
   /* resolution in space of residual spindowns */
   ht.dFdot.length = 1;
@@ -1892,6 +1915,16 @@ void ComputeFstatHoughMap(LALStatus *status,		/**< pointer to LALStatus structur
 
     TRY( LALHOUGHInitializeHT( status->statusPtr, &ht, &patch), status); /*not needed */
 
+    for (k = 0; k < nSpinMaps; k++) {
+      htSpin[k].xSide = xSide;
+      htSpin[k].ySide = ySide;
+      htSpin[k].map = LALCalloc(1, alloc_len = xSide*ySide*sizeof(HoughTT));
+      if ( htSpin[k].map == NULL ) {
+        XLALPrintError ("Failed to LALCalloc( 1, %d)\n", alloc_len );
+        ABORT ( status, HIERARCHICALSEARCH_EMEM, HIERARCHICALSEARCH_MSGEMEM );
+      }
+    }
+
     /*  Search frequency interval possible using the same LUTs */
     fBinSearch = fBin;
     fBinSearchMax = fBin + parSize.nFreqValid - 1;
@@ -1906,17 +1939,24 @@ void ComputeFstatHoughMap(LALStatus *status,		/**< pointer to LALStatus structur
 	nfdotBy2 = nfdot/2;
 	ht.f0Bin = fBinSearch;
 
+	/* construct the Hough maps of all residual spindowns together */
+	for( n = -nfdotBy2; n <= nfdotBy2 ; n++ ){
+	  for (j=0; j < (UINT4)nStacks; j++) {
+	    freqIndSpin[n + nfdotBy2].data[j] = fBinSearch + floor( (REAL4)(timeDiffV->data[j]*n*dfdot/deltaF) + 0.5f);
+	  }
+	}
+	if ( XLALHOUGHConstructHMTs_W( htSpinP, nSpinMaps, freqIndSpinP, phmdVSP, params->numThreads ) != XLAL_SUCCESS ) {
+	  XLALPrintError ("XLALHOUGHConstructHMTs_W() failed\n" );
+	  ABORT ( status, HIERARCHICALSEARCH_EXLAL, HIERARCHICALSEARCH_MSGEXLAL );
+	}
+
 	/*loop over all values of residual spindown */
 	/* check limits of loop */
 	for( n = -nfdotBy2; n <= nfdotBy2 ; n++ ){
 
 	  ht.spinRes.data[0] =  n*dfdot;
 
-	  for (j=0; j < (UINT4)nStacks; j++) {
-	    freqInd.data[j] = fBinSearch + floor( (REAL4)(timeDiffV->data[j]*n*dfdot/deltaF) + 0.5f);
-	  }
-
-	  TRY( LALHOUGHConstructHMT_W(status->statusPtr, &ht, &freqInd, &phmdVS),status );
+	  memcpy( ht.map, htSpin[n + nfdotBy2].map, xSide*ySide*sizeof(HoughTT) );
 
 	  /* get candidates */
 	  if ( params->useToplist ) {
@@ -1980,6 +2020,9 @@ void ComputeFstatHoughMap(LALStatus *status,		/**< pointer to LALStatus structur
     LALFree(patch.xCoor);
     LALFree(patch.yCoor);
     LALFree(ht.map);
+    for (k = 0; k < nSpinMaps; k++) {
+      LALFree(htSpin[k].map);
+    }
 
     for (j=0; j<lutV.length ; ++j){
       for (i=0; i<maxNBorders; ++i){
@@ -2003,7 +2046,14 @@ void ComputeFstatHoughMap(LALStatus *status,		/**< pointer to LALStatus structur
   LALFree(ht.dFdot.data);
   LALFree(lutV.lut);
   LALFree(phmdVS.phmd);
-  LALFree(freqInd.data);
+  for (k = 0; k < nSpinMaps; k++) {
+    LALFree(freqIndSpin[k].data);
+  }
+  LALFree(htSpin);
+  LALFree(freqIndSpin);
+  LALFree(htSpinP);
+  LALFree(freqIndSpinP);
+  LALFree(phmdVSP);
   LALFree(parDem.spin.data);
 
   TRY( LALDDestroyVector( status->statusPtr, &timeDiffV), status);
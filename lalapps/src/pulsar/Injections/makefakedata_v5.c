@@ -145,6 +145,9 @@ typedef struct
 
   INT4 randSeed;		/**< allow user to specify random-number seed for reproducible noise-realizations */
 
+  UINT4 SFTDomainDterms;	/**< if >0, add non-transient signals directly to the SFTs using this many bins either side of the signal */
+  UINT4 numThreads;		/**< number of threads used to add signals in the SFT domain */
+
 } UserVariables_t;
 
 
@@ -196,6 +199,8 @@ main(int argc, char *argv[])
   DataParams.SFTWindowType      = uvar.SFTWindowType;
   DataParams.SFTWindowBeta      = uvar.SFTWindowBeta;
   DataParams.sourceDeltaT       = uvar.sourceDeltaT;
+  DataParams.SFTDomainDterms    = uvar.SFTDomainDterms;
+  DataParams.numThreads         = uvar.numThreads;
   if ( GV.inputMultiTS == NULL )
     {
       DataParams.fMin               = GV.fminOut;
@@ -209,7 +214,9 @@ main(int argc, char *argv[])
       DataParams.inputMultiTS       = GV.inputMultiTS;
     }
 
-  XLAL_CHECK ( XLALCWMakeFakeMultiData ( &mSFTs, &mTseries, injectionSources, &DataParams, GV.edat ) == XLAL_SUCCESS, XLAL_EFUNC );
+  // time-series output is not available if signals are added in the SFT domain
+  MultiREAL8TimeSeries **mTseriesOut = ( uvar.SFTDomainDterms > 0 ) ? NULL : &mTseries;
+  XLAL_CHECK ( XLALCWMakeFakeMultiData ( &mSFTs, mTseriesOut, injectionSources, &DataParams, GV.edat ) == XLAL_SUCCESS, XLAL_EFUNC );
 
   XLALDestroyPulsarParamsVector ( injectionSources );
   injectionSources = NULL;
@@ -398,6 +405,11 @@ XLALInitMakefakedata ( ConfigVars_t *cfg, UserVariables_t *uvar )
     XLAL_CHECK ( XLALParseMultiLALDetector ( &(cfg->multiIFO), uvar->IFOs ) == XLAL_SUCCESS, XLAL_EFUNC );
   }
 
+  // ----- SFT-domain signal generation only produces SFTs
+  if ( uvar->SFTDomainDterms > 0 ) {
+    XLAL_CHECK ( uvar->TDDfile == NULL && uvar->outFrameDir == NULL, XLAL_EINVAL, "--SFTDomainDterms cannot be used with time-series output (--TDDfile or --outFrameDir)\n" );
+  }
+
   if ( have_noiseSFTs ) {
     /* user must specify the window function used for the noiseSFTs */
     XLAL_CHECK ( XLALUserVarWasSet ( &uvar->SFTWindowType ), XLAL_EINVAL, "Option --noiseSFTs requires to also set --SFTWindowType. Please try to ensure this matches how the input SFTs were generated." );
@@ -613,6 +625,7 @@ XLALInitUserVars ( UserVariables_t *uvar, int argc, char *argv[] )
   uvar->ephemSun = XLALStringDuplicate("sun00-40-DE405.dat.gz");
 
   uvar->Tsft = 1800;
+  uvar->numThreads = 1;
   uvar->outSingleSFT = 1; /* write our a single SFT file by default */
 
 #define MISC_DEFAULT "mfdv5"
@@ -671,6 +684,8 @@ XLALInitUserVars ( UserVariables_t *uvar, int argc, char *argv[] )
   // ----- 'expert-user/developer' options ----- (only shown in help at lalDebugLevel >= warning)
   XLALRegisterUvarMember(   randSeed,             INT4, 0, DEVELOPER, "Specify random-number seed for reproducible noise (0 means use /dev/urandom for seeding).");
   XLALRegisterUvarMember(  sourceDeltaT,        REAL8,  0, DEVELOPER, "Source-frame sampling period. '0' implies previous internal defaults" );
+  XLALRegisterUvarMember(  SFTDomainDterms,      UINT4,  0, DEVELOPER, "If >0, add non-transient signals directly to the SFTs, writing this many bins either side of each signal frequency (requires a rectangular SFT window, no time-series output). '0' generates all signals in the time domain" );
+  XLALRegisterUvarMember(  numThreads,           UINT4,  0, DEVELOPER, "Number of threads used to add signals in the SFT domain ('0' means the OpenMP default)" );
 
   /* read cmdline & cfgfile  */
   BOOLEAN should_exit = 0;
@@ -1,6 +1,7 @@
 mfdv4_CODE="lalapps_Makefakedata_v4"
 mfdv5_CODE="lalapps_Makefakedata_v5"
 cmp_CODE="lalapps_compareSFTs"
+dump_CODE="lalapps_dumpSFT"
 
 testDIR="./mfdv5_TEST"
 
@@ -140,6 +141,9 @@ sftsv5_1_meth2=${testDIR}/H-*_mfdv5_meth2-*.sft
 sftsv5_2_meth2=${testDIR}/L-*_mfdv5_meth2-*.sft
 sftsv5_meth2=${testDIR}/*_mfdv5_meth2-*.sft
 
+sftsv5_1_meth3=${testDIR}/H-*_mfdv5_meth3-*.sft
+sftsv5_2_meth3=${testDIR}/L-*_mfdv5_meth3-*.sft
+
 ## ----------
 ## produce SFTs for 2 detectors, containing Gaussian noise + N signals, compare between mfdv4 and mfdv5
 ## ----------
@@ -237,6 +241,15 @@ if ! eval $cmdline2; then
     exit 1
 fi
 
+echo
+echo "----- Method 3: same as Method 1, but adding non-transient signals in the SFT domain"
+cmdline="$mfdv5_CL ${outIFOs} ${sig13} --SFTDomainDterms=64 --numThreads=2 --outLabel='mfdv5_meth3'"
+echo $cmdline;
+if ! eval $cmdline; then
+    echo "Error.. something failed when running '$mfdv5_CODE' ..."
+    exit 1
+fi
+
 echo
 echo "--------------------------------------------------"
 echo "Comparison of resulting (concatenated) SFTs:"
@@ -280,3 +293,89 @@ if ! eval $cmdline; then
 else
     echo "OK."
 fi
+
+echo
+echo "---------- compare mfdv5 Method 3 SFTs to Method 1 ----------"
+cmdline="$cmp_CODE -V -e ${tol} -1 '${sftsv5_1_meth1}' -2 '${sftsv5_1_meth3}'"
+echo ${cmdline}
+if ! eval $cmdline; then
+    echo "Failed. SFTs produced by makefakedata_v5 in the time and SFT domains differ by more than ${tol}!"
+    exit 2
+else
+    echo "OK."
+fi
+
+cmdline="$cmp_CODE -V -e ${tol} -1 '${sftsv5_2_meth1}' -2 '${sftsv5_2_meth3}'"
+echo ${cmdline}
+if ! eval $cmdline; then
+    echo "Failed. SFTs produced by makefakedata_v5 in the time and SFT domains differ by more than ${tol}!"
+    exit 2
+else
+    echo "OK."
+fi
+
+echo
+echo "---------- compare noise-free mfdv5 Method 3 SFTs to Method 1 ----------"
+## without noise, the differences are due to the signals alone: per XLALCWAddSignalsToSFTs(), SFT-domain signals
+## agree with the signal model to ~2e-3 in relative amplitude, time-domain signals to ~5e-3 at 300Hz, and the
+## bins outside of +-Dterms, which are not written, contain a fraction ~1/(pi^2 Dterms) of the signal power;
+## the power-like measures of compareSFTs are then bounded by relErr^2 + 1/(pi^2 Dterms)
+Dterms_nonoise=512
+relErr_nonoise=$(echo 2e-3 5e-3 | LC_ALL=C awk '{printf "%g", $1 + $2}')
+tol_nonoise=$(echo ${relErr_nonoise} ${Dterms_nonoise} | LC_ALL=C awk '{printf "%g", $1 * $1 + 1 / (3.14159265 * 3.14159265 * $2)}')
+outIFOs_nonoise="--IFOs=${IFO1},${IFO2} --timestampsFiles=${timestamps1},${timestamps2}"
+sftsv5_1_nonoise_TD=${testDIR}/H-*_mfdv5nonoiseTD-*.sft
+sftsv5_2_nonoise_TD=${testDIR}/L-*_mfdv5nonoiseTD-*.sft
+sftsv5_1_nonoise_FD1=${testDIR}/H-*_mfdv5nonoiseFD1-*.sft
+sftsv5_2_nonoise_FD1=${testDIR}/L-*_mfdv5nonoiseFD1-*.sft
+sftsv5_1_nonoise_FD3=${testDIR}/H-*_mfdv5nonoiseFD3-*.sft
+sftsv5_2_nonoise_FD3=${testDIR}/L-*_mfdv5nonoiseFD3-*.sft
+
+cmdline="$mfdv5_CL ${outIFOs_nonoise} ${sig13} --outLabel='mfdv5nonoiseTD'"
+echo $cmdline;
+if ! eval $cmdline; then
+    echo "Error.. something failed when running '$mfdv5_CODE' ..."
+    exit 1
+fi
+cmdline="$mfdv5_CL ${outIFOs_nonoise} ${sig13} --SFTDomainDterms=${Dterms_nonoise} --numThreads=1 --outLabel='mfdv5nonoiseFD1'"
+echo $cmdline;
+if ! eval $cmdline; then
+    echo "Error.. something failed when running '$mfdv5_CODE' ..."
+    exit 1
+fi
+
+for i in 1 2; do
+    eval "sftsTD=\${sftsv5_${i}_nonoise_TD}"
+    eval "sftsFD=\${sftsv5_${i}_nonoise_FD1}"
+    cmdline="$cmp_CODE -V -e ${tol_nonoise} -1 '${sftsTD}' -2 '${sftsFD}'"
+    echo ${cmdline}
+    if ! eval $cmdline; then
+        echo "Failed. Noise-free SFTs produced by makefakedata_v5 in the time and SFT domains differ by more than ${tol_nonoise}!"
+        exit 2
+    else
+        echo "OK."
+    fi
+done
+
+echo
+echo "---------- compare mfdv5 Method 3 SFTs generated with 1 and 3 threads ----------"
+## signals are added to each SFT in the same order, so the SFT data should be identical
+cmdline="$mfdv5_CL ${outIFOs_nonoise} ${sig13} --SFTDomainDterms=${Dterms_nonoise} --numThreads=3 --outLabel='mfdv5nonoiseFD3'"
+echo $cmdline;
+if ! eval $cmdline; then
+    echo "Error.. something failed when running '$mfdv5_CODE' ..."
+    exit 1
+fi
+
+for i in 1 2; do
+    eval "sfts1=\${sftsv5_${i}_nonoise_FD1}"
+    eval "sfts3=\${sftsv5_${i}_nonoise_FD3}"
+    $dump_CODE -d -i "${sfts1}" > ${testDIR}/dump_nonoise_FD1.txt
+    $dump_CODE -d -i "${sfts3}" > ${testDIR}/dump_nonoise_FD3.txt
+    if ! diff -q ${testDIR}/dump_nonoise_FD1.txt ${testDIR}/dump_nonoise_FD3.txt; then
+        echo "Failed. SFTs produced by makefakedata_v5 in the SFT domain with 1 and 3 threads differ!"
+        exit 2
+    else
+        echo "OK."
+    fi
+done
@@ -0,0 +1,308 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*  MA  02110-1301  USA
+*/
+
+/**
+ * \file
+ * \ingroup lalapps_pulsar_SFTTools
+ * \brief
+ * Create SFTs from frame data using the streaming SFT producer of StreamingSFTs.h.
+ *
+ * Unlike lalapps_MakeSFTs, which reads, filters and transforms the data of each SFT separately, the frame files in
+ * the cache are read once, sequentially and in large chunks; overlapping SFTs therefore do not read any data twice.
+ * Each chunk is high-passed, and the SFTs it completes are transformed in batches and written to files by several
+ * threads. Gaps in the frame cache start a new contiguous segment of SFTs.
+ *
+ * If LAL was built with pthreads, the next chunk is read from the frame files by a separate thread while the SFTs of
+ * the current chunk are computed, and SFTs are written to files by a writer thread (see \c --writeQueueLength), so
+ * that reading, transforming and writing overlap. The number of SFTs created per second, and per thread used to
+ * transform them, is printed with \c --LAL_DEBUG_LEVEL=info.
+ */
+
+/* ---------- includes ---------- */
+#include "config.h"
+
+#include <stdio.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <lal/LALStdlib.h>
+#include <lal/UserInput.h>
+#include <lal/Date.h>
+#include <lal/LALString.h>
+#include <lal/LALCache.h>
+#include <lal/LALFrStream.h>
+#include <lal/LogPrintf.h>
+#include <lal/StreamingSFTs.h>
+
+#include <LALAppsVCSInfo.h>
+
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+#endif
+
+/* User variables */
+typedef struct {
+  CHAR *frameCache;
+  CHAR *channelName;
+  LIGOTimeGPS startTime;
+  LIGOTimeGPS endTime;
+  REAL8 Tsft;
+  REAL8 overlapFraction;
+  REAL8 highPassFreq;
+  INT4 highPassOrder;
+  CHAR *windowType;
+  REAL8 windowBeta;
+  REAL8 fMin;
+  REAL8 Band;
+  REAL8 chunkDuration;
+  INT4 batchSize;
+  INT4 numThreads;
+  INT4 writeQueueLength;
+  CHAR *outputDir;
+  CHAR *SFTcomment;
+  CHAR *Misc;
+} UserVar;
+
+/* State of reading consecutive chunks of frame data */
+typedef struct {
+  LALFrStream *framestream;	/* frame stream, only used by one thread at a time */
+  const UserVar *uvar;		/* user variables */
+  UINT4 nextFile;		/* index in frame cache of first frame file not yet part of a span */
+  LIGOTimeGPS next;		/* start time of next chunk */
+  LIGOTimeGPS spanEnd;		/* end time of current contiguous span of frame files */
+  REAL8TimeSeries *chunk;	/* chunk read by ReadNextChunk(), or NULL once all data are read */
+  int errnum;			/* error number of ReadNextChunk(), or 0 */
+} ChunkReader;
+
+/* ----- local prototypes ----- */
+int initUserVars ( UserVar *uvar );
+static int ReadNextChunk ( ChunkReader *reader );
+static void *ReadNextChunkThread ( void *arg );
+
+/*----------------------------------------------------------------------
+ * main function
+ *----------------------------------------------------------------------*/
+int
+main(int argc, char *argv[])
+{
+  /* register all user-variables */
+  UserVar XLAL_INIT_DECL(uvar);
+  XLAL_CHECK_MAIN ( initUserVars ( &uvar ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  /* read cmdline & cfgfile  */
+  BOOLEAN should_exit = 0;
+  XLAL_CHECK_MAIN( XLALUserVarReadAllInput( &should_exit, argc, argv, lalAppsVCSInfoList ) == XLAL_SUCCESS, XLAL_EFUNC );
+  if ( should_exit ) {
+    exit (1);
+  }
+
+  /* check user input */
+  XLAL_CHECK_MAIN ( XLALGPSCmp ( &uvar.startTime, &uvar.endTime ) < 0, XLAL_EINVAL, "--startTime must be before --endTime\n" );
+  XLAL_CHECK_MAIN ( uvar.Tsft > 0, XLAL_EINVAL, "--Tsft must be positive\n" );
+  XLAL_CHECK_MAIN ( uvar.chunkDuration >= uvar.Tsft, XLAL_EINVAL, "--chunkDuration must be at least --Tsft\n" );
+  XLAL_CHECK_MAIN ( uvar.highPassOrder > 0 && uvar.batchSize >= 0 && uvar.numThreads >= 0 && uvar.writeQueueLength >= 0, XLAL_EINVAL,
+                    "--highPassOrder must be positive, and --batchSize, --numThreads and --writeQueueLength non-negative\n" );
+
+  /* open frame cache, restricted to the requested time span */
+  LALCache *cache;
+  XLAL_CHECK_MAIN ( ( cache = XLALCacheImport ( uvar.frameCache ) ) != NULL, XLAL_EFUNC, "Failed to import frame cache '%s'\n", uvar.frameCache );
+  XLAL_CHECK_MAIN ( XLALCacheSieve ( cache, uvar.startTime.gpsSeconds, uvar.endTime.gpsSeconds + 1, NULL, NULL, NULL ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN ( cache->length > 0, XLAL_EINVAL, "No frame files in '%s' overlap the requested time span\n", uvar.frameCache );
+  XLAL_CHECK_MAIN ( XLALCacheSort ( cache ) == XLAL_SUCCESS, XLAL_EFUNC );
+  LALFrStream *framestream;
+  XLAL_CHECK_MAIN ( ( framestream = XLALFrStreamCacheOpen ( cache ) ) != NULL, XLAL_EFUNC );
+  XLAL_CHECK_MAIN ( XLALFrStreamSetMode ( framestream, LAL_FR_STREAM_VERBOSE_MODE ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  /* options of streaming SFT producer, which is created once the sampling time of the channel is known */
+  StreamingSFTsOptionalArgs optArgs = StreamingSFTsOptionalArgsDefaults;
+  optArgs.overlapFraction = uvar.overlapFraction;
+  optArgs.highPassFreq = uvar.highPassFreq;
+  optArgs.highPassOrder = uvar.highPassOrder;
+  optArgs.windowType = ( XLALStringCaseCompare ( uvar.windowType, "rectangular" ) == 0 ) ? NULL : uvar.windowType;
+  optArgs.windowBeta = uvar.windowBeta;
+  optArgs.fMin = uvar.fMin;
+  optArgs.Band = uvar.Band;
+  optArgs.batchSize = uvar.batchSize;
+  optArgs.numThreads = uvar.numThreads;
+  optArgs.writeQueueLength = uvar.writeQueueLength;
+  optArgs.outputDir = uvar.outputDir;
+  optArgs.SFTcomment = uvar.SFTcomment;
+  optArgs.Misc = uvar.Misc;
+  StreamingSFTs *stream = NULL;
+
+  /* number of threads used to transform SFTs */
+  UINT4 numThreads = 1;
+#ifdef _OPENMP
+  numThreads = ( uvar.numThreads > 0 ) ? (UINT4) uvar.numThreads : (UINT4) omp_get_max_threads();
+#endif
+
+  /* read each contiguous span of frame files once, in chunks, and pass them to the SFT producer; with pthreads, the
+     next chunk is read while the SFTs of the current chunk are computed */
+  const REAL8 tStart = XLALGetTimeOfDay();
+  ChunkReader reader = { .framestream = framestream, .uvar = &uvar, .next = uvar.startTime, .spanEnd = uvar.startTime };
+  XLAL_CHECK_MAIN ( ReadNextChunk ( &reader ) == XLAL_SUCCESS, XLAL_EFUNC );
+  while ( reader.chunk != NULL ) {
+    REAL8TimeSeries *chunk = reader.chunk;
+#ifdef LAL_PTHREAD_LOCK
+    pthread_t readAhead;
+    XLAL_CHECK_MAIN ( pthread_create ( &readAhead, NULL, ReadNextChunkThread, &reader ) == 0, XLAL_ESYS, "Failed to start frame reading thread\n" );
+#endif
+    int retn = XLAL_SUCCESS;
+    if ( stream == NULL && ( stream = XLALCreateStreamingSFTs ( chunk->deltaT, uvar.Tsft, &optArgs ) ) == NULL ) {
+      retn = XLAL_FAILURE;
+    }
+    if ( retn == XLAL_SUCCESS ) {
+      retn = XLALStreamingSFTsProcess ( stream, NULL, chunk );
+    }
+#ifdef LAL_PTHREAD_LOCK
+    XLAL_CHECK_MAIN ( pthread_join ( readAhead, NULL ) == 0, XLAL_ESYS );
+#else
+    ReadNextChunkThread ( &reader );
+#endif
+    XLALDestroyREAL8TimeSeries ( chunk );
+    XLAL_CHECK_MAIN ( retn == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN ( reader.errnum == 0, reader.errnum );
+  }
+  UINT8 numSFTs = 0;
+  if ( stream != NULL ) {
+    XLAL_CHECK_MAIN ( XLALStreamingSFTsFlush ( stream ) == XLAL_SUCCESS, XLAL_EFUNC );
+    numSFTs = XLALStreamingSFTsCount ( stream );
+  }
+  const REAL8 wallTime = XLALGetTimeOfDay() - tStart;
+  XLALPrintInfo ( "Wrote %" LAL_UINT8_FORMAT " SFTs to '%s' in %g seconds: %g SFTs/second, %g SFTs/second per thread (%u threads)\n", numSFTs, uvar.outputDir, wallTime,
+                  numSFTs / wallTime, numSFTs / wallTime / numThreads, numThreads );
+
+  /* free memory */
+  XLALDestroyStreamingSFTs ( stream );
+  XLALFrStreamClose ( framestream );
+  XLALDestroyCache ( cache );
+  XLALDestroyUserVars();
+
+  LALCheckMemoryLeaks();
+
+  return XLAL_SUCCESS;
+
+} /* main */
+
+
+/*----------------------------------------------------------------------*/
+/* register all our "user-variables" */
+int
+initUserVars ( UserVar *uvar )
+{
+  /* set a few defaults */
+  uvar->Tsft = 1800;
+  uvar->overlapFraction = StreamingSFTsOptionalArgsDefaults.overlapFraction;
+  uvar->highPassFreq = StreamingSFTsOptionalArgsDefaults.highPassFreq;
+  uvar->highPassOrder = StreamingSFTsOptionalArgsDefaults.highPassOrder;
+  uvar->windowType = XLALStringDuplicate ( StreamingSFTsOptionalArgsDefaults.windowType );
+  uvar->windowBeta = StreamingSFTsOptionalArgsDefaults.windowBeta;
+  uvar->chunkDuration = 16 * 1800;
+  uvar->batchSize = StreamingSFTsOptionalArgsDefaults.batchSize;
+  uvar->numThreads = StreamingSFTsOptionalArgsDefaults.numThreads;
+  uvar->writeQueueLength = 4;
+  uvar->outputDir = XLALStringDuplicate ( "." );
+
+  /* now register all our user-variable */
+  XLALRegisterUvarMember( frameCache,		STRING, 'C', REQUIRED, "Frame cache file listing the frame files to read");
+  XLALRegisterUvarMember( channelName,		STRING, 'N', REQUIRED, "Name of the channel to read from the frame files");
+  XLALRegisterUvarMember( startTime,		EPOCH,  's', REQUIRED, "Start time of the data to create SFTs from");
+  XLALRegisterUvarMember( endTime,		EPOCH,  'e', REQUIRED, "End time of the data to create SFTs from");
+  XLALRegisterUvarMember( Tsft,			REAL8,  't', OPTIONAL, "Duration of each SFT in seconds");
+  XLALRegisterUvarMember( overlapFraction,	REAL8,  'v', OPTIONAL, "Fraction of an SFT by which consecutive SFTs overlap, in [0, 1)");
+  XLALRegisterUvarMember( highPassFreq,		REAL8,  'f', OPTIONAL, "Knee (-3 dB) frequency in Hz of the high-pass filter; 0 = no high-pass filter");
+  XLALRegisterUvarMember( highPassOrder,	INT4,   0,   OPTIONAL, "Order of the Butterworth high-pass filter");
+  XLALRegisterUvarMember( windowType,		STRING, 'w', OPTIONAL, "Window applied to the data of each SFT, or 'rectangular' for no window");
+  XLALRegisterUvarMember( windowBeta,		REAL8,  0,   OPTIONAL, "Parameter of the window, if any");
+  XLALRegisterUvarMember( fMin,			REAL8,  'F', OPTIONAL, "Lowest frequency in Hz to store in SFTs");
+  XLALRegisterUvarMember( Band,			REAL8,  'B', OPTIONAL, "Frequency band in Hz to store in SFTs; 0 = up to the Nyquist frequency");
+  XLALRegisterUvarMember( chunkDuration,	REAL8,  0,   OPTIONAL, "Duration in seconds of each chunk of data read from the frame files");
+  XLALRegisterUvarMember( batchSize,		INT4,   0,   OPTIONAL, "Number of SFTs transformed together by each thread; 0 = choose automatically");
+  XLALRegisterUvarMember( numThreads,		INT4,   'n', OPTIONAL, "Number of threads; 0 = OpenMP default number of threads");
+  XLALRegisterUvarMember( writeQueueLength,	INT4,   0,   OPTIONAL, "Maximum number of SFTs waiting to be written by a separate writer thread (if LAL was built with pthreads); 0 = no writer thread");
+  XLALRegisterUvarMember( outputDir,		STRING, 'p', OPTIONAL, "Directory in which to write SFT files");
+  XLALRegisterUvarMember( SFTcomment,		STRING, 'c', OPTIONAL, "Comment to write to SFT files");
+  XLALRegisterUvarMember( Misc,			STRING, 'X', OPTIONAL, "Misc field of official SFT filenames");
+
+  return XLAL_SUCCESS;
+} /* initUserVars() */
+
+/*----------------------------------------------------------------------*/
+/* read the next chunk of frame data, moving on to the next contiguous span of frame files once the current one is exhausted */
+static int
+ReadNextChunk ( ChunkReader *reader )
+{
+  const UserVar *uvar = reader->uvar;
+  const LALCache *frcache = reader->framestream->cache;
+  reader->chunk = NULL;
+
+  while ( XLALGPSDiff ( &reader->spanEnd, &reader->next ) < 1 ) {
+    if ( reader->nextFile >= frcache->length ) {
+      return XLAL_SUCCESS;
+    }
+
+    /* find contiguous span of frame files, and intersect it with the requested time span */
+    UINT4 i = reader->nextFile;
+    INT4 spanStart = frcache->list[i].t0, spanEnd = frcache->list[i].t0 + frcache->list[i].dt;
+    for ( ++i; i < frcache->length && frcache->list[i].t0 <= spanEnd; ++i ) {
+      if ( spanEnd < frcache->list[i].t0 + frcache->list[i].dt ) {
+        spanEnd = frcache->list[i].t0 + frcache->list[i].dt;
+      }
+    }
+    reader->nextFile = i;
+    LIGOTimeGPS start = { spanStart, 0 }, end = { spanEnd, 0 };
+    if ( XLALGPSCmp ( &start, &uvar->startTime ) < 0 ) {
+      start = uvar->startTime;
+    }
+    if ( XLALGPSCmp ( &end, &uvar->endTime ) > 0 ) {
+      end = uvar->endTime;
+    }
+    reader->next = start;
+    reader->spanEnd = end;
+    if ( XLALGPSDiff ( &end, &start ) < uvar->Tsft ) {
+      reader->spanEnd = start;
+      continue;
+    }
+    XLALPrintInfo ( "Reading contiguous frame data [%d, %d)\n", start.gpsSeconds, end.gpsSeconds );
+  }
+
+  /* read next chunk of span; the first chunk of each span starts a new segment of SFTs */
+  const REAL8 remaining = XLALGPSDiff ( &reader->spanEnd, &reader->next );
+  const REAL8 duration = ( remaining < uvar->chunkDuration ) ? remaining : uvar->chunkDuration;
+  XLAL_CHECK ( XLALFrStreamSeek ( reader->framestream, &reader->next ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK ( ( reader->chunk = XLALFrStreamInputREAL8TimeSeries ( reader->framestream, uvar->channelName, &reader->next, duration, 0 ) ) != NULL, XLAL_EFUNC,
+               "Failed to read %g seconds of channel '%s' at GPS time %d.%09d\n", duration, uvar->channelName, reader->next.gpsSeconds, reader->next.gpsNanoSeconds );
+  reader->next = reader->chunk->epoch;
+  XLALGPSAdd ( &reader->next, reader->chunk->data->length * reader->chunk->deltaT );
+
+  return XLAL_SUCCESS;
+} /* ReadNextChunk() */
+
+/* call ReadNextChunk(), recording its error number; XLAL error numbers are thread-local when LAL is built with pthreads */
+static void *
+ReadNextChunkThread ( void *arg )
+{
+  ChunkReader *reader = (ChunkReader *) arg;
+  reader->errnum = 0;
+  if ( ReadNextChunk ( reader ) != XLAL_SUCCESS ) {
+    reader->errnum = xlalErrno;
+    XLALClearErrno();
+  }
+  return NULL;
+} /* ReadNextChunkThread() */
@@ -0,0 +1,96 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+/**
+ * \file
+ * \ingroup lalapps_pulsar_SFTTools
+ * \brief Write an SFT catalog index for a set of SFT files.
+ *
+ * The index records the headers of all SFTs matching the given file pattern, so that codes which
+ * accept an SFT file pattern can be given <tt>index:\<indexfile\></tt> instead, and avoid reading
+ * the header of every SFT file; see XLALWriteSFTCatalogIndex() and XLALReadSFTCatalogIndex().
+ * An existing index can be brought up to date by passing <tt>index:\<indexfile\></tt> as the input
+ * file pattern, in which case only SFT files modified since the index was written are read again.
+ */
+
+/* ---------- includes ---------- */
+#include "config.h"
+
+#include <LALAppsVCSInfo.h>
+
+#include <lal/UserInput.h>
+#include <lal/SFTfileIO.h>
+
+/* User variables */
+typedef struct
+{
+  CHAR *SFTfiles;
+  CHAR *outputIndex;
+  BOOLEAN checkCRC;
+} UserVariables_t;
+
+/*---------- internal prototypes ----------*/
+int XLALReadUserInput ( int argc, char *argv[], UserVariables_t *uvar );
+
+/*==================== FUNCTION DEFINITIONS ====================*/
+
+int
+main(int argc, char *argv[])
+{
+  /* register all our user-variable */
+  UserVariables_t XLAL_INIT_DECL(uvar);
+  XLAL_CHECK_MAIN ( XLALReadUserInput ( argc, argv, &uvar ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  SFTCatalog *catalog;
+  XLAL_CHECK_MAIN ( (catalog = XLALSFTdataFind ( uvar.SFTfiles, NULL )) != NULL, XLAL_EFUNC, "No SFTs matched your --SFTfiles query\n" );
+
+  if ( uvar.checkCRC )
+    {
+      BOOLEAN crc_check;
+      XLAL_CHECK_MAIN ( XLALCheckCRCSFTCatalog ( &crc_check, catalog ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK_MAIN ( crc_check, XLAL_EDATA, "SFTs matching --SFTfiles query failed CRC64 checksum validation\n" );
+    }
+
+  XLAL_CHECK_MAIN ( XLALWriteSFTCatalogIndex ( catalog, uvar.outputIndex ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLALPrintInfo ( "Wrote %u SFTs to SFT catalog index '%s'\n", catalog->length, uvar.outputIndex );
+
+  /* free memory */
+  XLALDestroySFTCatalog ( catalog );
+  XLALDestroyUserVars();
+
+  LALCheckMemoryLeaks();
+
+  return 0;
+} /* main */
+
+int
+XLALReadUserInput ( int argc, char *argv[], UserVariables_t *uvar )
+{
+  XLALRegisterUvarMember(	SFTfiles,	STRING,  'i', REQUIRED, "File-pattern for input SFTs, or 'index:<indexfile>' to update an existing SFT catalog index");
+  XLALRegisterUvarMember(	outputIndex,	STRING,  'o', REQUIRED, "Name of SFT catalog index file to write");
+  XLALRegisterUvarMember(	checkCRC,	BOOLEAN, 'c', OPTIONAL, "Check CRC64 checksums of all SFTs before writing the index");
+
+  /* read cmdline & cfgfile  */
+  BOOLEAN should_exit = 0;
+  XLAL_CHECK( XLALUserVarReadAllInput( &should_exit, argc, argv, lalAppsVCSInfoList ) == XLAL_SUCCESS, XLAL_EFUNC );
+  if ( should_exit ) {
+    exit (1);
+  }
+
+  return XLAL_SUCCESS;
+
+} // XLALReadUserInput()
@@ -0,0 +1,91 @@
+## create good and bad SFTs
+SFTwrite
+
+## write an SFT catalog index for a set of SFTs with consistent frequency spacing
+echo "lalapps_MakeSFTCatalogIndex -i './SFT-test[1235]*' -o sft-index.txt --checkCRC"
+if ! lalapps_MakeSFTCatalogIndex -i './SFT-test[1235]*' -o sft-index.txt --checkCRC; then
+    echo "ERROR: lalapps_MakeSFTCatalogIndex failed"
+    exit 1
+fi
+echo
+
+## SFT headers read through the index should be identical to those read from the SFTs;
+## file names are recorded relative to the directory of the index, and so differ in their locators
+lalapps_dumpSFT -H -i './SFT-test[1235]*' | grep -v '^%' | grep -v '^Locator' > headers-sfts.txt
+lalapps_dumpSFT -H -i 'index:sft-index.txt' | grep -v '^%' | grep -v '^Locator' > headers-index.txt
+if ! diff -s headers-sfts.txt headers-index.txt; then
+    echo "ERROR: SFT headers read from SFTs and from SFT catalog index should be equal"
+    exit 1
+fi
+echo
+
+## an index written to another directory should be usable from any working directory, and
+## modified SFTs should be read again even if their file names contain pattern characters
+mkdir -p index-dir
+cp SFT-test1 'index-dir/SFT;test1'
+if ! lalapps_MakeSFTCatalogIndex -i 'index-dir/SFT?test1' -o index-dir/sft-index.txt; then
+    echo "ERROR: lalapps_MakeSFTCatalogIndex failed to write SFT catalog index to another directory"
+    exit 1
+fi
+lalapps_dumpSFT -H -i 'index-dir/SFT?test1' | grep -v '^%' | grep -v '^Locator' > headers-dir-sfts.txt
+( cd index-dir && lalapps_dumpSFT -H -i 'index:sft-index.txt' ) | grep -v '^%' | grep -v '^Locator' > headers-dir-index.txt
+if ! diff -s headers-dir-sfts.txt headers-dir-index.txt; then
+    echo "ERROR: SFT headers read from SFTs and from SFT catalog index in another directory should be equal"
+    exit 1
+fi
+touch -d '2001-01-01' 'index-dir/SFT;test1'
+( cd index-dir && lalapps_dumpSFT -H -i 'index:sft-index.txt' ) | grep -v '^%' | grep -v '^Locator' > headers-dir-index-modified.txt
+if ! diff -s headers-dir-sfts.txt headers-dir-index-modified.txt; then
+    echo "ERROR: SFT headers read from modified SFT with pattern characters in its name and from SFT catalog index should be equal"
+    exit 1
+fi
+
+## absolute file names of SFTs inside the directory of the index should be recorded relative to it,
+## so that the directory can be moved
+if ! lalapps_MakeSFTCatalogIndex -i "${PWD}/index-dir/SFT?test1" -o index-dir/sft-index-abs.txt; then
+    echo "ERROR: lalapps_MakeSFTCatalogIndex failed to write SFT catalog index for absolute SFT file names"
+    exit 1
+fi
+if ! grep -q '^file .* SFT;test1$' index-dir/sft-index-abs.txt; then
+    echo "ERROR: absolute SFT file name inside the directory of the SFT catalog index should be recorded relative to it"
+    exit 1
+fi
+rm -rf index-dir-moved
+mv index-dir index-dir-moved
+( cd index-dir-moved && lalapps_dumpSFT -H -i 'index:sft-index-abs.txt' ) | grep -v '^%' | grep -v '^Locator' > headers-dir-index-moved.txt
+if ! diff -s headers-dir-sfts.txt headers-dir-index-moved.txt; then
+    echo "ERROR: SFT headers read from SFT catalog index in a moved directory should be equal"
+    exit 1
+fi
+echo
+
+## modify one of the indexed SFTs, which should then be read again
+cp SFT-test1 SFT-test2
+touch -d '2001-01-01' SFT-test2
+lalapps_dumpSFT -H -i './SFT-test[1235]*' | grep -v '^%' | grep -v '^Locator' > headers-sfts-modified.txt
+lalapps_dumpSFT -H -i 'index:sft-index.txt' | grep -v '^%' | grep -v '^Locator' > headers-index-modified.txt
+if ! diff -s headers-sfts-modified.txt headers-index-modified.txt; then
+    echo "ERROR: SFT headers read from modified SFTs and from SFT catalog index should be equal"
+    exit 1
+fi
+echo
+
+## update the index, which should then match the modified SFTs
+if ! lalapps_MakeSFTCatalogIndex -i 'index:sft-index.txt' -o sft-index-updated.txt; then
+    echo "ERROR: lalapps_MakeSFTCatalogIndex failed to update SFT catalog index"
+    exit 1
+fi
+lalapps_dumpSFT -H -i 'index:sft-index-updated.txt' | grep -v '^%' | grep -v '^Locator' > headers-index-updated.txt
+if ! diff -s headers-sfts-modified.txt headers-index-updated.txt; then
+    echo "ERROR: SFT headers read from modified SFTs and from updated SFT catalog index should be equal"
+    exit 1
+fi
+echo
+
+## an index referring to a missing SFT should fail
+rm -f SFT-test3
+if lalapps_dumpSFT -H -i 'index:sft-index.txt'; then
+    echo "ERROR: lalapps_dumpSFT should fail for SFT catalog index referring to a missing SFT"
+    exit 1
+fi
+echo
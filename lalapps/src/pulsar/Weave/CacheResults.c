@@ -31,6 +31,11 @@
 // Compare two quantities, and return a sort order value if they are unequal
 #define COMPARE_BY( x, y ) do { if ( (x) < (y) ) return -1; if ( (x) > (y) ) return +1; } while(0)
 
+const UserChoices WeaveCacheStrategyChoices = {
+  { WEAVE_CACHE_STRATEGY_RELEVANCE,     "relevance" },
+  { WEAVE_CACHE_STRATEGY_FIFO,          "fifo" },
+};
+
 ///
 /// Item stored in the cache
 ///
@@ -39,12 +44,54 @@ typedef struct {
   UINT4 generation;
   /// Relevance, used to decide how long to keep items
   REAL4 relevance;
+  /// Sequence number, used to decide how long to keep items
+  UINT8 sequence;
+  /// Memory used by coherent results, in bytes
+  UINT8 bytes;
   /// Coherent locator index, used to find items in cache
   UINT8 coh_index;
   /// Results of a coherent computation on a single segment
   WeaveCohResults *coh_res;
 } cache_item;
 
+///
+/// Statistics on the use of a cache
+///
+typedef struct {
+  /// Number of queries answered from the cache
+  UINT8 nhits;
+  /// Number of queries which required coherent results to be computed
+  UINT8 nmisses;
+  /// Number of queries which required coherent results to be recomputed
+  UINT8 nrecomputes;
+  /// Number of items removed to keep the cache within its size/memory limits
+  UINT8 nevictions;
+  /// Maximum number of items stored in the cache
+  UINT4 max_items;
+  /// Maximum memory used by items stored in the cache, in bytes
+  UINT8 max_bytes;
+} cache_stats;
+
+///
+/// Statistics on the use of caches for a single segment, as written to a FITS table
+///
+typedef struct {
+  /// Number of queries answered from the caches
+  UINT8 nhits;
+  /// Number of queries which required coherent results to be computed
+  UINT8 nmisses;
+  /// Number of queries which required coherent results to be recomputed
+  UINT8 nrecomputes;
+  /// Number of items removed to keep the caches within their size/memory limits
+  UINT8 nevictions;
+  /// Fraction of queries answered from the caches
+  REAL8 hit_rate;
+  /// Maximum number of items stored in the caches
+  UINT4 max_items;
+  /// Maximum memory used by items stored in the caches, in MB
+  REAL8 max_mem;
+} cache_info;
+
 ///
 /// Container for a series of cache queries
 ///
@@ -119,10 +166,18 @@ struct tagWeaveCache {
   UINT8 coh_max_index;
   /// Current generation of cache items
   UINT4 generation;
-  /// Heap which ranks cache items by relevance
+  /// Strategy used to decide which items to remove from the cache
+  WeaveCacheStrategy strategy;
+  /// Heap which ranks cache items by relevance, or by sequence number
   LALHeap *relevance_heap;
-  /// Maximum size obtained by relevance heap
-  UINT4 heap_max_size;
+  /// Sequence number of the next cache item
+  UINT8 sequence;
+  /// Maximum memory which may be used by cache items, in bytes
+  UINT8 max_bytes;
+  /// Current memory used by cache items, in bytes
+  UINT8 bytes;
+  /// Statistics on the use of the cache
+  cache_stats stats;
   /// Hash table which looks up cache items by index
   LALHashTbl *coh_index_hash;
   /// Bitset which records whether an item has ever been computed
@@ -147,6 +202,8 @@ static int cache_max_semi_bbox_sample_dim0( const WeaveCache *cache, const Latti
 static UINT8 cache_item_hash( const void *x );
 static int cache_item_compare_by_coh_index( const void *x, const void *y );
 static int cache_item_compare_by_relevance( const void *x, const void *y );
+static int cache_item_compare_by_sequence( const void *x, const void *y );
+static int cache_remove_root( WeaveCache *cache );
 static void cache_item_destroy( void *x );
 
 /// @}
@@ -180,6 +237,21 @@ int cache_item_compare_by_relevance(
   return 0;
 }
 
+///
+/// Compare cache items by generation, then sequence number
+///
+int cache_item_compare_by_sequence(
+  const void *x,
+  const void *y
+  )
+{
+  const cache_item *ix = ( const cache_item * ) x;
+  const cache_item *iy = ( const cache_item * ) y;
+  COMPARE_BY( ix->generation, iy->generation );   // Compare in ascending order
+  COMPARE_BY( ix->sequence, iy->sequence );   // Compare in ascending order
+  return 0;
+}
+
 ///
 /// Compare cache items by generation, then locator index
 ///
@@ -209,6 +281,32 @@ UINT8 cache_item_hash(
   return hval;
 }
 
+///
+/// Remove and destroy the item at the root of the relevance heap
+///
+int cache_remove_root(
+  WeaveCache *cache
+  )
+{
+
+  // Get the item at the root of the relevance heap
+  const cache_item *root_item = ( const cache_item * ) XLALHeapRoot( cache->relevance_heap );
+  XLAL_CHECK( xlalErrno == 0, XLAL_EFUNC );
+  XLAL_CHECK( root_item != NULL, XLAL_EFAILED );
+
+  // Remove root item from index hash table
+  XLAL_CHECK( XLALHashTblRemove( cache->coh_index_hash, root_item ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Subtract memory used by root item
+  cache->bytes -= root_item->bytes;
+
+  // Remove and destroy root item from the relevance heap
+  XLAL_CHECK( XLALHeapRemoveRoot( cache->relevance_heap ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  return XLAL_SUCCESS;
+
+}
+
 ///
 /// Sample points on surface of coherent bounding box, convert to semicoherent supersky
 /// coordinates, and record maximum value of semicoherent coordinate in dimension 'dim0'
@@ -610,6 +708,32 @@ int XLALWeaveCacheQueriesGetCounts(
 
 }
 
+///
+/// Add the counts of computed coherent results, and of coherent and semicoherent templates,
+/// accumulated by another set of cache queries, e.g. one used by a separate thread
+///
+int XLALWeaveCacheQueriesAddCounts(
+  WeaveCacheQueries *queries,
+  const WeaveCacheQueries *other
+  )
+{
+
+  // Check input
+  XLAL_CHECK( queries != NULL, XLAL_EFAULT );
+  XLAL_CHECK( other != NULL, XLAL_EFAULT );
+  XLAL_CHECK( queries->nqueries == other->nqueries, XLAL_EINVAL );
+
+  // Add counts
+  for ( size_t i = 0; i < queries->nqueries; ++i ) {
+    queries->coh_nres[i] += other->coh_nres[i];
+    queries->coh_ntmpl[i] += other->coh_ntmpl[i];
+  }
+  queries->semi_ntmpl += other->semi_ntmpl;
+
+  return XLAL_SUCCESS;
+
+}
+
 ///
 /// Create a cache
 ///
@@ -620,6 +744,8 @@ WeaveCache *XLALWeaveCacheCreate(
   const SuperskyTransformData *semi_rssky_transf,
   WeaveCohInput *coh_input,
   const UINT4 max_size,
+  const UINT8 max_bytes,
+  const WeaveCacheStrategy strategy,
   const BOOLEAN all_gc
   )
 {
@@ -627,6 +753,8 @@ WeaveCache *XLALWeaveCacheCreate(
   // Check input
   XLAL_CHECK_NULL( coh_tiling != NULL, XLAL_EFAULT );
   XLAL_CHECK_NULL( coh_input != NULL, XLAL_EFAULT );
+  XLAL_CHECK_NULL( strategy == WEAVE_CACHE_STRATEGY_RELEVANCE || strategy == WEAVE_CACHE_STRATEGY_FIFO, XLAL_EINVAL );
+  XLAL_CHECK_NULL( strategy == WEAVE_CACHE_STRATEGY_RELEVANCE || max_size > 0 || max_bytes > 0, XLAL_EINVAL, "Cache strategy other than relevance requires a maximum cache size or memory" );
 
   // Allocate memory
   WeaveCache *cache = XLALCalloc( 1, sizeof( *cache ) );
@@ -637,13 +765,18 @@ WeaveCache *XLALWeaveCacheCreate(
   cache->semi_rssky_transf = semi_rssky_transf;
   cache->coh_input = coh_input;
   cache->generation = 0;
+  cache->strategy = strategy;
+  cache->max_bytes = max_bytes;
 
   // Set garbage collection mode:
   // - Garbage collection is not performed for a fixed-size cache (i.e. 'max_size > 0'),
   //   i.e. the cache will only discard items once the fixed-size cache is full, but not
   //   try to remove cache items earlier based on their relevances
+  // - Garbage collection is only performed if cache items are ranked by relevance
   // - Garbage collection is applied to as many items as possible if 'all_gc' is true
-  cache->any_gc = ( max_size == 0 );
+  // - A cache with a maximum memory 'max_bytes' still performs garbage collection, but will
+  //   also discard items whenever adding a new item would exceed the maximum memory
+  cache->any_gc = ( max_size == 0 ) && ( strategy == WEAVE_CACHE_STRATEGY_RELEVANCE );
   cache->all_gc = all_gc;
 
   // Get number of parameter-space dimensions
@@ -743,8 +876,12 @@ WeaveCache *XLALWeaveCacheCreate(
   // In short, an item in the cache can be discarded once its relevance falls below the threshold set
   // by the current point semicoherent in the semicoherent parameter-space tiling.
   //
+  // If the cache strategy is WEAVE_CACHE_STRATEGY_FIFO, the heap instead sorts items by the order
+  // in which they were added; this discards the oldest items first once the cache is full.
+  //
   // Items removed from the heap are destroyed by calling cache_item_destroy().
-  cache->relevance_heap = XLALHeapCreate( cache_item_destroy, max_size, -1, cache_item_compare_by_relevance );
+  LALHeapCmpFcn heap_cmp = ( strategy == WEAVE_CACHE_STRATEGY_FIFO ) ? cache_item_compare_by_sequence : cache_item_compare_by_relevance;
+  cache->relevance_heap = XLALHeapCreate( cache_item_destroy, max_size, -1, heap_cmp );
   XLAL_CHECK_NULL( cache->relevance_heap != NULL, XLAL_EFUNC );
 
   // Create a hash table which looks up cache items by partition and locator index. Items removed
@@ -796,9 +933,81 @@ int XLALWeaveCacheWriteInfo(
   {
     UINT4 heap_max_size = 0;
     for ( size_t i = 0; i < ncache; ++i ) {
-      heap_max_size += cache[i]->heap_max_size;
+      heap_max_size += cache[i]->stats.max_items;
     }
-    XLAL_CHECK_MAIN( XLALFITSHeaderWriteUINT4( file, "cachemax", heap_max_size, "maximum size obtained by cache" ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( XLALFITSHeaderWriteUINT4( file, "cachemax", heap_max_size, "maximum size obtained by cache" ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  // Write total maximum memory used by cache items
+  {
+    UINT8 max_bytes = 0;
+    for ( size_t i = 0; i < ncache; ++i ) {
+      max_bytes += cache[i]->stats.max_bytes;
+    }
+    XLAL_CHECK( XLALFITSHeaderWriteREAL8( file, "cachemaxmem [MB]", ( ( REAL8 ) max_bytes ) / ( 1024.0 * 1024.0 ), "maximum memory used by cache" ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  // Write total number of items removed to keep caches within their size/memory limits
+  {
+    UINT8 nevictions = 0;
+    for ( size_t i = 0; i < ncache; ++i ) {
+      nevictions += cache[i]->stats.nevictions;
+    }
+    XLAL_CHECK( XLALFITSHeaderWriteUINT8( file, "cacheevict", nevictions, "number of items evicted from cache" ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  return XLAL_SUCCESS;
+
+}
+
+///
+/// Write statistics on the use of caches, summed over caches for the same segment, to a FITS file
+///
+int XLALWeaveCacheWriteSegInfo(
+  FITSFile *file,
+  const size_t nsegments,
+  const size_t ncache,
+  WeaveCache *const *cache
+  )
+{
+
+  // Check input
+  XLAL_CHECK( file != NULL, XLAL_EFAULT );
+  XLAL_CHECK( nsegments > 0, XLAL_ESIZE );
+  XLAL_CHECK( ncache > 0, XLAL_ESIZE );
+  XLAL_CHECK( ncache % nsegments == 0, XLAL_ESIZE );
+  XLAL_CHECK( cache != NULL, XLAL_EFAULT );
+
+  // Begin FITS table
+  XLAL_CHECK( XLALFITSTableOpenWrite( file, "cache_info", "cache information" ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Describe FITS table
+  XLAL_FITS_TABLE_COLUMN_BEGIN( cache_info );
+  XLAL_CHECK( XLAL_FITS_TABLE_COLUMN_ADD( file, UINT8, nhits ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLAL_FITS_TABLE_COLUMN_ADD( file, UINT8, nmisses ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLAL_FITS_TABLE_COLUMN_ADD( file, UINT8, nrecomputes ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLAL_FITS_TABLE_COLUMN_ADD( file, UINT8, nevictions ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLAL_FITS_TABLE_COLUMN_ADD( file, REAL8, hit_rate ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLAL_FITS_TABLE_COLUMN_ADD( file, UINT4, max_items ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLAL_FITS_TABLE_COLUMN_ADD_NAMED( file, REAL8, max_mem, "max_mem [MB]" ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Write FITS table
+  // - Caches are ordered by segment, then repeated for each thread
+  for ( size_t i = 0; i < nsegments; ++i ) {
+    cache_info XLAL_INIT_DECL( record );
+    UINT8 max_bytes = 0;
+    for ( size_t j = i; j < ncache; j += nsegments ) {
+      record.nhits += cache[j]->stats.nhits;
+      record.nmisses += cache[j]->stats.nmisses;
+      record.nrecomputes += cache[j]->stats.nrecomputes;
+      record.nevictions += cache[j]->stats.nevictions;
+      record.max_items += cache[j]->stats.max_items;
+      max_bytes += cache[j]->stats.max_bytes;
+    }
+    const UINT8 nqueries = record.nhits + record.nmisses;
+    record.hit_rate = ( nqueries > 0 ) ? ( ( REAL8 ) record.nhits ) / nqueries : 0;
+    record.max_mem = ( ( REAL8 ) max_bytes ) / ( 1024.0 * 1024.0 );
+    XLAL_CHECK( XLALFITSTableWriteRow( file, &record ) == XLAL_SUCCESS, XLAL_EFUNC );
   }
 
   return XLAL_SUCCESS;
@@ -838,6 +1047,7 @@ int XLALWeaveCacheClear(
   // Clear items in the relevance heap and hash table from memory
   XLAL_CHECK( XLALHeapClear( cache->relevance_heap ) == XLAL_SUCCESS, XLAL_EFUNC );
   XLAL_CHECK( XLALHashTblClear( cache->coh_index_hash ) == XLAL_SUCCESS, XLAL_EFUNC );
+  cache->bytes = 0;
 
   // Reset current generation of cache items
   cache->generation = 0;
@@ -889,12 +1099,27 @@ int XLALWeaveCacheRetrieve(
     // Set the relevance of the coherent frequency block associated with the new cache item
     new_item->relevance = queries->coh_relevance[query_index];
 
+    // Set the sequence number of the new cache item
+    new_item->sequence = cache->sequence++;
+
     // Determine the number of points in the coherent frequency block
     const UINT4 coh_nfreqs = queries->coh_right[query_index] - queries->coh_left[query_index] + 1;
 
     // Compute coherent results for the new cache item
     XLAL_CHECK( XLALWeaveCohResultsCompute( &new_item->coh_res, cache->coh_input, &queries->coh_phys[query_index], coh_nfreqs, tim ) == XLAL_SUCCESS, XLAL_EFUNC );
 
+    // Record memory used by the new cache item
+    new_item->bytes = XLALWeaveCohResultsMemory( new_item->coh_res );
+
+    // If the cache has a maximum memory, remove items until the new cache item will fit
+    // - The new cache item is always added, even if it alone exceeds the maximum memory
+    if ( cache->max_bytes > 0 ) {
+      while ( XLALHeapSize( cache->relevance_heap ) > 0 && cache->bytes + new_item->bytes > cache->max_bytes ) {
+        XLAL_CHECK( cache_remove_root( cache ) == XLAL_SUCCESS, XLAL_EFUNC );
+        ++cache->stats.nevictions;
+      }
+    }
+
     // Add new cache item to the index hash table
     XLAL_CHECK( XLALHashTblAdd( cache->coh_index_hash, new_item ) == XLAL_SUCCESS, XLAL_EFUNC );
 
@@ -913,6 +1138,7 @@ int XLALWeaveCacheRetrieve(
 
       // Exchange 'saved_item' with the least relevant item in the relevance heap
       XLAL_CHECK( XLALHeapExchangeRoot( cache->relevance_heap, ( void ** ) &cache->saved_item ) == XLAL_SUCCESS, XLAL_EFUNC );
+      cache->bytes += new_item->bytes - cache->saved_item->bytes;
 
       // If maximal garbage collection is enabled, remove as many results as possible
       while ( cache->all_gc ) {
@@ -924,11 +1150,8 @@ int XLALWeaveCacheRetrieve(
         // If item's relevance has fallen below the threshold relevance, it can be removed from the cache
         if ( least_relevant_item != NULL && least_relevant_item != new_item && cache_item_compare_by_relevance( least_relevant_item, &relevance_threshold ) < 0 ) {
 
-          // Remove least relevant item from index hash table
-          XLAL_CHECK( XLALHashTblRemove( cache->coh_index_hash, least_relevant_item ) == XLAL_SUCCESS, XLAL_EFUNC );
-
-          // Remove and destroy least relevant item from the relevance heap
-          XLAL_CHECK( XLALHeapRemoveRoot( cache->relevance_heap ) == XLAL_SUCCESS, XLAL_EINVAL );
+          // Remove and destroy least relevant item from the index hash table and relevance heap
+          XLAL_CHECK( cache_remove_root( cache ) == XLAL_SUCCESS, XLAL_EFUNC );
 
         } else {
 
@@ -943,20 +1166,32 @@ int XLALWeaveCacheRetrieve(
 
       // Add new cache item to the relevance heap; 'saved_item' many now contains an item removed from the heap
       XLAL_CHECK( XLALHeapAdd( cache->relevance_heap, ( void ** ) &cache->saved_item ) == XLAL_SUCCESS, XLAL_EFUNC );
+      cache->bytes += new_item->bytes;
 
       // If 'saved_item' contains an item removed from the heap, also remove it from the index hash table
+      // - Only count an eviction if the heap removed an existing item, rather than rejecting the new cache item itself
       if ( cache->saved_item != NULL ) {
         XLAL_CHECK( XLALHashTblRemove( cache->coh_index_hash, cache->saved_item ) == XLAL_SUCCESS, XLAL_EFUNC );
+        cache->bytes -= cache->saved_item->bytes;
+        if ( cache->saved_item != new_item ) {
+          ++cache->stats.nevictions;
+        }
       }
 
     }
 
-    // Update maximum size obtained by relevance heap
+    // Update maximum size and memory obtained by relevance heap
     const UINT4 heap_size = XLALHeapSize( cache->relevance_heap );
-    if ( cache->heap_max_size < heap_size ) {
-      cache->heap_max_size = heap_size;
+    if ( cache->stats.max_items < heap_size ) {
+      cache->stats.max_items = heap_size;
+    }
+    if ( cache->stats.max_bytes < cache->bytes ) {
+      cache->stats.max_bytes = cache->bytes;
     }
 
+    // Increment number of cache misses
+    ++cache->stats.nmisses;
+
     // Increment number of computed coherent results
     queries->coh_nres[query_index] += coh_nfreqs;
 
@@ -972,8 +1207,18 @@ int XLALWeaveCacheRetrieve(
       // This coherent result has now been computed
       XLAL_CHECK( XLALBitsetSet( cache->coh_computed_bitset, coh_bitset_index, 1 ) == XLAL_SUCCESS, XLAL_EFUNC );
 
+    } else {
+
+      // Coherent results have been computed before: increment the number of recomputations
+      ++cache->stats.nrecomputes;
+
     }
 
+  } else {
+
+    // Increment number of cache hits
+    ++cache->stats.nhits;
+
   }
 
   // Return coherent results from cache
@@ -32,11 +32,27 @@
 
 #include <lal/LatticeTiling.h>
 #include <lal/SuperskyMetrics.h>
+#include <lal/UserInput.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+///
+/// Strategies used to decide which items to remove from a full cache
+///
+enum tagWeaveCacheStrategy {
+  /// Remove items with the smallest relevance first
+  WEAVE_CACHE_STRATEGY_RELEVANCE,
+  /// Remove items in the order in which they were added
+  WEAVE_CACHE_STRATEGY_FIFO,
+};
+
+///
+/// Names of cache strategies, for use with UserInput
+///
+extern const UserChoices WeaveCacheStrategyChoices;
+
 WeaveCacheQueries *XLALWeaveCacheQueriesCreate(
   const LatticeTiling *semi_tiling,
   const SuperskyTransformData *semi_rssky_transf,
@@ -71,6 +87,10 @@ int XLALWeaveCacheQueriesGetCounts(
   UINT8 *coh_ntmpl,
   UINT8 *semi_ntmpl
   );
+int XLALWeaveCacheQueriesAddCounts(
+  WeaveCacheQueries *queries,
+  const WeaveCacheQueries *other
+  );
 WeaveCache *XLALWeaveCacheCreate(
   const LatticeTiling *coh_tiling,
   const BOOLEAN interpolation,
@@ -78,6 +98,8 @@ WeaveCache *XLALWeaveCacheCreate(
   const SuperskyTransformData *semi_rssky_transf,
   WeaveCohInput *coh_input,
   const UINT4 max_size,
+  const UINT8 max_bytes,
+  const WeaveCacheStrategy strategy,
   const BOOLEAN all_gc
   );
 void XLALWeaveCacheDestroy(
@@ -88,6 +110,12 @@ int XLALWeaveCacheWriteInfo(
   const size_t ncache,
   WeaveCache *const *cache
   );
+int XLALWeaveCacheWriteSegInfo(
+  FITSFile *file,
+  const size_t nsegments,
+  const size_t ncache,
+  WeaveCache *const *cache
+  );
 int XLALWeaveCacheExpire(
   WeaveCache *cache
   );
@@ -304,7 +304,7 @@ int XLALWeaveCohInputWriteInfo(
   if ( coh_input[0]->Fstat_collect_timing ) {
 
     // Get timing information from F-statistic input data
-    REAL4 tauF_eff = 0, tauF_core = 0, tauF_buffer = 0, NCalls = 0, NBufferMisses = 0;
+    REAL4 tauF_eff = 0, tauF_core = 0, tauF_buffer = 0, NCalls = 0, NBufferMisses = 0, tauSetupNorm = 0;
     UINT4 nmodel = 0;
     const char *XLAL_INIT_DECL( model_names, [TIMING_MODEL_MAX_VARS] );
     REAL4 XLAL_INIT_DECL( model_values, [TIMING_MODEL_MAX_VARS] );
@@ -322,6 +322,7 @@ int XLALWeaveCohInputWriteInfo(
       tauF_buffer += timing_generic.tauF_buffer;
       NCalls += timing_generic.NCalls;
       NBufferMisses += timing_generic.NBufferMisses;
+      tauSetupNorm += timing_generic.tauSetupNorm;
 
       // Get names of method-specific timing constants
       if ( nmodel == 0 ) {
@@ -348,6 +349,7 @@ int XLALWeaveCohInputWriteInfo(
     XLAL_CHECK( XLALFITSHeaderWriteREAL4( file, "fstat tauF_core", tauF_core / ncoh_input, "F-statistic generic timing constant" ) == XLAL_SUCCESS, XLAL_EFUNC );
     XLAL_CHECK( XLALFITSHeaderWriteREAL4( file, "fstat tauF_buffer", tauF_buffer / ncoh_input, "F-statistic generic timing constant" ) == XLAL_SUCCESS, XLAL_EFUNC );
     XLAL_CHECK( XLALFITSHeaderWriteREAL4( file, "fstat b", NBufferMisses / NCalls, "F-statistic generic timing constant" ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( XLALFITSHeaderWriteREAL4( file, "fstat tauSetupNorm", tauSetupNorm, "total time to normalise SFTs of all segments" ) == XLAL_SUCCESS, XLAL_EFUNC );
 
     // Write method-specific timing constants
     for ( size_t j = 0; j < nmodel; ++j ) {
@@ -518,6 +520,28 @@ void XLALWeaveCohResultsDestroy(
   }
 }
 
+///
+/// Return the memory, in bytes, used to store coherent results
+///
+UINT8 XLALWeaveCohResultsMemory(
+  const WeaveCohResults *coh_res
+  )
+{
+  UINT8 bytes = 0;
+  if ( coh_res != NULL ) {
+    bytes += sizeof( *coh_res );
+    if ( coh_res->coh2F != NULL ) {
+      bytes += sizeof( *coh_res->coh2F ) + coh_res->coh2F->length * sizeof( coh_res->coh2F->data[0] );
+    }
+    for ( size_t i = 0; i < PULSAR_MAX_DETECTORS; ++i ) {
+      if ( coh_res->coh2F_det[i] != NULL ) {
+        bytes += sizeof( *coh_res->coh2F_det[i] ) + coh_res->coh2F_det[i]->length * sizeof( coh_res->coh2F_det[i]->data[0] );
+      }
+    }
+  }
+  return bytes;
+}
+
 ///
 /// Create and initialise semicoherent results
 ///
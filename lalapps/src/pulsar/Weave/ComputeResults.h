@@ -132,6 +132,9 @@ int XLALWeaveCohResultsCompute(
 void XLALWeaveCohResultsDestroy(
   WeaveCohResults *coh_res
   );
+UINT8 XLALWeaveCohResultsMemory(
+  const WeaveCohResults *coh_res
+  );
 int XLALWeaveSemiResultsInit(
   WeaveSemiResults **semi_res,
   const WeaveSimulationLevel simulation_level,
@@ -36,6 +36,8 @@ struct tagWeaveOutputResults {
   /// NOTE: this is the *owner* of WeaveStatisticsParams, which is where it will be freed at the end
   /// while toplists will simply hold a reference-pointer
   WeaveStatisticsParams *statistics_params;
+  /// Whether this is a shard of another output results struct, which owns WeaveStatisticsParams
+  BOOLEAN shard;
   /// Reference time at which search is conducted
   LIGOTimeGPS ref_time;
   /// Number of spindown parameters to output
@@ -231,6 +233,27 @@ WeaveOutputResults *XLALWeaveOutputResultsCreate(
 
 }
 
+///
+/// Create a shard of output results, i.e. an empty output results struct with the same toplists,
+/// to which results may be added independently (e.g. by another thread) and later merged back
+/// with XLALWeaveOutputResultsMerge(); the shard holds only a reference to WeaveStatisticsParams
+///
+WeaveOutputResults *XLALWeaveOutputResultsCreateShard(
+  const WeaveOutputResults *out
+  )
+{
+  // Check input
+  XLAL_CHECK_NULL( out != NULL, XLAL_EFAULT );
+
+  // Create output results with the same parameters
+  WeaveOutputResults *shard = XLALWeaveOutputResultsCreate( &out->ref_time, out->nspins, out->statistics_params, out->toplist_limit, out->toplist_tmpl_idx );
+  XLAL_CHECK_NULL( shard != NULL, XLAL_EFUNC );
+  shard->shard = 1;
+
+  return shard;
+
+}
+
 ///
 /// Free output results
 ///
@@ -239,7 +262,9 @@ void XLALWeaveOutputResultsDestroy(
   )
 {
   if ( out != NULL ) {
-    XLALWeaveStatisticsParamsDestroy( out->statistics_params );
+    if ( !out->shard ) {
+      XLALWeaveStatisticsParamsDestroy( out->statistics_params );
+    }
     for ( size_t i = 0; i < out->ntoplists; ++i ) {
       XLALWeaveResultsToplistDestroy( out->toplists[i] );
     }
@@ -262,7 +287,9 @@ int XLALWeaveOutputResultsAdd(
   XLAL_CHECK( semi_res != NULL, XLAL_EFAULT );
 
   // Store main-loop parameters relevant for completion-loop statistics calculation
+  // - Shards share the same WeaveStatisticsParams, and may be added to concurrently
   static BOOLEAN firstTime = 1;
+#pragma omp critical (XLALWeaveOutputResultsAdd)
   if ( firstTime ) {
     out->statistics_params->nsum2F = semi_res->nsum2F;
     memcpy( out->statistics_params->nsum2F_det, semi_res->nsum2F_det, sizeof( semi_res->nsum2F_det ) );
@@ -278,6 +305,30 @@ int XLALWeaveOutputResultsAdd(
 
 }
 
+///
+/// Merge a shard of output results, created with XLALWeaveOutputResultsCreateShard(), into output results
+///
+int XLALWeaveOutputResultsMerge(
+  WeaveOutputResults *out,
+  WeaveOutputResults *shard
+  )
+{
+
+  // Check input
+  XLAL_CHECK( out != NULL, XLAL_EFAULT );
+  XLAL_CHECK( shard != NULL, XLAL_EFAULT );
+  XLAL_CHECK( shard->shard && shard->statistics_params == out->statistics_params, XLAL_EINVAL );
+  XLAL_CHECK( shard->ntoplists == out->ntoplists, XLAL_EINVAL );
+
+  // Merge toplists
+  for ( size_t i = 0; i < out->ntoplists; ++i ) {
+    XLAL_CHECK( XLALWeaveResultsToplistMerge( out->toplists[i], shard->toplists[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  return XLAL_SUCCESS;
+
+}
+
 ///
 /// Compute all the missing 'completion-loop' statistics for all toplist entries
 ///
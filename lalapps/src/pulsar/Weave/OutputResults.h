@@ -44,6 +44,9 @@ WeaveOutputResults *XLALWeaveOutputResultsCreate(
   const UINT4 toplist_limit,
   const BOOLEAN toplist_tmpl_idx
   );
+WeaveOutputResults *XLALWeaveOutputResultsCreateShard(
+  const WeaveOutputResults *out
+  );
 void XLALWeaveOutputResultsDestroy(
   WeaveOutputResults *out
   );
@@ -52,6 +55,10 @@ int XLALWeaveOutputResultsAdd(
   const WeaveSemiResults *semi_res,
   const UINT4 semi_nfreqs
   );
+int XLALWeaveOutputResultsMerge(
+  WeaveOutputResults *out,
+  WeaveOutputResults *shard
+  );
 int XLALWeaveOutputResultsCompletionLoop(
   WeaveOutputResults *out
   );
@@ -808,6 +808,35 @@ int XLALWeaveResultsToplistAdd(
 
 }
 
+///
+/// Merge the items of another toplist into a toplist
+///
+/// Items are moved from \c other, which is left empty, and are ranked as if they had been added to
+/// \c toplist directly; both toplists must have been created with the same ranking statistic.
+///
+int XLALWeaveResultsToplistMerge(
+  WeaveResultsToplist *toplist,
+  WeaveResultsToplist *other
+  )
+{
+  // Check input
+  XLAL_CHECK( toplist != NULL, XLAL_EFAULT );
+  XLAL_CHECK( other != NULL, XLAL_EFAULT );
+  XLAL_CHECK( toplist != other, XLAL_EINVAL );
+  XLAL_CHECK( strcmp( toplist->stat_name, other->stat_name ) == 0, XLAL_EINVAL );
+
+  // Move items from other heap, possibly displacing items from toplist heap
+  while ( XLALHeapSize( other->heap ) > 0 ) {
+    void *x = XLALHeapExtractRoot( other->heap );
+    XLAL_CHECK( x != NULL, XLAL_EFUNC );
+    XLAL_CHECK( XLALHeapAdd( toplist->heap, &x ) == XLAL_SUCCESS, XLAL_EFUNC );
+    toplist_item_destroy( x );
+  }
+
+  return XLAL_SUCCESS;
+
+}
+
 ///
 /// Compute all missing 'extra' (non-toplist-ranking) statistics for all toplist entries
 ///
@@ -48,6 +48,10 @@ struct tagWeaveSearchIterator {
   UINT4 repetition_count;
   /// Index of the current repetition
   UINT4 repetition_index;
+  /// Number of shards into which partitions/repetitions are divided
+  UINT4 shard_count;
+  /// Index of the shard of partitions/repetitions visited by this iterator
+  UINT4 shard_index;
   /// Progress count for iteration
   UINT8 prog_count;
   /// Progress index for iteration
@@ -102,6 +106,10 @@ WeaveSearchIterator *XLALWeaveMainLoopSearchIteratorCreate(
   itr->repetition_count = freq_partitions;
   itr->repetition_index = 0;
 
+  // By default, iterator visits all partitions/repetitions
+  itr->shard_count = 1;
+  itr->shard_index = 0;
+
   // Set progress count and index for iteration
   itr->prog_count = itr->repetition_count * XLALTotalLatticeTilingPoints( itr->semi_itr );
   XLAL_CHECK_NULL( itr->prog_count > 0, XLAL_EFUNC );
@@ -125,6 +133,44 @@ void XLALWeaveSearchIteratorDestroy(
   }
 }
 
+///
+/// Restrict iterator to a shard of its partitions/repetitions
+///
+/// Partitions/repetitions are numbered sequentially in the order visited by the iterator, and are
+/// assigned to shards in round-robin order. Each partition/repetition is visited by exactly one of
+/// the iterators sharded with the same \c shard_count, which may therefore be iterated over independently
+/// (e.g. by separate threads); the number of partitions/repetitions limits the useful number of shards.
+///
+int XLALWeaveSearchIteratorShard(
+  WeaveSearchIterator *itr,
+  const UINT4 shard_index,
+  const UINT4 shard_count
+  )
+{
+
+  // Check input
+  XLAL_CHECK( itr != NULL, XLAL_EFAULT );
+  XLAL_CHECK( itr->prog_index == 0, XLAL_EINVAL, "Iterator must be sharded before iteration begins" );
+  const UINT4 unit_count = itr->partition_count * itr->repetition_count;
+  XLAL_CHECK( 0 < shard_count && shard_count <= unit_count, XLAL_EINVAL, "Number of shards %u must be in range [1,%u]", shard_count, unit_count );
+  XLAL_CHECK( shard_index < shard_count, XLAL_EINVAL );
+
+  // Set shard count and index
+  itr->shard_count = shard_count;
+  itr->shard_index = shard_index;
+
+  // Start iteration at the first partition/repetition in this shard
+  itr->partition_index = shard_index % itr->partition_count;
+  itr->repetition_index = shard_index / itr->partition_count;
+
+  // Scale progress count by the fraction of partitions/repetitions in this shard
+  const UINT4 shard_unit_count = ( unit_count - shard_index + shard_count - 1 ) / shard_count;
+  itr->prog_count = GSL_MAX( 1, ( itr->prog_count * shard_unit_count ) / unit_count );
+
+  return XLAL_SUCCESS;
+
+}
+
 ///
 /// Save state of iterator to a FITS file
 ///
@@ -137,6 +183,7 @@ int XLALWeaveSearchIteratorSave(
   // Check input
   XLAL_CHECK( itr != NULL, XLAL_EFAULT );
   XLAL_CHECK( file != NULL, XLAL_EFAULT );
+  XLAL_CHECK( itr->shard_count == 1, XLAL_EINVAL, "Cannot save state of a sharded iterator" );
 
   // Write state of iterator over semicoherent parameter space
   XLAL_CHECK( XLALSaveLatticeTilingIterator( itr->semi_itr, file, "itrstate" ) == XLAL_SUCCESS, XLAL_EFUNC );
@@ -166,6 +213,7 @@ int XLALWeaveSearchIteratorRestore(
   // Check input
   XLAL_CHECK( itr != NULL, XLAL_EFAULT );
   XLAL_CHECK( file != NULL, XLAL_EFAULT );
+  XLAL_CHECK( itr->shard_count == 1, XLAL_EINVAL, "Cannot restore state of a sharded iterator" );
 
   // Read state of iterator over semicoherent parameter space
   XLAL_CHECK( XLALRestoreLatticeTilingIterator( itr->semi_itr, file, "itrstate" ) == XLAL_SUCCESS, XLAL_EFUNC );
@@ -218,18 +266,23 @@ int XLALWeaveSearchIteratorNext(
     XLAL_CHECK( itr_retn >= 0, XLAL_EFUNC );
     if ( itr_retn == 0 ) {
 
-      // Move to the next partition
-      ++itr->partition_index;
-      if ( itr->partition_index == itr->partition_count ) {
-        itr->partition_index = 0;
+      // Move to the next partition/repetition in this shard
+      for ( UINT4 s = 0; s < itr->shard_count; ++s ) {
+
+        // Move to the next partition
+        ++itr->partition_index;
+        if ( itr->partition_index == itr->partition_count ) {
+          itr->partition_index = 0;
+
+          // Move to the next repetition
+          ++itr->repetition_index;
+          if ( itr->repetition_index == itr->repetition_count ) {
 
-        // Move to the next repetition
-        ++itr->repetition_index;
-        if ( itr->repetition_index == itr->repetition_count ) {
+            // Iteration is complete
+            *iteration_complete = 1;
+            return XLAL_SUCCESS;
 
-          // Iteration is complete
-          *iteration_complete = 1;
-          return XLAL_SUCCESS;
+          }
 
         }
 
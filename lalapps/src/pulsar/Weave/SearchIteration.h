@@ -42,6 +42,11 @@ WeaveSearchIterator *XLALWeaveMainLoopSearchIteratorCreate(
 void XLALWeaveSearchIteratorDestroy(
   WeaveSearchIterator *itr
   );
+int XLALWeaveSearchIteratorShard(
+  WeaveSearchIterator *itr,
+  const UINT4 shard_index,
+  const UINT4 shard_count
+  );
 int XLALWeaveSearchIteratorSave(
   const WeaveSearchIterator *itr,
   FITSFile *file
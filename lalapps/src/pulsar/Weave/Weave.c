@@ -34,6 +34,122 @@
 #include <lal/UserInput.h>
 #include <lal/Random.h>
 
+///
+/// Search the next semicoherent frequency block in the main loop, and add its results to the output
+///
+/// Frequency blocks which contain no semicoherent frequencies are skipped. Sets \c search_complete if
+/// there are no further frequency blocks to search. All arguments apart from \c statistics_params are
+/// only accessed by the calling thread, so that independent shards of the main loop search parameter
+/// space may be searched concurrently.
+///
+static int main_loop_next_block(
+  BOOLEAN *search_complete,
+  WeaveSearchTiming *tim,
+  WeaveSearchIterator *main_loop_itr,
+  const size_t nsegments,
+  WeaveCache *const *coh_cache,
+  WeaveCacheQueries *queries,
+  const WeaveSimulationLevel simulation_level,
+  const size_t ndetectors,
+  const double dfreq,
+  const WeaveStatisticsParams *statistics_params,
+  WeaveSemiResults **semi_res,
+  WeaveOutputResults *out
+  )
+{
+
+  // Check input
+  XLAL_CHECK( search_complete != NULL, XLAL_EFAULT );
+  XLAL_CHECK( semi_res != NULL, XLAL_EFAULT );
+
+  while ( 1 ) {
+
+    // Switch timing section
+    XLAL_CHECK( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_OTHER, WEAVE_SEARCH_TIMING_ITER ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    // Get next semicoherent frequency block
+    // - Exit main loop if iteration is complete
+    // - Expire cache items if requested by iterator
+    BOOLEAN expire_cache = 0;
+    UINT8 semi_index = 0;
+    const gsl_vector *semi_rssky = NULL;
+    INT4 semi_left = 0;
+    INT4 semi_right = 0;
+    UINT4 freq_partition_index = 0;
+    XLAL_CHECK( XLALWeaveSearchIteratorNext( main_loop_itr, search_complete, &expire_cache, &semi_index, &semi_rssky, &semi_left, &semi_right, &freq_partition_index ) == XLAL_SUCCESS, XLAL_EFUNC );
+    if ( *search_complete ) {
+      XLAL_CHECK( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_ITER, WEAVE_SEARCH_TIMING_OTHER ) == XLAL_SUCCESS, XLAL_EFUNC );
+      return XLAL_SUCCESS;
+    } else if ( expire_cache ) {
+      for ( size_t i = 0; i < nsegments; ++i ) {
+        XLAL_CHECK( XLALWeaveCacheExpire( coh_cache[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
+      }
+    }
+
+    // Switch timing section
+    XLAL_CHECK( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_ITER, WEAVE_SEARCH_TIMING_QUERY ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    // Initialise cache queries
+    XLAL_CHECK( XLALWeaveCacheQueriesInit( queries, semi_index, semi_rssky, semi_left, semi_right, freq_partition_index ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    // Query for coherent results for each segment
+    for ( size_t i = 0; i < nsegments; ++i ) {
+      XLAL_CHECK( XLALWeaveCacheQuery( coh_cache[i], queries, i ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+
+    // Finalise cache queries
+    PulsarDopplerParams XLAL_INIT_DECL( semi_phys );
+    UINT4 semi_nfreqs = 0;
+    XLAL_CHECK( XLALWeaveCacheQueriesFinal( queries, &semi_phys, &semi_nfreqs ) == XLAL_SUCCESS, XLAL_EFUNC );
+    if ( semi_nfreqs == 0 ) {
+      XLAL_CHECK( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_QUERY, WEAVE_SEARCH_TIMING_OTHER ) == XLAL_SUCCESS, XLAL_EFUNC );
+      continue;
+    }
+
+    // Switch timing section
+    XLAL_CHECK( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_QUERY, WEAVE_SEARCH_TIMING_COH ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    // Retrieve coherent results from each segment
+    const WeaveCohResults *XLAL_INIT_DECL( coh_res, [nsegments] );
+    UINT8 XLAL_INIT_DECL( coh_index, [nsegments] );
+    UINT4 XLAL_INIT_DECL( coh_offset, [nsegments] );
+    for ( size_t i = 0; i < nsegments; ++i ) {
+      XLAL_CHECK( XLALWeaveCacheRetrieve( coh_cache[i], queries, i, &coh_res[i], &coh_index[i], &coh_offset[i], tim ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK( coh_res[i] != NULL, XLAL_EFUNC );
+    }
+
+    // Switch timing section
+    XLAL_CHECK( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_COH, WEAVE_SEARCH_TIMING_SEMISEG ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    // Initialise semicoherent results
+    XLAL_CHECK( XLALWeaveSemiResultsInit( semi_res, simulation_level, ndetectors, nsegments, semi_index, &semi_phys, dfreq, semi_nfreqs, statistics_params ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    // Add coherent results to semicoherent results
+    for ( size_t i = 0; i < nsegments; ++i ) {
+      XLAL_CHECK( XLALWeaveSemiResultsAdd( *semi_res, coh_res[i], coh_index[i], coh_offset[i], tim ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+
+    // Switch timing section
+    XLAL_CHECK( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_SEMISEG, WEAVE_SEARCH_TIMING_SEMI ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    // Compute all toplist-ranking semicoherent results
+    XLAL_CHECK( XLALWeaveSemiResultsComputeMain( *semi_res, tim ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    // Switch timing section
+    XLAL_CHECK( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_SEMI, WEAVE_SEARCH_TIMING_OUTPUT ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    // Add semicoherent results to output
+    XLAL_CHECK( XLALWeaveOutputResultsAdd( out, *semi_res, semi_nfreqs ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    // Switch timing section
+    XLAL_CHECK( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_OUTPUT, WEAVE_SEARCH_TIMING_OTHER ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    return XLAL_SUCCESS;
+
+  }
+
+}
+
 int main( int argc, char *argv[] )
 {
 
@@ -50,10 +166,10 @@ int main( int argc, char *argv[] )
     BOOLEAN validate_sft_files, interpolation, lattice_rand_offset, toplist_tmpl_idx, segment_info, simulate_search, time_search, cache_all_gc;
     CHAR *setup_file, *sft_files, *output_file, *ckpt_output_file;
     LALStringVector *sft_timestamps_files, *sft_noise_sqrtSX, *injections, *Fstat_assume_sqrtSX, *lrs_oLGX;
-    REAL8 sft_timebase, semi_max_mismatch, coh_max_mismatch, ckpt_output_period, ckpt_output_exit, lrs_Fstar0sc, nc_2Fth;
+    REAL8 sft_timebase, semi_max_mismatch, coh_max_mismatch, ckpt_output_period, ckpt_output_exit, lrs_Fstar0sc, nc_2Fth, cache_max_mem;
     REAL8Range alpha, delta, freq, f1dot, f2dot, f3dot, f4dot;
-    UINT4 sky_patch_count, sky_patch_index, freq_partitions, f1dot_partitions, Fstat_run_med_window, Fstat_Dterms, toplist_limit, rand_seed, cache_max_size;
-    int lattice, Fstat_method, Fstat_SSB_precision, toplists, extra_statistics, recalc_statistics;
+    UINT4 sky_patch_count, sky_patch_index, freq_partitions, f1dot_partitions, Fstat_run_med_window, Fstat_Dterms, toplist_limit, rand_seed, cache_max_size, threads;
+    int lattice, Fstat_method, Fstat_SSB_precision, toplists, extra_statistics, recalc_statistics, cache_strategy;
   } uvar_struct = {
     .Fstat_Dterms = Fstat_opt_args.Dterms,
     .Fstat_SSB_precision = Fstat_opt_args.SSBprec,
@@ -70,6 +186,8 @@ int main( int argc, char *argv[] )
     .extra_statistics = WEAVE_STATISTIC_NONE,
     .recalc_statistics = WEAVE_STATISTIC_NONE,
     .nc_2Fth = 5.2,
+    .cache_strategy = WEAVE_CACHE_STRATEGY_RELEVANCE,
+    .threads = 1,
   };
   struct uvar_type *const uvar = &uvar_struct;
 
@@ -323,12 +441,34 @@ int main( int argc, char *argv[] )
     "If zero, the caches will grow in size to store all items that are still required. "
     "Has no effect when performing a fully-coherent single-segment search, or a non-interpolating search. "
     );
+  XLALRegisterUvarMember(
+    cache_max_mem, REAL8, 0, DEVELOPER,
+    "Limit the total memory (in MB) used by the internal caches, used to store intermediate results, to this amount. "
+    "The memory is divided equally between the caches for each segment (and for each thread). "
+    "If zero, the memory used by the caches is not limited, except through " UVAR_STR( cache_max_size ) ". "
+    "Has no effect when performing a fully-coherent single-segment search, or a non-interpolating search. "
+    );
+  XLALRegisterUvarAuxDataMember(
+    cache_strategy, UserEnum, &WeaveCacheStrategyChoices, 0, DEVELOPER,
+    "Strategy used to decide which items to remove from the internal caches once they are full: "
+    "'relevance' removes items which are least likely to be required again first; "
+    "'fifo' removes items in the order in which they were added, and requires " UVAR_STR( cache_max_size ) " or " UVAR_STR( cache_max_mem ) ". "
+    "Has no effect when performing a fully-coherent single-segment search, or a non-interpolating search. "
+    );
   XLALRegisterUvarMember(
     cache_all_gc, BOOLEAN, 0, DEVELOPER,
     "If TRUE, try to instead remove as many items as possible, provided that they are no longer required. "
     "If FALSE, whenever an item is added to the internal caches, at most one item that may no longer be required is removed. "
     "Has no effect when performing a fully-coherent single-segment search, or a non-interpolating search. "
     );
+  XLALRegisterUvarMember(
+    threads, UINT4, 0, OPTIONAL,
+    "Perform the main search loop with this number of threads, each of which searches a share of the partitions given by " UVAR_STR2AND( freq_partitions, f1dot_partitions ) ". "
+    "The same number of threads is used to iterate over the lattice tilings when setting up the search. "
+    "Each thread loads its own copy of the input data and keeps its own internal caches, so memory usage grows in proportion to the number of threads. "
+    "Must be at most the product of " UVAR_STR2AND( freq_partitions, f1dot_partitions ) ", and cannot be greater than 1 when " UVAR_STR( ckpt_output_file ) " or " UVAR_STR( time_search ) " are given. "
+    "Requires LALApps to be configured with OpenMP support. "
+    );
 
   // Parse user input
   XLAL_CHECK_MAIN( xlalErrno == 0, XLAL_EFUNC, "A call to XLALRegisterUvarMember() failed" );
@@ -428,6 +568,31 @@ int main( int argc, char *argv[] )
   XLALUserVarCheck( &should_exit,
                     !UVAR_ALLSET2( time_search, ckpt_output_file ),
                     UVAR_STR2AND( time_search, ckpt_output_file ) " are mutually exclusive" );
+  XLALUserVarCheck( &should_exit,
+                    uvar->cache_max_mem >= 0,
+                    UVAR_STR( cache_max_mem ) " must be non-negative" );
+  XLALUserVarCheck( &should_exit,
+                    uvar->cache_strategy == WEAVE_CACHE_STRATEGY_RELEVANCE || uvar->cache_max_size > 0 || uvar->cache_max_mem > 0,
+                    UVAR_STR( cache_strategy ) " other than 'relevance' requires " UVAR_STR( cache_max_size ) " or " UVAR_STR( cache_max_mem ) );
+  XLALUserVarCheck( &should_exit,
+                    uvar->threads > 0,
+                    UVAR_STR( threads ) " must be strictly positive" );
+#ifndef _OPENMP
+  XLALUserVarCheck( &should_exit,
+                    uvar->threads == 1,
+                    UVAR_STR( threads ) " requires LALApps to be configured with OpenMP support" );
+#endif
+  XLALUserVarCheck( &should_exit,
+                    uvar->threads <= uvar->freq_partitions * uvar->f1dot_partitions,
+                    UVAR_STR( threads ) " must be at most the product of " UVAR_STR2AND( freq_partitions, f1dot_partitions ) );
+  // - Checkpoints record a single position of the main loop search iterator, whereas each thread advances its own shard
+  // - Timing information is collected per thread, and per-stage timings cannot be summed meaningfully over concurrent threads
+  XLALUserVarCheck( &should_exit,
+                    uvar->threads == 1 || !UVAR_SET( ckpt_output_file ),
+                    UVAR_STR( ckpt_output_file ) " is not supported when " UVAR_STR( threads ) " is greater than 1" );
+  XLALUserVarCheck( &should_exit,
+                    uvar->threads == 1 || !uvar->time_search,
+                    UVAR_STR( time_search ) " is not supported when " UVAR_STR( threads ) " is greater than 1" );
 
   // Exit if required
   if ( should_exit ) {
@@ -636,6 +801,9 @@ int main( int argc, char *argv[] )
   // Set semicoherent parameter-space lattice and metric
   XLAL_CHECK_MAIN( XLALSetTilingLatticeAndMetric( tiling[isemi], uvar->lattice, rssky_metric[isemi], semi_max_mismatch ) == XLAL_SUCCESS, XLAL_EFUNC );
 
+  // Iterate over semicoherent tiling with the same number of threads as the main search loop
+  XLAL_CHECK_MAIN( XLALSetLatticeTilingCallbackThreads( tiling[isemi], uvar->threads ) == XLAL_SUCCESS, XLAL_EFUNC );
+
   // Print number of (tiled) parameter-space dimensions
   LogPrintf( LOG_NORMAL, "Number of (tiled) parameter-space dimensions = %zu (%zu)\n", ndim, XLALTiledLatticeTilingDimensions( tiling[isemi] ) );
 
@@ -685,6 +853,7 @@ int main( int argc, char *argv[] )
 
     // Set coherent parameter-space lattice and metric
     XLAL_CHECK_MAIN( XLALSetTilingLatticeAndMetric( tiling[i], uvar->lattice, rssky_metric[i], coh_max_mismatch ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALSetLatticeTilingCallbackThreads( tiling[i], uvar->threads ) == XLAL_SUCCESS, XLAL_EFUNC );
 
     // Register callback to compute range of physical coordinates covered by coherent parameter space
     XLAL_CHECK_MAIN( XLALRegisterSuperskyLatticePhysicalRangeCallback( tiling[i], rssky_transf[i], &min_phys[i], &max_phys[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
@@ -816,16 +985,43 @@ int main( int argc, char *argv[] )
   }
   statistics_params->ref_time = setup.ref_time;
 
+  // Number of threads with which to perform the main search loop
+  // - Each thread searches a shard of the main loop search parameter space, using its own copy of the
+  //   input data required for computing coherent results; the first thread uses 'statistics_params->coh_input'
+  // - The input data cannot be shared between threads: XLALComputeFstat() buffers per-template state (SSB times,
+  //   antenna patterns, barycentred timeseries, FFT buffers) in its 'FstatInput', and so is not re-entrant. For
+  //   resampling this per-template state is at least twice the size of the read-only detector-frame timeseries,
+  //   so sharing only the latter would save less than a third of the memory of each additional thread
+  const UINT4 nthreads = uvar->threads;
+  WeaveCohInput *XLAL_INIT_DECL( coh_input, [nthreads * nsegments] );
+  for ( size_t i = 0; i < nsegments; ++i ) {
+    coh_input[i] = statistics_params->coh_input[i];
+  }
+  for ( size_t t = 1; t < nthreads; ++t ) {
+    // Do not reuse the F-statistic workspaces of another thread
+    Fstat_opt_args.prevInput = NULL;
+    for ( size_t i = 0; i < nsegments; ++i ) {
+      coh_input[t * nsegments + i] = XLALWeaveCohInputCreate( setup.detectors, simulation_level, sft_catalog, i, &setup.segments->segs[i], min_phys[i], max_phys[i], dfreq, setup.ephemerides, sft_noise_sqrtSX, Fstat_assume_sqrtSX, &Fstat_opt_args, statistics_params, 0 );
+      XLAL_CHECK_MAIN( coh_input[t * nsegments + i] != NULL, XLAL_EFUNC );
+    }
+  }
+
   LogPrintf( LOG_NORMAL, "Finished loading input data for coherent results\n" );
 
   // Create caches to store intermediate results from coherent parameter-space tilings
   // - If no interpolation, caching is not required so reduce maximum cache size to 1
-  WeaveCache *XLAL_INIT_DECL( coh_cache, [nsegments] );
-  for ( size_t i = 0; i < nsegments; ++i ) {
-    const size_t cache_max_size = interpolation ? uvar->cache_max_size : 1;
-    const BOOLEAN cache_all_gc = interpolation ? uvar->cache_all_gc : 0;
-    coh_cache[i] = XLALWeaveCacheCreate( tiling[i], interpolation, rssky_transf[i], rssky_transf[isemi], statistics_params->coh_input[i], cache_max_size, cache_all_gc );
-    XLAL_CHECK_MAIN( coh_cache[i] != NULL, XLAL_EFUNC );
+  // - Each thread keeps its own caches, so that they need not be shared between threads
+  // - Maximum cache memory is divided equally between all caches
+  WeaveCache *XLAL_INIT_DECL( coh_cache, [nthreads * nsegments] );
+  for ( size_t t = 0; t < nthreads; ++t ) {
+    for ( size_t i = 0; i < nsegments; ++i ) {
+      const size_t cache_max_size = interpolation ? uvar->cache_max_size : 1;
+      const UINT8 cache_max_bytes = interpolation ? ( UINT8 ) ceil( uvar->cache_max_mem * 1024.0 * 1024.0 / ( nthreads * nsegments ) ) : 0;
+      const WeaveCacheStrategy cache_strategy = interpolation ? uvar->cache_strategy : WEAVE_CACHE_STRATEGY_RELEVANCE;
+      const BOOLEAN cache_all_gc = interpolation ? uvar->cache_all_gc : 0;
+      coh_cache[t * nsegments + i] = XLALWeaveCacheCreate( tiling[i], interpolation, rssky_transf[i], rssky_transf[isemi], coh_input[t * nsegments + i], cache_max_size, cache_max_bytes, cache_strategy, cache_all_gc );
+      XLAL_CHECK_MAIN( coh_cache[t * nsegments + i] != NULL, XLAL_EFUNC );
+    }
   }
 
   ////////// Perform search //////////
@@ -838,8 +1034,8 @@ int main( int argc, char *argv[] )
   WeaveCacheQueries *queries = XLALWeaveCacheQueriesCreate( tiling[isemi], rssky_transf[isemi], dfreq, nsegments, uvar->freq_partitions );
   XLAL_CHECK_MAIN( queries != NULL, XLAL_EFUNC );
 
-  // Pointer to final semicoherent results
-  WeaveSemiResults *semi_res = NULL;
+  // Pointers to final semicoherent results for each thread
+  WeaveSemiResults *XLAL_INIT_DECL( semi_res, [nthreads] );
 
   // Create output results structure
   WeaveOutputResults *out = XLALWeaveOutputResultsCreate( &setup.ref_time, ninputspins, statistics_params, uvar->toplist_limit, uvar->toplist_tmpl_idx );
@@ -884,8 +1080,39 @@ int main( int argc, char *argv[] )
 
   }
 
+  // Create shards of the main loop search parameter space to be searched by each thread
+  // - Each thread has its own iterator, cache queries, output results, and search timing structure;
+  //   the first thread uses those created above, while output results from the other threads
+  //   are merged into 'out' once the main loop is complete
+  WeaveSearchIterator *XLAL_INIT_DECL( shard_itr, [nthreads] );
+  WeaveCacheQueries *XLAL_INIT_DECL( shard_queries, [nthreads] );
+  WeaveOutputResults *XLAL_INIT_DECL( shard_out, [nthreads] );
+  WeaveSearchTiming *XLAL_INIT_DECL( shard_tim, [nthreads] );
+  shard_itr[0] = main_loop_itr;
+  shard_queries[0] = queries;
+  shard_out[0] = out;
+  shard_tim[0] = tim;
+  for ( size_t t = 1; t < nthreads; ++t ) {
+    shard_itr[t] = XLALWeaveMainLoopSearchIteratorCreate( tiling[isemi], uvar->freq_partitions, uvar->f1dot_partitions );
+    XLAL_CHECK_MAIN( shard_itr[t] != NULL, XLAL_EFUNC );
+    shard_queries[t] = XLALWeaveCacheQueriesCreate( tiling[isemi], rssky_transf[isemi], dfreq, nsegments, uvar->freq_partitions );
+    XLAL_CHECK_MAIN( shard_queries[t] != NULL, XLAL_EFUNC );
+    shard_out[t] = XLALWeaveOutputResultsCreateShard( out );
+    XLAL_CHECK_MAIN( shard_out[t] != NULL, XLAL_EFUNC );
+    shard_tim[t] = XLALWeaveSearchTimingCreate( 0, statistics_params );
+    XLAL_CHECK_MAIN( shard_tim[t] != NULL, XLAL_EFUNC );
+  }
+  if ( nthreads > 1 ) {
+    for ( size_t t = 0; t < nthreads; ++t ) {
+      XLAL_CHECK_MAIN( XLALWeaveSearchIteratorShard( shard_itr[t], t, nthreads ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+    LogPrintf( LOG_NORMAL, "Performing main loop with %u threads\n", nthreads );
+  }
+
   // Start timing main search loop
-  XLAL_CHECK_MAIN( XLALWeaveSearchTimingStart( tim ) == XLAL_SUCCESS, XLAL_EFUNC );
+  for ( size_t t = 0; t < nthreads; ++t ) {
+    XLAL_CHECK_MAIN( XLALWeaveSearchTimingStart( shard_tim[t] ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
 
   // Elapsed wall time at which search was last checkpointed
   double wall_ckpt_elapsed = 0;
@@ -903,88 +1130,55 @@ int main( int argc, char *argv[] )
 
   // Begin main loop
   BOOLEAN search_complete = 0;
-  while ( !search_complete ) {
-
-    // Switch timing section
-    XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_OTHER, WEAVE_SEARCH_TIMING_ITER ) == XLAL_SUCCESS, XLAL_EFUNC );
+  if ( nthreads > 1 ) {
 
-    // Get next semicoherent frequency block
-    // - Exit main loop if iteration is complete
-    // - Expire cache items if requested by iterator
-    BOOLEAN expire_cache = 0;
-    UINT8 semi_index = 0;
-    const gsl_vector *semi_rssky = NULL;
-    INT4 semi_left = 0;
-    INT4 semi_right = 0;
-    UINT4 freq_partition_index = 0;
-    XLAL_CHECK( XLALWeaveSearchIteratorNext( main_loop_itr, &search_complete, &expire_cache, &semi_index, &semi_rssky, &semi_left, &semi_right, &freq_partition_index ) == XLAL_SUCCESS, XLAL_EFUNC );
-    if ( search_complete ) {
-      XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_ITER, WEAVE_SEARCH_TIMING_OTHER ) == XLAL_SUCCESS, XLAL_EFUNC );
-      break;
-    } else if ( expire_cache ) {
-      for ( size_t i = 0; i < nsegments; ++i ) {
-        XLAL_CHECK_MAIN( XLALWeaveCacheExpire( coh_cache[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
-      }
-    }
+    // Search each shard of the main loop search parameter space in a separate thread
+    int errnum = 0;
+    double XLAL_INIT_DECL( wall_shard, [nthreads] );
+#pragma omp parallel for schedule(static, 1) num_threads(nthreads)
+    for ( UINT4 t = 0; t < nthreads; ++t ) {
+      BOOLEAN shard_complete = 0;
+      while ( !shard_complete ) {
+
+        // Search next semicoherent frequency block in this shard
+        if ( main_loop_next_block( &shard_complete, shard_tim[t], shard_itr[t], nsegments, &coh_cache[t * nsegments], shard_queries[t], simulation_level, ndetectors, dfreq, statistics_params, &semi_res[t], shard_out[t] ) != XLAL_SUCCESS ) {
+#pragma omp critical (Weave_main_loop)
+          errnum = XLAL_EFUNC;
+          break;
+        }
 
-    // Switch timing section
-    XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_ITER, WEAVE_SEARCH_TIMING_QUERY ) == XLAL_SUCCESS, XLAL_EFUNC );
+        // Print progress of first shard, as representative of the progress of the whole search
+        double wall_elapsed = 0, cpu_elapsed = 0;
+        if ( t == 0 && !shard_complete && XLALWeaveSearchTimingElapsed( tim, &wall_elapsed, &cpu_elapsed ) == XLAL_SUCCESS && wall_elapsed - wall_prog_elapsed >= wall_prog_period ) {
+          LogPrintf( LOG_NORMAL, "%s at %.3g%% complete", simulation_level & WEAVE_SIMULATE ? "Simulation" : "Search", XLALWeaveSearchIteratorProgress( main_loop_itr ) );
+          LogPrintfVerbatim( LOG_NORMAL, ", elapsed %.1f sec, CPU %.1f%%, peak memory %.1fMB\n", wall_elapsed, 100.0 * cpu_elapsed / wall_elapsed, XLALGetPeakHeapUsageMB() );
+          wall_prog_elapsed = wall_elapsed;
+          wall_prog_period = GSL_MIN( 1200, wall_prog_period * 1.5 );
+        }
 
-    // Initialise cache queries
-    XLAL_CHECK_MAIN( XLALWeaveCacheQueriesInit( queries, semi_index, semi_rssky, semi_left, semi_right, freq_partition_index ) == XLAL_SUCCESS, XLAL_EFUNC );
+      }
 
-    // Query for coherent results for each segment
-    for ( size_t i = 0; i < nsegments; ++i ) {
-      XLAL_CHECK_MAIN( XLALWeaveCacheQuery( coh_cache[i], queries, i ) == XLAL_SUCCESS, XLAL_EFUNC );
-    }
+      // Record elapsed wall time at which this shard was completed
+      double cpu_shard = 0;
+      XLALWeaveSearchTimingElapsed( shard_tim[t], &wall_shard[t], &cpu_shard );
 
-    // Finalise cache queries
-    PulsarDopplerParams XLAL_INIT_DECL( semi_phys );
-    UINT4 semi_nfreqs = 0;
-    XLAL_CHECK_MAIN( XLALWeaveCacheQueriesFinal( queries, &semi_phys, &semi_nfreqs ) == XLAL_SUCCESS, XLAL_EFUNC );
-    if ( semi_nfreqs == 0 ) {
-      XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_QUERY, WEAVE_SEARCH_TIMING_OTHER ) == XLAL_SUCCESS, XLAL_EFUNC );
-      continue;
     }
-
-    // Switch timing section
-    XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_QUERY, WEAVE_SEARCH_TIMING_COH ) == XLAL_SUCCESS, XLAL_EFUNC );
-
-    // Retrieve coherent results from each segment
-    const WeaveCohResults *XLAL_INIT_DECL( coh_res, [nsegments] );
-    UINT8 XLAL_INIT_DECL( coh_index, [nsegments] );
-    UINT4 XLAL_INIT_DECL( coh_offset, [nsegments] );
-    for ( size_t i = 0; i < nsegments; ++i ) {
-      XLAL_CHECK_MAIN( XLALWeaveCacheRetrieve( coh_cache[i], queries, i, &coh_res[i], &coh_index[i], &coh_offset[i], tim ) == XLAL_SUCCESS, XLAL_EFUNC );
-      XLAL_CHECK_MAIN( coh_res[i] != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( errnum == 0, errnum );
+    for ( size_t t = 0; t < nthreads; ++t ) {
+      LogPrintf( LOG_NORMAL, "Thread %zu completed its shard of the main loop, elapsed %.1f sec\n", t, wall_shard[t] );
     }
+    search_complete = 1;
 
-    // Switch timing section
-    XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_COH, WEAVE_SEARCH_TIMING_SEMISEG ) == XLAL_SUCCESS, XLAL_EFUNC );
-
-    // Initialise semicoherent results
-    XLAL_CHECK_MAIN( XLALWeaveSemiResultsInit( &semi_res, simulation_level, ndetectors, nsegments, semi_index, &semi_phys, dfreq, semi_nfreqs, statistics_params ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+  while ( !search_complete ) {
 
-    // Add coherent results to semicoherent results
-    for ( size_t i = 0; i < nsegments; ++i ) {
-      XLAL_CHECK_MAIN( XLALWeaveSemiResultsAdd( semi_res, coh_res[i], coh_index[i], coh_offset[i], tim ) == XLAL_SUCCESS, XLAL_EFUNC );
+    // Search next semicoherent frequency block
+    // - Exit main loop if search is complete
+    XLAL_CHECK_MAIN( main_loop_next_block( &search_complete, tim, main_loop_itr, nsegments, coh_cache, queries, simulation_level, ndetectors, dfreq, statistics_params, &semi_res[0], out ) == XLAL_SUCCESS, XLAL_EFUNC );
+    if ( search_complete ) {
+      break;
     }
 
-    // Switch timing section
-    XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_SEMISEG, WEAVE_SEARCH_TIMING_SEMI ) == XLAL_SUCCESS, XLAL_EFUNC );
-
-    // Compute all toplist-ranking semicoherent results
-    XLAL_CHECK_MAIN( XLALWeaveSemiResultsComputeMain( semi_res, tim ) == XLAL_SUCCESS, XLAL_EFUNC );
-
-    // Switch timing section
-    XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_SEMI, WEAVE_SEARCH_TIMING_OUTPUT ) == XLAL_SUCCESS, XLAL_EFUNC );
-
-    // Add semicoherent results to output
-    XLAL_CHECK_MAIN( XLALWeaveOutputResultsAdd( out, semi_res, semi_nfreqs ) == XLAL_SUCCESS, XLAL_EFUNC );
-
-    // Switch timing section
-    XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_OUTPUT, WEAVE_SEARCH_TIMING_OTHER ) == XLAL_SUCCESS, XLAL_EFUNC );
-
     // Main iterator percentage complete
     const REAL4 prog_per_cent = XLALWeaveSearchIteratorProgress( main_loop_itr );
 
@@ -1079,10 +1273,16 @@ int main( int argc, char *argv[] )
   }   // End of main loop
 
   // Clear all cache items from memory
-  for ( size_t i = 0; i < nsegments; ++i ) {
+  for ( size_t i = 0; i < nthreads * nsegments; ++i ) {
     XLAL_CHECK_MAIN( XLALWeaveCacheClear( coh_cache[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
   }
 
+  // Merge output results and cache query counts from shards searched by other threads
+  for ( size_t t = 1; t < nthreads; ++t ) {
+    XLAL_CHECK_MAIN( XLALWeaveOutputResultsMerge( out, shard_out[t] ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALWeaveCacheQueriesAddCounts( queries, shard_queries[t] ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
   // Print progress
   double wall_main = 0, cpu_main = 0;
   XLAL_CHECK_MAIN( XLALWeaveSearchTimingElapsed( tim, &wall_main, &cpu_main ) == XLAL_SUCCESS, XLAL_EFUNC );
@@ -1183,7 +1383,7 @@ int main( int argc, char *argv[] )
     XLAL_CHECK_MAIN( XLALWeaveCohInputWriteInfo( file, nsegments, statistics_params->coh_input ) == XLAL_SUCCESS, XLAL_EFUNC );
 
     // Write various information from caches
-    XLAL_CHECK_MAIN( XLALWeaveCacheWriteInfo( file, nsegments, coh_cache ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALWeaveCacheWriteInfo( file, nthreads * nsegments, coh_cache ) == XLAL_SUCCESS, XLAL_EFUNC );
 
     // Write search results, unless search is being simulated
     if ( simulation_level == 0 ) {
@@ -1195,6 +1395,11 @@ int main( int argc, char *argv[] )
       XLAL_CHECK_MAIN( XLALWeaveCohInputWriteSegInfo( file, nsegments, statistics_params->coh_input ) == XLAL_SUCCESS, XLAL_EFUNC );
     }
 
+    // Write per-segment statistics on the use of caches, if their size or memory is limited
+    if ( uvar->cache_max_size > 0 || uvar->cache_max_mem > 0 ) {
+      XLAL_CHECK_MAIN( XLALWeaveCacheWriteSegInfo( file, nsegments, nthreads * nsegments, coh_cache ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+
     // Close output file
     XLALFITSFileClose( file );
     LogPrintf( LOG_NORMAL, "Closed output file '%s'\n", uvar->output_file );
@@ -1204,22 +1409,36 @@ int main( int argc, char *argv[] )
   ////////// Cleanup memory and exit //////////
 
   // Cleanup memory from search timing
-  XLALWeaveSearchTimingDestroy( tim );
+  for ( size_t t = 0; t < nthreads; ++t ) {
+    XLALWeaveSearchTimingDestroy( shard_tim[t] );
+  }
 
   // Cleanup memory from output results
+  for ( size_t t = 1; t < nthreads; ++t ) {
+    XLALWeaveOutputResultsDestroy( shard_out[t] );
+  }
   XLALWeaveOutputResultsDestroy( out );
 
   // Cleanup memory from semicoherent results
-  XLALWeaveSemiResultsDestroy( semi_res );
+  for ( size_t t = 0; t < nthreads; ++t ) {
+    XLALWeaveSemiResultsDestroy( semi_res[t] );
+  }
 
   // Cleanup memory from parameter-space iteration
-  XLALWeaveSearchIteratorDestroy( main_loop_itr );
+  for ( size_t t = 0; t < nthreads; ++t ) {
+    XLALWeaveSearchIteratorDestroy( shard_itr[t] );
+  }
 
   // Cleanup memory from computing 'stage 0' coherent results
-  XLALWeaveCacheQueriesDestroy( queries );
-  for ( size_t i = 0; i < nsegments; ++i ) {
+  for ( size_t t = 0; t < nthreads; ++t ) {
+    XLALWeaveCacheQueriesDestroy( shard_queries[t] );
+  }
+  for ( size_t i = 0; i < nthreads * nsegments; ++i ) {
     XLALWeaveCacheDestroy( coh_cache[i] );
   }
+  for ( size_t i = nsegments; i < nthreads * nsegments; ++i ) {
+    XLALWeaveCohInputDestroy( coh_input[i] );
+  }
 
   // Cleanup memory from loading input data
   XLALDestroySFTCatalog( sft_catalog );
@@ -57,6 +57,7 @@
 extern "C" {
 #endif
 
+typedef enum tagWeaveCacheStrategy WeaveCacheStrategy;
 typedef enum tagWeaveSearchTimingSection WeaveSearchTimingSection;
 typedef enum tagWeaveSimulationLevel WeaveSimulationLevel;
 typedef enum tagWeaveStatisticType WeaveStatisticType;
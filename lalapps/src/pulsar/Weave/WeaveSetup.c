@@ -44,13 +44,14 @@ int main( int argc, char *argv[] )
     LIGOTimeGPS ref_time;
     LIGOTimeGPSRange first_segment;
     REAL8 segment_gap;
-    UINT4 segment_count, spindowns;
+    UINT4 segment_count, spindowns, threads;
   } uvar_struct = {
     .detector_motion = XLALStringDuplicate( "spin+orbit" ),
     .ephem_earth = XLALStringDuplicate( "earth00-40-DE405.dat.gz" ),
     .ephem_sun = XLALStringDuplicate( "sun00-40-DE405.dat.gz" ),
     .segment_count = 1,
     .spindowns = 1,
+    .threads = 1,
   };
   struct uvar_type *const uvar = &uvar_struct;
 
@@ -121,6 +122,11 @@ int main( int argc, char *argv[] )
     "Must be at least 1. "
     "This option limits the size of the spindown parameter space given to lalapps_Weave. "
     );
+  XLALRegisterUvarMember(
+    threads, UINT4, 0, OPTIONAL,
+    "Compute the parameter-space metrics of the segments with this number of threads. "
+    "Requires LALApps to be configured with OpenMP support. "
+    );
 
   // Parse user input
   XLAL_CHECK_MAIN( xlalErrno == 0, XLAL_EFUNC, "A call to XLALRegisterUvarMember() failed" );
@@ -153,6 +159,14 @@ int main( int argc, char *argv[] )
   XLALUserVarCheck( &should_exit,
                     uvar->spindowns > 0,
                     UVAR_STR( spindowns ) " must be strictly positive" );
+  XLALUserVarCheck( &should_exit,
+                    uvar->threads > 0,
+                    UVAR_STR( threads ) " must be strictly positive" );
+#ifndef _OPENMP
+  XLALUserVarCheck( &should_exit,
+                    uvar->threads == 1,
+                    UVAR_STR( threads ) " requires LALApps to be configured with OpenMP support" );
+#endif
 
   // Exit if required
   if ( should_exit ) {
@@ -246,7 +260,7 @@ int main( int argc, char *argv[] )
   //   metrics can later be rescaled by search code
   LogPrintf( LOG_NORMAL, "Computing reduced supersky metrics ...\n" );
   const double fiducial_freq = 100.0;
-  setup.metrics = XLALComputeSuperskyMetrics( SUPERSKY_METRIC_TYPE, uvar->spindowns, &setup.ref_time, setup.segments, fiducial_freq, &detector_info, NULL, detector_motion, setup.ephemerides );
+  setup.metrics = XLALComputeSuperskyMetrics( SUPERSKY_METRIC_TYPE, uvar->spindowns, &setup.ref_time, setup.segments, fiducial_freq, &detector_info, NULL, detector_motion, setup.ephemerides, uvar->threads );
   XLAL_CHECK_MAIN( setup.metrics != NULL, XLAL_EFUNC );
   LogPrintf( LOG_NORMAL, "Finished computing reduced supersky metrics\n" );
 
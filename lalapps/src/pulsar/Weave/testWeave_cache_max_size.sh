@@ -1,4 +1,4 @@
-# Perform an interpolating search without/with a maximum cache size, and check for consistent results
+# Perform an interpolating search without/with a maximum cache size or memory, and check for consistent results
 
 export LAL_FSTAT_FFT_PLAN_MODE=ESTIMATE
 
@@ -12,6 +12,8 @@ for setup in short long; do
             weave_sft_options="--rand-seed=3456 --sft-timebase=1800 --sft-noise-sqrtSX=1,1 --sft-timestamps-files=timestamps-1.txt,timestamps-2.txt"
             weave_search_options="--alpha=0.9/1.4 --delta=-1.2/2.3 --freq=50.5/0.01 --f1dot=-1.5e-9,0 --semi-max-mismatch=5 --coh-max-mismatch=0.3"
             weave_cache_options="--cache-max-size=2"
+            weave_cache_max_mem=0.05
+            weave_cache_mem_options="--cache-max-mem=${weave_cache_max_mem} --cache-strategy=fifo"
             weave_recomp_threshold=0.0
             ;;
 
@@ -21,6 +23,8 @@ for setup in short long; do
             weave_sft_options=
             weave_search_options="--simulate-search --alpha=2.3/0.9 --delta=-1.2/2.3 --freq=50.5/0.01 --f1dot=-5e-11,0 --semi-max-mismatch=6 --coh-max-mismatch=0.3"
             weave_cache_options="--cache-max-size=25 --cache-all-gc"
+            weave_cache_max_mem=0.001
+            weave_cache_mem_options="--cache-max-mem=${weave_cache_max_mem}"
             weave_recomp_threshold=0.0
             ;;
 
@@ -55,6 +59,14 @@ for setup in short long; do
     set +x
     echo
 
+    echo "=== Setup '${setup}': Check that without a maximum cache no cache information table is written ==="
+    set -x
+    if lalapps_fits_overview "WeaveOutNoMax.fits[cache_info]"; then
+        exit 1
+    fi
+    set +x
+    echo
+
     echo "=== Setup '${setup}': Check for non-singular semicoherent dimensions ==="
     set -x
     semi_ntmpl_prev=1
@@ -66,50 +78,82 @@ for setup in short long; do
     set +x
     echo
 
-    echo "=== Setup '${setup}': ${verb} interpolating search with a maximum cache size ==="
-    set -x
-    lalapps_Weave ${weave_cache_options} --output-file=WeaveOutMax.fits \
-        --toplists=all --toplist-limit=2321 --segment-info --setup-file=WeaveSetup.fits \
-        ${weave_sft_options} ${weave_search_options}
-    lalapps_fits_overview WeaveOutMax.fits
-    set +x
-    echo
-
-    echo "=== Setup '${setup}': Check that number of coherent templates are equal ==="
-    set -x
-    coh_ntmpl_no_max=`lalapps_fits_header_getval "WeaveOutNoMax.fits[0]" 'NCOHTPL' | tr '\n\r' '  ' | awk 'NF == 1 {printf "%d", $1}'`
-    coh_ntmpl_max=`lalapps_fits_header_getval "WeaveOutMax.fits[0]" 'NCOHTPL' | tr '\n\r' '  ' | awk 'NF == 1 {printf "%d", $1}'`
-    expr ${coh_ntmpl_no_max} '=' ${coh_ntmpl_max}
-    set +x
-    echo
-
     echo "=== Setup '${setup}': Check that without a maximum cache number of recomputed results is below tolerance ==="
     set -x
+    coh_ntmpl_no_max=`lalapps_fits_header_getval "WeaveOutNoMax.fits[0]" 'NCOHTPL' | tr '\n\r' '  ' | awk 'NF == 1 {printf "%d", $1}'`
     coh_nres_no_max=`lalapps_fits_header_getval "WeaveOutNoMax.fits[0]" 'NCOHRES' | tr '\n\r' '  ' | awk 'NF == 1 {printf "%d", $1}'`
     awk "BEGIN { print recomp = ( ${coh_nres_no_max} - ${coh_ntmpl_no_max} ) / ${coh_ntmpl_no_max}; exit ( recomp <= ${weave_recomp_threshold} ? 0 : 1 ) }"
     set +x
     echo
 
-    echo "=== Setup '${setup}': Check that with a maximum cache number of recomputed results is above tolerance ==="
-    set -x
-    coh_nres_max=`lalapps_fits_header_getval "WeaveOutMax.fits[0]" 'NCOHRES' | tr '\n\r' '  ' | awk 'NF == 1 {printf "%d", $1}'`
-    awk "BEGIN { print recomp = ( ${coh_nres_max} - ${coh_ntmpl_max} ) / ${coh_ntmpl_max}; exit ( recomp > ${weave_recomp_threshold} ? 0 : 1 ) }"
-    set +x
-    echo
-
-    case ${setup} in
-
-        short)
-            echo "=== Setup '${setup}': Compare F-statistics from lalapps_Weave without/with a maximum cache size ==="
-            set -x
-            env LAL_DEBUG_LEVEL="${LAL_DEBUG_LEVEL},info" lalapps_WeaveCompare --setup-file=WeaveSetup.fits --result-file-1=WeaveOutNoMax.fits --result-file-2=WeaveOutMax.fits
-            set +x
-            echo
-            ;;
+    for max in size mem; do
+
+        case ${max} in
+            size)
+                weave_max_options="${weave_cache_options}"
+                ;;
+            mem)
+                weave_max_options="${weave_cache_mem_options}"
+                ;;
+        esac
+
+        echo "=== Setup '${setup}': ${verb} interpolating search with a maximum cache ${max} ==="
+        set -x
+        lalapps_Weave ${weave_max_options} --output-file=WeaveOutMax.fits \
+            --toplists=all --toplist-limit=2321 --segment-info --setup-file=WeaveSetup.fits \
+            ${weave_sft_options} ${weave_search_options}
+        lalapps_fits_overview WeaveOutMax.fits
+        lalapps_fits_table_list "WeaveOutMax.fits[cache_info]"
+        set +x
+        echo
+
+        echo "=== Setup '${setup}': Check that number of coherent templates are equal with a maximum cache ${max} ==="
+        set -x
+        coh_ntmpl_max=`lalapps_fits_header_getval "WeaveOutMax.fits[0]" 'NCOHTPL' | tr '\n\r' '  ' | awk 'NF == 1 {printf "%d", $1}'`
+        expr ${coh_ntmpl_no_max} '=' ${coh_ntmpl_max}
+        set +x
+        echo
+
+        echo "=== Setup '${setup}': Check that with a maximum cache ${max} number of recomputed results is above tolerance ==="
+        set -x
+        coh_nres_max=`lalapps_fits_header_getval "WeaveOutMax.fits[0]" 'NCOHRES' | tr '\n\r' '  ' | awk 'NF == 1 {printf "%d", $1}'`
+        awk "BEGIN { print recomp = ( ${coh_nres_max} - ${coh_ntmpl_max} ) / ${coh_ntmpl_max}; exit ( recomp > ${weave_recomp_threshold} ? 0 : 1 ) }"
+        set +x
+        echo
+
+        case ${max} in
+
+            mem)
+                echo "=== Setup '${setup}': Check that with a maximum cache ${max} the cache memory stays within ${weave_cache_max_mem} MB ==="
+                echo "=== (or, if a single item exceeds the memory of a cache, that each cache held at most one item) ==="
+                set -x
+                cache_max_mem=`lalapps_fits_header_getval "WeaveOutMax.fits[0]" 'CACHEMAXMEM' | tr '\n\r' '  ' | awk 'NF == 1 {printf "%.16g", $1}'`
+                cache_max_items=`lalapps_fits_table_list "WeaveOutMax.fits[cache_info][col max_items]" | awk '/^#/ { next } NF == 1 && $1 > n { n = $1 } END { printf "%d", n }'`
+                awk "BEGIN { exit ( ${cache_max_mem} <= ${weave_cache_max_mem} || ${cache_max_items} <= 1 ? 0 : 1 ) }"
+                set +x
+                echo
+                ;;
+
+            *)
+                ;;
+
+        esac
+
+        case ${setup} in
+
+            short)
+                echo "=== Setup '${setup}': Compare F-statistics from lalapps_Weave without/with a maximum cache ${max} ==="
+                set -x
+                env LAL_DEBUG_LEVEL="${LAL_DEBUG_LEVEL},info" lalapps_WeaveCompare --setup-file=WeaveSetup.fits --result-file-1=WeaveOutNoMax.fits --result-file-2=WeaveOutMax.fits
+                set +x
+                echo
+                ;;
+
+            *)
+                ;;
+
+        esac
 
-        *)
-            ;;
-
-    esac
+    done
 
 done
@@ -0,0 +1,55 @@
+# Perform an interpolating search with one/several threads, and check for consistent results
+
+export LAL_FSTAT_FFT_PLAN_MODE=ESTIMATE
+
+for Fmethod in ResampBest DemodBest; do
+
+    echo "=== F-statistic method '${Fmethod}': Create search setup with 3 segments ==="
+    set -x
+    lalapps_WeaveSetup --first-segment=1122332211/90000 --segment-count=3 --detectors=H1,L1 --output-file=WeaveSetup.fits
+    lalapps_fits_overview WeaveSetup.fits
+    set +x
+    echo
+
+    echo "=== F-statistic method '${Fmethod}': Generate timestamps spanning segment list in WeaveSetup.fits ==="
+    set -x
+    lalapps_fits_table_list 'WeaveSetup.fits[segments][col c1=start_s; col2=end_s]' \
+        | awk '/^#/ { next } { for ( t = $1; t + 1800 <= $2 + 1; t += 1800 ) { print t } }' > timestamps-1.txt
+    awk 'NR % 5 != 3 { print }' timestamps-1.txt > timestamps-2.txt
+    set +x
+    echo
+
+    weave_options="--toplists=mean2F --toplist-limit=2321 --segment-info --setup-file=WeaveSetup.fits \
+        --rand-seed=3456 --sft-timebase=1800 --sft-noise-sqrtSX=1,1 --sft-timestamps-files=timestamps-1.txt,timestamps-2.txt \
+        --alpha=1.9/1.4 --delta=-1.2/2.3 --freq=49.5/0.01 --f1dot=-1e-9,0 --semi-max-mismatch=6 --coh-max-mismatch=0.3 \
+        --freq-partitions=4 --Fstat-method=${Fmethod}"
+
+    echo "=== F-statistic method '${Fmethod}': Perform interpolating search with 1 thread ==="
+    set -x
+    lalapps_Weave --output-file=WeaveOutSerial.fits --threads=1 ${weave_options}
+    lalapps_fits_overview WeaveOutSerial.fits
+    set +x
+    echo
+
+    echo "=== F-statistic method '${Fmethod}': Perform interpolating search with 2 threads ==="
+    set -x
+    lalapps_Weave --output-file=WeaveOutThreads.fits --threads=2 ${weave_options}
+    lalapps_fits_overview WeaveOutThreads.fits
+    set +x
+    echo
+
+    echo "=== F-statistic method '${Fmethod}': Check that searches with 1/2 threads computed the same number of semicoherent templates ==="
+    set -x
+    semi_ntmpl_serial=`lalapps_fits_header_getval "WeaveOutSerial.fits[0]" 'NSEMITPL' | tr '\n\r' '  ' | awk 'NF == 1 {printf "%d", $1}'`
+    semi_ntmpl_threads=`lalapps_fits_header_getval "WeaveOutThreads.fits[0]" 'NSEMITPL' | tr '\n\r' '  ' | awk 'NF == 1 {printf "%d", $1}'`
+    [ "${semi_ntmpl_serial}" = "${semi_ntmpl_threads}" ]
+    set +x
+    echo
+
+    echo "=== F-statistic method '${Fmethod}': Compare F-statistics from lalapps_Weave with 1/2 threads ==="
+    set -x
+    env LAL_DEBUG_LEVEL="${LAL_DEBUG_LEVEL},info" lalapps_WeaveCompare --setup-file=WeaveSetup.fits --result-file-1=WeaveOutSerial.fits --result-file-2=WeaveOutThreads.fits
+    set +x
+    echo
+
+done
@@ -0,0 +1,179 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+/**
+ * \file
+ * \ingroup lalmetaio_general
+ *
+ * \brief Test and benchmark of the streaming, columnar LIGO_LW XML reader.
+ *
+ * A gzip-compressed \c sngl_inspiral table of random triggers is written
+ * with XLALWriteLIGOLwXMLSnglInspiralTable(), and read back both with
+ * LALSnglInspiralTableFromLIGOLw() and with XLALLIGOLwReadTableColumns().
+ * The values read by both are checked against those written, and the time
+ * taken by each reader is printed.
+ *
+ * ### Usage ###
+ *
+ * \code
+ * LIGOLwXMLReadColumnsTest [number of triggers]
+ * \endcode
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <lal/LALStdlib.h>
+#include <lal/FileIO.h>
+#include <lal/LALConstants.h>
+#include <lal/LogPrintf.h>
+#include <lal/LIGOMetadataTables.h>
+#include <lal/LIGOLwXML.h>
+#include <lal/LIGOLwXMLRead.h>
+#include <lal/LIGOLwXMLInspiralRead.h>
+#include <lal/StringVector.h>
+
+#define FILENAME "LIGOLwXMLReadColumnsTest.xml.gz"
+#define FILENAME_INT_8U "LIGOLwXMLReadColumnsTest-int_8u.xml.gz"
+
+/* real_4 and real_8 values are written with 8 and 16 significant digits,
+ * so are only compared to within a relative tolerance */
+static int close_to(REAL8 x, REAL8 x0, REAL8 tol)
+{
+  return fabs(x - x0) <= tol * fabs(x0);
+}
+
+/* write a table with a single int_8u column holding the given value */
+static int write_int_8u_table(const char *value)
+{
+  LALFILE *fp = XLALFileOpenWrite(FILENAME_INT_8U, 1);
+  XLAL_CHECK(fp != NULL, XLAL_EFUNC);
+  XLAL_CHECK(XLALFilePrintf(fp, "<?xml version='1.0' encoding='utf-8'?>\n<LIGO_LW>\n<Table Name=\"values:table\">\n<Column Name=\"values:value\" Type=\"int_8u\"/>\n<Stream Name=\"values:table\" Delimiter=\",\" Type=\"Local\">\n%s,\n</Stream>\n</Table>\n</LIGO_LW>\n", value) >= 0, XLAL_EIO);
+  XLAL_CHECK(XLALFileClose(fp) == 0, XLAL_EIO);
+  return XLAL_SUCCESS;
+}
+
+static void destroy_events(SnglInspiralTable *head)
+{
+  while (head) {
+    SnglInspiralTable *next = head->next;
+    LALFree(head);
+    head = next;
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  static const char *ifos[] = {"H1", "L1", "V1"};
+  const INT4 num_events = argc > 1 ? atoi(argv[1]) : 20000;
+  SnglInspiralTable *events = NULL, **next = &events;
+  SnglInspiralTable *metaio_events = NULL;
+  LIGOLwXMLStream *xml;
+  LALStringVector *names;
+  LIGOLwTableColumns *table;
+  const SnglInspiralTable *event, *metaio_event;
+  REAL8 tic, time_metaio, time_columns;
+  INT4 i, n;
+
+  /* make random triggers and write them to a file */
+  srand(2137);
+  for (i = 0; i < num_events; i++) {
+    SnglInspiralTable *row = LALCalloc(1, sizeof(*row));
+    XLAL_CHECK_MAIN(row != NULL, XLAL_ENOMEM);
+    snprintf(row->ifo, sizeof(row->ifo), "%s", ifos[rand() % 3]);
+    snprintf(row->search, sizeof(row->search), "FindChirpSPtwoPN");
+    snprintf(row->channel, sizeof(row->channel), "LDAS-STRAIN");
+    row->end.gpsSeconds = 900000000 + rand() % 1000000;
+    row->end.gpsNanoSeconds = rand() % 1000000000;
+    row->mass1 = 1.0 + 49.0 * rand() / RAND_MAX;
+    row->mass2 = 1.0 + 49.0 * rand() / RAND_MAX;
+    row->snr = 5.5 + 100.0 * rand() / RAND_MAX;
+    row->chisq = 100.0 * rand() / RAND_MAX;
+    row->sigmasq = 1e6 * rand() / RAND_MAX;
+    row->event_id = i;
+    *next = row;
+    next = &row->next;
+  }
+  XLAL_CHECK_MAIN((xml = XLALOpenLIGOLwXMLFile(FILENAME)) != NULL, XLAL_EFUNC);
+  XLAL_CHECK_MAIN(XLALWriteLIGOLwXMLSnglInspiralTable(xml, events) == 0, XLAL_EFUNC);
+  XLAL_CHECK_MAIN(XLALCloseLIGOLwXMLFile(xml) == 0, XLAL_EFUNC);
+
+  /* read the triggers back row-by-row with libmetaio */
+  tic = XLALGetTimeOfDay();
+  n = LALSnglInspiralTableFromLIGOLw(&metaio_events, FILENAME, 0, -1);
+  time_metaio = XLALGetTimeOfDay() - tic;
+  XLAL_CHECK_MAIN(n == num_events, XLAL_EFAILED, "LALSnglInspiralTableFromLIGOLw() read %d triggers, expected %d", n, num_events);
+
+  /* read the triggers back with the columnar reader */
+  names = XLALCreateStringVector("ifo", "end_time", "end_time_ns", "mass1", "mass2", "snr", "chisq", "sigmasq", "event_id", NULL);
+  XLAL_CHECK_MAIN(names != NULL, XLAL_EFUNC);
+  tic = XLALGetTimeOfDay();
+  table = XLALLIGOLwReadTableColumns(FILENAME, "sngl_inspiral", names);
+  time_columns = XLALGetTimeOfDay() - tic;
+  XLAL_CHECK_MAIN(table != NULL, XLAL_EFUNC);
+  XLAL_CHECK_MAIN(table->num_rows == (size_t) num_events, XLAL_EFAILED, "XLALLIGOLwReadTableColumns() read %zu triggers, expected %d", table->num_rows, num_events);
+  XLAL_CHECK_MAIN(table->num_columns == names->length, XLAL_EFAILED);
+  for (i = 0; i < (INT4) names->length; i++)
+    XLAL_CHECK_MAIN(XLALLIGOLwTableColumnsFind(table, names->data[i]) == i, XLAL_EFAILED);
+  XLAL_CHECK_MAIN(table->columns[0].storage == LIGOLW_COLUMN_STRING && table->columns[1].storage == LIGOLW_COLUMN_INT && table->columns[3].storage == LIGOLW_COLUMN_REAL, XLAL_EFAILED);
+
+  /* compare with the triggers written */
+  for (i = 0, event = events, metaio_event = metaio_events; i < num_events; i++, event = event->next, metaio_event = metaio_event->next) {
+    XLAL_CHECK_MAIN(strcmp(metaio_event->ifo, event->ifo) == 0 && metaio_event->end.gpsSeconds == event->end.gpsSeconds && metaio_event->end.gpsNanoSeconds == event->end.gpsNanoSeconds && close_to(metaio_event->mass1, event->mass1, 1e-6) && close_to(metaio_event->snr, event->snr, 1e-6) && metaio_event->event_id == event->event_id, XLAL_EFAILED, "LALSnglInspiralTableFromLIGOLw() trigger %d differs", i);
+    XLAL_CHECK_MAIN(strcmp(table->columns[0].as_string[i], event->ifo) == 0, XLAL_EFAILED, "ifo of trigger %d differs", i);
+    XLAL_CHECK_MAIN(table->columns[1].as_int[i] == event->end.gpsSeconds, XLAL_EFAILED, "end_time of trigger %d differs", i);
+    XLAL_CHECK_MAIN(table->columns[2].as_int[i] == event->end.gpsNanoSeconds, XLAL_EFAILED, "end_time_ns of trigger %d differs", i);
+    XLAL_CHECK_MAIN(close_to(table->columns[3].as_real[i], event->mass1, 1e-6), XLAL_EFAILED, "mass1 of trigger %d differs", i);
+    XLAL_CHECK_MAIN(close_to(table->columns[4].as_real[i], event->mass2, 1e-6), XLAL_EFAILED, "mass2 of trigger %d differs", i);
+    XLAL_CHECK_MAIN(close_to(table->columns[5].as_real[i], event->snr, 1e-6), XLAL_EFAILED, "snr of trigger %d differs", i);
+    XLAL_CHECK_MAIN(close_to(table->columns[6].as_real[i], event->chisq, 1e-6), XLAL_EFAILED, "chisq of trigger %d differs", i);
+    XLAL_CHECK_MAIN(close_to(table->columns[7].as_real[i], event->sigmasq, 1e-14), XLAL_EFAILED, "sigmasq of trigger %d differs", i);
+    XLAL_CHECK_MAIN(table->columns[8].as_int[i] == event->event_id, XLAL_EFAILED, "event_id of trigger %d differs", i);
+  }
+
+  printf("read %d sngl_inspiral triggers from %s:\n", num_events, FILENAME);
+  printf("  LALSnglInspiralTableFromLIGOLw(): %.3f s\n", time_metaio);
+  printf("  XLALLIGOLwReadTableColumns():     %.3f s (%zu columns)\n", time_columns, table->num_columns);
+
+  /* a missing column is an error */
+  XLALDestroyStringVector(names);
+  names = XLALCreateStringVector("snr", "no_such_column", NULL);
+  XLAL_CHECK_MAIN(names != NULL, XLAL_EFUNC);
+  XLALDestroyLIGOLwTableColumns(table);
+  table = XLALLIGOLwReadTableColumns(FILENAME, "sngl_inspiral", names);
+  XLAL_CHECK_MAIN(table == NULL, XLAL_EFAILED, "XLALLIGOLwReadTableColumns() did not fail on a missing column");
+  XLALClearErrno();
+
+  /* int_8u values are read up to the largest INT8, and are an error above it */
+  XLAL_CHECK_MAIN(write_int_8u_table("9223372036854775807") == XLAL_SUCCESS, XLAL_EFUNC);
+  table = XLALLIGOLwReadTableColumns(FILENAME_INT_8U, "values", NULL);
+  XLAL_CHECK_MAIN(table != NULL && table->num_rows == 1 && table->columns[0].as_int[0] == (INT8) LAL_INT8_MAX, XLAL_EFAILED, "XLALLIGOLwReadTableColumns() did not read the largest int_8u value");
+  XLALDestroyLIGOLwTableColumns(table);
+  XLAL_CHECK_MAIN(write_int_8u_table("9223372036854775808") == XLAL_SUCCESS, XLAL_EFUNC);
+  table = XLALLIGOLwReadTableColumns(FILENAME_INT_8U, "values", NULL);
+  XLAL_CHECK_MAIN(table == NULL, XLAL_EFAILED, "XLALLIGOLwReadTableColumns() did not fail on an int_8u value out of range");
+  XLALClearErrno();
+
+  XLALDestroyStringVector(names);
+  destroy_events(events);
+  destroy_events(metaio_events);
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+}
@@ -85,14 +85,18 @@
  *
  */
 
+#include <ctype.h>
+#include <errno.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
 #include <metaio.h>
 
 #include <lal/Date.h>
+#include <lal/FileIO.h>
 #include <lal/LALConstants.h>
 #include <lal/LALStdio.h>
+#include <lal/LALString.h>
 #include <lal/LIGOLwXMLRead.h>
 #include <lal/LIGOMetadataTables.h>
 #include <lal/LIGOMetadataUtils.h>
@@ -680,3 +684,697 @@ SearchSummaryTable *XLALSearchSummaryTableFromLIGOLw(
 
 	return head;
 }
+
+
+
+/*
+ * ============================================================================
+ *
+ *                     Streaming, Columnar Table Reader
+ *
+ * ============================================================================
+ */
+
+
+/* size of the chunks in which the document is read */
+#define LIGOLW_READ_CHUNK (1 << 20)
+
+
+/* buffered reader over a (possibly gzip-compressed) document */
+struct ligolw_reader {
+	LALFILE *fp;
+	char *buf;
+	size_t len;
+	size_t pos;
+	int error;
+};
+
+
+/* growable, nul-terminated character buffer */
+struct ligolw_strbuf {
+	char *data;
+	size_t len;
+	size_t size;
+};
+
+
+static int ligolw_reader_fill(struct ligolw_reader *reader)
+{
+	size_t len = XLALFileRead(reader->buf, 1, LIGOLW_READ_CHUNK, reader->fp);
+	if(len == (size_t) -1) {
+		reader->error = 1;
+		len = 0;
+	}
+	reader->len = len;
+	reader->pos = 0;
+	return len > 0;
+}
+
+
+static inline int ligolw_getc(struct ligolw_reader *reader)
+{
+	if(reader->pos >= reader->len && !ligolw_reader_fill(reader))
+		return EOF;
+	return (unsigned char) reader->buf[reader->pos++];
+}
+
+
+static int ligolw_strbuf_push(struct ligolw_strbuf *str, int c)
+{
+	if(str->len + 1 >= str->size) {
+		size_t size = str->size ? 2 * str->size : 64;
+		char *data = XLALRealloc(str->data, size);
+		if(!data)
+			XLAL_ERROR(XLAL_ENOMEM);
+		str->data = data;
+		str->size = size;
+	}
+	str->data[str->len++] = c;
+	str->data[str->len] = '\0';
+	return 0;
+}
+
+
+static int ligolw_strbuf_clear(struct ligolw_strbuf *str)
+{
+	if(!str->data) {
+		if(ligolw_strbuf_push(str, '\0') < 0)
+			XLAL_ERROR(XLAL_EFUNC);
+	}
+	str->len = 0;
+	str->data[0] = '\0';
+	return 0;
+}
+
+
+/* read the contents of the next element tag, i.e. the text between '<'
+ * and '>', into tag; comments are skipped.  returns 0 on success, 1 at
+ * the end of the document, and < 0 on error. */
+static int ligolw_next_tag(struct ligolw_reader *reader, struct ligolw_strbuf *tag)
+{
+	int c;
+
+	do {
+		while((c = ligolw_getc(reader)) != '<')
+			if(c == EOF) {
+				if(reader->error)
+					XLAL_ERROR(XLAL_EIO);
+				return 1;
+			}
+
+		if(ligolw_strbuf_clear(tag) < 0)
+			XLAL_ERROR(XLAL_EFUNC);
+		while(1) {
+			c = ligolw_getc(reader);
+			if(c == EOF) {
+				XLALPrintError("%s(): unterminated element tag\n", __func__);
+				XLAL_ERROR(reader->error ? XLAL_EIO : XLAL_EDATA);
+			}
+			/* a comment ends at "-->" */
+			if(c == '>' && (strncmp(tag->data, "!--", 3) || (tag->len >= 5 && !strcmp(tag->data + tag->len - 2, "--"))))
+				break;
+			if(ligolw_strbuf_push(tag, c) < 0)
+				XLAL_ERROR(XLAL_EFUNC);
+		}
+	} while(!strncmp(tag->data, "!--", 3));
+
+	return 0;
+}
+
+
+/* test whether a tag is an element of the given name */
+static int ligolw_tag_is(const char *tag, const char *name)
+{
+	size_t n = strlen(name);
+	return !strncmp(tag, name, n) && (tag[n] == '\0' || tag[n] == '/' || isspace((unsigned char) tag[n]));
+}
+
+
+/* copy the value of an attribute of a tag into value; returns 1 if the
+ * attribute was found, 0 if not, and < 0 on error */
+static int ligolw_tag_attribute(const char *tag, const char *attr, struct ligolw_strbuf *value)
+{
+	size_t n = strlen(attr);
+
+	/* skip element name */
+	while(*tag && !isspace((unsigned char) *tag))
+		tag++;
+
+	while(*tag) {
+		const char *name;
+		size_t name_len;
+		char quote;
+
+		while(isspace((unsigned char) *tag))
+			tag++;
+		name = tag;
+		while(*tag && *tag != '=' && !isspace((unsigned char) *tag))
+			tag++;
+		name_len = tag - name;
+		while(isspace((unsigned char) *tag))
+			tag++;
+		if(*tag++ != '=')
+			break;
+		while(isspace((unsigned char) *tag))
+			tag++;
+		quote = *tag++;
+		if(quote != '"' && quote != '\'')
+			break;
+		if(name_len == n && !strncmp(name, attr, n)) {
+			if(ligolw_strbuf_clear(value) < 0)
+				XLAL_ERROR(XLAL_EFUNC);
+			while(*tag && *tag != quote)
+				if(ligolw_strbuf_push(value, *tag++) < 0)
+					XLAL_ERROR(XLAL_EFUNC);
+			return 1;
+		}
+		while(*tag && *tag != quote)
+			tag++;
+		if(*tag)
+			tag++;
+	}
+
+	return 0;
+}
+
+
+/* strip the ":table" suffix and any prefixes from a table or column name,
+ * in place, as libmetaio does when matching names */
+static char *ligolw_strip_name(char *name, int is_table)
+{
+	char *colon;
+	size_t n = strlen(name);
+
+	if(is_table && n >= 6 && !strcmp(name + n - 6, ":table"))
+		name[n - 6] = '\0';
+	colon = strrchr(name, ':');
+	if(colon)
+		memmove(name, colon + 1, strlen(colon + 1) + 1);
+
+	return name;
+}
+
+
+/* decode the XML character entities in a string, in place */
+static void ligolw_decode_entities(char *s)
+{
+	static const struct {
+		const char *entity;
+		char c;
+	} entities[] = {
+		{"&lt;", '<'},
+		{"&gt;", '>'},
+		{"&amp;", '&'},
+		{"&quot;", '"'},
+		{"&apos;", '\''}
+	};
+	char *out = s;
+
+	while(*s) {
+		size_t i = XLAL_NUM_ELEM(entities);
+		if(*s == '&')
+			for(i = 0; i < XLAL_NUM_ELEM(entities); i++)
+				if(!strncmp(s, entities[i].entity, strlen(entities[i].entity)))
+					break;
+		if(i < XLAL_NUM_ELEM(entities)) {
+			*out++ = entities[i].c;
+			s += strlen(entities[i].entity);
+		} else
+			*out++ = *s++;
+	}
+	*out = '\0';
+}
+
+
+/* determine how the values of a column of the given LIGO_LW type are stored */
+static int ligolw_column_storage(const char *type, LIGOLwColumnStorage *storage)
+{
+	static const char *const int_types[] = {"int_2s", "int_2u", "int_4s", "int_4u", "int_8s", "int_8u"};
+	static const char *const real_types[] = {"real_4", "real_8"};
+	static const char *const string_types[] = {"lstring", "char_s", "char_v", "ilwd:char", "ilwd:char_u"};
+	size_t i;
+
+	for(i = 0; i < XLAL_NUM_ELEM(int_types); i++)
+		if(!strcmp(type, int_types[i])) {
+			*storage = LIGOLW_COLUMN_INT;
+			return 0;
+		}
+	for(i = 0; i < XLAL_NUM_ELEM(real_types); i++)
+		if(!strcmp(type, real_types[i])) {
+			*storage = LIGOLW_COLUMN_REAL;
+			return 0;
+		}
+	for(i = 0; i < XLAL_NUM_ELEM(string_types); i++)
+		if(!strcmp(type, string_types[i])) {
+			*storage = LIGOLW_COLUMN_STRING;
+			return 0;
+		}
+
+	XLALPrintError("%s(): unsupported column type \"%s\"\n", __func__, type);
+	XLAL_ERROR(XLAL_EDATA);
+}
+
+
+/* grow the value arrays of the columns from old_size to new_size rows;
+ * new string entries are set to NULL */
+static int ligolw_columns_resize(LIGOLwTableColumns *table, size_t old_size, size_t new_size)
+{
+	size_t i;
+
+	for(i = 0; i < table->num_columns; i++) {
+		LIGOLwColumn *column = &table->columns[i];
+		void *data;
+		switch(column->storage) {
+		case LIGOLW_COLUMN_INT:
+			if((data = XLALRealloc(column->as_int, new_size * sizeof(*column->as_int))))
+				column->as_int = data;
+			break;
+		case LIGOLW_COLUMN_REAL:
+			if((data = XLALRealloc(column->as_real, new_size * sizeof(*column->as_real))))
+				column->as_real = data;
+			break;
+		default:
+			if((data = XLALRealloc(column->as_string, new_size * sizeof(*column->as_string)))) {
+				column->as_string = data;
+				memset(column->as_string + old_size, 0, (new_size - old_size) * sizeof(*column->as_string));
+			}
+			break;
+		}
+		if(!data)
+			XLAL_ERROR(XLAL_ENOMEM);
+	}
+
+	return 0;
+}
+
+
+/* convert a value from the stream and store it in a row of a column */
+static int ligolw_store_value(LIGOLwColumn *column, size_t row, char *value, int quoted)
+{
+	char *end;
+
+	switch(column->storage) {
+	case LIGOLW_COLUMN_INT:
+		if(!*value) {
+			column->as_int[row] = 0;
+			break;
+		}
+		errno = 0;
+		if(!strcmp(column->type, "int_8u")) {
+			/* int_8u values are stored as INT8, so must not exceed its range */
+			unsigned long long uvalue = strtoull(value, &end, 10);
+			if(strchr(value, '-') || uvalue > LAL_INT8_MAX)
+				errno = ERANGE;
+			column->as_int[row] = (INT8) uvalue;
+		} else
+			column->as_int[row] = strtoll(value, &end, 10);
+		if(*end || errno) {
+			XLALPrintError("%s(): invalid %s value \"%s\" in column \"%s\"\n", __func__, column->type, value, column->name);
+			XLAL_ERROR(XLAL_EDATA);
+		}
+		break;
+
+	case LIGOLW_COLUMN_REAL:
+		if(!*value) {
+			column->as_real[row] = 0;
+			break;
+		}
+		/* parse real_4 values in single precision, as libmetaio does */
+		if(!strcmp(column->type, "real_4"))
+			column->as_real[row] = strtof(value, &end);
+		else
+			column->as_real[row] = strtod(value, &end);
+		if(*end) {
+			XLALPrintError("%s(): invalid %s value \"%s\" in column \"%s\"\n", __func__, column->type, value, column->name);
+			XLAL_ERROR(XLAL_EDATA);
+		}
+		break;
+
+	default:
+		if(!*value && !quoted) {
+			column->as_string[row] = NULL;
+			break;
+		}
+		ligolw_decode_entities(value);
+		column->as_string[row] = XLALStringDuplicate(value);
+		if(!column->as_string[row])
+			XLAL_ERROR(XLAL_EFUNC);
+		break;
+	}
+
+	return 0;
+}
+
+
+/* parse the contents of a Stream element; on entry the reader is
+ * positioned just after the Stream start tag.  column_map maps the columns
+ * of the document to the requested columns, or to -1 if not requested */
+static int ligolw_parse_stream(struct ligolw_reader *reader, LIGOLwTableColumns *table, const int *column_map, size_t num_doc_columns, int delimiter, struct ligolw_strbuf *token)
+{
+	size_t capacity = 0;
+	size_t col = 0;
+	int errnum = 0;
+	int c;
+
+	table->num_rows = 0;
+
+	while(1) {
+		const int keep = column_map[col] >= 0;
+		int empty = 1;
+		int quoted = 0;
+
+		if(ligolw_strbuf_clear(token) < 0) {
+			errnum = XLAL_EFUNC;
+			goto failed;
+		}
+
+		/* skip leading white space */
+		do
+			c = ligolw_getc(reader);
+		while(c != EOF && isspace(c));
+
+		if(c == '"') {
+			/* quoted string, with backslash escapes */
+			quoted = 1;
+			while((c = ligolw_getc(reader)) != '"') {
+				if(c == '\\')
+					c = ligolw_getc(reader);
+				if(c == EOF)
+					break;
+				if(keep && ligolw_strbuf_push(token, c) < 0) {
+					errnum = XLAL_EFUNC;
+					goto failed;
+				}
+			}
+			if(c != EOF)
+				do
+					c = ligolw_getc(reader);
+				while(c != EOF && isspace(c));
+		} else {
+			/* unquoted value, up to the delimiter */
+			while(c != EOF && c != delimiter && c != '<') {
+				if(!isspace(c))
+					empty = 0;
+				if(keep && ligolw_strbuf_push(token, c) < 0) {
+					errnum = XLAL_EFUNC;
+					goto failed;
+				}
+				c = ligolw_getc(reader);
+			}
+			while(token->len && isspace((unsigned char) token->data[token->len - 1]))
+				token->data[--token->len] = '\0';
+		}
+
+		if(c == EOF) {
+			XLALPrintError("%s(): unterminated Stream in %s table\n", __func__, table->table_name);
+			errnum = reader->error ? XLAL_EIO : XLAL_EDATA;
+			goto failed;
+		}
+		if(c != delimiter && c != '<') {
+			XLALPrintError("%s(): expected delimiter in %s table, found '%c'\n", __func__, table->table_name, c);
+			errnum = XLAL_EDATA;
+			goto failed;
+		}
+
+		/* end of an empty Stream, or of a Stream with a delimiter after the last row */
+		if(c == '<' && col == 0 && !quoted && empty)
+			break;
+
+		/* store the value */
+		if(keep) {
+			if(table->num_rows >= capacity) {
+				size_t new_capacity = capacity ? 2 * capacity : 1024;
+				if(ligolw_columns_resize(table, capacity, new_capacity) < 0) {
+					errnum = XLAL_EFUNC;
+					goto failed;
+				}
+				capacity = new_capacity;
+			}
+			if(ligolw_store_value(&table->columns[column_map[col]], table->num_rows, token->data, quoted) < 0) {
+				errnum = XLAL_EFUNC;
+				goto failed;
+			}
+		}
+
+		if(++col == num_doc_columns) {
+			col = 0;
+			table->num_rows++;
+		}
+
+		if(c == '<')
+			break;
+	}
+
+	if(col != 0) {
+		XLALPrintError("%s(): incomplete row %zu in %s table\n", __func__, table->num_rows, table->table_name);
+		errnum = XLAL_EDATA;
+		goto failed;
+	}
+
+	/* check the Stream end tag */
+	if(ligolw_strbuf_clear(token) < 0) {
+		errnum = XLAL_EFUNC;
+		goto failed;
+	}
+	while((c = ligolw_getc(reader)) != '>' && c != EOF)
+		if(ligolw_strbuf_push(token, c) < 0) {
+			errnum = XLAL_EFUNC;
+			goto failed;
+		}
+	if(c == EOF || !ligolw_tag_is(token->data, "/Stream")) {
+		XLALPrintError("%s(): malformed Stream in %s table\n", __func__, table->table_name);
+		errnum = XLAL_EDATA;
+		goto failed;
+	}
+
+	return 0;
+
+failed:
+	/* include a partially-read row, so that its strings are freed */
+	if(table->num_rows < capacity)
+		table->num_rows++;
+	XLAL_ERROR(errnum);
+}
+
+
+/**
+ * Read columns of a table from a LIGO Light Weight XML file into
+ * contiguous arrays, one per column.
+ *
+ * Unlike the row-by-row readers above, which go through libmetaio and
+ * build linked lists of heap-allocated rows, this function tokenizes the
+ * table's Stream element directly from large buffered reads, converting
+ * only the requested columns and storing each in a single array.  This is
+ * much faster and more compact for tables with many rows.  The file may be
+ * gzip-compressed.  Parsing stops at the end of the first table named
+ * table_name; the rest of the document is not read.
+ *
+ * column_names lists the columns to read, without table name prefixes;
+ * they are returned in this order.  If column_names is NULL, all columns
+ * are read, in document order.  It is an error for a requested column to
+ * be missing.
+ *
+ * The result must be freed with XLALDestroyLIGOLwTableColumns().
+ */
+LIGOLwTableColumns *XLALLIGOLwReadTableColumns(
+	const char *filename,
+	const char *table_name,
+	const LALStringVector *column_names
+)
+{
+	struct ligolw_reader reader = {NULL, NULL, 0, 0, 0};
+	struct ligolw_strbuf tag = {NULL, 0, 0};
+	struct ligolw_strbuf value = {NULL, 0, 0};
+	LIGOLwTableColumns *table = NULL;
+	char **doc_names = NULL;
+	char **doc_types = NULL;
+	int *column_map = NULL;
+	size_t num_doc_columns = 0;
+	int in_table = 0;
+	int found_table = 0;
+	int have_stream = 0;
+	int delimiter = ',';
+	int errnum = 0;
+	int status = 0;
+	size_t i, j;
+
+	XLAL_CHECK_NULL(filename != NULL, XLAL_EFAULT);
+	XLAL_CHECK_NULL(table_name != NULL, XLAL_EFAULT);
+
+	/* open the file */
+
+	reader.fp = XLALFileOpenRead(filename);
+	if(!reader.fp) {
+		XLALPrintError("%s(): error opening \"%s\"\n", __func__, filename);
+		XLAL_ERROR_NULL(XLAL_EIO);
+	}
+	reader.buf = XLALMalloc(LIGOLW_READ_CHUNK);
+	table = XLALCalloc(1, sizeof(*table));
+	if(!reader.buf || !table || !(table->table_name = XLALStringDuplicate(table_name))) {
+		errnum = XLAL_ENOMEM;
+		goto done;
+	}
+
+	/* scan the document's elements up to the table's Stream */
+
+	while(!found_table && (status = ligolw_next_tag(&reader, &tag)) == 0) {
+		if(ligolw_tag_is(tag.data, "Table")) {
+			if(ligolw_tag_attribute(tag.data, "Name", &value) > 0 && !strcmp(ligolw_strip_name(value.data, 1), table_name))
+				in_table = 1;
+		} else if(in_table && ligolw_tag_is(tag.data, "/Table")) {
+			found_table = 1;
+		} else if(in_table && ligolw_tag_is(tag.data, "Column")) {
+			char **names = XLALRealloc(doc_names, (num_doc_columns + 1) * sizeof(*doc_names));
+			char **types = names ? XLALRealloc(doc_types, (num_doc_columns + 1) * sizeof(*doc_types)) : NULL;
+			if(names)
+				doc_names = names;
+			if(types)
+				doc_types = types;
+			if(!names || !types) {
+				errnum = XLAL_ENOMEM;
+				goto done;
+			}
+			doc_names[num_doc_columns] = doc_types[num_doc_columns] = NULL;
+			num_doc_columns++;
+			if(ligolw_tag_attribute(tag.data, "Name", &value) <= 0 || !(doc_names[num_doc_columns - 1] = XLALStringDuplicate(ligolw_strip_name(value.data, 0)))) {
+				XLALPrintError("%s(): invalid Column in %s table\n", __func__, table_name);
+				errnum = XLAL_EDATA;
+				goto done;
+			}
+			if(ligolw_tag_attribute(tag.data, "Type", &value) <= 0 || !(doc_types[num_doc_columns - 1] = XLALStringDuplicate(value.data))) {
+				XLALPrintError("%s(): invalid Column \"%s\" in %s table\n", __func__, doc_names[num_doc_columns - 1], table_name);
+				errnum = XLAL_EDATA;
+				goto done;
+			}
+		} else if(in_table && ligolw_tag_is(tag.data, "Stream")) {
+			found_table = 1;
+			/* an empty Stream element has no rows */
+			have_stream = tag.data[tag.len - 1] != '/';
+			if(ligolw_tag_attribute(tag.data, "Delimiter", &value) > 0 && value.len > 0)
+				delimiter = (unsigned char) value.data[0];
+		}
+	}
+	if(status < 0) {
+		errnum = XLAL_EFUNC;
+		goto done;
+	}
+	if(!found_table) {
+		XLALPrintError("%s(): cannot find %s table in \"%s\"\n", __func__, table_name, filename);
+		errnum = XLAL_EIO;
+		goto done;
+	}
+
+	/* set up the requested columns */
+
+	table->num_columns = column_names ? column_names->length : num_doc_columns;
+	table->columns = XLALCalloc(table->num_columns + 1, sizeof(*table->columns));
+	column_map = XLALMalloc((num_doc_columns + 1) * sizeof(*column_map));
+	if(!table->columns || !column_map) {
+		errnum = XLAL_ENOMEM;
+		goto done;
+	}
+	for(j = 0; j < num_doc_columns; j++)
+		column_map[j] = -1;
+	for(i = 0; i < table->num_columns; i++) {
+		LIGOLwColumn *column = &table->columns[i];
+		const char *name = column_names ? column_names->data[i] : doc_names[i];
+		for(j = 0; j < num_doc_columns; j++)
+			if(!strcmp(name, doc_names[j]))
+				break;
+		if(j == num_doc_columns) {
+			XLALPrintError("%s(): missing required column \"%s\" in %s table\n", __func__, name, table_name);
+			errnum = XLAL_EDATA;
+			goto done;
+		}
+		if(column_map[j] >= 0) {
+			XLALPrintError("%s(): column \"%s\" requested more than once\n", __func__, name);
+			errnum = XLAL_EINVAL;
+			goto done;
+		}
+		column_map[j] = i;
+		if(!(column->name = XLALStringDuplicate(doc_names[j])) || !(column->type = XLALStringDuplicate(doc_types[j]))) {
+			errnum = XLAL_ENOMEM;
+			goto done;
+		}
+		if(ligolw_column_storage(column->type, &column->storage) < 0) {
+			errnum = XLAL_EFUNC;
+			goto done;
+		}
+	}
+
+	/* parse the rows */
+
+	if(have_stream && num_doc_columns > 0 && ligolw_parse_stream(&reader, table, column_map, num_doc_columns, delimiter, &value) < 0)
+		errnum = XLAL_EFUNC;
+
+done:
+	XLALFree(column_map);
+	XLALFree(reader.buf);
+	XLALFree(tag.data);
+	XLALFree(value.data);
+	for(i = 0; i < num_doc_columns; i++) {
+		XLALFree(doc_names[i]);
+		XLALFree(doc_types[i]);
+	}
+	XLALFree(doc_names);
+	XLALFree(doc_types);
+	XLALFileClose(reader.fp);
+
+	if(errnum) {
+		XLALDestroyLIGOLwTableColumns(table);
+		XLAL_ERROR_NULL(errnum);
+	}
+
+	return table;
+}
+
+
+/**
+ * Free a table read by XLALLIGOLwReadTableColumns().
+ */
+void XLALDestroyLIGOLwTableColumns(
+	LIGOLwTableColumns *table
+)
+{
+	size_t i, j;
+
+	if(!table)
+		return;
+	if(table->columns)
+		for(i = 0; i < table->num_columns; i++) {
+			LIGOLwColumn *column = &table->columns[i];
+			if(column->as_string)
+				for(j = 0; j < table->num_rows; j++)
+					XLALFree(column->as_string[j]);
+			XLALFree(column->as_string);
+			XLALFree(column->as_int);
+			XLALFree(column->as_real);
+			XLALFree(column->name);
+			XLALFree(column->type);
+		}
+	XLALFree(table->columns);
+	XLALFree(table->table_name);
+	XLALFree(table);
+}
+
+
+/**
+ * Return the index of the named column in a table read by
+ * XLALLIGOLwReadTableColumns(), or a negative integer if it is not present.
+ */
+int XLALLIGOLwTableColumnsFind(
+	const LIGOLwTableColumns *table,
+	const char *name
+)
+{
+	size_t i;
+
+	XLAL_CHECK(table != NULL, XLAL_EFAULT);
+	XLAL_CHECK(name != NULL, XLAL_EFAULT);
+
+	for(i = 0; i < table->num_columns; i++)
+		if(!strcmp(table->columns[i].name, name))
+			return i;
+
+	return -1;
+}
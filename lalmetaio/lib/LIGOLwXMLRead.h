@@ -44,11 +44,51 @@
 #define _LIGOLWXMLREAD_H
 
 #include <lal/LIGOMetadataTables.h>
+#include <lal/StringVector.h>
 
 #ifdef  __cplusplus
 extern "C" {
 #endif
 
+/**
+ * How the values of a column read by XLALLIGOLwReadTableColumns() are
+ * stored.  Integer columns (int_2s, int_4s, int_8s, and their unsigned
+ * counterparts) are stored as INT8, so int_8u values above #LAL_INT8_MAX
+ * are rejected; floating-point columns (real_4, real_8) are stored as
+ * REAL8, and all other columns (lstring, ilwd:char, ...) as strings.
+ */
+typedef enum tagLIGOLwColumnStorage {
+	LIGOLW_COLUMN_INT,	/**< values are in LIGOLwColumn::as_int */
+	LIGOLW_COLUMN_REAL,	/**< values are in LIGOLwColumn::as_real */
+	LIGOLW_COLUMN_STRING	/**< values are in LIGOLwColumn::as_string */
+} LIGOLwColumnStorage;
+
+/**
+ * One column of a table read by XLALLIGOLwReadTableColumns().  Only the
+ * array matching \c storage is allocated; empty (NULL) entries in the
+ * document are stored as 0 for numeric columns and as NULL for string
+ * columns.
+ */
+typedef struct tagLIGOLwColumn {
+	char *name;			/**< column name, without the table name prefix */
+	char *type;			/**< LIGO_LW type of the column, e.g. "real_4" */
+	LIGOLwColumnStorage storage;	/**< how the values are stored */
+	INT8 *as_int;			/**< integer values */
+	REAL8 *as_real;			/**< floating-point values; real_4 values are exactly representable */
+	char **as_string;		/**< string values */
+} LIGOLwColumn;
+
+/**
+ * Columnar representation of (some of the columns of) a LIGO Light Weight
+ * XML table.
+ */
+typedef struct tagLIGOLwTableColumns {
+	char *table_name;		/**< table name, without the ":table" suffix */
+	size_t num_rows;		/**< number of rows */
+	size_t num_columns;		/**< number of columns */
+	LIGOLwColumn *columns;		/**< columns, in the requested order */
+} LIGOLwTableColumns;
+
 /* Forward declarations of MetaIO types.  Note that metaio.h is not
  * included by this header file, so the metaio API does not become part of
  * the API exported by lalmetaio.  The MetaioParseEnvironment structure is
@@ -91,6 +131,24 @@ XLALTimeSlideTableFromLIGOLw (
     const char *filename
 );
 
+LIGOLwTableColumns *
+XLALLIGOLwReadTableColumns (
+    const char *filename,
+    const char *table_name,
+    const LALStringVector *column_names
+);
+
+void
+XLALDestroyLIGOLwTableColumns (
+    LIGOLwTableColumns *table
+);
+
+int
+XLALLIGOLwTableColumnsFind (
+    const LIGOLwTableColumns *table,
+    const char *name
+);
+
 /* these functions need to be lalified, but they are in support... */
 
 SearchSummaryTable *
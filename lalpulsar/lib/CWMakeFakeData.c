@@ -28,6 +28,11 @@
 
 // ---------- includes
 #include <math.h>
+#include <complex.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 // GSL includes
 
@@ -45,8 +50,13 @@
 #include <lal/FFTWMutex.h>
 #include <lal/ExtrapolatePulsarSpins.h>
 #include <lal/ConfigFile.h>
+#include <lal/SSBtimes.h>
+#include <lal/LALComputeAM.h>
+#include <lal/FstatisticTools.h>
 
 // ---------- local defines
+#define SFT_DOMAIN_MAX_SEGMENT 240.0	// maximal length (in s) of the sub-segments of each SFT in XLALCWAddSignalsToSFTs()
+#define SFT_DOMAIN_BLOCK_PER_THREAD 4	// number of signals per thread handled together by XLALCWAddSignalsToSFTs()
 
 // ---------- local macro definitions
 #define SQ(x) ( (x) * (x) )
@@ -74,6 +84,8 @@ const char *const InjectionSourcesHelpString = "Source parameters to inject for
 
 // ---------- local prototypes
 static UINT4 gcd (UINT4 numer, UINT4 denom);
+static int CWSignalSegmentParams ( REAL8 *kappa, COMPLEX16 *prefac, const PulsarParams *pulsarParams, const DetectorStateSeries *detStates,
+                                  const MultiSSBtimesBatch *ssbBatch, REAL8 Tsft, REAL8 f0, UINT4 numSegments );
 int XLALcorrect_phase ( SFTtype *sft, LIGOTimeGPS tHeterodyne );
 int XLALCheckConfigFileWasFullyParsed ( const char *fname, const LALParsedDataFile *cfgdata );
 
@@ -183,6 +195,16 @@ XLALCWMakeFakeData ( SFTVector **SFTvect,
   XLAL_CHECK ( (dataParams->inputMultiTS == NULL) || (detectorIndex < dataParams->inputMultiTS->length), XLAL_EINVAL );
   XLAL_CHECK ( (dataParams->inputMultiTS == NULL) || (dataParams->fMin == 0 && dataParams->Band == 0), XLAL_EINVAL, "If given time-series, must have fMin=Band=0\n");
 
+  // with SFT-domain signal generation, only transient signals are generated in the time domain
+  BOOLEAN sftDomain = ( dataParams->SFTDomainDterms > 0 );
+  if ( sftDomain )
+    {
+      XLAL_CHECK ( SFTvect != NULL, XLAL_EINVAL, "SFT-domain signal generation requires SFT output\n" );
+      XLAL_CHECK ( Tseries == NULL, XLAL_EINVAL, "Time-series output is not available with SFT-domain signal generation\n" );
+      XLAL_CHECK ( (dataParams->SFTWindowType == NULL) || (XLALStringCaseCompare ( dataParams->SFTWindowType, "rectangular" ) == 0), XLAL_EINVAL,
+                   "SFT-domain signal generation requires a rectangular SFT window, got '%s'\n", dataParams->SFTWindowType );
+    }
+
   // initial default values fMin, sampling rate from caller input or timeseries
   REAL8 fMin  = dataParams->fMin;
   REAL8 fBand = dataParams->Band;
@@ -325,6 +347,11 @@ XLALCWMakeFakeData ( SFTVector **SFTvect,
       XLAL_CHECK ( (fCoverMin >= fMin) && (fCoverMax < fMin + fBand), XLAL_EINVAL, "Error: injection signal %d:'%s' needs frequency band [%f,%f]Hz, injecting into [%f,%f]Hz\n",
                    iInj, pulsarParams->name, fCoverMin, fCoverMax, fMin, fMin + fBand );
 
+      // non-transient signals are added directly to the SFTs below
+      if ( sftDomain && (pulsarParams->Transient.type == TRANSIENT_NONE) ) {
+        continue;
+      }
+
       REAL8 signalDuration = XLALGPSDiff ( &signalEndGPS, &signalStartGPS );
       XLAL_CHECK ( signalDuration >= 0, XLAL_EFAILED, "Something went wrong, got negative signal duration = %g\n", signalDuration );
       if ( signalDuration > 0 )	// only need to do sth if transient-window had finite overlap with output TS
@@ -386,6 +413,23 @@ XLALCWMakeFakeData ( SFTVector **SFTvect,
         {
           (*SFTvect) = sftVect;
         }
+
+      // add non-transient signals in the SFT domain, if requested
+      if ( sftDomain )
+        {
+          PulsarParamsVector XLAL_INIT_DECL(cwSources);
+          XLAL_CHECK ( (cwSources.data = XLALCalloc ( numPulsars > 0 ? numPulsars : 1, sizeof(cwSources.data[0]) )) != NULL, XLAL_ENOMEM );
+          for ( UINT4 iInj = 0; iInj < numPulsars; iInj ++ )
+            {
+              if ( injectionSources->data[iInj].Transient.type == TRANSIENT_NONE ) {
+                cwSources.data[cwSources.length++] = injectionSources->data[iInj];
+              }
+            }
+          if ( cwSources.length > 0 ) {
+            XLAL_CHECK ( XLALCWAddSignalsToSFTs ( (*SFTvect), &cwSources, site, edat, dataParams->SFTDomainDterms, dataParams->numThreads ) == XLAL_SUCCESS, XLAL_EFUNC );
+          }
+          XLALFree ( cwSources.data );
+        }
     } // if SFTvect
 
   // return timeseries if requested
@@ -400,6 +444,272 @@ XLALCWMakeFakeData ( SFTVector **SFTvect,
 } // XLALCWMakeFakeData()
 
 
+/**
+ * Add CW signals directly to a vector of SFTs, without generating their time series.
+ *
+ * Each SFT is divided into sub-segments no longer than SFT_DOMAIN_MAX_SEGMENT=240s;
+ * the antenna-pattern functions, SSB timing and signal phase are computed at the
+ * mid-point of each sub-segment, and the phase is treated as linear within it.
+ * The contribution of each sub-segment is then a Dirichlet kernel, which is
+ * written only into the \a Dterms bins either side of the signal frequency;
+ * all other bins of the SFT are left untouched.
+ *
+ * The signal model is the same as that of the F-statistic, namely
+ * \f$h(t) = \sum_\mu A^\mu h_\mu(t)\f$ with the amplitudes \f$A^\mu\f$ given by
+ * XLALAmplitudeParams2Vect(), and the SFT normalization is that of
+ * XLALMakeSFTsFromREAL8TimeSeries() with a rectangular window.
+ * For \f$T_{\mathrm{SFT}}=1800\f$s, the bins within \f$\pm\f$\a Dterms of the signal
+ * frequency agree with a direct evaluation of the signal model to about \f$2\times10^{-3}\f$
+ * in relative amplitude, for frequencies up to a few kHz. The time-domain signals generated
+ * by XLALCWMakeFakeData() interpolate the SSB delay over 800s intervals, with an error of a
+ * few microseconds, so that the difference to SFTs of these signals grows with frequency
+ * to about 0.5% at 300Hz and 1.5% at 1kHz. The bins outside of \f$\pm\f$\a Dterms, which
+ * are not written, would contain a fraction of about \f$1/(\pi^2 D_{\mathrm{terms}})\f$
+ * of the signal power in the SFT, i.e. 1.3% for \a Dterms=8, and 0.3% for \a Dterms=32.
+ *
+ * Signals are processed in blocks, which are distributed over \a numThreads
+ * OpenMP threads (0 = OpenMP default); signals are added to each SFT in the order
+ * in which they are given, so that the result does not depend on the number of threads.
+ *
+ * Transient signals are not supported, and must be generated in the time domain.
+ */
+int
+XLALCWAddSignalsToSFTs ( SFTVector *SFTvect,				///< [in/out] SFTs to add signals to
+                         const PulsarParamsVector *injectionSources,	///< [in] CW signals to add
+                         const LALDetector *site,			///< [in] detector the SFTs belong to
+                         const EphemerisData *edat,			///< [in] ephemeris data
+                         UINT4 Dterms,					///< [in] number of bins either side of the signal frequency to write into
+                         UINT4 numThreads				///< [in] number of threads to use, if OpenMP is enabled
+                         )
+{
+  XLAL_CHECK ( SFTvect != NULL && SFTvect->length > 0, XLAL_EINVAL, "Invalid NULL or zero-length input 'SFTvect'\n" );
+  XLAL_CHECK ( injectionSources != NULL, XLAL_EINVAL, "Invalid NULL input 'injectionSources'\n" );
+  XLAL_CHECK ( site != NULL, XLAL_EINVAL, "Invalid NULL input 'site'\n" );
+  XLAL_CHECK ( edat != NULL, XLAL_EINVAL, "Invalid NULL input 'edat'\n" );
+  XLAL_CHECK ( Dterms > 0, XLAL_EINVAL, "Dterms must be > 0\n" );
+
+  const UINT4 numSFTs = SFTvect->length;
+  const UINT4 numBins = SFTvect->data[0].data->length;
+  const REAL8 f0 = SFTvect->data[0].f0;
+  const REAL8 dFreq = SFTvect->data[0].deltaF;
+  const REAL8 Tsft = 1.0 / dFreq;
+  for ( UINT4 alpha = 0; alpha < numSFTs; alpha ++ )
+    {
+      const SFTtype *sft = &SFTvect->data[alpha];
+      XLAL_CHECK ( sft->data->length == numBins && sft->f0 == f0 && sft->deltaF == dFreq, XLAL_EINVAL,
+                   "SFT %d has inconsistent frequency bins\n", alpha );
+    }
+  const UINT4 numSignals = injectionSources->length;
+  for ( UINT4 iInj = 0; iInj < numSignals; iInj ++ )
+    {
+      XLAL_CHECK ( injectionSources->data[iInj].Transient.type == TRANSIENT_NONE, XLAL_EINVAL,
+                   "Injection signal %d:'%s' is transient, which is not supported in the SFT domain\n", iInj, injectionSources->data[iInj].name );
+    }
+  if ( numSignals == 0 ) {
+    return XLAL_SUCCESS;
+  }
+
+#ifdef _OPENMP
+  if ( numThreads == 0 ) {
+    numThreads = omp_get_max_threads();
+  }
+#else
+  (void) numThreads;
+  numThreads = 1;
+#endif
+
+  int retn = XLAL_FAILURE;
+  LIGOTimeGPSVector *segTimes = NULL;
+  DetectorStateSeries *detStates = NULL;
+  MultiSSBtimesBatch *ssbBatch = NULL;
+  COMPLEX16 *segStep = NULL;
+  REAL8 *kappa = NULL;
+  COMPLEX16 *prefac = NULL;
+
+  // split each SFT into sub-segments, and get detector states and sky-independent SSB quantities at their mid-points
+  const UINT4 numSegments = (UINT4) ceil ( Tsft / SFT_DOMAIN_MAX_SEGMENT );
+  const REAL8 Tseg = Tsft / numSegments;
+  const UINT4 numPoints = numSFTs * numSegments;
+  XLAL_CHECK_FAIL ( (segTimes = XLALCreateTimestampVector ( numPoints )) != NULL, XLAL_EFUNC );
+  segTimes->deltaT = Tseg;
+  for ( UINT4 alpha = 0; alpha < numSFTs; alpha ++ )
+    {
+      for ( UINT4 j = 0; j < numSegments; j ++ )
+        {
+          segTimes->data[alpha * numSegments + j] = SFTvect->data[alpha].epoch;
+          XLALGPSAdd ( &segTimes->data[alpha * numSegments + j], (j + 0.5) * Tseg );
+        }
+    }
+  XLAL_CHECK_FAIL ( (detStates = XLALGetDetectorStates ( segTimes, site, edat, 0 )) != NULL, XLAL_EFUNC );
+  MultiDetectorStateSeries multiDetStates = { .length = 1, .data = &detStates };
+  XLAL_CHECK_FAIL ( (ssbBatch = XLALCreateMultiSSBtimesBatch ( &multiDetStates )) != NULL, XLAL_EFUNC );
+
+  // rotations of the Dirichlet-kernel phase factors from one bin to the next
+  const REAL8 cosStep = cos ( LAL_PI / numSegments );
+  const REAL8 sinStep = sin ( LAL_PI / numSegments );
+  XLAL_CHECK_FAIL ( (segStep = XLALCalloc ( numSegments, sizeof(segStep[0]) )) != NULL, XLAL_ENOMEM );
+  for ( UINT4 j = 0; j < numSegments; j ++ ) {
+    segStep[j] = cexp ( - I * LAL_TWOPI * (j + 0.5) / numSegments );
+  }
+
+  // per-signal frequency bin offsets and prefactors of each sub-segment, for one block of signals
+  const UINT4 blockLen = SFT_DOMAIN_BLOCK_PER_THREAD * numThreads;
+  XLAL_CHECK_FAIL ( (kappa = XLALCalloc ( (size_t)blockLen * numPoints, sizeof(kappa[0]) )) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK_FAIL ( (prefac = XLALCalloc ( (size_t)blockLen * numPoints, sizeof(prefac[0]) )) != NULL, XLAL_ENOMEM );
+
+  for ( UINT4 iStart = 0; iStart < numSignals; iStart += blockLen )
+    {
+      const UINT4 numBlock = ( numSignals - iStart < blockLen ) ? ( numSignals - iStart ) : blockLen;
+
+      // compute sub-segment parameters of each signal in this block
+      int errnum = 0;
+#pragma omp parallel for schedule(dynamic) num_threads(numThreads)
+      for ( UINT4 s = 0; s < numBlock; s ++ )
+        {
+          if ( CWSignalSegmentParams ( kappa + (size_t)s * numPoints, prefac + (size_t)s * numPoints, &injectionSources->data[iStart + s],
+                                       detStates, ssbBatch, Tsft, f0, numSegments ) != XLAL_SUCCESS ) {
+#pragma omp critical (XLALCWAddSignalsToSFTs)
+            errnum = XLAL_EFUNC;
+          }
+        }
+      XLAL_CHECK_FAIL ( errnum == 0, errnum, "CWSignalSegmentParams() failed\n" );
+
+      // add signals in this block to each SFT, in order
+#pragma omp parallel for schedule(static) num_threads(numThreads)
+      for ( UINT4 alpha = 0; alpha < numSFTs; alpha ++ )
+        {
+          COMPLEX8 *data = SFTvect->data[alpha].data->data;
+          for ( UINT4 s = 0; s < numBlock; s ++ )
+            {
+              const REAL8 *kappa_s = kappa + (size_t)s * numPoints + alpha * numSegments;
+              const COMPLEX16 *prefac_s = prefac + (size_t)s * numPoints + alpha * numSegments;
+
+              // bins to write into, centred on the mean signal frequency over this SFT
+              REAL8 kappaMean = 0;
+              for ( UINT4 j = 0; j < numSegments; j ++ ) {
+                kappaMean += kappa_s[j];
+              }
+              kappaMean /= numSegments;
+              const REAL8 kLo = floor ( kappaMean ) - Dterms + 1;
+              const REAL8 kHi = floor ( kappaMean ) + Dterms;
+              if ( kHi < 0 || kLo > numBins - 1 ) {
+                continue;
+              }
+              const INT4 k1 = ( kLo < 0 ) ? 0 : (INT4) kLo;
+              const INT4 k2 = ( kHi > numBins - 1 ) ? (INT4) numBins - 1 : (INT4) kHi;
+
+              for ( UINT4 j = 0; j < numSegments; j ++ )
+                {
+                  // Dirichlet kernel of this sub-segment: sum over the bins of prefac * exp(-2 pi i k (j + 1/2)/numSegments) * sin(x)/x,
+                  // with x = pi * (kappa - k) / numSegments; the phase factor and sin(x) are advanced from bin to bin by rotation
+                  REAL8 x = LAL_PI * ( kappa_s[j] - k1 ) / numSegments;
+                  REAL8 sinx = sin ( x ), cosx = cos ( x );
+                  REAL8 phase = (REAL8) k1 * (j + 0.5) / numSegments;
+                  phase -= floor ( phase );
+                  COMPLEX16 rot = prefac_s[j] * cexp ( - I * LAL_TWOPI * phase );
+                  for ( INT4 k = k1; k <= k2; k ++ )
+                    {
+                      const REAL8 sinc = ( fabs ( x ) < LAL_REAL4_EPS ) ? 1.0 : ( sinx / x );
+                      data[k] += (COMPLEX8) ( rot * sinc );
+                      rot *= segStep[j];
+                      const REAL8 sinx1 = sinx * cosStep - cosx * sinStep;
+                      cosx = cosx * cosStep + sinx * sinStep;
+                      sinx = sinx1;
+                      x = LAL_PI * ( kappa_s[j] - (k + 1) ) / numSegments;
+                    }
+                } // for j < numSegments
+            } // for s < numBlock
+        } // for alpha < numSFTs
+
+    } // for iStart < numSignals
+
+  retn = XLAL_SUCCESS;
+
+XLAL_FAIL:
+
+  // cleanup
+  XLALFree ( kappa );
+  XLALFree ( prefac );
+  XLALFree ( segStep );
+  XLALDestroyMultiSSBtimesBatch ( ssbBatch );
+  XLALDestroyDetectorStateSeries ( detStates );
+  XLALDestroyTimestampVector ( segTimes );
+
+  return retn;
+
+} // XLALCWAddSignalsToSFTs()
+
+/**
+ * Compute, for one signal, the offset \f$\kappa = (f - f_0) T_{\mathrm{SFT}}\f$ of the signal frequency
+ * from the first SFT bin, and the complex prefactor \f$\frac{1}{2}T_{\mathrm{seg}}(a(A_1 - iA_3) + b(A_2 - iA_4))e^{i(\phi - 2\pi f_0 t)}\f$,
+ * at the mid-point \f$t\f$ (relative to the SFT start) of every sub-segment of every SFT.
+ */
+static int
+CWSignalSegmentParams ( REAL8 *kappa,				///< [out] frequency bin offsets, per SFT and sub-segment
+                        COMPLEX16 *prefac,			///< [out] Dirichlet-kernel prefactors, per SFT and sub-segment
+                        const PulsarParams *pulsarParams,	///< [in] CW signal parameters
+                        const DetectorStateSeries *detStates,	///< [in] detector states at sub-segment mid-points
+                        const MultiSSBtimesBatch *ssbBatch,	///< [in] sky-independent SSB quantities at sub-segment mid-points
+                        REAL8 Tsft,				///< [in] SFT length
+                        REAL8 f0,				///< [in] frequency of the first SFT bin
+                        UINT4 numSegments			///< [in] number of sub-segments per SFT
+                        )
+{
+  const PulsarDopplerParams *doppler = &pulsarParams->Doppler;
+  SkyPosition skypos = { .longitude = doppler->Alpha, .latitude = doppler->Delta, .system = COORDINATESYSTEM_EQUATORIAL };
+
+  // SSB (and binary) timing and antenna-pattern functions at sub-segment mid-points
+  int retn = XLAL_FAILURE;
+  MultiSSBtimes *multiSSB = NULL;
+  AMCoeffs *amcoe = NULL;
+  XLAL_CHECK_FAIL ( XLALGetMultiSSBtimesBatch ( &multiSSB, ssbBatch, skypos, doppler->refTime, 1 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  SSBtimes *tSSB = multiSSB->data[0];
+  if ( doppler->asini > 0 ) {
+    XLAL_CHECK_FAIL ( XLALAddBinaryTimes ( &tSSB, tSSB, doppler ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+  XLAL_CHECK_FAIL ( (amcoe = XLALComputeAMCoeffs ( detStates, skypos )) != NULL, XLAL_EFUNC );
+
+  PulsarAmplitudeVect A_Mu;
+  XLAL_CHECK_FAIL ( XLALAmplitudeParams2Vect ( A_Mu, pulsarParams->Amp ) == XLAL_SUCCESS, XLAL_EFUNC );
+  const COMPLEX16 Aa = 0.5 * ( Tsft / numSegments ) * ( A_Mu[0] - I * A_Mu[2] );
+  const COMPLEX16 Ab = 0.5 * ( Tsft / numSegments ) * ( A_Mu[1] - I * A_Mu[3] );
+
+  const UINT4 numPoints = detStates->length;
+  for ( UINT4 i = 0; i < numPoints; i ++ )
+    {
+      // signal phase (in cycles) and frequency in the source frame, from the spin Taylor series
+      const REAL8 DeltaT = tSSB->DeltaT->data[i];
+      REAL8 phi = 0, freq = 0, Dtk = 1;	// Dtk = DeltaT^k / k!
+      for ( UINT4 k = 0; k < PULSAR_MAX_SPINS; k ++ )
+        {
+          freq += doppler->fkdot[k] * Dtk;
+          Dtk *= DeltaT / (k + 1);
+          phi += doppler->fkdot[k] * Dtk;
+        }
+      freq *= tSSB->Tdot->data[i];
+
+      // remove the phase of the first SFT bin at the mid-point of this sub-segment
+      const REAL8 tMid = ( (i % numSegments) + 0.5 ) * Tsft / numSegments;
+      phi = ( phi - floor ( phi ) ) - f0 * tMid;
+      phi -= floor ( phi );
+
+      kappa[i] = ( freq - f0 ) * Tsft;
+      prefac[i] = ( amcoe->a->data[i] * Aa + amcoe->b->data[i] * Ab ) * cexp ( I * LAL_TWOPI * phi );
+    }
+
+  retn = XLAL_SUCCESS;
+
+XLAL_FAIL:
+
+  // cleanup
+  XLALDestroyMultiSSBtimes ( multiSSB );
+  XLALDestroyAMCoeffs ( amcoe );
+
+  return retn;
+
+} // CWSignalSegmentParams()
+
+
 /**
  * Generate a (heterodyned) REAL4 timeseries of a CW signal for given pulsarParams,
  * site, start-time, duration, and sampling-rate
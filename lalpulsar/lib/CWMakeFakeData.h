@@ -80,6 +80,8 @@ typedef struct tagCWMFDataParams
   UINT4 randSeed;				//!< seed value for random-number generator
   MultiREAL8TimeSeries *inputMultiTS;		//!< [optional] input time-series for signals+noise to be added to
   REAL8 sourceDeltaT;                           //!< [optional] source-frame sampling period. '0' means to use the previous internal defaults
+  UINT4 SFTDomainDterms;			//!< [optional] if >0, add non-transient signals directly to the SFTs, using this many bins either side of the signal frequency; see XLALCWAddSignalsToSFTs(). '0' means to generate all signals in the time domain
+  UINT4 numThreads;				//!< [optional] number of threads used to add signals in the SFT domain. '0' means to use the OpenMP default
 } CWMFDataParams;
 
 // ---------- Global variables ----------
@@ -101,6 +103,8 @@ int XLALCWMakeFakeMultiData ( MultiSFTVector **multiSFTs, MultiREAL8TimeSeries *
 int XLALCWMakeFakeData ( SFTVector **SFTVect, REAL8TimeSeries **Tseries,
                          const PulsarParamsVector *injectionSources, const CWMFDataParams *dataParams, UINT4 detectorIndex, const EphemerisData *edat );
 
+int XLALCWAddSignalsToSFTs ( SFTVector *SFTvect, const PulsarParamsVector *injectionSources, const LALDetector *site, const EphemerisData *edat, UINT4 Dterms, UINT4 numThreads );
+
 REAL4TimeSeries *
 XLALGenerateCWSignalTS ( const PulsarParams *pulsarParams, const LALDetector *site, LIGOTimeGPS startTime, REAL8 duration, REAL8 fSamp, REAL8 fHet, const EphemerisData *edat, REAL8 sourceDeltaT );
 SFTVector *
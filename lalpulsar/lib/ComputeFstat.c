@@ -25,6 +25,10 @@
 #include <math.h>
 #include <gsl/gsl_math.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include "ComputeFstat_internal.h"
 
 #include <lal/LALString.h>
@@ -51,6 +55,8 @@ struct tagFstatInput {
 // ---------- Internal prototypes ---------- //
 
 static int XLALSelectBestFstatMethod ( FstatMethodType *method );
+static int FstatMethodIsDemod ( FstatMethodType method );
+static int FstatMethodIsResamp ( FstatMethodType method );
 
 int XLALSetupFstatDemod  ( void **method_data, FstatCommon *common, FstatMethodFuncs* funcs, MultiSFTVector *multiSFTs, const FstatOptionalArgs *optArgs );
 int XLALSetupFstatResamp ( void **method_data, FstatCommon *common, FstatMethodFuncs* funcs, MultiSFTVector *multiSFTs, const FstatOptionalArgs *optArgs );
@@ -66,6 +72,9 @@ static const char *const FstatMethodNames[FMETHOD_END] = {
 
   [FMETHOD_RESAMP_GENERIC]	= "ResampGeneric",
   [FMETHOD_RESAMP_BEST]		= "ResampBest",
+
+  [FMETHOD_DEMOD_AVX2]		= "DemodAVX2",
+  [FMETHOD_DEMOD_AVX512]	= "DemodAVX512",
 };
 
 const FstatOptionalArgs FstatOptionalArgsDefaults = {
@@ -79,7 +88,10 @@ const FstatOptionalArgs FstatOptionalArgsDefaults = {
   .assumeSqrtSX = NULL,
   .prevInput = NULL,
   .collectTiming = 0,
-  .resampFFTPowerOf2 = 1
+  .resampFFTPowerOf2 = 1,
+  .numThreads = 1,
+  .resampMaxWorkspaceMB = 0,
+  .resampBatchSize = 4
 };
 
 static const char FstatTimingGenericHelp[] =
@@ -89,6 +101,8 @@ static const char FstatTimingGenericHelp[] =
   "%%%% tauF_buffer:    time per detector per frequency bin to re-compute all buffered quantities once\n"
   "%%%% NFbin:          (average over F-stat calls) number of F-stat output frequency bins\n"
   "%%%% Ndet:           number of detectors\n"
+  "%%%% tauSetupNorm:   time to normalize the SFTs and compute the noise weights in XLALCreateFstatInput(),\n"
+  "%%%%                 excluding the time to load the SFTs and to set up the F-stat method\n"
   "%%%%\n"
   "%%%% => generic F-stat timing:\n"
   "%%%% tauF_eff = tauF_core + b * tauF_buffer\n"
@@ -411,6 +425,13 @@ XLALCreateFstatInput ( const SFTCatalog *SFTcatalog,              ///< [in] Cata
     setupFuncMethod = XLALSetupFstatDemod;
     break;
 
+  case FMETHOD_DEMOD_AVX2:		// Demod: AVX2 vectorised generic hotloop
+  case FMETHOD_DEMOD_AVX512:		// Demod: AVX-512 vectorised generic hotloop
+    XLAL_CHECK_NULL ( optArgs.Dterms > 0, XLAL_EINVAL );
+    extraBinsMethod = optArgs.Dterms;
+    setupFuncMethod = XLALSetupFstatDemod;
+    break;
+
   case FMETHOD_RESAMP_GENERIC:		// Resamp: generic implementation
     extraBinsMethod = 8;   // use 8 extra bins to give better agreement with Demod(w Dterms=8) near the boundaries
     setupFuncMethod = XLALSetupFstatResamp;
@@ -466,6 +487,13 @@ XLALCreateFstatInput ( const SFTCatalog *SFTcatalog,              ///< [in] Cata
 
   common->allowedMismatchFromSFTLength = optArgs.allowedMismatchFromSFTLength;
 
+  // Determine the number of threads to use in XLALComputeFstat()
+#ifdef _OPENMP
+  common->numThreads = ( optArgs.numThreads > 0 ) ? optArgs.numThreads : (UINT4) omp_get_max_threads();
+#else
+  common->numThreads = 1;
+#endif
+
   // Compute the mid-time and time-span of the SFTs
   double Tspan = 0;
   {
@@ -567,12 +595,10 @@ XLALCreateFstatInput ( const SFTCatalog *SFTcatalog,              ///< [in] Cata
     XLAL_CHECK_NULL ( multiSFTs->data[X]->length > 1, XLAL_EINVAL, "Need more than 1 SFTs per Detector!\n" );
   }
 
-  // Normalise SFTs using either running median or assumed PSDs
-  MultiPSDVector *runningMedian;
-  XLAL_CHECK_NULL ( (runningMedian = XLALNormalizeMultiSFTVect ( multiSFTs, optArgs.runningMedianWindow, optArgs.assumeSqrtSX )) != NULL, XLAL_EFUNC );
-
-  // Calculate SFT noise weights from PSD
-  XLAL_CHECK_NULL ( (common->multiNoiseWeights = XLALComputeMultiNoiseWeights ( runningMedian, optArgs.runningMedianWindow, 0 )) != NULL, XLAL_EFUNC );
+  // Normalise SFTs using either running median or assumed PSDs, and calculate SFT noise weights from PSD,
+  // in a single pass over the SFTs using the same number of threads as XLALComputeFstat()
+  XLAL_CHECK_NULL ( XLALNormalizeMultiSFTVectAndNoiseWeights ( NULL, &common->multiNoiseWeights, multiSFTs, optArgs.runningMedianWindow, optArgs.assumeSqrtSX, 0,
+                                                               common->numThreads, &common->tauSetupNorm ) == XLAL_SUCCESS, XLAL_EFUNC );
 
   // for use within this modul: remove the normalization from the noise-weights: the normalisation factor is saved separately
   // in the struct, and this allows us to use and extract subsets of the noise-weights without having to re-normalize them
@@ -600,14 +626,15 @@ XLALCreateFstatInput ( const SFTCatalog *SFTcatalog,              ///< [in] Cata
   // - The method input data structures are expected to take ownership of the
   //   SFTs, which is why 'input->common' does not retain a pointer to them
   FstatMethodFuncs *funcs = &input->method_funcs;
-  XLAL_CHECK_NULL( (setupFuncMethod) ( &input->method_data, common, funcs, multiSFTs, &optArgs ) == XLAL_SUCCESS, XLAL_EFUNC );
+  if ( (setupFuncMethod) ( &input->method_data, common, funcs, multiSFTs, &optArgs ) != XLAL_SUCCESS ) {
+    // method setup functions set their destructor functions before any failure can occur after allocating 'method_data'
+    XLALDestroyFstatInput ( input );
+    XLAL_ERROR_NULL ( XLAL_EFUNC );
+  }
 
   // If setup function allocated a workspace, check that it also supplied a destructor function
   XLAL_CHECK_NULL( common->workspace == NULL || funcs->workspace_destroy_func != NULL, XLAL_EFAILED );
 
-  // Cleanup
-  XLALDestroyMultiPSDVector ( runningMedian );
-
   return input;
 
 } // XLALCreateFstatInput()
@@ -722,16 +749,10 @@ XLALGetFstatInputDetectorStates ( const FstatInput* input       ///< [in] \c Fst
 
 } // XLALGetFstatInputDetectorStates()
 
-///
-/// Compute the \f$\mathcal{F}\f$-statistic over a band of frequencies.
-///
-int
-XLALComputeFstat ( FstatResults **Fstats,               ///< [in/out] Address of a pointer to a \c FstatResults results structure; if \c NULL, allocate here.
-                   FstatInput *input,                   ///< [in] Input data structure created by one of the setup functions.
-                   const PulsarDopplerParams *doppler,  ///< [in] Doppler parameters, including starting frequency, at which to compute \f$2\mathcal{F}\f$
-                   const UINT4 numFreqBins,             ///< [in] Number of frequencies at which the \f$2\mathcal{F}\f$ are to be computed. Must be 1 if XLALCreateFstatInput() was passed zero \c dFreq.
-                   const FstatQuantities whatToCompute  ///< [in] Bit-field of which \f$\mathcal{F}\f$-statistic quantities to compute.
-                   )
+// Check input, (re-)allocate results struct as needed, and initialise results struct parameters for a call
+// to the method computation function; the Doppler parameters in the results struct are extrapolated to the SFT mid-time
+static int
+XLALPrepareFstatResults ( FstatResults **Fstats, FstatInput *input, const PulsarDopplerParams *doppler, const UINT4 numFreqBins, const FstatQuantities whatToCompute )
 {
   // Check input
   XLAL_CHECK ( Fstats != NULL, XLAL_EINVAL);
@@ -841,17 +862,90 @@ XLALComputeFstat ( FstatResults **Fstats,               ///< [in/out] Address of
   }
   (*Fstats)->whatWasComputed = whatToCompute;
 
+  return XLAL_SUCCESS;
+
+} // XLALPrepareFstatResults()
+
+///
+/// Compute the \f$\mathcal{F}\f$-statistic over a band of frequencies.
+///
+int
+XLALComputeFstat ( FstatResults **Fstats,               ///< [in/out] Address of a pointer to a \c FstatResults results structure; if \c NULL, allocate here.
+                   FstatInput *input,                   ///< [in] Input data structure created by one of the setup functions.
+                   const PulsarDopplerParams *doppler,  ///< [in] Doppler parameters, including starting frequency, at which to compute \f$2\mathcal{F}\f$
+                   const UINT4 numFreqBins,             ///< [in] Number of frequencies at which the \f$2\mathcal{F}\f$ are to be computed. Must be 1 if XLALCreateFstatInput() was passed zero \c dFreq.
+                   const FstatQuantities whatToCompute  ///< [in] Bit-field of which \f$\mathcal{F}\f$-statistic quantities to compute.
+                   )
+{
+  XLAL_CHECK ( XLALPrepareFstatResults ( Fstats, input, doppler, numFreqBins, whatToCompute ) == XLAL_SUCCESS, XLAL_EFUNC );
+
   // Call the appropriate method function to compute the F-statistic
-  XLAL_CHECK ( (input->method_funcs.compute_func) ( *Fstats, common, input->method_data ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK ( (input->method_funcs.compute_func) ( *Fstats, &input->common, input->method_data ) == XLAL_SUCCESS, XLAL_EFUNC );
 
   (*Fstats)->doppler = (*doppler);
   // Record the internal reference time used, which is required to compute a correct global signal phase
-  (*Fstats)->refTimePhase = midDoppler.refTime;
+  (*Fstats)->refTimePhase = input->common.midTime;
 
   return XLAL_SUCCESS;
 
 } // XLALComputeFstat()
 
+///
+/// Compute the \f$\mathcal{F}\f$-statistic over a band of frequencies, for a batch of Doppler templates.
+///
+/// The results are the same as calling XLALComputeFstat() for each template in turn, but some methods compute a batch
+/// of templates more efficiently: \a Resamp re-uses the barycentred timeseries between consecutive templates with the same sky
+/// position and binary parameters, and computes the FFTs of up to \c FstatOptionalArgs.resampBatchSize such templates together.
+/// Templates should therefore be ordered with the spindowns varying fastest.
+///
+/// Templates at different sky positions are not batched together, even neighbouring ones: each sky position needs its own
+/// SSB times, barycentred timeseries and antenna-pattern matrix, so only the FFT itself could be shared, and batching it
+/// would require buffering all of these per template.
+///
+int
+XLALComputeFstatBatch ( FstatResults **Fstats,			///< [in/out] Array of \c numTemplates pointers to \c FstatResults results structures; any \c NULL are allocated here.
+                        FstatInput *input,			///< [in] Input data structure created by one of the setup functions.
+                        const PulsarDopplerParams *dopplers,	///< [in] Array of \c numTemplates Doppler parameters, including starting frequencies, at which to compute \f$2\mathcal{F}\f$
+                        const UINT4 numTemplates,		///< [in] Number of templates
+                        const UINT4 numFreqBins,		///< [in] Number of frequencies at which the \f$2\mathcal{F}\f$ are to be computed, for each template.
+                        const FstatQuantities whatToCompute	///< [in] Bit-field of which \f$\mathcal{F}\f$-statistic quantities to compute.
+                        )
+{
+  // Check input
+  XLAL_CHECK ( Fstats != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( input != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( dopplers != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( numTemplates > 0, XLAL_EINVAL );
+
+  for ( UINT4 i = 0; i < numTemplates; ++i )
+    {
+      XLAL_CHECK ( XLALPrepareFstatResults ( &Fstats[i], input, &dopplers[i], numFreqBins, whatToCompute ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+
+  // Call the appropriate method function to compute the F-statistic, for all templates at once if supported
+  if ( input->method_funcs.compute_batch_func != NULL )
+    {
+      XLAL_CHECK ( (input->method_funcs.compute_batch_func) ( Fstats, numTemplates, &input->common, input->method_data ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+  else
+    {
+      for ( UINT4 i = 0; i < numTemplates; ++i )
+        {
+          XLAL_CHECK ( (input->method_funcs.compute_func) ( Fstats[i], &input->common, input->method_data ) == XLAL_SUCCESS, XLAL_EFUNC );
+        }
+    }
+
+  for ( UINT4 i = 0; i < numTemplates; ++i )
+    {
+      Fstats[i]->doppler = dopplers[i];
+      // Record the internal reference time used, which is required to compute a correct global signal phase
+      Fstats[i]->refTimePhase = input->common.midTime;
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALComputeFstatBatch()
+
 ///
 /// Free all memory associated with a \c FstatInput structure.
 ///
@@ -864,7 +958,7 @@ XLALDestroyFstatInput ( FstatInput* input       ///< [in] \c FstatInput structur
   }
   if ( input->common.isTimeslice )
     {
-      XLAL_CHECK_VOID ( input->method < FMETHOD_RESAMP_GENERIC, XLAL_EINVAL,
+      XLAL_CHECK_VOID ( FstatMethodIsDemod ( input->method ), XLAL_EINVAL,
                         "Something is wrong: 'isTimeslice==TRUE' for non-LALDemod F-stat method '%s' is not supported!\n", XLALGetFstatInputMethodName(input));
       XLALDestroyFstatInputTimeslice_common ( &input->common );
       XLALDestroyFstatInputTimeslice_Demod ( input->method_data);
@@ -876,6 +970,11 @@ XLALDestroyFstatInput ( FstatInput* input       ///< [in] \c FstatInput structur
   XLALDestroyMultiNoiseWeights ( input->common.multiNoiseWeights );
   XLALDestroyMultiDetectorStateSeries ( input->common.multiDetectorStates );
 
+  if ( input->method_data != NULL ) {
+    // Free method-specific data using destructor function; this may release resources held in the shared workspace
+    (input->method_funcs.method_data_destroy_func) ( input->method_data );
+  }
+
   // Release a reference to 'common.workspace'; if there are no more outstanding references ...
   if ( --(*input->workspace_refcount) == 0 ) {
     XLALPrintInfo( "%s: workspace reference count = %i, freeing workspace\n", __func__, *input->workspace_refcount );
@@ -892,11 +991,6 @@ XLALDestroyFstatInput ( FstatInput* input       ///< [in] \c FstatInput structur
     XLALPrintInfo( "%s: workspace reference count = %i\n", __func__, *input->workspace_refcount );
   }
 
-  if ( input->method_data != NULL ) {
-    // Free method-specific data using destructor function
-    (input->method_funcs.method_data_destroy_func) ( input->method_data );
-  }
-
   XLALFree ( input );
 
   return;
@@ -1073,6 +1167,7 @@ XLALSelectBestFstatMethod ( FstatMethodType *method )
     //     FMETHOD_..._OPTIMISED,    (always avaiable)
     //     FMETHOD_..._SUPERFAST     (not always available; requires special hardware)
     //     FMETHOD_..._BEST          (must **always** avaiable)
+    //   Methods appended after FMETHOD_RESAMP_BEST (e.g. FMETHOD_DEMOD_AVX2) are never selected this way.
     XLALPrintInfo( "%s: trying to find best available Fstat method for '%s'\n", __func__, FstatMethodNames[*method] );
     while ( !XLALFstatMethodIsAvailable( --( *method ) ) ) {
       XLAL_CHECK ( FMETHOD_START < *method, XLAL_EFAILED );
@@ -1090,6 +1185,41 @@ XLALSelectBestFstatMethod ( FstatMethodType *method )
   return XLAL_SUCCESS;
 }
 
+///
+/// Return true if given \c FstatMethodType belongs to the \a Demod class of methods
+///
+static int
+FstatMethodIsDemod ( FstatMethodType method )
+{
+  switch ( method ) {
+  case FMETHOD_DEMOD_GENERIC:
+  case FMETHOD_DEMOD_OPTC:
+  case FMETHOD_DEMOD_ALTIVEC:
+  case FMETHOD_DEMOD_SSE:
+  case FMETHOD_DEMOD_AVX2:
+  case FMETHOD_DEMOD_AVX512:
+  case FMETHOD_DEMOD_BEST:
+    return 1;
+  default:
+    return 0;
+  }
+}
+
+///
+/// Return true if given \c FstatMethodType belongs to the \a Resamp class of methods
+///
+static int
+FstatMethodIsResamp ( FstatMethodType method )
+{
+  switch ( method ) {
+  case FMETHOD_RESAMP_GENERIC:
+  case FMETHOD_RESAMP_BEST:
+    return 1;
+  default:
+    return 0;
+  }
+}
+
 ///
 /// Return true if given \c FstatMethodType corresponds to a valid and *available* Fstat method, false otherwise
 ///
@@ -1126,6 +1256,24 @@ XLALFstatMethodIsAvailable ( FstatMethodType method )
     return 0;
 #endif
 
+  case FMETHOD_DEMOD_AVX2:
+    // This method is available only if compiled with AVX2 support,
+    // and AVX2 is available on the current execution machine
+#ifdef HAVE_AVX2_COMPILER
+    return LAL_HAVE_AVX2_RUNTIME();
+#else
+    return 0;
+#endif
+
+  case FMETHOD_DEMOD_AVX512:
+    // This method is available only if compiled with AVX-512 support,
+    // and AVX-512 is available on the current execution machine
+#ifdef HAVE_AVX512F_COMPILER
+    return LAL_HAVE_AVX512F_RUNTIME();
+#else
+    return 0;
+#endif
+
   default:
     return 0;
 
@@ -1199,11 +1347,11 @@ XLALGetFstatTiming ( const FstatInput* input, FstatTimingGeneric *timingGeneric,
   XLAL_CHECK ( timingGeneric != NULL, XLAL_EINVAL );
   XLAL_CHECK ( timingModel != NULL, XLAL_EINVAL );
 
-  if ( input->method >= FMETHOD_DEMOD_GENERIC && input->method <= FMETHOD_DEMOD_BEST)
+  if ( FstatMethodIsDemod ( input->method ) )
     {
       XLAL_CHECK ( XLALGetFstatTiming_Demod ( input->method_data, timingGeneric, timingModel ) == XLAL_SUCCESS, XLAL_EFUNC );
     }
-  else if ( input->method >= FMETHOD_RESAMP_GENERIC && input->method <= FMETHOD_RESAMP_BEST)
+  else if ( FstatMethodIsResamp ( input->method ) )
     {
       XLAL_CHECK ( XLALGetFstatTiming_Resamp ( input->method_data, timingGeneric, timingModel ) == XLAL_SUCCESS, XLAL_EFUNC );
     }
@@ -1212,6 +1360,7 @@ XLALGetFstatTiming ( const FstatInput* input, FstatTimingGeneric *timingGeneric,
       XLAL_ERROR ( XLAL_EINVAL, "Unsupported F-stat method '%s'\n", FstatMethodNames [ input->method ] );
     }
 
+  timingGeneric->tauSetupNorm = input->common.tauSetupNorm;
   timingGeneric->help = FstatTimingGenericHelp;	// set static help-string pointer (not used or set otherwise)
 
   return XLAL_SUCCESS;
@@ -1233,7 +1382,7 @@ XLALAppendFstatTiming2File ( const FstatInput* input, FILE *fp, BOOLEAN printHea
       fprintf ( fp, "%s\n", tiGen.help );
       fprintf ( fp, "%s\n", tiModel.help );
       // generic F-stat timing header line
-      fprintf ( fp, "%%%%%8s %10s %4s %10s %10s %11s %10s ", "NCalls", "NFbin", "Ndet", "tauF_eff", "tauF_core", "tauF_buffer", "b");
+      fprintf ( fp, "%%%%%8s %10s %4s %10s %10s %11s %10s %12s ", "NCalls", "NFbin", "Ndet", "tauF_eff", "tauF_core", "tauF_buffer", "b", "tauSetupNorm");
       // method-specific F-stat timing model header line
       fprintf (fp, "|");
       for ( UINT4 i = 0; i < tiModel.numVariables; i ++ ) {
@@ -1243,8 +1392,8 @@ XLALAppendFstatTiming2File ( const FstatInput* input, FILE *fp, BOOLEAN printHea
     } // if (printHeader)
 
   // generic F-stat timing values
-  fprintf (fp, "%10.0f %10d %4d %10.2e %10.2e %11.2e %10.2e ",
-           tiGen.NCalls, tiGen.NFbin, tiGen.Ndet, tiGen.tauF_eff, tiGen.tauF_core, tiGen.tauF_buffer, tiGen.NBufferMisses/tiGen.NCalls );
+  fprintf (fp, "%10.0f %10d %4d %10.2e %10.2e %11.2e %10.2e %12.2e ",
+           tiGen.NCalls, tiGen.NFbin, tiGen.Ndet, tiGen.tauF_eff, tiGen.tauF_core, tiGen.tauF_buffer, tiGen.NBufferMisses/tiGen.NCalls, tiGen.tauSetupNorm );
 
   // method-specific F-stat timing model values
   fprintf (fp, " "); // for '|'
@@ -1272,7 +1421,7 @@ XLALExtractResampledTimeseries ( MultiCOMPLEX8TimeSeries **multiTimeSeries_SRC_a
 {
   XLAL_CHECK ( input != NULL, XLAL_EINVAL );
   XLAL_CHECK ( ( multiTimeSeries_SRC_a != NULL ) && ( multiTimeSeries_SRC_b != NULL ) , XLAL_EINVAL );
-  XLAL_CHECK ( (input->method >= FMETHOD_RESAMP_GENERIC) && (input->method <= FMETHOD_RESAMP_BEST), XLAL_EINVAL,
+  XLAL_CHECK ( FstatMethodIsResamp ( input->method ), XLAL_EINVAL,
                "%s() only works for resampling-Fstat methods, not with '%s'\n", __func__, XLALGetFstatInputMethodName ( input ) );
 
   XLAL_CHECK ( XLALExtractResampledTimeseries_intern ( multiTimeSeries_SRC_a, multiTimeSeries_SRC_b, input->method_data ) == XLAL_SUCCESS, XLAL_EFUNC );
@@ -1306,7 +1455,7 @@ XLALFstatInputTimeslice ( FstatInput ** slice,                ///< [out] Address
               LAL_GPS_PRINT(*minStartGPS), LAL_GPS_PRINT(*maxStartGPS) );
 
   // only supported for 'LALDemod' Fstat methods
-  XLAL_CHECK ( input->method < FMETHOD_RESAMP_GENERIC, XLAL_EINVAL, "This function is not avavible for the chosen FstatMethod '%s'!", XLALGetFstatInputMethodName ( input ) );
+  XLAL_CHECK ( FstatMethodIsDemod ( input->method ), XLAL_EINVAL, "This function is not avavible for the chosen FstatMethod '%s'!", XLALGetFstatInputMethodName ( input ) );
 
   const FstatCommon *common = &(input->common);
   UINT4 numIFOs = common->detectors.length;
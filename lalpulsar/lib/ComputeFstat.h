@@ -121,6 +121,9 @@ typedef enum tagFstatMethodType {
   FMETHOD_RESAMP_GENERIC,	///< \a Resamp: generic implementation
   FMETHOD_RESAMP_BEST,		///< \a Resamp: best guess of the fastest available implementation
 
+  FMETHOD_DEMOD_AVX2,		///< \a Demod: AVX2 vectorised generic hotloop, works for any number of Dirichlet kernel terms \f$\text{Dterms}\f$; never selected by \a DemodBest
+  FMETHOD_DEMOD_AVX512,		///< \a Demod: AVX-512 vectorised generic hotloop, works for any number of Dirichlet kernel terms \f$\text{Dterms}\f$; never selected by \a DemodBest
+
   /// \cond DONT_DOXYGEN
   FMETHOD_END
   /// \endcond
@@ -144,6 +147,13 @@ typedef struct tagFstatOptionalArgs {
   BOOLEAN collectTiming;		///< a flag to turn on/off the collection of F-stat-method-specific timing-data
   BOOLEAN resampFFTPowerOf2;		///< \a Resamp: round up FFT lengths to next power of 2; see \c FstatMethodType.
   REAL8 allowedMismatchFromSFTLength;      ///<  Optional override for XLALFstatCheckSFTLengthMismatch().
+  UINT4 numThreads;			///< Number of threads used by XLALComputeFstat(): \a Demod splits frequency bins, \a Resamp splits detectors, between threads.
+					///< 1 = serial; 0 = OpenMP default number of threads. Results are identical to the serial ones. Requires OpenMP; \a Resamp is serial if \c collectTiming is set.
+  REAL8 resampMaxWorkspaceMB;		///< \a Resamp: memory budget in MB for the workspace (buffers and pool of FFT plans keyed by FFT length) shared between
+					///< \c FstatInput structures via \c prevInput; the budget of the \c FstatInput which creates the workspace applies.
+					///< Unused FFT plans are freed, and batches of XLALComputeFstatBatch() are shrunk, to stay within budget;
+					///< XLALCreateFstatInput() fails with \c XLAL_ENOMEM if the budget cannot be met. 0 = unlimited.
+  UINT4 resampBatchSize;		///< \a Resamp: maximal number of templates whose FFTs are computed together by XLALComputeFstatBatch().
 } FstatOptionalArgs;
 
 ///
@@ -303,6 +313,7 @@ typedef struct tagFstatTimingGeneric
   UINT4 Ndet;		//< number of detectors
   REAL4 NCalls;		//< number of F-stat calls we average over
   REAL4 NBufferMisses;	//< number of times the buffer needed to be recomputed
+  REAL4 tauSetupNorm;	//< time to normalize the SFTs and compute the noise weights in XLALCreateFstatInput(), excluding loading SFTs and method setup
   const char *help;	//< (static) string documenting the generic F-stat timing values
 } FstatTimingGeneric;
 
@@ -358,6 +369,10 @@ SWIGLAL(INOUT_STRUCTS(FstatResults**, Fstats));
 #endif
 int XLALComputeFstat ( FstatResults **Fstats, FstatInput *input, const PulsarDopplerParams *doppler,
                        const UINT4 numFreqBins, const FstatQuantities whatToCompute );
+#ifndef SWIG // exclude from SWIG interface; array of FstatResults pointers
+int XLALComputeFstatBatch ( FstatResults **Fstats, FstatInput *input, const PulsarDopplerParams *dopplers, const UINT4 numTemplates,
+                            const UINT4 numFreqBins, const FstatQuantities whatToCompute );
+#endif
 
 void XLALDestroyFstatInput ( FstatInput* input );
 void XLALDestroyFstatResults ( FstatResults* Fstats );
@@ -104,7 +104,123 @@ int XLALComputeFaFb_SSE     ( COMPLEX8 *Fa, COMPLEX8 *Fb, FstatAtomVector **Fsta
                               const PulsarSpins fkdot, const SSBtimes *tSSB, const AMCoeffs *amcoe, const UINT4 Dterms );
 #endif
 
+#ifdef HAVE_AVX2_COMPILER
+int XLALComputeFaFb_AVX2    ( COMPLEX8 *Fa, COMPLEX8 *Fb, FstatAtomVector **FstatAtoms, const SFTVector *sfts,
+                              const PulsarSpins fkdot, const SSBtimes *tSSB, const AMCoeffs *amcoe, const UINT4 Dterms );
+#endif
+
+#ifdef HAVE_AVX512F_COMPILER
+int XLALComputeFaFb_AVX512  ( COMPLEX8 *Fa, COMPLEX8 *Fb, FstatAtomVector **FstatAtoms, const SFTVector *sfts,
+                              const PulsarSpins fkdot, const SSBtimes *tSSB, const AMCoeffs *amcoe, const UINT4 Dterms );
+#endif
+
 // ----- local function definitions ----------
+///
+/// Compute the F-statistic quantities requested in \a Fstats for the single frequency bin \a k
+///
+static int
+XLALComputeFstatDemodFreqBin ( FstatResults* Fstats,
+                               const UINT4 k,
+                               const DemodMethodData *demod,
+                               const MultiSSBtimes *multiSSBTotal,
+                               const MultiAMCoeffs *multiAMcoef
+                               )
+{
+  const FstatQuantities whatToCompute = Fstats->whatWasComputed;
+  BOOLEAN returnAtoms = (whatToCompute & FSTATQ_ATOMS_PER_DET);
+  const MultiSFTVector *multiSFTs = demod->multiSFTs;
+  UINT4 numDetectors = multiSFTs->length;
+
+  REAL4 Ad = multiAMcoef->Mmunu.Ad;
+  REAL4 Bd = multiAMcoef->Mmunu.Bd;
+  REAL4 Cd = multiAMcoef->Mmunu.Cd;
+  REAL4 Ed = multiAMcoef->Mmunu.Ed;
+  REAL4 Dd_inv = 1.0 / multiAMcoef->Mmunu.Dd;
+
+  // Set frequency to search at
+  PulsarDopplerParams thisPoint = Fstats->doppler;
+  thisPoint.fkdot[0] += k * Fstats->dFreq;
+
+  COMPLEX8 Fa = 0;       		// complex amplitude Fa
+  COMPLEX8 Fb = 0;                 // complex amplitude Fb
+  MultiFstatAtomVector *multiFstatAtoms = NULL;	// per-IFO, per-SFT arrays of F-stat 'atoms', ie quantities required to compute F-stat
+
+  // prepare return of 'FstatAtoms' if requested
+  if ( returnAtoms )
+    {
+      XLAL_CHECK ( (multiFstatAtoms = XLALMalloc ( sizeof(*multiFstatAtoms) )) != NULL, XLAL_ENOMEM );
+      multiFstatAtoms->length = numDetectors;
+      XLAL_CHECK ( (multiFstatAtoms->data = XLALMalloc ( numDetectors * sizeof(*multiFstatAtoms->data) )) != NULL, XLAL_ENOMEM );
+    } // if returnAtoms
+
+  // loop over detectors and compute all detector-specific quantities
+  for ( UINT4 X=0; X < numDetectors; X ++)
+    {
+      COMPLEX8 FaX, FbX;
+      FstatAtomVector *FstatAtoms = NULL;
+      FstatAtomVector **FstatAtoms_p = returnAtoms ? (&FstatAtoms) : NULL;
+
+      // call XLALComputeFaFb_...() function for the user-requested hotloop variant
+      XLAL_CHECK ( (demod->computefafb_func) ( &FaX, &FbX, FstatAtoms_p, multiSFTs->data[X], thisPoint.fkdot,
+                                               multiSSBTotal->data[X], multiAMcoef->data[X], demod->Dterms ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+      if ( returnAtoms ) {
+        multiFstatAtoms->data[X] = FstatAtoms;     // copy pointer to IFO-specific Fstat-atoms 'contents'
+      }
+
+      XLAL_CHECK ( isfinite(creal(FaX)) && isfinite(cimag(FaX)) && isfinite(creal(FbX)) && isfinite(cimag(FbX)), XLAL_EFPOVRFLW );
+
+      if ( whatToCompute & FSTATQ_FAFB_PER_DET )
+        {
+          Fstats->FaPerDet[X][k] = FaX;
+          Fstats->FbPerDet[X][k] = FbX;
+        }
+
+      // compute single-IFO F-stats, if requested
+      if ( whatToCompute & FSTATQ_2F_PER_DET )
+        {
+          REAL4 AdX = multiAMcoef->data[X]->A;
+          REAL4 BdX = multiAMcoef->data[X]->B;
+          REAL4 CdX = multiAMcoef->data[X]->C;
+          REAL4 EdX = 0;
+          REAL4 DdX_inv = 1.0 / multiAMcoef->data[X]->D;
+
+          // compute final single-IFO F-stat
+          Fstats->twoFPerDet[X][k] = compute_fstat_from_fa_fb ( FaX, FbX, AdX, BdX, CdX, EdX, DdX_inv );
+
+        } // if FSTATQ_2F_PER_DET
+
+      /* Fa = sum_X Fa_X */
+      Fa += FaX;
+
+      /* Fb = sum_X Fb_X */
+      Fb += FbX;
+
+    } // for  X < numDetectors
+
+  if ( whatToCompute & FSTATQ_2F )
+    {
+      Fstats->twoF[k] = compute_fstat_from_fa_fb ( Fa, Fb, Ad, Bd, Cd, Ed, Dd_inv );
+    }
+
+  // Return multi-detector Fa & Fb
+  if ( whatToCompute & FSTATQ_FAFB )
+    {
+      Fstats->Fa[k] = Fa;
+      Fstats->Fb[k] = Fb;
+    }
+
+  // Return F-atoms per detector
+  if ( whatToCompute & FSTATQ_ATOMS_PER_DET )
+    {
+      XLALDestroyMultiFstatAtomVector ( Fstats->multiFatoms[k] );
+      Fstats->multiFatoms[k] = multiFstatAtoms;
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALComputeFstatDemodFreqBin()
+
 static int
 XLALComputeFstatDemod ( FstatResults* Fstats,
                         const FstatCommon *common,
@@ -123,13 +239,8 @@ XLALComputeFstatDemod ( FstatResults* Fstats,
   REAL8 Tau_buffer = 0;
   REAL8 tic = 0, toc = 0;
 
-  // Get which F-statistic quantities to compute
-  const FstatQuantities whatToCompute = Fstats->whatWasComputed;
-
   // handy shortcuts
-  BOOLEAN returnAtoms = (whatToCompute & FSTATQ_ATOMS_PER_DET);
   PulsarDopplerParams thisPoint = Fstats->doppler;
-  const REAL8 fStart = thisPoint.fkdot[0];
   const MultiSFTVector *multiSFTs = demod->multiSFTs;
   const MultiNoiseWeights *multiWeights = common->multiNoiseWeights;
   const MultiDetectorStateSeries *multiDetStates = common->multiDetectorStates;
@@ -196,96 +307,19 @@ XLALComputeFstatDemod ( FstatResults* Fstats,
       multiSSBTotal = multiSSB;
     }
 
-  // ----- compute final Fstatistic-value -----
-  REAL4 Ad = multiAMcoef->Mmunu.Ad;
-  REAL4 Bd = multiAMcoef->Mmunu.Bd;
-  REAL4 Cd = multiAMcoef->Mmunu.Cd;
-  REAL4 Ed = multiAMcoef->Mmunu.Ed;;
-  REAL4 Dd_inv = 1.0 / multiAMcoef->Mmunu.Dd;
-
   // ---------- Compute F-stat for each frequency bin ----------
-  for ( UINT4 k = 0; k < Fstats->numFreqBins; k++ )
+  // frequency bins are independent, and are optionally computed in parallel
+  int errnum = 0;
+#pragma omp parallel for schedule(static) num_threads(common->numThreads) if(common->numThreads > 1)
+  for ( INT4 k = 0; k < (INT4)Fstats->numFreqBins; k++ )
     {
-      // Set frequency to search at
-      thisPoint.fkdot[0] = fStart + k * Fstats->dFreq;
-
-      COMPLEX8 Fa = 0;       		// complex amplitude Fa
-      COMPLEX8 Fb = 0;                 // complex amplitude Fb
-      MultiFstatAtomVector *multiFstatAtoms = NULL;	// per-IFO, per-SFT arrays of F-stat 'atoms', ie quantities required to compute F-stat
-
-      // prepare return of 'FstatAtoms' if requested
-      if ( returnAtoms )
-        {
-          XLAL_CHECK ( (multiFstatAtoms = XLALMalloc ( sizeof(*multiFstatAtoms) )) != NULL, XLAL_ENOMEM );
-          multiFstatAtoms->length = numDetectors;
-          XLAL_CHECK ( (multiFstatAtoms->data = XLALMalloc ( numDetectors * sizeof(*multiFstatAtoms->data) )) != NULL, XLAL_ENOMEM );
-        } // if returnAtoms
-
-      // loop over detectors and compute all detector-specific quantities
-      for ( UINT4 X=0; X < numDetectors; X ++)
-        {
-          COMPLEX8 FaX, FbX;
-          FstatAtomVector *FstatAtoms = NULL;
-          FstatAtomVector **FstatAtoms_p = returnAtoms ? (&FstatAtoms) : NULL;
-
-          // call XLALComputeFaFb_...() function for the user-requested hotloop variant
-          XLAL_CHECK ( (demod->computefafb_func) ( &FaX, &FbX, FstatAtoms_p, multiSFTs->data[X], thisPoint.fkdot,
-                                                   multiSSBTotal->data[X], multiAMcoef->data[X], demod->Dterms ) == XLAL_SUCCESS, XLAL_EFUNC );
-
-          if ( returnAtoms ) {
-            multiFstatAtoms->data[X] = FstatAtoms;     // copy pointer to IFO-specific Fstat-atoms 'contents'
-          }
-
-          XLAL_CHECK ( isfinite(creal(FaX)) && isfinite(cimag(FaX)) && isfinite(creal(FbX)) && isfinite(cimag(FbX)), XLAL_EFPOVRFLW );
-
-          if ( whatToCompute & FSTATQ_FAFB_PER_DET )
-            {
-              Fstats->FaPerDet[X][k] = FaX;
-              Fstats->FbPerDet[X][k] = FbX;
-            }
-
-          // compute single-IFO F-stats, if requested
-          if ( whatToCompute & FSTATQ_2F_PER_DET )
-            {
-              REAL4 AdX = multiAMcoef->data[X]->A;
-              REAL4 BdX = multiAMcoef->data[X]->B;
-              REAL4 CdX = multiAMcoef->data[X]->C;
-              REAL4 EdX = 0;
-              REAL4 DdX_inv = 1.0 / multiAMcoef->data[X]->D;
-
-              // compute final single-IFO F-stat
-              Fstats->twoFPerDet[X][k] = compute_fstat_from_fa_fb ( FaX, FbX, AdX, BdX, CdX, EdX, DdX_inv );
-
-            } // if FSTATQ_2F_PER_DET
-
-          /* Fa = sum_X Fa_X */
-          Fa += FaX;
-
-          /* Fb = sum_X Fb_X */
-          Fb += FbX;
-
-        } // for  X < numDetectors
-
-      if ( whatToCompute & FSTATQ_2F )
-        {
-          Fstats->twoF[k] = compute_fstat_from_fa_fb ( Fa, Fb, Ad, Bd, Cd, Ed, Dd_inv );
-        }
-
-      // Return multi-detector Fa & Fb
-      if ( whatToCompute & FSTATQ_FAFB )
-        {
-          Fstats->Fa[k] = Fa;
-          Fstats->Fb[k] = Fb;
-        }
-
-      // Return F-atoms per detector
-      if ( whatToCompute & FSTATQ_ATOMS_PER_DET )
+      if ( XLALComputeFstatDemodFreqBin ( Fstats, k, demod, multiSSBTotal, multiAMcoef ) != XLAL_SUCCESS )
         {
-          XLALDestroyMultiFstatAtomVector ( Fstats->multiFatoms[k] );
-          Fstats->multiFatoms[k] = multiFstatAtoms;
+#pragma omp critical (XLALComputeFstatDemod)
+          errnum = XLAL_EFUNC;
         }
-
     } // for k < Fstats->numFreqBins
+  XLAL_CHECK ( errnum == 0, errnum );
 
   // this needs to be free'ed, as it's currently not buffered
   XLALDestroyMultiSSBtimes ( multiBinary );
@@ -414,6 +448,9 @@ XLALSetupFstatDemod ( void **method_data,
       demod->timingDemod.Nsft	= 1.0 * numSFTs / numDetectors;	// average number of sfts *per detector*
     } // if collectTiming
 
+  // initialize sin/cos lookup table used by the hotloops here, as they may be called in parallel
+  XLALSinCosLUTInit();
+
   // Select XLALComputeFaFb_...() function for the user-requested hotloop variant
   switch ( optArgs->FstatMethod ) {
   case  FMETHOD_DEMOD_GENERIC:
@@ -431,6 +468,16 @@ XLALSetupFstatDemod ( void **method_data,
   case FMETHOD_DEMOD_SSE:
     demod->computefafb_func = XLALComputeFaFb_SSE;
     break;
+#endif
+#ifdef HAVE_AVX2_COMPILER
+  case FMETHOD_DEMOD_AVX2:
+    demod->computefafb_func = XLALComputeFaFb_AVX2;
+    break;
+#endif
+#ifdef HAVE_AVX512F_COMPILER
+  case FMETHOD_DEMOD_AVX512:
+    demod->computefafb_func = XLALComputeFaFb_AVX512;
+    break;
 #endif
   default:
     XLAL_ERROR ( XLAL_EINVAL, "Invalid Demod hotloop optArgs->FstatMethod='%d'", optArgs->FstatMethod );
@@ -0,0 +1,85 @@
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with with program; see the file COPYING. If not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301  USA
+//
+
+/// [hotloop]
+{
+  /* 'vanilla' LALDemod hotloop algorithm (see ComputeFstat_DemodHL_Generic.i),
+   * vectorised over the 2*Dterms frequency bins of the Dirichlet kernel sum,
+   * for arbitrary Dterms. Since P_alpha_k = (s_alpha, c_alpha - 1) / x_k, only the
+   * sums of Re(X_alpha_k) / x_k and Im(X_alpha_k) / x_k need to be accumulated;
+   * the common factor (s_alpha, c_alpha - 1) is applied once at the end.
+   */
+  REAL4 s_alpha, c_alpha;   /* sin(2pi kappa_alpha) and (cos(2pi kappa_alpha)-1) */
+  XLALSinCos2PiLUTtrimmed ( &s_alpha, &c_alpha, kappa_star);
+  c_alpha -= 1.0f;
+
+  const REAL8 kappa_max = kappa_star + 1.0f * Dterms - 1.0f;
+  const UINT4 numTerms = 2 * Dterms;
+
+  /* x_l = kappa_max - l is formed in double precision, since kappa_star may be
+   * close to 1, and then rounded to single precision before taking 1/x_l */
+  const __m256d off_0123 = _mm256_set_pd ( 3.0, 2.0, 1.0, 0.0 );
+  const __m256d four = _mm256_set1_pd ( 4.0 );
+  const __m256 one = _mm256_set1_ps ( 1.0f );
+  __m256 sum_XP = _mm256_setzero_ps();   /* (Re, Im) pairs of sum_l X_alpha_l / x_l */
+
+  UINT4 l = 0;
+  for ( ; l + 8 <= numTerms; l += 8 )
+    {
+      /* 1/x for bins l..l+7, ordered [ l..l+3 | l+4..l+7 ] */
+      const __m256d x_lo = _mm256_sub_pd ( _mm256_set1_pd ( kappa_max - l ), off_0123 );
+      const __m256d x_hi = _mm256_sub_pd ( x_lo, four );
+      const __m256 x = _mm256_insertf128_ps ( _mm256_castps128_ps256 ( _mm256_cvtpd_ps ( x_lo ) ), _mm256_cvtpd_ps ( x_hi ), 1 );
+      const __m256 xinv = _mm256_div_ps ( one, x );
+
+      /* duplicate each 1/x for the Re and Im part of its bin: [ l, l+1 | l+4, l+5 ] and [ l+2, l+3 | l+6, l+7 ] */
+      const __m256 xinv_a = _mm256_unpacklo_ps ( xinv, xinv );
+      const __m256 xinv_b = _mm256_unpackhi_ps ( xinv, xinv );
+
+      /* load SFT bins l..l+7 and arrange them to match */
+      const __m256 X_0 = _mm256_loadu_ps ( (const float *) ( Xalpha_l + l ) );
+      const __m256 X_1 = _mm256_loadu_ps ( (const float *) ( Xalpha_l + l + 4 ) );
+      const __m256 X_a = _mm256_permute2f128_ps ( X_0, X_1, 0x20 );
+      const __m256 X_b = _mm256_permute2f128_ps ( X_0, X_1, 0x31 );
+
+      sum_XP = _mm256_add_ps ( sum_XP, _mm256_mul_ps ( xinv_a, X_a ) );
+      sum_XP = _mm256_add_ps ( sum_XP, _mm256_mul_ps ( xinv_b, X_b ) );
+
+    } /* for l + 8 <= numTerms */
+
+  /* horizontal sum of the (Re, Im) pairs */
+  __m128 sum_XP_4 = _mm_add_ps ( _mm256_castps256_ps128 ( sum_XP ), _mm256_extractf128_ps ( sum_XP, 1 ) );
+  sum_XP_4 = _mm_add_ps ( sum_XP_4, _mm_movehl_ps ( sum_XP_4, sum_XP_4 ) );
+  REAL4 realXinv = _mm_cvtss_f32 ( sum_XP_4 );
+  REAL4 imagXinv = _mm_cvtss_f32 ( _mm_shuffle_ps ( sum_XP_4, sum_XP_4, _MM_SHUFFLE ( 1, 1, 1, 1 ) ) );
+
+  /* remaining bins, if 2*Dterms is not a multiple of 8 */
+  for ( ; l < numTerms; l ++ )
+    {
+      const REAL4 xinv = 1.0f / (REAL4) ( kappa_max - l );
+      realXinv += xinv * crealf ( Xalpha_l[l] );
+      imagXinv += xinv * cimagf ( Xalpha_l[l] );
+    }
+
+  /* multiply by the common factor of P_alpha_k */
+  realXP = s_alpha * realXinv - c_alpha * imagXinv;
+  imagXP = c_alpha * realXinv + s_alpha * imagXinv;
+
+  /* real- and imaginary part of e^{i 2 pi lambda_alpha } */
+  XLALSinCos2PiLUT ( &imagQ, &realQ, lambda_alpha );
+}
+/// [hotloop]
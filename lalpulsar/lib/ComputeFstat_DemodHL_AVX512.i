@@ -0,0 +1,82 @@
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with with program; see the file COPYING. If not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301  USA
+//
+
+/// [hotloop]
+{
+  /* AVX-512 version of the hotloop in ComputeFstat_DemodHL_AVX2.i,
+   * processing 16 frequency bins per iteration, for arbitrary Dterms.
+   * The last iteration uses masked loads for any remaining bins.
+   */
+  REAL4 s_alpha, c_alpha;   /* sin(2pi kappa_alpha) and (cos(2pi kappa_alpha)-1) */
+  XLALSinCos2PiLUTtrimmed ( &s_alpha, &c_alpha, kappa_star);
+  c_alpha -= 1.0f;
+
+  const REAL8 kappa_max = kappa_star + 1.0f * Dterms - 1.0f;
+  const UINT4 numTerms = 2 * Dterms;
+
+  /* x_l = kappa_max - l is formed in double precision and rounded to single
+   * precision before taking 1/x_l; x_l is never zero, even past the last bin */
+  const __m512d off_0to7 = _mm512_set_pd ( 7.0, 6.0, 5.0, 4.0, 3.0, 2.0, 1.0, 0.0 );
+  const __m512d eight = _mm512_set1_pd ( 8.0 );
+  const __m512 one = _mm512_set1_ps ( 1.0f );
+  __m512 sum_XP = _mm512_setzero_ps();   /* (Re, Im) pairs of sum_l X_alpha_l / x_l */
+
+  for ( UINT4 l = 0; l < numTerms; l += 16 )
+    {
+      /* load masks for SFT bins l..l+7 and l+8..l+15 */
+      const UINT4 rem = numTerms - l;
+      const __mmask16 mask_0 = ( rem >= 8 ) ? 0xFFFF : ( 1U << ( 2 * rem ) ) - 1;
+      const __mmask16 mask_1 = ( rem >= 16 ) ? 0xFFFF : ( rem > 8 ) ? ( 1U << ( 2 * ( rem - 8 ) ) ) - 1 : 0;
+
+      /* 1/x for bins l..l+15, ordered [ l..l+3 | l+4..l+7 | l+8..l+11 | l+12..l+15 ] */
+      const __m512d x_lo = _mm512_sub_pd ( _mm512_set1_pd ( kappa_max - l ), off_0to7 );
+      const __m512d x_hi = _mm512_sub_pd ( x_lo, eight );
+      const __m512d x_lo_hi = _mm512_insertf64x4 ( _mm512_castpd256_pd512 ( _mm256_castps_pd ( _mm512_cvtpd_ps ( x_lo ) ) ), _mm256_castps_pd ( _mm512_cvtpd_ps ( x_hi ) ), 1 );
+      const __m512 x = _mm512_castpd_ps ( x_lo_hi );
+      const __m512 xinv = _mm512_div_ps ( one, x );
+
+      /* duplicate each 1/x for the Re and Im part of its bin:
+       * [ l, l+1 | l+4, l+5 | l+8, l+9 | l+12, l+13 ] and [ l+2, l+3 | l+6, l+7 | l+10, l+11 | l+14, l+15 ] */
+      const __m512 xinv_a = _mm512_unpacklo_ps ( xinv, xinv );
+      const __m512 xinv_b = _mm512_unpackhi_ps ( xinv, xinv );
+
+      /* load SFT bins l..l+15, zeroing any past the end, and arrange them to match */
+      const __m512 X_0 = _mm512_maskz_loadu_ps ( mask_0, (const float *) ( Xalpha_l + l ) );
+      const __m512 X_1 = _mm512_maskz_loadu_ps ( mask_1, (const float *) ( Xalpha_l + l + 8 ) );
+      const __m512 X_a = _mm512_shuffle_f32x4 ( X_0, X_1, _MM_SHUFFLE ( 2, 0, 2, 0 ) );
+      const __m512 X_b = _mm512_shuffle_f32x4 ( X_0, X_1, _MM_SHUFFLE ( 3, 1, 3, 1 ) );
+
+      sum_XP = _mm512_add_ps ( sum_XP, _mm512_mul_ps ( xinv_a, X_a ) );
+      sum_XP = _mm512_add_ps ( sum_XP, _mm512_mul_ps ( xinv_b, X_b ) );
+
+    } /* for l < numTerms */
+
+  /* horizontal sum of the (Re, Im) pairs */
+  __m256 sum_XP_8 = _mm256_add_ps ( _mm512_castps512_ps256 ( sum_XP ), _mm256_castpd_ps ( _mm512_extractf64x4_pd ( _mm512_castps_pd ( sum_XP ), 1 ) ) );
+  __m128 sum_XP_4 = _mm_add_ps ( _mm256_castps256_ps128 ( sum_XP_8 ), _mm256_extractf128_ps ( sum_XP_8, 1 ) );
+  sum_XP_4 = _mm_add_ps ( sum_XP_4, _mm_movehl_ps ( sum_XP_4, sum_XP_4 ) );
+  const REAL4 realXinv = _mm_cvtss_f32 ( sum_XP_4 );
+  const REAL4 imagXinv = _mm_cvtss_f32 ( _mm_shuffle_ps ( sum_XP_4, sum_XP_4, _MM_SHUFFLE ( 1, 1, 1, 1 ) ) );
+
+  /* multiply by the common factor of P_alpha_k */
+  realXP = s_alpha * realXinv - c_alpha * imagXinv;
+  imagXP = c_alpha * realXinv + s_alpha * imagXinv;
+
+  /* real- and imaginary part of e^{i 2 pi lambda_alpha } */
+  XLALSinCos2PiLUT ( &imagQ, &realQ, lambda_alpha );
+}
+/// [hotloop]
@@ -25,6 +25,10 @@
 #include <complex.h>
 #include <fftw3.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include "ComputeFstat_internal.h"
 
 #include <lal/FFTWMutex.h>
@@ -49,6 +53,8 @@
 // ----- local macros ----------
 #define MYMAX(x,y) ( (x) > (y) ? (x) : (y) )
 #define MYMIN(x,y) ( (x) < (y) ? (x) : (y) )
+// distance between consecutive FFTs in batch buffers: FFT length rounded up to a multiple of 8 samples, so that all FFTs have the same (SIMD) alignment
+#define BATCH_STRIDE(n) ( ( ( (n) + 7 ) / 8 ) * 8 )
 
 // local macro versions of library functions to avoid calling external functions in GPU-ready code
 #define GPSDIFF(x,y) (1.0*((x).gpsSeconds - (y).gpsSeconds) + ((x).gpsNanoSeconds - (y).gpsNanoSeconds)*1e-9)
@@ -94,6 +100,8 @@ typedef struct tagFstatTimingResamp
   REAL4 tau0_FFT;       // timing coefficient for FFT-time
   REAL4 tau0_bary;      // timing coefficient for barycentering
 
+  REAL4 FFTplanReused;	// whether the FFT plan was re-used from the shared workspace pool (1) or newly computed (0)
+
   Timings_t Tau;
 
 } FstatTimingResamp;
@@ -109,6 +117,10 @@ static const char FstatTimingResampHelp[] =
   "%%%% tau0_FFT:       timing coefficient for FFT-time\n"
   "%%%% tau0_bary:      timing coefficient for barycentering\n"
   "%%%%\n"
+  "%%%% WorkspaceMB:    current memory (in MB) of the workspace shared between FstatInputs, including (estimated) FFT plans\n"
+  "%%%% NFFTplans:      current number of FFT plans in the shared workspace pool, keyed by FFT length\n"
+  "%%%% FFTplanReused:  whether this FstatInput re-used an FFT plan from the shared workspace pool (1) or computed a new one (0)\n"
+  "%%%%\n"
   "%%%% Resampling F-statistic timing model:\n"
   "%%%% tauF_core       = tau0_Fbin + (NsampFFT/NFbin) * ( R * tau0_spin + 5 * log2(NsampFFT) * tau0_FFT )\n"
   "%%%% tauF_buffer     = R * NsampFFT * tau0_bary / NFbin\n"
@@ -118,6 +130,17 @@ static const char FstatTimingResampHelp[] =
 
 
 // ----- workspace ----------
+
+// an FFT plan in the pool of the shared workspace, keyed by FFT length and number of FFTs
+typedef struct tagResampFFTPlan
+{
+  UINT4 numSamplesFFT;		// FFT length
+  UINT4 howmany;		// number of FFTs computed by plan
+  fftwf_plan plan;		// FFT plan; NULL if this pool entry is unused
+  UINT4 refcount;		// number of FstatInputs using this plan; 0 if plan is idle
+  UINT4 idleSince;		// value of 'numReleases' when plan last became idle, used to free the longest-idle plans first
+} ResampFFTPlan;
+
 typedef struct tagResampWorkspace
 {
   // intermediate quantities to interpolate and operate on SRC-frame timeseries
@@ -130,13 +153,30 @@ typedef struct tagResampWorkspace
   COMPLEX8 *TS_FFT;		// zero-padded, spindown-corr SRC-frame TS
   COMPLEX8 *FabX_Raw;		// raw full-band FFT result Fa,Fb
 
+  // per-thread copies of TS_FFT and FabX_Raw, used when detectors are computed in parallel; thread 0 uses TS_FFT and FabX_Raw
+  UINT4 numThreadsAlloc;	// number of threads for which buffers are allocated, including thread 0
+  COMPLEX8 **TS_FFT_thread;	// TS_FFT for threads 1, ..., numThreadsAlloc - 1
+  COMPLEX8 **FabX_Raw_thread;	// FabX_Raw for threads 1, ..., numThreadsAlloc - 1
+
+  // buffers for batched FFTs of {Fa,Fb} for several templates, used by XLALComputeFstatResampBatch()
+  UINT4 numBatchAlloc;		// number of templates for which batch buffers are allocated
+  COMPLEX8 *TS_FFT_batch;	// TS_FFT for each template in a batch, of length 2 * numBatchAlloc * BATCH_STRIDE(numSamplesFFTAlloc)
+  COMPLEX8 *FabX_Raw_batch;	// FabX_Raw for each template in a batch, of length 2 * numBatchAlloc * BATCH_STRIDE(numSamplesFFTAlloc)
+
   // arrays of size numFreqBinsOut over frequency bins f_k:
-  COMPLEX8 *FaX_k;		// properly normalized F_a^X(f_k) over output bins
-  COMPLEX8 *FbX_k;		// properly normalized F_b^X(f_k) over output bins
+  COMPLEX8 *FaX_k;		// properly normalized F_a^X(f_k) over output bins, for all detectors X
+  COMPLEX8 *FbX_k;		// properly normalized F_b^X(f_k) over output bins, for all detectors X
+  UINT4 numFreqBinsAllocX;	// internal: keep track of allocated length of per-detector frequency-arrays (over all detectors)
   COMPLEX8 *Fa_k;		// properly normalized F_a(f_k) over output bins
   COMPLEX8 *Fb_k;		// properly normalized F_b(f_k) over output bins
   UINT4 numFreqBinsAlloc;	// internal: keep track of allocated length of frequency-arrays
 
+  // pool of FFT plans, keyed by FFT length, shared between all FstatInputs using this workspace
+  UINT4 numPlansAlloc;		// allocated length of 'plans'
+  ResampFFTPlan *plans;		// pool of FFT plans
+  UINT4 numReleases;		// counts plans becoming idle
+  size_t maxMemory;		// memory budget in bytes for the workspace; 0 = unlimited
+
 } ResampWorkspace;
 
 typedef struct
@@ -147,6 +187,7 @@ typedef struct
   PulsarDopplerParams prev_doppler;			// buffering: previous phase-evolution ("doppler") parameters
   MultiAMCoeffs *multiAMcoef;				// buffered antenna-pattern functions
   MultiSSBtimes *multiSSBtimes;				// buffered SSB times, including *only* sky-position corrections, not binary
+  MultiSSBtimesBatch *multiSSBbatch;			// sky-independent SSB-timing quantities, if SSB precision is SSBPREC_RELATIVISTICOPT
   MultiSSBtimes *multiBinaryTimes;			// buffered SRC times, including both sky- and binary corrections [to avoid re-allocating this]
 
   AntennaPatternMatrix Mmunu;				// combined multi-IFO antenna-pattern coefficients {A,B,C,E}
@@ -157,7 +198,13 @@ typedef struct
 
   UINT4 numSamplesFFT;					// length of zero-padded SRC-frame timeseries (related to dFreq)
   UINT4 decimateFFT;					// output every n-th frequency bin, with n>1 iff (dFreq > 1/Tspan), and was internally decreased by n
-  fftwf_plan fftplan;					// FFT plan
+  fftwf_plan fftplan;					// FFT plan, owned by the pool of FFT plans in the shared workspace
+  ResampWorkspace *ws;					// shared workspace holding 'fftplan'; NULL if no plan was acquired
+  UINT4 planIndex;					// index of 'fftplan' in pool of FFT plans of shared workspace
+  UINT4 batchSize;					// maximal number of templates whose FFTs are computed together in XLALComputeFstatResampBatch()
+  UINT4 batchPlanSize;					// number of templates computed by 'batchplan'; 0 if no batched FFT plan was acquired
+  UINT4 batchPlanIndex;					// index of 'batchplan' in pool of FFT plans of shared workspace
+  fftwf_plan batchplan;					// batched FFT plan, owned by the pool of FFT plans in the shared workspace
 
   // ----- timing -----
   BOOLEAN collectTiming;				// flag whether or not to collect timing information
@@ -177,6 +224,30 @@ XLALComputeFstatResamp ( FstatResults* Fstats,
                          void *method_data
                        );
 
+static int
+XLALComputeFstatResampBatch ( FstatResults **Fstats,
+                              const UINT4 numTemplates,
+                              const FstatCommon *common,
+                              void *method_data
+                              );
+
+static int
+XLALAllocFaFbWorkspace_Resamp ( ResampWorkspace *ws,
+                                const FstatQuantities whatToCompute,
+                                const UINT4 numDetectors,
+                                const UINT4 numFreqBins,
+                                const UINT4 numTemplates
+                                );
+
+static int
+XLALSumFaFbAndCompute2F_Resamp ( FstatResults *Fstats,
+                                 const ResampMethodData *resamp,
+                                 ResampWorkspace *ws,
+                                 const COMPLEX8 *FaX_k_all,
+                                 const COMPLEX8 *FbX_k_all,
+                                 Timings_t *Tau
+                                 );
+
 static int
 XLALApplySpindownAndFreqShift ( COMPLEX8 *xOut,
                                 const COMPLEX8TimeSeries *xIn,
@@ -192,7 +263,10 @@ XLALBarycentricResampleMultiCOMPLEX8TimeSeries ( ResampMethodData *resamp,
 
 static int
 XLALComputeFaFb_Resamp ( ResampMethodData *resamp,
-                         ResampWorkspace *ws,
+                         COMPLEX8 *TS_FFT,
+                         COMPLEX8 *FabX_Raw,
+                         COMPLEX8 *FaX_k,
+                         COMPLEX8 *FbX_k,
                          const PulsarDopplerParams thisPoint,
                          REAL8 dFreq,
                          UINT4 numFreqBins,
@@ -200,6 +274,25 @@ XLALComputeFaFb_Resamp ( ResampMethodData *resamp,
                          const COMPLEX8TimeSeries *TimeSeries_SRC_b
                          );
 
+static int
+XLALGetFFTOutputBins_Resamp ( REAL8 *freqShift,
+                              UINT4 *offset_bins,
+                              const ResampMethodData *resamp,
+                              const PulsarDopplerParams *thisPoint,
+                              REAL8 dFreq,
+                              UINT4 numFreqBins,
+                              const COMPLEX8TimeSeries *TimeSeries_SRC
+                              );
+
+static void
+XLALNormalizeFaFb_Resamp ( COMPLEX8 *FaX_k,
+                           COMPLEX8 *FbX_k,
+                           const PulsarDopplerParams *thisPoint,
+                           REAL8 dFreq,
+                           UINT4 numFreqBins,
+                           const COMPLEX8TimeSeries *TimeSeries_SRC
+                           );
+
 static void
 XLALGetFFTPlanHints ( int * planMode,
                       double * planGenTimeoutSeconds
@@ -207,11 +300,196 @@ XLALGetFFTPlanHints ( int * planMode,
 
 // ==================== function definitions ====================
 
+static void
+XLALDestroyResampWorkspaceThreadBuffers ( ResampWorkspace *ws )
+{
+  for ( UINT4 t = 1; t < ws->numThreadsAlloc; ++t )
+    {
+      fftw_free ( ws->TS_FFT_thread[t-1] );
+      fftw_free ( ws->FabX_Raw_thread[t-1] );
+    }
+  XLALFree ( ws->TS_FFT_thread );
+  XLALFree ( ws->FabX_Raw_thread );
+  ws->TS_FFT_thread = NULL;
+  ws->FabX_Raw_thread = NULL;
+  ws->numThreadsAlloc = 0;
+
+} // XLALDestroyResampWorkspaceThreadBuffers()
+
+static void
+XLALDestroyResampWorkspaceBatchBuffers ( ResampWorkspace *ws )
+{
+  fftw_free ( ws->TS_FFT_batch );
+  fftw_free ( ws->FabX_Raw_batch );
+  ws->TS_FFT_batch = NULL;
+  ws->FabX_Raw_batch = NULL;
+  ws->numBatchAlloc = 0;
+
+} // XLALDestroyResampWorkspaceBatchBuffers()
+
+// estimate the memory used by the workspace; the memory of an FFT plan is estimated as that of the FFT buffers it transforms
+static size_t
+XLALResampWorkspaceMemory ( const ResampWorkspace *ws )
+{
+  size_t mem = sizeof(*ws) + ws->numPlansAlloc * sizeof(ws->plans[0]);
+  mem += 2 * ws->TStmp1_SRC->length * sizeof(COMPLEX8) + ws->SRCtimes_DET->length * sizeof(REAL8);
+  mem += 2 * MYMAX ( 1, ws->numThreadsAlloc ) * ws->numSamplesFFTAlloc * sizeof(COMPLEX8);
+  mem += 4 * ws->numBatchAlloc * BATCH_STRIDE(ws->numSamplesFFTAlloc) * sizeof(COMPLEX8);
+  mem += 2 * ( ws->numFreqBinsAllocX + ws->numFreqBinsAlloc ) * sizeof(COMPLEX8);
+  for ( UINT4 i = 0; i < ws->numPlansAlloc; ++i )
+    {
+      if ( ws->plans[i].plan != NULL ) {
+        mem += (size_t) ws->plans[i].howmany * ws->plans[i].numSamplesFFT * sizeof(COMPLEX8);
+      }
+    }
+  return mem;
+
+} // XLALResampWorkspaceMemory()
+
+// free idle FFT plans, longest-idle first, until the workspace memory plus 'memExtra' bytes is within the memory budget
+static void
+XLALResampWorkspaceFreeIdlePlans ( ResampWorkspace *ws, size_t memExtra )
+{
+  if ( ws->maxMemory == 0 ) {
+    return;
+  }
+  while ( XLALResampWorkspaceMemory ( ws ) + memExtra > ws->maxMemory )
+    {
+      ResampFFTPlan *idlest = NULL;
+      for ( UINT4 i = 0; i < ws->numPlansAlloc; ++i )
+        {
+          ResampFFTPlan *p = &ws->plans[i];
+          if ( p->plan != NULL && p->refcount == 0 && ( idlest == NULL || p->idleSince < idlest->idleSince ) ) {
+            idlest = p;
+          }
+        }
+      if ( idlest == NULL ) {
+        break;	// no more idle plans to free
+      }
+      XLALPrintInfo ( "%s: freeing idle FFT plan of length %" LAL_UINT4_FORMAT " to stay within memory budget\n", __func__, idlest->numSamplesFFT );
+      LAL_FFTW_WISDOM_LOCK;
+      fftwf_destroy_plan ( idlest->plan );
+      LAL_FFTW_WISDOM_UNLOCK;
+      idlest->plan = NULL;
+    }
+
+} // XLALResampWorkspaceFreeIdlePlans()
+
+// release a reference to an FFT plan in the workspace pool; idle plans are kept for re-use, within the memory budget
+static void
+XLALReleaseResampFFTPlan ( ResampWorkspace *ws, UINT4 planIndex )
+{
+  ResampFFTPlan *p = &ws->plans[planIndex];
+  if ( --p->refcount == 0 )
+    {
+      p->idleSince = ++ws->numReleases;
+      XLALResampWorkspaceFreeIdlePlans ( ws, 0 );
+    }
+
+} // XLALReleaseResampFFTPlan()
+
+// get a plan for 'howmany' FFTs of length 'numSamplesFFT' from the pool of the workspace, or compute it and add it to the pool
+static int
+XLALAcquireResampFFTPlan ( UINT4 *planIndex,		//!< [out] index of FFT plan in pool
+                           BOOLEAN *reused,		//!< [out] whether the FFT plan was re-used from the pool
+                           ResampWorkspace *ws,		//!< [in,out] workspace
+                           const UINT4 numSamplesFFT,	//!< [in] FFT length
+                           const UINT4 howmany,		//!< [in] number of FFTs, stored BATCH_STRIDE(numSamplesFFT) samples apart in 'in' and 'out'
+                           COMPLEX8 *in,		//!< [in] FFT input buffer used for planning
+                           COMPLEX8 *out		//!< [in] FFT output buffer used for planning
+                           )
+{
+  UINT4 idx = ws->numPlansAlloc;
+  for ( UINT4 i = 0; i < ws->numPlansAlloc; ++i )
+    {
+      if ( ws->plans[i].plan != NULL && ws->plans[i].numSamplesFFT == numSamplesFFT && ws->plans[i].howmany == howmany ) {
+        idx = i;
+        break;
+      }
+    }
+  const BOOLEAN reusePlan = ( idx < ws->numPlansAlloc );
+  const size_t memNewPlan = reusePlan ? 0 : (size_t) howmany * numSamplesFFT * sizeof(COMPLEX8);
+  if ( reusePlan ) {
+    ++ws->plans[idx].refcount;	// mark plan as used, so that it is not freed below
+  }
+  XLALResampWorkspaceFreeIdlePlans ( ws, memNewPlan );
+  const size_t memRequired = XLALResampWorkspaceMemory ( ws ) + memNewPlan;
+  if ( ws->maxMemory > 0 && memRequired > ws->maxMemory )
+    {
+      if ( reusePlan ) {
+        XLALReleaseResampFFTPlan ( ws, idx );
+      }
+      XLAL_ERROR ( XLAL_ENOMEM, "Resampling workspace requires %.1f MB, exceeding memory budget resampMaxWorkspaceMB = %g MB\n", memRequired / 1048576.0, ws->maxMemory / 1048576.0 );
+    }
+
+  if ( !reusePlan )
+    {
+      int fft_plan_flags=FFTW_MEASURE;
+      double fft_plan_timeout= FFTW_NO_TIMELIMIT ;
+      char *wisdom_filename;
+      static int tried_wisdom = 0;
+
+      LAL_FFTW_WISDOM_LOCK;
+      // if FFTWF_WISDOM_FILENAME is set, try to import that wisdom
+      wisdom_filename = getenv("FFTWF_WISDOM_FILENAME");
+      if (wisdom_filename && !tried_wisdom) {
+        FILE* fp = fopen(wisdom_filename,"r");
+        if (!fp) {
+          XLALPrintWarning("WARNING: Couldn't open wisdom file '%s'\n", wisdom_filename);
+        } else if (fftwf_import_wisdom_from_file(fp)) {
+          XLALPrintInfo("INFO: imported wisdom from file '%s'\n", wisdom_filename);
+          fclose(fp);
+        } else {
+          XLALPrintWarning("WARNING: Couldn't import wisdom from file '%s'\n", wisdom_filename);
+          fclose(fp);
+        }
+        tried_wisdom = -1;
+      }
+      XLALGetFFTPlanHints (& fft_plan_flags , & fft_plan_timeout);
+      fftw_set_timelimit( fft_plan_timeout );
+      fftwf_plan plan;
+      if ( howmany == 1 ) {
+        plan = fftwf_plan_dft_1d ( numSamplesFFT, in, out, FFTW_FORWARD, fft_plan_flags );
+      } else {
+        const int n = numSamplesFFT, dist = BATCH_STRIDE(numSamplesFFT);
+        plan = fftwf_plan_many_dft ( 1, &n, howmany, in, NULL, 1, dist, out, NULL, 1, dist, FFTW_FORWARD, fft_plan_flags );
+      }
+      LAL_FFTW_WISDOM_UNLOCK;
+      XLAL_CHECK ( plan != NULL, XLAL_EFAILED, "fftwf_plan_dft() failed for FFT length %" LAL_UINT4_FORMAT " and %" LAL_UINT4_FORMAT " FFTs\n", numSamplesFFT, howmany );
+
+      // store plan in an unused pool entry, or append to pool
+      for ( idx = 0; idx < ws->numPlansAlloc && ws->plans[idx].plan != NULL; ++idx ) {
+      }
+      if ( idx == ws->numPlansAlloc )
+        {
+          XLAL_CHECK ( (ws->plans = XLALRealloc ( ws->plans, (ws->numPlansAlloc + 1) * sizeof(ws->plans[0]) )) != NULL, XLAL_ENOMEM );
+          ws->numPlansAlloc ++;
+        }
+      ws->plans[idx].numSamplesFFT = numSamplesFFT;
+      ws->plans[idx].howmany = howmany;
+      ws->plans[idx].plan = plan;
+      ws->plans[idx].refcount = 1;
+      ws->plans[idx].idleSince = 0;
+    } // if !reusePlan
+  else
+    {
+      XLALPrintInfo ( "%s: re-using FFT plan of length %" LAL_UINT4_FORMAT " for %" LAL_UINT4_FORMAT " FFTs from shared workspace\n", __func__, numSamplesFFT, howmany );
+    }
+
+  (*planIndex) = idx;
+  (*reused) = reusePlan;
+  return XLAL_SUCCESS;
+
+} // XLALAcquireResampFFTPlan()
+
 static void
 XLALDestroyResampWorkspace ( void *workspace )
 {
   ResampWorkspace *ws = (ResampWorkspace*) workspace;
 
+  XLALDestroyResampWorkspaceThreadBuffers ( ws );
+  XLALDestroyResampWorkspaceBatchBuffers ( ws );
+
   XLALDestroyCOMPLEX8Vector ( ws->TStmp1_SRC );
   XLALDestroyCOMPLEX8Vector ( ws->TStmp2_SRC );
   XLALDestroyREAL8Vector ( ws->SRCtimes_DET );
@@ -219,6 +497,16 @@ XLALDestroyResampWorkspace ( void *workspace )
   fftw_free ( ws->FabX_Raw );
   fftw_free ( ws->TS_FFT );
 
+  LAL_FFTW_WISDOM_LOCK;
+  for ( UINT4 i = 0; i < ws->numPlansAlloc; ++i )
+    {
+      if ( ws->plans[i].plan != NULL ) {
+        fftwf_destroy_plan ( ws->plans[i].plan );
+      }
+    }
+  LAL_FFTW_WISDOM_UNLOCK;
+  XLALFree ( ws->plans );
+
   XLALFree ( ws->FaX_k );
   XLALFree ( ws->FbX_k );
   XLALFree ( ws->Fa_k );
@@ -243,11 +531,16 @@ XLALDestroyResampMethodData ( void* method_data )
   XLALDestroyMultiCOMPLEX8TimeSeries ( resamp->multiTimeSeries_SRC_b );
   XLALDestroyMultiAMCoeffs ( resamp->multiAMcoef );
   XLALDestroyMultiSSBtimes ( resamp->multiSSBtimes );
+  XLALDestroyMultiSSBtimesBatch ( resamp->multiSSBbatch );
   XLALDestroyMultiSSBtimes ( resamp->multiBinaryTimes );
 
-  LAL_FFTW_WISDOM_LOCK;
-  fftwf_destroy_plan ( resamp->fftplan );
-  LAL_FFTW_WISDOM_UNLOCK;
+  // release FFT plan back to the pool of the shared workspace
+  if ( resamp->ws != NULL ) {
+    XLALReleaseResampFFTPlan ( resamp->ws, resamp->planIndex );
+    if ( resamp->batchPlanSize > 0 ) {
+      XLALReleaseResampFFTPlan ( resamp->ws, resamp->batchPlanIndex );
+    }
+  }
 
   XLALFree ( resamp );
 
@@ -267,18 +560,24 @@ XLALSetupFstatResamp ( void **method_data,
   XLAL_CHECK ( funcs != NULL, XLAL_EFAULT );
   XLAL_CHECK ( multiSFTs != NULL, XLAL_EFAULT );
   XLAL_CHECK ( optArgs != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( optArgs->resampMaxWorkspaceMB >= 0, XLAL_EINVAL );
 
   // Allocate method data
   ResampMethodData *resamp = *method_data = XLALCalloc( 1, sizeof(*resamp) );
   XLAL_CHECK( resamp != NULL, XLAL_ENOMEM );
 
   resamp->Dterms = optArgs->Dterms;
+  resamp->batchSize = MYMAX ( 1, optArgs->resampBatchSize );
 
   // Set method function pointers
   funcs->compute_func = XLALComputeFstatResamp;
+  funcs->compute_batch_func = XLALComputeFstatResampBatch;
   funcs->method_data_destroy_func = XLALDestroyResampMethodData;
   funcs->workspace_destroy_func = XLALDestroyResampWorkspace;
 
+  // initialize sin/cos lookup table here, as it may be used by several threads in XLALComputeFstatResamp()
+  XLALSinCosLUTInit();
+
   // Extra band needed for resampling: Hamming-windowed sinc used for interpolation has a transition bandwith of
   // TB=(4/L)*fSamp, where L=2*Dterms+1 is the window-length, and here fSamp=Band (i.e. the full SFT frequency band)
   // However, we're only interested in the physical band and we'll be throwing away all bins outside of this.
@@ -367,6 +666,12 @@ XLALSetupFstatResamp ( void **method_data,
 
   XLAL_CHECK ( numSamplesFFT >= numSamplesMax_SRC, XLAL_EFAILED, "[numSamplesFFT = %d] < [numSamplesMax_SRC = %d]\n", numSamplesFFT, numSamplesMax_SRC );
 
+  // precompute sky-independent SSB-timing quantities, so that SSB times are computed quickly for each new sky position;
+  // XLALGetMultiSSBtimesBatch() only supports SSBPREC_RELATIVISTICOPT, otherwise XLALGetMultiSSBtimes() is used
+  if ( common->SSBprec == SSBPREC_RELATIVISTICOPT ) {
+    XLAL_CHECK ( (resamp->multiSSBbatch = XLALCreateMultiSSBtimesBatch ( common->multiDetectorStates )) != NULL, XLAL_EFUNC );
+  }
+
   // ---- re-use shared workspace, or allocate here ----------
   ResampWorkspace *ws = (ResampWorkspace*) common->workspace;
   if ( ws != NULL )
@@ -379,6 +684,10 @@ XLALSetupFstatResamp ( void **method_data,
           XLAL_CHECK ( (ws->TS_FFT   = fftw_malloc ( numSamplesFFT * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
 
           ws->numSamplesFFTAlloc = numSamplesFFT;
+
+          // per-thread and batch buffers are re-allocated with the new length when next needed
+          XLALDestroyResampWorkspaceThreadBuffers ( ws );
+          XLALDestroyResampWorkspaceBatchBuffers ( ws );
         }
 
       // adjust maximal SRC-frame timeseries length, if necessary
@@ -403,35 +712,17 @@ XLALSetupFstatResamp ( void **method_data,
       XLAL_CHECK ( (ws->TS_FFT   = fftw_malloc ( numSamplesFFT * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
       ws->numSamplesFFTAlloc = numSamplesFFT;
 
+      // the memory budget of the workspace is set by the FstatInput which creates it
+      ws->maxMemory = (size_t) ( optArgs->resampMaxWorkspaceMB * 1024 * 1024 );
+
       common->workspace = ws;
     } // end: if we create our own workspace
 
-  // ----- compute and buffer FFT plan ----------
-  int fft_plan_flags=FFTW_MEASURE;
-  double fft_plan_timeout= FFTW_NO_TIMELIMIT ;
-  char *wisdom_filename;
-  static int tried_wisdom = 0;
-
-  LAL_FFTW_WISDOM_LOCK;
-  // if FFTWF_WISDOM_FILENAME is set, try to import that wisdom
-  wisdom_filename = getenv("FFTWF_WISDOM_FILENAME");
-  if (wisdom_filename && !tried_wisdom) {
-    FILE* fp = fopen(wisdom_filename,"r");
-    if (!fp) {
-      XLALPrintWarning("WARNING: Couldn't open wisdom file '%s'\n", wisdom_filename);
-    } else if (fftwf_import_wisdom_from_file(fp)) {
-      XLALPrintInfo("INFO: imported wisdom from file '%s'\n", wisdom_filename);
-      fclose(fp);
-    } else {
-      XLALPrintWarning("WARNING: Couldn't import wisdom from file '%s'\n", wisdom_filename);
-      fclose(fp);
-    }
-    tried_wisdom = -1;
-  }
-  XLALGetFFTPlanHints (& fft_plan_flags , & fft_plan_timeout);
-  fftw_set_timelimit( fft_plan_timeout );
-  XLAL_CHECK ( (resamp->fftplan = fftwf_plan_dft_1d ( resamp->numSamplesFFT, ws->TS_FFT, ws->FabX_Raw, FFTW_FORWARD, fft_plan_flags )) != NULL, XLAL_EFAILED, "fftwf_plan_dft_1d() failed\n");
-  LAL_FFTW_WISDOM_UNLOCK;
+  // ----- get FFT plan of length 'numSamplesFFT' from the pool of the shared workspace, or compute it and add it to the pool ----------
+  BOOLEAN reusePlan = 0;
+  XLAL_CHECK ( XLALAcquireResampFFTPlan ( &resamp->planIndex, &reusePlan, ws, numSamplesFFT, 1, ws->TS_FFT, ws->FabX_Raw ) == XLAL_SUCCESS, XLAL_EFUNC );
+  resamp->ws = ws;
+  resamp->fftplan = ws->plans[resamp->planIndex].plan;
 
   // turn on timing collection if requested
   resamp->collectTiming = optArgs->collectTiming;
@@ -446,6 +737,7 @@ XLALSetupFstatResamp ( void **method_data,
       resamp->timingResamp.Resolution = TspanXMax / TspanFFT;
       resamp->timingResamp.NsampFFT0  = numSamplesFFT0;
       resamp->timingResamp.NsampFFT   = numSamplesFFT;
+      resamp->timingResamp.FFTplanReused = reusePlan;
     }
 
   return XLAL_SUCCESS;
@@ -506,64 +798,374 @@ XLALComputeFstatResamp ( FstatResults* Fstats,
     tic = XLALGetCPUTime();
   }
 
-  // NOTE: we try to use as much existing memory as possible in FstatResults, so we only
-  // allocate local 'workspace' storage in case there's not already a vector allocated in FstatResults for it
-  // this also avoid having to copy these results in case the user asked for them to be returned
-  if ( whatToCompute & FSTATQ_FAFB )
+  XLAL_CHECK ( XLALAllocFaFbWorkspace_Resamp ( ws, whatToCompute, numDetectors, numFreqBins, 1 ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // number of threads over which to split detectors; timing measurements require a serial computation
+  const UINT4 numThreads = collectTiming ? 1 : MYMIN ( common->numThreads, numDetectors );
+
+  // allocate per-thread FFT buffers, if needed
+  if ( numThreads > ws->numThreadsAlloc )
+    {
+      XLALDestroyResampWorkspaceThreadBuffers ( ws );
+      XLAL_CHECK ( (ws->TS_FFT_thread = XLALCalloc ( numThreads - 1, sizeof(ws->TS_FFT_thread[0]) )) != NULL, XLAL_ENOMEM );
+      XLAL_CHECK ( (ws->FabX_Raw_thread = XLALCalloc ( numThreads - 1, sizeof(ws->FabX_Raw_thread[0]) )) != NULL, XLAL_ENOMEM );
+      ws->numThreadsAlloc = numThreads;
+      for ( UINT4 t = 1; t < numThreads; ++t )
+        {
+          XLAL_CHECK ( (ws->TS_FFT_thread[t-1] = fftw_malloc ( ws->numSamplesFFTAlloc * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
+          XLAL_CHECK ( (ws->FabX_Raw_thread[t-1] = fftw_malloc ( ws->numSamplesFFTAlloc * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
+        }
+    }
+
+  if ( collectTiming ) {
+    toc = XLALGetCPUTime();
+    Tau->Mem = (toc-tic);	// this one doesn't scale with number of detector!
+  }
+  // ====================================================================================================
+
+  // compute {Fa^X(f_k), Fb^X(f_k)} for each detector, optionally in parallel
+  int errnum = 0;
+#pragma omp parallel for schedule(static) num_threads(numThreads) if(numThreads > 1)
+  for ( INT4 X = 0; X < (INT4)numDetectors; X++ )
     {
-      XLALFree ( ws->Fa_k ); // avoid memory leak if allocated in previous call
-      ws->Fa_k = Fstats->Fa;
-      XLALFree ( ws->Fb_k ); // avoid memory leak if allocated in previous call
-      ws->Fb_k = Fstats->Fb;
-    } // end: if returning FaFb we can use that return-struct as 'workspace'
-  else	// otherwise: we (re)allocate it locally
+#ifdef _OPENMP
+      const int t = omp_get_thread_num();
+#else
+      const int t = 0;
+#endif
+      COMPLEX8 *TS_FFT   = ( t == 0 ) ? ws->TS_FFT   : ws->TS_FFT_thread[t-1];
+      COMPLEX8 *FabX_Raw = ( t == 0 ) ? ws->FabX_Raw : ws->FabX_Raw_thread[t-1];
+
+      // if return-struct contains memory for holding FaFbPerDet: use that directly instead of local memory
+      COMPLEX8 *FaX_k, *FbX_k;
+      if ( whatToCompute & FSTATQ_FAFB_PER_DET )
+        {
+          FaX_k = Fstats->FaPerDet[X];
+          FbX_k = Fstats->FbPerDet[X];
+        }
+      else
+        {
+          FaX_k = ws->FaX_k + X * numFreqBins;
+          FbX_k = ws->FbX_k + X * numFreqBins;
+        }
+
+      if ( XLALComputeFaFb_Resamp ( resamp, TS_FFT, FabX_Raw, FaX_k, FbX_k, thisPoint, common->dFreq, numFreqBins, multiTimeSeries_SRC_a->data[X], multiTimeSeries_SRC_b->data[X] ) != XLAL_SUCCESS )
+        {
+#pragma omp critical (XLALComputeFstatResamp)
+          errnum = XLAL_EFUNC;
+        }
+    } // for X < numDetectors
+  XLAL_CHECK ( errnum == 0, errnum );
+
+  // sum over detectors and compute F-statistic
+  XLAL_CHECK ( XLALSumFaFbAndCompute2F_Resamp ( Fstats, resamp, ws, ws->FaX_k, ws->FbX_k, collectTiming ? Tau : NULL ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  if ( collectTiming )
+    {
+      tocEnd = XLALGetCPUTime();
+
+      FstatTimingGeneric *tiGen = &(resamp->timingGeneric);
+      FstatTimingResamp  *tiRS  = &(resamp->timingResamp);
+      XLAL_CHECK ( numDetectors == tiGen->Ndet, XLAL_EINVAL, "Inconsistent number of detectors between XLALCreateSetup() [%d] and XLALComputeFstat() [%d]\n", tiGen->Ndet, numDetectors );
+
+      Tau->Total = (tocEnd - ticStart);
+      // rescale all relevant timings to per-detector
+      Tau->Total /= numDetectors;
+      Tau->Bary  /= numDetectors;
+      Tau->Spin  /= numDetectors;
+      Tau->FFT   /= numDetectors;
+      Tau->Norm  /= numDetectors;
+      Tau->Copy  /= numDetectors;
+      REAL8 Tau_buffer = Tau->Bary;
+      // compute generic F-stat timing model contributions
+      UINT4 NFbin      = Fstats->numFreqBins;
+      REAL8 tauF_eff   = Tau->Total / NFbin;
+      REAL8 tauF_core  = (Tau->Total - Tau_buffer) / NFbin;
+
+      // compute resampling timing model coefficients
+      REAL8 tau0_Fbin  = (Tau->Copy + Tau->Norm + Tau->SumFabX + Tau->Fab2F) / NFbin;
+      REAL8 tau0_spin  = Tau->Spin / (tiRS->Resolution * tiRS->NsampFFT );
+      REAL8 tau0_FFT   = Tau->FFT / (5.0 * tiRS->NsampFFT * log2(tiRS->NsampFFT));
+
+      // update the averaged timing-model quantities
+      tiGen->NCalls ++;	// keep track of number of Fstat-calls for timing
+#define updateAvgF(q) tiGen->q = ((tiGen->q *(tiGen->NCalls-1) + q)/(tiGen->NCalls))
+      updateAvgF(tauF_eff);
+      updateAvgF(tauF_core);
+      // we also average NFbin, which can be different between different calls to XLALComputeFstat() (contrary to Ndet)
+      updateAvgF(NFbin);
+
+#define updateAvgRS(q) tiRS->q = ((tiRS->q *(tiGen->NCalls-1) + q)/(tiGen->NCalls))
+      updateAvgRS(tau0_Fbin);
+      updateAvgRS(tau0_spin);
+      updateAvgRS(tau0_FFT);
+
+      // buffer-quantities only updated if buffer was actually recomputed
+      if ( Tau->BufferRecomputed )
+        {
+          REAL8 tau0_bary   = Tau_buffer / (tiRS->Resolution * tiRS->NsampFFT);
+          REAL8 tauF_buffer = Tau_buffer / NFbin;
+
+          updateAvgF(tauF_buffer);
+          updateAvgRS(tau0_bary);
+        } // if BufferRecomputed
+
+    } // if collectTiming
+
+  return XLAL_SUCCESS;
+
+} // XLALComputeFstatResamp()
+
+// returns whether two Doppler points have the same sky position, reference time and binary parameters,
+// and therefore the same barycentred timeseries
+static BOOLEAN
+XLALSameSkyAndBinary_Resamp ( const PulsarDopplerParams *a, const PulsarDopplerParams *b )
+{
+  return (a->Alpha == b->Alpha) && (a->Delta == b->Delta) && ( GPSDIFF ( a->refTime, b->refTime ) == 0 ) &&
+    (a->asini == b->asini) && (a->period == b->period) && (a->ecc == b->ecc) && ( GPSDIFF ( a->tp, b->tp ) == 0 ) && (a->argp == b->argp);
+} // XLALSameSkyAndBinary_Resamp()
+
+///
+/// Compute the F-statistic for a batch of templates: consecutive templates which differ only in their frequency and spindowns
+/// share the same barycentred timeseries, and the FFTs of {Fa,Fb} for up to 'batchSize' such templates are computed together.
+/// A change of sky position ends a batch, since the SRC-frame timeseries, their epochs and the antenna-pattern matrix
+/// 'Mmunu' of 'resamp' are all overwritten when the next sky position is barycentred.
+///
+static int
+XLALComputeFstatResampBatch ( FstatResults **Fstats,
+                              const UINT4 numTemplates,
+                              const FstatCommon *common,
+                              void *method_data
+                              )
+{
+  // Check input
+  XLAL_CHECK ( Fstats != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( numTemplates > 0, XLAL_EINVAL );
+  XLAL_CHECK ( common != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( method_data != NULL, XLAL_EFAULT );
+
+  ResampMethodData *resamp = (ResampMethodData*) method_data;
+  ResampWorkspace *ws = (ResampWorkspace*) common->workspace;
+
+  const FstatQuantities whatToCompute = Fstats[0]->whatWasComputed;
+  XLAL_CHECK ( !(whatToCompute & FSTATQ_ATOMS_PER_DET), XLAL_EINVAL, "Resampling does not currently support atoms per detector" );
+  const UINT4 numFreqBins = Fstats[0]->numFreqBins;
+  const UINT4 numDetectors = resamp->multiTimeSeries_DET->length;
+  const UINT4 numSamplesFFT = resamp->numSamplesFFT;
+  const REAL8 dFreq = common->dFreq;
+
+  // number of templates whose FFTs are computed together, limited by the memory budget of the workspace
+  UINT4 batchSize = resamp->batchSize;
+  if ( ws->maxMemory > 0 )
+    {
+      // exclude the batch buffers, and the batched FFT plan of this FstatInput unless it is shared with another one
+      const size_t memBatch = 4 * ws->numBatchAlloc * BATCH_STRIDE(ws->numSamplesFFTAlloc) * sizeof(COMPLEX8);
+      size_t memBatchPlan = 0;
+      if ( resamp->batchPlanSize > 0 && ws->plans[resamp->batchPlanIndex].refcount == 1 ) {
+        memBatchPlan = 2 * resamp->batchPlanSize * numSamplesFFT * sizeof(COMPLEX8);
+      }
+      const size_t memOther = XLALResampWorkspaceMemory ( ws ) - memBatch - memBatchPlan;
+      const size_t memFree = ( ws->maxMemory > memOther ) ? ws->maxMemory - memOther : 0;
+      // each template of a batch needs 4 batch buffers, plus the estimate of 2 FFT buffers for the batched FFT plan
+      const size_t memPerTemplate = ( 4 * BATCH_STRIDE(ws->numSamplesFFTAlloc) + 2 * numSamplesFFT ) * sizeof(COMPLEX8);
+      batchSize = MYMIN ( batchSize, memFree / memPerTemplate );
+    }
+
+  // fall back to computing templates one at a time if batching is not possible; timing measurements also require this
+  if ( batchSize < 2 || numTemplates < 2 || resamp->collectTiming || whatToCompute == FSTATQ_NONE )
+    {
+      for ( UINT4 i = 0; i < numTemplates; ++i )
+        {
+          XLAL_CHECK ( XLALComputeFstatResamp ( Fstats[i], common, method_data ) == XLAL_SUCCESS, XLAL_EFUNC );
+        }
+      return XLAL_SUCCESS;
+    }
+
+  // allocate batch FFT buffers, if needed; with a memory budget, also shrink them to the current batch size
+  if ( batchSize > ws->numBatchAlloc || ( ws->maxMemory > 0 && batchSize < ws->numBatchAlloc ) )
+    {
+      XLALDestroyResampWorkspaceBatchBuffers ( ws );
+      XLAL_CHECK ( (ws->TS_FFT_batch   = fftw_malloc ( 2 * batchSize * BATCH_STRIDE(ws->numSamplesFFTAlloc) * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
+      XLAL_CHECK ( (ws->FabX_Raw_batch = fftw_malloc ( 2 * batchSize * BATCH_STRIDE(ws->numSamplesFFTAlloc) * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
+      ws->numBatchAlloc = batchSize;
+    }
+
+  // get plan for batched FFTs of {Fa,Fb} for 'batchSize' templates from the pool of the shared workspace
+  if ( resamp->batchPlanSize != batchSize )
+    {
+      if ( resamp->batchPlanSize > 0 ) {
+        XLALReleaseResampFFTPlan ( ws, resamp->batchPlanIndex );
+        resamp->batchPlanSize = 0;
+      }
+      BOOLEAN reusePlan = 0;
+      XLAL_CHECK ( XLALAcquireResampFFTPlan ( &resamp->batchPlanIndex, &reusePlan, ws, numSamplesFFT, 2 * batchSize, ws->TS_FFT_batch, ws->FabX_Raw_batch ) == XLAL_SUCCESS, XLAL_EFUNC );
+      resamp->batchPlanSize = batchSize;
+      resamp->batchplan = ws->plans[resamp->batchPlanIndex].plan;
+    }
+
+  // allocate per-detector {FaX,FbX} for all templates in a batch
+  XLAL_CHECK ( XLALAllocFaFbWorkspace_Resamp ( ws, whatToCompute, numDetectors, numFreqBins, batchSize ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  const UINT4 stride = BATCH_STRIDE(numSamplesFFT);
+  for ( UINT4 i0 = 0; i0 < numTemplates; )
+    {
+      // barycentre timeseries for first template of batch
+      // Note: all buffering is done within that function
+      XLAL_CHECK ( XLALBarycentricResampleMultiCOMPLEX8TimeSeries ( resamp, &Fstats[i0]->doppler, common ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+      // batch consists of following templates with the same barycentred timeseries
+      UINT4 numBatch = 1;
+      while ( i0 + numBatch < numTemplates && numBatch < batchSize && XLALSameSkyAndBinary_Resamp ( &Fstats[i0]->doppler, &Fstats[i0 + numBatch]->doppler ) ) {
+        numBatch ++;
+      }
+
+      for ( UINT4 X = 0; X < numDetectors; X++ )
+        {
+          const COMPLEX8TimeSeries *TimeSeries_SRCX_a = resamp->multiTimeSeries_SRC_a->data[X];
+          const COMPLEX8TimeSeries *TimeSeries_SRCX_b = resamp->multiTimeSeries_SRC_b->data[X];
+          XLAL_CHECK ( numSamplesFFT >= TimeSeries_SRCX_a->data->length, XLAL_EFAILED, "[numSamplesFFT = %d] < [len(TimeSeries_SRC_a) = %d]\n", numSamplesFFT, TimeSeries_SRCX_a->data->length );
+          XLAL_CHECK ( numSamplesFFT >= TimeSeries_SRCX_b->data->length, XLAL_EFAILED, "[numSamplesFFT = %d] < [len(TimeSeries_SRC_b) = %d]\n", numSamplesFFT, TimeSeries_SRCX_b->data->length );
+
+          // apply spindown phase-factors, store results in zero-padded timeseries for 'FFT'ing
+          memset ( ws->TS_FFT_batch, 0, 2 * numBatch * stride * sizeof(ws->TS_FFT_batch[0]) );
+          for ( UINT4 b = 0; b < numBatch; ++b )
+            {
+              const PulsarDopplerParams *thisPoint = &Fstats[i0 + b]->doppler;
+              REAL8 freqShift;
+              UINT4 offset_bins;
+              XLAL_CHECK ( XLALGetFFTOutputBins_Resamp ( &freqShift, &offset_bins, resamp, thisPoint, dFreq, numFreqBins, TimeSeries_SRCX_a ) == XLAL_SUCCESS, XLAL_EFUNC );
+              XLAL_CHECK ( XLALApplySpindownAndFreqShift ( ws->TS_FFT_batch + (2*b) * stride, TimeSeries_SRCX_a, thisPoint, freqShift ) == XLAL_SUCCESS, XLAL_EFUNC );
+              XLAL_CHECK ( XLALApplySpindownAndFreqShift ( ws->TS_FFT_batch + (2*b + 1) * stride, TimeSeries_SRCX_b, thisPoint, freqShift ) == XLAL_SUCCESS, XLAL_EFUNC );
+            }
+
+          // Fourier transform the resampled Fa(t) and Fb(t) of all templates in the batch
+          if ( numBatch == batchSize ) {
+            fftwf_execute_dft ( resamp->batchplan, ws->TS_FFT_batch, ws->FabX_Raw_batch );
+          } else {
+            for ( UINT4 j = 0; j < 2 * numBatch; ++j ) {
+              fftwf_execute_dft ( resamp->fftplan, ws->TS_FFT_batch + j * stride, ws->FabX_Raw_batch + j * stride );
+            }
+          }
+
+          // copy and normalize output frequency bins
+          for ( UINT4 b = 0; b < numBatch; ++b )
+            {
+              const PulsarDopplerParams *thisPoint = &Fstats[i0 + b]->doppler;
+              REAL8 freqShift;
+              UINT4 offset_bins;
+              XLAL_CHECK ( XLALGetFFTOutputBins_Resamp ( &freqShift, &offset_bins, resamp, thisPoint, dFreq, numFreqBins, TimeSeries_SRCX_a ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+              // if return-struct contains memory for holding FaFbPerDet: use that directly instead of local memory
+              COMPLEX8 *FaX_k, *FbX_k;
+              if ( whatToCompute & FSTATQ_FAFB_PER_DET )
+                {
+                  FaX_k = Fstats[i0 + b]->FaPerDet[X];
+                  FbX_k = Fstats[i0 + b]->FbPerDet[X];
+                }
+              else
+                {
+                  FaX_k = ws->FaX_k + ( b * numDetectors + X ) * numFreqBins;
+                  FbX_k = ws->FbX_k + ( b * numDetectors + X ) * numFreqBins;
+                }
+
+              const COMPLEX8 *FaX_Raw = ws->FabX_Raw_batch + (2*b) * stride;
+              const COMPLEX8 *FbX_Raw = ws->FabX_Raw_batch + (2*b + 1) * stride;
+              for ( UINT4 k = 0; k < numFreqBins; k++ )
+                {
+                  FaX_k[k] = FaX_Raw [ offset_bins + k * resamp->decimateFFT ];
+                  FbX_k[k] = FbX_Raw [ offset_bins + k * resamp->decimateFFT ];
+                }
+              XLALNormalizeFaFb_Resamp ( FaX_k, FbX_k, thisPoint, dFreq, numFreqBins, TimeSeries_SRCX_a );
+            } // for b < numBatch
+
+        } // for X < numDetectors
+
+      // sum over detectors and compute F-statistic for each template in the batch
+      for ( UINT4 b = 0; b < numBatch; ++b )
+        {
+          const UINT4 offsetX = b * numDetectors * numFreqBins;
+          const COMPLEX8 *FaX_k_all = ( ws->FaX_k != NULL ) ? ws->FaX_k + offsetX : NULL;
+          const COMPLEX8 *FbX_k_all = ( ws->FbX_k != NULL ) ? ws->FbX_k + offsetX : NULL;
+          XLAL_CHECK ( XLALSumFaFbAndCompute2F_Resamp ( Fstats[i0 + b], resamp, ws, FaX_k_all, FbX_k_all, NULL ) == XLAL_SUCCESS, XLAL_EFUNC );
+        }
+
+      i0 += numBatch;
+
+    } // for i0 < numTemplates
+
+  return XLAL_SUCCESS;
+
+} // XLALComputeFstatResampBatch()
+
+// allocate workspace arrays for {Fa,Fb} and per-detector {FaX,FbX} for 'numTemplates' templates,
+// unless they are returned in FstatResults, in which case those arrays are used directly
+static int
+XLALAllocFaFbWorkspace_Resamp ( ResampWorkspace *ws,			//!< [in,out] workspace
+                                const FstatQuantities whatToCompute,	//!< [in] quantities to compute
+                                const UINT4 numDetectors,		//!< [in] number of detectors
+                                const UINT4 numFreqBins,		//!< [in] number of output frequency bins
+                                const UINT4 numTemplates		//!< [in] number of templates whose per-detector {FaX,FbX} are needed at the same time
+                                )
+{
+  if ( !(whatToCompute & FSTATQ_FAFB) )
     {
       if ( numFreqBins > ws->numFreqBinsAlloc )
         {
           XLAL_CHECK ( (ws->Fa_k = XLALRealloc ( ws->Fa_k, numFreqBins * sizeof(COMPLEX8))) != NULL, XLAL_ENOMEM );
           XLAL_CHECK ( (ws->Fb_k = XLALRealloc ( ws->Fb_k, numFreqBins * sizeof(COMPLEX8))) != NULL, XLAL_ENOMEM );
+          ws->numFreqBinsAlloc = numFreqBins;	// keep track of allocated array length
         } // only increase workspace arrays
     }
 
   if ( whatToCompute & FSTATQ_FAFB_PER_DET )
     {
       XLALFree ( ws->FaX_k ); // avoid memory leak if allocated in previous call
-      ws->FaX_k = NULL;	// will be set in loop over detectors X
+      ws->FaX_k = NULL;	// FaPerDet is used directly in loop over detectors X
       XLALFree ( ws->FbX_k ); // avoid memory leak if allocated in previous call
-      ws->FbX_k = NULL;	// will be set in loop over detectors X
+      ws->FbX_k = NULL;	// FbPerDet is used directly in loop over detectors X
+      ws->numFreqBinsAllocX = 0;
     } // end: if returning FaFbPerDet we can use that return-struct as 'workspace'
-  else	// otherwise: we (re)allocate it locally
+  else	// otherwise: we (re)allocate it locally, for all detectors so that they can be computed in parallel
     {
-      if ( numFreqBins > ws->numFreqBinsAlloc )
+      const UINT4 numFreqBinsX = numTemplates * numDetectors * numFreqBins;
+      if ( numFreqBinsX > ws->numFreqBinsAllocX )
         {
-          XLAL_CHECK ( (ws->FaX_k = XLALRealloc ( ws->FaX_k, numFreqBins * sizeof(COMPLEX8))) != NULL, XLAL_ENOMEM );
-          XLAL_CHECK ( (ws->FbX_k = XLALRealloc ( ws->FbX_k, numFreqBins * sizeof(COMPLEX8))) != NULL, XLAL_ENOMEM );
+          XLAL_CHECK ( (ws->FaX_k = XLALRealloc ( ws->FaX_k, numFreqBinsX * sizeof(COMPLEX8))) != NULL, XLAL_ENOMEM );
+          XLAL_CHECK ( (ws->FbX_k = XLALRealloc ( ws->FbX_k, numFreqBinsX * sizeof(COMPLEX8))) != NULL, XLAL_ENOMEM );
+          ws->numFreqBinsAllocX = numFreqBinsX;	// keep track of allocated array length
         } // only increase workspace arrays
     }
-  if ( numFreqBins > ws->numFreqBinsAlloc ) {
-    ws->numFreqBinsAlloc = numFreqBins;	// keep track of allocated array length
-  }
 
-  if ( collectTiming ) {
-    toc = XLALGetCPUTime();
-    Tau->Mem = (toc-tic);	// this one doesn't scale with number of detector!
-  }
-  // ====================================================================================================
+  return XLAL_SUCCESS;
+
+} // XLALAllocFaFbWorkspace_Resamp()
+
+// sum {FaX,FbX} over detectors, in detector order, and compute the requested F-statistic quantities
+static int
+XLALSumFaFbAndCompute2F_Resamp ( FstatResults *Fstats,			//!< [in,out] F-statistic results
+                                 const ResampMethodData *resamp,	//!< [in] buffered resampling data
+                                 ResampWorkspace *ws,			//!< [in,out] workspace
+                                 const COMPLEX8 *FaX_k_all,		//!< [in] F_a^X(f_k) for all detectors X, unless returned in Fstats
+                                 const COMPLEX8 *FbX_k_all,		//!< [in] F_b^X(f_k) for all detectors X, unless returned in Fstats
+                                 Timings_t *Tau				//!< [in,out] timing measurements; NULL if not collected
+                                 )
+{
+  const FstatQuantities whatToCompute = Fstats->whatWasComputed;
+  const UINT4 numFreqBins = Fstats->numFreqBins;
+  const UINT4 numDetectors = resamp->multiTimeSeries_DET->length;
+  const BOOLEAN collectTiming = ( Tau != NULL );
+  REAL8 tic = 0, toc = 0;
+
+  // NOTE: we try to use as much existing memory as possible in FstatResults, so we only
+  // use local 'workspace' storage in case there's not already a vector allocated in FstatResults for it
+  // this also avoid having to copy these results in case the user asked for them to be returned
+  COMPLEX8 *Fa_k = ( whatToCompute & FSTATQ_FAFB ) ? Fstats->Fa : ws->Fa_k;
+  COMPLEX8 *Fb_k = ( whatToCompute & FSTATQ_FAFB ) ? Fstats->Fb : ws->Fb_k;
 
-  // loop over detectors
   for ( UINT4 X=0; X < numDetectors; X++ )
     {
-      // if return-struct contains memory for holding FaFbPerDet: use that directly instead of local memory
-      if ( whatToCompute & FSTATQ_FAFB_PER_DET )
-        {
-          ws->FaX_k = Fstats->FaPerDet[X];
-          ws->FbX_k = Fstats->FbPerDet[X];
-        }
-      const COMPLEX8TimeSeries *TimeSeriesX_SRC_a = multiTimeSeries_SRC_a->data[X];
-      const COMPLEX8TimeSeries *TimeSeriesX_SRC_b = multiTimeSeries_SRC_b->data[X];
-
-      // compute {Fa^X(f_k), Fb^X(f_k)}: results returned via workspace ws
-      XLAL_CHECK ( XLALComputeFaFb_Resamp ( resamp, ws, thisPoint, common->dFreq, numFreqBins, TimeSeriesX_SRC_a, TimeSeriesX_SRC_b ) == XLAL_SUCCESS, XLAL_EFUNC );
+      const COMPLEX8 *FaX_k = ( whatToCompute & FSTATQ_FAFB_PER_DET ) ? Fstats->FaPerDet[X] : FaX_k_all + X * numFreqBins;
+      const COMPLEX8 *FbX_k = ( whatToCompute & FSTATQ_FAFB_PER_DET ) ? Fstats->FbPerDet[X] : FbX_k_all + X * numFreqBins;
 
       if ( collectTiming ) {
         tic = XLALGetCPUTime();
@@ -572,16 +1174,16 @@ XLALComputeFstatResamp ( FstatResults* Fstats,
         { // avoid having to memset this array: for the first detector we *copy* results
           for ( UINT4 k = 0; k < numFreqBins; k++ )
             {
-              ws->Fa_k[k] = ws->FaX_k[k];
-              ws->Fb_k[k] = ws->FbX_k[k];
+              Fa_k[k] = FaX_k[k];
+              Fb_k[k] = FbX_k[k];
             }
         } // end: if X==0
       else
         { // for subsequent detectors we *add to* them
           for ( UINT4 k = 0; k < numFreqBins; k++ )
             {
-              ws->Fa_k[k] += ws->FaX_k[k];
-              ws->Fb_k[k] += ws->FbX_k[k];
+              Fa_k[k] += FaX_k[k];
+              Fb_k[k] += FbX_k[k];
             }
         } // end:if X>0
 
@@ -601,7 +1203,7 @@ XLALComputeFstatResamp ( FstatResults* Fstats,
           const REAL4 DdX_inv = 1.0f / resamp->MmunuX[X].Dd;
           for ( UINT4 k = 0; k < numFreqBins; k ++ )
             {
-              Fstats->twoFPerDet[X][k] = compute_fstat_from_fa_fb ( ws->FaX_k[k], ws->FbX_k[k], AdX, BdX, CdX, EdX, DdX_inv );
+              Fstats->twoFPerDet[X][k] = compute_fstat_from_fa_fb ( FaX_k[k], FbX_k[k], AdX, BdX, CdX, EdX, DdX_inv );
             }  // for k < numFreqBins
         } // end: if compute F_X
 
@@ -627,7 +1229,7 @@ XLALComputeFstatResamp ( FstatResults* Fstats,
       const REAL4 Dd_inv = 1.0f / resamp->Mmunu.Dd;
       for ( UINT4 k=0; k < numFreqBins; k++ )
         {
-          Fstats->twoF[k] = compute_fstat_from_fa_fb ( ws->Fa_k[k], ws->Fb_k[k], Ad, Bd, Cd, Ed, Dd_inv );
+          Fstats->twoF[k] = compute_fstat_from_fa_fb ( Fa_k[k], Fb_k[k], Ad, Bd, Cd, Ed, Dd_inv );
         }
     } // if FSTATQ_2F
 
@@ -650,81 +1252,17 @@ XLALComputeFstatResamp ( FstatResults* Fstats,
       Fstats->MmunuX[X] = resamp->MmunuX[X];
     }
 
-  // ----- workspace memory management:
-  // if we used the return struct directly to store Fa,Fb results,
-  // make sure to wipe those pointers to avoid mistakenly considering them as 'local' memory
-  // and re-allocing it in another call to this function
-  if ( whatToCompute & FSTATQ_FAFB )
-    {
-      ws->Fa_k = NULL;
-      ws->Fb_k = NULL;
-    }
-  if ( whatToCompute & FSTATQ_FAFB_PER_DET )
-    {
-      ws->FaX_k = NULL;
-      ws->FbX_k = NULL;
-    }
-
-  if ( collectTiming )
-    {
-      tocEnd = XLALGetCPUTime();
-
-      FstatTimingGeneric *tiGen = &(resamp->timingGeneric);
-      FstatTimingResamp  *tiRS  = &(resamp->timingResamp);
-      XLAL_CHECK ( numDetectors == tiGen->Ndet, XLAL_EINVAL, "Inconsistent number of detectors between XLALCreateSetup() [%d] and XLALComputeFstat() [%d]\n", tiGen->Ndet, numDetectors );
-
-      Tau->Total = (tocEnd - ticStart);
-      // rescale all relevant timings to per-detector
-      Tau->Total /= numDetectors;
-      Tau->Bary  /= numDetectors;
-      Tau->Spin  /= numDetectors;
-      Tau->FFT   /= numDetectors;
-      Tau->Norm  /= numDetectors;
-      Tau->Copy  /= numDetectors;
-      REAL8 Tau_buffer = Tau->Bary;
-      // compute generic F-stat timing model contributions
-      UINT4 NFbin      = Fstats->numFreqBins;
-      REAL8 tauF_eff   = Tau->Total / NFbin;
-      REAL8 tauF_core  = (Tau->Total - Tau_buffer) / NFbin;
-
-      // compute resampling timing model coefficients
-      REAL8 tau0_Fbin  = (Tau->Copy + Tau->Norm + Tau->SumFabX + Tau->Fab2F) / NFbin;
-      REAL8 tau0_spin  = Tau->Spin / (tiRS->Resolution * tiRS->NsampFFT );
-      REAL8 tau0_FFT   = Tau->FFT / (5.0 * tiRS->NsampFFT * log2(tiRS->NsampFFT));
-
-      // update the averaged timing-model quantities
-      tiGen->NCalls ++;	// keep track of number of Fstat-calls for timing
-#define updateAvgF(q) tiGen->q = ((tiGen->q *(tiGen->NCalls-1) + q)/(tiGen->NCalls))
-      updateAvgF(tauF_eff);
-      updateAvgF(tauF_core);
-      // we also average NFbin, which can be different between different calls to XLALComputeFstat() (contrary to Ndet)
-      updateAvgF(NFbin);
-
-#define updateAvgRS(q) tiRS->q = ((tiRS->q *(tiGen->NCalls-1) + q)/(tiGen->NCalls))
-      updateAvgRS(tau0_Fbin);
-      updateAvgRS(tau0_spin);
-      updateAvgRS(tau0_FFT);
-
-      // buffer-quantities only updated if buffer was actually recomputed
-      if ( Tau->BufferRecomputed )
-        {
-          REAL8 tau0_bary   = Tau_buffer / (tiRS->Resolution * tiRS->NsampFFT);
-          REAL8 tauF_buffer = Tau_buffer / NFbin;
-
-          updateAvgF(tauF_buffer);
-          updateAvgRS(tau0_bary);
-        } // if BufferRecomputed
-
-    } // if collectTiming
-
   return XLAL_SUCCESS;
 
-} // XLALComputeFstatResamp()
+} // XLALSumFaFbAndCompute2F_Resamp()
 
 
 static int
 XLALComputeFaFb_Resamp ( ResampMethodData *resamp,				//!< [in,out] buffered resampling data and workspace
-                         ResampWorkspace *ws,					//!< [in,out] resampling workspace (memory-sharing across segments)
+                         COMPLEX8 *TS_FFT,					//!< [out] workspace for zero-padded, spindown-corr SRC-frame TS, of length numSamplesFFT
+                         COMPLEX8 *FabX_Raw,					//!< [out] workspace for raw full-band FFT result, of length numSamplesFFT
+                         COMPLEX8 *FaX_k,					//!< [out] F_a^X(f_k) over output bins
+                         COMPLEX8 *FbX_k,					//!< [out] F_b^X(f_k) over output bins
                          const PulsarDopplerParams thisPoint,			//!< [in] Doppler point to compute {FaX,FbX} for
                          REAL8 dFreq,						//!< [in] output frequency resolution
                          UINT4 numFreqBins,					//!< [in] number of output frequency bins
@@ -732,23 +1270,13 @@ XLALComputeFaFb_Resamp ( ResampMethodData *resamp,				//!< [in,out] buffered res
                          const COMPLEX8TimeSeries * restrict TimeSeries_SRC_b	//!< [in] SRC-frame single-IFO timeseries * b(t)
                          )
 {
-  XLAL_CHECK ( (resamp != NULL) && (ws != NULL) && (TimeSeries_SRC_a != NULL) && (TimeSeries_SRC_b != NULL), XLAL_EINVAL );
+  XLAL_CHECK ( (resamp != NULL) && (TS_FFT != NULL) && (FabX_Raw != NULL) && (TimeSeries_SRC_a != NULL) && (TimeSeries_SRC_b != NULL), XLAL_EINVAL );
+  XLAL_CHECK ( (FaX_k != NULL) && (FbX_k != NULL), XLAL_EINVAL );
   XLAL_CHECK ( dFreq > 0, XLAL_EINVAL );
-  XLAL_CHECK ( numFreqBins <= ws->numFreqBinsAlloc, XLAL_EINVAL );
 
-  REAL8 FreqOut0 = thisPoint.fkdot[0];
-
-  // compute frequency shift to align heterodyne frequency with output frequency bins
-  REAL8 fHet   = TimeSeries_SRC_a->f0;
-  REAL8 dt_SRC = TimeSeries_SRC_a->deltaT;
-
-  REAL8 dFreqFFT = dFreq / resamp->decimateFFT;	// internally may be using higher frequency resolution dFreqFFT than requested
-  REAL8 freqShift = remainder ( FreqOut0 - fHet, dFreq ); // frequency shift to closest bin
-  REAL8 fMinFFT = fHet + freqShift - dFreqFFT * (resamp->numSamplesFFT/2);	// we'll shift DC into the *middle bin* N/2  [N always even!]
-  XLAL_CHECK ( FreqOut0 >= fMinFFT, XLAL_EDOM, "Lowest output frequency outside the available frequency band: [FreqOut0 = %.16g] < [fMinFFT = %.16g]\n", FreqOut0, fMinFFT );
-  UINT4 offset_bins = (UINT4) lround ( ( FreqOut0 - fMinFFT ) / dFreqFFT );
-  UINT4 maxOutputBin = offset_bins + (numFreqBins - 1) * resamp->decimateFFT;
-  XLAL_CHECK ( maxOutputBin < resamp->numSamplesFFT, XLAL_EDOM, "Highest output frequency bin outside available band: [maxOutputBin = %d] >= [numSamplesFFT = %d]\n", maxOutputBin, resamp->numSamplesFFT );
+  REAL8 freqShift;
+  UINT4 offset_bins;
+  XLAL_CHECK ( XLALGetFFTOutputBins_Resamp ( &freqShift, &offset_bins, resamp, &thisPoint, dFreq, numFreqBins, TimeSeries_SRC_a ) == XLAL_SUCCESS, XLAL_EFUNC );
 
   FstatTimingResamp *tiRS = &(resamp->timingResamp);
   BOOLEAN collectTiming = resamp->collectTiming;
@@ -760,10 +1288,10 @@ XLALComputeFaFb_Resamp ( ResampMethodData *resamp,				//!< [in,out] buffered res
   if ( collectTiming ) {
     tic = XLALGetCPUTime();
   }
-  memset ( ws->TS_FFT, 0, resamp->numSamplesFFT * sizeof(ws->TS_FFT[0]) );
+  memset ( TS_FFT, 0, resamp->numSamplesFFT * sizeof(TS_FFT[0]) );
   // ----- compute FaX_k
   // apply spindown phase-factors, store result in zero-padded timeseries for 'FFT'ing
-  XLAL_CHECK ( XLALApplySpindownAndFreqShift ( ws->TS_FFT, TimeSeries_SRC_a, &thisPoint, freqShift ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK ( XLALApplySpindownAndFreqShift ( TS_FFT, TimeSeries_SRC_a, &thisPoint, freqShift ) == XLAL_SUCCESS, XLAL_EFUNC );
 
   if ( collectTiming ) {
     toc = XLALGetCPUTime();
@@ -772,7 +1300,7 @@ XLALComputeFaFb_Resamp ( ResampMethodData *resamp,				//!< [in,out] buffered res
   }
 
   // Fourier transform the resampled Fa(t)
-  fftwf_execute_dft ( resamp->fftplan, ws->TS_FFT, ws->FabX_Raw );
+  fftwf_execute_dft ( resamp->fftplan, TS_FFT, FabX_Raw );
 
   if ( collectTiming ) {
     toc = XLALGetCPUTime();
@@ -781,7 +1309,7 @@ XLALComputeFaFb_Resamp ( ResampMethodData *resamp,				//!< [in,out] buffered res
   }
 
   for ( UINT4 k = 0; k < numFreqBins; k++ ) {
-    ws->FaX_k[k] = ws->FabX_Raw [ offset_bins + k * resamp->decimateFFT ];
+    FaX_k[k] = FabX_Raw [ offset_bins + k * resamp->decimateFFT ];
   }
 
   if ( collectTiming ) {
@@ -792,7 +1320,7 @@ XLALComputeFaFb_Resamp ( ResampMethodData *resamp,				//!< [in,out] buffered res
 
   // ----- compute FbX_k
   // apply spindown phase-factors, store result in zero-padded timeseries for 'FFT'ing
-  XLAL_CHECK ( XLALApplySpindownAndFreqShift ( ws->TS_FFT, TimeSeries_SRC_b, &thisPoint, freqShift ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK ( XLALApplySpindownAndFreqShift ( TS_FFT, TimeSeries_SRC_b, &thisPoint, freqShift ) == XLAL_SUCCESS, XLAL_EFUNC );
 
   if ( collectTiming ) {
     toc = XLALGetCPUTime();
@@ -801,7 +1329,7 @@ XLALComputeFaFb_Resamp ( ResampMethodData *resamp,				//!< [in,out] buffered res
   }
 
   // Fourier transform the resampled Fa(t)
-  fftwf_execute_dft ( resamp->fftplan, ws->TS_FFT, ws->FabX_Raw );
+  fftwf_execute_dft ( resamp->fftplan, TS_FFT, FabX_Raw );
 
   if ( collectTiming ) {
     toc = XLALGetCPUTime();
@@ -810,7 +1338,7 @@ XLALComputeFaFb_Resamp ( ResampMethodData *resamp,				//!< [in,out] buffered res
   }
 
   for ( UINT4 k = 0; k < numFreqBins; k++ ) {
-    ws->FbX_k[k] = ws->FabX_Raw [ offset_bins + k * resamp->decimateFFT ];
+    FbX_k[k] = FabX_Raw [ offset_bins + k * resamp->decimateFFT ];
   }
 
   if ( collectTiming ) {
@@ -820,17 +1348,7 @@ XLALComputeFaFb_Resamp ( ResampMethodData *resamp,				//!< [in,out] buffered res
   }
 
   // ----- normalization factors to be applied to Fa and Fb:
-  const REAL8 dtauX = GPSDIFF ( TimeSeries_SRC_a->epoch, thisPoint.refTime );
-  for ( UINT4 k = 0; k < numFreqBins; k++ )
-    {
-      REAL8 f_k = FreqOut0 + k * dFreq;
-      REAL8 cycles = - f_k * dtauX;
-      REAL4 sinphase, cosphase;
-      XLALSinCos2PiLUT ( &sinphase, &cosphase, cycles );
-      COMPLEX8 normX_k = dt_SRC * crectf ( cosphase, sinphase );
-      ws->FaX_k[k] *= normX_k;
-      ws->FbX_k[k] *= normX_k;
-    } // for k < numFreqBinsOut
+  XLALNormalizeFaFb_Resamp ( FaX_k, FbX_k, &thisPoint, dFreq, numFreqBins, TimeSeries_SRC_a );
 
   if ( collectTiming ) {
     toc = XLALGetCPUTime();
@@ -842,6 +1360,60 @@ XLALComputeFaFb_Resamp ( ResampMethodData *resamp,				//!< [in,out] buffered res
 
 } // XLALComputeFaFb_Resamp()
 
+// compute the frequency shift to apply to the SRC-frame timeseries, and the offset of the first output frequency bin in the FFT
+static int
+XLALGetFFTOutputBins_Resamp ( REAL8 *freqShift,					//!< [out] frequency shift to closest bin
+                              UINT4 *offset_bins,					//!< [out] FFT bin of first output frequency bin
+                              const ResampMethodData *resamp,			//!< [in] buffered resampling data
+                              const PulsarDopplerParams *thisPoint,		//!< [in] Doppler point to compute {FaX,FbX} for
+                              REAL8 dFreq,					//!< [in] output frequency resolution
+                              UINT4 numFreqBins,					//!< [in] number of output frequency bins
+                              const COMPLEX8TimeSeries *TimeSeries_SRC		//!< [in] SRC-frame single-IFO timeseries
+                              )
+{
+  REAL8 FreqOut0 = thisPoint->fkdot[0];
+
+  // compute frequency shift to align heterodyne frequency with output frequency bins
+  REAL8 fHet   = TimeSeries_SRC->f0;
+
+  REAL8 dFreqFFT = dFreq / resamp->decimateFFT;	// internally may be using higher frequency resolution dFreqFFT than requested
+  (*freqShift) = remainder ( FreqOut0 - fHet, dFreq ); // frequency shift to closest bin
+  REAL8 fMinFFT = fHet + (*freqShift) - dFreqFFT * (resamp->numSamplesFFT/2);	// we'll shift DC into the *middle bin* N/2  [N always even!]
+  XLAL_CHECK ( FreqOut0 >= fMinFFT, XLAL_EDOM, "Lowest output frequency outside the available frequency band: [FreqOut0 = %.16g] < [fMinFFT = %.16g]\n", FreqOut0, fMinFFT );
+  (*offset_bins) = (UINT4) lround ( ( FreqOut0 - fMinFFT ) / dFreqFFT );
+  UINT4 maxOutputBin = (*offset_bins) + (numFreqBins - 1) * resamp->decimateFFT;
+  XLAL_CHECK ( maxOutputBin < resamp->numSamplesFFT, XLAL_EDOM, "Highest output frequency bin outside available band: [maxOutputBin = %d] >= [numSamplesFFT = %d]\n", maxOutputBin, resamp->numSamplesFFT );
+
+  return XLAL_SUCCESS;
+
+} // XLALGetFFTOutputBins_Resamp()
+
+// apply normalization factors to {FaX,FbX}
+static void
+XLALNormalizeFaFb_Resamp ( COMPLEX8 *FaX_k,					//!< [in,out] F_a^X(f_k) over output bins
+                           COMPLEX8 *FbX_k,					//!< [in,out] F_b^X(f_k) over output bins
+                           const PulsarDopplerParams *thisPoint,		//!< [in] Doppler point to compute {FaX,FbX} for
+                           REAL8 dFreq,						//!< [in] output frequency resolution
+                           UINT4 numFreqBins,					//!< [in] number of output frequency bins
+                           const COMPLEX8TimeSeries *TimeSeries_SRC		//!< [in] SRC-frame single-IFO timeseries
+                           )
+{
+  const REAL8 FreqOut0 = thisPoint->fkdot[0];
+  const REAL8 dt_SRC = TimeSeries_SRC->deltaT;
+  const REAL8 dtauX = GPSDIFF ( TimeSeries_SRC->epoch, thisPoint->refTime );
+  for ( UINT4 k = 0; k < numFreqBins; k++ )
+    {
+      REAL8 f_k = FreqOut0 + k * dFreq;
+      REAL8 cycles = - f_k * dtauX;
+      REAL4 sinphase, cosphase;
+      XLALSinCos2PiLUT ( &sinphase, &cosphase, cycles );
+      COMPLEX8 normX_k = dt_SRC * crectf ( cosphase, sinphase );
+      FaX_k[k] *= normX_k;
+      FbX_k[k] *= normX_k;
+    } // for k < numFreqBinsOut
+
+} // XLALNormalizeFaFb_Resamp()
+
 static int
 XLALApplySpindownAndFreqShift ( COMPLEX8 *restrict xOut,      			///< [out] the spindown-corrected SRC-frame timeseries
                                 const COMPLEX8TimeSeries *restrict xIn,		///< [in] the input SRC-frame timeseries
@@ -969,8 +1541,12 @@ XLALBarycentricResampleMultiCOMPLEX8TimeSeries ( ResampMethodData *resamp,		// [
           resamp->MmunuX[X].Dd = resamp->multiAMcoef->data[X]->D;
         }
 
-      XLALDestroyMultiSSBtimes ( resamp->multiSSBtimes );
-      XLAL_CHECK ( (resamp->multiSSBtimes = XLALGetMultiSSBtimes ( common->multiDetectorStates, skypos, thisPoint->refTime, common->SSBprec )) != NULL, XLAL_EFUNC );
+      if ( resamp->multiSSBbatch != NULL ) {
+        XLAL_CHECK ( XLALGetMultiSSBtimesBatch ( &resamp->multiSSBtimes, resamp->multiSSBbatch, skypos, thisPoint->refTime, common->numThreads ) == XLAL_SUCCESS, XLAL_EFUNC );
+      } else {
+        XLALDestroyMultiSSBtimes ( resamp->multiSSBtimes );
+        XLAL_CHECK ( (resamp->multiSSBtimes = XLALGetMultiSSBtimes ( common->multiDetectorStates, skypos, thisPoint->refTime, common->SSBprec )) != NULL, XLAL_EFUNC );
+      }
 
     } // if cannot re-use buffered solution ie if !(same_skypos && same_binary)
 
@@ -1211,6 +1787,24 @@ XLALGetFstatTiming_Resamp ( const void *method_data, FstatTimingGeneric *timingG
   timingModel->names[i]  = "tau0_bary";
   timingModel->values[i] = tiRS->tau0_bary;
 
+  // shared workspace quantities may change with each call to XLALCreateFstatInput() or XLALComputeFstat(), so are computed here
+  UINT4 NFFTplans = 0;
+  for ( UINT4 j = 0; j < resamp->ws->numPlansAlloc; ++j ) {
+    NFFTplans += ( resamp->ws->plans[j].plan != NULL );
+  }
+
+  i++;
+  timingModel->names[i]  = "WorkspaceMB";
+  timingModel->values[i] = XLALResampWorkspaceMemory ( resamp->ws ) / 1048576.0;
+
+  i++;
+  timingModel->names[i]  = "NFFTplans";
+  timingModel->values[i] = NFFTplans;
+
+  i++;
+  timingModel->names[i]  = "FFTplanReused";
+  timingModel->values[i] = tiRS->FFTplanReused;
+
   timingModel->numVariables = i+1;
   timingModel->help      = FstatTimingResampHelp;
 
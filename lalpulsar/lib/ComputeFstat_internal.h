@@ -59,6 +59,8 @@ typedef struct {
   void *workspace;					// F-statistic method workspace
   BOOLEAN isTimeslice;                                  //Flag if this is a timeslice of another FstatInput struct
   REAL8 allowedMismatchFromSFTLength; // optional override for XLALFstatCheckSFTLengthMismatch()
+  UINT4 numThreads;					// Number of threads to use in XLALComputeFstat()
+  REAL8 tauSetupNorm;					// Time taken to normalize the SFTs and compute the noise weights, excluding loading SFTs and method setup
 } FstatCommon;
 
 // Pointers to function pointers which perform method-specific operations
@@ -66,6 +68,9 @@ typedef struct {
   int (*compute_func) (					// F-statistic method computation function
     FstatResults *, const FstatCommon *, void *
     );
+  int (*compute_batch_func) (				// F-statistic method computation function for a batch of templates; NULL if not supported
+    FstatResults **, const UINT4, const FstatCommon *, void *
+    );
   void (*method_data_destroy_func) ( void * );		// F-statistic method data destructor function
   void (*workspace_destroy_func) ( void * );		// Workspace destructor function
 } FstatMethodFuncs;
@@ -18,6 +18,11 @@
  */
 
 #include <lal/LALHough.h>
+#include <gsl/gsl_math.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 /** \cond DONT_DOXYGEN */
 
@@ -35,6 +40,9 @@
 
 #define SQ(x) (x) * (x)
 
+/* Maximum number of Hough maps which are accumulated together in one pass over their PHMDs */
+#define HOUGH_NBLOCK_MAPS 8
+
 static void LALComputeAM (LALStatus *, AMCoeffs *coe, LIGOTimeGPS *ts, AMCoeffsParams *params);
 
 /** \addtogroup LALHough_h */
@@ -580,6 +588,123 @@ void LALHOUGHConstructHMT_W (LALStatus                  *status,	/**< pointer to
 
 
 
+/**
+ * Calculates \a nmaps weighted total Hough maps \a ht, each from its own time-frequency trajectory
+ * \a freqInd and set of partial Hough map derivatives \a phmdVS. This is the XLAL equivalent of
+ * calling LALHOUGHConstructHMT_W() for each map in turn, e.g.\ for the different spindowns or
+ * frequency bins searched using one set of PHMDs, or for the maps of different sky patches.
+ *
+ * Consecutive maps which share the same set of PHMDs are accumulated in a single pass over the
+ * PHMDs, in blocks of up to 8 maps, into interleaved Hough map derivatives (see
+ * XLALHOUGHAddPHMD2InterleavedHD_W()) which are then integrated together. If LALSuite is built
+ * with OpenMP, the blocks are divided between \a num_threads threads; if \a num_threads is
+ * zero, the OpenMP default number of threads is used.
+ */
+int XLALHOUGHConstructHMTs_W( HOUGHMapTotal *const *ht,				/**< [out] total Hough maps */
+                              const UINT4 nmaps,				/**< [in] number of Hough maps */
+                              const UINT8FrequencyIndexVector *const *freqInd,	/**< [in] time-frequency trajectory of each Hough map */
+                              const PHMDVectorSequence *const *phmdVS,		/**< [in] set of partial Hough map derivatives of each Hough map */
+                              UINT4 num_threads					/**< [in] number of threads to use, if OpenMP is enabled */
+                              )
+{
+
+  /* Check input */
+  XLAL_CHECK( ht != NULL, XLAL_EFAULT );
+  XLAL_CHECK( nmaps > 0, XLAL_EINVAL );
+  XLAL_CHECK( freqInd != NULL, XLAL_EFAULT );
+  XLAL_CHECK( phmdVS != NULL, XLAL_EFAULT );
+  for ( UINT4 m = 0; m < nmaps; ++m ) {
+    XLAL_CHECK( ht[m] != NULL && ht[m]->map != NULL, XLAL_EFAULT );
+    XLAL_CHECK( ht[m]->xSide > 0 && ht[m]->ySide > 0, XLAL_ESIZE );
+    XLAL_CHECK( freqInd[m] != NULL && freqInd[m]->data != NULL, XLAL_EFAULT );
+    XLAL_CHECK( phmdVS[m] != NULL && phmdVS[m]->phmd != NULL, XLAL_EFAULT );
+    XLAL_CHECK( phmdVS[m]->length > 0 && phmdVS[m]->nfSize > 0, XLAL_ESIZE );
+    XLAL_CHECK( freqInd[m]->length == phmdVS[m]->length, XLAL_ESIZE );
+    XLAL_CHECK( freqInd[m]->deltaF == phmdVS[m]->deltaF, XLAL_EINVAL );
+    XLAL_CHECK( phmdVS[m]->breakLine < phmdVS[m]->nfSize, XLAL_EINVAL );
+    for ( UINT4 k = 0; k < freqInd[m]->length; ++k ) {
+      XLAL_CHECK( freqInd[m]->data[k] >= phmdVS[m]->fBinMin && freqInd[m]->data[k] - phmdVS[m]->fBinMin < phmdVS[m]->nfSize, XLAL_EDOM,
+                  "Trajectory of Hough map %u at time index %u lies outside cylinder of PHMDs", m, k );
+    }
+  }
+
+  /* Divide the Hough maps into blocks of consecutive maps with the same set of PHMDs and size */
+  UINT4 *blockStart = XLALMalloc( ( nmaps + 1 ) * sizeof( *blockStart ) );
+  XLAL_CHECK( blockStart != NULL, XLAL_ENOMEM );
+  INT4 nblocks = 0;
+  size_t maxMapLength = 0;
+  for ( UINT4 m = 0; m < nmaps; ++m ) {
+    if ( m == 0 || m - blockStart[nblocks - 1] == HOUGH_NBLOCK_MAPS || phmdVS[m] != phmdVS[m - 1]
+         || ht[m]->xSide != ht[m - 1]->xSide || ht[m]->ySide != ht[m - 1]->ySide ) {
+      blockStart[nblocks++] = m;
+    }
+    maxMapLength = GSL_MAX( maxMapLength, ( size_t ) ht[m]->ySide * ( ht[m]->xSide + 1 ) );
+  }
+  blockStart[nblocks] = nmaps;
+
+  /* Determine the number of threads to use */
+#ifdef _OPENMP
+  if ( num_threads == 0 ) {
+    num_threads = omp_get_max_threads();
+  }
+#else
+  (void) num_threads;
+#endif
+
+  int errnum = 0;
+#pragma omp parallel num_threads(num_threads) if(num_threads > 1 && nblocks > 1)
+  {
+
+    /* Allocate interleaved Hough map derivatives for this thread */
+    HoughDT *hd = XLALMalloc( maxMapLength * HOUGH_NBLOCK_MAPS * sizeof( *hd ) );
+    if ( hd == NULL ) {
+#pragma omp critical (XLALHOUGHConstructHMTs_W)
+      errnum = XLAL_ENOMEM;
+    }
+
+#pragma omp for schedule(dynamic)
+    for ( INT4 block = 0; block < nblocks; ++block ) {
+      if ( errnum != 0 ) {
+        continue;
+      }
+      const UINT4 m0 = blockStart[block];
+      const UINT4 nb = blockStart[block + 1] - m0;
+      const PHMDVectorSequence *ph = phmdVS[m0];
+      const UINT2 xSide = ht[m0]->xSide;
+      const UINT2 ySide = ht[m0]->ySide;
+
+      /* Accumulate the PHMDs of each Hough map in the block, one time index at a time */
+      memset( hd, 0, ( size_t ) ySide * ( xSide + 1 ) * nb * sizeof( *hd ) );
+      for ( UINT4 k = 0; k < ph->length && errnum == 0; ++k ) {
+        for ( UINT4 b = 0; b < nb; ++b ) {
+          const UINT4 j = ( freqInd[m0 + b]->data[k] - ph->fBinMin + ph->breakLine ) % ph->nfSize;
+          if ( XLALHOUGHAddPHMD2InterleavedHD_W( hd, xSide, ySide, nb, b, &ph->phmd[j * ph->length + k] ) != XLAL_SUCCESS ) {
+#pragma omp critical (XLALHOUGHConstructHMTs_W)
+            errnum = XLAL_EFUNC;
+            break;
+          }
+        }
+      }
+
+      /* Integrate the Hough maps in the block together */
+      if ( errnum == 0 && XLALHOUGHIntegrInterleavedHD2HT( &ht[m0], nb, hd ) != XLAL_SUCCESS ) {
+#pragma omp critical (XLALHOUGHConstructHMTs_W)
+        errnum = XLAL_EFUNC;
+      }
+
+    }
+
+    XLALFree( hd );
+
+  }
+  XLALFree( blockStart );
+  XLAL_CHECK( errnum == 0, errnum );
+
+  return XLAL_SUCCESS;
+
+}
+
+
 /**
  * Adds weight factors for set of partial hough map derivatives -- the
  * weights must be calculated outside this function.
@@ -18,6 +18,7 @@
  */
 
 #include <lal/HoughMap.h>
+#include <gsl/gsl_math.h>
 
 /*
  * The functions that make up the guts of this module
@@ -401,6 +402,167 @@ void LALHOUGHIntegrHD2HT (LALStatus       *status,
   RETURN (status);
 }
 
+/**
+ * Accumulates the weighted partial Hough map derivative \a phmd into one of \a nmaps
+ * Hough map derivatives which are stored interleaved in \a map, i.e.\ pixel (x,y) of
+ * map \a imap is stored at <tt>map[(y*(xSide+1) + x)*nmaps + imap]</tt>; the length of
+ * \a map should therefore be <tt>ySide*(xSide+1)*nmaps</tt>.
+ *
+ * Interleaving the derivatives of Hough maps at neighbouring frequency bins, which are
+ * built from partial Hough map derivatives sharing the same look-up tables, keeps the
+ * pixels updated by their borders close together in memory, and allows the maps to be
+ * integrated together by XLALHOUGHIntegrInterleavedHD2HT() with vector operations.
+ * Borders are clipped to the map, and checked to lie within it, once per border instead of once per pixel.
+ */
+int XLALHOUGHAddPHMD2InterleavedHD_W( HoughDT *map,		/**< [in,out] interleaved Hough map derivatives */
+                                      const UINT2 xSide,	/**< [in] number of physical pixels in the x direction */
+                                      const UINT2 ySide,	/**< [in] number of physical pixels in the y direction */
+                                      const UINT4 nmaps,	/**< [in] number of interleaved Hough map derivatives */
+                                      const UINT4 imap,		/**< [in] index of Hough map derivative to accumulate into */
+                                      const HOUGHphmd *phmd	/**< [in] partial Hough map derivative */
+                                      )
+{
+
+  XLAL_CHECK( map != NULL, XLAL_EFAULT );
+  XLAL_CHECK( xSide > 0 && ySide > 0, XLAL_ESIZE );
+  XLAL_CHECK( imap < nmaps, XLAL_EINVAL );
+  XLAL_CHECK( phmd != NULL, XLAL_EFAULT );
+  XLAL_CHECK( phmd->firstColumn != NULL, XLAL_EFAULT );
+  XLAL_CHECK( phmd->ySide >= ySide, XLAL_ESIZE );
+
+  const HoughDT weight = phmd->weight;
+  const size_t rowStride = ( ( size_t ) xSide + 1 ) * nmaps;
+  HoughDT *const map0 = map + imap;
+
+  /* first column correction */
+  for ( INT4 j = 0; j < ySide; ++j ) {
+    map0[j * rowStride] += phmd->firstColumn[j] * weight;
+  }
+
+  /* left borders => increase according to weight, right borders => decrease according to weight */
+  for ( int side = 0; side < 2; ++side ) {
+    const UINT2 lengthBorders = ( side == 0 ) ? phmd->lengthLeft : phmd->lengthRight;
+    HOUGHBorder *const *borderP = ( side == 0 ) ? phmd->leftBorderP : phmd->rightBorderP;
+    const HoughDT sideWeight = ( side == 0 ) ? weight : -weight;
+    for ( UINT2 k = 0; k < lengthBorders; ++k ) {
+
+      /* clip border to the map */
+      const INT4 yLower = GSL_MAX( borderP[k]->yLower, 0 );
+      const INT4 yUpper = GSL_MIN( borderP[k]->yUpper, ySide - 1 );
+      const COORType *xPixel = borderP[k]->xPixel;
+
+      /* check that the border lies within the map, outside of the accumulation loop */
+      INT4 xMin = xSide, xMax = 0;
+      for ( INT4 j = yLower; j <= yUpper; ++j ) {
+        xMin = GSL_MIN( xMin, xPixel[j] );
+        xMax = GSL_MAX( xMax, xPixel[j] );
+      }
+      XLAL_CHECK( yLower > yUpper || ( 0 <= xMin && xMax <= xSide ), XLAL_EDOM, "Map index out of bounds: xPixel[%i..%i] in [%i,%i], not in [0,%u]", yLower, yUpper, xMin, xMax, xSide );
+
+      for ( INT4 j = yLower; j <= yUpper; ++j ) {
+        map0[j * rowStride + xPixel[j] * nmaps] += sideWeight;
+      }
+
+    }
+  }
+
+  return XLAL_SUCCESS;
+
+}
+
+/**
+ * XLAL version of LALHOUGHAddPHMD2HD_W(): accumulates the weighted partial Hough map
+ * derivative \a phmd into the Hough map derivative \a hd.
+ */
+int XLALHOUGHAddPHMD2HD_W( HOUGHMapDeriv *hd,		/**< [in,out] Hough map derivative */
+                           const HOUGHphmd *phmd	/**< [in] partial Hough map derivative */
+                           )
+{
+  XLAL_CHECK( hd != NULL, XLAL_EFAULT );
+  XLAL_CHECK( XLALHOUGHAddPHMD2InterleavedHD_W( hd->map, hd->xSide, hd->ySide, 1, 0, phmd ) == XLAL_SUCCESS, XLAL_EFUNC );
+  return XLAL_SUCCESS;
+}
+
+/**
+ * Constructs the \a nmaps total Hough maps \a ht from the interleaved Hough map
+ * derivatives \a map (see XLALHOUGHAddPHMD2InterleavedHD_W()) by integrating each row.
+ * The rows of all maps are integrated together, so that the running sums of the maps
+ * are updated with vector operations.
+ */
+int XLALHOUGHIntegrInterleavedHD2HT( HOUGHMapTotal *const *ht,	/**< [out] total Hough maps */
+                                     const UINT4 nmaps,		/**< [in] number of interleaved Hough map derivatives */
+                                     const HoughDT *map		/**< [in] interleaved Hough map derivatives */
+                                     )
+{
+
+  XLAL_CHECK( ht != NULL, XLAL_EFAULT );
+  XLAL_CHECK( nmaps > 0, XLAL_ESIZE );
+  XLAL_CHECK( map != NULL, XLAL_EFAULT );
+  const UINT2 xSide = ht[0]->xSide;
+  const UINT2 ySide = ht[0]->ySide;
+  XLAL_CHECK( xSide > 0 && ySide > 0, XLAL_ESIZE );
+  for ( UINT4 b = 0; b < nmaps; ++b ) {
+    XLAL_CHECK( ht[b] != NULL && ht[b]->map != NULL, XLAL_EFAULT );
+    XLAL_CHECK( ht[b]->xSide == xSide && ht[b]->ySide == ySide, XLAL_ESIZE );
+  }
+
+  if ( nmaps == 1 ) {
+
+    /* integrate each row of a single map */
+    HoughTT *restrict htmap = ht[0]->map;
+    for ( INT4 j = 0; j < ySide; ++j ) {
+      const HoughDT *restrict hdrow = map + j * ( ( size_t ) xSide + 1 );
+      HoughTT accumulator = 0;
+      for ( INT4 i = 0; i < xSide; ++i ) {
+        htmap[j * xSide + i] = ( accumulator += hdrow[i] );
+      }
+    }
+
+  } else {
+
+    /* integrate each row of all maps together into a buffer of interleaved running sums, then copy
+       the running sums of each map to its total Hough map */
+    HoughTT *rowSums = XLALMalloc( ( size_t ) xSide * nmaps * sizeof( *rowSums ) );
+    XLAL_CHECK( rowSums != NULL, XLAL_ENOMEM );
+    for ( INT4 j = 0; j < ySide; ++j ) {
+      const HoughDT *restrict hdrow = map + j * ( ( size_t ) xSide + 1 ) * nmaps;
+      HoughTT *restrict sums = rowSums;
+      for ( UINT4 b = 0; b < nmaps; ++b ) {
+        sums[b] = hdrow[b];
+      }
+      for ( size_t i = nmaps; i < ( size_t ) xSide * nmaps; ++i ) {
+        sums[i] = sums[i - nmaps] + hdrow[i];
+      }
+      for ( UINT4 b = 0; b < nmaps; ++b ) {
+        HoughTT *restrict htrow = ht[b]->map + j * xSide;
+        for ( INT4 i = 0; i < xSide; ++i ) {
+          htrow[i] = sums[i * nmaps + b];
+        }
+      }
+    }
+    XLALFree( rowSums );
+
+  }
+
+  return XLAL_SUCCESS;
+
+}
+
+/**
+ * XLAL version of LALHOUGHIntegrHD2HT(): constructs the total Hough map \a ht from its
+ * derivative \a hd by integrating each row (x-direction).
+ */
+int XLALHOUGHIntegrHD2HT( HOUGHMapTotal *ht,		/**< [out] total Hough map */
+                          const HOUGHMapDeriv *hd	/**< [in] Hough map derivative */
+                          )
+{
+  XLAL_CHECK( ht != NULL, XLAL_EFAULT );
+  XLAL_CHECK( hd != NULL && hd->map != NULL, XLAL_EFAULT );
+  XLAL_CHECK( ht->xSide == hd->xSide && ht->ySide == hd->ySide, XLAL_ESIZE );
+  XLAL_CHECK( XLALHOUGHIntegrInterleavedHD2HT( &ht, 1, hd->map ) == XLAL_SUCCESS, XLAL_EFUNC );
+  return XLAL_SUCCESS;
+}
+
 /**  Find source sky location given stereographic coordinates indexes */
 void LALStereo2SkyLocation (LALStatus  *status,
          REAL8UnitPolarCoor *sourceLocation, /* output*/
@@ -175,6 +175,14 @@ void LALHOUGHInitializeHT (LALStatus      *status,
 			  HOUGHPatchGrid  *patch      /* patch information */
 			  );
 
+int XLALHOUGHAddPHMD2InterleavedHD_W( HoughDT *map, const UINT2 xSide, const UINT2 ySide, const UINT4 nmaps, const UINT4 imap, const HOUGHphmd *phmd );
+
+int XLALHOUGHAddPHMD2HD_W( HOUGHMapDeriv *hd, const HOUGHphmd *phmd );
+
+int XLALHOUGHIntegrInterleavedHD2HT( HOUGHMapTotal *const *ht, const UINT4 nmaps, const HoughDT *map );
+
+int XLALHOUGHIntegrHD2HT( HOUGHMapTotal *ht, const HOUGHMapDeriv *hd );
+
 void LALStereo2SkyLocation (LALStatus  *status,
 			    REAL8UnitPolarCoor *sourceLocation, /* output*/
 			    UINT2              xPos,
@@ -120,11 +120,17 @@ typedef struct tagPosVelAcc
 }
 PosVelAcc;
 
+/** Opaque type holding the memory mapping of a binary ephemeris file */
+typedef struct tagEphemerisFileMapping EphemerisFileMapping;
+
 /**
  * This structure contains all information about the
  * center-of-mass positions of the Earth and Sun, listed at regular
  * time intervals.
  */
+#ifdef SWIG /* SWIG interface directives */
+SWIGLAL(IGNORE_MEMBERS(tagEphemerisData, mappingE, mappingS));
+#endif /* SWIG */
 typedef struct tagEphemerisData
 {
   CHAR *filenameE;      /**< File containing Earth's position.  */
@@ -145,6 +151,9 @@ typedef struct tagEphemerisData
   PosVelAcc *ephemS;    /**< Array with pos, vel and acc for the sun (see ephemE) */
 
   EphemerisType etype;  /**< The ephemeris type e.g. DE405 */
+
+  EphemerisFileMapping *mappingE; /**< Internal: memory mapping of a binary Earth ephemeris file holding \a ephemE, or NULL */
+  EphemerisFileMapping *mappingS; /**< Internal: memory mapping of a binary Sun ephemeris file holding \a ephemS, or NULL */
 }
 EphemerisData;
 
@@ -153,6 +162,9 @@ EphemerisData;
  * This structure will contain a vector of time corrections
  * used during conversion from TT to TDB/TCB/Teph
  */
+#ifdef SWIG /* SWIG interface directives */
+SWIGLAL(IGNORE_MEMBERS(tagTimeCorrectionData, mapping));
+#endif /* SWIG */
 typedef struct tagTimeCorrectionData{
   CHAR *timeEphemeris;   /**< File containing the time ephemeris */
 
@@ -160,6 +172,7 @@ typedef struct tagTimeCorrectionData{
   REAL8 dtTtable;        /**< The spacing in sec between consecutive instants in Time ephemeris table.*/
   REAL8 *timeCorrs;      /**< Array of time delays for converting TT to TDB/TCB from the Time table (seconds).*/
   REAL8 timeCorrStart;   /**< The initial GPS time of the time delay table. */
+  EphemerisFileMapping *mapping; /**< Internal: memory mapping of a binary time correction file holding \a timeCorrs, or NULL */
 } TimeCorrectionData;
 
 
@@ -265,11 +278,22 @@ EmissionTime;
 /// internal (opaque) buffer type for optimized Barycentering function
 typedef struct tagBarycenterBuffer BarycenterBuffer;
 
+/// internal (opaque) buffer of sky-independent quantities for batched Barycentering of many arrival times
+typedef struct tagBarycenterBatch BarycenterBatch;
+
 /* Function prototypes. */
 int XLALBarycenterEarth ( EarthState *earth, const LIGOTimeGPS *tGPS, const EphemerisData *edat);
 int XLALBarycenter ( EmissionTime *emit, const BarycenterInput *baryinput, const EarthState *earth);
 int XLALBarycenterOpt ( EmissionTime *emit, const BarycenterInput *baryinput, const EarthState *earth, BarycenterBuffer **buffer);
 
+/* Batched Barycentering of many arrival times for any number of sky positions */
+#ifndef SWIG // exclude from SWIG interface; only useful from C
+BarycenterBatch *XLALCreateBarycenterBatch ( const LALDetector *site, UINT4 length );
+void XLALDestroyBarycenterBatch ( BarycenterBatch *batch );
+int XLALSetBarycenterBatchTime ( BarycenterBatch *batch, UINT4 i, const LIGOTimeGPS *tgps, const EarthState *earth );
+int XLALBarycenterBatch ( REAL8 *deltaT, REAL8 *tDot, const BarycenterBatch *batch, REAL8 alpha, REAL8 delta, REAL8 dInv, UINT4 numThreads );
+#endif
+
 /* Function that uses time delay look-up tables to calculate time delays */
 int XLALBarycenterEarthNew ( EarthState *earth,
                              const LIGOTimeGPS *tGPS,
@@ -246,6 +246,13 @@ void LALHOUGHConstructHMT_W  (LALStatus                  *status,
 			      PHMDVectorSequence         *phmdVS
 			      );
 
+int XLALHOUGHConstructHMTs_W( HOUGHMapTotal *const *ht,
+                              const UINT4 nmaps,
+                              const UINT8FrequencyIndexVector *const *freqInd,
+                              const PHMDVectorSequence *const *phmdVS,
+                              UINT4 num_threads
+                              );
+
 void LALHOUGHWeighSpacePHMD  (LALStatus            *status,
 			      PHMDVectorSequence   *phmdVS,
 			      REAL8Vector *weightV
@@ -18,6 +18,19 @@
 *  MA  02110-1301  USA
 */
 
+#include <config.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 #include <lal/FileIO.h>
 #include <lal/LALBarycenter.h>
 #include <lal/LALInitBarycenter.h>
@@ -32,6 +45,11 @@
 #define NORM3D(x) ( SQ( (x)[0]) + SQ( (x)[1] ) + SQ ( (x)[2] ) )
 #define LENGTH3D(x) ( sqrt( NORM3D ( (x) ) ) )
 
+/* binary ephemeris files */
+#define EPHEM_BINARY_MAGIC      "LALEPHEM"
+#define EPHEM_BINARY_VERSION    1
+#define EPHEM_BINARY_BYTEORDER  0x01020304
+
 /** \endcond */
 
 /* ----- local type definitions ---------- */
@@ -46,9 +64,49 @@ typedef struct
   UINT4 length;      	/**< number of ephemeris-data entries */
   REAL8 dt;      	/**< spacing in seconds between consecutive instants in ephemeris table.*/
   PosVelAcc *data;    	/**< array containing pos,vel,acc as extracted from ephem file. Units are sec, 1, 1/sec respectively */
+  EphemerisType etype;	/**< ephemeris type recorded in a binary ephemeris file, or EPHEM_NONE */
+  EphemerisFileMapping *mapping; /**< memory mapping holding \a data if read from a binary ephemeris file, or NULL */
 }
 EphemerisVector;
 
+/** Kinds of table stored in a binary ephemeris file */
+typedef enum
+{
+  EPHEM_BINARY_POSVELACC = 1,	/**< table of \a PosVelAcc entries of the Earth or Sun */
+  EPHEM_BINARY_TIMECORR = 2	/**< table of \a REAL8 time corrections */
+}
+EphemerisBinaryKind;
+
+/**
+ * Header of a binary ephemeris file. The header is followed directly by \a length table entries of
+ * \a entrySize bytes each, stored in native byte order exactly as they are held in memory, so that
+ * the table can be used in place from a (shared, read-only) memory mapping of the file. The header
+ * is 64 bytes long, which keeps the table aligned for all entry types.
+ */
+typedef struct
+{
+  CHAR magic[8];	/**< EPHEM_BINARY_MAGIC, not NUL-terminated */
+  UINT4 version;	/**< file format version EPHEM_BINARY_VERSION */
+  UINT4 byteOrder;	/**< EPHEM_BINARY_BYTEORDER as written by the creating machine */
+  UINT4 kind;		/**< kind of table, an #EphemerisBinaryKind */
+  UINT4 etype;		/**< #EphemerisType of a position/velocity/acceleration table, or EPHEM_NONE */
+  UINT4 length;		/**< number of table entries */
+  UINT4 entrySize;	/**< size in bytes of each table entry */
+  REAL8 start;		/**< GPS time of the first table entry */
+  REAL8 dt;		/**< spacing in seconds between consecutive table entries */
+  REAL8 end;		/**< GPS time of the last table entry */
+  REAL8 reserved;	/**< reserved for future use, zero */
+}
+EphemerisBinaryHeader;
+
+/** Memory holding the contents of a binary ephemeris file */
+struct tagEphemerisFileMapping
+{
+  void *base;		/**< start of file contents */
+  size_t size;		/**< size of file contents in bytes */
+  BOOLEAN isMapped;	/**< TRUE if \a base is a memory mapping of the file, FALSE if it was read into allocated memory */
+};
+
 /* ----- internal prototypes ---------- */
 EphemerisVector *XLALCreateEphemerisVector ( UINT4 length );
 void XLALDestroyEphemerisVector ( EphemerisVector *ephemV );
@@ -56,6 +114,11 @@ void XLALDestroyEphemerisVector ( EphemerisVector *ephemV );
 EphemerisVector * XLALReadEphemerisFile ( const CHAR *fname);
 int XLALCheckEphemerisRanges ( const EphemerisVector *ephemEarth, REAL8 avg[3], REAL8 range[3] );
 
+static int IsBinaryEphemerisFile ( const char *fname_path );
+static EphemerisFileMapping *MapBinaryEphemerisFile ( const char *fname_path, EphemerisBinaryKind kind, size_t entrySize );
+static void UnmapBinaryEphemerisFile ( EphemerisFileMapping *mapping );
+static int WriteBinaryEphemerisFile ( const CHAR *fname, EphemerisBinaryKind kind, EphemerisType etype, UINT4 length, REAL8 start, REAL8 dt, const void *data, size_t entrySize );
+
 /* ----- function definitions ---------- */
 
 /* ========== exported API ========== */
@@ -78,6 +141,10 @@ int XLALCheckEphemerisRanges ( const EphemerisVector *ephemEarth, REAL8 avg[3],
  * Chebychev polynomials in these files using the conversion in the lalapps code
  * lalapps_create_time_correction_ephemeris
  *
+ * Alternatively, the file may be a binary time correction file written by
+ * XLALWriteBinaryTimeCorrectionFile(); this is detected automatically, and the table of
+ * time delays is then used directly from a read-only memory mapping of the file.
+ *
  * \ingroup LALBarycenter_h
  */
 TimeCorrectionData *
@@ -96,6 +163,29 @@ XLALInitTimeCorrections ( const CHAR *timeCorrectionFile /**< File containing Ea
   char *fname_path;
   XLAL_CHECK_NULL ( (fname_path = XLALPulsarFileResolvePath ( timeCorrectionFile )) != NULL, XLAL_EINVAL );
 
+  /* binary time correction files are used directly from a memory mapping */
+  const int isBinary = IsBinaryEphemerisFile ( fname_path );
+  if ( isBinary != 0 ) {
+    EphemerisFileMapping *mapping = NULL;
+    if ( isBinary > 0 ) {
+      mapping = MapBinaryEphemerisFile ( fname_path, EPHEM_BINARY_TIMECORR, sizeof(REAL8) );
+    }
+    XLALFree ( fname_path );
+    XLAL_CHECK_NULL ( mapping != NULL, XLAL_EFUNC, "Failed to read binary time correction file '%s'\n", timeCorrectionFile );
+    const EphemerisBinaryHeader *header = mapping->base;
+    TimeCorrectionData *tdat;
+    if ( ( tdat = XLALCalloc ( 1, sizeof(*tdat) ) ) == NULL ) {
+      UnmapBinaryEphemerisFile ( mapping );
+      XLAL_ERROR_NULL ( XLAL_ENOMEM, "XLALCalloc ( 1, %zu ) failed.\n", sizeof(*tdat) );
+    }
+    tdat->nentriesT = header->length;
+    tdat->dtTtable = header->dt;
+    tdat->timeCorrStart = header->start;
+    tdat->timeCorrs = (REAL8 *) ( header + 1 );
+    tdat->mapping = mapping;
+    return tdat;
+  }
+
   /* read in file with XLALParseDataFile to ignore comment header lines */
   if ( XLALParseDataFile ( &flines, fname_path ) != XLAL_SUCCESS ) {
     XLALFree ( fname_path );
@@ -165,7 +255,9 @@ XLALDestroyTimeCorrectionData ( TimeCorrectionData *tcd )
   if ( !tcd )
     return;
 
-  if ( tcd->timeCorrs )
+  if ( tcd->mapping )
+    UnmapBinaryEphemerisFile ( tcd->mapping );
+  else if ( tcd->timeCorrs )
     XLALFree ( tcd->timeCorrs );
 
   XLALFree ( tcd );
@@ -192,6 +284,13 @@ XLALDestroyTimeCorrectionData ( TimeCorrectionData *tcd )
  * at that instant.  All in units of seconds; e.g. positions have
  * units of seconds, and accelerations have units 1/sec.
  *
+ * Alternatively, either file may be a binary ephemeris file written by
+ * XLALWriteBinaryEphemerisFiles(); this is detected automatically, and the
+ * ephemeris table is then used directly from a read-only memory mapping of the
+ * file, so that startup avoids parsing the ASCII tables and processes on the
+ * same machine share a single copy of the table in memory. The ephemeris type
+ * recorded in a binary file takes precedence over the type inferred from its name.
+ *
  * \ingroup LALBarycenter_h
  */
 EphemerisData *
@@ -233,13 +332,6 @@ XLALInitBarycenter ( const CHAR *earthEphemerisFile,         /**< File containin
   else
     sun_etype = EPHEM_DE405;
 
-  // check consistency
-  if ( earth_etype != sun_etype )
-    XLAL_ERROR_NULL (XLAL_EINVAL, "Earth '%s' and Sun '%s' ephemeris-files have inconsistent coordinate-types %d != %d\n",
-                     earthEphemerisFile, sunEphemerisFile, earth_etype, sun_etype );
-  else
-    etype = earth_etype;
-
   EphemerisVector *ephemV;
   /* ----- read EARTH ephemeris file ---------- */
   if ( ( ephemV = XLALReadEphemerisFile ( earthEphemerisFile )) == NULL )
@@ -264,7 +356,9 @@ XLALInitBarycenter ( const CHAR *earthEphemerisFile,         /**< File containin
   edat->nentriesE = ephemV->length;
   edat->dtEtable  = ephemV->dt;
   edat->ephemE    = ephemV->data;
-  edat->etype     = etype;
+  edat->mappingE  = ephemV->mapping;
+  if ( ephemV->etype != EPHEM_NONE )
+    earth_etype = ephemV->etype;
   XLALFree ( ephemV );	/* don't use 'destroy', as we linked the data into edat! */
   ephemV = NULL;
 
@@ -290,9 +384,23 @@ XLALInitBarycenter ( const CHAR *earthEphemerisFile,         /**< File containin
   edat->nentriesS = ephemV->length;
   edat->dtStable  = ephemV->dt;
   edat->ephemS    = ephemV->data;
+  edat->mappingS  = ephemV->mapping;
+  if ( ephemV->etype != EPHEM_NONE )
+    sun_etype = ephemV->etype;
   XLALFree ( ephemV );	/* don't use 'destroy', as we linked the data into edat! */
   ephemV = NULL;
 
+  // check consistency
+  if ( earth_etype != sun_etype )
+    {
+      XLALDestroyEphemerisData ( edat );
+      XLAL_ERROR_NULL (XLAL_EINVAL, "Earth '%s' and Sun '%s' ephemeris-files have inconsistent coordinate-types %d != %d\n",
+                       earthEphemerisFile, sunEphemerisFile, earth_etype, sun_etype );
+    }
+  else
+    etype = earth_etype;
+  edat->etype = etype;
+
   // store *copy* of ephemeris-file names in output structure
   edat->filenameE = XLALStringDuplicate( earthEphemerisFile );
   edat->filenameS = XLALStringDuplicate( sunEphemerisFile );
@@ -319,10 +427,14 @@ XLALDestroyEphemerisData ( EphemerisData *edat )
   if ( edat->filenameS )
     XLALFree ( edat->filenameS );
 
-  if ( edat->ephemE )
+  if ( edat->mappingE )
+    UnmapBinaryEphemerisFile ( edat->mappingE );
+  else if ( edat->ephemE )
     XLALFree ( edat->ephemE );
 
-  if ( edat->ephemS )
+  if ( edat->mappingS )
+    UnmapBinaryEphemerisFile ( edat->mappingS );
+  else if ( edat->ephemS )
     XLALFree ( edat->ephemS );
 
   XLALFree ( edat );
@@ -363,11 +475,14 @@ int XLALRestrictEphemerisData ( EphemerisData *edat, const LIGOTimeGPS *startGPS
   } while(1);
 
   // Reallocate 'ephemE' to new table size, and free old table
-  PosVelAcc *const new_ephemE = XLALMalloc(edat->nentriesE * sizeof(*new_ephemE));
-  XLAL_CHECK(new_ephemE != NULL, XLAL_ENOMEM);
-  memcpy(new_ephemE, edat->ephemE, edat->nentriesE * sizeof(*new_ephemE));
-  edat->ephemE = new_ephemE;
-  XLALFree(old_ephemE);
+  // - a table in a memory-mapped binary ephemeris file is simply viewed in place
+  if (edat->mappingE == NULL) {
+    PosVelAcc *const new_ephemE = XLALMalloc(edat->nentriesE * sizeof(*new_ephemE));
+    XLAL_CHECK(new_ephemE != NULL, XLAL_ENOMEM);
+    memcpy(new_ephemE, edat->ephemE, edat->nentriesE * sizeof(*new_ephemE));
+    edat->ephemE = new_ephemE;
+    XLALFree(old_ephemE);
+  }
 
   // Increase 'ephemS' and decrease 'nentriesS' to fit the range ['start', 'end']
   PosVelAcc *const old_ephemS = edat->ephemS;
@@ -383,17 +498,80 @@ int XLALRestrictEphemerisData ( EphemerisData *edat, const LIGOTimeGPS *startGPS
   } while(1);
 
   // Reallocate 'ephemS' to new table size, and free old table
-  PosVelAcc *const new_ephemS = XLALMalloc(edat->nentriesS * sizeof(*new_ephemS));
-  XLAL_CHECK(new_ephemS != NULL, XLAL_ENOMEM);
-  memcpy(new_ephemS, edat->ephemS, edat->nentriesS * sizeof(*new_ephemS));
-  edat->ephemS = new_ephemS;
-  XLALFree(old_ephemS);
+  // - a table in a memory-mapped binary ephemeris file is simply viewed in place
+  if (edat->mappingS == NULL) {
+    PosVelAcc *const new_ephemS = XLALMalloc(edat->nentriesS * sizeof(*new_ephemS));
+    XLAL_CHECK(new_ephemS != NULL, XLAL_ENOMEM);
+    memcpy(new_ephemS, edat->ephemS, edat->nentriesS * sizeof(*new_ephemS));
+    edat->ephemS = new_ephemS;
+    XLALFree(old_ephemS);
+  }
 
   return XLAL_SUCCESS;
 
 } /* XLALRestrictEphemerisData() */
 
 
+/**
+ * Write the Earth and Sun ephemerides in 'edat' to binary ephemeris files, which can be read
+ * by XLALInitBarycenter() in place of the ASCII ephemeris files they were created from.
+ *
+ * Binary ephemeris files store the position/velocity/acceleration tables exactly as they are
+ * held in memory, and are therefore specific to the byte order of the machine that wrote them.
+ * Either output filename may be NULL, in which case that file is not written.
+ *
+ * \ingroup LALBarycenter_h
+ */
+int
+XLALWriteBinaryEphemerisFiles ( const EphemerisData *edat,	/**< [in] ephemeris data to write */
+                                const CHAR *earthBinaryFile,	/**< [in] output binary Earth ephemeris file, or NULL */
+                                const CHAR *sunBinaryFile	/**< [in] output binary Sun ephemeris file, or NULL */
+                                )
+{
+  XLAL_CHECK ( edat != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( edat->nentriesE > 0 && edat->ephemE != NULL, XLAL_EINVAL, "Empty Earth ephemeris table\n" );
+  XLAL_CHECK ( edat->nentriesS > 0 && edat->ephemS != NULL, XLAL_EINVAL, "Empty Sun ephemeris table\n" );
+
+  if ( earthBinaryFile != NULL ) {
+    XLAL_CHECK ( WriteBinaryEphemerisFile ( earthBinaryFile, EPHEM_BINARY_POSVELACC, edat->etype, edat->nentriesE,
+                                            edat->ephemE[0].gps, edat->dtEtable, edat->ephemE, sizeof(edat->ephemE[0]) ) == XLAL_SUCCESS,
+                 XLAL_EFUNC, "Failed to write binary Earth ephemeris file '%s'\n", earthBinaryFile );
+  }
+  if ( sunBinaryFile != NULL ) {
+    XLAL_CHECK ( WriteBinaryEphemerisFile ( sunBinaryFile, EPHEM_BINARY_POSVELACC, edat->etype, edat->nentriesS,
+                                            edat->ephemS[0].gps, edat->dtStable, edat->ephemS, sizeof(edat->ephemS[0]) ) == XLAL_SUCCESS,
+                 XLAL_EFUNC, "Failed to write binary Sun ephemeris file '%s'\n", sunBinaryFile );
+  }
+
+  return XLAL_SUCCESS;
+
+} /* XLALWriteBinaryEphemerisFiles() */
+
+
+/**
+ * Write the time corrections in 'tdat' to a binary time correction file, which can be read
+ * by XLALInitTimeCorrections() in place of the ASCII time correction file it was created from.
+ *
+ * \ingroup LALBarycenter_h
+ */
+int
+XLALWriteBinaryTimeCorrectionFile ( const TimeCorrectionData *tdat,		/**< [in] time corrections to write */
+                                    const CHAR *timeCorrectionBinaryFile	/**< [in] output binary time correction file */
+                                    )
+{
+  XLAL_CHECK ( tdat != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( timeCorrectionBinaryFile != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( tdat->nentriesT > 0 && tdat->timeCorrs != NULL, XLAL_EINVAL, "Empty time correction table\n" );
+
+  XLAL_CHECK ( WriteBinaryEphemerisFile ( timeCorrectionBinaryFile, EPHEM_BINARY_TIMECORR, EPHEM_NONE, tdat->nentriesT,
+                                          tdat->timeCorrStart, tdat->dtTtable, tdat->timeCorrs, sizeof(tdat->timeCorrs[0]) ) == XLAL_SUCCESS,
+               XLAL_EFUNC, "Failed to write binary time correction file '%s'\n", timeCorrectionBinaryFile );
+
+  return XLAL_SUCCESS;
+
+} /* XLALWriteBinaryTimeCorrectionFile() */
+
+
 /* ========== internal function definitions ========== */
 
 /** simple creator function for EphemerisVector type */
@@ -425,7 +603,9 @@ XLALDestroyEphemerisVector ( EphemerisVector *ephemV )
   if ( !ephemV )
     return;
 
-  if ( ephemV->data )
+  if ( ephemV->mapping )
+    UnmapBinaryEphemerisFile ( ephemV->mapping );
+  else if ( ephemV->data )
     XLALFree ( ephemV->data );
 
   XLALFree ( ephemV );
@@ -454,6 +634,9 @@ XLALPulsarFileResolvePath ( const char *fname	  //!< [in] filename or file-path
  *
  * NOTE2: files are searches first locally, then in LAL_DATA_PATH, and finally in PKG_DATA_DIR
  * using XLALPulsarFileResolvePath()
+ *
+ * NOTE3: binary ephemeris files written by XLALWriteBinaryEphemerisFiles() are recognised by
+ * their header, and are memory-mapped instead of parsed.
  */
 EphemerisVector *
 XLALReadEphemerisFile ( const CHAR *fname )
@@ -480,6 +663,31 @@ XLALReadEphemerisFile ( const CHAR *fname )
 
   // if we're here, it means we found it
 
+  // binary ephemeris files are used directly from a memory mapping
+  const int isBinary = IsBinaryEphemerisFile ( fname_path );
+  if ( isBinary != 0 )
+    {
+      EphemerisFileMapping *mapping = NULL;
+      if ( isBinary > 0 ) {
+        mapping = MapBinaryEphemerisFile ( fname_path, EPHEM_BINARY_POSVELACC, sizeof(PosVelAcc) );
+      }
+      XLALFree ( fname_path );
+      XLAL_CHECK_NULL ( mapping != NULL, XLAL_EFUNC, "Failed to read binary ephemeris-file '%s'\n", fname );
+      const EphemerisBinaryHeader *header = mapping->base;
+      EphemerisVector *ephemV;
+      if ( ( ephemV = XLALCalloc ( 1, sizeof(*ephemV) ) ) == NULL )
+        {
+          UnmapBinaryEphemerisFile ( mapping );
+          XLAL_ERROR_NULL ( XLAL_ENOMEM, "Failed to XLALCalloc(1, %zu)\n", sizeof(*ephemV) );
+        }
+      ephemV->length  = header->length;
+      ephemV->dt      = header->dt;
+      ephemV->data    = (PosVelAcc *) ( header + 1 );
+      ephemV->etype   = header->etype;
+      ephemV->mapping = mapping;
+      return ephemV;
+    }
+
   // read in whole file (compressed or not) with XLALParseDataFile(), which ignores comment header lines
   LALParsedDataFile *flines = NULL;
   XLAL_CHECK_NULL ( XLALParseDataFile ( &flines, fname_path ) == XLAL_SUCCESS, XLAL_EFUNC );
@@ -648,3 +856,172 @@ XLALCheckEphemerisRanges ( const EphemerisVector *ephemV, REAL8 avg[3], REAL8 ra
   return XLAL_SUCCESS;
 
 } /* XLALCheckEphemerisRanges() */
+
+
+/**
+ * Check whether a file is a binary ephemeris file, by looking for EPHEM_BINARY_MAGIC at its start.
+ * Returns 1 if it is, 0 if it is not (e.g. an ASCII or gzip-compressed ephemeris file), and -1 on error.
+ */
+static int
+IsBinaryEphemerisFile ( const char *fname_path )
+{
+  FILE *fp;
+  if ( ( fp = fopen ( fname_path, "rb" ) ) == NULL )
+    {
+      XLALPrintError ( "ERROR: Couldn't open file '%s': %s\n", fname_path, strerror(errno) );
+      return -1;
+    }
+  CHAR magic[sizeof(EPHEM_BINARY_MAGIC) - 1];
+  const size_t n = fread ( magic, 1, sizeof(magic), fp );
+  fclose ( fp );
+  return ( n == sizeof(magic) && memcmp ( magic, EPHEM_BINARY_MAGIC, sizeof(magic) ) == 0 ) ? 1 : 0;
+} /* IsBinaryEphemerisFile() */
+
+
+/**
+ * Map a binary ephemeris file into memory, and check that its header is consistent with a table of the given
+ * kind and entry size. The file is memory-mapped read-only and shared where possible, otherwise it is read
+ * into allocated memory.
+ */
+static EphemerisFileMapping *
+MapBinaryEphemerisFile ( const char *fname_path, EphemerisBinaryKind kind, size_t entrySize )
+{
+  EphemerisFileMapping *mapping;
+  XLAL_CHECK_NULL ( ( mapping = XLALCalloc ( 1, sizeof(*mapping) ) ) != NULL, XLAL_ENOMEM );
+
+#ifdef HAVE_SYS_MMAN_H
+  {
+    int fd;
+    struct stat st;
+    if ( ( fd = open ( fname_path, O_RDONLY ) ) >= 0 )
+      {
+        if ( fstat ( fd, &st ) == 0 && st.st_size > 0 )
+          {
+            void *base = mmap ( NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0 );
+            if ( base != MAP_FAILED )
+              {
+                mapping->base = base;
+                mapping->size = st.st_size;
+                mapping->isMapped = 1;
+              }
+          }
+        close ( fd );
+      }
+  }
+#endif
+
+  // fall back to reading the file into memory
+  if ( mapping->base == NULL )
+    {
+      FILE *fp;
+      if ( ( fp = fopen ( fname_path, "rb" ) ) == NULL )
+        {
+          XLALFree ( mapping );
+          XLAL_ERROR_NULL ( XLAL_EIO, "Couldn't open file '%s': %s\n", fname_path, strerror(errno) );
+        }
+      long size = -1;
+      if ( fseek ( fp, 0, SEEK_END ) == 0 )
+        size = ftell ( fp );
+      if ( size <= 0 || fseek ( fp, 0, SEEK_SET ) != 0 || ( mapping->base = XLALMalloc ( size ) ) == NULL
+           || fread ( mapping->base, 1, size, fp ) != (size_t) size )
+        {
+          fclose ( fp );
+          UnmapBinaryEphemerisFile ( mapping );
+          XLAL_ERROR_NULL ( XLAL_EIO, "Couldn't read file '%s'\n", fname_path );
+        }
+      fclose ( fp );
+      mapping->size = size;
+    }
+
+  // check header
+  const EphemerisBinaryHeader *header = mapping->base;
+  int errnum = 0;
+  if ( mapping->size < sizeof(*header) || memcmp ( header->magic, EPHEM_BINARY_MAGIC, sizeof(header->magic) ) != 0 )
+    {
+      errnum = XLAL_EIO;
+      XLALPrintError ( "ERROR: '%s' is not a binary ephemeris file\n", fname_path );
+    }
+  else if ( header->byteOrder != EPHEM_BINARY_BYTEORDER )
+    {
+      errnum = XLAL_EIO;
+      XLALPrintError ( "ERROR: Binary ephemeris file '%s' was written on a machine with a different byte order\n", fname_path );
+    }
+  else if ( header->version != EPHEM_BINARY_VERSION )
+    {
+      errnum = XLAL_EIO;
+      XLALPrintError ( "ERROR: Binary ephemeris file '%s' has unsupported version %u\n", fname_path, header->version );
+    }
+  else if ( header->kind != (UINT4) kind || header->entrySize != entrySize || header->etype >= EPHEM_LAST )
+    {
+      errnum = XLAL_EIO;
+      XLALPrintError ( "ERROR: Binary ephemeris file '%s' does not contain the expected kind of table\n", fname_path );
+    }
+  else if ( header->length == 0 || !( header->dt > 0 ) || mapping->size != sizeof(*header) + ( (size_t) header->length ) * entrySize )
+    {
+      errnum = XLAL_EIO;
+      XLALPrintError ( "ERROR: Binary ephemeris file '%s' has inconsistent length\n", fname_path );
+    }
+  if ( errnum != 0 )
+    {
+      UnmapBinaryEphemerisFile ( mapping );
+      XLAL_ERROR_NULL ( errnum );
+    }
+
+  return mapping;
+
+} /* MapBinaryEphemerisFile() */
+
+
+/**
+ * Unmap or free the contents of a binary ephemeris file, NULL robust.
+ */
+static void
+UnmapBinaryEphemerisFile ( EphemerisFileMapping *mapping )
+{
+  if ( !mapping )
+    return;
+
+#ifdef HAVE_SYS_MMAN_H
+  if ( mapping->isMapped )
+    munmap ( mapping->base, mapping->size );
+  else
+#endif
+    XLALFree ( mapping->base );
+
+  XLALFree ( mapping );
+
+  return;
+
+} /* UnmapBinaryEphemerisFile() */
+
+
+/**
+ * Write a table of ephemeris data to a binary ephemeris file.
+ */
+static int
+WriteBinaryEphemerisFile ( const CHAR *fname, EphemerisBinaryKind kind, EphemerisType etype, UINT4 length, REAL8 start, REAL8 dt, const void *data, size_t entrySize )
+{
+  XLAL_CHECK ( dt > 0, XLAL_EINVAL, "Invalid table spacing dt = %g\n", dt );
+
+  EphemerisBinaryHeader XLAL_INIT_DECL(header);
+  memcpy ( header.magic, EPHEM_BINARY_MAGIC, sizeof(header.magic) );
+  header.version = EPHEM_BINARY_VERSION;
+  header.byteOrder = EPHEM_BINARY_BYTEORDER;
+  header.kind = kind;
+  header.etype = etype;
+  header.length = length;
+  header.entrySize = entrySize;
+  header.start = start;
+  header.dt = dt;
+  header.end = start + ( length - 1 ) * dt;
+
+  FILE *fp;
+  XLAL_CHECK ( ( fp = fopen ( fname, "wb" ) ) != NULL, XLAL_EIO, "Couldn't open file '%s' for writing: %s\n", fname, strerror(errno) );
+  int ok = ( fwrite ( &header, sizeof(header), 1, fp ) == 1 );
+  ok = ok && ( fwrite ( data, entrySize, length, fp ) == length );
+  ok = ( fclose ( fp ) == 0 ) && ok;
+  XLAL_CHECK ( ok, XLAL_EIO, "Failed to write file '%s'\n", fname );
+
+  return XLAL_SUCCESS;
+
+} /* WriteBinaryEphemerisFile() */
@@ -39,6 +39,9 @@ void XLALDestroyTimeCorrectionData( TimeCorrectionData *tcd );
 
 char *XLALPulsarFileResolvePath ( const char *fname );
 
+int XLALWriteBinaryEphemerisFiles ( const EphemerisData *edat, const CHAR *earthBinaryFile, const CHAR *sunBinaryFile );
+int XLALWriteBinaryTimeCorrectionFile ( const TimeCorrectionData *tdat, const CHAR *timeCorrectionBinaryFile );
+
 /** \endcond */
 
 #ifdef  __cplusplus
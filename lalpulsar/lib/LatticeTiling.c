@@ -24,6 +24,10 @@
 #include <gsl/gsl_blas.h>
 #include <gsl/gsl_linalg.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include <lal/LatticeTiling.h>
 #include <lal/LALStdio.h>
 #include <lal/LALHashFunc.h>
@@ -62,11 +66,22 @@ typedef struct tagLT_Bound {
 ///
 typedef struct tagLT_Callback {
   LatticeTilingCallback func;           ///< Callback function
+  LatticeTilingCallbackMerge merge;     ///< Function which merges output data of callback function (optional)
   size_t param_len;                     ///< Length of arbitrary input data for use by callback function
   char param[LT_DATA_MAX_SIZE];         ///< Arbitrary input data for use by callback function
+  size_t out_len;                       ///< Length of output data to be filled by callback function
   char out[LT_DATA_MAX_SIZE];           ///< Output data to be filled by callback function
 } LT_Callback;
 
+///
+/// Number of lattice tiling points at each point in the outermost tiled dimension.
+///
+typedef struct tagLT_PointCounts {
+  INT4 outer_lower;                     ///< Lower bound on outermost tiled dimension in generating integers
+  size_t nouter;                        ///< Number of points in outermost tiled dimension
+  UINT8 *counts;                        ///< Number of points up to each dimension (rows) at each outer point (columns)
+} LT_PointCounts;
+
 ///
 /// FITS record for for saving and restoring a lattice tiling iterator.
 ///
@@ -79,6 +94,19 @@ typedef struct tagLT_FITSRecord {
   INT4 direction;                       ///< Direction of iteration in each tiled parameter-space dimension
 } LT_FITSRecord;
 
+///
+/// FITS record for for saving and restoring lattice tiling statistics and point counts.
+///
+typedef struct tagLT_CountsFITSRecord {
+  INT4 checksum;                        ///< Checksum of various data describing parameter-space bounds
+  UINT8 total_points;                   ///< Total number of points up to this dimension
+  UINT4 min_points;                     ///< Minimum number of points in this dimension
+  UINT4 max_points;                     ///< Maximum number of points in this dimension
+  REAL8 min_value;                      ///< Minimum value of points in this dimension
+  REAL8 max_value;                      ///< Maximum value of points in this dimension
+  UINT8 *counts;                        ///< Number of points up to this dimension at each outer point
+} LT_CountsFITSRecord;
+
 ///
 /// Lattice tiling index trie for one dimension.
 ///
@@ -105,7 +133,9 @@ struct tagLatticeTiling {
   size_t ncallback;                     ///< Number of registered callbacks
   LT_Callback **callbacks;              ///< Registered callbacks
   size_t *ncallback_done;               ///< Pointer to number of successfully performed callbacks (mutable)
+  UINT4 num_threads;                    ///< Number of threads with which to perform callbacks
   const LatticeTilingStats *stats;      ///< Lattice tiling statistics computed by default callback
+  LT_PointCounts *point_counts;         ///< Pointer to number of points at each outer point (mutable)
 };
 
 struct tagLatticeTilingIterator {
@@ -123,6 +153,13 @@ struct tagLatticeTilingIterator {
   INT4 *int_upper;                      ///< Current upper parameter-space bound in generating integers
   INT4 *direction;                      ///< Direction of iteration in each tiled parameter-space dimension
   UINT8 index;                          ///< Index of current lattice tiling point
+  UINT4 partition_count;                ///< Number of partitions of blocks returned by XLALNextLatticeTilingBlock()
+  UINT4 partition_index;                ///< Index of partition of blocks returned by XLALNextLatticeTilingBlock()
+  UINT8 block_index;                    ///< Index of next block of points considered by XLALNextLatticeTilingBlock()
+  bool outer_limited;                   ///< If true, restrict iteration over the outermost tiled dimension
+  INT4 outer_lower;                     ///< Lower limit on outermost tiled dimension in generating integers
+  INT4 outer_upper;                     ///< Upper limit on outermost tiled dimension in generating integers
+  UINT8 outer_first_index;              ///< Index of first point within limits on outermost tiled dimension
 };
 
 struct tagLatticeTilingLocator {
@@ -349,6 +386,73 @@ static int LT_StatsCallback(
 
 }
 
+///
+/// Merge function for lattice tiling statistics callback
+///
+static int LT_StatsMerge(
+  const LatticeTiling *tiling,
+  const void *param UNUSED,
+  void *out,
+  const void *other_out
+  )
+{
+
+  LatticeTilingStats *stats = ( LatticeTilingStats * ) out;
+  const LatticeTilingStats *other_stats = ( const LatticeTilingStats * ) other_out;
+
+  const size_t n = XLALTotalLatticeTilingDimensions( tiling );
+
+  // Statistics are only merged over points in the outermost tiled dimension; lower dimensions
+  // are not tiled, and so are the same in both outputs
+  const size_t outer_i = ( tiling->tiled_ndim > 0 ) ? tiling->tiled_idx[0] : n;
+
+  // Merge statistics
+  for ( size_t i = outer_i; i < n; ++i ) {
+    stats[i].total_points += other_stats[i].total_points;
+    stats[i].min_points = GSL_MIN( stats[i].min_points, other_stats[i].min_points );
+    stats[i].max_points = GSL_MAX( stats[i].max_points, other_stats[i].max_points );
+    stats[i].min_value = GSL_MIN( stats[i].min_value, other_stats[i].min_value );
+    stats[i].max_value = GSL_MAX( stats[i].max_value, other_stats[i].max_value );
+  }
+
+  return XLAL_SUCCESS;
+
+}
+
+///
+/// Compute a checksum of various data describing the parameter-space bounds in a dimension
+///
+static int LT_BoundChecksum(
+  const LatticeTiling *tiling,
+  const size_t i,
+  INT4 *checksum
+  )
+{
+  *checksum = 0;
+  XLAL_CHECK( XLALPearsonHash( checksum, sizeof( *checksum ), &tiling->bounds[i].is_tiled, sizeof( tiling->bounds[i].is_tiled ) ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLALPearsonHash( checksum, sizeof( *checksum ), &tiling->bounds[i].data_len, sizeof( tiling->bounds[i].data_len ) ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLALPearsonHash( checksum, sizeof( *checksum ), tiling->bounds[i].data_lower, tiling->bounds[i].data_len ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLALPearsonHash( checksum, sizeof( *checksum ), tiling->bounds[i].data_upper, tiling->bounds[i].data_len ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLALPearsonHash( checksum, sizeof( *checksum ), &tiling->bounds[i].padf, sizeof( tiling->bounds[i].padf ) ) == XLAL_SUCCESS, XLAL_EFUNC );
+  return XLAL_SUCCESS;
+}
+
+///
+/// Compute a checksum of the lattice generator and origin of a lattice tiling
+///
+static int LT_LatticeChecksum(
+  const LatticeTiling *tiling,
+  INT4 *checksum
+  )
+{
+  *checksum = 0;
+  for ( size_t i = 0; i < tiling->ndim; ++i ) {
+    XLAL_CHECK( XLALPearsonHash( checksum, sizeof( *checksum ), gsl_matrix_const_ptr( tiling->phys_from_int, i, 0 ), tiling->ndim * sizeof( double ) ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( XLALPearsonHash( checksum, sizeof( *checksum ), gsl_vector_const_ptr( tiling->phys_origin, i ), sizeof( double ) ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+  return XLAL_SUCCESS;
+}
+
 ///
 /// Initialise FITS table for saving and restoring a lattice tiling iterator
 ///
@@ -364,6 +468,22 @@ static int LT_InitFITSRecordTable( FITSFile *file )
   return XLAL_SUCCESS;
 }
 
+///
+/// Initialise FITS table for saving and restoring lattice tiling statistics and point counts
+///
+static int LT_InitCountsFITSRecordTable( FITSFile *file, const size_t nouter )
+{
+  XLAL_FITS_TABLE_COLUMN_BEGIN( LT_CountsFITSRecord );
+  XLAL_CHECK( XLAL_FITS_TABLE_COLUMN_ADD( file, INT4, checksum ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLAL_FITS_TABLE_COLUMN_ADD( file, UINT8, total_points ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLAL_FITS_TABLE_COLUMN_ADD( file, UINT4, min_points ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLAL_FITS_TABLE_COLUMN_ADD( file, UINT4, max_points ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLAL_FITS_TABLE_COLUMN_ADD( file, REAL8, min_value ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLAL_FITS_TABLE_COLUMN_ADD( file, REAL8, max_value ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLAL_FITS_TABLE_COLUMN_ADD_PTR_ARRAY( file, UINT8, nouter, counts ) == XLAL_SUCCESS, XLAL_EFUNC );
+  return XLAL_SUCCESS;
+}
+
 ///
 /// Free memory pointed to by an index trie. The trie itself should be freed by the caller.
 ///
@@ -810,10 +930,13 @@ LatticeTiling *XLALCreateLatticeTiling(
   XLAL_CHECK_NULL( tiling->bounds != NULL, XLAL_ENOMEM );
   tiling->ncallback_done = XLALCalloc( 1, sizeof( *tiling->ncallback_done ) );
   XLAL_CHECK_NULL( tiling->ncallback_done != NULL, XLAL_ENOMEM );
+  tiling->point_counts = XLALCalloc( 1, sizeof( *tiling->point_counts ) );
+  XLAL_CHECK_NULL( tiling->point_counts != NULL, XLAL_ENOMEM );
 
   // Initialise fields
   tiling->ndim = ndim;
   tiling->lattice = TILING_LATTICE_MAX;
+  tiling->num_threads = 1;
   for ( size_t i = 0; i < ndim; ++i ) {
     tiling->bounds[i].padf = LATTICE_TILING_PAD_LHBBX | LATTICE_TILING_PAD_UHBBX;
   }
@@ -843,6 +966,10 @@ void XLALDestroyLatticeTiling(
     }
     XLALFree( tiling->callbacks );
     XLALFree( tiling->ncallback_done );
+    if ( tiling->point_counts != NULL ) {
+      XLALFree( tiling->point_counts->counts );
+      XLALFree( tiling->point_counts );
+    }
     GFMAT( tiling->int_from_phys, tiling->phys_from_int, tiling->tiled_generator );
     GFVEC( tiling->phys_bbox, tiling->phys_origin, tiling->phys_origin_shift_frac );
     XLALFree( tiling );
@@ -1141,7 +1268,7 @@ int XLALSetTilingLatticeAndMetric(
   }
 
   // Register default statistics callback function
-  tiling->stats = XLALRegisterLatticeTilingCallback( tiling, LT_StatsCallback, 0, NULL, tiling->ndim * sizeof( *tiling->stats ) );
+  tiling->stats = XLALRegisterMergeableLatticeTilingCallback( tiling, LT_StatsCallback, LT_StatsMerge, 0, NULL, tiling->ndim * sizeof( *tiling->stats ) );
   XLAL_CHECK( tiling->stats != NULL, XLAL_EFUNC );
 
   // Count number of tiled dimensions; if no parameter-space dimensions are tiled, we're done
@@ -1508,6 +1635,20 @@ const void *XLALRegisterLatticeTilingCallback(
   const size_t out_len
   )
 {
+  const void *out = XLALRegisterMergeableLatticeTilingCallback( tiling, func, NULL, param_len, param, out_len );
+  XLAL_CHECK_NULL( out != NULL, XLAL_EFUNC );
+  return out;
+}
+
+const void *XLALRegisterMergeableLatticeTilingCallback(
+  LatticeTiling *tiling,
+  const LatticeTilingCallback func,
+  const LatticeTilingCallbackMerge merge,
+  const size_t param_len,
+  const void *param,
+  const size_t out_len
+  )
+{
 
   // Check input
   XLAL_CHECK_NULL( tiling != NULL, XLAL_EFAULT );
@@ -1527,15 +1668,104 @@ const void *XLALRegisterLatticeTilingCallback(
 
   // Set fields
   cb->func = func;
+  cb->merge = merge;
   cb->param_len = param_len;
   if ( param_len > 0 ) {
     memcpy( cb->param, param, param_len );
   }
+  cb->out_len = out_len;
 
   return cb->out;
 
 }
 
+int XLALSetLatticeTilingCallbackThreads(
+  LatticeTiling *tiling,
+  const UINT4 num_threads
+  )
+{
+
+  // Check input
+  XLAL_CHECK( tiling != NULL, XLAL_EFAULT );
+
+  // Set number of threads
+  tiling->num_threads = num_threads;
+
+  return XLAL_SUCCESS;
+
+}
+
+static int LT_NextPoint( LatticeTilingIterator *itr );
+
+///
+/// Perform lattice tiling callbacks, starting from callback \c m0, over all points of an iterator
+/// at one point in the outermost tiled dimension, with output data stored in \c outs. Optionally
+/// count the number of points up to each dimension, and store in column \c k of \c counts.
+///
+static int LT_PerformCallbacksAtOuterPoint(
+  LatticeTilingIterator *itr,
+  const INT4 outer_point,
+  const bool first_call,
+  const size_t m0,
+  void *const *outs,
+  UINT8 *counts,
+  const size_t nouter,
+  const size_t k
+  )
+{
+
+  const LatticeTiling *tiling = itr->tiling;
+  const size_t n = tiling->ndim;
+  const size_t outer_i = tiling->tiled_idx[0];
+
+  // Restrict iterator to the given point in the outermost tiled dimension
+  XLAL_CHECK( XLALResetLatticeTilingIterator( itr ) == XLAL_SUCCESS, XLAL_EFUNC );
+  itr->outer_limited = true;
+  itr->outer_lower = itr->outer_upper = outer_point;
+  itr->outer_first_index = 0;
+
+  // Iterate over all points
+  bool first = first_call;
+  UINT8 count[n];
+  memset( count, 0, sizeof( count ) );
+  int changed_ti_p1;
+  while ( ( changed_ti_p1 = LT_NextPoint( itr ) ) > 0 ) {
+    const size_t changed_i = first ? 0 : tiling->tiled_idx[changed_ti_p1 - 1];
+
+    // Call callback functions
+    for ( size_t m = m0; m < tiling->ncallback; ++m ) {
+      LT_Callback *cb = tiling->callbacks[m];
+      XLAL_CHECK( ( cb->func )( first, tiling, itr, itr->phys_point, changed_i, cb->param, outs[m - m0] ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+    first = false;
+
+    // Count points, as in LT_StatsCallback()
+    if ( counts != NULL ) {
+      for ( size_t i = GSL_MAX( changed_i, outer_i ); i < n; ++i ) {
+        if ( i + 1 == n ) {
+          INT4 left = 0, right = 0;
+          XLAL_CHECK( XLALCurrentLatticeTilingBlock( itr, i, &left, &right ) == XLAL_SUCCESS, XLAL_EFUNC );
+          count[i] += right - left + 1;
+        } else {
+          count[i] += 1;
+        }
+      }
+    }
+
+  }
+  XLAL_CHECK( changed_ti_p1 == 0, XLAL_EFUNC );
+
+  // Store point counts
+  if ( counts != NULL ) {
+    for ( size_t i = 0; i < n; ++i ) {
+      counts[i * nouter + k] = count[i];
+    }
+  }
+
+  return XLAL_SUCCESS;
+
+}
+
 int XLALPerformLatticeTilingCallbacks(
   const LatticeTiling *tiling
   )
@@ -1551,25 +1781,150 @@ int XLALPerformLatticeTilingCallbacks(
   }
 
   const size_t n = tiling->ndim;
+  const size_t tn = tiling->tiled_ndim;
+  const size_t m0 = *tiling->ncallback_done;
+  const size_t ncb = tiling->ncallback - m0;
+
+  // Count points at each outer point if this has not already been done
+  LT_PointCounts *point_counts = tiling->point_counts;
+  const bool count_points = ( point_counts->counts == NULL );
 
   // Create iterator over tiling (except highest dimension)
   LatticeTilingIterator *itr = XLALCreateLatticeTilingIterator( tiling, n - 1 );
   XLAL_CHECK( itr != NULL, XLAL_EFUNC );
 
-  // Iterate over all points
-  bool first_call = true;
-  int changed_ti_p1;
-  double point_array[n];
-  gsl_vector_view point_view = gsl_vector_view_array( point_array, n );
-  while ( ( changed_ti_p1 = XLALNextLatticeTilingPoint( itr, &point_view.vector ) ) > 0 ) {
-    const size_t changed_i = ( !first_call && tiling->tiled_ndim > 0 ) ? tiling->tiled_idx[changed_ti_p1 - 1] : 0;
+  if ( tn == 0 || tiling->tiled_idx[0] + 1 == n ) {
+
+    // Iterator does not iterate over any tiled dimensions, and so visits only one point
 
     // Call callback functions
-    for ( size_t m = *tiling->ncallback_done; m < tiling->ncallback; ++m ) {
+    const int changed_ti_p1 = LT_NextPoint( itr );
+    XLAL_CHECK( changed_ti_p1 > 0, XLAL_EFUNC );
+    for ( size_t m = m0; m < tiling->ncallback; ++m ) {
       LT_Callback *cb = tiling->callbacks[m];
-      XLAL_CHECK( (cb->func)( first_call, tiling, itr, &point_view.vector, changed_i, cb->param, cb->out ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK( ( cb->func )( true, tiling, itr, itr->phys_point, 0, cb->param, cb->out ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+
+    // Each point in the outermost tiled dimension, if any, is a single point
+    if ( count_points ) {
+      point_counts->outer_lower = ( tn > 0 ) ? itr->int_lower[0] : 0;
+      point_counts->nouter = ( tn > 0 ) ? ( size_t )( itr->int_upper[0] - itr->int_lower[0] + 1 ) : 1;
+      point_counts->counts = XLALCalloc( n * point_counts->nouter, sizeof( *point_counts->counts ) );
+      XLAL_CHECK( point_counts->counts != NULL, XLAL_ENOMEM );
+      for ( size_t j = 0; j < n * point_counts->nouter; ++j ) {
+        point_counts->counts[j] = 1;
+      }
+    }
+
+  } else {
+
+    // Iterate over each point in the outermost tiled dimension in turn
+
+    // Determine the number of threads to use; callbacks are only performed in parallel if the
+    // output data of all callbacks can be merged
+    UINT4 num_threads = tiling->num_threads;
+#ifdef _OPENMP
+    if ( num_threads == 0 ) {
+      num_threads = omp_get_max_threads();
+    }
+#else
+    num_threads = 1;
+#endif
+    for ( size_t m = m0; m < tiling->ncallback; ++m ) {
+      if ( tiling->callbacks[m]->merge == NULL ) {
+        num_threads = 1;
+      }
+    }
+    const bool parallel = ( num_threads > 1 );
+
+    // Determine the range of the outermost tiled dimension
+    XLAL_CHECK( LT_NextPoint( itr ) > 0, XLAL_EFUNC );
+    const INT4 outer_lower = itr->int_lower[0];
+    const size_t nouter = itr->int_upper[0] - itr->int_lower[0] + 1;
+
+    // Allocate memory for point counts
+    UINT8 *counts = NULL;
+    if ( count_points ) {
+      counts = XLALCalloc( n * nouter, sizeof( *counts ) );
+      XLAL_CHECK( counts != NULL, XLAL_ENOMEM );
+    }
+
+    // Perform callbacks at the first outer point, storing output data in the callbacks' own output
+    void *outs[ncb];
+    for ( size_t m = m0; m < tiling->ncallback; ++m ) {
+      outs[m - m0] = tiling->callbacks[m]->out;
+    }
+    XLAL_CHECK( LT_PerformCallbacksAtOuterPoint( itr, outer_lower, true, m0, outs, counts, nouter, 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    // Perform callbacks at the remaining outer points:
+    // - serially, continuing to store output data in the callbacks' own output
+    // - in parallel, storing output data in per-thread output which is then merged
+    int errnum = 0;
+#pragma omp parallel num_threads(num_threads) if(parallel)
+    {
+      LatticeTilingIterator *thread_itr = itr;
+      void *thread_outs[ncb];
+      char *thread_out_data = NULL;
+      bool thread_first_call = false;
+      memcpy( thread_outs, outs, sizeof( thread_outs ) );
+      if ( parallel ) {
+        thread_itr = XLALCreateLatticeTilingIterator( tiling, n - 1 );
+        thread_out_data = XLALCalloc( ncb, LT_DATA_MAX_SIZE );
+        if ( thread_itr == NULL || thread_out_data == NULL ) {
+#pragma omp critical (XLALPerformLatticeTilingCallbacks)
+          errnum = XLAL_ENOMEM;
+        } else {
+          for ( size_t j = 0; j < ncb; ++j ) {
+            thread_outs[j] = &thread_out_data[j * LT_DATA_MAX_SIZE];
+          }
+          thread_first_call = true;
+        }
+      }
+
+#pragma omp for schedule(dynamic)
+      for ( size_t k = 1; k < nouter; ++k ) {
+        if ( errnum != 0 ) {
+          continue;
+        }
+        if ( LT_PerformCallbacksAtOuterPoint( thread_itr, outer_lower + ( INT4 ) k, thread_first_call, m0, thread_outs, counts, nouter, k ) != XLAL_SUCCESS ) {
+#pragma omp critical (XLALPerformLatticeTilingCallbacks)
+          errnum = XLAL_EFUNC;
+          continue;
+        }
+        thread_first_call = false;
+      }
+
+      if ( parallel ) {
+
+        // Merge per-thread output data, if any points were visited by this thread
+#pragma omp critical (XLALPerformLatticeTilingCallbacks)
+        if ( errnum == 0 && thread_out_data != NULL && !thread_first_call ) {
+          for ( size_t m = m0; m < tiling->ncallback; ++m ) {
+            LT_Callback *cb = tiling->callbacks[m];
+            if ( ( cb->merge )( tiling, cb->param, cb->out, thread_outs[m - m0] ) != XLAL_SUCCESS ) {
+              errnum = XLAL_EFUNC;
+              break;
+            }
+          }
+        }
+
+        XLALDestroyLatticeTilingIterator( thread_itr );
+        XLALFree( thread_out_data );
+
+      }
+
+    }
+    if ( errnum != 0 ) {
+      XLALFree( counts );
+      XLAL_ERROR( errnum );
+    }
+
+    // Store point counts
+    if ( count_points ) {
+      point_counts->outer_lower = outer_lower;
+      point_counts->nouter = nouter;
+      point_counts->counts = counts;
     }
-    first_call = false;
 
   }
   XLAL_CHECK( xlalErrno == 0, XLAL_EFAILED );
@@ -1604,6 +1959,170 @@ const LatticeTilingStats *XLALLatticeTilingStatistics(
 
 }
 
+int XLALSaveLatticeTilingPointCounts(
+  const LatticeTiling *tiling,
+  FITSFile *file,
+  const char *name
+  )
+{
+
+  // Check input
+  XLAL_CHECK( tiling != NULL, XLAL_EFAULT );
+  XLAL_CHECK( tiling->lattice < TILING_LATTICE_MAX, XLAL_EINVAL );
+  XLAL_CHECK( file != NULL, XLAL_EFAULT );
+  XLAL_CHECK( name != NULL, XLAL_EFAULT );
+
+  const size_t n = tiling->ndim;
+
+  // Ensure statistics and point counts have been computed
+  XLAL_CHECK( XLALPerformLatticeTilingCallbacks( tiling ) == XLAL_SUCCESS, XLAL_EFUNC );
+  const LT_PointCounts *point_counts = tiling->point_counts;
+  XLAL_CHECK( point_counts->counts != NULL, XLAL_EFAILED );
+
+  // Open FITS table for writing
+  XLAL_CHECK( XLALFITSTableOpenWrite( file, name, "lattice tiling statistics and point counts" ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( LT_InitCountsFITSRecordTable( file, point_counts->nouter ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Write FITS records to table
+  for ( size_t i = 0; i < n; ++i ) {
+
+    // Fill record
+    LT_CountsFITSRecord XLAL_INIT_DECL( record );
+    XLAL_CHECK( LT_BoundChecksum( tiling, i, &record.checksum ) == XLAL_SUCCESS, XLAL_EFUNC );
+    record.total_points = tiling->stats[i].total_points;
+    record.min_points = tiling->stats[i].min_points;
+    record.max_points = tiling->stats[i].max_points;
+    record.min_value = tiling->stats[i].min_value;
+    record.max_value = tiling->stats[i].max_value;
+    record.counts = &point_counts->counts[i * point_counts->nouter];
+
+    // Write record
+    XLAL_CHECK( XLALFITSTableWriteRow( file, &record ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  }
+
+  // Write tiling properties
+  {
+    UINT4 ndim = tiling->ndim;
+    XLAL_CHECK( XLALFITSHeaderWriteUINT4( file, "ndim", ndim, "number of parameter-space dimensions" ) == XLAL_SUCCESS, XLAL_EFUNC );
+  } {
+    UINT4 tiled_ndim = tiling->tiled_ndim;
+    XLAL_CHECK( XLALFITSHeaderWriteUINT4( file, "tiled_ndim", tiled_ndim, "number of tiled parameter-space dimensions" ) == XLAL_SUCCESS, XLAL_EFUNC );
+  } {
+    UINT4 lattice = tiling->lattice;
+    XLAL_CHECK( XLALFITSHeaderWriteUINT4( file, "lattice", lattice, "type of lattice to generate tiling with" ) == XLAL_SUCCESS, XLAL_EFUNC );
+  } {
+    INT4 lattice_checksum = 0;
+    XLAL_CHECK( LT_LatticeChecksum( tiling, &lattice_checksum ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( XLALFITSHeaderWriteINT4( file, "lattice_checksum", lattice_checksum, "checksum of lattice generator and origin" ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  // Write point count properties
+  {
+    INT4 outer_lower = point_counts->outer_lower;
+    XLAL_CHECK( XLALFITSHeaderWriteINT4( file, "outer_lower", outer_lower, "lower bound on outermost tiled dimension" ) == XLAL_SUCCESS, XLAL_EFUNC );
+  } {
+    UINT8 nouter = point_counts->nouter;
+    XLAL_CHECK( XLALFITSHeaderWriteUINT8( file, "nouter", nouter, "number of points in outermost tiled dimension" ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  return XLAL_SUCCESS;
+
+}
+
+int XLALRestoreLatticeTilingPointCounts(
+  LatticeTiling *tiling,
+  FITSFile *file,
+  const char *name
+  )
+{
+
+  // Check input
+  XLAL_CHECK( tiling != NULL, XLAL_EFAULT );
+  XLAL_CHECK( tiling->lattice < TILING_LATTICE_MAX, XLAL_EINVAL );
+  XLAL_CHECK( *tiling->ncallback_done == 0, XLAL_EINVAL, "Lattice tiling callbacks have already been performed" );
+  XLAL_CHECK( file != NULL, XLAL_EFAULT );
+  XLAL_CHECK( name != NULL, XLAL_EFAULT );
+
+  const size_t n = tiling->ndim;
+
+  // Open FITS table for reading
+  UINT8 nrows = 0;
+  XLAL_CHECK( XLALFITSTableOpenRead( file, name, &nrows ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( nrows == ( UINT8 ) n, XLAL_EIO, "Could not restore point counts; invalid HDU '%s'", name );
+
+  // Read and check tiling properties
+  {
+    UINT4 ndim;
+    XLAL_CHECK( XLALFITSHeaderReadUINT4( file, "ndim", &ndim ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( ndim == tiling->ndim, XLAL_EIO, "Could not restore point counts; invalid HDU '%s'", name );
+  } {
+    UINT4 tiled_ndim;
+    XLAL_CHECK( XLALFITSHeaderReadUINT4( file, "tiled_ndim", &tiled_ndim ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( tiled_ndim == tiling->tiled_ndim, XLAL_EIO, "Could not restore point counts; invalid HDU '%s'", name );
+  } {
+    UINT4 lattice;
+    XLAL_CHECK( XLALFITSHeaderReadUINT4( file, "lattice", &lattice ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( lattice == tiling->lattice, XLAL_EIO, "Could not restore point counts; invalid HDU '%s'", name );
+  } {
+    INT4 lattice_checksum;
+    XLAL_CHECK( XLALFITSHeaderReadINT4( file, "lattice_checksum", &lattice_checksum ) == XLAL_SUCCESS, XLAL_EFUNC );
+    INT4 lattice_checksum_ref = 0;
+    XLAL_CHECK( LT_LatticeChecksum( tiling, &lattice_checksum_ref ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( lattice_checksum == lattice_checksum_ref, XLAL_EIO, "Could not restore point counts; invalid HDU '%s'", name );
+  }
+
+  // Read point count properties
+  INT4 outer_lower;
+  XLAL_CHECK( XLALFITSHeaderReadINT4( file, "outer_lower", &outer_lower ) == XLAL_SUCCESS, XLAL_EFUNC );
+  UINT8 nouter;
+  XLAL_CHECK( XLALFITSHeaderReadUINT8( file, "nouter", &nouter ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( nouter > 0, XLAL_EIO, "Could not restore point counts; invalid HDU '%s'", name );
+
+  // Allocate memory for point counts
+  UINT8 *counts = XLALCalloc( n * nouter, sizeof( *counts ) );
+  XLAL_CHECK( counts != NULL, XLAL_ENOMEM );
+
+  // Read FITS records from table
+  XLAL_CHECK( LT_InitCountsFITSRecordTable( file, nouter ) == XLAL_SUCCESS, XLAL_EFUNC );
+  LatticeTilingStats *stats = ( LatticeTilingStats * ) tiling->callbacks[0]->out;
+  XLAL_CHECK( ( const LatticeTilingStats * ) stats == tiling->stats, XLAL_EFAILED );
+  for ( size_t i = 0; i < n; ++i ) {
+
+    // Read and check record
+    LT_CountsFITSRecord XLAL_INIT_DECL( record );
+    record.counts = &counts[i * nouter];
+    XLAL_CHECK( XLALFITSTableReadRow( file, &record, &nrows ) == XLAL_SUCCESS, XLAL_EFUNC );
+    {
+      INT4 checksum = 0;
+      XLAL_CHECK( LT_BoundChecksum( tiling, i, &checksum ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK( record.checksum == checksum, XLAL_EIO, "Could not restore point counts; invalid HDU '%s'", name );
+    }
+    XLAL_CHECK( record.total_points > 0, XLAL_EIO, "Could not restore point counts; invalid HDU '%s'", name );
+
+    // Restore statistics
+    stats[i].name = XLALLatticeTilingBoundName( tiling, i );
+    stats[i].total_points = record.total_points;
+    stats[i].min_points = record.min_points;
+    stats[i].max_points = record.max_points;
+    stats[i].min_value = record.min_value;
+    stats[i].max_value = record.max_value;
+
+  }
+
+  // Restore point counts
+  XLALFree( tiling->point_counts->counts );
+  tiling->point_counts->outer_lower = outer_lower;
+  tiling->point_counts->nouter = nouter;
+  tiling->point_counts->counts = counts;
+
+  // Mark statistics callback as having been performed
+  *tiling->ncallback_done = 1;
+
+  return XLAL_SUCCESS;
+
+}
+
 int XLALRandomLatticeTilingPoints(
   const LatticeTiling *tiling,
   const double scale,
@@ -1673,6 +2192,8 @@ LatticeTilingIterator *XLALCreateLatticeTilingIterator(
   itr->alternating = false;
   itr->state = 0;
   itr->index = 0;
+  itr->partition_count = 1;
+  itr->partition_index = 0;
 
   // Determine the maximum tiled dimension to iterate over
   itr->tiled_itr_ndim = 0;
@@ -1752,20 +2273,119 @@ int XLALResetLatticeTilingIterator(
 
   // Return iterator to initialised state
   itr->state = 0;
+  itr->block_index = 0;
 
   return XLAL_SUCCESS;
 
 }
 
-int XLALNextLatticeTilingPoint(
+int XLALSetLatticeTilingIteratorPartition(
   LatticeTilingIterator *itr,
-  gsl_vector *point
+  const UINT4 partition_count,
+  const UINT4 partition_index
   )
 {
 
   // Check input
   XLAL_CHECK( itr != NULL, XLAL_EFAULT );
-  XLAL_CHECK( point == NULL || point->size == itr->tiling->ndim, XLAL_EINVAL );
+  XLAL_CHECK( itr->state == 0, XLAL_EINVAL );
+  XLAL_CHECK( partition_count > 0, XLAL_EINVAL );
+  XLAL_CHECK( partition_index < partition_count, XLAL_EINVAL );
+
+  // Set partition
+  itr->partition_count = partition_count;
+  itr->partition_index = partition_index;
+
+  return XLAL_SUCCESS;
+
+}
+
+int XLALSetLatticeTilingIteratorOuterPartition(
+  LatticeTilingIterator *itr,
+  const UINT4 partition_count,
+  const UINT4 partition_index
+  )
+{
+
+  // Check input
+  XLAL_CHECK( itr != NULL, XLAL_EFAULT );
+  XLAL_CHECK( itr->state == 0, XLAL_EINVAL );
+  XLAL_CHECK( itr->tiled_itr_ndim > 0, XLAL_EINVAL, "Iterator must iterate over at least one tiled dimension" );
+  XLAL_CHECK( partition_count > 0, XLAL_EINVAL );
+  XLAL_CHECK( partition_index < partition_count, XLAL_EINVAL );
+
+  // Ensure point counts have been computed
+  XLAL_CHECK( XLALPerformLatticeTilingCallbacks( itr->tiling ) == XLAL_SUCCESS, XLAL_EFUNC );
+  const LT_PointCounts *point_counts = itr->tiling->point_counts;
+  XLAL_CHECK( point_counts->counts != NULL, XLAL_EFAILED );
+
+  // Get point counts up to the highest iterated-over dimension
+  const size_t nouter = point_counts->nouter;
+  const UINT8 *counts = &point_counts->counts[( itr->itr_ndim - 1 ) * nouter];
+  UINT8 total = 0;
+  for ( size_t k = 0; k < nouter; ++k ) {
+    total += counts[k];
+  }
+
+  // Find the range of outer points [k_lower, k_upper) in the partition, such that the points
+  // preceding the partition number at least 'partition_index' shares of the total number of points
+  size_t k_lower = 0, k_upper = 0;
+  UINT8 first_index = 0, cumul_count = 0;
+  for ( size_t k = 0; k < nouter; ++k ) {
+    const double share = ( ( double ) cumul_count ) * partition_count / total;
+    if ( share < partition_index ) {
+      k_lower = k + 1;
+      first_index = cumul_count + counts[k];
+    }
+    if ( share < partition_index + 1 ) {
+      k_upper = k + 1;
+    }
+    cumul_count += counts[k];
+  }
+
+  // Limit iteration over the outermost tiled dimension to the partition
+  itr->outer_limited = true;
+  itr->outer_lower = point_counts->outer_lower + ( INT4 ) k_lower;
+  itr->outer_upper = point_counts->outer_lower + ( INT4 ) k_upper - 1;
+  itr->outer_first_index = first_index;
+
+  return XLAL_SUCCESS;
+
+}
+
+///
+/// Return the lower bound on the integer points iterated over in a tiled dimension, taking into
+/// account any limits on the outermost tiled dimension.
+///
+static inline INT4 LT_ItrLower(
+  const LatticeTilingIterator *itr,
+  const size_t ti
+  )
+{
+  return ( ti == 0 && itr->outer_limited ) ? GSL_MAX( itr->int_lower[0], itr->outer_lower ) : itr->int_lower[ti];
+}
+
+///
+/// Return the upper bound on the integer points iterated over in a tiled dimension, taking into
+/// account any limits on the outermost tiled dimension.
+///
+static inline INT4 LT_ItrUpper(
+  const LatticeTilingIterator *itr,
+  const size_t ti
+  )
+{
+  return ( ti == 0 && itr->outer_limited ) ? GSL_MIN( itr->int_upper[0], itr->outer_upper ) : itr->int_upper[ti];
+}
+
+///
+/// Advance lattice tiling iterator to the next point. Returns 1 + the index of the lowest changed
+/// tiled dimension if there are points remaining, 0 if there are no more points, and XLAL_FAILURE
+/// on error.
+///
+static int LT_NextPoint(
+  LatticeTilingIterator *itr            ///< [in] Lattice tiling iterator
+  )
+{
 
   const size_t n = itr->tiling->ndim;
   const size_t tn = itr->tiling->tiled_ndim;
@@ -1795,7 +2415,7 @@ int XLALNextLatticeTilingPoint(
     }
 
     // Initialise index
-    itr->index = 0;
+    itr->index = itr->outer_first_index;
 
     // All dimensions have changed
     changed_ti = 0;
@@ -1835,8 +2455,8 @@ int XLALNextLatticeTilingPoint(
       gsl_blas_daxpy( direction, &phys_from_int_i.vector, itr->phys_point );
 
       // If point is not out of bounds, we have found the next lattice point
-      const INT4 int_lower_ti = itr->int_lower[ti];
-      const INT4 int_upper_ti = itr->int_upper[ti];
+      const INT4 int_lower_ti = LT_ItrLower( itr, ti );
+      const INT4 int_upper_ti = LT_ItrUpper( itr, ti );
       if ( ( direction > 0 && int_point_ti <= int_upper_ti ) || ( direction < 0 && int_point_ti >= int_lower_ti ) ) {
         break;
       }
@@ -1945,11 +2565,17 @@ int XLALNextLatticeTilingPoint(
       // - lower or upper bound (depending on current direction) for iterated-over dimensions
       // - mid-point of integer bounds for non-iterated dimensions
       if ( ti < itr->tiled_itr_ndim ) {
-        itr->int_point[ti] = ( direction > 0 ) ? int_lower_i : int_upper_i;
+        itr->int_point[ti] = ( direction > 0 ) ? LT_ItrLower( itr, ti ) : LT_ItrUpper( itr, ti );
       } else {
         itr->int_point[ti] = ( int_lower_i + int_upper_i ) / 2;
       }
 
+      // If limits on the outermost tiled dimension exclude all points, iterator is finished
+      if ( ti == 0 && itr->outer_limited && LT_ItrLower( itr, 0 ) > LT_ItrUpper( itr, 0 ) ) {
+        itr->state = 2;
+        return 0;
+      }
+
     }
 
     // If tiled, recompute current physical point from integer point
@@ -1974,13 +2600,32 @@ int XLALNextLatticeTilingPoint(
   // Iterator is in progress
   itr->state = 1;
 
+  // Return index of changed dimensions (offset from 1, since 0 is used to indicate no more points)
+  return 1 + changed_ti;
+
+}
+
+int XLALNextLatticeTilingPoint(
+  LatticeTilingIterator *itr,
+  gsl_vector *point
+  )
+{
+
+  // Check input
+  XLAL_CHECK( itr != NULL, XLAL_EFAULT );
+  XLAL_CHECK( point == NULL || point->size == itr->tiling->ndim, XLAL_EINVAL );
+  XLAL_CHECK( itr->partition_count == 1, XLAL_EINVAL, "Partitioned iterators must use XLALNextLatticeTilingBlock()" );
+
+  // Advance iterator
+  const int retn = LT_NextPoint( itr );
+  XLAL_CHECK( retn >= 0, XLAL_EFUNC );
+
   // Optionally, copy current physical point
-  if ( point != NULL ) {
+  if ( retn > 0 && point != NULL ) {
     gsl_vector_memcpy( point, itr->phys_point );
   }
 
-  // Return index of changed dimensions (offset from 1, since 0 is used to indicate no more points)
-  return 1 + changed_ti;
+  return retn;
 
 }
 
@@ -2019,6 +2664,130 @@ int XLALNextLatticeTilingPoints(
 
 }
 
+int XLALNextLatticeTilingBlock(
+  LatticeTilingIterator *itr,
+  gsl_matrix **points,
+  UINT8 *first_index
+  )
+{
+
+  // Check input
+  XLAL_CHECK( itr != NULL, XLAL_EFAULT );
+  XLAL_CHECK( points != NULL, XLAL_EFAULT );
+
+  const size_t n = itr->tiling->ndim;
+  const size_t tn = itr->tiling->tiled_ndim;
+  const size_t tin = itr->tiled_itr_ndim;
+
+  while ( true ) {
+
+    // Advance iterator to first point in the next block
+    const int retn = LT_NextPoint( itr );
+    XLAL_CHECK( retn >= 0, XLAL_EFUNC );
+    if ( retn == 0 ) {
+      return 0;
+    }
+
+    // Determine the number of points in the remainder of the block, i.e. up to the bound
+    // (depending on current direction) of the highest iterated-over tiled dimension
+    UINT4 num_points = 1;
+    if ( tin > 0 ) {
+      const size_t ti = tin - 1;
+      if ( itr->direction[ti] > 0 ) {
+        num_points += LT_ItrUpper( itr, ti ) - itr->int_point[ti];
+      } else {
+        num_points += itr->int_point[ti] - LT_ItrLower( itr, ti );
+      }
+    }
+
+    // Skip block if it is not in this iterator's partition
+    const UINT8 block_index = itr->block_index++;
+    if ( block_index % itr->partition_count != itr->partition_index ) {
+
+      // Move iterator to last point in block without computing any physical points;
+      // physical coordinates are recomputed from the integer point when the next block begins
+      if ( num_points > 1 ) {
+        const size_t ti = tin - 1;
+        itr->int_point[ti] += itr->direction[ti] * ( INT4 )( num_points - 1 );
+        itr->index += num_points - 1;
+      }
+
+      continue;
+
+    }
+
+    // Resize or allocate points matrix, if required
+    if ( *points != NULL ) {
+      if ( ( *points )->size1 != n || ( *points )->size2 < num_points ) {
+        GFMAT( *points );
+        *points = NULL;
+      }
+    }
+    if ( *points == NULL ) {
+      GAMAT( *points, n, num_points );
+    }
+
+    // Return index of first point in block
+    if ( first_index != NULL ) {
+      *first_index = itr->index;
+    }
+
+    if ( num_points > 1 && tin == tn && itr->tiling->tiled_idx[tn - 1] == n - 1 ) {
+
+      // The highest iterated-over tiled dimension is the highest parameter-space dimension, so
+      // points in the block differ only in that dimension, and only by a multiple of the generator
+
+      // Points in lower dimensions are the same for all points in the block
+      for ( size_t i = 0; i + 1 < n; ++i ) {
+        const double phys_point_i = gsl_vector_get( itr->phys_point, i );
+        double *row_i = gsl_matrix_ptr( *points, i, 0 );
+        for ( UINT4 k = 0; k < num_points; ++k ) {
+          row_i[k] = phys_point_i;
+        }
+      }
+
+      // Compute points in highest dimension from integer point, summing contributions from the
+      // integer point in the same order as LT_NextPoint() so that points are bitwise identical
+      const size_t i = n - 1;
+      const size_t ti = tn - 1;
+      double phys_point_i_lower = gsl_vector_get( itr->tiling->phys_origin, i );
+      for ( size_t tj = 0; tj < ti; ++tj ) {
+        const size_t j = itr->tiling->tiled_idx[tj];
+        phys_point_i_lower += gsl_matrix_get( itr->tiling->phys_from_int, i, j ) * itr->int_point[tj];
+      }
+      const double phys_from_int_i_i = gsl_matrix_get( itr->tiling->phys_from_int, i, i );
+      const INT4 direction = itr->direction[ti];
+      const INT4 int_point_ti = itr->int_point[ti];
+      double *row_i = gsl_matrix_ptr( *points, i, 0 );
+      for ( UINT4 k = 0; k < num_points; ++k ) {
+        row_i[k] = phys_point_i_lower + phys_from_int_i_i * ( int_point_ti + direction * ( INT4 ) k );
+      }
+
+      // Move iterator to last point in block
+      itr->int_point[ti] = int_point_ti + direction * ( INT4 )( num_points - 1 );
+      itr->index += num_points - 1;
+      LT_SetPhysPoint( itr->tiling, itr->phys_point_cache, itr->phys_point, i, row_i[num_points - 1] );
+
+    } else {
+
+      // Advance iterator through each point in the block, and copy physical points
+      for ( UINT4 k = 0; k < num_points; ++k ) {
+        if ( k > 0 ) {
+          XLAL_CHECK( LT_NextPoint( itr ) > 0, XLAL_EFAILED );
+        }
+        for ( size_t i = 0; i < n; ++i ) {
+          gsl_matrix_set( *points, i, k, gsl_vector_get( itr->phys_point, i ) );
+        }
+      }
+
+    }
+
+    return num_points;
+
+  }
+
+}
+
 UINT8 XLALTotalLatticeTilingPoints(
   const LatticeTilingIterator *itr
   )
@@ -2089,6 +2858,7 @@ int XLALSaveLatticeTilingIterator(
   // Check input
   XLAL_CHECK( itr != NULL, XLAL_EFAULT );
   XLAL_CHECK( itr->state > 0, XLAL_EINVAL );
+  XLAL_CHECK( itr->partition_count == 1, XLAL_EINVAL, "Partitioned iterators cannot be saved" );
   XLAL_CHECK( file != NULL, XLAL_EFAULT );
   XLAL_CHECK( name != NULL, XLAL_EFAULT );
 
@@ -2103,15 +2873,7 @@ int XLALSaveLatticeTilingIterator(
 
     // Fill record
     LT_FITSRecord XLAL_INIT_DECL( record );
-    {
-      INT4 checksum = 0;
-      XLAL_CHECK( XLALPearsonHash( &checksum, sizeof( checksum ), &itr->tiling->bounds[i].is_tiled, sizeof( itr->tiling->bounds[i].is_tiled ) ) == XLAL_SUCCESS, XLAL_EFUNC );
-      XLAL_CHECK( XLALPearsonHash( &checksum, sizeof( checksum ), &itr->tiling->bounds[i].data_len, sizeof( itr->tiling->bounds[i].data_len ) ) == XLAL_SUCCESS, XLAL_EFUNC );
-      XLAL_CHECK( XLALPearsonHash( &checksum, sizeof( checksum ), itr->tiling->bounds[i].data_lower, itr->tiling->bounds[i].data_len ) == XLAL_SUCCESS, XLAL_EFUNC );
-      XLAL_CHECK( XLALPearsonHash( &checksum, sizeof( checksum ), itr->tiling->bounds[i].data_upper, itr->tiling->bounds[i].data_len ) == XLAL_SUCCESS, XLAL_EFUNC );
-      XLAL_CHECK( XLALPearsonHash( &checksum, sizeof( checksum ), &itr->tiling->bounds[i].padf, sizeof( itr->tiling->bounds[i].padf ) ) == XLAL_SUCCESS, XLAL_EFUNC );
-      record.checksum = checksum;
-    }
+    XLAL_CHECK( LT_BoundChecksum( itr->tiling, i, &record.checksum ) == XLAL_SUCCESS, XLAL_EFUNC );
     record.phys_point = gsl_vector_get( itr->phys_point, i );
     if ( itr->tiling->bounds[i].is_tiled ) {
       record.int_point = itr->int_point[ti];
@@ -2172,6 +2934,7 @@ int XLALRestoreLatticeTilingIterator(
 
   // Check input
   XLAL_CHECK( itr != NULL, XLAL_EFAULT );
+  XLAL_CHECK( itr->partition_count == 1, XLAL_EINVAL, "Partitioned iterators cannot be restored" );
   XLAL_CHECK( file != NULL, XLAL_EFAULT );
   XLAL_CHECK( name != NULL, XLAL_EFAULT );
 
@@ -2236,11 +2999,7 @@ int XLALRestoreLatticeTilingIterator(
     XLAL_CHECK( XLALFITSTableReadRow( file, &record, &nrows ) == XLAL_SUCCESS, XLAL_EFUNC );
     {
       INT4 checksum = 0;
-      XLAL_CHECK( XLALPearsonHash( &checksum, sizeof( checksum ), &itr->tiling->bounds[i].is_tiled, sizeof( itr->tiling->bounds[i].is_tiled ) ) == XLAL_SUCCESS, XLAL_EFUNC );
-      XLAL_CHECK( XLALPearsonHash( &checksum, sizeof( checksum ), &itr->tiling->bounds[i].data_len, sizeof( itr->tiling->bounds[i].data_len ) ) == XLAL_SUCCESS, XLAL_EFUNC );
-      XLAL_CHECK( XLALPearsonHash( &checksum, sizeof( checksum ), itr->tiling->bounds[i].data_lower, itr->tiling->bounds[i].data_len ) == XLAL_SUCCESS, XLAL_EFUNC );
-      XLAL_CHECK( XLALPearsonHash( &checksum, sizeof( checksum ), itr->tiling->bounds[i].data_upper, itr->tiling->bounds[i].data_len ) == XLAL_SUCCESS, XLAL_EFUNC );
-      XLAL_CHECK( XLALPearsonHash( &checksum, sizeof( checksum ), &itr->tiling->bounds[i].padf, sizeof( itr->tiling->bounds[i].padf ) ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK( LT_BoundChecksum( itr->tiling, i, &checksum ) == XLAL_SUCCESS, XLAL_EFUNC );
       XLAL_CHECK( record.checksum == checksum, XLAL_EIO, "Could not restore iterator; invalid HDU '%s'", name );
     }
     LT_SetPhysPoint( itr->tiling, itr->phys_point_cache, itr->phys_point, i, record.phys_point );
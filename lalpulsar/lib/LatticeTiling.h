@@ -114,6 +114,19 @@ typedef int( *LatticeTilingCallback )(
   void *out                             ///< [out] Output data to be filled by callback function
   );
 
+///
+/// Function which merges the output data \c other_out of a lattice tiling callback, computed over
+/// some of the points in a lattice tiling, into the output data \c out of the same callback computed
+/// over other points. Used to perform callbacks in parallel; the result of merging must not depend
+/// on the order in which output data are merged.
+///
+typedef int( *LatticeTilingCallbackMerge )(
+  const LatticeTiling *tiling,          ///< [in] Lattice tiling
+  const void *param,                    ///< [in] Arbitrary input data for use by callback function
+  void *out,                            ///< [in,out] Output data to be merged into
+  const void *other_out                 ///< [in] Output data to merge
+  );
+
 ///
 /// Statistics related to the number/value of lattice tiling points in a dimension.
 ///
@@ -326,7 +339,33 @@ const void *XLALRegisterLatticeTilingCallback(
   );
 
 ///
-/// Perform all registered lattice tiling callbacks.
+/// Register a callback function which can be used to compute properties of a lattice tiling, and
+/// whose output data can be merged with \c merge so that it can be performed in parallel.
+/// Returns a const pointer to the output data to be filled by the callback function.
+///
+const void *XLALRegisterMergeableLatticeTilingCallback(
+  LatticeTiling *tiling,                ///< [in] Lattice tiling
+  const LatticeTilingCallback func,     ///< [in] Callback function
+  const LatticeTilingCallbackMerge merge, ///< [in] Function which merges output data of callback function
+  const size_t param_len,               ///< [in] Length of arbitrary input data for use by callback function
+  const void *param,                    ///< [in] Arbitrary input data for use by callback function
+  const size_t out_len                  ///< [in] Length of output data to be filled by callback function
+  );
+
+///
+/// Set the number of threads with which to perform lattice tiling callbacks, if OpenMP is enabled
+/// (0 = OpenMP default). Callbacks are performed in parallel, over the points in the outermost tiled
+/// dimension, only if all callbacks to be performed were registered with a merge function.
+///
+int XLALSetLatticeTilingCallbackThreads(
+  LatticeTiling *tiling,                ///< [in] Lattice tiling
+  const UINT4 num_threads               ///< [in] Number of threads
+  );
+
+///
+/// Perform all registered lattice tiling callbacks. The first time callbacks are performed, the
+/// number of points in the lattice tiling at each point in the outermost tiled dimension is also
+/// counted; see XLALSaveLatticeTilingPointCounts().
 ///
 int XLALPerformLatticeTilingCallbacks(
   const LatticeTiling *tiling           ///< [in] Lattice tiling
@@ -342,6 +381,30 @@ const LatticeTilingStats *XLALLatticeTilingStatistics(
   const size_t dim                      ///< [in] Dimension in which to return statistics
   );
 
+///
+/// Save the lattice tiling statistics, and the number of points in the lattice tiling at each point
+/// in the outermost tiled dimension, to a FITS file.
+///
+int XLALSaveLatticeTilingPointCounts(
+  const LatticeTiling *tiling,          ///< [in] Lattice tiling
+  FITSFile *file,                       ///< [in] FITS file to save point counts to
+  const char *name                      ///< [in] FITS HDU to save point counts to
+  );
+
+///
+/// Restore the lattice tiling statistics, and the number of points in the lattice tiling at each
+/// point in the outermost tiled dimension, from a FITS file written by
+/// XLALSaveLatticeTilingPointCounts() for a lattice tiling with the same parameter-space bounds,
+/// lattice, and metric. The tiling then need not be iterated over to compute statistics, or to
+/// partition iterators with XLALSetLatticeTilingIteratorOuterPartition(); any other registered
+/// callbacks are still performed by XLALPerformLatticeTilingCallbacks().
+///
+int XLALRestoreLatticeTilingPointCounts(
+  LatticeTiling *tiling,                ///< [in] Lattice tiling
+  FITSFile *file,                       ///< [in] FITS file to restore point counts from
+  const char *name                      ///< [in] FITS HDU to restore point counts from
+  );
+
 ///
 /// Generate random points within the parameter space of the lattice tiling.  Points can be scaled
 /// to fill the parameter space exactly (<tt>scale == 0</tt>), fill a subset of the parameter space
@@ -381,6 +444,37 @@ int XLALSetLatticeTilingAlternatingIterator(
   const bool alternating                ///< [in] If true, set alternating iterator
   );
 
+///
+/// Partition the blocks of points returned by XLALNextLatticeTilingBlock() between several
+/// iterators, e.g. one per thread. Blocks are assigned to partitions in turn, i.e. the iterator
+/// returns the blocks with index \c partition_index, <tt>partition_index + partition_count</tt>,
+/// and so on; each partition therefore always returns the same blocks in the same order. Point
+/// indexes returned by XLALNextLatticeTilingBlock() are those of the unpartitioned iterator. A
+/// partitioned iterator cannot be used with XLALNextLatticeTilingPoint() or saved/restored.
+///
+int XLALSetLatticeTilingIteratorPartition(
+  LatticeTilingIterator *itr,           ///< [in] Lattice tiling iterator
+  const UINT4 partition_count,          ///< [in] Number of partitions
+  const UINT4 partition_index           ///< [in] Index of partition to iterate over
+  );
+
+///
+/// Partition a lattice tiling iterator into contiguous ranges of points in the outermost tiled
+/// dimension, chosen using the counts computed by XLALPerformLatticeTilingCallbacks() (or restored
+/// by XLALRestoreLatticeTilingPointCounts()) so that each partition contains roughly the same
+/// number of points. The iterator then returns only the points in partition \c partition_index; a
+/// partition may be empty if there are more partitions than points in the outermost tiled
+/// dimension. Point indexes are those of the unpartitioned iterator, so that searches over each
+/// partition may be resumed and combined. Unlike XLALSetLatticeTilingIteratorPartition(), the
+/// iterator may be used with XLALNextLatticeTilingPoint() and saved/restored, provided it is
+/// restored to an iterator with the same partition.
+///
+int XLALSetLatticeTilingIteratorOuterPartition(
+  LatticeTilingIterator *itr,           ///< [in] Lattice tiling iterator
+  const UINT4 partition_count,          ///< [in] Number of partitions
+  const UINT4 partition_index           ///< [in] Index of partition to iterate over
+  );
+
 ///
 /// Reset an iterator to the beginning of a lattice tiling.
 ///
@@ -411,6 +505,25 @@ int XLALNextLatticeTilingPoints(
   gsl_matrix **points                   ///< [out] Columns are next set of points in lattice tiling
   );
 
+///
+/// Advance lattice tiling iterator to the end of the next block of points, i.e. points which differ
+/// only in the highest iterated-over tiled dimension, and return the block in \c points. Coordinates
+/// of each parameter-space dimension are stored contiguously in the rows of \c points, and columns
+/// are the points in order of iteration; \c points is dynamically resized as required. Optionally
+/// return the index of the first point in the block in \c first_index; subsequent points in the
+/// block have consecutive indexes. Returns the number of points in the block if there are points
+/// remaining, 0 if there are no more points, and XLAL_FAILURE on error.
+///
+#ifdef SWIG // SWIG interface directives
+SWIGLAL( RETURN_VALUE( int, XLALNextLatticeTilingBlock ) );
+SWIGLAL( INOUT_STRUCTS( gsl_matrix **, points ) );
+#endif
+int XLALNextLatticeTilingBlock(
+  LatticeTilingIterator *itr,           ///< [in] Lattice tiling iterator
+  gsl_matrix **points,                  ///< [out] Rows are coordinates of next block of points in lattice tiling
+  UINT8 *first_index                    ///< [out] Index of first point in block
+  );
+
 ///
 /// Return the total number of points covered by the lattice tiling iterator.
 ///
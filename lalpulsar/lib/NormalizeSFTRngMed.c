@@ -18,7 +18,14 @@
 *  MA  02110-1301  USA
 */
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include <lal/NormalizeSFTRngMed.h>
+#include <lal/LogPrintf.h>
+
+#include "SFTutils_internal.h"
 
 /**
  * \addtogroup NormalizeSFTRngMed_h
@@ -49,6 +56,7 @@
  * XLALNormalizeSFT ()
  * XLALNormalizeSFTVect ()
  * XLALNormalizeMultiSFTVect ()
+ * XLALNormalizeMultiSFTVectAndNoiseWeights ()
  * \endcode
  *
  * The function XLALNormalizeSFTVect() takes as input a vector of SFTs and normalizes
@@ -59,8 +67,17 @@
  * of SFT vectors and also returns a collection of power-estimates for these vectors using
  * the Running median method.
  *
+ * The function XLALNormalizeMultiSFTVectAndNoiseWeights() does the same, and also computes the
+ * SFT noise weights of XLALComputeMultiNoiseWeights(), in a single pass over all SFTs which is
+ * distributed over threads. Each thread reuses its own periodogram and running-median workspaces,
+ * so that the running-median PSDs need not be stored unless they are requested.
+ *
  */
 
+// ---------- local prototypes ----------
+static int SFTtoRngmed ( REAL8FrequencySeries *rngmed, const SFTtype *sft, UINT4 blockSize, REAL8Vector *periodoWorkspace );
+static int NormalizeSFT ( REAL8FrequencySeries *rngmed, SFTtype *sft, UINT4 blockSize, const REAL8 assumeSqrtS, REAL8Vector *periodoWorkspace );
+
 /**
  * Normalize an sft based on RngMed estimated PSD, and returns running-median.
  */
@@ -71,48 +88,8 @@ XLALNormalizeSFT ( REAL8FrequencySeries *rngmed, 	/**< [out] rng-median smoothed
                    const REAL8          assumeSqrtS	/**< If >0, instead assume sqrt(S) value *instead* of calculating PSD from running median */
                    )
 {
-  /* check input argments */
-  XLAL_CHECK (sft && sft->data && sft->data->data && sft->data->length > 0, XLAL_EINVAL, "Invalid NULL or zero-length input in 'sft'" );
-
-  XLAL_CHECK ( rngmed && rngmed->data && rngmed->data->data && rngmed->data->length > 0, XLAL_EINVAL, "Invalid NULL or zero-length input in 'rngmed'" );
-  /* make sure there is no size mismatch */
-  UINT4 length = sft->data->length;
-  XLAL_CHECK ( length == rngmed->data->length, XLAL_EINVAL, "SFT length (%d) differs from rngmed length (%d)", length, rngmed->data->length );
-
-  XLAL_CHECK ( assumeSqrtS >= 0.0, XLAL_EINVAL );
-
-  if ( assumeSqrtS == 0)
-    { /* calculate the rngmed */
-      XLAL_CHECK ( XLALSFTtoRngmed (rngmed, sft, blockSize) == XLAL_SUCCESS, XLAL_EFUNC, "XLALSFTtoRngmed() failed" );
-    }
-  else
-    {
-      // copy whole SFT header info to be on the safe side (deltaF definitely needed for Tsft=1/deltaF later)
-      strcpy ( rngmed->name, sft->name );
-      rngmed->epoch 	 = sft->epoch;
-      rngmed->f0 	 = sft->f0;
-      rngmed->deltaF 	 = sft->deltaF;
-      rngmed->sampleUnits= sft->sampleUnits;
-
-      /* set PSD to constant value: Tsft * S / 2 = Tsft * (sqrt(S))^2 / 2 */
-      const REAL8 Tsft = 1.0 / sft->deltaF;
-      const REAL8 assume_Tsft_Sn_b2 = Tsft * assumeSqrtS*assumeSqrtS / 2;
-      for (UINT4 j = 0; j < length; j++) {
-        rngmed->data->data[j] = assume_Tsft_Sn_b2;
-      }
-    }
-
-  /* loop over sft and normalize */
-  for (UINT4 j = 0; j < length; j++)
-    {
-      REAL8 Tsft_Sn_b2 = rngmed->data->data[j];		/* Wiener-Kinchine: E[|data|^2] = Tsft * Sn / 2 */
-      REAL8 norm = 1.0 / sqrt(Tsft_Sn_b2);
-      /* frequency domain normalization */
-      sft->data->data[j] *= ((REAL4) norm);
-    } // for j < length
-
+  XLAL_CHECK ( NormalizeSFT ( rngmed, sft, blockSize, assumeSqrtS, NULL ) == XLAL_SUCCESS, XLAL_EFUNC );
   return XLAL_SUCCESS;
-
 } /* XLALNormalizeSFT() */
 
 
@@ -211,6 +188,197 @@ XLALNormalizeMultiSFTVect ( MultiSFTVector *multsft,		/**< [in/out] multi-vector
 } /* XLALNormalizeMultiSFTVect() */
 
 
+/**
+ * Function for normalizing a multi vector of SFTs in a multi IFO search, which also computes the
+ * SFT noise weights, in a single pass over all SFTs distributed over \a numThreads threads.
+ *
+ * The normalized SFTs, running-median estimates of the power, and noise weights are identical to
+ * those returned by XLALNormalizeMultiSFTVect() followed by XLALComputeMultiNoiseWeights(). Each
+ * thread computes periodograms and, if \a multiPSD is NULL, running medians in its own reusable
+ * workspaces, so that the running-median estimates of the power are only stored if requested.
+ */
+int
+XLALNormalizeMultiSFTVectAndNoiseWeights ( MultiPSDVector **multiPSD,		/**< [out] running-median estimates of the power; may be NULL */
+                                           MultiNoiseWeights **multiWeights,	/**< [out] SFT noise weights, as computed by XLALComputeMultiNoiseWeights(); may be NULL */
+                                           MultiSFTVector *multsft,		/**< [in/out] multi-vector of SFTs which will be normalized */
+                                           UINT4 blockSize,			/**< Running median window size */
+                                           const MultiNoiseFloor *assumeSqrtSX,	/**< If !NULL, instead assume sqrt(S^X) values *instead* of calculating PSD from running median */
+                                           UINT4 excludePercentile,		/**< Percentile of frequency bins at either end of each SFT to exclude from the noise weights */
+                                           UINT4 numThreads,			/**< Number of threads: 1 = serial; 0 = OpenMP default number of threads */
+                                           REAL8 *wallTime			/**< [out] if !NULL, wall-clock time in seconds taken by this function */
+                                           )
+{
+  const REAL8 tic = XLALGetTimeOfDay();
+
+  /* check input argments */
+  XLAL_CHECK ( multsft && multsft->data && multsft->length > 0, XLAL_EINVAL, "Invalid NULL or zero-length input 'multsft'");
+  XLAL_CHECK ( assumeSqrtSX == NULL || assumeSqrtSX->length == multsft->length, XLAL_EINVAL );
+  XLAL_CHECK ( multiPSD == NULL || *multiPSD == NULL, XLAL_EINVAL );
+  XLAL_CHECK ( multiWeights == NULL || *multiWeights == NULL, XLAL_EINVAL );
+
+#ifdef _OPENMP
+  if ( numThreads == 0 ) {
+    numThreads = omp_get_max_threads();
+  }
+#else
+  (void) numThreads;
+  numThreads = 1;
+#endif
+
+  /* index of the first SFT of each IFO in a flattened list of all SFTs, and the maximal SFT length */
+  UINT4 numifo = multsft->length;
+  UINT4 firstSFT[numifo + 1];
+  UINT4 maxLength = 0;
+  firstSFT[0] = 0;
+  for ( UINT4 X = 0; X < numifo; X++ )
+    {
+      XLAL_CHECK ( multsft->data[X] != NULL, XLAL_EINVAL );
+      firstSFT[X + 1] = firstSFT[X] + multsft->data[X]->length;
+      for ( UINT4 j = 0; j < multsft->data[X]->length; j++ )
+        {
+          const COMPLEX8Vector *data = multsft->data[X]->data[j].data;
+          XLAL_CHECK ( data != NULL && data->data != NULL && data->length > 0, XLAL_EINVAL, "Invalid NULL or zero-length SFT %d of IFO %d", j, X );
+          XLAL_CHECK ( multiWeights == NULL || data->length >= blockSize, XLAL_EINVAL, "Need at least %d bins in SFT (have %d) to compute noise weights", blockSize, data->length );
+          if ( maxLength < data->length ) {
+            maxLength = data->length;
+          }
+        }
+    }
+  const UINT4 numSFTsTot = firstSFT[numifo];
+
+  /* allocate outputs: multipsd structure, and weights vectors; and per-thread periodogram and running-median workspaces */
+  MultiPSDVector *psd = NULL;
+  MultiNoiseWeights *weights = NULL;
+  REAL8Vector *periodoWorkspace[numThreads];
+  REAL8Vector *rngmedWorkspace[numThreads];
+  for ( UINT4 t = 0; t < numThreads; t++ )
+    {
+      periodoWorkspace[t] = rngmedWorkspace[t] = NULL;
+    }
+  if ( multiPSD != NULL )
+    {
+      XLAL_CHECK_FAIL ( ( psd = XLALCalloc ( 1, sizeof(*psd) ) ) != NULL, XLAL_ENOMEM );
+      XLAL_CHECK_FAIL ( ( psd->data = XLALCalloc ( numifo, sizeof(*psd->data) ) ) != NULL, XLAL_ENOMEM );
+      psd->length = numifo;
+      for ( UINT4 X = 0; X < numifo; X++ )
+        {
+          UINT4 numsft = multsft->data[X]->length;
+          XLAL_CHECK_FAIL ( ( psd->data[X] = XLALCalloc ( 1, sizeof(*psd->data[X]) ) ) != NULL, XLAL_ENOMEM );
+          XLAL_CHECK_FAIL ( ( psd->data[X]->data = XLALCalloc ( numsft, sizeof(*psd->data[X]->data) ) ) != NULL, XLAL_ENOMEM );
+          psd->data[X]->length = numsft;
+          for ( UINT4 j = 0; j < numsft; j++ )
+            {
+              XLAL_CHECK_FAIL ( ( psd->data[X]->data[j].data = XLALCreateREAL8Vector ( multsft->data[X]->data[j].data->length ) ) != NULL, XLAL_EFUNC );
+            }
+        }
+    }
+  if ( multiWeights != NULL )
+    {
+      XLAL_CHECK_FAIL ( ( weights = XLALCalloc ( 1, sizeof(*weights) ) ) != NULL, XLAL_ENOMEM );
+      XLAL_CHECK_FAIL ( ( weights->data = XLALCalloc ( numifo, sizeof(*weights->data) ) ) != NULL, XLAL_ENOMEM );
+      weights->length = numifo;
+      for ( UINT4 X = 0; X < numifo; X++ )
+        {
+          XLAL_CHECK_FAIL ( ( weights->data[X] = XLALCreateREAL8Vector ( multsft->data[X]->length ) ) != NULL, XLAL_EFUNC );
+        }
+    }
+  for ( UINT4 t = 0; t < numThreads; t++ )
+    {
+      XLAL_CHECK_FAIL ( ( periodoWorkspace[t] = XLALCreateREAL8Vector ( maxLength ) ) != NULL, XLAL_EFUNC );
+      if ( psd == NULL ) {
+        XLAL_CHECK_FAIL ( ( rngmedWorkspace[t] = XLALCreateREAL8Vector ( maxLength ) ) != NULL, XLAL_EFUNC );
+      }
+    }
+
+  /* loop over all sfts of all IFOs: normalize each SFT, and compute its unnormalized noise weight */
+  int errnum = 0;
+#pragma omp parallel for schedule(dynamic) num_threads(numThreads) if(numThreads > 1)
+  for ( UINT4 n = 0; n < numSFTsTot; n++ )
+    {
+#ifdef _OPENMP
+      const UINT4 t = omp_get_thread_num();
+#else
+      const UINT4 t = 0;
+#endif
+      UINT4 X = 0;
+      while ( n >= firstSFT[X + 1] ) {
+        X++;
+      }
+      const UINT4 j = n - firstSFT[X];
+      SFTtype *sft = &multsft->data[X]->data[j];
+
+      /* running-median estimate of the power, either to be returned or in this thread's workspace */
+      REAL8FrequencySeries rngmedView;
+      REAL8Vector rngmedViewData;
+      REAL8FrequencySeries *rngmed;
+      if ( psd != NULL )
+        {
+          rngmed = &psd->data[X]->data[j];
+        }
+      else
+        {
+          rngmedViewData.length = sft->data->length;
+          rngmedViewData.data = rngmedWorkspace[t]->data;
+          rngmedView.data = &rngmedViewData;
+          rngmed = &rngmedView;
+        }
+
+      /* if assumeSqrtSX is not given, pass 0.0 to calculate PSD from running median */
+      const REAL8 assumeSqrtS = (assumeSqrtSX != NULL) ? assumeSqrtSX->sqrtSn[X] : 0.0;
+
+      if ( NormalizeSFT ( rngmed, sft, blockSize, assumeSqrtS, periodoWorkspace[t] ) != XLAL_SUCCESS )
+        {
+#pragma omp critical (XLALNormalizeMultiSFTVectAndNoiseWeights)
+          errnum = XLAL_EFUNC;
+          continue;
+        }
+
+      if ( weights != NULL )
+        {
+          weights->data[X]->data[j] = RngmedToNoiseWeight ( rngmed, blockSize, excludePercentile );
+        }
+
+    } /* for n < numSFTsTot */
+
+  for ( UINT4 t = 0; t < numThreads; t++ )
+    {
+      XLALDestroyREAL8Vector ( periodoWorkspace[t] );
+      XLALDestroyREAL8Vector ( rngmedWorkspace[t] );
+      periodoWorkspace[t] = rngmedWorkspace[t] = NULL;
+    }
+  XLAL_CHECK_FAIL ( errnum == 0, errnum, "NormalizeSFT() failed" );
+
+  /* normalize the weights, in the same way as XLALComputeMultiNoiseWeights() */
+  if ( weights != NULL )
+    {
+      NormalizeMultiNoiseWeights ( weights, TSFTfromDFreq ( multsft->data[0]->data[0].deltaF ) );
+    }
+
+  if ( multiPSD != NULL ) {
+    *multiPSD = psd;
+  }
+  if ( multiWeights != NULL ) {
+    *multiWeights = weights;
+  }
+  if ( wallTime != NULL ) {
+    *wallTime = XLALGetTimeOfDay() - tic;
+  }
+
+  return XLAL_SUCCESS;
+
+XLAL_FAIL:
+  for ( UINT4 t = 0; t < numThreads; t++ )
+    {
+      XLALDestroyREAL8Vector ( periodoWorkspace[t] );
+      XLALDestroyREAL8Vector ( rngmedWorkspace[t] );
+    }
+  XLALDestroyMultiPSDVector ( psd );
+  XLALDestroyMultiNoiseWeights ( weights );
+  return XLAL_FAILURE;
+
+} /* XLALNormalizeMultiSFTVectAndNoiseWeights() */
+
+
 /**
  * Calculates a smoothed (running-median) periodogram for the given SFT.
  */
@@ -231,32 +399,7 @@ XLALSFTtoRngmed ( REAL8FrequencySeries *rngmed,	/**< [out] running-median smooth
                rngmed->data->length, sft->data->length );
   XLAL_CHECK ( rngmed->data->data != NULL, XLAL_EINVAL, "Invalid NULL pointer in rngmed->data->data" );
 
-  UINT4 length = sft->data->length;
-
-  REAL8FrequencySeries periodo;
-  XLAL_CHECK ( (periodo.data = XLALCreateREAL8Vector ( length )) != NULL, XLAL_EFUNC, "Failed to allocate periodo.data of length %d", length);
-
-  /* calculate the periodogram */
-  XLAL_CHECK ( XLALSFTtoPeriodogram ( &periodo, sft ) == XLAL_SUCCESS, XLAL_EFUNC, "Call to XLALSFTtoPeriodogram() failed.\n");
-
-  /* calculate the rngmed */
-  if ( blockSize > 0 )
-    {
-      XLAL_CHECK ( XLALPeriodoToRngmed ( rngmed, &periodo, blockSize ) == XLAL_SUCCESS, XLAL_EFUNC, "Call to XLALPeriodoToRngmed() failed." );
-    }
-  else	// blockSize==0 means don't use any running-median, just *copy* the periodogram contents into the output
-    {
-      strcpy ( rngmed->name, periodo.name );
-      rngmed->epoch 	= periodo.epoch;
-      rngmed->f0 	= periodo.f0;
-      rngmed->deltaF 	= periodo.deltaF;
-      rngmed->sampleUnits=periodo.sampleUnits;
-      memcpy ( rngmed->data->data, periodo.data->data, periodo.data->length * sizeof(periodo.data->data[0]) );
-    }
-
-  /* free memory */
-  XLALFree ( periodo.data->data );
-  XLALFree ( periodo.data );
+  XLAL_CHECK ( SFTtoRngmed ( rngmed, sft, blockSize, NULL ) == XLAL_SUCCESS, XLAL_EFUNC );
 
   return XLAL_SUCCESS;
 
@@ -421,3 +564,107 @@ XLALSFTstoCrossPeriodogram ( REAL8FrequencySeries *periodo,		/**< [out] modulus
   return XLAL_SUCCESS;
 
 } /* XLALSFTstoCrossPeriodogram() */
+
+
+/**
+ * Normalize an sft based on RngMed estimated PSD, and returns running-median; the periodogram is
+ * computed in \a periodoWorkspace if it is not NULL.
+ */
+static int
+NormalizeSFT ( REAL8FrequencySeries *rngmed, SFTtype *sft, UINT4 blockSize, const REAL8 assumeSqrtS, REAL8Vector *periodoWorkspace )
+{
+  /* check input argments */
+  XLAL_CHECK (sft && sft->data && sft->data->data && sft->data->length > 0, XLAL_EINVAL, "Invalid NULL or zero-length input in 'sft'" );
+
+  XLAL_CHECK ( rngmed && rngmed->data && rngmed->data->data && rngmed->data->length > 0, XLAL_EINVAL, "Invalid NULL or zero-length input in 'rngmed'" );
+  /* make sure there is no size mismatch */
+  UINT4 length = sft->data->length;
+  XLAL_CHECK ( length == rngmed->data->length, XLAL_EINVAL, "SFT length (%d) differs from rngmed length (%d)", length, rngmed->data->length );
+
+  XLAL_CHECK ( assumeSqrtS >= 0.0, XLAL_EINVAL );
+
+  if ( assumeSqrtS == 0)
+    { /* calculate the rngmed */
+      XLAL_CHECK ( SFTtoRngmed (rngmed, sft, blockSize, periodoWorkspace) == XLAL_SUCCESS, XLAL_EFUNC, "SFTtoRngmed() failed" );
+    }
+  else
+    {
+      // copy whole SFT header info to be on the safe side (deltaF definitely needed for Tsft=1/deltaF later)
+      strcpy ( rngmed->name, sft->name );
+      rngmed->epoch 	 = sft->epoch;
+      rngmed->f0 	 = sft->f0;
+      rngmed->deltaF 	 = sft->deltaF;
+      rngmed->sampleUnits= sft->sampleUnits;
+
+      /* set PSD to constant value: Tsft * S / 2 = Tsft * (sqrt(S))^2 / 2 */
+      const REAL8 Tsft = 1.0 / sft->deltaF;
+      const REAL8 assume_Tsft_Sn_b2 = Tsft * assumeSqrtS*assumeSqrtS / 2;
+      for (UINT4 j = 0; j < length; j++) {
+        rngmed->data->data[j] = assume_Tsft_Sn_b2;
+      }
+    }
+
+  /* loop over sft and normalize */
+  for (UINT4 j = 0; j < length; j++)
+    {
+      REAL8 Tsft_Sn_b2 = rngmed->data->data[j];		/* Wiener-Kinchine: E[|data|^2] = Tsft * Sn / 2 */
+      REAL8 norm = 1.0 / sqrt(Tsft_Sn_b2);
+      /* frequency domain normalization */
+      sft->data->data[j] *= ((REAL4) norm);
+    } // for j < length
+
+  return XLAL_SUCCESS;
+
+} /* NormalizeSFT() */
+
+
+/**
+ * Calculates a smoothed (running-median) periodogram for the given SFT; the periodogram is
+ * computed in \a periodoWorkspace if it is not NULL.
+ */
+static int
+SFTtoRngmed ( REAL8FrequencySeries *rngmed, const SFTtype *sft, UINT4 blockSize, REAL8Vector *periodoWorkspace )
+{
+  UINT4 length = sft->data->length;
+
+  REAL8FrequencySeries periodo;
+  REAL8Vector periodoView;
+  if ( periodoWorkspace != NULL )
+    {
+      XLAL_CHECK ( periodoWorkspace->length >= length, XLAL_EINVAL, "Periodogram workspace length (%d) is shorter than the SFT (%d)", periodoWorkspace->length, length );
+      periodoView.length = length;
+      periodoView.data = periodoWorkspace->data;
+      periodo.data = &periodoView;
+    }
+  else
+    {
+      XLAL_CHECK ( (periodo.data = XLALCreateREAL8Vector ( length )) != NULL, XLAL_EFUNC, "Failed to allocate periodo.data of length %d", length);
+    }
+
+  /* calculate the periodogram */
+  XLAL_CHECK ( XLALSFTtoPeriodogram ( &periodo, sft ) == XLAL_SUCCESS, XLAL_EFUNC, "Call to XLALSFTtoPeriodogram() failed.\n");
+
+  /* calculate the rngmed */
+  if ( blockSize > 0 )
+    {
+      XLAL_CHECK ( XLALPeriodoToRngmed ( rngmed, &periodo, blockSize ) == XLAL_SUCCESS, XLAL_EFUNC, "Call to XLALPeriodoToRngmed() failed." );
+    }
+  else	// blockSize==0 means don't use any running-median, just *copy* the periodogram contents into the output
+    {
+      strcpy ( rngmed->name, periodo.name );
+      rngmed->epoch 	= periodo.epoch;
+      rngmed->f0 	= periodo.f0;
+      rngmed->deltaF 	= periodo.deltaF;
+      rngmed->sampleUnits=periodo.sampleUnits;
+      memcpy ( rngmed->data->data, periodo.data->data, periodo.data->length * sizeof(periodo.data->data[0]) );
+    }
+
+  /* free memory */
+  if ( periodoWorkspace == NULL )
+    {
+      XLALDestroyREAL8Vector ( periodo.data );
+    }
+
+  return XLAL_SUCCESS;
+
+} /* SFTtoRngmed() */
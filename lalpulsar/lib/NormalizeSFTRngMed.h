@@ -59,6 +59,8 @@ int XLALPeriodoToRngmed ( REAL8FrequencySeries  *rngmed, const REAL8FrequencySer
 int XLALNormalizeSFT ( REAL8FrequencySeries *rngmed, SFTtype *sft, UINT4 blockSize, const REAL8 assumeSqrtS );
 int XLALNormalizeSFTVect ( SFTVector  *sftVect,	UINT4 blockSize, const REAL8 assumeSqrtS );
 MultiPSDVector * XLALNormalizeMultiSFTVect ( MultiSFTVector *multsft, UINT4 blockSize, const MultiNoiseFloor *assumeSqrtSX );
+int XLALNormalizeMultiSFTVectAndNoiseWeights ( MultiPSDVector **multiPSD, MultiNoiseWeights **multiWeights, MultiSFTVector *multsft, UINT4 blockSize,
+                                               const MultiNoiseFloor *assumeSqrtSX, UINT4 excludePercentile, UINT4 numThreads, REAL8 *wallTime );
 int XLALSFTstoCrossPeriodogram ( REAL8FrequencySeries *periodo, const COMPLEX8FrequencySeries *sft1, const COMPLEX8FrequencySeries *sft2 );
 
 /** @} */
@@ -19,6 +19,10 @@
  *  MA  02110-1301  USA
  */
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include <lal/PulsarCrossCorr_v2.h>
 
 #define SQUARE(x) ((x)*(x))
@@ -31,6 +35,48 @@
 #define FALSE (1==0)
 
 
+// ----- local types ----------
+
+/** Engine for evaluating the cross-correlation statistic over many templates */
+struct tagCrossCorrPairEngine
+{
+  UINT4 numThreads;             //!< number of OpenMP threads to use
+  UINT4 numSFTs;                //!< number of SFTs in the flat SFT list
+  UINT4 numPairs;               //!< number of SFT pairs
+  UINT4 *pairSFT1;              //!< flat index of the first SFT of each pair
+  UINT4 *pairSFT2;              //!< flat index of the second SFT of each pair
+  REAL8 *pairGAmp;              //!< amplitude of curly G for each pair
+  const COMPLEX8 **sftData;     //!< data of each SFT
+  UINT4 *sftLength;             //!< number of frequency bins of each SFT
+  BOOLEAN *sftPaired;           //!< whether each SFT appears in at least one pair
+  COMPLEX16 *sftPhaseSum;       //!< per template: phase-corrected, sinc-weighted alternating sum over the bins of each SFT
+  REAL8 *sftSincSqr;            //!< per template: sum over the bins of each SFT of the squared sinc factors
+};
+
+/** Per-thread data of a ResampCrossCorrEngine */
+typedef struct tagResampCrossCorrThreadData
+{
+  ResampCrossCorrWorkspace *ws; //!< workspace with a batched A/B FFT plan
+  COMPLEX8 *FaX_K;              //!< Fa of SFT K at detector X
+  COMPLEX8 *FbX_K;              //!< Fb of SFT K at detector X
+  COMPLEX8 *FaY_L;              //!< Fa of the SFTs L at detector Y paired with SFT K
+  COMPLEX8 *FbY_L;              //!< Fb of the SFTs L at detector Y paired with SFT K
+  REAL8 *numeEquivAve;          //!< partial sum of the average statistic over the SFTs K handled by this thread
+} ResampCrossCorrThreadData;
+
+/** Engine for evaluating the resampled cross-correlation statistic over many templates */
+struct tagResampCrossCorrEngine
+{
+  UINT4 numThreads;             //!< number of OpenMP threads to use
+  UINT4 numFreqBinsOut;         //!< number of output frequency bins
+  const MultiResampSFTPairMultiIndexList *resampMultiPairs; //!< resamp multi list of SFT pairs
+  UINT4 numSFTsK;               //!< number of SFTs K over all detectors X
+  UINT4 *detXOfK;               //!< detector index X of each SFT K
+  UINT4 *sftKOfK;               //!< index of each SFT K in the list for its detector X
+  REAL8 curlyEquivGSqrSum;      //!< sum over all pairs of the squared curly G amplitudes
+  ResampCrossCorrThreadData *thread; //!< per-thread data
+};
+
 // ----- local prototypes ----------
 static int
 XLALApplyCrossCorrFreqShiftResamp
@@ -1257,6 +1303,363 @@ int XLALCalculatePulsarCrossCorrStatisticResamp
   return XLAL_SUCCESS;
 } // end XLALCalculatePulsarCrossCorrStatisticResamp
 
+/** Create an engine for evaluating the cross-correlation statistic over many templates */
+/* The SFT pair list, the SFT data and the curly G amplitudes are flattened
+ * once into contiguous arrays, and the index checks which
+ * XLALCalculatePulsarCrossCorrStatistic() repeats for every template are made
+ * here instead. If numThreads is zero, all available OpenMP threads are used */
+int XLALCreateCrossCorrPairEngine
+(
+ CrossCorrPairEngine          **engine, /* Output: engine */
+ const SFTPairIndexList      *sftPairs, /* Input: flat list of SFT pairs */
+ const SFTIndexList        *sftIndices, /* Input: flat list of SFTs */
+ const MultiSFTVector       *inputSFTs, /* Input: SFT data */
+ const REAL8Vector          *curlyGAmp, /* Input: Amplitude of curly G for each pair */
+ const UINT4                numThreads  /* Input: number of OpenMP threads */
+ )
+{
+  XLAL_CHECK ( engine != NULL && *engine == NULL, XLAL_EINVAL );
+  XLAL_CHECK ( sftPairs != NULL && sftIndices != NULL && inputSFTs != NULL && curlyGAmp != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( curlyGAmp->length == sftPairs->length, XLAL_EBADLEN, "Lengths of pair-indexed lists don't match!" );
+
+  const UINT4 numSFTs = sftIndices->length;
+  const UINT4 numPairs = sftPairs->length;
+
+  /* Allocate engine */
+  CrossCorrPairEngine *eng = XLALCalloc ( 1, sizeof(*eng) );
+  XLAL_CHECK ( eng != NULL, XLAL_ENOMEM );
+  eng->numSFTs = numSFTs;
+  eng->numPairs = numPairs;
+#ifdef _OPENMP
+  eng->numThreads = ( numThreads > 0 ) ? numThreads : (UINT4) omp_get_max_threads();
+#else
+  (void) numThreads;
+  eng->numThreads = 1;
+#endif
+  eng->pairSFT1 = XLALCalloc ( MYMAX ( numPairs, 1 ), sizeof(eng->pairSFT1[0]) );
+  eng->pairSFT2 = XLALCalloc ( MYMAX ( numPairs, 1 ), sizeof(eng->pairSFT2[0]) );
+  eng->pairGAmp = XLALCalloc ( MYMAX ( numPairs, 1 ), sizeof(eng->pairGAmp[0]) );
+  eng->sftData = XLALCalloc ( MYMAX ( numSFTs, 1 ), sizeof(eng->sftData[0]) );
+  eng->sftLength = XLALCalloc ( MYMAX ( numSFTs, 1 ), sizeof(eng->sftLength[0]) );
+  eng->sftPaired = XLALCalloc ( MYMAX ( numSFTs, 1 ), sizeof(eng->sftPaired[0]) );
+  eng->sftPhaseSum = XLALCalloc ( MYMAX ( numSFTs, 1 ), sizeof(eng->sftPhaseSum[0]) );
+  eng->sftSincSqr = XLALCalloc ( MYMAX ( numSFTs, 1 ), sizeof(eng->sftSincSqr[0]) );
+  if ( eng->pairSFT1 == NULL || eng->pairSFT2 == NULL || eng->pairGAmp == NULL || eng->sftData == NULL
+       || eng->sftLength == NULL || eng->sftPaired == NULL || eng->sftPhaseSum == NULL || eng->sftSincSqr == NULL ) {
+    XLALDestroyCrossCorrPairEngine ( eng );
+    XLAL_ERROR ( XLAL_ENOMEM );
+  }
+
+  /* Flatten the SFT data */
+  for ( UINT4 sftNum = 0; sftNum < numSFTs; sftNum++ ) {
+    const UINT4 detInd = sftIndices->data[sftNum].detInd;
+    const UINT4 sftInd = sftIndices->data[sftNum].sftInd;
+    if ( detInd >= inputSFTs->length || sftInd >= inputSFTs->data[detInd]->length ) {
+      XLALDestroyCrossCorrPairEngine ( eng );
+      XLAL_ERROR ( XLAL_EINVAL, "SFT asked for index off end of list:\n sftNum=%"LAL_UINT4_FORMAT", detInd=%"LAL_UINT4_FORMAT", sftInd=%"LAL_UINT4_FORMAT"\n", sftNum, detInd, sftInd );
+    }
+    eng->sftData[sftNum] = inputSFTs->data[detInd]->data[sftInd].data->data;
+    eng->sftLength[sftNum] = inputSFTs->data[detInd]->data[sftInd].data->length;
+  }
+
+  /* Flatten the SFT pairs and their curly G amplitudes */
+  for ( UINT4 alpha = 0; alpha < numPairs; alpha++ ) {
+    const UINT4 sftNum1 = sftPairs->data[alpha].sftNum[0];
+    const UINT4 sftNum2 = sftPairs->data[alpha].sftNum[1];
+    if ( sftNum1 >= numSFTs || sftNum2 >= numSFTs ) {
+      XLALDestroyCrossCorrPairEngine ( eng );
+      XLAL_ERROR ( XLAL_EINVAL, "SFT pair asked for SFT index off end of list:\n alpha=%"LAL_UINT4_FORMAT", sftNum1=%"LAL_UINT4_FORMAT", sftNum2=%"LAL_UINT4_FORMAT", numSFTs=%"LAL_UINT4_FORMAT"\n", alpha, sftNum1, sftNum2, numSFTs );
+    }
+    eng->pairSFT1[alpha] = sftNum1;
+    eng->pairSFT2[alpha] = sftNum2;
+    eng->pairGAmp[alpha] = curlyGAmp->data[alpha];
+    eng->sftPaired[sftNum1] = eng->sftPaired[sftNum2] = TRUE;
+  }
+
+  /* Initialize lookup table before it is used by several threads */
+  XLALSinCosLUTInit();
+
+  (*engine) = eng;
+  return XLAL_SUCCESS;
+} // end XLALCreateCrossCorrPairEngine
+
+/** Calculate multi-bin cross-correlation statistic using a pair engine */
+/* Equivalent to XLALCalculatePulsarCrossCorrStatistic(), but the double sum
+ * over the bins of each pair is factorized: since the alternating sign is
+ * (-1)**(k1-k2) = (-1)**k1 (-1)**k2, the sinc-weighted, phase-corrected sums
+ * over the bins of each SFT are computed once, and each pair then needs only
+ * one complex product. Both the sums over SFTs and the sum over pairs are
+ * distributed over the engine's OpenMP threads. */
+int XLALCalculatePulsarCrossCorrStatisticEngine
+(
+ REAL8                               *ccStat, /* Output: cross-correlation statistic rho */
+ REAL8                            *evSquared, /* Output: (E[rho]/h0^2)^2 */
+ CrossCorrPairEngine                 *engine, /* Input: pair engine */
+ const COMPLEX8Vector       *expSignalPhases, /* Input: Phase of signal for each SFT */
+ const UINT4Vector               *lowestBins, /* Input: Bin index to start with for each SFT */
+ const REAL8VectorSequence         *sincList, /* Input: input the sinc factors*/
+ const MultiNoiseWeights       *multiWeights, /* Input: nomalizeation factor S^-1 & weights for each SFT */
+ const UINT4                         numBins  /* Input Number of frequency bins to be taken into calc */
+ )
+{
+  XLAL_CHECK ( ccStat != NULL && evSquared != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( engine != NULL && expSignalPhases != NULL && lowestBins != NULL && sincList != NULL && multiWeights != NULL, XLAL_EINVAL );
+
+  const UINT4 numSFTs = engine->numSFTs;
+  if ( expSignalPhases->length !=numSFTs
+       || lowestBins->length !=numSFTs
+       || sincList->length !=numSFTs
+       || sincList->vectorLength != numBins ) {
+    XLALPrintError("Lengths of SFT-indexed lists don't match!");
+    XLAL_ERROR(XLAL_EBADLEN );
+  }
+
+  /* Sum over the bins of each SFT */
+  int errnum = 0;
+#pragma omp parallel for schedule(static) num_threads(engine->numThreads)
+  for (UINT4 sftNum = 0; sftNum < numSFTs; sftNum++) {
+    engine->sftPhaseSum[sftNum] = 0;
+    engine->sftSincSqr[sftNum] = 0;
+    if ( !engine->sftPaired[sftNum] ) {
+      continue;
+    }
+    const UINT4 lowestBin = lowestBins->data[sftNum];
+    if ( (lowestBin + numBins - 1) >= engine->sftLength[sftNum] ) {
+#pragma omp critical (XLALCalculatePulsarCrossCorrStatisticEngine)
+      errnum = XLAL_EINVAL;
+      continue;
+    }
+    const COMPLEX8 *data = engine->sftData[sftNum] + lowestBin;
+    const REAL8 *sinc = sincList->data + sftNum * numBins;
+    COMPLEX16 phaseSum = 0;
+    REAL8 sincSqr = 0;
+    REAL8 sign = ( lowestBin % 2 == 0 ) ? 1 : -1;
+    for (UINT4 j = 0; j < numBins; j++) {
+      phaseSum += sign * sinc[j] * data[j];
+      sincSqr += SQUARE( sinc[j] );
+      sign = -sign;
+    }
+    engine->sftPhaseSum[sftNum] = conj( expSignalPhases->data[sftNum] ) * phaseSum;
+    engine->sftSincSqr[sftNum] = sincSqr;
+  }
+  XLAL_CHECK ( errnum == 0, errnum, "Loop would run off end of SFT data array: numBins=%"LAL_UINT4_FORMAT"\n", numBins );
+
+  /* Sum over pairs */
+  REAL8 nume = 0;
+  REAL8 curlyGSqr = 0;
+#pragma omp parallel for schedule(static) num_threads(engine->numThreads) reduction(+:nume,curlyGSqr)
+  for (UINT4 alpha = 0; alpha < engine->numPairs; alpha++) {
+    const UINT4 sftNum1 = engine->pairSFT1[alpha];
+    const UINT4 sftNum2 = engine->pairSFT2[alpha];
+    const REAL8 GalphaAmp = engine->pairGAmp[alpha];
+    nume += GalphaAmp * creal( conj( engine->sftPhaseSum[sftNum1] ) * engine->sftPhaseSum[sftNum2] );
+    curlyGSqr += SQUARE( GalphaAmp ) * engine->sftSincSqr[sftNum1] * engine->sftSincSqr[sftNum2];
+  }
+
+  if (curlyGSqr == 0.0)
+    {
+      *evSquared = 0.0;
+      *ccStat = 0.0;
+    }
+  else
+    {
+      *evSquared = 8 * SQUARE(multiWeights->Sinv_Tsft) * curlyGSqr;
+      *ccStat = 4 * multiWeights->Sinv_Tsft * nume / sqrt(*evSquared);
+    }
+  return XLAL_SUCCESS;
+} // end XLALCalculatePulsarCrossCorrStatisticEngine
+
+/** Create an engine for evaluating the resampled cross-correlation statistic over many templates */
+/* The SFTs K of the pair list are flattened once into a task list, and the
+ * normalization over all pairs is computed once. Each OpenMP thread gets its
+ * own workspace, whose FFT plan transforms the A and B time series of an SFT
+ * in one batched call. If numThreads is zero, all available threads are used */
+int XLALCreateResampCrossCorrEngine
+(
+ ResampCrossCorrEngine                  **engine,           /**< [out] engine */
+ const ResampCrossCorrWorkspace          *ws,               /**< [in] workspace from XLALCreateCrossCorrWorkspace() */
+ const MultiResampSFTPairMultiIndexList  *resampMultiPairs, /**< [in] resamp multi list of SFT pairs */
+ const REAL8Vector                       *resampCurlyGAmp,  /**< [in] amplitude of curly G for each L_Y_K_X (alpha-indexed) */
+ const UINT4                              numThreads        /**< [in] number of OpenMP threads */
+ )
+{
+  XLAL_CHECK ( engine != NULL && *engine == NULL, XLAL_EINVAL );
+  XLAL_CHECK ( ws != NULL && resampMultiPairs != NULL && resampCurlyGAmp != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( resampCurlyGAmp->length >= resampMultiPairs->allPairCount, XLAL_EBADLEN );
+
+  const UINT4 numSamplesFFT = ws->numSamplesFFT;
+  const UINT4 numFreqBins = ws->numFreqBinsOut;
+
+  /* Allocate engine */
+  ResampCrossCorrEngine *eng = XLALCalloc ( 1, sizeof(*eng) );
+  XLAL_CHECK ( eng != NULL, XLAL_ENOMEM );
+  eng->numFreqBinsOut = numFreqBins;
+  eng->resampMultiPairs = resampMultiPairs;
+#ifdef _OPENMP
+  eng->numThreads = ( numThreads > 0 ) ? numThreads : (UINT4) omp_get_max_threads();
+#else
+  (void) numThreads;
+  eng->numThreads = 1;
+#endif
+
+  /* Flatten the SFTs K over all detectors X */
+  for (UINT4 detX=0; detX < resampMultiPairs->length; detX++) {
+    eng->numSFTsK += resampMultiPairs->data[detX].length;
+  }
+  eng->detXOfK = XLALCalloc ( MYMAX ( eng->numSFTsK, 1 ), sizeof(eng->detXOfK[0]) );
+  eng->sftKOfK = XLALCalloc ( MYMAX ( eng->numSFTsK, 1 ), sizeof(eng->sftKOfK[0]) );
+  eng->thread = XLALCalloc ( eng->numThreads, sizeof(eng->thread[0]) );
+  if ( eng->detXOfK == NULL || eng->sftKOfK == NULL || eng->thread == NULL ) {
+    XLALDestroyResampCrossCorrEngine ( eng );
+    XLAL_ERROR ( XLAL_ENOMEM );
+  }
+  for (UINT4 detX=0, K=0; detX < resampMultiPairs->length; detX++) {
+    for (UINT4 sftK=0; sftK < resampMultiPairs->data[detX].length; sftK++, K++) {
+      eng->detXOfK[K] = detX;
+      eng->sftKOfK[K] = sftK;
+    }
+  }
+
+  /* Normalization factor, which is independent of the template */
+  for (UINT4 alpha=0; alpha < resampMultiPairs->allPairCount; alpha++) {
+    eng->curlyEquivGSqrSum += SQUARE(resampCurlyGAmp->data[alpha]);
+  }
+
+  /* Create per-thread workspaces with batched A/B FFT plans */
+  for (UINT4 t = 0; t < eng->numThreads; t++) {
+    ResampCrossCorrThreadData *td = &eng->thread[t];
+    ResampCrossCorrWorkspace *tws = td->ws = XLALCalloc ( 1, sizeof(*tws) );
+    if ( tws == NULL ) {
+      XLALDestroyResampCrossCorrEngine ( eng );
+      XLAL_ERROR ( XLAL_ENOMEM );
+    }
+    tws->batchedFFT = TRUE;
+    tws->decimateFFT = ws->decimateFFT;
+    tws->numSamplesFFT = numSamplesFFT;
+    tws->numFreqBinsOut = numFreqBins;
+    tws->TS_FFT = fftw_malloc ( 2 * numSamplesFFT * sizeof(COMPLEX8) );
+    tws->FabX_Raw = fftw_malloc ( 2 * numSamplesFFT * sizeof(COMPLEX8) );
+    tws->FaX_k = XLALCalloc ( numFreqBins, sizeof(COMPLEX8) );
+    tws->FbX_k = XLALCalloc ( numFreqBins, sizeof(COMPLEX8) );
+    td->FaX_K = XLALCalloc ( numFreqBins, sizeof(COMPLEX8) );
+    td->FbX_K = XLALCalloc ( numFreqBins, sizeof(COMPLEX8) );
+    td->FaY_L = XLALCalloc ( numFreqBins, sizeof(COMPLEX8) );
+    td->FbY_L = XLALCalloc ( numFreqBins, sizeof(COMPLEX8) );
+    td->numeEquivAve = XLALCalloc ( numFreqBins, sizeof(REAL8) );
+    if ( tws->TS_FFT == NULL || tws->FabX_Raw == NULL || tws->FaX_k == NULL || tws->FbX_k == NULL
+         || td->FaX_K == NULL || td->FbX_K == NULL || td->FaY_L == NULL || td->FbY_L == NULL || td->numeEquivAve == NULL ) {
+      XLALDestroyResampCrossCorrEngine ( eng );
+      XLAL_ERROR ( XLAL_ENOMEM );
+    }
+    const int fftLength = numSamplesFFT;
+    LAL_FFTW_WISDOM_LOCK;
+    tws->fftplan = fftwf_plan_many_dft ( 1, &fftLength, 2, tws->TS_FFT, NULL, 1, fftLength, tws->FabX_Raw, NULL, 1, fftLength, FFTW_FORWARD, FFTW_MEASURE );
+    LAL_FFTW_WISDOM_UNLOCK;
+    if ( tws->fftplan == NULL ) {
+      XLALDestroyResampCrossCorrEngine ( eng );
+      XLAL_ERROR ( XLAL_EFAILED, "fftwf_plan_many_dft() failed\n" );
+    }
+  }
+
+  /* Initialize lookup table before it is used by several threads */
+  XLALSinCosLUTInit();
+
+  (*engine) = eng;
+  return XLAL_SUCCESS;
+} // end XLALCreateResampCrossCorrEngine
+
+/** Calculate multi-bin cross-correlation statistic using resampling and an engine */
+/* Equivalent to XLALCalculatePulsarCrossCorrStatisticResamp(), but the SFTs K
+ * are distributed over the engine's OpenMP threads in fixed contiguous blocks,
+ * so that for a given number of threads the result does not depend on
+ * scheduling; partial sums are added up in thread order */
+int XLALCalculatePulsarCrossCorrStatisticResampEngine
+(
+ REAL8Vector                             *restrict ccStatVector,           /**< [out] vector cross-correlation statistic rho */
+ REAL8Vector                             *restrict evSquaredVector,        /**< [out] vector (E[rho]/h0^2) */
+ REAL8Vector                             *restrict numeEquivAve,           /**< [out] vector for intermediate average statistic */
+ REAL8Vector                             *restrict numeEquivCirc,          /**< [out] vector for intermediate circular statistic */
+ ResampCrossCorrEngine                   *restrict engine,                 /**< [in/out] resampling engine */
+ const MultiNoiseWeights                 *restrict multiWeights,           /**< [in] normalization factor S^-1 & weights for each SFT */
+ const PulsarDopplerParams               *restrict binaryTemplateSpacings, /**< [in] Set of spacings for search */
+ const PulsarDopplerParams               *restrict dopplerpos,             /**< [in] Doppler point to search */
+ const MultiCOMPLEX8TimeSeries           *restrict multiTimeSeries_SRC_a,  /**< [in] resampled time series A */
+ const MultiCOMPLEX8TimeSeries           *restrict multiTimeSeries_SRC_b   /**< [in] resampled time series B */
+ )
+{
+  XLAL_CHECK ( engine != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( multiWeights != NULL && binaryTemplateSpacings != NULL && dopplerpos != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( multiTimeSeries_SRC_a != NULL && multiTimeSeries_SRC_b != NULL, XLAL_EINVAL );
+  const UINT4 numFreqBins = engine->numFreqBinsOut;
+  XLAL_CHECK ( ccStatVector != NULL && ccStatVector->length >= numFreqBins, XLAL_EINVAL );
+  XLAL_CHECK ( evSquaredVector != NULL && evSquaredVector->length >= numFreqBins, XLAL_EINVAL );
+  XLAL_CHECK ( numeEquivAve != NULL && numeEquivAve->length >= numFreqBins, XLAL_EINVAL );
+  XLAL_CHECK ( numeEquivCirc != NULL && numeEquivCirc->length >= numFreqBins, XLAL_EINVAL );
+
+  const MultiResampSFTPairMultiIndexList *resampMultiPairs = engine->resampMultiPairs;
+  const REAL8 dt_SRC = multiTimeSeries_SRC_b->data[0]->deltaT;
+  const REAL8 SRCsampPerTcoh = resampMultiPairs->Tshort/dt_SRC;
+
+  /* Reset all partial sums, including those of threads which may not be started */
+  for (UINT4 t = 0; t < engine->numThreads; t++) {
+    memset ( engine->thread[t].numeEquivAve, 0, numFreqBins * sizeof(REAL8) );
+  }
+
+  /* MAIN LOOP (RESAMPLING), over SFTs K */
+  int errnum = 0;
+#pragma omp parallel num_threads(engine->numThreads)
+  {
+#ifdef _OPENMP
+    ResampCrossCorrThreadData *td = &engine->thread[omp_get_thread_num()];
+#else
+    ResampCrossCorrThreadData *td = &engine->thread[0];
+#endif
+#pragma omp for schedule(static)
+    for (UINT4 K = 0; K < engine->numSFTsK; K++) {
+      if ( errnum != 0 ) {
+        continue;
+      }
+      const UINT4 detX = engine->detXOfK[K];
+      const UINT4 sftK = engine->sftKOfK[K];
+      if ( ( XLALComputeFaFb_CrossCorrResamp(td->ws, td->FaX_K, td->FbX_K, resampMultiPairs, multiTimeSeries_SRC_a, multiTimeSeries_SRC_b, dopplerpos, binaryTemplateSpacings, SRCsampPerTcoh, detX, sftK, 0, FALSE) ) != XLAL_SUCCESS) {
+#pragma omp critical (XLALCalculatePulsarCrossCorrStatisticResampEngine)
+        errnum = XLAL_EFUNC;
+        continue;
+      }
+      for (UINT4 detY=0; detY < resampMultiPairs->data[detX].data[sftK].length; detY++){
+        if ( ( XLALComputeFaFb_CrossCorrResamp(td->ws, td->FaY_L, td->FbY_L, resampMultiPairs, multiTimeSeries_SRC_a, multiTimeSeries_SRC_b, dopplerpos, binaryTemplateSpacings, SRCsampPerTcoh, detX, sftK, detY, TRUE) ) != XLAL_SUCCESS) {
+#pragma omp critical (XLALCalculatePulsarCrossCorrStatisticResampEngine)
+          errnum = XLAL_EFUNC;
+          break;
+        }
+        for (UINT4 j = 0; j < numFreqBins; j++){
+          td->numeEquivAve[j] += creal(0.1 * (  conj(td->FaX_K[j]) * td->FaY_L[j] + conj(td->FbX_K[j]) * td->FbY_L[j]  ) );
+        }
+      } /* detY */
+    } /* K */
+  }
+  XLAL_CHECK ( errnum == 0, errnum, "XLALComputeFaFb_CrossCorrResamp() failed\n" );
+
+  /* Add up partial sums in thread order */
+  for (UINT4 j = 0; j < numFreqBins; j++){
+    numeEquivAve->data[j] = 0;
+    numeEquivCirc->data[j] = 0;
+  }
+  for (UINT4 t = 0; t < engine->numThreads; t++) {
+    for (UINT4 j = 0; j < numFreqBins; j++){
+      numeEquivAve->data[j] += engine->thread[t].numeEquivAve[j];
+    }
+  }
+
+  /* Normalization as in XLALCalculatePulsarCrossCorrStatisticResamp() */
+  const REAL8 originalMultiWeightsSinvTsft = multiWeights->Sinv_Tsft * (resampMultiPairs->Tsft / resampMultiPairs->Tshort);
+  for (UINT4 j = 0; j < numFreqBins; j++){
+    evSquaredVector->data[j] = 8 * SQUARE(multiWeights->Sinv_Tsft) * engine->curlyEquivGSqrSum;
+    ccStatVector->data[j] = 4 * originalMultiWeightsSinvTsft * numeEquivAve->data[j] / sqrt(evSquaredVector->data[j]);
+  }
+  return XLAL_SUCCESS;
+} // end XLALCalculatePulsarCrossCorrStatisticResampEngine
+
 /** calculate signal phase derivatives wrt Doppler coords, for each SFT */
 /* allocates memory as well */
 int XLALCalculateCrossCorrPhaseDerivatives
@@ -2980,6 +3383,9 @@ XLALEquipCrossCorrPairsWithScienceFlags(
 
 
 /** Generates a resampling workspace for CrossCorr */
+/* The holders for detector 1 and 2 Fa and Fb are only needed by
+ * XLALCalculatePulsarCrossCorrStatisticResamp(); if ws1KFaX_kOut etc.
+ * are NULL, they are not allocated */
 int
 XLALCreateCrossCorrWorkspace( 
     ResampCrossCorrWorkspace  **        wsOut,                    /**< [out] workspace for one cross-correlation */
@@ -3000,10 +3406,8 @@ XLALCreateCrossCorrWorkspace(
     MultiCOMPLEX8TimeSeries  * multiTimeSeries_SRC_a = (*multiTimeSeries_SRC_aOut); 
     MultiCOMPLEX8TimeSeries  * multiTimeSeries_SRC_b = (*multiTimeSeries_SRC_bOut); 
 
-    COMPLEX8 *restrict ws1KFaX_k = (*ws1KFaX_kOut );
-    COMPLEX8 *restrict ws1KFbX_k = (*ws1KFbX_kOut );
-    COMPLEX8 *restrict ws2LFaX_k = (*ws2LFaX_kOut );
-    COMPLEX8 *restrict ws2LFbX_k = (*ws2LFbX_kOut );
+    const BOOLEAN wantFaFbHolders = ( ws1KFaX_kOut != NULL );
+    XLAL_CHECK ( ( ws1KFbX_kOut != NULL ) == wantFaFbHolders && ( ws2LFaX_kOut != NULL ) == wantFaFbHolders && ( ws2LFbX_kOut != NULL ) == wantFaFbHolders, XLAL_EINVAL );
     /* Extract base info from the resampled time series.
      * Use both a and b time series structs to make vars used */
     XLALExtractResampledTimeseries ( &multiTimeSeries_SRC_a, &multiTimeSeries_SRC_b, resampFstatInput );
@@ -3095,14 +3499,12 @@ XLALCreateCrossCorrWorkspace(
     LAL_FFTW_WISDOM_UNLOCK;
     /* -- finish creating FFT plan with FFTW */
 
-    XLAL_CHECK ( (ws1KFaX_k = fftw_malloc ( numFreqBins * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
-    XLAL_CHECK ( (ws1KFbX_k = fftw_malloc ( numFreqBins * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
-    XLAL_CHECK ( (ws2LFaX_k = fftw_malloc ( numFreqBins * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
-    XLAL_CHECK ( (ws2LFbX_k = fftw_malloc ( numFreqBins * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
-    (*ws1KFaX_kOut ) = ws1KFaX_k;
-    (*ws1KFbX_kOut ) = ws1KFbX_k;
-    (*ws2LFaX_kOut ) = ws2LFaX_k;
-    (*ws2LFbX_kOut ) = ws2LFbX_k;
+    if ( wantFaFbHolders ) {
+      XLAL_CHECK ( ((*ws1KFaX_kOut ) = fftw_malloc ( numFreqBins * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
+      XLAL_CHECK ( ((*ws1KFbX_kOut ) = fftw_malloc ( numFreqBins * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
+      XLAL_CHECK ( ((*ws2LFaX_kOut ) = fftw_malloc ( numFreqBins * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
+      XLAL_CHECK ( ((*ws2LFbX_kOut ) = fftw_malloc ( numFreqBins * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
+    }
     (*wsOut) = ws;
     return XLAL_SUCCESS;
 } /* XLALCreateCrossCorrWorkspace */
@@ -3274,6 +3676,56 @@ XLALDestroyResampCrossCorrWorkspace ( void *workspace )
 
 } // XLALDestroyResampWorkspace()
 
+/**
+ * Destroy a CrossCorrPairEngine structure.
+ */
+void
+XLALDestroyCrossCorrPairEngine ( CrossCorrPairEngine *engine )
+{
+  if ( engine == NULL ) {
+    return;
+  }
+  XLALFree ( engine->pairSFT1 );
+  XLALFree ( engine->pairSFT2 );
+  XLALFree ( engine->pairGAmp );
+  XLALFree ( engine->sftData );
+  XLALFree ( engine->sftLength );
+  XLALFree ( engine->sftPaired );
+  XLALFree ( engine->sftPhaseSum );
+  XLALFree ( engine->sftSincSqr );
+  XLALFree ( engine );
+} // XLALDestroyCrossCorrPairEngine()
+
+/**
+ * Destroy a ResampCrossCorrEngine structure.
+ * Note, this is "NULL-robust" in the sense that it can be used
+ * for failure-cleanup even on incomplete structs
+ */
+void
+XLALDestroyResampCrossCorrEngine ( ResampCrossCorrEngine *engine )
+{
+  if ( engine == NULL ) {
+    return;
+  }
+  if ( engine->thread != NULL ) {
+    for ( UINT4 t = 0; t < engine->numThreads; t++ ) {
+      ResampCrossCorrThreadData *td = &engine->thread[t];
+      if ( td->ws != NULL ) {
+        XLALDestroyResampCrossCorrWorkspace ( td->ws );
+      }
+      XLALFree ( td->FaX_K );
+      XLALFree ( td->FbX_K );
+      XLALFree ( td->FaY_L );
+      XLALFree ( td->FbY_L );
+      XLALFree ( td->numeEquivAve );
+    }
+    XLALFree ( engine->thread );
+  }
+  XLALFree ( engine->detXOfK );
+  XLALFree ( engine->sftKOfK );
+  XLALFree ( engine );
+} // XLALDestroyResampCrossCorrEngine()
+
 // ---------- internal functions ----------
 
 /** Imported and modified from ComputeFstat_Resamp.c */
@@ -3521,6 +3973,9 @@ XLALComputeFaFb_CrossCorrResamp
             startFirstInd = resampDataArrayA->data->length;
         }
 
+        /* with a batched FFT plan, the B time series is loaded after the A
+         * time series in the same buffer, and both are transformed at once */
+        const UINT4 offsetB = ws->batchedFFT ? ws->numSamplesFFT : 0;
         memset ( ws->TS_FFT, 0, ws->numSamplesFFT * sizeof(ws->TS_FFT[0]) );
         UINT4 sftLength = 0;
         if (isL == TRUE){
@@ -3552,14 +4007,16 @@ XLALComputeFaFb_CrossCorrResamp
             XLAL_CHECK ( XLALApplyCrossCorrFreqShiftResamp ( ws->TS_FFT, resampDataArrayA, dopplerpos, freqShiftInFFT, startInd, endInd, ws->numSamplesFFT, headOfSliceIndex ) == XLAL_SUCCESS, XLAL_EFUNC );
           //}
         }
-        fftwf_execute ( ws->fftplan );
-        for ( UINT4 k = 0; k < ws->numFreqBinsOut; k++ ) {
-          ws->FaX_k[k] = ws->FabX_Raw [ offset_bins + (UINT4)floor(k * RedecimateFFT)  ];
+        if ( !ws->batchedFFT ) {
+          fftwf_execute ( ws->fftplan );
+          for ( UINT4 k = 0; k < ws->numFreqBinsOut; k++ ) {
+            ws->FaX_k[k] = ws->FabX_Raw [ offset_bins + (UINT4)floor(k * RedecimateFFT)  ];
+          }
         }
         // END load and FFT A time series
 
         // Load and FFT B time series
-        memset ( ws->TS_FFT, 0, ws->numSamplesFFT * sizeof(ws->TS_FFT[0]) );
+        memset ( ws->TS_FFT + offsetB, 0, ws->numSamplesFFT * sizeof(ws->TS_FFT[0]) );
         for (UINT4 sft=0; sft < sftLength; sft++){
           //if (resampMultiPairsDetXsftK->data[detY].data[sft].sciFlag > 0){
             if (isL == TRUE){
@@ -3579,12 +4036,17 @@ XLALComputeFaFb_CrossCorrResamp
                 startInd = endInd;
             }
             UINT4 headOfSliceIndex = startInd - startFirstInd;
-            XLAL_CHECK ( XLALApplyCrossCorrFreqShiftResamp ( ws->TS_FFT, resampDataArrayB, dopplerpos, freqShiftInFFT, startInd, endInd, ws->numSamplesFFT, headOfSliceIndex ) == XLAL_SUCCESS, XLAL_EFUNC );
+            XLAL_CHECK ( XLALApplyCrossCorrFreqShiftResamp ( ws->TS_FFT + offsetB, resampDataArrayB, dopplerpos, freqShiftInFFT, startInd, endInd, ws->numSamplesFFT, headOfSliceIndex ) == XLAL_SUCCESS, XLAL_EFUNC );
           //}
         }
         fftwf_execute ( ws->fftplan );
+        if ( ws->batchedFFT ) {
+          for ( UINT4 k = 0; k < ws->numFreqBinsOut; k++ ) {
+            ws->FaX_k[k] = ws->FabX_Raw [ offset_bins + (UINT4)floor(k * RedecimateFFT)  ];
+          }
+        }
         for ( UINT4 k = 0; k < ws->numFreqBinsOut; k++ ) {
-          ws->FbX_k[k] = ws->FabX_Raw [ offset_bins + (UINT4)floor(k * RedecimateFFT)  ];
+          ws->FbX_k[k] = ws->FabX_Raw [ offsetB + offset_bins + (UINT4)floor(k * RedecimateFFT)  ];
         }
         // End load and FFT B time series 
 
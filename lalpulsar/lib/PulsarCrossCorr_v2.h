@@ -232,6 +232,7 @@ typedef struct tagResampCrossCorrWorkspace
   fftwf_plan fftplan;           //!< buffer FFT plan for given numSamplesOut length
   COMPLEX8 *TS_FFT;             //!< zero-padded, spindown-corr SRC-frame TS
   COMPLEX8 *FabX_Raw;           //!< raw full-band FFT result Fa,Fb
+  BOOLEAN batchedFFT;           //!< if true, TS_FFT and FabX_Raw hold the A and B timeseries back-to-back, and fftplan transforms both at once
 
   // arrays of size numFreqBinsOut over frequency bins f_k:
   UINT4 numFreqBinsOut;         //!< number of output frequency bins {f_k}
@@ -246,6 +247,14 @@ typedef struct tagResampCrossCorrWorkspace
 
 /* end Resampling multi-types */
 
+/** Engine which evaluates the (demodulated) cross-correlation statistic for many templates,
+ * reusing a flattened copy of the SFT pair list and distributing the work over OpenMP threads */
+typedef struct tagCrossCorrPairEngine CrossCorrPairEngine;
+
+/** Engine which evaluates the resampled cross-correlation statistic for many templates,
+ * with one batched-FFT workspace per OpenMP thread */
+typedef struct tagResampCrossCorrEngine ResampCrossCorrEngine;
+
 /** A collection of UINT4Vectors -- one for each IFO  */
   /* Probably belongs in SFTUtils.h */
 typedef struct tagMultiUINT4Vector {
@@ -388,6 +397,55 @@ int XLALCalculatePulsarCrossCorrStatisticResamp
    )
   ;
 
+int XLALCreateCrossCorrPairEngine
+  (
+   CrossCorrPairEngine            ** engine,
+   const SFTPairIndexList          * sftPairs,
+   const SFTIndexList              * sftIndices,
+   const MultiSFTVector            * inputSFTs,
+   const REAL8Vector               * curlyGAmp,
+   const UINT4                       numThreads
+   )
+  ;
+
+int XLALCalculatePulsarCrossCorrStatisticEngine
+  (
+   REAL8                           * ccStat,
+   REAL8                           * evSquared,
+   CrossCorrPairEngine             * engine,
+   const COMPLEX8Vector            * expSignalPhases,
+   const UINT4Vector               * lowestBins,
+   const REAL8VectorSequence       * sincList,
+   const MultiNoiseWeights         * multiWeights,
+   const UINT4                       numBins
+   )
+  ;
+
+int XLALCreateResampCrossCorrEngine
+  (
+   ResampCrossCorrEngine                  ** engine,
+   const ResampCrossCorrWorkspace          * ws,
+   const MultiResampSFTPairMultiIndexList  * resampMultiPairs,
+   const REAL8Vector                       * resampCurlyGAmp,
+   const UINT4                               numThreads
+   )
+  ;
+
+int XLALCalculatePulsarCrossCorrStatisticResampEngine
+  (
+   REAL8Vector                             *_LAL_RESTRICT_ ccStatVector,
+   REAL8Vector                             *_LAL_RESTRICT_ evSquaredVector,
+   REAL8Vector                             *_LAL_RESTRICT_ numeEquivAve,
+   REAL8Vector                             *_LAL_RESTRICT_ numeEquivCirc,
+   ResampCrossCorrEngine                   *_LAL_RESTRICT_ engine,
+   const MultiNoiseWeights                 *_LAL_RESTRICT_ multiWeights,
+   const PulsarDopplerParams               *_LAL_RESTRICT_ binaryTemplateSpacings,
+   const PulsarDopplerParams               *_LAL_RESTRICT_ dopplerpos,
+   const MultiCOMPLEX8TimeSeries           *_LAL_RESTRICT_ multiTimeSeries_SRC_a,
+   const MultiCOMPLEX8TimeSeries           *_LAL_RESTRICT_ multiTimeSeries_SRC_b
+   )
+  ;
+
 int XLALCalculateCrossCorrPhaseDerivatives
   (
    REAL8VectorSequence           ** phaseDerivs,
@@ -655,6 +713,10 @@ void XLALDestroyMultiMatchList( MultiResampSFTMultiCountList * localMultiListOfL
 
 void XLALDestroyResampCrossCorrWorkspace ( void *workspace );
 
+void XLALDestroyCrossCorrPairEngine ( CrossCorrPairEngine *engine );
+
+void XLALDestroyResampCrossCorrEngine ( ResampCrossCorrEngine *engine );
+
 #ifdef  __cplusplus
 }                /* Close C++ protection */
 #endif
@@ -36,6 +36,8 @@
  */
 
 /*---------- INCLUDES ----------*/
+#include <config.h>
+
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <errno.h>
@@ -49,6 +51,12 @@
 #include <io.h>
 #endif
 
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 #include <lal/LALStdio.h>
 #include <lal/LALString.h>
 #include <lal/FileIO.h>
@@ -59,6 +67,8 @@
 #include <lal/UserInputParse.h>
 #include <lal/SFTutils.h>
 
+#include "SFTutils_internal.h"
+
 /*---------- DEFINES ----------*/
 
 #define MIN_SFT_VERSION 2
@@ -75,6 +85,16 @@
 #define SFTFILEIO_REALLOC_BLOCKSIZE 100
 #endif
 
+/** maximal number of SFT-files mapped at the same time while their SFT data is copied */
+#ifndef SFTFILEIO_MAP_BATCHSIZE
+#define SFTFILEIO_MAP_BATCHSIZE 1024
+#endif
+
+/** maximal number of SFT-files which stay mapped because they hold SFT data returned by XLALMapSFTs() */
+#ifndef SFTFILEIO_MAX_VIEW_MAPPINGS
+#define SFTFILEIO_MAX_VIEW_MAPPINGS 16384
+#endif
+
 /*----- Macros ----- */
 
 #define GPS2REAL8(gps) (1.0 * (gps).gpsSeconds + 1.e-9 * (gps).gpsNanoSeconds )
@@ -117,6 +137,34 @@ typedef struct {
   struct tagSFTLocator *lastfrom;  /**< last bin read from this locator */
 } SFTReadSegment;
 
+/** a memory-mapped SFT file */
+typedef struct tagSFTFileMapping
+{
+  const CHAR *fname;		/* name of mapped file (owned by the catalog locators) */
+  char *base;			/* start of mapped file contents */
+  size_t size;			/* size of mapped file in bytes */
+  BOOLEAN keep;			/* whether the file stays mapped, as it holds SFT data returned as views */
+} SFTFileMapping;
+
+/* NOTE: opaque type holding the memory-mappings behind a MappedSFTVector */
+struct tagSFTFileMappings
+{
+  UINT4 numMaps;		/* number of mapped SFT files */
+  SFTFileMapping *maps;		/* array of mapped SFT files */
+  UINT4 numSFTs;		/* number of SFTs */
+  BOOLEAN *isView;		/* whether the data of each SFT points into a mapped file */
+};
+
+/** a contiguous bin-range of one SFT to read from one SFT-descriptor */
+typedef struct
+{
+  UINT4 isft;			/* index of SFT this segment belongs to */
+  UINT4 first;			/* first bin to read from this segment */
+  UINT4 last;			/* last bin to read from this segment */
+  UINT4 idesc;			/* index of SFT-descriptor in catalog */
+  UINT4 imap;			/* index of mapped file containing this segment */
+} SFTMappedSegment;
+
 /* detector numbers as defined in Rome SFDBs
  * 0 is Nautilus but we won't support that
  */
@@ -177,6 +225,7 @@ static BOOLEAN is_pattern(const char*c); /* filename string is a glob-style patt
 
 static BOOLEAN consistent_mSFT_header ( SFTtype header1, UINT4 version1, UINT4 nsamples1, SFTtype header2, UINT4 version2, UINT4 nsamples2 );
 static BOOLEAN timestamp_in_list( LIGOTimeGPS timestamp, LIGOTimeGPSVector *list );
+static BOOLEAN sft_satisfies_constraints ( const SFTtype *header, const SFTConstraints *constraints );
 static long get_file_len ( FILE *fp );
 
 static FILE * fopen_SFTLocator ( const struct tagSFTLocator *locator );
@@ -187,7 +236,6 @@ static int read_v2_header_from_fp ( FILE *fp, SFTtype *header, UINT4 *nsamples,
 
 static int read_SFDB_header_from_fp ( FILE *fp, SFDBHeader *header );
 
-int compareSFTdesc(const void *ptr1, const void *ptr2);
 static int compareSFTloc(const void *ptr1, const void *ptr2);
 static int compareDetNameCatalogs ( const void *ptr1, const void *ptr2 );
 static int compareSFTepoch(const void *ptr1, const void *ptr2);
@@ -196,7 +244,25 @@ static UINT8 calc_crc64(const CHAR *data, UINT4 length, UINT8 crc);
 static BOOLEAN has_valid_v2_crc64 (FILE *fp );
 
 static int read_SFTversion_from_fp ( UINT4 *version, BOOLEAN *need_swap, FILE *fp );
-REAL8 TSFTfromDFreq ( REAL8 dFreq );
+
+static BOOLEAN can_map_catalog ( const SFTCatalog *catalog );
+static int map_sft_file ( SFTFileMapping *map );
+static void unmap_sft_file ( SFTFileMapping *map );
+static void destroy_sft_file_mappings ( struct tagSFTFileMappings *mappings );
+static int locate_mapped_sft_bins ( char **bins, BOOLEAN *swapEndian, const SFTFileMapping *map, const SFTDescriptor *desc );
+static int compareSFTMappedSegments ( const void *ptr1, const void *ptr2 );
+static int compareSFTMappedSegmentsByFile ( const void *ptr1, const void *ptr2 );
+static int compareSFTdescFname ( const void *ptr1, const void *ptr2 );
+static int load_sfts_mapped ( SFTVector **sftVector, struct tagSFTFileMappings **mappings, const SFTCatalog *catalog, REAL8 fMin, REAL8 fMax, BOOLEAN wantViews );
+
+static int write_index_string ( LALFILE *fp, const CHAR *str );
+static int read_index_string ( CHAR **str, const CHAR *token );
+static int get_index_file_status ( const CHAR *fname, UINT8 *size, INT8 *mtime );
+static int get_index_directory ( CHAR **dir, const CHAR *index_fname );
+static CHAR *get_index_sft_fname ( const CHAR *sft_fname, const CHAR *index_dir );
+static int append_catalog_descriptor ( SFTCatalog *catalog, UINT4 *numSFTs, const SFTDescriptor *desc );
+static int read_sft_file_descriptors ( SFTCatalog *catalog, UINT4 *numSFTs, const CHAR *fname, const SFTConstraints *constraints );
+static int compareSFTdescLocator ( const void *ptr1, const void *ptr2 );
 
 BOOLEAN CheckIfSFDBInScienceMode(SFDBHeader *SFDBHeader, LALStringVector *detectors, MultiLIGOTimeGPSVector *startingTS, MultiLIGOTimeGPSVector *endingTS);
 /*==================== FUNCTION DEFINITIONS ====================*/
@@ -271,6 +337,10 @@ UINT4 XLALRoundFrequencyUpToSFTBin( const REAL8 freq, const REAL8 df )
  *
  * The returned SFTs in the catalogue are sorted by increasing GPS-epochs !
  *
+ * If \a file_pattern is of the form <tt>index:\<indexfile\></tt>, the SFT headers are not
+ * read from the SFT files, but are taken from an SFT catalog index previously written by
+ * XLALWriteSFTCatalogIndex(); see XLALReadSFTCatalogIndex().
+ *
  */
 SFTCatalog *
 XLALSFTdataFind ( const CHAR *file_pattern,		/**< which SFT-files */
@@ -288,195 +358,52 @@ XLALSFTdataFind ( const CHAR *file_pattern,		/**< which SFT-files */
         }
     }
 
-  /* prepare return-catalog */
   SFTCatalog *ret;
-  XLAL_CHECK_NULL ( (ret = LALCalloc ( 1, sizeof (*ret) )) != NULL, XLAL_ENOMEM );
+  LALStringVector *fnames = NULL;
+  UINT4 numFiles = 0;
+  UINT4 numSFTs = 0;
+
+#define INDEX_PREFIX "index:"
+  if ( strncmp ( file_pattern, INDEX_PREFIX, strlen(INDEX_PREFIX) ) == 0 )
+    { /* take SFT headers from an SFT catalog index, and only apply the user-constraints */
+      const CHAR *index_fname = file_pattern + strlen(INDEX_PREFIX);
+      XLAL_CHECK_NULL ( (ret = XLALReadSFTCatalogIndex ( index_fname )) != NULL, XLAL_EFUNC, "Failed to read SFT catalog index '%s'.\n\n", index_fname );
+      for ( UINT4 i = 0; i < ret->length; i ++ )
+        {
+          SFTDescriptor *desc = &(ret->data[i]);
+          if ( sft_satisfies_constraints ( &(desc->header), constraints ) )
+            {
+              ret->data[numSFTs ++] = (*desc);
+            }
+          else
+            {
+              XLALFree ( desc->locator->fname );
+              XLALFree ( desc->locator );
+              XLALFree ( desc->comment );
+            }
+        }
+    }
+#undef INDEX_PREFIX
+  else
+    {
+      /* prepare return-catalog */
+      XLAL_CHECK_NULL ( (ret = LALCalloc ( 1, sizeof (*ret) )) != NULL, XLAL_ENOMEM );
 
-  /* find matching filenames */
-  LALStringVector *fnames;
-  XLAL_CHECK_NULL ( (fnames = XLALFindFiles (file_pattern)) != NULL, XLAL_EFUNC, "Failed to find filelist matching pattern '%s'.\n\n", file_pattern );
-  UINT4 numFiles = fnames->length;
+      /* find matching filenames */
+      XLAL_CHECK_NULL ( (fnames = XLALFindFiles (file_pattern)) != NULL, XLAL_EFUNC, "Failed to find filelist matching pattern '%s'.\n\n", file_pattern );
+      numFiles = fnames->length;
+    }
 
-  UINT4 numSFTs = 0;
   /* ----- main loop: parse all matching files */
   for ( UINT4 i = 0; i < numFiles; i ++ )
     {
-      const CHAR *fname = fnames->data[i];
-
-      /* merged SFTs need to satisfy stronger consistency-constraints (-> see spec) */
-      BOOLEAN mfirst_block = TRUE;
-      UINT4   mprev_version = 0;
-      SFTtype XLAL_INIT_DECL( mprev_header );
-      REAL8   mprev_nsamples = 0;
-
-      FILE *fp;
-      if ( ( fp = fopen( fname, "rb" ) ) == NULL )
-	{
-          XLALPrintError ("ERROR: Failed to open matched file '%s'\n\n", fname );
-	  XLALDestroyStringVector ( fnames );
-	  XLALDestroySFTCatalog ( ret );
-	  XLAL_ERROR_NULL ( XLAL_EIO );
-	}
-
-      long file_len;
-      if ( (file_len = get_file_len(fp)) == 0 )
-	{
-          XLALPrintError ("ERROR: got file-len == 0 for '%s'\n\n", fname );
-	  XLALDestroyStringVector ( fnames );
-	  XLALDestroySFTCatalog ( ret );
-	  fclose(fp);
-	  XLAL_ERROR_NULL ( XLAL_EIO );
-	}
-
-      /* go through SFT-blocks in fp */
-      while ( ftell(fp) < file_len )
-	{
-	  SFTtype this_header;
-	  UINT4 this_version;
-	  UINT4 this_nsamples;
-	  UINT8 this_crc;
-	  CHAR *this_comment = NULL;
-	  BOOLEAN endian;
-	  BOOLEAN want_this_block = FALSE;
-
-	  long this_filepos;
-	  if ( (this_filepos = ftell(fp)) == -1 )
-	    {
-              XLALPrintError ("ERROR: ftell() failed for '%s'\n\n", fname );
-	      XLALDestroyStringVector ( fnames );
-	      XLALDestroySFTCatalog ( ret );
-	      fclose (fp);
-	      XLAL_ERROR_NULL ( XLAL_EIO );
-	    }
-
-	  if ( read_sft_header_from_fp (fp, &this_header, &this_version, &this_crc, &endian, &this_comment, &this_nsamples ) != 0 )
-	    {
-              XLALPrintError ("ERROR: File-block '%s:%ld' is not a valid SFT!\n\n", fname, ftell(fp));
-	      XLALDestroyStringVector ( fnames );
-	      XLALFree ( this_comment );
-	      XLALDestroySFTCatalog ( ret );
-	      fclose(fp);
-	      XLAL_ERROR_NULL ( XLAL_EDATA );
-	    }
-
-	  /* if merged-SFT: check consistency constraints */
-	  if ( !mfirst_block )
-	    {
-	      if ( ! consistent_mSFT_header ( mprev_header, mprev_version, mprev_nsamples, this_header, this_version, this_nsamples ) )
-		{
-                  XLALPrintError ( "ERROR: merged SFT-file '%s' contains inconsistent SFT-blocks!\n\n", fname);
-		  XLALFree ( this_comment );
-		  XLALDestroyStringVector ( fnames );
-		  XLALDestroySFTCatalog ( ret );
-		  fclose(fp);
-		  XLAL_ERROR_NULL ( XLAL_EDATA );
-		}
-	    } /* if !mfirst_block */
-
-	  mprev_header = this_header;
-	  mprev_version = this_version;
-	  mprev_nsamples = this_nsamples;
-
-	  want_this_block = TRUE;	/* default */
-	  /* but does this SFT-block satisfy the user-constraints ? */
-	  if ( constraints )
-	    {
-	      if ( constraints->detector )
-		{
-                  if ( strncmp( constraints->detector, this_header.name, 2) ) {
-		    want_this_block = FALSE;
-                  }
-		}
-
-	      if ( XLALCWGPSinRange(this_header.epoch, constraints->minStartTime, constraints->maxStartTime) != 0 ) {
-		want_this_block = FALSE;
-              }
-
-	      if ( constraints->timestamps && !timestamp_in_list(this_header.epoch, constraints->timestamps) ) {
-		want_this_block = FALSE;
-              }
-
-	    } /* if constraints */
-
-	  if ( want_this_block )
-	    {
-	      numSFTs ++;
-
-	      /* do we need to alloc more memory for the SFTs? */
-	      if (  numSFTs > ret->length )
-		{
-		  /* we realloc SFT-memory blockwise in order to
-		   * improve speed in debug-mode (using LALMalloc/LALFree)
-		   */
-                  int len = (ret->length + SFTFILEIO_REALLOC_BLOCKSIZE) * sizeof( *(ret->data) );
-                  if ( (ret->data = LALRealloc ( ret->data, len )) == NULL )
-		    {
-                      XLALPrintError ("ERROR: SFT memory reallocation failed: nSFT:%d, len = %d\n", numSFTs, len );
-		      XLALDestroyStringVector ( fnames );
-		      XLALDestroySFTCatalog ( ret );
-		      XLALFree ( this_comment );
-		      fclose(fp);
-		      XLAL_ERROR_NULL ( XLAL_ENOMEM );
-		    }
-
-		  /* properly initialize data-fields pointers to NULL to avoid SegV when Freeing */
-		  for ( UINT4 j=0; j < SFTFILEIO_REALLOC_BLOCKSIZE; j ++ ) {
-		    memset ( &(ret->data[ret->length + j]), 0, sizeof( ret->data[0] ) );
-                  }
-
-		  ret->length += SFTFILEIO_REALLOC_BLOCKSIZE;
-		} // if numSFTs > ret->length
-
-	      SFTDescriptor *desc = &(ret->data[numSFTs - 1]);
-
-	      desc->locator = XLALCalloc ( 1, sizeof ( *(desc->locator) ) );
-	      if ( desc->locator ) {
-		desc->locator->fname = XLALCalloc( 1, strlen(fname) + 1 );
-              }
-	      if ( (desc->locator == NULL) || (desc->locator->fname == NULL ) )
-		{
-                  XLALPrintError ("ERROR: XLALCalloc() failed\n" );
-		  XLALDestroyStringVector ( fnames );
-		  XLALDestroySFTCatalog ( ret );
-		  fclose(fp);
-		  XLAL_ERROR_NULL ( XLAL_ENOMEM );
-		}
-	      strcpy ( desc->locator->fname, fname );
-	      desc->locator->offset = this_filepos;
-
-	      desc->header  = this_header;
-	      desc->comment = this_comment;
-	      desc->numBins = this_nsamples;
-	      desc->version = this_version;
-	      desc->crc64   = this_crc;
-
-	    } /* if want_this_block */
-	  else
-	    {
-	      XLALFree ( this_comment );
-	    }
-
-	  mfirst_block = FALSE;
-
-	  /* skip seeking if we know we would reach the end */
-	  if ( ftell ( fp ) + (long)this_nsamples * 8 >= file_len )
-	    break;
-
-	  /* seek to end of SFT data-entries in file  */
-	  if ( fseek ( fp, this_nsamples * 8 , SEEK_CUR ) == -1 )
-	    {
-              XLALPrintError ("ERROR: Failed to skip DATA field for SFT '%s': %s\n", fname, strerror(errno) );
-	      XLALFree ( this_comment );
-	      XLALDestroyStringVector ( fnames );
-	      XLALDestroySFTCatalog ( ret );
-	      fclose(fp);
-	      XLAL_ERROR_NULL ( XLAL_EIO );
-	    }
-
-	} /* while !feof */
-
-      fclose(fp);
-
+      int errnum = read_sft_file_descriptors ( ret, &numSFTs, fnames->data[i], constraints );
+      if ( errnum != 0 )
+        {
+          XLALDestroyStringVector ( fnames );
+          XLALDestroySFTCatalog ( ret );
+          XLAL_ERROR_NULL ( errnum );
+        }
     } /* for i < numFiles */
 
   /* free matched filenames */
@@ -548,6 +475,328 @@ XLALSFTdataFind ( const CHAR *file_pattern,		/**< which SFT-files */
 } /* XLALSFTdataFind() */
 
 
+/** First line of an SFT catalog index file, identifying its format version */
+#define SFT_INDEX_HEADER "%% SFT catalog index, version 1"
+
+/**
+ * Write an SFT catalog index to the file \a fname. The index records everything XLALSFTdataFind()
+ * would read from the headers of the SFTs in \a catalog, so that the same catalog can be reconstructed
+ * by XLALReadSFTCatalogIndex(), or by XLALSFTdataFind() with a file pattern <tt>index:\<fname\></tt>,
+ * from a single sequential read of the index instead of opening every SFT file.
+ *
+ * For every SFT file referenced by \a catalog, the index contains a line
+ * <tt>file \<size\> \<mtime\> \<numSFTs\> \<filename\></tt> giving its current size and modification time,
+ * followed by \c numSFTs lines
+ * <tt>sft \<offset\> \<version\> \<gpsSeconds\> \<gpsNanoSeconds\> \<f0\> \<deltaF\> \<numBins\> \<crc64\> \<detector\> \<comment\></tt>
+ * describing the SFTs of the catalog found in that file, in order of their position in the file.
+ * SFT file names are recorded relative to the directory of the index if the file lies inside that
+ * directory, and as absolute paths otherwise, so that the index does not depend on the working directory.
+ * Strings are written with whitespace, control characters and \c '\%' escaped as <tt>\%XX</tt>, and a
+ * missing or empty comment is written as <tt>-</tt>. Lines starting with \c '\%' are comments.
+ *
+ * \note The index should be written from a catalog returned by XLALSFTdataFind() without constraints,
+ * since SFTs excluded from \a catalog are not recorded in the index.
+ */
+int
+XLALWriteSFTCatalogIndex ( const SFTCatalog *catalog,	/**< [in] SFT catalog to write index for */
+                           const CHAR *fname		/**< [in] name of index file to write */
+                           )
+{
+  XLAL_CHECK ( catalog != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( fname != NULL, XLAL_EINVAL );
+
+  int errnum = 0;
+  LALFILE *fp = NULL;
+  CHAR *index_dir = NULL;
+  CHAR *index_sft_fname = NULL;
+
+  /* sort descriptors by file and position within file */
+  const SFTDescriptor **byLoc;
+  XLAL_CHECK ( (byLoc = XLALCalloc ( catalog->length + 1, sizeof(*byLoc) )) != NULL, XLAL_ENOMEM );
+  if ( get_index_directory ( &index_dir, fname ) != 0 )
+    {
+      errnum = XLAL_ENOMEM;
+      goto failed;
+    }
+  for ( UINT4 i = 0; i < catalog->length; i ++ )
+    byLoc[i] = &(catalog->data[i]);
+  qsort ( byLoc, catalog->length, sizeof(byLoc[0]), compareSFTdescLocator );
+
+  if ( (fp = XLALFileOpenWrite ( fname, 0 )) == NULL )
+    {
+      errnum = XLAL_EIO;
+      XLALPrintError ("ERROR: Failed to open SFT catalog index '%s' for writing\n", fname );
+      goto failed;
+    }
+  if ( XLALFilePrintf ( fp, "%s\n", SFT_INDEX_HEADER ) < 0
+       || XLALFilePrintf ( fp, "%%%% file <size> <mtime> <numSFTs> <filename>\n" ) < 0
+       || XLALFilePrintf ( fp, "%%%% sft <offset> <version> <gpsSeconds> <gpsNanoSeconds> <f0> <deltaF> <numBins> <crc64> <detector> <comment>\n" ) < 0 )
+    goto write_failed;
+
+  for ( UINT4 i = 0, numSFTs; i < catalog->length; i += numSFTs )
+    {
+      const CHAR *sft_fname = byLoc[i]->locator->fname;
+      for ( numSFTs = 1; i + numSFTs < catalog->length && strcmp ( byLoc[i + numSFTs]->locator->fname, sft_fname ) == 0; numSFTs ++ )
+        ;
+
+      UINT8 size;
+      INT8 mtime;
+      if ( get_index_file_status ( sft_fname, &size, &mtime ) != 0 )
+        {
+          errnum = XLAL_EIO;
+          XLALPrintError ("ERROR: Failed to get status of SFT file '%s'\n", sft_fname );
+          goto failed;
+        }
+      XLALFree ( index_sft_fname );
+      if ( (index_sft_fname = get_index_sft_fname ( sft_fname, index_dir )) == NULL )
+        {
+          errnum = XLAL_EIO;
+          XLALPrintError ("ERROR: Failed to resolve path of SFT file '%s'\n", sft_fname );
+          goto failed;
+        }
+      if ( XLALFilePrintf ( fp, "file %" LAL_UINT8_FORMAT " %" LAL_INT8_FORMAT " %u ", size, mtime, numSFTs ) < 0
+           || write_index_string ( fp, index_sft_fname ) != 0
+           || XLALFilePrintf ( fp, "\n" ) < 0 )
+        goto write_failed;
+
+      for ( UINT4 j = i; j < i + numSFTs; j ++ )
+        {
+          const SFTDescriptor *desc = byLoc[j];
+          if ( XLALFilePrintf ( fp, "sft %ld %u %d %d %.17g %.17g %u %" LAL_UINT8_FORMAT " ",
+                                desc->locator->offset, desc->version, desc->header.epoch.gpsSeconds, desc->header.epoch.gpsNanoSeconds,
+                                desc->header.f0, desc->header.deltaF, desc->numBins, desc->crc64 ) < 0
+               || write_index_string ( fp, desc->header.name ) != 0
+               || XLALFilePrintf ( fp, " " ) < 0
+               || write_index_string ( fp, desc->comment ) != 0
+               || XLALFilePrintf ( fp, "\n" ) < 0 )
+            goto write_failed;
+        }
+
+    } /* for i < catalog->length */
+
+  XLALFree ( byLoc );
+  XLALFree ( index_dir );
+  XLALFree ( index_sft_fname );
+  XLAL_CHECK ( XLALFileClose ( fp ) == 0, XLAL_EIO, "Failed to close SFT catalog index '%s'\n", fname );
+
+  return XLAL_SUCCESS;
+
+ write_failed:
+  errnum = XLAL_EIO;
+  XLALPrintError ("ERROR: Failed to write SFT catalog index '%s'\n", fname );
+ failed:
+  XLALFree ( byLoc );
+  XLALFree ( index_dir );
+  XLALFree ( index_sft_fname );
+  if ( fp )
+    XLALFileClose ( fp );
+  XLAL_ERROR ( errnum );
+
+} /* XLALWriteSFTCatalogIndex() */
+
+
+/**
+ * Read an SFT catalog index written by XLALWriteSFTCatalogIndex(), and return the SFTCatalog it describes.
+ *
+ * The index is validated incrementally: for every SFT file listed in the index, only the file size and
+ * modification time are checked against those recorded in the index. SFT files which have been modified
+ * since the index was written are opened and their SFT headers read again, while for all other files the
+ * SFT headers are taken from the index without opening the file. It is an error if a listed SFT file
+ * no longer exists. Relative SFT file names are interpreted relative to the directory of the index.
+ *
+ * The returned SFTs in the catalogue are sorted by increasing GPS-epochs, as for XLALSFTdataFind().
+ */
+SFTCatalog *
+XLALReadSFTCatalogIndex ( const CHAR *fname	/**< [in] name of index file to read */
+                          )
+{
+  XLAL_CHECK_NULL ( fname != NULL, XLAL_EINVAL );
+
+  int errnum = 0;
+  CHAR *content = NULL;
+  CHAR *sft_fname = NULL;
+  SFTCatalog *ret = NULL;
+  UINT4 numSFTs = 0;
+  UINT4 numFiles = 0, numModified = 0;
+  CHAR *index_dir = NULL;
+
+  XLAL_CHECK_NULL ( (content = XLALFileLoad ( fname )) != NULL, XLAL_EFUNC, "Failed to load SFT catalog index '%s'\n", fname );
+  if ( (ret = XLALCalloc ( 1, sizeof(*ret) )) == NULL || get_index_directory ( &index_dir, fname ) != 0 )
+    {
+      XLALFree ( ret );
+      XLALFree ( content );
+      XLAL_ERROR_NULL ( XLAL_ENOMEM );
+    }
+
+  CHAR *rest = content;
+  CHAR *line = XLALStringToken ( &rest, "\n", 0 );
+  if ( line == NULL || strcmp ( line, SFT_INDEX_HEADER ) != 0 )
+    {
+      errnum = XLAL_EDATA;
+      XLALPrintError ("ERROR: '%s' is not an SFT catalog index\n", fname );
+      goto failed;
+    }
+
+  BOOLEAN modified = FALSE;
+  UINT4 numSFTsLeft = 0;
+  while ( (line = XLALStringToken ( &rest, "\n", 0 )) != NULL )
+    {
+      if ( line[0] == '%' )
+        continue;
+
+      /* split line into whitespace-separated tokens */
+      CHAR *tokens[11];
+      UINT4 numTokens = 0;
+      CHAR *token;
+      while ( numTokens < XLAL_NUM_ELEM(tokens) && (token = XLALStringToken ( &line, " \t", 0 )) != NULL )
+        tokens[numTokens ++] = token;
+      if ( numTokens == 0 )
+        continue;
+      if ( XLALStringToken ( &line, " \t", 0 ) != NULL )
+        {
+          errnum = XLAL_EDATA;
+          goto invalid_line;
+        }
+
+      if ( numTokens == 5 && strcmp ( tokens[0], "file" ) == 0 && numSFTsLeft == 0 )
+        {
+          UINT8 size, size_now;
+          INT8 mtime, mtime_now;
+          CHAR *index_sft_fname = NULL;
+          XLALFree ( sft_fname );
+          sft_fname = NULL;
+          if ( XLALParseStringValueAsUINT8 ( &size, tokens[1] ) != XLAL_SUCCESS
+               || XLALParseStringValueAsINT8 ( &mtime, tokens[2] ) != XLAL_SUCCESS
+               || XLALParseStringValueAsUINT4 ( &numSFTsLeft, tokens[3] ) != XLAL_SUCCESS
+               || read_index_string ( &index_sft_fname, tokens[4] ) != 0 || index_sft_fname == NULL )
+            {
+              XLALFree ( index_sft_fname );
+              errnum = XLAL_EDATA;
+              goto invalid_line;
+            }
+
+          /* SFT file names which are not absolute are relative to the directory of the index */
+          if ( index_sft_fname[0] == '/' || index_dir == NULL )
+            sft_fname = index_sft_fname;
+          else
+            {
+              sft_fname = XLALStringAppend ( XLALStringDuplicate ( index_dir ), index_sft_fname );
+              XLALFree ( index_sft_fname );
+              if ( sft_fname == NULL )
+                {
+                  errnum = XLAL_ENOMEM;
+                  goto failed;
+                }
+            }
+          numFiles ++;
+
+          if ( get_index_file_status ( sft_fname, &size_now, &mtime_now ) != 0 )
+            {
+              errnum = XLAL_EIO;
+              XLALPrintError ("ERROR: SFT file '%s' listed in SFT catalog index '%s' is missing\n", sft_fname, fname );
+              goto failed;
+            }
+
+          /* read the headers of modified SFT files again, skipping their entries in the index */
+          modified = ( size_now != size || mtime_now != mtime );
+          if ( modified )
+            {
+              numModified ++;
+              XLALPrintInfo ( "%s: SFT file '%s' was modified since SFT catalog index '%s' was written\n", __func__, sft_fname, fname );
+              if ( (errnum = read_sft_file_descriptors ( ret, &numSFTs, sft_fname, NULL )) != 0 )
+                goto failed;
+            }
+        }
+
+      else if ( numTokens == 11 && strcmp ( tokens[0], "sft" ) == 0 && numSFTsLeft > 0 )
+        {
+          numSFTsLeft --;
+          if ( modified )
+            continue;
+
+          SFTDescriptor XLAL_INIT_DECL(desc);
+          INT8 offset;
+          CHAR *name = NULL;
+          if ( XLALParseStringValueAsINT8 ( &offset, tokens[1] ) != XLAL_SUCCESS
+               || XLALParseStringValueAsUINT4 ( &desc.version, tokens[2] ) != XLAL_SUCCESS
+               || XLALParseStringValueAsINT4 ( &desc.header.epoch.gpsSeconds, tokens[3] ) != XLAL_SUCCESS
+               || XLALParseStringValueAsINT4 ( &desc.header.epoch.gpsNanoSeconds, tokens[4] ) != XLAL_SUCCESS
+               || XLALParseStringValueAsREAL8 ( &desc.header.f0, tokens[5] ) != XLAL_SUCCESS
+               || XLALParseStringValueAsREAL8 ( &desc.header.deltaF, tokens[6] ) != XLAL_SUCCESS
+               || XLALParseStringValueAsUINT4 ( &desc.numBins, tokens[7] ) != XLAL_SUCCESS
+               || XLALParseStringValueAsUINT8 ( &desc.crc64, tokens[8] ) != XLAL_SUCCESS
+               || read_index_string ( &name, tokens[9] ) != 0 || name == NULL || strlen ( name ) >= sizeof ( desc.header.name )
+               || read_index_string ( &desc.comment, tokens[10] ) != 0 )
+            {
+              XLALFree ( name );
+              XLALFree ( desc.comment );
+              errnum = XLAL_EDATA;
+              goto invalid_line;
+            }
+          strcpy ( desc.header.name, name );
+          XLALFree ( name );
+
+          if ( (desc.locator = XLALCalloc ( 1, sizeof(*desc.locator) )) != NULL )
+            {
+              desc.locator->fname = XLALStringDuplicate ( sft_fname );
+              desc.locator->offset = offset;
+            }
+          if ( desc.locator == NULL || desc.locator->fname == NULL || append_catalog_descriptor ( ret, &numSFTs, &desc ) != 0 )
+            {
+              if ( desc.locator )
+                XLALFree ( desc.locator->fname );
+              XLALFree ( desc.locator );
+              XLALFree ( desc.comment );
+              errnum = XLAL_ENOMEM;
+              goto failed;
+            }
+        }
+
+      else
+        {
+          errnum = XLAL_EDATA;
+          goto invalid_line;
+        }
+
+    } /* while line */
+
+  if ( numSFTsLeft > 0 )
+    {
+      errnum = XLAL_EDATA;
+      XLALPrintError ("ERROR: SFT catalog index '%s' is truncated\n", fname );
+      goto failed;
+    }
+
+  XLALPrintInfo ( "%s: read %u SFTs in %u files from SFT catalog index '%s'; %u files were modified and read again\n",
+                  __func__, numSFTs, numFiles, fname, numModified );
+
+  XLALFree ( sft_fname );
+  XLALFree ( index_dir );
+  XLALFree ( content );
+
+  /* now realloc SFT-vector to its actual size, and sort in order of increasing GPS-time */
+  ret->length = numSFTs;
+  if ( numSFTs > 0 )
+    {
+      XLAL_CHECK_NULL ( (ret->data = XLALRealloc ( ret->data, numSFTs * sizeof( *(ret->data) ) )) != NULL, XLAL_ENOMEM );
+      qsort( (void*)ret->data, ret->length, sizeof( ret->data[0] ), compareSFTdesc );
+    }
+
+  return ret;
+
+ invalid_line:
+  XLALPrintError ("ERROR: Invalid entry in SFT catalog index '%s'\n", fname );
+ failed:
+  ret->length = numSFTs;
+  XLALDestroySFTCatalog ( ret );
+  XLALFree ( sft_fname );
+  XLALFree ( index_dir );
+  XLALFree ( content );
+  XLAL_ERROR_NULL ( errnum );
+
+} /* XLALReadSFTCatalogIndex() */
+
+
 /*
    This function reads an SFT (segment) from an open file pointer into a buffer.
    firstBin2read specifies the first bin to read from the SFT, lastBin2read is the last bin.
@@ -1096,6 +1345,158 @@ XLALLoadMultiSFTsFromView ( const MultiSFTCatalogView *multiCatalogView,/**< The
 } // XLALLoadMultiSFTsFromView()
 
 
+/**
+ * Load the given frequency-band <tt>[fMin, fMax]</tt> (inclusively) from the SFT-files listed in the
+ * SFT-'catalogue' ( returned by XLALSFTdataFind() ), using memory-mapped file access.
+ *
+ * This returns the same ::SFTVector as XLALLoadSFTs(), but each SFT-file is memory-mapped exactly
+ * once (irrespective of how many SFTs it contains), only the pages containing the requested band
+ * are touched, and the band extraction is distributed over SFTs using OpenMP threads (if enabled).
+ * Files are mapped in batches of at most 1024, and each file is unmapped as soon as its SFTs have
+ * been copied, so that any number of SFT-files can be loaded.
+ * This is much faster than XLALLoadSFTs() for catalogs of many SFT-files, or merged SFT-files
+ * containing many SFTs.
+ *
+ * Falls back to XLALLoadSFTs() if memory-mapping is not supported on this platform, or if
+ * the catalog already contains SFT data.
+ */
+SFTVector*
+XLALLoadSFTsMapped ( const SFTCatalog *catalog,   /**< The 'catalogue' of SFTs to load */
+                     REAL8 fMin,                  /**< minumum requested frequency (-1 = read from lowest) */
+                     REAL8 fMax                   /**< maximum requested frequency (-1 = read up to highest) */
+                     )
+{
+  XLAL_CHECK_NULL ( (catalog != NULL) && (catalog->length != 0), XLAL_EINVAL );
+
+  if ( !can_map_catalog ( catalog ) )
+    {
+      SFTVector *sfts;
+      XLAL_CHECK_NULL ( ( sfts = XLALLoadSFTs ( catalog, fMin, fMax ) ) != NULL, XLAL_EFUNC );
+      return sfts;
+    }
+
+  SFTVector *sfts = NULL;
+  struct tagSFTFileMappings *mappings = NULL;
+  XLAL_CHECK_NULL ( load_sfts_mapped ( &sfts, &mappings, catalog, fMin, fMax, FALSE ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  /* data has been copied, so mappings are no longer needed */
+  destroy_sft_file_mappings ( mappings );
+
+  return sfts;
+
+} /* XLALLoadSFTsMapped() */
+
+
+/**
+ * Function to load a catalog of SFTs from possibly different detectors using memory-mapped file access.
+ * This is the equivalent of XLALLoadMultiSFTs() using XLALLoadSFTsMapped().
+ */
+MultiSFTVector *
+XLALLoadMultiSFTsMapped ( const SFTCatalog *inputCatalog,   /**< The 'catalogue' of SFTs to load */
+                          REAL8 fMin,                       /**< minumum requested frequency (-1 = read from lowest) */
+                          REAL8 fMax                        /**< maximum requested frequency (-1 = read up to highest) */
+                          )
+{
+  XLAL_CHECK_NULL ( (inputCatalog != NULL) && (inputCatalog->length != 0), XLAL_EINVAL );
+
+  MultiSFTCatalogView *multiCatalogView;
+  // get the (alphabetically-sorted!) multiSFTCatalogView
+  XLAL_CHECK_NULL ( (multiCatalogView = XLALGetMultiSFTCatalogView ( inputCatalog )) != NULL, XLAL_EFUNC );
+
+  UINT4 numIFOs = multiCatalogView->length;
+
+  /* create multi sft vector */
+  MultiSFTVector *multiSFTs;
+  XLAL_CHECK_NULL ( (multiSFTs = XLALCalloc(1, sizeof(*multiSFTs))) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK_NULL ( (multiSFTs->data = XLALCalloc ( numIFOs, sizeof(*multiSFTs->data))) != NULL, XLAL_ENOMEM );
+  multiSFTs->length = numIFOs;
+
+  for ( UINT4 X = 0; X < numIFOs; X++ )
+    {
+      if ( ( multiSFTs->data[X] = XLALLoadSFTsMapped ( &(multiCatalogView->data[X]), fMin, fMax ) ) == NULL )
+        {
+          XLALDestroyMultiSFTVector ( multiSFTs );
+          XLALDestroyMultiSFTCatalogView ( multiCatalogView );
+          XLAL_ERROR_NULL ( XLAL_EFUNC, "Failed to XLALLoadSFTsMapped() for IFO X = %d\n", X );
+        }
+    } // for X < numIFOs
+
+  XLALDestroyMultiSFTCatalogView ( multiCatalogView );
+
+  return multiSFTs;
+
+} /* XLALLoadMultiSFTsMapped() */
+
+
+/**
+ * Map the given frequency-band <tt>[fMin, fMax]</tt> (inclusively) of the SFTs listed in the
+ * SFT-'catalogue' into memory, without copying the SFT data where possible.
+ *
+ * The returned ::MappedSFTVector contains an ::SFTVector equivalent to that returned by XLALLoadSFTs(),
+ * except that the data of each SFT points directly into the memory-mapped SFT-file, provided that
+ * the requested band is contained in a single SFT (segment) stored in native byte-order; otherwise
+ * the data of that SFT is copied. The SFT-files remain mapped until the ::MappedSFTVector is destroyed
+ * with XLALDestroyMappedSFTVector(). Files are mapped privately: modifying the SFT data is allowed, but
+ * only modified pages are copied, and the SFT-files are never changed.
+ *
+ * To stay well within the number of mappings allowed per process (e.g. \c vm.max_map_count on Linux),
+ * at most 16384 SFT-files stay mapped: SFTs in any further files are copied, as by XLALLoadSFTsMapped().
+ *
+ * This avoids both the I/O and the memory cost of copying the SFT data, e.g. when many processes on the
+ * same node read the same SFTs, they share the same physical pages of the page cache.
+ *
+ * \note The SFT-files must not be modified or truncated while they are mapped.
+ */
+MappedSFTVector *
+XLALMapSFTs ( const SFTCatalog *catalog,   /**< The 'catalogue' of SFTs to map */
+              REAL8 fMin,                  /**< minumum requested frequency (-1 = read from lowest) */
+              REAL8 fMax                   /**< maximum requested frequency (-1 = read up to highest) */
+              )
+{
+  XLAL_CHECK_NULL ( (catalog != NULL) && (catalog->length != 0), XLAL_EINVAL );
+  XLAL_CHECK_NULL ( can_map_catalog ( catalog ), XLAL_EINVAL, "SFT catalog cannot be memory-mapped on this platform, or already contains SFT data\n" );
+
+  MappedSFTVector *ret;
+  XLAL_CHECK_NULL ( (ret = XLALCalloc ( 1, sizeof(*ret) )) != NULL, XLAL_ENOMEM );
+
+  if ( load_sfts_mapped ( &ret->sfts, &ret->mappings, catalog, fMin, fMax, TRUE ) != XLAL_SUCCESS )
+    {
+      XLALFree ( ret );
+      XLAL_ERROR_NULL ( XLAL_EFUNC );
+    }
+
+  return ret;
+
+} /* XLALMapSFTs() */
+
+
+/**
+ * Destroy a ::MappedSFTVector returned by XLALMapSFTs(), and unmap its SFT-files.
+ */
+void
+XLALDestroyMappedSFTVector ( MappedSFTVector *mapped )
+{
+  if ( mapped == NULL )
+    return;
+
+  if ( mapped->sfts != NULL && mapped->mappings != NULL )
+    {
+      /* detach data which points into mapped files, so that it is not freed */
+      for ( UINT4 i = 0; i < mapped->sfts->length && i < mapped->mappings->numSFTs; i++ )
+        {
+          if ( mapped->mappings->isView[i] && mapped->sfts->data[i].data != NULL )
+            mapped->sfts->data[i].data->data = NULL;
+        }
+    }
+  XLALDestroySFTVector ( mapped->sfts );
+  destroy_sft_file_mappings ( mapped->mappings );
+  XLALFree ( mapped );
+
+  return;
+
+} /* XLALDestroyMappedSFTVector() */
+
+
 /// backwards compatible wrapper to XLALReadTimestampsFileConstrained() without GPS-time constraints
 LIGOTimeGPSVector *
 XLALReadTimestampsFile ( const CHAR *fname )
@@ -1182,8 +1583,9 @@ XLALReadTimestampsFileConstrained ( const CHAR *fname, const LIGOTimeGPS *minGPS
  * XLAL_SUCCESS if the operation suceeds (even if the checksums fail to validate),
  * and XLAL_FAILURE otherwise.
  *
- * \note: because this function has to read the complete SFT data into memory it is
- * potentially slow and memory-intensive.
+ * \note: because this function has to read the complete SFT data it is potentially slow;
+ * if lalpulsar was built with OpenMP, the SFTs are checked in parallel. Failures are
+ * reported for the first failing SFT in catalog order, as for a sequential check.
  */
 int
 XLALCheckCRCSFTCatalog(
@@ -1198,42 +1600,88 @@ XLALCheckCRCSFTCatalog(
   /* CRC checks are assumed to pass until one fails */
   *crc_check = 1;
 
-  /* step through SFTs and check CRC64 */
-  for ( UINT4 i=0; i < catalog->length; i ++ )
+  /* status of each SFT: 0 = valid (or not checked), 1 = open failure,
+     2 = illegal version, 3 = checksum failure */
+  int *status = XLALCalloc ( catalog->length > 0 ? catalog->length : 1, sizeof(*status) );
+  XLAL_CHECK ( status != NULL, XLAL_ENOMEM );
+
+  /* index of the first SFT known to have failed; SFTs after it need not be checked */
+  INT8 firstFailure = catalog->length;
+
+  /* step through SFTs and check CRC64; SFT files are checked in parallel,
+     but results are reported as if they were checked in catalog order */
+#pragma omp parallel for schedule(dynamic)
+  for ( INT8 i = 0; i < (INT8)catalog->length; i ++ )
     {
-      FILE *fp;
+      INT8 first;
+#pragma omp critical (XLALCheckCRCSFTCatalog)
+      first = firstFailure;
+      if ( i > first ) {
+        continue;
+      }
 
       switch ( catalog->data[i].version  )
 	{
 	case 1:	/* version 1 had no CRC  */
-	  continue;
+	  break;
 	case 2:
-	  if ( (fp = fopen_SFTLocator ( catalog->data[i].locator )) == NULL )
-	    {
-	      XLALPrintError ( "Failed to open locator '%s'\n",
-			      XLALshowSFTLocator ( catalog->data[i].locator ) );
-              return XLAL_FAILURE;
-	    }
-	  if ( !(has_valid_v2_crc64 ( fp ) != 0) )
-	    {
-	      XLALPrintError ( "CRC64 checksum failure for SFT '%s'\n",
-			      XLALshowSFTLocator ( catalog->data[i].locator ) );
-              *crc_check = 0;
-	      fclose(fp);
-              return XLAL_SUCCESS;
-	    }
-	  fclose(fp);
+          {
+            FILE *fp;
+            if ( (fp = fopen_SFTLocator ( catalog->data[i].locator )) == NULL )
+              {
+                status[i] = 1;
+              }
+            else
+              {
+                if ( !(has_valid_v2_crc64 ( fp ) != 0) )
+                  {
+                    status[i] = 3;
+                  }
+                fclose(fp);
+              }
+          }
 	  break;
 
 	default:
-	  XLALPrintError ( "Illegal SFT-version encountered : %d\n", catalog->data[i].version );
-          return XLAL_FAILURE;
+          status[i] = 2;
 	  break;
 	} /* switch (version ) */
 
+      if ( status[i] != 0 )
+        {
+#pragma omp critical (XLALCheckCRCSFTCatalog)
+          if ( i < firstFailure ) {
+            firstFailure = i;
+          }
+        }
+
     } /* for i < numSFTs */
 
-  return XLAL_SUCCESS;
+  /* report the first failure in catalog order */
+  int retn = XLAL_SUCCESS;
+  if ( firstFailure < (INT8)catalog->length )
+    {
+      const SFTDescriptor *desc = &catalog->data[firstFailure];
+      switch ( status[firstFailure] )
+        {
+        case 1:
+          XLALPrintError ( "Failed to open locator '%s'\n", XLALshowSFTLocator ( desc->locator ) );
+          retn = XLAL_FAILURE;
+          break;
+        case 2:
+          XLALPrintError ( "Illegal SFT-version encountered : %d\n", desc->version );
+          retn = XLAL_FAILURE;
+          break;
+        default:
+          XLALPrintError ( "CRC64 checksum failure for SFT '%s'\n", XLALshowSFTLocator ( desc->locator ) );
+          *crc_check = 0;
+          break;
+        }
+    }
+
+  XLALFree ( status );
+
+  return retn;
 
 } /* XLALCheckCRCSFTCatalog() */
 
@@ -2352,30 +2800,330 @@ fopen_SFTLocator ( const struct tagSFTLocator *locator )
 } /* fopen_SFTLocator() */
 
 
-/***********************************************************************
- * internal helper functions
- ***********************************************************************/
+/***********************************************************************
+ * internal helper functions
+ ***********************************************************************/
+
+
+static BOOLEAN
+timestamp_in_list( LIGOTimeGPS timestamp, LIGOTimeGPSVector *list )
+{
+  UINT4 i;
+  LIGOTimeGPS *el;
+
+  if ( !list )
+    return FALSE;
+
+  el = &(list->data[0]);
+  for ( i=0; i < list->length; i++, el++)
+    {
+      if ( (timestamp.gpsSeconds == el->gpsSeconds) && ( timestamp.gpsNanoSeconds == el->gpsNanoSeconds ) )
+	return TRUE;
+    } /* for i < length */
+
+  return FALSE;
+
+} /* timestamp_in_list() */
+
+
+/* check whether an SFT-block with the given header satisfies the user-constraints (if any) */
+static BOOLEAN
+sft_satisfies_constraints ( const SFTtype *header, const SFTConstraints *constraints )
+{
+  if ( !constraints )
+    return TRUE;
+
+  if ( constraints->detector && strncmp( constraints->detector, header->name, 2) )
+    return FALSE;
+
+  if ( XLALCWGPSinRange(header->epoch, constraints->minStartTime, constraints->maxStartTime) != 0 )
+    return FALSE;
+
+  if ( constraints->timestamps && !timestamp_in_list(header->epoch, constraints->timestamps) )
+    return FALSE;
+
+  return TRUE;
+
+} /* sft_satisfies_constraints() */
+
+
+/* write a string to an SFT catalog index as a single token, escaping whitespace, control
+ * characters and '%' as '%XX'; a NULL or empty string is written as '-' */
+static int
+write_index_string ( LALFILE *fp, const CHAR *str )
+{
+  if ( str == NULL || str[0] == '\0' )
+    return ( XLALFilePuts ( "-", fp ) < 0 ) ? -1 : 0;
+
+  for ( const unsigned char *c = (const unsigned char *) str; *c != '\0'; c ++ )
+    {
+      int retn;
+      if ( *c <= ' ' || *c >= 127 || *c == '%' || ( *c == '-' && c == (const unsigned char *) str ) )
+        retn = XLALFilePrintf ( fp, "%%%02X", *c );
+      else
+        retn = XLALFilePutc ( *c, fp );
+      if ( retn < 0 )
+        return -1;
+    }
+
+  return 0;
+
+} /* write_index_string() */
+
+
+/* read a string written by write_index_string() from an SFT catalog index token */
+static int
+read_index_string ( CHAR **str, const CHAR *token )
+{
+  (*str) = NULL;
+  if ( strcmp ( token, "-" ) == 0 )
+    return 0;
+
+  CHAR *ret;
+  if ( (ret = XLALCalloc ( 1, strlen ( token ) + 1 )) == NULL )
+    return -1;
+
+  CHAR *d = ret;
+  for ( const CHAR *c = token; *c != '\0'; c ++ )
+    {
+      if ( *c == '%' )
+        {
+          unsigned int x;
+          if ( !isxdigit ( (unsigned char) c[1] ) || !isxdigit ( (unsigned char) c[2] ) || sscanf ( c + 1, "%2x", &x ) != 1 || x == 0 )
+            {
+              XLALFree ( ret );
+              return -1;
+            }
+          *d++ = (CHAR) x;
+          c += 2;
+        }
+      else
+        *d++ = *c;
+    }
+
+  (*str) = ret;
+  return 0;
+
+} /* read_index_string() */
+
+
+/* get the size and modification time of a file, as recorded in an SFT catalog index */
+static int
+get_index_file_status ( const CHAR *fname, UINT8 *size, INT8 *mtime )
+{
+  struct stat st;
+  if ( stat ( fname, &st ) != 0 )
+    return -1;
+  (*size) = st.st_size;
+  (*mtime) = st.st_mtime;
+  return 0;
+} /* get_index_file_status() */
+
+
+/* get the directory of an SFT catalog index, including the trailing '/', or NULL if it is in the current directory */
+static int
+get_index_directory ( CHAR **dir, const CHAR *index_fname )
+{
+  (*dir) = NULL;
+  const CHAR *slash = strrchr ( index_fname, '/' );
+  if ( slash == NULL )
+    return 0;
+  if ( ( (*dir) = XLALStringDuplicate ( index_fname ) ) == NULL )
+    return -1;
+  (*dir)[slash - index_fname + 1] = '\0';
+  return 0;
+} /* get_index_directory() */
+
+
+/*
+ * get the name of an SFT file to record in an SFT catalog index in directory 'index_dir'
+ * (NULL for the current directory): relative to 'index_dir' if the file is inside it,
+ * otherwise absolute. Without realpath(), names are resolved only by comparing their
+ * leading directories with 'index_dir', and relative names outside it are an error.
+ */
+static CHAR *
+get_index_sft_fname ( const CHAR *sft_fname, const CHAR *index_dir )
+{
+  CHAR *ret = NULL;
+
+#ifdef HAVE_REALPATH
+  char *real_sft_fname = realpath ( sft_fname, NULL );
+  char *real_index_dir = realpath ( ( index_dir != NULL ) ? index_dir : ".", NULL );
+  if ( real_sft_fname != NULL && real_index_dir != NULL )
+    {
+      size_t len = strlen ( real_index_dir );
+      if ( len > 0 && real_index_dir[len - 1] == '/' )
+        len --;		/* index in root directory */
+      if ( strncmp ( real_sft_fname, real_index_dir, len ) == 0 && real_sft_fname[len] == '/' )
+        ret = XLALStringDuplicate ( real_sft_fname + len + 1 );
+      else
+        ret = XLALStringDuplicate ( real_sft_fname );
+    }
+  free ( real_sft_fname );
+  free ( real_index_dir );
+#else
+  const size_t len = ( index_dir != NULL ) ? strlen ( index_dir ) : 0;
+  if ( len > 0 && strncmp ( sft_fname, index_dir, len ) == 0 )
+    ret = XLALStringDuplicate ( sft_fname + len );
+  else if ( sft_fname[0] == '/' || index_dir == NULL )
+    ret = XLALStringDuplicate ( sft_fname );
+#endif
+
+  return ret;
+
+} /* get_index_sft_fname() */
+
+
+/* append an SFT-descriptor to a catalog, whose 'length' is the number of descriptors allocated */
+static int
+append_catalog_descriptor ( SFTCatalog *catalog, UINT4 *numSFTs, const SFTDescriptor *desc )
+{
+  if ( (*numSFTs) >= catalog->length )
+    {
+      SFTDescriptor *data;
+      if ( (data = XLALRealloc ( catalog->data, (catalog->length + SFTFILEIO_REALLOC_BLOCKSIZE) * sizeof(*data) )) == NULL )
+        return -1;
+      memset ( &(data[catalog->length]), 0, SFTFILEIO_REALLOC_BLOCKSIZE * sizeof(*data) );
+      catalog->data = data;
+      catalog->length += SFTFILEIO_REALLOC_BLOCKSIZE;
+    }
+  catalog->data[(*numSFTs) ++] = (*desc);
+  return 0;
+} /* append_catalog_descriptor() */
+
+
+/*
+ * Read the headers of all SFT-blocks in the file 'fname' (which is opened directly, not matched
+ * as a file pattern), and append descriptors of those satisfying 'constraints' (may be NULL) to
+ * 'catalog', whose 'length' is the number of descriptors allocated. Returns 0 on success, or an
+ * XLAL error code.
+ */
+static int
+read_sft_file_descriptors ( SFTCatalog *catalog, UINT4 *numSFTs, const CHAR *fname, const SFTConstraints *constraints )
+{
+  /* merged SFTs need to satisfy stronger consistency-constraints (-> see spec) */
+  BOOLEAN mfirst_block = TRUE;
+  UINT4   mprev_version = 0;
+  SFTtype XLAL_INIT_DECL( mprev_header );
+  REAL8   mprev_nsamples = 0;
+
+  FILE *fp;
+  if ( ( fp = fopen( fname, "rb" ) ) == NULL )
+    {
+      XLALPrintError ("ERROR: Failed to open matched file '%s'\n\n", fname );
+      return XLAL_EIO;
+    }
+
+  long file_len;
+  if ( (file_len = get_file_len(fp)) == 0 )
+    {
+      XLALPrintError ("ERROR: got file-len == 0 for '%s'\n\n", fname );
+      fclose(fp);
+      return XLAL_EIO;
+    }
+
+  /* go through SFT-blocks in fp */
+  while ( ftell(fp) < file_len )
+    {
+      SFTtype this_header;
+      UINT4 this_version;
+      UINT4 this_nsamples;
+      UINT8 this_crc;
+      CHAR *this_comment = NULL;
+      BOOLEAN endian;
+
+      long this_filepos;
+      if ( (this_filepos = ftell(fp)) == -1 )
+        {
+          XLALPrintError ("ERROR: ftell() failed for '%s'\n\n", fname );
+          fclose (fp);
+          return XLAL_EIO;
+        }
+
+      if ( read_sft_header_from_fp (fp, &this_header, &this_version, &this_crc, &endian, &this_comment, &this_nsamples ) != 0 )
+        {
+          XLALPrintError ("ERROR: File-block '%s:%ld' is not a valid SFT!\n\n", fname, ftell(fp));
+          XLALFree ( this_comment );
+          fclose(fp);
+          return XLAL_EDATA;
+        }
+
+      /* if merged-SFT: check consistency constraints */
+      if ( !mfirst_block )
+        {
+          if ( ! consistent_mSFT_header ( mprev_header, mprev_version, mprev_nsamples, this_header, this_version, this_nsamples ) )
+            {
+              XLALPrintError ( "ERROR: merged SFT-file '%s' contains inconsistent SFT-blocks!\n\n", fname);
+              XLALFree ( this_comment );
+              fclose(fp);
+              return XLAL_EDATA;
+            }
+        } /* if !mfirst_block */
+
+      mprev_header = this_header;
+      mprev_version = this_version;
+      mprev_nsamples = this_nsamples;
+
+      /* does this SFT-block satisfy the user-constraints ? */
+      if ( sft_satisfies_constraints ( &this_header, constraints ) )
+        {
+          SFTDescriptor XLAL_INIT_DECL(desc);
+          if ( (desc.locator = XLALCalloc ( 1, sizeof ( *(desc.locator) ) )) != NULL ) {
+            desc.locator->fname = XLALStringDuplicate ( fname );
+          }
+          if ( (desc.locator == NULL) || (desc.locator->fname == NULL) )
+            {
+              XLALPrintError ("ERROR: XLALCalloc() failed\n" );
+              XLALFree ( desc.locator );
+              XLALFree ( this_comment );
+              fclose(fp);
+              return XLAL_ENOMEM;
+            }
+          desc.locator->offset = this_filepos;
+
+          desc.header  = this_header;
+          desc.comment = this_comment;
+          desc.numBins = this_nsamples;
+          desc.version = this_version;
+          desc.crc64   = this_crc;
+
+          if ( append_catalog_descriptor ( catalog, numSFTs, &desc ) != 0 )
+            {
+              XLALPrintError ("ERROR: SFT memory reallocation failed: nSFT:%d\n", (*numSFTs) + 1 );
+              XLALFree ( desc.locator->fname );
+              XLALFree ( desc.locator );
+              XLALFree ( this_comment );
+              fclose(fp);
+              return XLAL_ENOMEM;
+            }
+
+        } /* if want this block */
+      else
+        {
+          XLALFree ( this_comment );
+        }
+
+      mfirst_block = FALSE;
 
+      /* skip seeking if we know we would reach the end */
+      if ( ftell ( fp ) + (long)this_nsamples * 8 >= file_len )
+        break;
 
-static BOOLEAN
-timestamp_in_list( LIGOTimeGPS timestamp, LIGOTimeGPSVector *list )
-{
-  UINT4 i;
-  LIGOTimeGPS *el;
+      /* seek to end of SFT data-entries in file  */
+      if ( fseek ( fp, this_nsamples * 8 , SEEK_CUR ) == -1 )
+        {
+          XLALPrintError ("ERROR: Failed to skip DATA field for SFT '%s': %s\n", fname, strerror(errno) );
+          fclose(fp);
+          return XLAL_EIO;
+        }
 
-  if ( !list )
-    return FALSE;
+    } /* while !feof */
 
-  el = &(list->data[0]);
-  for ( i=0; i < list->length; i++, el++)
-    {
-      if ( (timestamp.gpsSeconds == el->gpsSeconds) && ( timestamp.gpsNanoSeconds == el->gpsNanoSeconds ) )
-	return TRUE;
-    } /* for i < length */
+  fclose(fp);
 
-  return FALSE;
+  return 0;
 
-} /* timestamp_in_list() */
+} /* read_sft_file_descriptors() */
 
 
 /* check consistency constraints for SFT-blocks within a merged SFT-file,
@@ -3197,6 +3945,54 @@ static long get_file_len ( FILE *fp )
 #define POLY64 0xd800000000000000ULL
 #define TABLELEN 256
 
+/* Tables for the slicing-by-8 CRC64 computation: crc64Table[0] is the
+ * usual byte-at-a-time table, and crc64Table[k][i] is the CRC of byte i
+ * followed by k zero bytes. The tables are read-only once initialized,
+ * so calc_crc64() is re-entrant. */
+static UINT8 crc64Table[8][TABLELEN];
+
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+static pthread_once_t crc64Once = PTHREAD_ONCE_INIT;
+#define CRC64_ONCE(init) pthread_once(&crc64Once, (init))
+#else
+/* without pthreads, guard initialization against OpenMP threads, e.g. in XLALCheckCRCSFTCatalog() */
+static int crc64Once = 1;
+static void
+crc64_once ( void (*init)(void) )
+{
+#pragma omp critical (crc64_once)
+  {
+    if ( crc64Once ) {
+      init();
+      crc64Once = 0;
+    }
+  }
+}
+#define CRC64_ONCE(init) crc64_once(init)
+#endif
+
+static void
+init_crc64_table(void)
+{
+  for (UINT4 i = 0; i < TABLELEN; i++) {
+    UINT8 part = i;
+    for (UINT4 j = 0; j < 8; j++) {
+      if (part & 1)
+        part = (part >> 1) ^ POLY64;
+      else
+        part >>= 1;
+    }
+    crc64Table[0][i] = part;
+  }
+  for (UINT4 k = 1; k < 8; k++) {
+    for (UINT4 i = 0; i < TABLELEN; i++) {
+      const UINT8 prev = crc64Table[k-1][i];
+      crc64Table[k][i] = (prev >> 8) ^ crc64Table[0][prev & 0xff];
+    }
+  }
+}
+
 /* The crc64 checksum of M bytes of data at address data is returned
  * by crc64(data, M, ~(0ULL)). Call the function multiple times to
  * compute the checksum of data made in contiguous chunks, setting
@@ -3204,34 +4000,32 @@ static long get_file_len ( FILE *fp )
 static UINT8
 calc_crc64(const CHAR *data, UINT4 length, UINT8 crc)
 {
-  UINT8 CRCTable[TABLELEN];
-  UINT4 i;
+  const unsigned char *p = (const unsigned char *) data;
 
   /* is there is no data, simply return previous checksum value */
-  if (!length || !data )
+  if (!length || !p )
     return crc;
 
-  /* initialize the CRC table for fast computation.  We could keep
-     this table in memory to make the computation faster, but that is
-     not re-entrant for multi-threaded code.
-  */
-  for (i = 0; i < TABLELEN; i++) {
-    UINT4 j;
-    UINT8 part = i;
-    for (j = 0; j < 8; j++) {
-      if (part & 1)
-        part = (part >> 1) ^ POLY64;
-      else
-        part >>= 1;
-    }
-    CRCTable[i] = part;
+  CRC64_ONCE(init_crc64_table);
+
+  /* compute the CRC-64 code 8 bytes at a time; the bytes are assembled
+     little-endian so that the result does not depend on the host byte order */
+  while (length >= 8) {
+    const UINT8 x = crc ^ ( ((UINT8) p[0])       | ((UINT8) p[1] << 8)  |
+                            ((UINT8) p[2] << 16) | ((UINT8) p[3] << 24) |
+                            ((UINT8) p[4] << 32) | ((UINT8) p[5] << 40) |
+                            ((UINT8) p[6] << 48) | ((UINT8) p[7] << 56) );
+    crc = crc64Table[7][ x        & 0xff] ^ crc64Table[6][(x >> 8)  & 0xff] ^
+          crc64Table[5][(x >> 16) & 0xff] ^ crc64Table[4][(x >> 24) & 0xff] ^
+          crc64Table[3][(x >> 32) & 0xff] ^ crc64Table[2][(x >> 40) & 0xff] ^
+          crc64Table[1][(x >> 48) & 0xff] ^ crc64Table[0][ x >> 56        ];
+    p += 8;
+    length -= 8;
   }
 
-  /* compute the CRC-64 code */
-  for (i=0; i<length; i++) {
-    UINT8 temp1 = crc >> 8;
-    UINT8 temp2 = CRCTable[(crc ^ (UINT8) data[i]) & 0xff];
-    crc = temp1 ^ temp2;
+  /* remaining bytes one at a time */
+  while (length--) {
+    crc = (crc >> 8) ^ crc64Table[0][(crc ^ *p++) & 0xff];
   }
 
   return crc;
@@ -3239,6 +4033,18 @@ calc_crc64(const CHAR *data, UINT4 length, UINT8 crc)
 } /* calc_crc64() */
 
 
+/**
+ * Compute the CRC64 checksum used by the SFTv2 standard of 'length' bytes at 'data'.
+ * To checksum data in contiguous chunks, pass the previously accumulated checksum
+ * as 'crc'; a checksum is started with crc = ~(0ULL).
+ */
+UINT8
+XLALComputeCRC64 ( const void *data, UINT4 length, UINT8 crc )
+{
+  return calc_crc64 ( (const CHAR *) data, length, crc );
+} /* XLALComputeCRC64() */
+
+
 /**
  * Check the v2 SFT-block starting at fp for valid crc64 checksum.
  * Restores filepointer before leaving.
@@ -3312,6 +4118,506 @@ has_valid_v2_crc64 ( FILE *fp )
 } /* has_valid_v2_crc64 */
 
 
+/* ---------- memory-mapped SFT loading ---------- */
+
+/* whether an SFT catalog can be loaded through memory-mapped file access */
+static BOOLEAN
+can_map_catalog ( const SFTCatalog *catalog )
+{
+#ifdef HAVE_SYS_MMAN_H
+  for ( UINT4 i = 0; i < catalog->length; i ++ )
+    {
+      if ( catalog->data[i].header.data != NULL || catalog->data[i].locator == NULL )
+        return FALSE;
+    }
+  return TRUE;
+#else
+  (void)catalog;
+  return FALSE;
+#endif
+} /* can_map_catalog() */
+
+
+/* memory-map a complete SFT file; returns 0 on success, -1 on error */
+static int
+map_sft_file ( SFTFileMapping *map )
+{
+#ifdef HAVE_SYS_MMAN_H
+  int fd;
+  struct stat st;
+  void *base;
+
+  if ( ( fd = open ( map->fname, O_RDONLY ) ) < 0 )
+    {
+      XLALPrintError ( "ERROR: Couldn't open file '%s': %s\n", map->fname, strerror(errno) );
+      return -1;
+    }
+  if ( fstat ( fd, &st ) != 0 || st.st_size <= 0 )
+    {
+      XLALPrintError ( "ERROR: Couldn't determine size of file '%s'\n", map->fname );
+      close ( fd );
+      return -1;
+    }
+
+  /* map privately, so that SFT data returned as views can be modified without changing the file */
+  base = mmap ( NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0 );
+  close ( fd );
+  if ( base == MAP_FAILED )
+    {
+      XLALPrintError ( "ERROR: Couldn't memory-map file '%s': %s\n", map->fname, strerror(errno) );
+      return -1;
+    }
+
+  map->base = base;
+  map->size = st.st_size;
+  return 0;
+#else
+  (void)map;
+  return -1;
+#endif
+} /* map_sft_file() */
+
+
+/* unmap an SFT file, if it is mapped */
+static void
+unmap_sft_file ( SFTFileMapping *map )
+{
+#ifdef HAVE_SYS_MMAN_H
+  if ( map->base != NULL )
+    munmap ( map->base, map->size );
+#endif
+  map->base = NULL;
+  map->size = 0;
+} /* unmap_sft_file() */
+
+
+/* unmap all SFT files and free a tagSFTFileMappings */
+static void
+destroy_sft_file_mappings ( struct tagSFTFileMappings *mappings )
+{
+  if ( mappings == NULL )
+    return;
+
+  for ( UINT4 m = 0; m < mappings->numMaps; m ++ )
+    unmap_sft_file ( &mappings->maps[m] );
+
+  XLALFree ( mappings->maps );
+  XLALFree ( mappings->isView );
+  XLALFree ( mappings );
+
+  return;
+
+} /* destroy_sft_file_mappings() */
+
+
+/*
+ * Locate the frequency-bins of the (v2) SFT described by 'desc' in the mapped file 'map'.
+ * The mapped SFT-header is checked against the catalog, in case the file has been changed.
+ * Returns 0 on success, -1 on error.
+ */
+static int
+locate_mapped_sft_bins ( char **bins, BOOLEAN *swapEndian, const SFTFileMapping *map, const SFTDescriptor *desc )
+{
+  _SFT_header_v2_t rawheader;
+  const size_t offset = desc->locator->offset;
+  const REAL8 version = 2;
+  REAL8 version_swapped = version;
+  size_t data_offset;
+
+  if ( offset + sizeof(rawheader) > map->size )
+    {
+      XLALPrintError ( "ERROR: SFT at position %zu is beyond end of file '%s'\n", offset, map->fname );
+      return -1;
+    }
+  memcpy ( &rawheader, map->base + offset, sizeof(rawheader) );
+
+  /* figure out endian-ness */
+  endian_swap( (CHAR*)(&version_swapped), sizeof( version_swapped ), 1 );
+  if ( memcmp ( &rawheader.version, &version, sizeof(version) ) == 0 )
+    *swapEndian = FALSE;
+  else if ( memcmp ( &rawheader.version, &version_swapped, sizeof(version) ) == 0 )
+    *swapEndian = TRUE;
+  else
+    {
+      XLALPrintError ( "ERROR: Invalid SFT-version at position %zu in file '%s'\n", offset, map->fname );
+      return -1;
+    }
+  if ( *swapEndian )
+    {
+      endian_swap((CHAR*)(&rawheader.gps_sec), 			sizeof(rawheader.gps_sec) 		, 1);
+      endian_swap((CHAR*)(&rawheader.gps_nsec), 		sizeof(rawheader.gps_nsec) 		, 1);
+      endian_swap((CHAR*)(&rawheader.first_frequency_index), 	sizeof(rawheader.first_frequency_index) , 1);
+      endian_swap((CHAR*)(&rawheader.nsamples), 		sizeof(rawheader.nsamples) 		, 1);
+      endian_swap((CHAR*)(&rawheader.comment_length),		sizeof(rawheader.comment_length)	, 1);
+    }
+
+  /* check consistency with catalog */
+  volatile REAL8 tmp = desc->header.f0 / desc->header.deltaF;
+  if ( rawheader.gps_sec != desc->header.epoch.gpsSeconds || rawheader.gps_nsec != desc->header.epoch.gpsNanoSeconds
+       || rawheader.nsamples != (INT4)desc->numBins || rawheader.first_frequency_index != lround ( tmp )
+       || rawheader.comment_length < 0 || rawheader.comment_length % 8 != 0 )
+    {
+      XLALPrintError ( "ERROR: SFT-header at position %zu in file '%s' is inconsistent with SFT catalog\n", offset, map->fname );
+      return -1;
+    }
+
+  data_offset = offset + sizeof(rawheader) + rawheader.comment_length;
+  if ( data_offset + desc->numBins * sizeof(COMPLEX8) > map->size )
+    {
+      XLALPrintError ( "ERROR: SFT at position %zu is truncated in file '%s'\n", offset, map->fname );
+      return -1;
+    }
+
+  *bins = map->base + data_offset;
+  return 0;
+
+} /* locate_mapped_sft_bins() */
+
+
+/* compare two SFTMappedSegments by SFT index, then first bin */
+static int
+compareSFTMappedSegments ( const void *ptr1, const void *ptr2 )
+{
+  const SFTMappedSegment *seg1 = ptr1;
+  const SFTMappedSegment *seg2 = ptr2;
+  if ( seg1->isft != seg2->isft )
+    return ( seg1->isft < seg2->isft ) ? -1 : 1;
+  if ( seg1->first != seg2->first )
+    return ( seg1->first < seg2->first ) ? -1 : 1;
+  return 0;
+} /* compareSFTMappedSegments() */
+
+
+/* compare two SFTMappedSegments by index of mapped file, then SFT index */
+static int
+compareSFTMappedSegmentsByFile ( const void *ptr1, const void *ptr2 )
+{
+  const SFTMappedSegment *seg1 = ptr1;
+  const SFTMappedSegment *seg2 = ptr2;
+  if ( seg1->imap != seg2->imap )
+    return ( seg1->imap < seg2->imap ) ? -1 : 1;
+  if ( seg1->isft != seg2->isft )
+    return ( seg1->isft < seg2->isft ) ? -1 : 1;
+  return 0;
+} /* compareSFTMappedSegmentsByFile() */
+
+
+/* compare two SFT-descriptor pointers by the file name of their locator */
+static int
+compareSFTdescFname ( const void *ptr1, const void *ptr2 )
+{
+  const SFTDescriptor *const *desc1 = ptr1;
+  const SFTDescriptor *const *desc2 = ptr2;
+  return strcmp ( (*desc1)->locator->fname, (*desc2)->locator->fname );
+} /* compareSFTdescFname() */
+
+
+/* compare two pointers to SFT-descriptors by their file name, then position in file */
+static int
+compareSFTdescLocator ( const void *ptr1, const void *ptr2 )
+{
+  const SFTDescriptor *const *desc1 = ptr1;
+  const SFTDescriptor *const *desc2 = ptr2;
+  int s = strcmp ( (*desc1)->locator->fname, (*desc2)->locator->fname );
+  if ( s != 0 )
+    return s;
+  if ( (*desc1)->locator->offset < (*desc2)->locator->offset )
+    return -1;
+  else if ( (*desc1)->locator->offset > (*desc2)->locator->offset )
+    return 1;
+  return 0;
+} /* compareSFTdescLocator() */
+
+
+/*
+ * Core function of XLALLoadSFTsMapped() and XLALMapSFTs(): map the SFT-files of the catalog
+ * (each file only once) in batches of at most SFTFILEIO_MAP_BATCHSIZE files, and extract the
+ * band [fMin, fMax] from all SFTs of each batch in parallel; files are unmapped once their SFTs
+ * have been extracted, so that catalogs of many files do not exhaust the number of mappings
+ * allowed per process. If 'wantViews' is TRUE, the data of SFTs which can be taken from a single
+ * native-endian segment points into the mapped files, which stay mapped; to bound the number of
+ * mappings, only SFTs in the first SFTFILEIO_MAX_VIEW_MAPPINGS such files are returned as views,
+ * and the data of all other SFTs is copied.
+ */
+static int
+load_sfts_mapped ( SFTVector **sftVector, struct tagSFTFileMappings **mappings, const SFTCatalog *catalog, REAL8 fMin, REAL8 fMax, BOOLEAN wantViews )
+{
+  const UINT4 numDesc = catalog->length;
+  UINT4 firstbin, lastbin, minbin, maxbin;
+  UINT4 nSFTs = 1;
+  REAL8 deltaF;
+  SFTMappedSegment *segs = NULL;
+  const SFTDescriptor **byFname = NULL;
+  UINT4 *segStart = NULL;
+  UINT4 numSegs = 0;
+  UINT4 numKeep = 0;
+  struct tagSFTFileMappings *maps = NULL;
+  SFTVector *sfts = NULL;
+  int errnum = 0;
+
+  XLAL_CHECK ( (segs = XLALCalloc ( numDesc, sizeof(*segs) )) != NULL, XLAL_ENOMEM );
+
+  /* determine SFT index of each descriptor, and min and max bin of all SFTs, as in XLALLoadSFTs() */
+  deltaF = catalog->data[0].header.deltaF;
+  minbin = maxbin = lround ( catalog->data[0].header.f0 / deltaF );
+  for ( UINT4 i = 0; i < numDesc; i ++ )
+    {
+      const SFTDescriptor *desc = &catalog->data[i];
+      if ( i > 0 && !GPSEQUAL ( catalog->data[i-1].header.epoch, desc->header.epoch ) )
+        nSFTs ++;
+      if ( desc->header.deltaF != deltaF )
+        {
+          errnum = XLAL_EIO;
+          XLALPrintError ( "ERROR: deltaF mismatch (%f/%f) in SFT '%s'\n", desc->header.deltaF, deltaF, desc->locator->fname );
+          goto failed;
+        }
+      UINT4 first = lround ( desc->header.f0 / deltaF );
+      UINT4 last = first + desc->numBins - 1;
+      if ( first < minbin )
+        minbin = first;
+      if ( last > maxbin )
+        maxbin = last;
+      segs[i].isft = nSFTs - 1;
+      segs[i].first = first;
+      segs[i].last = last;
+      segs[i].idesc = i;
+    }
+
+  /* calculate first and last frequency bin to read */
+  if ( fMin < 0 )
+    firstbin = minbin;
+  else
+    firstbin = XLALRoundFrequencyDownToSFTBin ( fMin, deltaF );
+  if ( fMax < 0 )
+    lastbin = maxbin;
+  else
+    lastbin = XLALRoundFrequencyUpToSFTBin ( fMax, deltaF );
+  if ( lastbin < firstbin )
+    {
+      errnum = XLAL_EINVAL;
+      XLALPrintError ( "ERROR: empty frequency band [%f, %f] Hz requested\n", fMin, fMax );
+      goto failed;
+    }
+  const UINT4 numBins = lastbin + 1 - firstbin;
+
+  /* assign each descriptor to a file mapping, mapping each file only once */
+  if ( (byFname = XLALCalloc ( numDesc, sizeof(*byFname) )) == NULL
+       || (maps = XLALCalloc ( 1, sizeof(*maps) )) == NULL
+       || (maps->maps = XLALCalloc ( numDesc, sizeof(*maps->maps) )) == NULL
+       || (maps->isView = XLALCalloc ( nSFTs, sizeof(*maps->isView) )) == NULL )
+    {
+      errnum = XLAL_ENOMEM;
+      goto failed;
+    }
+  maps->numSFTs = nSFTs;
+  for ( UINT4 i = 0; i < numDesc; i ++ )
+    byFname[i] = &catalog->data[i];
+  qsort ( byFname, numDesc, sizeof(byFname[0]), compareSFTdescFname );
+  for ( UINT4 i = 0; i < numDesc; i ++ )
+    {
+      if ( i == 0 || strcmp ( byFname[i]->locator->fname, byFname[i-1]->locator->fname ) != 0 )
+        {
+          maps->maps[maps->numMaps].fname = byFname[i]->locator->fname;
+          maps->numMaps ++;
+        }
+      segs[byFname[i] - catalog->data].imap = maps->numMaps - 1;
+    }
+  XLALFree ( byFname );
+  byFname = NULL;
+
+  /* restrict segments to the requested band, drop those outside it, and sort them by SFT and frequency */
+  for ( UINT4 i = 0; i < numDesc; i ++ )
+    {
+      SFTMappedSegment seg = segs[i];
+      if ( seg.first < firstbin )
+        seg.first = firstbin;
+      if ( seg.last > lastbin )
+        seg.last = lastbin;
+      if ( seg.first <= seg.last )
+        segs[numSegs++] = seg;
+    }
+  qsort ( segs, numSegs, sizeof(segs[0]), compareSFTMappedSegments );
+
+  /* check that each SFT is covered by its segments without gaps or overlaps */
+  if ( (segStart = XLALCalloc ( nSFTs + 1, sizeof(*segStart) )) == NULL )
+    {
+      errnum = XLAL_ENOMEM;
+      goto failed;
+    }
+  for ( UINT4 s = 0, isft = 0; isft < nSFTs; isft ++ )
+    {
+      UINT4 nextbin = firstbin;
+      segStart[isft] = s;
+      for ( ; s < numSegs && segs[s].isft == isft; s ++ )
+        {
+          if ( segs[s].first != nextbin )
+            {
+              errnum = XLAL_EIO;
+              XLALPrintError ( "ERROR: data gap or overlap in SFT#%u (GPS %lf): expected bin %u, bin %u found in file '%s'\n",
+                               isft, GPS2REAL8(catalog->data[segs[s].idesc].header.epoch), nextbin, segs[s].first,
+                               catalog->data[segs[s].idesc].locator->fname );
+              break;
+            }
+          nextbin = segs[s].last + 1;
+        }
+      if ( errnum == 0 && nextbin != lastbin + 1 )
+        {
+          errnum = XLAL_EIO;
+          XLALPrintError ( "ERROR: data missing in SFT#%u: expected bin %u, last bin found %u\n", isft, lastbin, nextbin - 1 );
+        }
+      if ( errnum != 0 )
+        goto failed;
+      /* data can be returned as a view only if it is taken from a single segment, in a file which stays mapped */
+      if ( wantViews && ( s - segStart[isft] == 1 ) )
+        {
+          SFTFileMapping *map = &maps->maps[segs[segStart[isft]].imap];
+          if ( !map->keep && numKeep < SFTFILEIO_MAX_VIEW_MAPPINGS )
+            {
+              map->keep = TRUE;
+              numKeep ++;
+            }
+          maps->isView[isft] = map->keep;
+        }
+    }
+  segStart[nSFTs] = numSegs;
+
+  /* allocate SFT vector and SFT data, unless SFTs are views, and copy headers */
+  if ( (sfts = XLALCreateSFTVector ( nSFTs, 0 )) == NULL )
+    {
+      errnum = XLAL_ENOMEM;
+      goto failed;
+    }
+  for ( UINT4 isft = 0; isft < nSFTs; isft ++ )
+    {
+      SFTtype *sft = &sfts->data[isft];
+      const SFTDescriptor *desc0 = &catalog->data[segs[segStart[isft]].idesc];
+      memcpy ( sft->name, desc0->header.name, sizeof(sft->name) );
+      sft->epoch = desc0->header.epoch;
+      sft->f0 = 1.0 * firstbin * deltaF;
+      sft->deltaF = deltaF;
+      sft->sampleUnits = desc0->header.sampleUnits;
+      if ( maps->isView[isft] )
+        sft->data = XLALCalloc ( 1, sizeof(*sft->data) );
+      else
+        sft->data = XLALCreateCOMPLEX8Vector ( numBins );
+      if ( sft->data == NULL )
+        {
+          errnum = XLAL_ENOMEM;
+          goto failed;
+        }
+    }
+
+  /* sort segments by file, so that each batch of files holds a contiguous range of segments */
+  qsort ( segs, numSegs, sizeof(segs[0]), compareSFTMappedSegmentsByFile );
+
+  for ( UINT4 m0 = 0, s0 = 0; m0 < maps->numMaps; m0 += SFTFILEIO_MAP_BATCHSIZE )
+    {
+      const UINT4 m1 = ( maps->numMaps - m0 < SFTFILEIO_MAP_BATCHSIZE ) ? maps->numMaps : m0 + SFTFILEIO_MAP_BATCHSIZE;
+      UINT4 s1 = s0;
+      while ( s1 < numSegs && segs[s1].imap < m1 )
+        s1 ++;
+
+      /* map this batch of files */
+#pragma omp parallel for schedule(dynamic)
+      for ( INT4 m = m0; m < (INT4)m1; m ++ )
+        {
+          if ( map_sft_file ( &maps->maps[m] ) != 0 )
+            {
+#pragma omp critical (load_sfts_mapped)
+              errnum = XLAL_EIO;
+            }
+        }
+      if ( errnum != 0 )
+        goto failed;
+
+      /* extract the requested band from all segments in this batch of files; each segment fills a distinct range of bins */
+#pragma omp parallel for schedule(dynamic)
+      for ( INT4 s = s0; s < (INT4)s1; s ++ )
+        {
+          const SFTMappedSegment *seg = &segs[s];
+          const SFTDescriptor *desc = &catalog->data[seg->idesc];
+          SFTtype *sft = &sfts->data[seg->isft];
+          char *bins;
+          BOOLEAN swapEndian;
+          int thisErr = 0;
+          if ( locate_mapped_sft_bins ( &bins, &swapEndian, &maps->maps[seg->imap], desc ) != 0 )
+            thisErr = XLAL_EIO;
+          else
+            {
+              volatile REAL8 tmp = desc->header.f0 / deltaF;
+              const UINT4 offsetBins = seg->first - lround ( tmp );
+              const UINT4 numSegBins = seg->last - seg->first + 1;
+              bins += offsetBins * sizeof(COMPLEX8);
+
+              if ( maps->isView[seg->isft] && !swapEndian )
+                {
+                  sft->data->length = numSegBins;
+                  sft->data->data = (COMPLEX8 *) bins;
+                }
+              else
+                {
+                  if ( maps->isView[seg->isft] )
+                    {
+                      /* cannot return byte-swapped data as a view: copy instead; a view SFT has only this segment */
+                      maps->isView[seg->isft] = FALSE;
+                      XLALFree ( sft->data );
+                      sft->data = XLALCreateCOMPLEX8Vector ( numBins );
+                    }
+                  if ( sft->data == NULL )
+                    thisErr = XLAL_ENOMEM;
+                  else
+                    {
+                      COMPLEX8 *dst = sft->data->data + ( seg->first - firstbin );
+                      memcpy ( dst, bins, numSegBins * sizeof(COMPLEX8) );
+                      if ( swapEndian )
+                        endian_swap ( (CHAR*) dst, sizeof(REAL4), 2 * numSegBins );
+                    }
+                }
+            }
+          if ( thisErr != 0 )
+            {
+#pragma omp critical (load_sfts_mapped)
+              errnum = thisErr;
+            }
+        }
+      if ( errnum != 0 )
+        goto failed;
+
+      /* unmap files of this batch which hold no views */
+      for ( UINT4 m = m0; m < m1; m ++ )
+        {
+          if ( !maps->maps[m].keep )
+            unmap_sft_file ( &maps->maps[m] );
+        }
+
+      s0 = s1;
+    }
+
+  XLALFree ( segStart );
+  XLALFree ( segs );
+
+  (*sftVector) = sfts;
+  (*mappings) = maps;
+
+  return XLAL_SUCCESS;
+
+ failed:
+  if ( sfts != NULL )
+    {
+      for ( UINT4 isft = 0; isft < nSFTs; isft ++ )
+        if ( maps->isView[isft] && sfts->data[isft].data != NULL )
+          sfts->data[isft].data->data = NULL;
+      XLALDestroySFTVector ( sfts );
+    }
+  destroy_sft_file_mappings ( maps );
+  XLALFree ( byFname );
+  XLALFree ( segStart );
+  XLALFree ( segs );
+  XLAL_ERROR ( errnum );
+
+} /* load_sfts_mapped() */
+
+
 /* compare two SFT-descriptors by their GPS-epoch, then starting frequency */
 int
 compareSFTdesc(const void *ptr1, const void *ptr2)
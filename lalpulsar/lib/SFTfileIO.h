@@ -85,6 +85,11 @@ extern "C" {
  * Thes function XLALSFTdataFind() returns an SFTCatalog of matching SFTs for a given file-pattern
  * (e.g. "SFT.*", "SFT.000", "/some/path/some_files_[0-9]?.sft", etc ) and additional, optional SFTConstraints.
  *
+ * Reading the headers of many SFT files can be avoided by first writing an SFT catalog index with
+ * XLALWriteSFTCatalogIndex() (or \c lalapps_MakeSFTCatalogIndex), and then passing the file-pattern
+ * <tt>index:\<indexfile\></tt> to XLALSFTdataFind(). Only the sizes and modification times of the indexed
+ * SFT files are then checked, see XLALReadSFTCatalogIndex().
+ *
  * The optional constraints are:
  * - detector-prefix (e.g. "H1", "H2", "L1", "G1", "V1", etc..)
  * - GPS start-time + end-time
@@ -131,6 +136,10 @@ extern "C" {
  * The function XLALLoadMultiSFTs() is similar to the above, except that it accepts an \c SFTCatalog with different detectors,
  * and returns corresponding multi-IFO vector of SFTVectors.
  *
+ * The functions XLALLoadSFTsMapped() and XLALLoadMultiSFTsMapped() return the same results using memory-mapped
+ * file access, mapping each SFT-file only once and extracting the band from many SFTs in parallel (using OpenMP, if enabled).
+ * XLALMapSFTs() avoids copying the SFT data altogether, returning SFTs which point into the mapped files.
+ *
  * <p><h2>Usage: Writing of SFT-files</h2>
  *
  * For <b>writing SFTs</b>:
@@ -275,6 +284,17 @@ typedef struct tagMultiSFTCatalogView
 } MultiSFTCatalogView;
 
 
+/**
+ * An ::SFTVector whose data may point directly into memory-mapped SFT-files, as returned by XLALMapSFTs().
+ * Must be freed with XLALDestroyMappedSFTVector(), which also unmaps the SFT-files.
+ */
+typedef struct tagMappedSFTVector
+{
+  SFTVector *sfts;				/**< the SFTs */
+  struct tagSFTFileMappings *mappings;		/**< *internal* memory-mappings of SFT-files holding the SFT data [opaque!] */
+} MappedSFTVector;
+
+
 /*---------- Global variables ----------*/
 
 /*
@@ -289,6 +309,8 @@ UINT4 XLALRoundFrequencyUpToSFTBin( const REAL8 freq, const REAL8 df );
 LALStringVector *XLALFindFiles (const CHAR *globstring);
 
 SFTCatalog *XLALSFTdataFind ( const CHAR *file_pattern, const SFTConstraints *constraints );
+int XLALWriteSFTCatalogIndex ( const SFTCatalog *catalog, const CHAR *fname );
+SFTCatalog *XLALReadSFTCatalogIndex ( const CHAR *fname );
 
 int XLALWriteSFTVector2Dir  ( const SFTVector *sftVect, const CHAR *dirname, const CHAR *SFTcomment, const CHAR *Misc );
 int XLALWriteSFTVector2File ( const SFTVector *sftVect, const CHAR *dirname, const CHAR *SFTcomment, const CHAR *Misc );
@@ -308,7 +330,13 @@ SFTVector* XLALLoadSFTs (const SFTCatalog *catalog, REAL8 fMin, REAL8 fMax);
 MultiSFTVector* XLALLoadMultiSFTs (const SFTCatalog *catalog, REAL8 fMin, REAL8 fMax);
 MultiSFTVector *XLALLoadMultiSFTsFromView ( const MultiSFTCatalogView *multiCatalogView, REAL8 fMin, REAL8 fMax );
 
+SFTVector *XLALLoadSFTsMapped ( const SFTCatalog *catalog, REAL8 fMin, REAL8 fMax );
+MultiSFTVector *XLALLoadMultiSFTsMapped ( const SFTCatalog *inputCatalog, REAL8 fMin, REAL8 fMax );
+MappedSFTVector *XLALMapSFTs ( const SFTCatalog *catalog, REAL8 fMin, REAL8 fMax );
+void XLALDestroyMappedSFTVector ( MappedSFTVector *mapped );
+
 int XLALCheckCRCSFTCatalog( BOOLEAN *crc_check, SFTCatalog *catalog );
+UINT8 XLALComputeCRC64 ( const void *data, UINT4 length, UINT8 crc );
 
 void XLALDestroySFTCatalog ( SFTCatalog *catalog );
 LALStringVector *XLALListIFOsInCatalog( const SFTCatalog *catalog );
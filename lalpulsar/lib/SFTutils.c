@@ -38,6 +38,8 @@
 #include <lal/SFTutils.h>
 #include <lal/SFTReferenceLibrary.h>
 
+#include "SFTutils_internal.h"
+
 #if defined(__GNUC__)
 #define UNUSED __attribute__ ((unused))
 #else
@@ -89,8 +91,6 @@ const UserChoices MathOpTypeChoices = {
 
 
 /*---------- internal prototypes ----------*/
-REAL8 TSFTfromDFreq ( REAL8 dFreq );
-int compareSFTdesc(const void *ptr1, const void *ptr2);     // defined in SFTfileIO.c
 
 /*==================== FUNCTION DEFINITIONS ====================*/
 
@@ -1105,13 +1105,9 @@ XLALComputeMultiNoiseWeights ( const MultiPSDVector  *rngmed,
   XLAL_CHECK_NULL ( (multiWeights->data = XLALCalloc ( numIFOs, sizeof(*multiWeights->data))) != NULL, XLAL_ENOMEM );
   multiWeights->length = numIFOs;
 
-  UINT4 numSFTsTot = 0;
-  REAL8 sumWeights = 0;
-
   for ( UINT4 X = 0; X < numIFOs; X++)
     {
       UINT4 numSFTs = rngmed->data[X]->length;
-      numSFTsTot += numSFTs;
 
       /* create k^th weights vector */
       if( ( multiWeights->data[X] = XLALCreateREAL8Vector ( numSFTs ) ) == NULL )
@@ -1124,35 +1120,68 @@ XLALComputeMultiNoiseWeights ( const MultiPSDVector  *rngmed,
       /* loop over rngmeds and calculate weights -- one for each sft */
       for ( UINT4 alpha = 0; alpha < numSFTs; alpha++)
 	{
-	  UINT4 halfBlock = blocksRngMed/2;
+	  const REAL8FrequencySeries *thisrm = &(rngmed->data[X]->data[alpha]);
+	  if ( thisrm->data->length < blocksRngMed )
+	    {
+	      XLALDestroyMultiNoiseWeights ( multiWeights );
+	      XLAL_ERROR_NULL ( XLAL_EINVAL, "Need at least %d bins in SFT (have %d) to compute noise weights", blocksRngMed, thisrm->data->length );
+	    }
+	  multiWeights->data[X]->data[alpha] = RngmedToNoiseWeight ( thisrm, blocksRngMed, excludePercentile );
+	} /* end loop over sfts for each ifo */
 
-	  REAL8FrequencySeries *thisrm = &(rngmed->data[X]->data[alpha]);
+    } /* end loop over ifos */
 
-	  UINT4 lengthsft = thisrm->data->length;
+  NormalizeMultiNoiseWeights ( multiWeights, Tsft );
 
-	  XLAL_CHECK_NULL ( lengthsft >= blocksRngMed, XLAL_EINVAL );
+  return multiWeights;
 
-	  UINT4 length = lengthsft - blocksRngMed + 1;
-	  UINT4 halfLength = length/2;
+} /* XLALComputeMultiNoiseWeights() */
 
-	  /* calculate index in power medians vector from which to calculate mean */
-	  UINT4 excludeIndex =  excludePercentile * halfLength ; /* integer arithmetic */
-	  excludeIndex /= 100; /* integer arithmetic */
+/**
+ * Compute the unnormalized noise weight of one SFT, i.e. the inverse of the running-median
+ * power averaged over all bins of \a rngmed, excluding \a excludePercentile of the bins at
+ * either end; \a rngmed must have at least \a blocksRngMed bins.
+ */
+REAL8
+RngmedToNoiseWeight ( const REAL8FrequencySeries *rngmed, UINT4 blocksRngMed, UINT4 excludePercentile )
+{
+  UINT4 halfBlock = blocksRngMed/2;
+  UINT4 lengthsft = rngmed->data->length;
+  UINT4 length = lengthsft - blocksRngMed + 1;
+  UINT4 halfLength = length/2;
 
-	  REAL8 Tsft_avgS2 = 0.0;	// 'S2' refers to double-sided PSD
-	  for ( UINT4 k = halfBlock + excludeIndex; k < lengthsft - halfBlock - excludeIndex; k++)
-	    {
-	      Tsft_avgS2 += thisrm->data->data[k];
-	    }
-	  Tsft_avgS2 /= lengthsft - 2*halfBlock - 2*excludeIndex;
+  /* calculate index in power medians vector from which to calculate mean */
+  UINT4 excludeIndex =  excludePercentile * halfLength ; /* integer arithmetic */
+  excludeIndex /= 100; /* integer arithmetic */
 
-          REAL8 wXa = 1.0/Tsft_avgS2;	// unnormalized weight
-	  multiWeights->data[X]->data[alpha] = wXa;
+  REAL8 Tsft_avgS2 = 0.0;	// 'S2' refers to double-sided PSD
+  for ( UINT4 k = halfBlock + excludeIndex; k < lengthsft - halfBlock - excludeIndex; k++)
+    {
+      Tsft_avgS2 += rngmed->data->data[k];
+    }
+  Tsft_avgS2 /= lengthsft - 2*halfBlock - 2*excludeIndex;
 
-	  sumWeights += wXa;	// sum the weights to normalize this at the end
-	} /* end loop over sfts for each ifo */
+  return 1.0/Tsft_avgS2;	// unnormalized weight
 
-    } /* end loop over ifos */
+} /* RngmedToNoiseWeight() */
+
+/**
+ * Normalize unnormalized SFT noise weights, as computed by RngmedToNoiseWeight(), to be of order
+ * unity, and set the overall noise-normalization factor \a multiWeights->Sinv_Tsft.
+ */
+void
+NormalizeMultiNoiseWeights ( MultiNoiseWeights *multiWeights, REAL8 Tsft )
+{
+  UINT4 numSFTsTot = 0;
+  REAL8 sumWeights = 0;
+  for ( UINT4 X = 0; X < multiWeights->length; X ++) {
+    UINT4 numSFTs = multiWeights->data[X]->length;
+    numSFTsTot += numSFTs;
+    for ( UINT4 alpha = 0; alpha < numSFTs; alpha ++)
+      {
+	sumWeights += multiWeights->data[X]->data[alpha];	// sum the weights to normalize them
+      }
+  }
 
   /* overall noise-normalization factor Sinv = 1/Nsft sum_Xa Sinv_Xa,
    * see Eq.(60) in CFSv2 notes:
@@ -1161,7 +1190,7 @@ XLALComputeMultiNoiseWeights ( const MultiPSDVector  *rngmed,
   REAL8 TsftS2_inv = sumWeights / numSFTsTot;	// this is double-sided PSD 'S2'
 
   /* make weights of order unity by normalizing with TsftS2_inv, see Eq.(58) in CFSv2 notes (v3) */
-  for ( UINT4 X = 0; X < numIFOs; X ++) {
+  for ( UINT4 X = 0; X < multiWeights->length; X ++) {
     UINT4 numSFTs = multiWeights->data[X]->length;
     for ( UINT4 alpha = 0; alpha < numSFTs; alpha ++)
       {
@@ -1171,9 +1200,7 @@ XLALComputeMultiNoiseWeights ( const MultiPSDVector  *rngmed,
 
   multiWeights->Sinv_Tsft = 0.5 * Tsft*Tsft * TsftS2_inv;		/* 'Sinv * Tsft' refers to single-sided PSD!! Eq.(60) in CFSv2 notes (v3)*/
 
-  return multiWeights;
-
-} /* XLALComputeMultiNoiseWeights() */
+} /* NormalizeMultiNoiseWeights() */
 
 /** Destroy a MultiNoiseWeights object */
 void
@@ -0,0 +1,34 @@
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with with program; see the file COPYING. If not, write to the
+// Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301  USA
+//
+
+#include <lal/SFTutils.h>
+
+// ============================================================================================== //
+//                                                                                                //
+// This file should **ONLY** contain definitions that **MUST** be shared between SFT source files //
+//                                                                                                //
+// ============================================================================================== //
+
+// ---------- Shared internal functions ---------- //
+
+// defined in SFTutils.c
+REAL8 TSFTfromDFreq ( REAL8 dFreq );
+REAL8 RngmedToNoiseWeight ( const REAL8FrequencySeries *rngmed, UINT4 blocksRngMed, UINT4 excludePercentile );
+void NormalizeMultiNoiseWeights ( MultiNoiseWeights *multiWeights, REAL8 Tsft );
+
+// defined in SFTfileIO.c
+int compareSFTdesc ( const void *ptr1, const void *ptr2 );
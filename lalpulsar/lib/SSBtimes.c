@@ -36,6 +36,20 @@
 /** Simple Euklidean scalar product for two 3-dim vectors in cartesian coords */
 #define SCALAR(u,v) ((u)[0]*(v)[0] + (u)[1]*(v)[1] + (u)[2]*(v)[2])
 
+/*---------- internal types ----------*/
+
+/** Sky-independent SSB-timing quantities for one detector */
+typedef struct tagSSBtimesBatch {
+  UINT4 numSteps;		/**< number of timestamps */
+  LIGOTimeGPS *tGPS;		/**< timestamps t_i */
+  BarycenterBatch *bary;	/**< sky-independent barycentering quantities at timestamps t_i */
+} SSBtimesBatch;
+
+struct tagMultiSSBtimesBatch {
+  UINT4 length;			/**< number of detectors */
+  SSBtimesBatch *data;		/**< array of per-detector quantities */
+};
+
 /*---------- Global variables ----------*/
 
 const UserChoices SSBprecisionChoices = {
@@ -699,6 +713,177 @@ XLALGetMultiSSBtimes ( const MultiDetectorStateSeries *multiDetStates, /**< [in]
 
 } /* XLALGetMultiSSBtimes() */
 
+/** Precompute all sky-independent SSB-timing quantities for the given detector-states, so that SSB times
+ * for many sky positions can then be obtained quickly with XLALGetMultiSSBtimesBatch().
+ *
+ * NOTE: this functions *allocates* the output, use XLALDestroyMultiSSBtimesBatch() to free this.
+ */
+MultiSSBtimesBatch *
+XLALCreateMultiSSBtimesBatch ( const MultiDetectorStateSeries *multiDetStates /**< [in] detector-states at timestamps t_i */
+                               )
+{
+  XLAL_CHECK_NULL ( multiDetStates != NULL, XLAL_EINVAL, "Invalid NULL input 'multiDetStates'\n");
+  XLAL_CHECK_NULL ( multiDetStates->length > 0, XLAL_EINVAL, "Invalid zero-length 'multiDetStates'\n");
+
+  UINT4 numDetectors = multiDetStates->length;
+
+  MultiSSBtimesBatch *ret = XLALCalloc ( 1, sizeof( *ret ) );
+  XLAL_CHECK_NULL ( ret != NULL, XLAL_ENOMEM, "Failed to XLALCalloc(1,%zu)\n", sizeof( *ret ) );
+  ret->length = numDetectors;
+  ret->data = XLALCalloc ( numDetectors, sizeof ( *ret->data ) );
+  XLAL_CHECK_FAIL ( ret->data != NULL, XLAL_ENOMEM, "Failed to XLALCalloc(%d,%zu)\n", numDetectors, sizeof ( *ret->data ) );
+
+  for ( UINT4 X = 0; X < numDetectors; X ++ )
+    {
+      const DetectorStateSeries *detStates = multiDetStates->data[X];
+      XLAL_CHECK_FAIL ( detStates != NULL && detStates->length > 0, XLAL_EINVAL, "Invalid NULL or zero-length 'multiDetStates->data[%d]'\n", X );
+      SSBtimesBatch *batch = &ret->data[X];
+
+      // site location in light seconds, as required by XLALBarycenter()
+      LALDetector site = detStates->detector;
+      site.location[0] /= LAL_C_SI;
+      site.location[1] /= LAL_C_SI;
+      site.location[2] /= LAL_C_SI;
+
+      batch->numSteps = detStates->length;
+      batch->tGPS = XLALCalloc ( batch->numSteps, sizeof ( batch->tGPS[0] ) );
+      XLAL_CHECK_FAIL ( batch->tGPS != NULL, XLAL_ENOMEM, "Failed to XLALCalloc(%d,%zu)\n", batch->numSteps, sizeof ( batch->tGPS[0] ) );
+      batch->bary = XLALCreateBarycenterBatch ( &site, batch->numSteps );
+      XLAL_CHECK_FAIL ( batch->bary != NULL, XLAL_EFUNC, "XLALCreateBarycenterBatch() failed with xlalErrno = %d\n", xlalErrno );
+
+      for ( UINT4 i = 0; i < batch->numSteps; i++ )
+        {
+          const DetectorState *state = &(detStates->data[i]);
+          batch->tGPS[i] = state->tGPS;
+          XLAL_CHECK_FAIL ( XLALSetBarycenterBatchTime ( batch->bary, i, &state->tGPS, &state->earthState ) == XLAL_SUCCESS, XLAL_EFUNC );
+        }
+
+    } /* for X < numDetectors */
+
+  return ret;
+
+XLAL_FAIL:
+  XLALDestroyMultiSSBtimesBatch ( ret );
+  return NULL;
+
+} /* XLALCreateMultiSSBtimesBatch() */
+
+/** Compute SSB-timings for all detectors at the given sky position, using the sky-independent quantities
+ * precomputed by XLALCreateMultiSSBtimesBatch(). The result is equivalent to XLALGetMultiSSBtimes() with
+ * precision SSBPREC_RELATIVISTICOPT, up to rounding of the SSB times to nanoseconds.
+ *
+ * If (*multiSSB)==NULL it is allocated here, otherwise it is re-used; this avoids re-allocating the output
+ * at every sky position. If OpenMP is enabled, the timestamps of each detector are split across
+ * \a numThreads threads (0 = OpenMP default).
+ */
+int
+XLALGetMultiSSBtimesBatch ( MultiSSBtimes **multiSSB,		/**< [in/out] SSB times, allocated here if (*multiSSB)==NULL */
+                            const MultiSSBtimesBatch *batch,	/**< [in] precomputed sky-independent quantities */
+                            SkyPosition skypos,			/**< source sky-position [in equatorial coords!] */
+                            LIGOTimeGPS refTime,		/**< SSB reference-time T_0 for SSB-timing */
+                            UINT4 numThreads			/**< number of threads to use, if OpenMP is enabled */
+                            )
+{
+  XLAL_CHECK ( multiSSB != NULL, XLAL_EINVAL, "Invalid NULL input 'multiSSB'\n" );
+  XLAL_CHECK ( batch != NULL, XLAL_EINVAL, "Invalid NULL input 'batch'\n" );
+  XLAL_CHECK ( skypos.system == COORDINATESYSTEM_EQUATORIAL, XLAL_EDOM, "Only equatorial coordinate system (=%d) allowed, got %d\n", COORDINATESYSTEM_EQUATORIAL, skypos.system );
+
+  UINT4 numDetectors = batch->length;
+
+  // prepare output struct, or check that it can be re-used
+  MultiSSBtimes *ret = (*multiSSB);
+  if ( ret == NULL )
+    {
+      XLAL_CHECK ( (ret = XLALCalloc ( 1, sizeof( *ret ) )) != NULL, XLAL_ENOMEM );
+      XLAL_CHECK_FAIL ( (ret->data = XLALCalloc ( numDetectors, sizeof ( *ret->data ) )) != NULL, XLAL_ENOMEM );
+      ret->length = numDetectors;
+      for ( UINT4 X = 0; X < numDetectors; X ++ )
+        {
+          XLAL_CHECK_FAIL ( (ret->data[X] = XLALCalloc ( 1, sizeof ( *ret->data[X] ) )) != NULL, XLAL_ENOMEM );
+          XLAL_CHECK_FAIL ( (ret->data[X]->DeltaT = XLALCreateREAL8Vector ( batch->data[X].numSteps )) != NULL, XLAL_EFUNC );
+          XLAL_CHECK_FAIL ( (ret->data[X]->Tdot = XLALCreateREAL8Vector ( batch->data[X].numSteps )) != NULL, XLAL_EFUNC );
+        }
+      (*multiSSB) = ret;
+    }
+  else
+    {
+      XLAL_CHECK ( ret->length == numDetectors, XLAL_EINVAL, "Number of detectors in 'multiSSB' differ %d != %d\n", ret->length, numDetectors );
+      for ( UINT4 X = 0; X < numDetectors; X ++ )
+        {
+          XLAL_CHECK ( ret->data[X]->DeltaT->length == batch->data[X].numSteps, XLAL_EINVAL );
+          XLAL_CHECK ( ret->data[X]->Tdot->length == batch->data[X].numSteps, XLAL_EINVAL );
+        }
+    }
+
+  REAL8 refTimeREAL8 = XLALGPSGetREAL8 ( &refTime );
+
+  for ( UINT4 X = 0; X < numDetectors; X ++ )
+    {
+      const SSBtimesBatch *batchX = &batch->data[X];
+      SSBtimes *ssbX = ret->data[X];
+      ssbX->refTime = refTime;
+
+      // compute emission-time offsets deltaT = te - t_i, and their derivatives
+      XLAL_CHECK ( XLALBarycenterBatch ( ssbX->DeltaT->data, ssbX->Tdot->data, batchX->bary, skypos.longitude, skypos.latitude, 0, numThreads ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+      // convert to DeltaT = te - T_0, rounding te to nanoseconds as in XLALBarycenterOpt()
+      for ( UINT4 i = 0; i < batchX->numSteps; i++ )
+        {
+          const LIGOTimeGPS *ti = &batchX->tGPS[i];
+          REAL8 deltaT = ssbX->DeltaT->data[i];
+          INT4 deltaTint = floor ( deltaT );
+          LIGOTimeGPS te;
+          if ( ( 1e-9 * ti->gpsNanoSeconds + deltaT - deltaTint ) >= 1.e0 )
+            {
+              te.gpsSeconds     = ti->gpsSeconds + deltaTint + 1;
+              te.gpsNanoSeconds = floor ( 1e9 * ( ti->gpsNanoSeconds * 1e-9 + deltaT - deltaTint - 1.0 ) );
+            }
+          else
+            {
+              te.gpsSeconds     = ti->gpsSeconds + deltaTint;
+              te.gpsNanoSeconds = floor ( 1e9 * ( ti->gpsNanoSeconds * 1e-9 + deltaT - deltaTint ) );
+            }
+          ssbX->DeltaT->data[i] = XLALGPSGetREAL8 ( &te ) - refTimeREAL8;
+        } /* for i < numSteps */
+
+    } /* for X < numDetectors */
+
+  return XLAL_SUCCESS;
+
+XLAL_FAIL:
+  // only reached while allocating the output, before it is returned in (*multiSSB)
+  XLALDestroyMultiSSBtimes ( ret );
+  return XLAL_FAILURE;
+
+} /* XLALGetMultiSSBtimesBatch() */
+
+/** Destroy a MultiSSBtimesBatch structure.
+ * Note, this is "NULL-robust" in the sense that it will not crash
+ * on NULL-entries anywhere in this struct, so it can be used
+ * for failure-cleanup even on incomplete structs
+ */
+void
+XLALDestroyMultiSSBtimesBatch ( MultiSSBtimesBatch *batch )
+{
+  if ( ! batch )
+    return;
+
+  if ( batch->data )
+    {
+      for ( UINT4 X = 0; X < batch->length; X ++ )
+        {
+          XLALFree ( batch->data[X].tGPS );
+          XLALDestroyBarycenterBatch ( batch->data[X].bary );
+        }
+      XLALFree ( batch->data );
+    }
+
+  XLALFree ( batch );
+
+  return;
+
+} /* XLALDestroyMultiSSBtimesBatch() */
+
 /** Find the earliest timestamp in a multi-SSB data structure
  *
 */
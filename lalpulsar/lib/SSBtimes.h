@@ -69,6 +69,9 @@ typedef struct tagMultiSSBtimes {
   SSBtimes **data;	/**< array of SSBtimes (pointers) */
 } MultiSSBtimes;
 
+/** Opaque buffer of sky-independent SSB-timing quantities for all detectors, used to compute SSB times for many sky positions */
+typedef struct tagMultiSSBtimesBatch MultiSSBtimesBatch;
+
 /*---------- exported Global variables ----------*/
 
 /*---------- exported prototypes [API] ----------*/
@@ -80,6 +83,12 @@ MultiSSBtimes *XLALDuplicateMultiSSBtimes ( const MultiSSBtimes *multiSSB );
 SSBtimes *XLALGetSSBtimes ( const DetectorStateSeries *DetectorStates, SkyPosition pos, LIGOTimeGPS refTime, SSBprecision precision );
 MultiSSBtimes *XLALGetMultiSSBtimes ( const MultiDetectorStateSeries *multiDetStates, SkyPosition skypos, LIGOTimeGPS refTime, SSBprecision precision);
 
+#ifndef SWIG // exclude from SWIG interface; only useful from C
+MultiSSBtimesBatch *XLALCreateMultiSSBtimesBatch ( const MultiDetectorStateSeries *multiDetStates );
+int XLALGetMultiSSBtimesBatch ( MultiSSBtimes **multiSSB, const MultiSSBtimesBatch *batch, SkyPosition skypos, LIGOTimeGPS refTime, UINT4 numThreads );
+void XLALDestroyMultiSSBtimesBatch ( MultiSSBtimesBatch *batch );
+#endif
+
 int XLALEarliestMultiSSBtime ( LIGOTimeGPS *out, const MultiSSBtimes *multiSSB, const REAL8 Tsft );
 int XLALLatestMultiSSBtime ( LIGOTimeGPS *out, const MultiSSBtimes *multiSSB,  const REAL8 Tsft );
 
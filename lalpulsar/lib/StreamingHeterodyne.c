@@ -0,0 +1,558 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+#include <math.h>
+#include <string.h>
+#include <complex.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <lal/StreamingHeterodyne.h>
+#include <lal/HeterodynedPulsarModel.h>
+#include <lal/SFTutils.h>
+#include <lal/VectorMath.h>
+#include <lal/Window.h>
+#include <lal/Sequence.h>
+#include <lal/TimeSeries.h>
+#include <lal/Date.h>
+
+/* number of samples whose mixing phases are evaluated together */
+#define STREAMHET_BLOCK_LENGTH 1024
+
+/* minimum number of input samples in a span of the cubic phase approximation */
+#define STREAMHET_MIN_SPAN 8
+
+/* cubic approximation of the heterodyne phase over one span */
+typedef struct tagStreamingHeterodyneSpan {
+  REAL8 phase0;           /* fractional phase in cycles at the start of the span */
+  REAL8 coeff[3];         /* coefficients of powers 1, 2, 3 of the time since the start of the span */
+} StreamingHeterodyneSpan;
+
+/* per-pulsar state of a streaming heterodyne */
+typedef struct tagStreamingHeterodynePulsar {
+  PulsarParameters *pars; /* pulsar parameters (not owned) */
+  UINT4 spanSamples;      /* number of input samples per span */
+  INT8 firstSpan;         /* index of the first span in 'spans' */
+  UINT4 maxSpans;         /* allocated length of 'spans' */
+  StreamingHeterodyneSpan *spans;
+  REAL8 *mixRe;           /* real part of mixed samples not yet consumed by the filter */
+  REAL8 *mixIm;           /* imaginary part of mixed samples not yet consumed by the filter */
+  REAL4VectorAligned *phase, *sinPhase, *cosPhase; /* workspace for one block of mixing phases */
+} StreamingHeterodynePulsar;
+
+struct tagStreamingHeterodyne {
+  UINT4 numPulsars;
+  StreamingHeterodynePulsar *pulsars;
+  LALDetector detector;
+  const EphemerisData *ephem;
+  const TimeCorrectionData *tdat;
+  TimeCorrectionType ttype;
+  REAL8 deltaT;           /* sampling time of input data */
+  UINT4 decimation;       /* ratio of output to input sampling time */
+  StreamingHeterodyneOptionalArgs args;
+  UINT4 halfTaps;         /* half-length of the filter, in input samples */
+  REAL8 *taps;            /* 2*halfTaps + 1 filter coefficients */
+  BOOLEAN started;        /* whether a segment of contiguous data has been started */
+  LIGOTimeGPS segStart;   /* start time of the current segment */
+  INT8 nextSample;        /* index in the segment of the next expected input sample */
+  INT8 bufStart;          /* index in the segment of the first sample in the mixing buffers */
+  UINT4 bufLength;        /* number of samples in the mixing buffers */
+  UINT4 bufMax;           /* allocated length of the mixing buffers */
+  INT8 nextOutput;        /* index in the segment of the next output sample, in units of the decimation */
+};
+
+const StreamingHeterodyneOptionalArgs StreamingHeterodyneOptionalArgsDefaults = {
+  .freqFactor = 2.0,
+  .spanLength = 600.0,
+  .maxPhaseError = 1e-4,
+  .filterHalfLength = 16,
+  .filterCutoff = 0.8,
+  .filterKaiserBeta = 6.0,
+  .numThreads = 1
+};
+
+/* ---------- internal prototypes ---------- */
+static int StreamingHeterodyneSpans( StreamingHeterodyne *het, StreamingHeterodynePulsar *psr, const INT8 first, const INT8 last );
+static int StreamingHeterodyneFitSpans( StreamingHeterodyne *het, StreamingHeterodynePulsar *psr, const INT8 k0, const UINT4 numSpans, REAL8 *maxError );
+static int StreamingHeterodyneMix( const StreamingHeterodyne *het, StreamingHeterodynePulsar *psr, const REAL8 *data, const INT8 n0, const UINT4 length );
+
+
+/**
+ * \brief Create a streaming heterodyne for a set of pulsars
+ *
+ * The pulsar parameters are not copied, and must remain valid for the lifetime of the returned structure; the
+ * same holds for the ephemeris and time correction data.
+ *
+ * \param pulsars [in] Array of pulsar parameters, e.g. from XLALReadTEMPOParFile()
+ * \param numPulsars [in] Number of pulsars
+ * \param detector [in] The detector whose data will be heterodyned
+ * \param ephem [in] Solar system ephemeris data
+ * \param tdat [in] Time correction data
+ * \param ttype [in] The type of time system corrections to perform
+ * \param deltaT [in] Sampling time of the input data
+ * \param decimation [in] Ratio of the output to the input sampling time
+ * \param optArgs [in] Optional arguments; if NULL, use \c StreamingHeterodyneOptionalArgsDefaults
+ *
+ * \return The streaming heterodyne structure
+ */
+StreamingHeterodyne *XLALCreateStreamingHeterodyne( PulsarParameters **pulsars,
+                                                    const UINT4 numPulsars,
+                                                    const LALDetector *detector,
+                                                    const EphemerisData *ephem,
+                                                    const TimeCorrectionData *tdat,
+                                                    const TimeCorrectionType ttype,
+                                                    const REAL8 deltaT,
+                                                    const UINT4 decimation,
+                                                    const StreamingHeterodyneOptionalArgs *optArgs ){
+  /* check inputs */
+  XLAL_CHECK_NULL( pulsars != NULL, XLAL_EFAULT, "pulsars must not be NULL" );
+  XLAL_CHECK_NULL( numPulsars > 0, XLAL_EINVAL, "numPulsars must be greater than zero" );
+  for ( UINT4 p = 0; p < numPulsars; p++ ){
+    XLAL_CHECK_NULL( pulsars[p] != NULL, XLAL_EFAULT, "PulsarParameters %u must not be NULL", p );
+    XLAL_CHECK_NULL( PulsarCheckParam( pulsars[p], "F" ), XLAL_EINVAL, "No frequencies given for pulsar %u", p );
+  }
+  XLAL_CHECK_NULL( detector != NULL, XLAL_EFAULT, "LALDetector must not be NULL" );
+  XLAL_CHECK_NULL( ephem != NULL, XLAL_EFAULT, "EphemerisData must not be NULL" );
+  XLAL_CHECK_NULL( tdat != NULL, XLAL_EFAULT, "TimeCorrectionData must not be NULL" );
+  XLAL_CHECK_NULL( deltaT > 0., XLAL_EINVAL, "deltaT must be greater than zero" );
+  XLAL_CHECK_NULL( decimation > 0, XLAL_EINVAL, "decimation must be greater than zero" );
+
+  const StreamingHeterodyneOptionalArgs *args = ( optArgs != NULL ) ? optArgs : &StreamingHeterodyneOptionalArgsDefaults;
+  XLAL_CHECK_NULL( args->freqFactor > 0., XLAL_EINVAL, "freqFactor must be greater than zero" );
+  XLAL_CHECK_NULL( args->spanLength > 0., XLAL_EINVAL, "spanLength must be greater than zero" );
+  XLAL_CHECK_NULL( args->maxPhaseError > 0., XLAL_EINVAL, "maxPhaseError must be greater than zero" );
+  XLAL_CHECK_NULL( args->filterHalfLength > 0, XLAL_EINVAL, "filterHalfLength must be greater than zero" );
+  XLAL_CHECK_NULL( args->filterCutoff > 0. && args->filterCutoff <= 1., XLAL_EINVAL, "filterCutoff must be in (0, 1]" );
+  XLAL_CHECK_NULL( args->filterKaiserBeta >= 0., XLAL_EINVAL, "filterKaiserBeta must not be negative" );
+
+  StreamingHeterodyne *het = XLALCalloc( 1, sizeof(*het) );
+  XLAL_CHECK_NULL( het != NULL, XLAL_ENOMEM );
+  het->numPulsars = numPulsars;
+  het->detector = *detector;
+  het->ephem = ephem;
+  het->tdat = tdat;
+  het->ttype = ttype;
+  het->deltaT = deltaT;
+  het->decimation = decimation;
+  het->args = *args;
+
+  /* Kaiser-windowed sinc anti-aliasing filter, normalised to unit gain at zero frequency */
+  het->halfTaps = args->filterHalfLength * decimation;
+  const UINT4 numTaps = 2 * het->halfTaps + 1;
+  het->taps = XLALCalloc( numTaps, sizeof(REAL8) );
+  XLAL_CHECK_NULL( het->taps != NULL, XLAL_ENOMEM );
+  REAL8Window *window = XLALCreateKaiserREAL8Window( numTaps, args->filterKaiserBeta );
+  XLAL_CHECK_NULL( window != NULL, XLAL_EFUNC );
+  const REAL8 fc = 0.5 * args->filterCutoff / decimation; /* cut-off frequency in cycles per input sample */
+  REAL8 sum = 0.;
+  for ( UINT4 k = 0; k < numTaps; k++ ){
+    const REAL8 x = (REAL8)k - (REAL8)het->halfTaps;
+    const REAL8 h = ( x == 0. ) ? 2. * fc : sin( LAL_TWOPI * fc * x ) / ( LAL_PI * x );
+    het->taps[k] = h * window->data->data[k];
+    sum += het->taps[k];
+  }
+  for ( UINT4 k = 0; k < numTaps; k++ ){ het->taps[k] /= sum; }
+  XLALDestroyREAL8Window( window );
+
+  /* per-pulsar state */
+  UINT4 spanSamples = (UINT4) round( args->spanLength / deltaT );
+  if ( spanSamples < STREAMHET_MIN_SPAN ){ spanSamples = STREAMHET_MIN_SPAN; }
+  het->pulsars = XLALCalloc( numPulsars, sizeof(het->pulsars[0]) );
+  XLAL_CHECK_NULL( het->pulsars != NULL, XLAL_ENOMEM );
+  for ( UINT4 p = 0; p < numPulsars; p++ ){
+    StreamingHeterodynePulsar *psr = &het->pulsars[p];
+    psr->pars = pulsars[p];
+    psr->spanSamples = spanSamples;
+    psr->phase = XLALCreateREAL4VectorAligned( STREAMHET_BLOCK_LENGTH, 32 );
+    psr->sinPhase = XLALCreateREAL4VectorAligned( STREAMHET_BLOCK_LENGTH, 32 );
+    psr->cosPhase = XLALCreateREAL4VectorAligned( STREAMHET_BLOCK_LENGTH, 32 );
+    if ( psr->phase == NULL || psr->sinPhase == NULL || psr->cosPhase == NULL ){
+      XLALDestroyStreamingHeterodyne( het );
+      XLAL_ERROR_NULL( XLAL_EFUNC );
+    }
+  }
+
+  return het;
+}
+
+
+/**
+ * \brief Free a streaming heterodyne structure
+ */
+void XLALDestroyStreamingHeterodyne( StreamingHeterodyne *het ){
+  if ( het == NULL ){ return; }
+
+  if ( het->pulsars != NULL ){
+    for ( UINT4 p = 0; p < het->numPulsars; p++ ){
+      StreamingHeterodynePulsar *psr = &het->pulsars[p];
+      XLALFree( psr->spans );
+      XLALFree( psr->mixRe );
+      XLALFree( psr->mixIm );
+      XLALDestroyREAL4VectorAligned( psr->phase );
+      XLALDestroyREAL4VectorAligned( psr->sinPhase );
+      XLALDestroyREAL4VectorAligned( psr->cosPhase );
+    }
+    XLALFree( het->pulsars );
+  }
+  XLALFree( het->taps );
+  XLALFree( het );
+}
+
+
+/**
+ * \brief Discard the filter state of a streaming heterodyne
+ *
+ * The next call to XLALStreamingHeterodyneProcess() starts a new contiguous segment of data, which may begin at any
+ * time after the end of the previous segment, e.g. after a gap in science-mode data.
+ */
+int XLALStreamingHeterodyneReset( StreamingHeterodyne *het ){
+  XLAL_CHECK( het != NULL, XLAL_EFAULT, "StreamingHeterodyne must not be NULL" );
+  het->started = 0;
+  return XLAL_SUCCESS;
+}
+
+
+/**
+ * \brief Heterodyne and decimate a chunk of data for all pulsars
+ *
+ * The chunk must directly follow the chunk passed to the previous call, unless this is the first call or
+ * XLALStreamingHeterodyneReset() has been called since. The decimated output samples which are completed by this
+ * chunk are returned in \c outputs[p] for pulsar \c p; a \c NULL element is allocated, otherwise the time series is
+ * resized. There may be no output samples, e.g. if the chunk is shorter than the decimation.
+ *
+ * \param het [in] The streaming heterodyne structure
+ * \param outputs [out] Array of heterodyned and decimated time series, one per pulsar
+ * \param data [in] A chunk of detector data
+ *
+ * \return \c XLAL_SUCCESS on success
+ */
+int XLALStreamingHeterodyneProcess( StreamingHeterodyne *het,
+                                    COMPLEX16TimeSeries **outputs,
+                                    const REAL8TimeSeries *data ){
+  /* check inputs */
+  XLAL_CHECK( het != NULL, XLAL_EFAULT, "StreamingHeterodyne must not be NULL" );
+  XLAL_CHECK( outputs != NULL, XLAL_EFAULT, "outputs must not be NULL" );
+  XLAL_CHECK( data != NULL && data->data != NULL, XLAL_EFAULT, "data must not be NULL" );
+  XLAL_CHECK( fabs( data->deltaT - het->deltaT ) <= 1e-9 * het->deltaT, XLAL_EINVAL,
+              "Sampling time of data (%g) does not match that of heterodyne (%g)", data->deltaT, het->deltaT );
+
+  const UINT4 length = data->data->length;
+  const UINT4 R = het->decimation;
+
+  /* start a new segment, or check that the data are contiguous with the current segment */
+  if ( !het->started ){
+    het->started = 1;
+    het->segStart = data->epoch;
+    het->nextSample = 0;
+    het->bufStart = 0;
+    het->bufLength = 0;
+    het->nextOutput = het->args.filterHalfLength;
+  }
+  else{
+    LIGOTimeGPS expected = het->segStart;
+    XLALGPSAdd( &expected, het->nextSample * het->deltaT );
+    const REAL8 mismatch = XLALGPSDiff( &data->epoch, &expected );
+    XLAL_CHECK( fabs( mismatch ) <= 0.01 * het->deltaT, XLAL_EINVAL,
+                "Data starting at %d.%09d do not follow on from previous data (expected %d.%09d); call XLALStreamingHeterodyneReset() to start a new segment",
+                data->epoch.gpsSeconds, data->epoch.gpsNanoSeconds, expected.gpsSeconds, expected.gpsNanoSeconds );
+  }
+  const INT8 n0 = het->nextSample;
+
+  /* number of output samples whose filter support is complete after this chunk */
+  const INT8 lastAvail = n0 + length - 1 - het->halfTaps;
+  UINT4 numOut = 0;
+  if ( lastAvail >= 0 && lastAvail / R >= het->nextOutput ){ numOut = lastAvail / R - het->nextOutput + 1; }
+
+  /* prepare output time series */
+  LIGOTimeGPS outEpoch = het->segStart;
+  XLALGPSAdd( &outEpoch, het->nextOutput * R * het->deltaT );
+  for ( UINT4 p = 0; p < het->numPulsars; p++ ){
+    if ( outputs[p] == NULL ){
+      outputs[p] = XLALCreateCOMPLEX16TimeSeries( "heterodyned", &outEpoch, 0., R * het->deltaT, &data->sampleUnits, numOut );
+      XLAL_CHECK( outputs[p] != NULL, XLAL_EFUNC );
+    }
+    else{
+      XLAL_CHECK( XLALResizeCOMPLEX16Sequence( outputs[p]->data, 0, numOut ) != NULL, XLAL_EFUNC );
+      outputs[p]->epoch = outEpoch;
+      outputs[p]->deltaT = R * het->deltaT;
+      outputs[p]->f0 = 0.;
+      outputs[p]->sampleUnits = data->sampleUnits;
+    }
+  }
+  if ( length == 0 ){ return XLAL_SUCCESS; }
+
+  /* grow mixing buffers */
+  if ( het->bufLength + length > het->bufMax ){
+    het->bufMax = het->bufLength + length;
+    for ( UINT4 p = 0; p < het->numPulsars; p++ ){
+      StreamingHeterodynePulsar *psr = &het->pulsars[p];
+      XLAL_CHECK( ( psr->mixRe = XLALRealloc( psr->mixRe, het->bufMax * sizeof(REAL8) ) ) != NULL, XLAL_ENOMEM );
+      XLAL_CHECK( ( psr->mixIm = XLALRealloc( psr->mixIm, het->bufMax * sizeof(REAL8) ) ) != NULL, XLAL_ENOMEM );
+    }
+  }
+
+  /* cubic phase approximations covering this chunk; computed serially, as the barycentring routines are not thread-safe */
+  for ( UINT4 p = 0; p < het->numPulsars; p++ ){
+    XLAL_CHECK( StreamingHeterodyneSpans( het, &het->pulsars[p], n0, n0 + length - 1 ) == XLAL_SUCCESS, XLAL_EFUNC,
+                "Failed to approximate phase of pulsar %u", p );
+  }
+
+  /* number of samples which are no longer needed after this chunk */
+  INT8 drop = ( het->nextOutput + numOut ) * R - het->halfTaps - het->bufStart;
+  if ( drop < 0 ){ drop = 0; }
+
+  UINT4 numThreads = het->args.numThreads;
+#ifdef _OPENMP
+  if ( numThreads == 0 ) {
+    numThreads = omp_get_max_threads();
+  }
+#else
+  (void) numThreads;
+  numThreads = 1;
+#endif
+
+  /* mix, filter and decimate each pulsar */
+  const UINT4 numTaps = 2 * het->halfTaps + 1;
+  const REAL8 *taps = het->taps;
+  int errnum = 0;
+#pragma omp parallel for schedule(dynamic) num_threads(numThreads)
+  for ( UINT4 p = 0; p < het->numPulsars; p++ ){
+    StreamingHeterodynePulsar *psr = &het->pulsars[p];
+    if ( StreamingHeterodyneMix( het, psr, data->data->data, n0, length ) != XLAL_SUCCESS ){
+#pragma omp critical (XLALStreamingHeterodyneProcess)
+      errnum = XLAL_EFUNC;
+      continue;
+    }
+
+    COMPLEX16 *out = outputs[p]->data->data;
+    for ( UINT4 m = 0; m < numOut; m++ ){
+      const INT8 first = ( het->nextOutput + m ) * R - het->halfTaps - het->bufStart;
+      const REAL8 *xRe = psr->mixRe + first;
+      const REAL8 *xIm = psr->mixIm + first;
+      REAL8 sumRe = 0., sumIm = 0.;
+      for ( UINT4 k = 0; k < numTaps; k++ ){
+        sumRe += taps[k] * xRe[k];
+        sumIm += taps[k] * xIm[k];
+      }
+      out[m] = crect( sumRe, sumIm );
+    }
+
+    if ( drop > 0 ){
+      memmove( psr->mixRe, psr->mixRe + drop, ( het->bufLength + length - drop ) * sizeof(REAL8) );
+      memmove( psr->mixIm, psr->mixIm + drop, ( het->bufLength + length - drop ) * sizeof(REAL8) );
+    }
+  }
+  XLAL_CHECK( errnum == 0, errnum, "StreamingHeterodyneMix() failed" );
+
+  het->nextSample += length;
+  het->nextOutput += numOut;
+  het->bufLength += length - drop;
+  het->bufStart += drop;
+
+  return XLAL_SUCCESS;
+}
+
+
+/**
+ * Mix a chunk of data, starting at segment index \c n0, with the heterodyne phase of one pulsar, and append the
+ * result to its mixing buffers.
+ */
+static int StreamingHeterodyneMix( const StreamingHeterodyne *het,
+                                   StreamingHeterodynePulsar *psr,
+                                   const REAL8 *data,
+                                   const INT8 n0,
+                                   const UINT4 length ){
+  const REAL8 dt = het->deltaT;
+  const INT8 S = psr->spanSamples;
+  REAL4 *phase = psr->phase->data;
+  REAL4 *sinPhase = psr->sinPhase->data;
+  REAL4 *cosPhase = psr->cosPhase->data;
+  REAL8 *mixRe = psr->mixRe + het->bufLength;
+  REAL8 *mixIm = psr->mixIm + het->bufLength;
+
+  for ( UINT4 b = 0; b < length; b += STREAMHET_BLOCK_LENGTH ){
+    const UINT4 blockLength = ( length - b < STREAMHET_BLOCK_LENGTH ) ? ( length - b ) : STREAMHET_BLOCK_LENGTH;
+
+    /* fractional phases of this block, one run of samples within the same span at a time */
+    INT8 k = ( n0 + b ) / S;
+    INT8 j = n0 + b - k * S;
+    UINT4 i = 0;
+    while ( i < blockLength ){
+      const UINT4 run = ( blockLength - i < S - j ) ? ( blockLength - i ) : (UINT4)( S - j );
+      const StreamingHeterodyneSpan *span = &psr->spans[k - psr->firstSpan];
+      const REAL8 phase0 = span->phase0, c1 = span->coeff[0], c2 = span->coeff[1], c3 = span->coeff[2];
+      for ( UINT4 r = 0; r < run; r++ ){
+        const REAL8 u = ( j + r ) * dt;
+        const REAL8 ph = phase0 + u * ( c1 + u * ( c2 + u * c3 ) );
+        phase[i + r] = (REAL4)( ph - floor( ph ) );
+      }
+      i += run;
+      j += run;
+      if ( j == S ){
+        j = 0;
+        k++;
+      }
+    }
+
+    XLAL_CHECK( XLALVectorSinCos2PiREAL4( sinPhase, cosPhase, phase, blockLength ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    /* multiply by exp(-2 pi i phase) */
+    for ( UINT4 r = 0; r < blockLength; r++ ){
+      mixRe[b + r] = data[b + r] * cosPhase[r];
+      mixIm[b + r] = -data[b + r] * sinPhase[r];
+    }
+  }
+
+  return XLAL_SUCCESS;
+}
+
+
+/**
+ * Compute the cubic phase approximations of one pulsar over all spans containing the segment indices \c first to
+ * \c last, halving the span length until the approximation error is within tolerance.
+ */
+static int StreamingHeterodyneSpans( StreamingHeterodyne *het,
+                                     StreamingHeterodynePulsar *psr,
+                                     const INT8 first,
+                                     const INT8 last ){
+  while ( 1 ){
+    const INT8 S = psr->spanSamples;
+    const INT8 k0 = first / S;
+    const UINT4 numSpans = last / S - k0 + 1;
+    if ( numSpans > psr->maxSpans ){
+      XLAL_CHECK( ( psr->spans = XLALRealloc( psr->spans, numSpans * sizeof(psr->spans[0]) ) ) != NULL, XLAL_ENOMEM );
+      psr->maxSpans = numSpans;
+    }
+
+    REAL8 maxError = 0.;
+    XLAL_CHECK( StreamingHeterodyneFitSpans( het, psr, k0, numSpans, &maxError ) == XLAL_SUCCESS, XLAL_EFUNC );
+    psr->firstSpan = k0;
+    if ( maxError <= het->args.maxPhaseError ){ break; }
+
+    XLAL_CHECK( psr->spanSamples / 2 >= STREAMHET_MIN_SPAN, XLAL_ETOL,
+                "Phase approximation error %g cycles exceeds tolerance %g cycles with the minimum span of %u samples",
+                maxError, het->args.maxPhaseError, psr->spanSamples );
+    psr->spanSamples /= 2;
+  }
+
+  return XLAL_SUCCESS;
+}
+
+
+/**
+ * Fit cubic polynomials to the heterodyne phase over \c numSpans spans starting with span \c k0, and return the
+ * maximum difference between the polynomials and the timing model at the span mid-points.
+ *
+ * The timing model is evaluated at 0, 1/3, 1/2, 2/3 and 1 of each span. The phase at the start of each span is
+ * stored modulo one, and the phase differences within the span are computed directly from the differences in
+ * emission time, so that they do not lose precision to the large absolute phase.
+ */
+static int StreamingHeterodyneFitSpans( StreamingHeterodyne *het,
+                                        StreamingHeterodynePulsar *psr,
+                                        const INT8 k0,
+                                        const UINT4 numSpans,
+                                        REAL8 *maxError ){
+  static const REAL8 nodeFrac[4] = { 0., 1. / 3., 0.5, 2. / 3. };
+  const UINT4 numNodes = 4 * numSpans + 1;
+  const REAL8 L = psr->spanSamples * het->deltaT;
+  const REAL8 ff = het->args.freqFactor;
+
+  /* times of the nodes */
+  LIGOTimeGPSVector *times = XLALCreateTimestampVector( numNodes );
+  XLAL_CHECK( times != NULL, XLAL_EFUNC );
+  REAL8 *offsets = XLALCalloc( numNodes, sizeof(REAL8) );
+  XLAL_CHECK( offsets != NULL, XLAL_ENOMEM );
+  for ( UINT4 i = 0; i < numNodes; i++ ){
+    const UINT4 s = i / 4;
+    offsets[i] = ( ( k0 + s ) * psr->spanSamples ) * het->deltaT + ( ( i == 4 * numSpans ) ? 0. : nodeFrac[i % 4] * L );
+    times->data[i] = het->segStart;
+    XLALGPSAdd( &times->data[i], offsets[i] );
+  }
+
+  /* timing model at the nodes */
+  REAL8Vector *ssb = NULL, *bsb = NULL, *glph = NULL, *fwph = NULL;
+  XLAL_CHECK( ( ssb = XLALHeterodynedPulsarGetSSBDelay( psr->pars, times, &het->detector, het->ephem, het->tdat, het->ttype ) ) != NULL, XLAL_EFUNC );
+  XLAL_CHECK( ( bsb = XLALHeterodynedPulsarGetBSBDelay( psr->pars, times, ssb, het->ephem ) ) != NULL, XLAL_EFUNC );
+  XLAL_CHECK( ( glph = XLALHeterodynedPulsarGetGlitchPhase( psr->pars, times, ssb, bsb ) ) != NULL, XLAL_EFUNC );
+  const REAL8Vector *freqs = PulsarGetREAL8VectorParam( psr->pars, "F" );
+  XLAL_CHECK( ( fwph = XLALHeterodynedPulsarGetFITWAVESPhase( psr->pars, times, ssb, freqs->data[0] ) ) != NULL, XLAL_EFUNC );
+
+  LIGOTimeGPS pepoch;
+  XLALGPSSetREAL8( &pepoch, PulsarGetREAL8ParamOrZero( psr->pars, "PEPOCH" ) );
+
+  *maxError = 0.;
+  for ( UINT4 s = 0; s < numSpans; s++ ){
+    const UINT4 i0 = 4 * s;
+    const REAL8 T0 = XLALGPSDiff( &times->data[i0], &pepoch ) + ssb->data[i0] + bsb->data[i0];
+
+    /* fractional phase at the start of the span */
+    REAL8 phase0 = ff * ( glph->data[i0] + fwph->data[i0] );
+    phase0 -= floor( phase0 );
+    REAL8 Tpow = T0, fact = 1.;
+    for ( UINT4 j = 0; j < freqs->length; j++ ){
+      fact *= ( j + 1 );
+      REAL8 term = ff * freqs->data[j] * Tpow / fact;
+      phase0 += term - floor( term );
+      Tpow *= T0;
+    }
+    psr->spans[s].phase0 = phase0 - floor( phase0 );
+
+    /* phase differences from the start of the span at 1/3, 1/2, 2/3 and 1 of the span */
+    REAL8 y[4];
+    for ( UINT4 n = 0; n < 4; n++ ){
+      const UINT4 i1 = i0 + n + 1;
+      const REAL8 T1 = XLALGPSDiff( &times->data[i1], &pepoch ) + ssb->data[i1] + bsb->data[i1];
+      const REAL8 dT = ( offsets[i1] - offsets[i0] ) + ( ssb->data[i1] - ssb->data[i0] ) + ( bsb->data[i1] - bsb->data[i0] );
+      REAL8 dphi = ( glph->data[i1] - glph->data[i0] ) + ( fwph->data[i1] - fwph->data[i0] );
+      REAL8 psum = 0., T1pow = 1.;
+      fact = 1.;
+      for ( UINT4 j = 0; j < freqs->length; j++ ){
+        /* T1^(j+1) - T0^(j+1) = dT * sum_{m=0}^{j} T1^(j-m) T0^m */
+        psum = psum * T0 + T1pow;
+        T1pow *= T1;
+        fact *= ( j + 1 );
+        dphi += freqs->data[j] * dT * psum / fact;
+      }
+      y[n] = ff * dphi;
+    }
+
+    /* cubic through the phase differences at 0, 1/3, 2/3 and 1 of the span, in units of 1/3 of the span */
+    const REAL8 d1 = y[0];
+    const REAL8 d2 = y[2] - 2. * y[0];
+    const REAL8 d3 = y[3] - 3. * y[2] + 3. * y[0];
+    const REAL8 a1 = d1 - 0.5 * d2 + d3 / 3.;
+    const REAL8 a2 = 0.5 * ( d2 - d3 );
+    const REAL8 a3 = d3 / 6.;
+    const REAL8 err = fabs( a1 * 1.5 + a2 * 2.25 + a3 * 3.375 - y[1] );
+    if ( err > *maxError ){ *maxError = err; }
+    const REAL8 h = L / 3.;
+    psr->spans[s].coeff[0] = a1 / h;
+    psr->spans[s].coeff[1] = a2 / ( h * h );
+    psr->spans[s].coeff[2] = a3 / ( h * h * h );
+  }
+
+  XLALDestroyTimestampVector( times );
+  XLALFree( offsets );
+  XLALDestroyREAL8Vector( ssb );
+  XLALDestroyREAL8Vector( bsb );
+  XLALDestroyREAL8Vector( glph );
+  XLALDestroyREAL8Vector( fwph );
+
+  return XLAL_SUCCESS;
+}
@@ -0,0 +1,102 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+#ifndef _STREAMINGHETERODYNE_H
+#define _STREAMINGHETERODYNE_H
+
+#include <lal/LALStdlib.h>
+#include <lal/LALDatatypes.h>
+#include <lal/LALDetectors.h>
+#include <lal/LALBarycenter.h>
+#include <lal/ReadPulsarParFile.h>
+
+/* C++ protection. */
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup StreamingHeterodyne_h Header StreamingHeterodyne.h
+ * \ingroup lalpulsar_general
+ *
+ * \brief Streaming heterodyne and decimation of detector data for many targeted pulsars at once.
+ *
+ * Data are passed to XLALStreamingHeterodyneProcess() in contiguous chunks of any length. Each chunk is read once,
+ * and for every pulsar is multiplied by \f$e^{-2\pi i \Phi(t)}\f$, where \f$\Phi(t)\f$ is the pulsar phase (times
+ * the frequency factor) at the detector, then low-pass filtered and decimated. The filter state is kept between
+ * chunks, so that the output does not depend on how the data are divided into chunks.
+ *
+ * Instead of barycentring every sample, \f$\Phi(t)\f$ is approximated by a cubic polynomial over spans of length
+ * \c StreamingHeterodyneOptionalArgs.spanLength. Each cubic interpolates the full timing model (solar system and
+ * binary system delays, glitches and FITWAVES, as computed by XLALHeterodynedPulsarGetSSBDelay() and related
+ * functions) at four points of the span, and is checked against the timing model at the span mid-point; if the
+ * difference exceeds \c StreamingHeterodyneOptionalArgs.maxPhaseError, the spans of that pulsar are halved until it
+ * does not. The mixing phases are evaluated in blocks and their sines and cosines computed with
+ * XLALVectorSinCos2PiREAL4(), which uses SIMD instructions where available.
+ *
+ * The anti-aliasing filter is a Kaiser-windowed sinc, and is evaluated only at the decimated output samples, i.e.
+ * as a polyphase decimator. It is centred on each output sample, so that the output has no group delay; as a
+ * consequence, the first and last \c StreamingHeterodyneOptionalArgs.filterHalfLength output samples of each
+ * contiguous segment of data are not produced.
+ */
+/** @{ */
+
+/** Opaque structure holding the state of a streaming heterodyne */
+typedef struct tagStreamingHeterodyne StreamingHeterodyne;
+
+/** Optional arguments to XLALCreateStreamingHeterodyne() */
+typedef struct tagStreamingHeterodyneOptionalArgs {
+  REAL8 freqFactor;		/**< Multiple of the pulsar rotation frequency at which to heterodyne */
+  REAL8 spanLength;		/**< Initial length in seconds of the spans over which the phase is approximated by a cubic polynomial */
+  REAL8 maxPhaseError;		/**< Maximum allowed error in cycles of the cubic phase approximation */
+  UINT4 filterHalfLength;	/**< Half-length of the anti-aliasing filter, in output samples */
+  REAL8 filterCutoff;		/**< Cut-off frequency of the anti-aliasing filter, as a fraction of the output Nyquist frequency */
+  REAL8 filterKaiserBeta;	/**< Kaiser window parameter of the anti-aliasing filter */
+  UINT4 numThreads;		/**< Number of threads over which pulsars are split: 1 = serial; 0 = OpenMP default number of threads */
+} StreamingHeterodyneOptionalArgs;
+
+/** Global initializer for setting \c StreamingHeterodyneOptionalArgs to default values */
+extern const StreamingHeterodyneOptionalArgs StreamingHeterodyneOptionalArgsDefaults;
+
+/* ---------- Function prototypes ---------- */
+
+StreamingHeterodyne *XLALCreateStreamingHeterodyne( PulsarParameters **pulsars,
+                                                    const UINT4 numPulsars,
+                                                    const LALDetector *detector,
+                                                    const EphemerisData *ephem,
+                                                    const TimeCorrectionData *tdat,
+                                                    const TimeCorrectionType ttype,
+                                                    const REAL8 deltaT,
+                                                    const UINT4 decimation,
+                                                    const StreamingHeterodyneOptionalArgs *optArgs );
+
+void XLALDestroyStreamingHeterodyne( StreamingHeterodyne *het );
+
+int XLALStreamingHeterodyneReset( StreamingHeterodyne *het );
+
+int XLALStreamingHeterodyneProcess( StreamingHeterodyne *het,
+                                    COMPLEX16TimeSeries **outputs,
+                                    const REAL8TimeSeries *data );
+
+/** @} */
+
+#ifdef  __cplusplus
+}
+#endif
+/* C++ protection. */
+
+#endif
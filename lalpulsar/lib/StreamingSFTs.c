@@ -0,0 +1,652 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+// ---------- includes
+#include <math.h>
+#include <string.h>
+#include <complex.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <fftw3.h>
+
+#include <lal/StreamingSFTs.h>
+#include <lal/SFTfileIO.h>
+#include <lal/Window.h>
+#include <lal/ZPGFilter.h>
+#include <lal/IIRFilter.h>
+#include <lal/FFTWMutex.h>
+#include <lal/LALString.h>
+#include <lal/Date.h>
+
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+#endif
+
+// ---------- local defines
+#define STREAMSFT_HIGHPASS_BLOCK	65536		// number of samples passed through all high-pass filter sections at once
+#define STREAMSFT_BATCH_BYTES		( 32 << 20 )	// approximate memory per thread of automatically-sized FFT batches
+
+// ---------- local type definitions
+struct tagStreamingSFTs {
+  REAL8 deltaT;			// sampling time of input data
+  REAL8 Tsft;			// SFT duration
+  UINT4 sftLength;		// number of samples per SFT
+  UINT4 sftStride;		// number of samples between the starts of consecutive SFTs
+  UINT4 firstBin;		// index of first frequency bin stored in SFTs
+  UINT4 numBins;		// number of frequency bins stored in SFTs
+  StreamingSFTsOptionalArgs args;	// optional arguments, with strings owned by this struct
+  UINT4 numFilters;		// number of high-pass filter sections
+  REAL8IIRFilter **filters;	// high-pass filter sections
+  REAL8Window *window;		// window applied to SFT data, or NULL
+  REAL8 norm;			// SFTv2 normalisation of FFT output
+  UINT4 numThreads;		// number of threads
+  UINT4 batchSize;		// number of SFTs per FFT batch
+  fftw_plan plan;		// FFTW plan for one batch of SFTs
+  double **fftIn;		// per-thread FFT input arrays, of length batchSize * sftLength
+  fftw_complex **fftOut;	// per-thread FFT output arrays, of length batchSize * ( sftLength/2 + 1 )
+  BOOLEAN started;		// whether a segment of contiguous data has been started
+  CHAR name[LALNameLength];	// detector prefix of the data of the current segment
+  LIGOTimeGPS segStart;		// start time of the current segment
+  INT8 nextSample;		// index in the segment of the next expected input sample
+  INT8 nextSFT;			// index in the segment of the first sample of the next SFT
+  INT8 bufStart;		// index in the segment of the first sample in 'buf'
+  UINT4 bufLength;		// number of high-passed samples in 'buf'
+  UINT4 bufMax;			// allocated length of 'buf'
+  REAL8 *buf;			// high-passed samples not yet used by all SFTs
+  UINT8 numSFTs;		// number of SFTs completed since creation
+  SFTVector **writeQueue;	// circular queue of SFT vectors waiting to be written by the writer thread, or NULL
+  UINT4 writeQueueHead;		// index in 'writeQueue' of the next SFT vector to write
+  UINT4 writeQueueCount;	// number of SFT vectors in 'writeQueue'
+  UINT4 writeQueueSFTs;		// total number of SFTs in 'writeQueue'
+#ifdef LAL_PTHREAD_LOCK
+  pthread_t writer;		// writer thread
+  pthread_mutex_t writeLock;	// lock on the write queue and the fields below
+  pthread_cond_t writeCond;	// signalled whenever the write queue changes
+  BOOLEAN writeStop;		// whether the writer thread should stop once the write queue is empty
+  int writeErrnum;		// error number of the first failed write, or 0
+#endif
+};
+
+// ---------- Global variables
+const StreamingSFTsOptionalArgs StreamingSFTsOptionalArgsDefaults = {
+  .overlapFraction = 0,
+  .highPassFreq = 0,
+  .highPassOrder = 10,
+  .windowType = "tukey",
+  .windowBeta = 0.001,
+  .fMin = 0,
+  .Band = 0,
+  .batchSize = 0,
+  .numThreads = 1,
+  .writeQueueLength = 0,
+  .outputDir = NULL,
+  .SFTcomment = NULL,
+  .Misc = NULL,
+};
+
+// ---------- local prototypes
+static int CreateHighPassFilter ( StreamingSFTs *stream );
+static int ComputeSFTBatch ( const StreamingSFTs *stream, SFTVector *sfts, const UINT4 first, const UINT4 length, const UINT4 thread );
+#ifdef LAL_PTHREAD_LOCK
+static int StartWriterThread ( StreamingSFTs *stream );
+static int QueueSFTsForWriting ( StreamingSFTs *stream, SFTVector *sfts );
+static void *WriterThread ( void *arg );
+#endif
+
+// ==================== function definitions ====================
+
+///
+/// Create a structure for streaming creation of SFTs of duration \a Tsft from data sampled at \a deltaT.
+///
+StreamingSFTs *
+XLALCreateStreamingSFTs ( const REAL8 deltaT,				///< [in] Sampling time of the input data
+                          const REAL8 Tsft,				///< [in] Duration of each SFT
+                          const StreamingSFTsOptionalArgs *optArgs	///< [in] Optional arguments; if NULL, use \c StreamingSFTsOptionalArgsDefaults
+                          )
+{
+  XLAL_CHECK_NULL ( deltaT > 0, XLAL_EINVAL, "Invalid non-positive deltaT = %g\n", deltaT );
+  XLAL_CHECK_NULL ( Tsft > 0, XLAL_EINVAL, "Invalid non-positive Tsft = %g\n", Tsft );
+
+  const StreamingSFTsOptionalArgs *args = ( optArgs != NULL ) ? optArgs : &StreamingSFTsOptionalArgsDefaults;
+  XLAL_CHECK_NULL ( args->overlapFraction >= 0 && args->overlapFraction < 1, XLAL_EINVAL, "Invalid overlapFraction = %g, must be in [0, 1)\n", args->overlapFraction );
+  XLAL_CHECK_NULL ( args->highPassFreq >= 0 && args->highPassFreq < 0.5 / deltaT, XLAL_EINVAL, "Invalid highPassFreq = %g, must be in [0, %g)\n", args->highPassFreq, 0.5 / deltaT );
+  XLAL_CHECK_NULL ( args->highPassFreq == 0 || args->highPassOrder > 0, XLAL_EINVAL, "Invalid zero highPassOrder\n" );
+  XLAL_CHECK_NULL ( args->fMin >= 0 && args->Band >= 0, XLAL_EINVAL, "Invalid negative fMin = %g or Band = %g\n", args->fMin, args->Band );
+
+  // make sure that number of samples per SFT is an integer
+  const REAL8 sftLength0 = Tsft / deltaT;
+  const UINT4 sftLength = lround ( sftLength0 );
+  XLAL_CHECK_NULL ( sftLength > 1 && fabs ( sftLength0 - sftLength ) / sftLength0 < 10 * LAL_REAL8_EPS, XLAL_EINVAL,
+                    "Inconsistent sampling-step (deltaT=%g) and Tsft=%g: must be integer multiple Tsft/deltaT = %g\n", deltaT, Tsft, sftLength0 );
+
+  StreamingSFTs *stream;
+  XLAL_CHECK_NULL ( ( stream = XLALCalloc ( 1, sizeof(*stream) ) ) != NULL, XLAL_ENOMEM );
+  stream->deltaT = deltaT;
+  stream->Tsft = Tsft;
+  stream->sftLength = sftLength;
+  stream->sftStride = lround ( ( 1.0 - args->overlapFraction ) * sftLength );
+  if ( stream->sftStride == 0 ) {
+    stream->sftStride = 1;
+  }
+  stream->args = *args;
+  stream->args.windowType = NULL;
+  stream->args.outputDir = NULL;
+  stream->args.SFTcomment = NULL;
+  stream->args.Misc = NULL;
+  if ( args->outputDir != NULL ) {
+    XLAL_CHECK_FAIL ( ( stream->args.outputDir = XLALStringDuplicate ( args->outputDir ) ) != NULL, XLAL_EFUNC );
+  }
+  if ( args->SFTcomment != NULL ) {
+    XLAL_CHECK_FAIL ( ( stream->args.SFTcomment = XLALStringDuplicate ( args->SFTcomment ) ) != NULL, XLAL_EFUNC );
+  }
+  if ( args->Misc != NULL ) {
+    XLAL_CHECK_FAIL ( ( stream->args.Misc = XLALStringDuplicate ( args->Misc ) ) != NULL, XLAL_EFUNC );
+  }
+
+  // frequency bins to store in SFTs
+  const UINT4 numFFTBins = sftLength / 2 + 1;
+  if ( args->Band > 0 ) {
+    XLAL_CHECK_FAIL ( XLALFindCoveringSFTBins ( &stream->firstBin, &stream->numBins, args->fMin, args->Band, Tsft ) == XLAL_SUCCESS, XLAL_EFUNC );
+  } else {
+    stream->firstBin = lround ( args->fMin * Tsft );
+    stream->numBins = ( stream->firstBin < numFFTBins ) ? numFFTBins - stream->firstBin : 0;
+  }
+  XLAL_CHECK_FAIL ( stream->numBins > 0 && stream->firstBin + stream->numBins <= numFFTBins, XLAL_EINVAL,
+                    "Requested frequency band [%g, %g) Hz is not contained within the SFT band [0, %g] Hz\n", args->fMin, args->fMin + args->Band, 0.5 / deltaT );
+
+  // high-pass filter
+  XLAL_CHECK_FAIL ( CreateHighPassFilter ( stream ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // window function, and SFTv2 normalisation of FFT output, i.e. multiply DFT by (dt/sigma{window})
+  stream->norm = deltaT;
+  if ( args->windowType != NULL ) {
+    XLAL_CHECK_FAIL ( ( stream->window = XLALCreateNamedREAL8Window ( args->windowType, args->windowBeta, sftLength ) ) != NULL, XLAL_EFUNC );
+    stream->norm /= sqrt ( stream->window->sumofsquares / stream->window->data->length );
+  }
+
+  // number of threads
+  stream->numThreads = args->numThreads;
+#ifdef _OPENMP
+  if ( stream->numThreads == 0 ) {
+    stream->numThreads = omp_get_max_threads();
+  }
+#else
+  stream->numThreads = 1;
+#endif
+
+  // batched FFT plan, and per-thread FFT arrays
+  stream->batchSize = args->batchSize;
+  if ( stream->batchSize == 0 ) {
+    const size_t bytesPerSFT = sftLength * sizeof(double) + numFFTBins * sizeof(fftw_complex);
+    stream->batchSize = ( bytesPerSFT < STREAMSFT_BATCH_BYTES ) ? STREAMSFT_BATCH_BYTES / bytesPerSFT : 1;
+  }
+  XLAL_CHECK_FAIL ( ( stream->fftIn = XLALCalloc ( stream->numThreads, sizeof(stream->fftIn[0]) ) ) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK_FAIL ( ( stream->fftOut = XLALCalloc ( stream->numThreads, sizeof(stream->fftOut[0]) ) ) != NULL, XLAL_ENOMEM );
+  for ( UINT4 t = 0; t < stream->numThreads; ++t ) {
+    XLAL_CHECK_FAIL ( ( stream->fftIn[t] = fftw_malloc ( stream->batchSize * sftLength * sizeof(double) ) ) != NULL, XLAL_ENOMEM );
+    XLAL_CHECK_FAIL ( ( stream->fftOut[t] = fftw_malloc ( stream->batchSize * numFFTBins * sizeof(fftw_complex) ) ) != NULL, XLAL_ENOMEM );
+    memset ( stream->fftIn[t], 0, stream->batchSize * sftLength * sizeof(double) );
+  }
+  const int n = sftLength;
+  LAL_FFTW_WISDOM_LOCK;
+  stream->plan = fftw_plan_many_dft_r2c ( 1, &n, stream->batchSize, stream->fftIn[0], NULL, 1, sftLength, stream->fftOut[0], NULL, 1, numFFTBins, FFTW_ESTIMATE );
+  LAL_FFTW_WISDOM_UNLOCK;
+  XLAL_CHECK_FAIL ( stream->plan != NULL, XLAL_EFUNC, "fftw_plan_many_dft_r2c() failed\n" );
+
+  // writer thread; without pthreads, SFTs are written by the threads which transform them
+#ifdef LAL_PTHREAD_LOCK
+  if ( stream->args.outputDir != NULL && args->writeQueueLength > 0 ) {
+    XLAL_CHECK_FAIL ( StartWriterThread ( stream ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+#endif
+
+  return stream;
+
+XLAL_FAIL:
+  XLALDestroyStreamingSFTs ( stream );
+  return NULL;
+
+} // XLALCreateStreamingSFTs()
+
+///
+/// Destroy a streaming SFT creation structure
+///
+void
+XLALDestroyStreamingSFTs ( StreamingSFTs *stream )
+{
+  if ( stream == NULL ) {
+    return;
+  }
+#ifdef LAL_PTHREAD_LOCK
+  // writer thread writes any queued SFTs before stopping; call XLALStreamingSFTsFlush() first to check for errors
+  if ( stream->writeQueue != NULL ) {
+    pthread_mutex_lock ( &stream->writeLock );
+    stream->writeStop = 1;
+    pthread_cond_broadcast ( &stream->writeCond );
+    pthread_mutex_unlock ( &stream->writeLock );
+    pthread_join ( stream->writer, NULL );
+    pthread_cond_destroy ( &stream->writeCond );
+    pthread_mutex_destroy ( &stream->writeLock );
+    XLALFree ( stream->writeQueue );
+  }
+#endif
+  if ( stream->plan != NULL ) {
+    LAL_FFTW_WISDOM_LOCK;
+    fftw_destroy_plan ( stream->plan );
+    LAL_FFTW_WISDOM_UNLOCK;
+  }
+  for ( UINT4 t = 0; t < stream->numThreads; ++t ) {
+    if ( stream->fftIn != NULL ) {
+      fftw_free ( stream->fftIn[t] );
+    }
+    if ( stream->fftOut != NULL ) {
+      fftw_free ( stream->fftOut[t] );
+    }
+  }
+  XLALFree ( stream->fftIn );
+  XLALFree ( stream->fftOut );
+  if ( stream->filters != NULL ) {
+    for ( UINT4 f = 0; f < stream->numFilters; ++f ) {
+      XLALDestroyREAL8IIRFilter ( stream->filters[f] );
+    }
+  }
+  XLALFree ( stream->filters );
+  XLALDestroyREAL8Window ( stream->window );
+  XLALFree ( stream->buf );
+  XLALFree ( ( char * ) stream->args.outputDir );
+  XLALFree ( ( char * ) stream->args.SFTcomment );
+  XLALFree ( ( char * ) stream->args.Misc );
+  XLALFree ( stream );
+} // XLALDestroyStreamingSFTs()
+
+///
+/// Reset a streaming SFT creation structure, discarding any partial SFT and the high-pass filter state; the next
+/// data passed to XLALStreamingSFTsProcess() start a new contiguous segment.
+///
+int
+XLALStreamingSFTsReset ( StreamingSFTs *stream )
+{
+  XLAL_CHECK ( stream != NULL, XLAL_EFAULT );
+  for ( UINT4 f = 0; f < stream->numFilters; ++f ) {
+    memset ( stream->filters[f]->history->data, 0, stream->filters[f]->history->length * sizeof(stream->filters[f]->history->data[0]) );
+  }
+  stream->started = 0;
+  stream->nextSample = stream->nextSFT = stream->bufStart = 0;
+  stream->bufLength = 0;
+  return XLAL_SUCCESS;
+} // XLALStreamingSFTsReset()
+
+///
+/// Pass a chunk of data to a streaming SFT creation structure, and return all SFTs completed by it.
+///
+/// On return, <tt>*outputSFTs</tt> holds the SFTs completed by this chunk, which may be none; any SFT vector
+/// previously held in <tt>*outputSFTs</tt> is destroyed. If \a outputSFTs is NULL, SFTs are only written to files;
+/// with a writer thread, this saves copying them.
+///
+int
+XLALStreamingSFTsProcess ( StreamingSFTs *stream,		///< [in] Streaming SFT creation structure
+                           SFTVector **outputSFTs,		///< [out] SFTs completed by this chunk of data; may be NULL
+                           const REAL8TimeSeries *data		///< [in] Chunk of data
+                           )
+{
+  XLAL_CHECK ( stream != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( data != NULL && data->data != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( fabs ( data->deltaT - stream->deltaT ) <= 10 * LAL_REAL8_EPS * stream->deltaT, XLAL_EINVAL,
+               "Sampling time of data (%g) differs from that of stream (%g)\n", data->deltaT, stream->deltaT );
+  XLAL_CHECK ( data->f0 == 0, XLAL_EINVAL, "Heterodyned data (f0 = %g) are not supported\n", data->f0 );
+
+  // start a new segment if data do not follow on from the previous chunk
+  if ( stream->started ) {
+    const REAL8 offset = XLALGPSDiff ( &data->epoch, &stream->segStart ) / stream->deltaT;
+    if ( fabs ( offset - stream->nextSample ) > 1e-3 ) {
+      XLAL_CHECK ( XLALStreamingSFTsReset ( stream ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+  }
+  if ( !stream->started ) {
+    stream->started = 1;
+    stream->segStart = data->epoch;
+    // SFTs are named by detector prefix, i.e. the part of a channel name such as 'H1:GDS-CALIB_STRAIN' before the colon
+    memcpy ( stream->name, data->name, sizeof(stream->name) );
+    stream->name[sizeof(stream->name) - 1] = '\0';
+    char *colon = strchr ( stream->name, ':' );
+    if ( colon != NULL ) {
+      *colon = '\0';
+    }
+  }
+
+  // append data to buffer
+  const UINT4 length = data->data->length;
+  if ( stream->bufLength + length > stream->bufMax ) {
+    stream->bufMax = stream->bufLength + length;
+    XLAL_CHECK ( ( stream->buf = XLALRealloc ( stream->buf, stream->bufMax * sizeof(stream->buf[0]) ) ) != NULL, XLAL_ENOMEM );
+  }
+  REAL8 *newData = stream->buf + stream->bufLength;
+  memcpy ( newData, data->data->data, length * sizeof(newData[0]) );
+
+  // high-pass new data in blocks, passing each block through all filter sections while it is in cache
+  for ( UINT4 i = 0; i < length && stream->numFilters > 0; i += STREAMSFT_HIGHPASS_BLOCK ) {
+    REAL8Vector block = { .length = ( length - i < STREAMSFT_HIGHPASS_BLOCK ) ? length - i : STREAMSFT_HIGHPASS_BLOCK, .data = newData + i };
+    for ( UINT4 f = 0; f < stream->numFilters; ++f ) {
+      XLAL_CHECK ( XLALIIRFilterREAL8Vector ( &block, stream->filters[f] ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+  }
+  stream->bufLength += length;
+  stream->nextSample += length;
+
+  // count SFTs completed by this chunk
+  UINT4 numSFTs = 0;
+  while ( stream->nextSFT + ( (INT8) numSFTs ) * stream->sftStride + stream->sftLength <= stream->bufStart + stream->bufLength ) {
+    ++numSFTs;
+  }
+
+  // create output SFTs
+  SFTVector *sfts = NULL;
+  if ( numSFTs > 0 ) {
+    XLAL_CHECK ( ( sfts = XLALCreateSFTVector ( numSFTs, stream->numBins ) ) != NULL, XLAL_EFUNC );
+  } else {
+    XLAL_CHECK ( ( sfts = XLALCalloc ( 1, sizeof(*sfts) ) ) != NULL, XLAL_ENOMEM );
+  }
+
+  // compute SFTs in batches, distributed over threads
+  const UINT4 numBatches = ( numSFTs + stream->batchSize - 1 ) / stream->batchSize;
+  int errnum = 0;
+#pragma omp parallel for schedule(dynamic) num_threads(stream->numThreads)
+  for ( UINT4 b = 0; b < numBatches; ++b ) {
+#ifdef _OPENMP
+    const UINT4 thread = omp_get_thread_num();
+#else
+    const UINT4 thread = 0;
+#endif
+    const UINT4 first = b * stream->batchSize;
+    const UINT4 batchLength = ( numSFTs - first < stream->batchSize ) ? numSFTs - first : stream->batchSize;
+    if ( ComputeSFTBatch ( stream, sfts, first, batchLength, thread ) != XLAL_SUCCESS ) {
+#pragma omp critical (XLALStreamingSFTsProcess)
+      {
+        errnum = xlalErrno;
+      }
+    }
+  }
+  if ( errnum != 0 ) {
+    XLALDestroySFTVector ( sfts );
+    XLAL_ERROR ( errnum, "Failed to compute SFTs\n" );
+  }
+
+  // discard samples no longer needed by any SFT
+  stream->numSFTs += numSFTs;
+  stream->nextSFT += ( (INT8) numSFTs ) * stream->sftStride;
+  const UINT4 numDiscard = stream->nextSFT - stream->bufStart;
+  memmove ( stream->buf, stream->buf + numDiscard, ( stream->bufLength - numDiscard ) * sizeof(stream->buf[0]) );
+  stream->bufLength -= numDiscard;
+  stream->bufStart += numDiscard;
+
+  // hand SFTs over to the writer thread, keeping a copy if they are also returned
+#ifdef LAL_PTHREAD_LOCK
+  if ( stream->writeQueue != NULL && numSFTs > 0 ) {
+    SFTVector *queued = sfts;
+    if ( outputSFTs != NULL ) {
+      if ( ( queued = XLALDuplicateSFTVector ( sfts ) ) == NULL ) {
+        XLALDestroySFTVector ( sfts );
+        XLAL_ERROR ( XLAL_EFUNC );
+      }
+    } else {
+      sfts = NULL;
+    }
+    if ( QueueSFTsForWriting ( stream, queued ) != XLAL_SUCCESS ) {
+      XLALDestroySFTVector ( sfts );
+      XLAL_ERROR ( XLAL_EFUNC );
+    }
+  }
+#endif
+
+  // return SFTs
+  if ( outputSFTs != NULL ) {
+    XLALDestroySFTVector ( *outputSFTs );
+    *outputSFTs = sfts;
+  } else {
+    XLALDestroySFTVector ( sfts );
+  }
+
+  return XLAL_SUCCESS;
+
+} // XLALStreamingSFTsProcess()
+
+///
+/// Return the number of SFTs completed by all data passed to XLALStreamingSFTsProcess() since creation
+///
+UINT8
+XLALStreamingSFTsCount ( const StreamingSFTs *stream )
+{
+  XLAL_CHECK_VAL ( 0, stream != NULL, XLAL_EFAULT );
+  return stream->numSFTs;
+} // XLALStreamingSFTsCount()
+
+///
+/// Wait until all SFTs queued by XLALStreamingSFTsProcess() have been written to files by the writer thread, and
+/// return an error if any of them could not be written. Does nothing if there is no writer thread.
+///
+int
+XLALStreamingSFTsFlush ( StreamingSFTs *stream )
+{
+  XLAL_CHECK ( stream != NULL, XLAL_EFAULT );
+#ifdef LAL_PTHREAD_LOCK
+  if ( stream->writeQueue != NULL ) {
+    pthread_mutex_lock ( &stream->writeLock );
+    while ( stream->writeQueueCount > 0 ) {
+      pthread_cond_wait ( &stream->writeCond, &stream->writeLock );
+    }
+    const int errnum = stream->writeErrnum;
+    stream->writeErrnum = 0;
+    pthread_mutex_unlock ( &stream->writeLock );
+    XLAL_CHECK ( errnum == 0, errnum, "Failed to write SFTs to directory '%s'\n", stream->args.outputDir );
+  }
+#endif
+  return XLAL_SUCCESS;
+} // XLALStreamingSFTsFlush()
+
+///
+/// Create the sections of a causal Butterworth high-pass filter, following the design used by XLALButterworthREAL8TimeSeries()
+///
+static int
+CreateHighPassFilter ( StreamingSFTs *stream )
+{
+  const UINT4 order = stream->args.highPassOrder;
+  if ( stream->args.highPassFreq == 0 ) {
+    return XLAL_SUCCESS;
+  }
+
+  // an order-n Butterworth filter has n poles spaced evenly along a semicircle in the upper complex w-plane; pairing
+  // up poles symmetric across the imaginary axis gives [n/2] filter sections of order 2, plus perhaps one of order 1
+  const REAL8 wc = tan ( LAL_PI * stream->args.highPassFreq * stream->deltaT );
+  stream->numFilters = ( order + 1 ) / 2;
+  XLAL_CHECK ( ( stream->filters = XLALCalloc ( stream->numFilters, sizeof(stream->filters[0]) ) ) != NULL, XLAL_ENOMEM );
+  for ( UINT4 f = 0; f < stream->numFilters; ++f ) {
+    const UINT4 i = f, j = order - 1 - f;
+    COMPLEX16ZPGFilter *zpg = NULL;
+    if ( i < j ) {
+      const REAL8 theta = LAL_PI * ( i + 0.5 ) / order;
+      XLAL_CHECK ( ( zpg = XLALCreateCOMPLEX16ZPGFilter ( 2, 2 ) ) != NULL, XLAL_EFUNC );
+      zpg->zeros->data[0] = zpg->zeros->data[1] = 0;
+      zpg->poles->data[0] = wc * cos ( theta ) + I * wc * sin ( theta );
+      zpg->poles->data[1] = -wc * cos ( theta ) + I * wc * sin ( theta );
+    } else {
+      XLAL_CHECK ( ( zpg = XLALCreateCOMPLEX16ZPGFilter ( 1, 1 ) ) != NULL, XLAL_EFUNC );
+      zpg->zeros->data[0] = 0;
+      zpg->poles->data[0] = I * wc;
+    }
+    zpg->gain = 1;
+    if ( XLALWToZCOMPLEX16ZPGFilter ( zpg ) != XLAL_SUCCESS || ( stream->filters[f] = XLALCreateREAL8IIRFilter ( zpg ) ) == NULL ) {
+      XLALDestroyCOMPLEX16ZPGFilter ( zpg );
+      XLAL_ERROR ( XLAL_EFUNC );
+    }
+    XLALDestroyCOMPLEX16ZPGFilter ( zpg );
+  }
+
+  return XLAL_SUCCESS;
+
+} // CreateHighPassFilter()
+
+///
+/// Window, Fourier transform, and normalise one batch of SFTs, and write them to files if requested
+///
+static int
+ComputeSFTBatch ( const StreamingSFTs *stream, SFTVector *sfts, const UINT4 first, const UINT4 length, const UINT4 thread )
+{
+  const UINT4 sftLength = stream->sftLength;
+  const UINT4 numFFTBins = sftLength / 2 + 1;
+  double *in = stream->fftIn[thread];
+  fftw_complex *out = stream->fftOut[thread];
+
+  // copy windowed data of each SFT into FFT input array
+  for ( UINT4 j = 0; j < length; ++j ) {
+    const REAL8 *sftData = stream->buf + ( stream->nextSFT + ( (INT8) ( first + j ) ) * stream->sftStride - stream->bufStart );
+    double *sftIn = in + ( (size_t) j ) * sftLength;
+    if ( stream->window != NULL ) {
+      const REAL8 *win = stream->window->data->data;
+      for ( UINT4 k = 0; k < sftLength; ++k ) {
+        sftIn[k] = win[k] * sftData[k];
+      }
+    } else {
+      memcpy ( sftIn, sftData, sftLength * sizeof(sftIn[0]) );
+    }
+  }
+
+  // Fourier transform the whole batch; executing a plan on new arrays is thread-safe
+  fftw_execute_dft_r2c ( stream->plan, in, out );
+
+  // fill SFT headers and normalised data
+  const REAL8 df = 1.0 / stream->Tsft;
+  for ( UINT4 j = 0; j < length; ++j ) {
+    SFTtype *sft = &sfts->data[first + j];
+    memcpy ( sft->name, stream->name, sizeof(sft->name) );
+    sft->epoch = stream->segStart;
+    XLALGPSAdd ( &sft->epoch, ( stream->nextSFT + ( (INT8) ( first + j ) ) * stream->sftStride ) * stream->deltaT );
+    sft->f0 = stream->firstBin * df;
+    sft->deltaF = df;
+    const fftw_complex *sftOut = out + ( (size_t) j ) * numFFTBins + stream->firstBin;
+    for ( UINT4 k = 0; k < stream->numBins; ++k ) {
+      sft->data->data[k] = (COMPLEX8) ( stream->norm * sftOut[k] );
+    }
+  }
+
+  // write SFTs to files, unless this is done by the writer thread
+  if ( stream->args.outputDir != NULL && stream->writeQueue == NULL ) {
+    SFTVector batch = { .length = length, .data = &sfts->data[first] };
+    XLAL_CHECK ( XLALWriteSFTVector2Dir ( &batch, stream->args.outputDir, stream->args.SFTcomment, stream->args.Misc ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  return XLAL_SUCCESS;
+
+} // ComputeSFTBatch()
+
+#ifdef LAL_PTHREAD_LOCK
+
+///
+/// Create the write queue and its lock, and start the writer thread
+///
+static int
+StartWriterThread ( StreamingSFTs *stream )
+{
+  // the queue never holds more SFT vectors than SFTs, and never more SFTs than 'writeQueueLength' unless it holds a single vector
+  XLAL_CHECK ( ( stream->writeQueue = XLALCalloc ( stream->args.writeQueueLength, sizeof(stream->writeQueue[0]) ) ) != NULL, XLAL_ENOMEM );
+  int err = pthread_mutex_init ( &stream->writeLock, NULL );
+  if ( err == 0 ) {
+    if ( ( err = pthread_cond_init ( &stream->writeCond, NULL ) ) == 0 ) {
+      if ( ( err = pthread_create ( &stream->writer, NULL, WriterThread, stream ) ) == 0 ) {
+        return XLAL_SUCCESS;
+      }
+      pthread_cond_destroy ( &stream->writeCond );
+    }
+    pthread_mutex_destroy ( &stream->writeLock );
+  }
+  XLALFree ( stream->writeQueue );
+  stream->writeQueue = NULL;
+  XLAL_ERROR ( XLAL_ESYS, "Failed to start writer thread: %s\n", strerror ( err ) );
+} // StartWriterThread()
+
+///
+/// Append a vector of SFTs to the write queue, taking ownership of it; blocks while the queue is full, and returns
+/// an error, without queuing the SFTs, if a previous write failed
+///
+static int
+QueueSFTsForWriting ( StreamingSFTs *stream, SFTVector *sfts )
+{
+  pthread_mutex_lock ( &stream->writeLock );
+  while ( stream->writeErrnum == 0 && stream->writeQueueSFTs > 0 && stream->writeQueueSFTs + sfts->length > stream->args.writeQueueLength ) {
+    pthread_cond_wait ( &stream->writeCond, &stream->writeLock );
+  }
+  const int errnum = stream->writeErrnum;
+  if ( errnum == 0 ) {
+    const UINT4 tail = ( stream->writeQueueHead + stream->writeQueueCount ) % stream->args.writeQueueLength;
+    stream->writeQueue[tail] = sfts;
+    ++stream->writeQueueCount;
+    stream->writeQueueSFTs += sfts->length;
+    pthread_cond_broadcast ( &stream->writeCond );
+  } else {
+    stream->writeErrnum = 0;
+  }
+  pthread_mutex_unlock ( &stream->writeLock );
+  if ( errnum != 0 ) {
+    XLALDestroySFTVector ( sfts );
+    XLAL_ERROR ( errnum, "Failed to write SFTs to directory '%s'\n", stream->args.outputDir );
+  }
+  return XLAL_SUCCESS;
+} // QueueSFTsForWriting()
+
+///
+/// Writer thread: write and destroy queued SFT vectors in order, until told to stop and the write queue is empty
+///
+static void *
+WriterThread ( void *arg )
+{
+  StreamingSFTs *stream = ( StreamingSFTs * ) arg;
+  pthread_mutex_lock ( &stream->writeLock );
+  while ( 1 ) {
+    while ( stream->writeQueueCount == 0 && !stream->writeStop ) {
+      pthread_cond_wait ( &stream->writeCond, &stream->writeLock );
+    }
+    if ( stream->writeQueueCount == 0 ) {
+      break;
+    }
+    SFTVector *sfts = stream->writeQueue[stream->writeQueueHead];
+    const UINT4 numSFTs = sfts->length;
+    pthread_mutex_unlock ( &stream->writeLock );
+
+    // write without holding the lock; XLAL error numbers are thread-local when LAL is built with pthreads
+    int errnum = 0;
+    if ( XLALWriteSFTVector2Dir ( sfts, stream->args.outputDir, stream->args.SFTcomment, stream->args.Misc ) != XLAL_SUCCESS ) {
+      errnum = xlalErrno;
+      XLALClearErrno();
+    }
+    XLALDestroySFTVector ( sfts );
+
+    pthread_mutex_lock ( &stream->writeLock );
+    stream->writeQueueHead = ( stream->writeQueueHead + 1 ) % stream->args.writeQueueLength;
+    --stream->writeQueueCount;
+    stream->writeQueueSFTs -= numSFTs;
+    if ( errnum != 0 && stream->writeErrnum == 0 ) {
+      stream->writeErrnum = errnum;
+    }
+    pthread_cond_broadcast ( &stream->writeCond );
+  }
+  pthread_mutex_unlock ( &stream->writeLock );
+  return NULL;
+} // WriterThread()
+
+#endif // LAL_PTHREAD_LOCK
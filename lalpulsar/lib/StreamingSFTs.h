@@ -0,0 +1,108 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+#ifndef _STREAMINGSFTS_H
+#define _STREAMINGSFTS_H
+
+#include <lal/LALStdlib.h>
+#include <lal/LALDatatypes.h>
+#include <lal/SFTutils.h>
+
+/* C++ protection. */
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup StreamingSFTs_h Header StreamingSFTs.h
+ * \ingroup lalpulsar_sft
+ *
+ * \brief Streaming creation of SFTs from contiguous detector data.
+ *
+ * Data, e.g. as read sequentially from frame files, are passed to XLALStreamingSFTsProcess() in contiguous
+ * chunks of any length; each sample is therefore read only once, even when consecutive SFTs overlap. Each chunk
+ * is high-passed in blocks by a causal Butterworth filter whose state is kept between chunks, so that unlike
+ * filtering each SFT separately there is no start-up transient at the start of every SFT. All SFTs completed by
+ * a chunk are then windowed and Fourier transformed together: each thread transforms a batch of SFTs with a
+ * single FFTW plan, and, if an output directory is given, writes its SFTs to files while other threads are still
+ * transforming theirs.
+ *
+ * If \c writeQueueLength is non-zero and LAL was built with pthreads, SFTs are instead written to files by a
+ * separate writer thread, so that XLALStreamingSFTsProcess() returns as soon as the SFTs of a chunk are transformed,
+ * and the caller can read the next chunk while the SFTs of the previous one are being written. At most
+ * \c writeQueueLength SFTs wait to be written at any time (or all SFTs of one chunk, if more); further calls to
+ * XLALStreamingSFTsProcess() block until enough of them are written. Errors of the writer thread are returned by
+ * the next call to XLALStreamingSFTsProcess() or XLALStreamingSFTsFlush(), which should be called after the last
+ * chunk. Without pthreads, SFTs are always written by the threads which transform them.
+ *
+ * A chunk which does not start where the previous chunk ended starts a new contiguous segment: the filter state
+ * and any partial SFT are discarded, and SFTs of the new segment start at the first sample of the chunk.
+ *
+ * SFTs are normalised following the SFTv2 specification, in the same way as XLALMakeSFTsFromREAL8TimeSeries().
+ *
+ * Batching only helps for short SFTs: an 1800-second SFT of data sampled at 16384 Hz already needs about 450 MB of
+ * FFT arrays, so automatically-sized batches then hold a single SFT, and throughput is that of one FFTW transform
+ * per SFT per thread. The test program StreamingSFTsTest reports the throughput achieved for its short test SFTs, and
+lalapps_StreamSFTs that achieved for frame data.
+ */
+/** @{ */
+
+/** Opaque structure holding the state of streaming SFT creation */
+typedef struct tagStreamingSFTs StreamingSFTs;
+
+/** Optional arguments to XLALCreateStreamingSFTs() */
+typedef struct tagStreamingSFTsOptionalArgs {
+  REAL8 overlapFraction;	/**< Fraction of an SFT by which consecutive SFTs overlap, in [0, 1) */
+  REAL8 highPassFreq;		/**< Knee (-3 dB) frequency in Hz of the high-pass filter; 0 = no high-pass filter */
+  UINT4 highPassOrder;		/**< Order of the Butterworth high-pass filter */
+  const char *windowType;	/**< Window applied to the data of each SFT, see XLALCreateNamedREAL8Window(); NULL = rectangular window */
+  REAL8 windowBeta;		/**< Parameter of the window, if any */
+  REAL8 fMin;			/**< Lowest frequency in Hz to store in SFTs */
+  REAL8 Band;			/**< Frequency band in Hz to store in SFTs; 0 = up to the Nyquist frequency */
+  UINT4 batchSize;		/**< Number of SFTs transformed together by each thread; 0 = as many as fit in a few tens of megabytes */
+  UINT4 numThreads;		/**< Number of threads: 1 = serial; 0 = OpenMP default number of threads */
+  UINT4 writeQueueLength;	/**< Maximum number of SFTs waiting to be written by a separate writer thread; 0 = no writer thread */
+  const char *outputDir;	/**< If not NULL, write each SFT to a file with its official SFT filename in this directory */
+  const char *SFTcomment;	/**< Comment to write to SFT files */
+  const char *Misc;		/**< Misc field of official SFT filenames */
+} StreamingSFTsOptionalArgs;
+
+/** Global initializer for setting \c StreamingSFTsOptionalArgs to default values */
+extern const StreamingSFTsOptionalArgs StreamingSFTsOptionalArgsDefaults;
+
+/* ---------- Function prototypes ---------- */
+
+StreamingSFTs *XLALCreateStreamingSFTs ( const REAL8 deltaT, const REAL8 Tsft, const StreamingSFTsOptionalArgs *optArgs );
+
+void XLALDestroyStreamingSFTs ( StreamingSFTs *stream );
+
+int XLALStreamingSFTsReset ( StreamingSFTs *stream );
+
+int XLALStreamingSFTsProcess ( StreamingSFTs *stream, SFTVector **outputSFTs, const REAL8TimeSeries *data );
+
+int XLALStreamingSFTsFlush ( StreamingSFTs *stream );
+
+UINT8 XLALStreamingSFTsCount ( const StreamingSFTs *stream );
+
+/** @} */
+
+#ifdef  __cplusplus
+}
+#endif
+/* C++ protection. */
+
+#endif
@@ -102,49 +102,68 @@ typedef struct tagSM_CallbackOut {
 } SM_CallbackOut;
 
 ///
-/// Call XLALComputeDopplerPhaseMetric() to compute the phase metric for a given coordinate system.
+/// Call XLALComputeDopplerPhaseMetricSegments() to compute the phase metrics for two given coordinate systems
+/// for each segment. Both metrics are extracted from the metric in the union of the two coordinate systems,
+/// so that detector motion is computed only once.
 ///
-static gsl_matrix *SM_ComputePhaseMetric(
-  const DopplerCoordinateSystem *coords,        ///< [in] Coordinate system to compute metric for
+static int SM_ComputePhaseMetrics(
+  gsl_matrix **metrics_1,                       ///< [out] Metric in 1st coordinate system for each segment
+  gsl_matrix **metrics_2,                       ///< [out] Metric in 2nd coordinate system for each segment
+  const DopplerCoordinateSystem *coords_1,      ///< [in] 1st coordinate system to compute metric for
+  const DopplerCoordinateSystem *coords_2,      ///< [in] 2nd coordinate system to compute metric for
   const LIGOTimeGPS *ref_time,                  ///< [in] Reference time of the metric
-  const LIGOTimeGPS *start_time,                ///< [in] Start time of the metric
-  const LIGOTimeGPS *end_time,                  ///< [in] End time of the metric
+  const LALSegList *segments,                   ///< [in] List of segments to compute metrics for
   const MultiLALDetector *detectors,            ///< [in] List of detectors to average metric over
   const MultiNoiseFloor *detector_weights,      ///< [in] Weights used to combine single-detector metrics (default: unit weights)
   const DetectorMotionType detector_motion,     ///< [in] Which detector motion to use
-  const EphemerisData *ephemerides              ///< [in] Earth/Sun ephemerides
+  const EphemerisData *ephemerides,             ///< [in] Earth/Sun ephemerides
+  const size_t threads                          ///< [in] Number of threads over which segments are distributed (0: OpenMP default)
   )
 {
 
   // Check input
-  XLAL_CHECK_NULL( coords != NULL, XLAL_EFAULT );
-  XLAL_CHECK_NULL( ref_time != NULL, XLAL_EFAULT );
-  XLAL_CHECK_NULL( start_time != NULL, XLAL_EFAULT );
-  XLAL_CHECK_NULL( end_time != NULL, XLAL_EFAULT );
-  XLAL_CHECK_NULL( detectors != NULL, XLAL_EFAULT );
-  XLAL_CHECK_NULL( detectors->length > 0, XLAL_EINVAL );
-  XLAL_CHECK_NULL( detector_motion > 0, XLAL_EINVAL );
-  XLAL_CHECK_NULL( ephemerides != NULL, XLAL_EINVAL );
+  XLAL_CHECK( metrics_1 != NULL, XLAL_EFAULT );
+  XLAL_CHECK( metrics_2 != NULL, XLAL_EFAULT );
+  XLAL_CHECK( coords_1 != NULL, XLAL_EFAULT );
+  XLAL_CHECK( coords_2 != NULL, XLAL_EFAULT );
+  XLAL_CHECK( ref_time != NULL, XLAL_EFAULT );
+  XLAL_CHECK( segments != NULL, XLAL_EFAULT );
+  XLAL_CHECK( detectors != NULL, XLAL_EFAULT );
+  XLAL_CHECK( detectors->length > 0, XLAL_EINVAL );
+  XLAL_CHECK( detector_motion > 0, XLAL_EINVAL );
+  XLAL_CHECK( ephemerides != NULL, XLAL_EINVAL );
 
   // Supersky metric cannot (reliably) be computed for segment lengths <= ~24 hours
-  XLAL_CHECK_NULL( XLALGPSDiff( end_time, start_time ) >= 81000, XLAL_ERANGE, "Supersky metric cannot be computed for segment lengths <= ~24 hours" );
+  for ( size_t n = 0; n < segments->length; ++n ) {
+    XLAL_CHECK( XLALGPSDiff( &segments->segs[n].end, &segments->segs[n].start ) >= 81000, XLAL_ERANGE, "Supersky metric cannot be computed for segment lengths <= ~24 hours" );
+  }
 
-  // Create parameters struct for XLALComputeDopplerPhaseMetric()
+  // Create parameters struct for XLALComputeDopplerPhaseMetricSegments()
   DopplerMetricParams XLAL_INIT_DECL( par );
 
-  // Set coordinate system
-  par.coordSys = *coords;
+  // Set coordinate system to union of both coordinate systems, and record where each coordinate is found
+  size_t idx_1[DOPPLERMETRIC_MAX_DIM], idx_2[DOPPLERMETRIC_MAX_DIM];
+  {
+    const DopplerCoordinateSystem *coords[2] = { coords_1, coords_2 };
+    size_t *idx[2] = { idx_1, idx_2 };
+    for ( size_t c = 0; c < 2; ++c ) {
+      for ( size_t i = 0; i < coords[c]->dim; ++i ) {
+        int j = XLALFindDopplerCoordinateInSystem( &par.coordSys, coords[c]->coordIDs[i] );
+        if ( j < 0 ) {
+          XLAL_CHECK( par.coordSys.dim < DOPPLERMETRIC_MAX_DIM, XLAL_EINVAL, "Too many distinct coordinates" );
+          j = par.coordSys.dim;
+          par.coordSys.coordIDs[par.coordSys.dim++] = coords[c]->coordIDs[i];
+        }
+        idx[c][i] = j;
+      }
+    }
+  }
 
   // Set detector motion type
   par.detMotionType = detector_motion;
 
   // Set segment list
-  LALSegList segments;
-  XLAL_CHECK_NULL( XLALSegListInit( &segments ) == XLAL_SUCCESS, XLAL_EFUNC );
-  LALSeg segment;
-  XLAL_CHECK_NULL( XLALSegSet( &segment, start_time, end_time, 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
-  XLAL_CHECK_NULL( XLALSegListAppend( &segments, &segment ) == XLAL_SUCCESS, XLAL_EFUNC );
-  par.segmentList = segments;
+  par.segmentList = *segments;
 
   // Set detectors and detector weights
   par.multiIFO = *detectors;
@@ -154,9 +173,8 @@ static gsl_matrix *SM_ComputePhaseMetric(
     par.multiNoiseFloor.length = 0;   // Indicates unit weights
   }
 
-  // Set reference time to segment mid-time, to improve stability of numerical calculation of metric
-  par.signalParams.Doppler.refTime = *start_time;
-  XLALGPSAdd( &par.signalParams.Doppler.refTime, 0.5 * XLALGPSDiff( end_time, start_time ) );
+  // Set reference time; XLALComputeDopplerPhaseMetricSegments() computes metric at segment mid-times, to improve stability
+  par.signalParams.Doppler.refTime = *ref_time;
 
   // Set fiducial frequency
   par.signalParams.Doppler.fkdot[0] = fiducial_calc_freq;
@@ -167,20 +185,38 @@ static gsl_matrix *SM_ComputePhaseMetric(
   // Do not include sky-position-dependent Roemer delay in time variable
   par.approxPhase = 1;
 
-  // Call XLALComputeDopplerPhaseMetric() and check output
-  DopplerPhaseMetric *metric = XLALComputeDopplerPhaseMetric( &par, ephemerides );
-  XLAL_CHECK_NULL( metric != NULL && metric->g_ij != NULL, XLAL_EFUNC, "XLALComputeDopplerPhaseMetric() failed" );
+  // Call XLALComputeDopplerPhaseMetricSegments() and check output
+  gsl_matrix **metrics = XLALCalloc( segments->length, sizeof( *metrics ) );
+  XLAL_CHECK( metrics != NULL, XLAL_ENOMEM );
+  if ( XLALComputeDopplerPhaseMetricSegments( metrics, &par, ephemerides, 0, threads ) != XLAL_SUCCESS ) {
+    for ( size_t n = 0; n < segments->length; ++n ) {
+      GFMAT( metrics[n] );
+    }
+    XLALFree( metrics );
+    XLAL_ERROR( XLAL_EFUNC, "XLALComputeDopplerPhaseMetricSegments() failed" );
+  }
 
-  // Extract metric, while transforming its reference time from segment mid-time to time specified by 'ref_time'
-  gsl_matrix *g_ij = NULL;
-  const REAL8 Dtau = XLALGPSDiff( ref_time, &par.signalParams.Doppler.refTime );
-  XLAL_CHECK_NULL( XLALChangeMetricReferenceTime( &g_ij, NULL, metric->g_ij, coords, Dtau ) == XLAL_SUCCESS, XLAL_EFUNC );
+  // Extract metrics in each coordinate system
+  for ( size_t n = 0; n < segments->length; ++n ) {
+    GAMAT( metrics_1[n], coords_1->dim, coords_1->dim );
+    for ( size_t i = 0; i < coords_1->dim; ++i ) {
+      for ( size_t j = 0; j < coords_1->dim; ++j ) {
+        gsl_matrix_set( metrics_1[n], i, j, gsl_matrix_get( metrics[n], idx_1[i], idx_1[j] ) );
+      }
+    }
+    GAMAT( metrics_2[n], coords_2->dim, coords_2->dim );
+    for ( size_t i = 0; i < coords_2->dim; ++i ) {
+      for ( size_t j = 0; j < coords_2->dim; ++j ) {
+        gsl_matrix_set( metrics_2[n], i, j, gsl_matrix_get( metrics[n], idx_2[i], idx_2[j] ) );
+      }
+    }
+    GFMAT( metrics[n] );
+  }
 
   // Cleanup
-  XLALDestroyDopplerPhaseMetric( metric );
-  XLALSegListClear( &segments );
+  XLALFree( metrics );
 
-  return g_ij;
+  return XLAL_SUCCESS;
 
 }
 
@@ -593,7 +629,8 @@ SuperskyMetrics *XLALComputeSuperskyMetrics(
   const MultiLALDetector *detectors,
   const MultiNoiseFloor *detector_weights,
   const DetectorMotionType detector_motion,
-  const EphemerisData *ephemerides
+  const EphemerisData *ephemerides,
+  const size_t threads
   )
 {
 
@@ -656,28 +693,46 @@ SuperskyMetrics *XLALComputeSuperskyMetrics(
   gsl_matrix *GAMAT_NULL( ussky_metric_avg, 4 + spindowns, 4 + spindowns );
   gsl_matrix *GAMAT_NULL( orbital_metric_avg, 3 + spindowns, 3 + spindowns );
 
+  // Compute the unrestricted supersky metric and the orbital metric in ecliptic coordinates for all segments
+  gsl_matrix **ussky_metric_segs = XLALCalloc( metrics->num_segments, sizeof( *ussky_metric_segs ) );
+  XLAL_CHECK_NULL( ussky_metric_segs != NULL, XLAL_ENOMEM );
+  gsl_matrix **orbital_metric_segs = XLALCalloc( metrics->num_segments, sizeof( *orbital_metric_segs ) );
+  XLAL_CHECK_NULL( orbital_metric_segs != NULL, XLAL_ENOMEM );
+  int errnum = 0;
+  XLAL_TRY( SM_ComputePhaseMetrics( ussky_metric_segs, orbital_metric_segs, &ucoords, &ocoords, ref_time, segments, detectors, detector_weights, detector_motion, ephemerides, threads ), errnum );
+  if ( errnum == 0 ) {
+    LogPrintf( LOG_DEBUG, "Computed unrestricted supersky and orbital metrics for %zu segments\n", metrics->num_segments );
+  }
+
   // Compute the coherent supersky metrics for each segment
-  for ( size_t n = 0; n < metrics->num_segments; ++n ) {
+  for ( size_t n = 0; errnum == 0 && n < metrics->num_segments; ++n ) {
     const LIGOTimeGPS *start_time_seg = &segments->segs[n].start;
     const LIGOTimeGPS *end_time_seg = &segments->segs[n].end;
 
-    // Compute the unrestricted supersky metric
-    gsl_matrix *ussky_metric_seg = SM_ComputePhaseMetric( &ucoords, ref_time, start_time_seg, end_time_seg, detectors, detector_weights, detector_motion, ephemerides );
-    XLAL_CHECK_NULL( ussky_metric_seg != NULL, XLAL_EFUNC );
+    // Accumulate the unrestricted supersky metric and the orbital metric
+    gsl_matrix *ussky_metric_seg = ussky_metric_segs[n];
     gsl_matrix_add( ussky_metric_avg, ussky_metric_seg );
-
-    // Compute the orbital metric in ecliptic coordinates
-    gsl_matrix *orbital_metric_seg = SM_ComputePhaseMetric( &ocoords, ref_time, start_time_seg, end_time_seg, detectors, detector_weights, detector_motion, ephemerides );
-    XLAL_CHECK_NULL( orbital_metric_seg != NULL, XLAL_EFUNC );
+    gsl_matrix *orbital_metric_seg = orbital_metric_segs[n];
     gsl_matrix_add( orbital_metric_avg, orbital_metric_seg );
 
     // Compute the coherent reduced supersky metric
-    XLAL_CHECK_NULL( SM_ComputeReducedSuperskyMetric( &metrics->coh_rssky_metric[n], &metrics->coh_rssky_transf[n], spindowns, ussky_metric_seg, &ucoords, orbital_metric_seg, &ocoords, ref_time, start_time_seg, end_time_seg ) == XLAL_SUCCESS, XLAL_EFUNC );
-    LogPrintf( LOG_DEBUG, "Computed coherent reduced supersky metric for segment %zu/%zu\n", n, metrics->num_segments );
+    XLAL_TRY( SM_ComputeReducedSuperskyMetric( &metrics->coh_rssky_metric[n], &metrics->coh_rssky_transf[n], spindowns, ussky_metric_seg, &ucoords, orbital_metric_seg, &ocoords, ref_time, start_time_seg, end_time_seg ), errnum );
+    if ( errnum == 0 ) {
+      LogPrintf( LOG_DEBUG, "Computed coherent reduced supersky metric for segment %zu/%zu\n", n, metrics->num_segments );
+    }
 
-    // Cleanup
-    GFMAT( ussky_metric_seg, orbital_metric_seg );
+  }
 
+  // Cleanup per-segment metrics, also if their computation failed
+  for ( size_t n = 0; n < metrics->num_segments; ++n ) {
+    GFMAT( ussky_metric_segs[n], orbital_metric_segs[n] );
+  }
+  XLALFree( ussky_metric_segs );
+  XLALFree( orbital_metric_segs );
+  if ( errnum != 0 ) {
+    GFMAT( ussky_metric_avg, orbital_metric_avg );
+    XLALDestroySuperskyMetrics( metrics );
+    XLAL_ERROR_NULL( XLAL_EFUNC, "Failed to compute coherent supersky metrics" );
   }
 
   // Normalise averaged metrics by number of segments
@@ -2478,6 +2533,33 @@ static int SM_LatticePhysicalRangeCallback(
 
 }
 
+static int SM_LatticePhysicalRangeMerge(
+  const LatticeTiling *tiling UNUSED,
+  const void *param,
+  void *out,
+  const void *other_out
+  )
+{
+
+  // Get callback data
+  const SM_CallbackParam *cparam = ( ( const SM_CallbackParam * ) param );
+  SM_CallbackOut *cout = ( ( SM_CallbackOut * ) out );
+  const SM_CallbackOut *other_cout = ( ( const SM_CallbackOut * ) other_out );
+
+  // Merge minimum/maximum values of physical coordinates
+  cout->min_phys.Alpha = GSL_MIN( cout->min_phys.Alpha, other_cout->min_phys.Alpha );
+  cout->max_phys.Alpha = GSL_MAX( cout->max_phys.Alpha, other_cout->max_phys.Alpha );
+  cout->min_phys.Delta = GSL_MIN( cout->min_phys.Delta, other_cout->min_phys.Delta );
+  cout->max_phys.Delta = GSL_MAX( cout->max_phys.Delta, other_cout->max_phys.Delta );
+  for ( size_t s = 0; s <= cparam->rssky_transf->SMAX; ++s ) {
+    cout->min_phys.fkdot[s] = GSL_MIN( cout->min_phys.fkdot[s], other_cout->min_phys.fkdot[s] );
+    cout->max_phys.fkdot[s] = GSL_MAX( cout->max_phys.fkdot[s], other_cout->max_phys.fkdot[s] );
+  }
+
+  return XLAL_SUCCESS;
+
+}
+
 int XLALRegisterSuperskyLatticePhysicalRangeCallback(
   LatticeTiling *tiling,
   const SuperskyTransformData *rssky_transf,
@@ -2496,7 +2578,7 @@ int XLALRegisterSuperskyLatticePhysicalRangeCallback(
   const SM_CallbackParam param = {
     .rssky_transf = rssky_transf,
   };
-  const SM_CallbackOut *out = XLALRegisterLatticeTilingCallback( tiling, SM_LatticePhysicalRangeCallback, sizeof( param ), &param, sizeof( *out ) );
+  const SM_CallbackOut *out = XLALRegisterMergeableLatticeTilingCallback( tiling, SM_LatticePhysicalRangeCallback, SM_LatticePhysicalRangeMerge, sizeof( param ), &param, sizeof( *out ) );
   XLAL_CHECK( out != NULL, XLAL_EFUNC );
 
   // Set output parameters
@@ -2569,6 +2651,29 @@ static int SM_LatticeSuperskyRangeCallback(
 
 }
 
+static int SM_LatticeSuperskyRangeMerge(
+  const LatticeTiling *tiling UNUSED,
+  const void *param,
+  void *out,
+  const void *other_out
+  )
+{
+
+  // Get callback data
+  const SM_CallbackParam *cparam = ( ( const SM_CallbackParam * ) param );
+  SM_CallbackOut *cout = ( ( SM_CallbackOut * ) out );
+  const SM_CallbackOut *other_cout = ( ( const SM_CallbackOut * ) other_out );
+
+  // Merge minimum/maximum values of other reduced supersky coordinates
+  for ( size_t i = 0; i < cparam->rssky2_transf->ndim; ++i ) {
+    cout->min_rssky2_array[i] = GSL_MIN( cout->min_rssky2_array[i], other_cout->min_rssky2_array[i] );
+    cout->max_rssky2_array[i] = GSL_MAX( cout->max_rssky2_array[i], other_cout->max_rssky2_array[i] );
+  }
+
+  return XLAL_SUCCESS;
+
+}
+
 int XLALRegisterSuperskyLatticeSuperskyRangeCallback(
   LatticeTiling *tiling,
   const SuperskyTransformData *rssky_transf,
@@ -2590,7 +2695,7 @@ int XLALRegisterSuperskyLatticeSuperskyRangeCallback(
     .rssky_transf = rssky_transf,
     .rssky2_transf = rssky2_transf,
   };
-  const SM_CallbackOut *out = XLALRegisterLatticeTilingCallback( tiling, SM_LatticeSuperskyRangeCallback, sizeof( param ), &param, sizeof( *out ) );
+  const SM_CallbackOut *out = XLALRegisterMergeableLatticeTilingCallback( tiling, SM_LatticeSuperskyRangeCallback, SM_LatticeSuperskyRangeMerge, sizeof( param ), &param, sizeof( *out ) );
   XLAL_CHECK( out != NULL, XLAL_EFUNC );
   XLAL_CHECK( rssky2_transf->ndim <= XLAL_NUM_ELEM( out->min_rssky2_array ), XLAL_EFAILED );
   XLAL_CHECK( rssky2_transf->ndim <= XLAL_NUM_ELEM( out->max_rssky2_array ), XLAL_EFAILED );
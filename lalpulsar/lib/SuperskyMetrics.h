@@ -87,7 +87,8 @@ SuperskyMetrics *XLALComputeSuperskyMetrics(
   const MultiLALDetector *detectors,            ///< [in] List of detectors to average metrics over
   const MultiNoiseFloor *detector_weights,      ///< [in] Weights used to combine single-detector metrics (default: unit weights)
   const DetectorMotionType detector_motion,     ///< [in] Which detector motion to use
-  const EphemerisData *ephemerides              ///< [in] Earth/Sun ephemerides
+  const EphemerisData *ephemerides,             ///< [in] Earth/Sun ephemerides
+  const size_t threads                          ///< [in] Number of threads over which segments are distributed (0: OpenMP default)
   );
 
 ///
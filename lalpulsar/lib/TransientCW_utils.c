@@ -58,6 +58,19 @@ static gsl_vector *expLUT = NULL; 	/**< module-global lookup-table for negative
 
 static int XLALCreateExpLUT ( void );	/* only ever used internally, destructor is in exported API */
 
+/**
+ * Sums of F-stat atoms quantities over a range of atoms, accumulated in double precision
+ */
+typedef struct tagTransientAtomSums {
+  REAL8 a2;		/**< sum of a2_alpha */
+  REAL8 b2;		/**< sum of b2_alpha */
+  REAL8 ab;		/**< sum of ab_alpha */
+  COMPLEX16 Fa;		/**< sum of Fa_alpha */
+  COMPLEX16 Fb;		/**< sum of Fb_alpha */
+} TransientAtomSums;
+
+static int XLALGetTransientWindowAtomsRange ( UINT4 *i_t0, UINT4 *i_t1, UINT4 *t0, UINT4 *t1, transientWindow_t window, UINT4 t0_data, UINT4 TAtom, UINT4 numAtoms );
+
 static const char *transientWindowNames[TRANSIENT_LAST] =
   {
     [TRANSIENT_NONE]	 	= "none",
@@ -618,6 +631,46 @@ XLALComputeTransientPosterior_tau ( transientWindowRange_t windowRange,		/**< [i
 
 
 
+/**
+ * Helper function to find the index range [i_t0, i_t1] of 'binned' F-stat atoms (as returned by
+ * XLALmergeMultiFstatAtomsBinned()) spanned by a given transient window, together with its timespan [t0, t1].
+ */
+static int
+XLALGetTransientWindowAtomsRange ( UINT4 *i_t0,			/**< [out] index of first atom in window */
+                                   UINT4 *i_t1,			/**< [out] index of last atom in window */
+                                   UINT4 *t0,			/**< [out] window start-time */
+                                   UINT4 *t1,			/**< [out] window end-time */
+                                   transientWindow_t window,	/**< [in] window-parameters */
+                                   UINT4 t0_data,		/**< [in] timestamp of first atom */
+                                   UINT4 TAtom,			/**< [in] time-spacing of atoms */
+                                   UINT4 numAtoms		/**< [in] number of atoms */
+                                   )
+{
+  UINT4 TAtomHalf = TAtom/2;	/* integer division */
+
+  /* get start- and end-time of this transient-window */
+  if ( XLALGetTransientWindowTimespan ( t0, t1, window ) != XLAL_SUCCESS ) {
+    XLALPrintError ("%s: XLALGetTransientWindowTimespan() failed.\n", __func__ );
+    XLAL_ERROR ( XLAL_EFUNC );
+  }
+
+  /* compute Fstat-atom index i_t0 in [0, numAtoms) */
+  INT4 i_tmp = ( window.t0 - t0_data + TAtomHalf ) / TAtom;	// integer round: floor(x+0.5)
+  if ( i_tmp < 0 ) i_tmp = 0;
+  (*i_t0) = (UINT4)i_tmp;
+  if ( (*i_t0) >= numAtoms ) (*i_t0) = numAtoms - 1;
+
+  /* compute window end-time Fstat-atom index i_t1 in [0, numAtoms) */
+  i_tmp = ( (*t1) - t0_data + TAtomHalf ) / TAtom  - 1;	// integer round: floor(x+0.5)
+  if ( i_tmp < 0 ) i_tmp = 0;
+  (*i_t1) = (UINT4)i_tmp;
+  if ( (*i_t1) >= numAtoms ) (*i_t1) = numAtoms - 1;
+
+  return XLAL_SUCCESS;
+
+} /* XLALGetTransientWindowAtomsRange() */
+
+
 /**
  * Function to compute transient-window "F-statistic map" over start-time and timescale {t0, tau}.
  * Returns a 2D matrix F_mn, with m = index over start-times t0, and n = index over timescales tau,
@@ -629,6 +682,10 @@ XLALComputeTransientPosterior_tau ( transientWindowRange_t windowRange,		/**< [i
  * little practical interest, except for demonstrating that marginalizing (1/D)e^F is *less* sensitive
  * than marginalizing e^F (see transient methods-paper [in prepartion])
  *
+ * Note3: the cost is O(numAtoms + N_t0) per timescale tau: rectangular windows are differences of prefix sums over
+ * the atoms, and exponential windows are truncated geometric series obtained from a single backwards recursion over
+ * the atoms per tau. Timescales are computed in parallel if OpenMP is enabled; the result does not depend on the number
+ * of threads.
  */
 transientFstatMap_t *
 XLALComputeTransientFstatMap ( const MultiFstatAtomVector *multiFstatAtoms, 	/**< [in] multi-IFO F-statistic atoms */
@@ -646,6 +703,13 @@ XLALComputeTransientFstatMap ( const MultiFstatAtomVector *multiFstatAtoms, 	/**
     XLAL_ERROR_NULL ( XLAL_EINVAL );
   }
 
+  /* internal memory, freed at the end or on failure */
+  int errnum = 0;
+  FstatAtomVector *atoms = NULL;
+  TransientAtomSums *prefixSums = NULL;
+  REAL4 *maxF_n = NULL;
+  UINT4 *maxF_m = NULL;
+
   /* ----- pepare return container ----- */
   transientFstatMap_t *ret;
   if ( (ret = XLALCalloc ( 1, sizeof(*ret) )) == NULL ) {
@@ -654,13 +718,12 @@ XLALComputeTransientFstatMap ( const MultiFstatAtomVector *multiFstatAtoms, 	/**
   }
 
   /* ----- first combine all multi-atoms into a single atoms-vector with *unique* timestamps */
-  FstatAtomVector *atoms;
   UINT4 TAtom = multiFstatAtoms->data[0]->TAtom;
-  UINT4 TAtomHalf = TAtom/2;	/* integer division */
 
   if ( (atoms = XLALmergeMultiFstatAtomsBinned ( multiFstatAtoms, TAtom )) == NULL ) {
     XLALPrintError ("%s: XLALmergeMultiFstatAtomsBinned() failed with code %d\n", __func__, xlalErrno );
-    XLAL_ERROR_NULL ( XLAL_EFUNC );
+    errnum = XLAL_EFUNC;
+    goto failed;
   }
   UINT4 numAtoms = atoms->length;
   /* actual data spans [t0_data, t0_data + numAtoms * TAtom] in steps of TAtom */
@@ -704,153 +767,227 @@ XLALComputeTransientFstatMap ( const MultiFstatAtomVector *multiFstatAtoms, 	/**
 
   if ( ( ret->F_mn = gsl_matrix_calloc ( N_t0Range, N_tauRange )) == NULL ) {
     XLALPrintError ("%s: failed ret->F_mn = gsl_matrix_calloc ( %d, %d )\n", __func__, N_tauRange, N_t0Range );
-    XLAL_ERROR_NULL ( XLAL_ENOMEM );
+    errnum = XLAL_ENOMEM;
+    goto failed;
   }
 
+  /* ----- check all windows {m,n} for the degenerate 1-atom case before doing any work ----- */
   transientWindow_t win_mn;
   win_mn.type = windowRange.type;
-  ret->maxF = -1.0;	// keep track of loudest F-stat point. Initializing to a negative value ensures that we always update at least once and hence return sane t0_d_ML, tau_d_ML even if there is only a single bin where F=0 happens.
   UINT4 m, n;
-  /* ----- OUTER loop over start-times [t0,t0+t0Band] ---------- */
-  for ( m = 0; m < N_t0Range; m ++ ) /* m enumerates 'binned' t0 start-time indices  */
+  for ( m = 0; m < N_t0Range; m ++ )
     {
-      /* compute Fstat-atom index i_t0 in [0, numAtoms) */
       win_mn.t0 = windowRange.t0 + m * windowRange.dt0;
-      INT4 i_tmp = ( win_mn.t0 - t0_data + TAtomHalf ) / TAtom;	// integer round: floor(x+0.5)
-      if ( i_tmp < 0 ) i_tmp = 0;
-      UINT4 i_t0 = (UINT4)i_tmp;
-      if ( i_t0 >= numAtoms ) i_t0 = numAtoms - 1;
-
-      /* ----- INNER loop over timescale-parameter tau ---------- */
-      REAL4 Ad=0, Bd=0, Cd=0;
-      COMPLEX8 Fa=0, Fb=0;
-      UINT4 i_t1_last = i_t0;
-
       for ( n = 0; n < N_tauRange; n ++ )
         {
-          /* translate n into an atoms end-index for this search interval [t0, t0+Tcoh],
-           * giving the index range of atoms to sum over
-           */
           win_mn.tau = windowRange.tau + n * windowRange.dtau;
-
-          /* get end-time t1 of this transient-window search */
-          UINT4 t0, t1;
-          if ( XLALGetTransientWindowTimespan ( &t0, &t1, win_mn ) != XLAL_SUCCESS ) {
-            XLALPrintError ("%s: XLALGetTransientWindowTimespan() failed.\n", __func__ );
-            XLAL_ERROR_NULL ( XLAL_EFUNC );
+          UINT4 i_t0, i_t1, t0, t1;
+          if ( XLALGetTransientWindowAtomsRange ( &i_t0, &i_t1, &t0, &t1, win_mn, t0_data, TAtom, numAtoms ) != XLAL_SUCCESS ) {
+            XLALPrintError ("%s: XLALGetTransientWindowAtomsRange() failed.\n", __func__ );
+            errnum = XLAL_EFUNC;
+            goto failed;
           }
-
-          /* compute window end-time Fstat-atom index i_t1 in [0, numAtoms) */
-          i_tmp = ( t1 - t0_data + TAtomHalf ) / TAtom  - 1;	// integer round: floor(x+0.5)
-          if ( i_tmp < 0 ) i_tmp = 0;
-          UINT4 i_t1 = (UINT4)i_tmp;
-          if ( i_t1 >= numAtoms ) i_t1 = numAtoms - 1;
-
           /* protection against degenerate 1-atom case: (this implies D=0 and therefore F->inf) */
           if ( i_t1 == i_t0 ) {
             XLALPrintError ("%s: encountered a single-atom Fstat-calculation. This is degenerate and cannot be computed!\n", __func__ );
             XLALPrintError ("Window-values m=%d (t0=%d=t0_data + %d), n=%d (tau=%d) ==> t1_data - t0 = %d\n",
                             m, win_mn.t0, i_t0 * TAtom, n, win_mn.tau, t1_data - win_mn.t0 );
             XLALPrintError ("The most likely cause is that your t0-range covered all of your data: t0 must stay away *at least* 2*TAtom from the end of the data!\n");
-            XLAL_ERROR_NULL ( XLAL_EDOM );
+            errnum = XLAL_EDOM;
+            goto failed;
           }
+        } /* for n < N_tauRange */
+    } /* for m < N_t0Range */
 
-          /* now we have two valid atoms-indices [i_t0, i_t1] spanning our Fstat-window to sum over,
-           * using weights according to the window-type
-           */
-          switch ( windowRange.type )
-            {
-            case TRANSIENT_RECTANGULAR:
-#if 0
-              /* 'vanilla' unoptimized method, for sanity checks with 'optimized' method */
-              Ad=0; Bd=0; Cd=0; Fa=0; Fb=0;
-              for ( UINT4 i = i_t0; i <= i_t1; i ++ )
-#else
-              /* special optimiziation in the rectangular-window case: just add on to previous tau values
-               * ie re-use the sum over [i_t0, i_t1_last] from the pevious tau-loop iteration
-               */
-              for ( UINT4 i = i_t1_last; i <= i_t1; i ++ )
-#endif
-                {
-                  FstatAtom *thisAtom_i = &atoms->data[i];
-
-                  /* now add on top of previous values, summed from [i_t0, i_t1_last] */
-                  Ad += thisAtom_i->a2_alpha;
-                  Bd += thisAtom_i->b2_alpha;
-                  Cd += thisAtom_i->ab_alpha;
+  /* ----- rectangular windows: prefix sums S_i = sum_{j<i} atom_j, so any window [i_t0, i_t1] is S_{i_t1+1} - S_{i_t0} */
+  if ( windowRange.type == TRANSIENT_RECTANGULAR )
+    {
+      if ( (prefixSums = XLALCalloc ( numAtoms + 1, sizeof(*prefixSums) )) == NULL ) {
+        XLALPrintError ("%s: XLALCalloc(%d,%zu) failed.\n", __func__, numAtoms + 1, sizeof(*prefixSums) );
+        errnum = XLAL_ENOMEM;
+        goto failed;
+      }
+      for ( UINT4 i = 0; i < numAtoms; i ++ )
+        {
+          const FstatAtom *thisAtom_i = &atoms->data[i];
+          prefixSums[i+1].a2 = prefixSums[i].a2 + thisAtom_i->a2_alpha;
+          prefixSums[i+1].b2 = prefixSums[i].b2 + thisAtom_i->b2_alpha;
+          prefixSums[i+1].ab = prefixSums[i].ab + thisAtom_i->ab_alpha;
+          prefixSums[i+1].Fa = prefixSums[i].Fa + thisAtom_i->Fa_alpha;
+          prefixSums[i+1].Fb = prefixSums[i].Fb + thisAtom_i->Fb_alpha;
+        }
+    }
 
-                  Fa += thisAtom_i->Fa_alpha;
-                  Fb += thisAtom_i->Fb_alpha;
+  /* keep track of the loudest F-stat point per timescale tau: the first (lowest) m with the highest F in each column n */
+  maxF_n = XLALCalloc ( N_tauRange, sizeof(*maxF_n) );
+  maxF_m = XLALCalloc ( N_tauRange, sizeof(*maxF_m) );
+  if ( maxF_n == NULL || maxF_m == NULL ) {
+    XLALPrintError ("%s: XLALCalloc(%d,%zu) failed.\n", __func__, N_tauRange, sizeof(*maxF_n) );
+    errnum = XLAL_ENOMEM;
+    goto failed;
+  }
 
-                } /* for i = i_t1_last : i_t1 */
+  /* ----- loop over timescales tau, which are independent and can therefore be computed in parallel ----- */
+#pragma omp parallel
+  {
+    /* exponential windows: per-thread buffer of backwards-recursive sums G_i = atom_i + q * G_{i+1} */
+    TransientAtomSums *expSums = NULL;
+    if ( windowRange.type == TRANSIENT_EXPONENTIAL && ( expSums = XLALCalloc ( numAtoms + 1, sizeof(*expSums) )) == NULL ) {
+#pragma omp critical(XLALComputeTransientFstatMap)
+      errnum = XLAL_ENOMEM;
+    }
 
-              i_t1_last = i_t1 + 1;		/* keep track of up to where we summed for the next iteration */
+#pragma omp for schedule(static)
+    for ( UINT4 n_tau = 0; n_tau < N_tauRange; n_tau ++ )
+      {
+        if ( errnum != 0 ) {
+          continue;
+        }
 
-              break;
+        transientWindow_t win;
+        win.type = windowRange.type;
+        win.tau = windowRange.tau + n_tau * windowRange.dtau;
+
+        /* exponential windows: for atoms on a regular grid, each window is a (truncated) geometric series
+         * in q = e^(-TAtom/tau) for Fa,Fb and q^2 for A,B,C, which we sum backwards over all atoms once per tau
+         */
+        REAL8 q = 0, q2 = 0;
+        if ( win.type == TRANSIENT_EXPONENTIAL )
+          {
+            q = exp ( - 1.0 * TAtom / win.tau );
+            q2 = q * q;
+            memset ( &expSums[numAtoms], 0, sizeof(expSums[numAtoms]) );
+            for ( INT4 i = numAtoms - 1; i >= 0; i -- )
+              {
+                const FstatAtom *thisAtom_i = &atoms->data[i];
+                expSums[i].a2 = thisAtom_i->a2_alpha + q2 * expSums[i+1].a2;
+                expSums[i].b2 = thisAtom_i->b2_alpha + q2 * expSums[i+1].b2;
+                expSums[i].ab = thisAtom_i->ab_alpha + q2 * expSums[i+1].ab;
+                expSums[i].Fa = thisAtom_i->Fa_alpha + q  * expSums[i+1].Fa;
+                expSums[i].Fb = thisAtom_i->Fb_alpha + q  * expSums[i+1].Fb;
+              }
+          }
 
-            case TRANSIENT_EXPONENTIAL:
-              /* reset all values */
-              Ad=0; Bd=0; Cd=0; Fa=0; Fb=0;
+        maxF_n[n_tau] = -1.0;	// initializing to a negative value ensures that we always update at least once
 
-              for ( UINT4 i = i_t0; i <= i_t1; i ++ )
-                {
-                  FstatAtom *thisAtom_i = &atoms->data[i];
-                  UINT4 t_i = thisAtom_i->timestamp;
+        for ( UINT4 m_t0 = 0; m_t0 < N_t0Range; m_t0 ++ )
+          {
+            win.t0 = windowRange.t0 + m_t0 * windowRange.dt0;
 
-                  REAL8 win_i;
-                  win_i = XLALGetExponentialTransientWindowValue ( t_i, t0, t1, win_mn.tau );
+            /* get the atoms-indices [i_t0, i_t1] spanning this Fstat-window */
+            UINT4 i_t0, i_t1, t0, t1;
+            if ( XLALGetTransientWindowAtomsRange ( &i_t0, &i_t1, &t0, &t1, win, t0_data, TAtom, numAtoms ) != XLAL_SUCCESS ) {
+#pragma omp critical(XLALComputeTransientFstatMap)
+              errnum = XLAL_EFUNC;
+              break;
+            }
 
-                  REAL8 win2_i = win_i * win_i;
+            /* sum over the window using weights according to the window-type */
+            REAL8 Ad = 0, Bd = 0, Cd = 0;
+            COMPLEX16 Fa = 0, Fb = 0;
+            switch ( win.type )
+              {
+              case TRANSIENT_RECTANGULAR:
+                Ad = prefixSums[i_t1+1].a2 - prefixSums[i_t0].a2;
+                Bd = prefixSums[i_t1+1].b2 - prefixSums[i_t0].b2;
+                Cd = prefixSums[i_t1+1].ab - prefixSums[i_t0].ab;
+                Fa = prefixSums[i_t1+1].Fa - prefixSums[i_t0].Fa;
+                Fb = prefixSums[i_t1+1].Fb - prefixSums[i_t0].Fb;
+                break;
+
+              case TRANSIENT_EXPONENTIAL:
+                {
+                  /* the window vanishes outside of [t0, t1], which may cut off the first and last atoms in [i_t0, i_t1] */
+                  UINT4 i_a = i_t0, i_b = i_t1;
+                  while ( i_a <= i_b && t0_data + i_a * TAtom < t0 ) {
+                    i_a ++;
+                  }
+                  while ( i_b >= i_a && t0_data + i_b * TAtom > t1 ) {
+                    i_b --;
+                  }
+                  if ( i_a > i_b ) {
+                    break;
+                  }
+                  /* sum_{i=i_a}^{i_b} atom_i e^(-(t_i - t0)/tau) = e^(-(t_{i_a} - t0)/tau) * ( G_{i_a} - q^(i_b+1-i_a) G_{i_b+1} ) */
+                  REAL8 w = exp ( - 1.0 * ( t0_data + i_a * TAtom - t0 ) / win.tau );
+                  REAL8 w2 = w * w;
+                  REAL8 qL = exp ( - 1.0 * ( i_b + 1 - i_a ) * TAtom / win.tau );
+                  REAL8 qL2 = qL * qL;
+                  Ad = w2 * ( expSums[i_a].a2 - qL2 * expSums[i_b+1].a2 );
+                  Bd = w2 * ( expSums[i_a].b2 - qL2 * expSums[i_b+1].b2 );
+                  Cd = w2 * ( expSums[i_a].ab - qL2 * expSums[i_b+1].ab );
+                  Fa = w  * ( expSums[i_a].Fa - qL  * expSums[i_b+1].Fa );
+                  Fb = w  * ( expSums[i_a].Fb - qL  * expSums[i_b+1].Fb );
+                }
+                break;
 
-                  Ad += thisAtom_i->a2_alpha * win2_i;
-                  Bd += thisAtom_i->b2_alpha * win2_i;
-                  Cd += thisAtom_i->ab_alpha * win2_i;
+              default:
+                break;
 
-                  Fa += thisAtom_i->Fa_alpha * win_i;
-                  Fb += thisAtom_i->Fb_alpha * win_i;
+              } /* switch window.type */
 
-                } /* for i in [i_t0, i_t1] */
-              break;
+            /* generic F-stat calculation from A,B,C, Fa, Fb */
+            REAL4 Dd = XLALComputeAntennaPatternSqrtDeterminant ( Ad, Bd, Cd, 0 );
+            REAL4 DdInv = 1.0f / Dd;
+            REAL4 twoF = compute_fstat_from_fa_fb ( Fa, Fb, Ad, Bd, Cd, 0, DdInv );
+            REAL4 F = 0.5 * twoF;
+            /* keep track of loudest F-stat value encountered for this timescale */
+            if ( F > maxF_n[n_tau] )
+              {
+                maxF_n[n_tau] = F;
+                maxF_m[n_tau] = m_t0;
+              }
 
-            default:
-              XLALPrintError ("%s: invalid transient window type %d not in [%d, %d].\n",
-                              __func__, windowRange.type, TRANSIENT_NONE, TRANSIENT_LAST -1 );
-              XLAL_ERROR_NULL ( XLAL_EINVAL );
-              break;
+            /* if requested: use 'regularized' F-stat: log ( 1/D * e^F ) = F + log(1/D) */
+            if ( useFReg )
+              F += log( DdInv );
 
-            } /* switch window.type */
+            /* and store this in Fstat-matrix as element {m,n} */
+            gsl_matrix_set ( ret->F_mn, m_t0, n_tau, F );
 
+          } /* for m in m[t0] : m[t0+t0Band] */
 
-          /* generic F-stat calculation from A,B,C, Fa, Fb */
-          REAL4 Dd = XLALComputeAntennaPatternSqrtDeterminant ( Ad, Bd, Cd, 0 );
-          REAL4 DdInv = 1.0f / Dd;
-          REAL4 twoF = compute_fstat_from_fa_fb ( Fa, Fb, Ad, Bd, Cd, 0, DdInv );
-          REAL4 F = 0.5 * twoF;
-          /* keep track of loudest F-stat value encountered over the m x n matrix */
-          if ( F > ret->maxF )
-            {
-              ret->maxF = F;
-              ret->t0_ML  = win_mn.t0;	/* start-time t0 corresponding to Fmax */
-              ret->tau_ML = win_mn.tau;	/* timescale tau corresponding to Fmax */
-            }
+      } /* for n in n[tau] : n[tau+tauBand] */
 
-          /* if requested: use 'regularized' F-stat: log ( 1/D * e^F ) = F + log(1/D) */
-          if ( useFReg )
-            F += log( DdInv );
+    XLALFree ( expSums );
 
-          /* and store this in Fstat-matrix as element {m,n} */
-          gsl_matrix_set ( ret->F_mn, m, n, F );
+  } /* omp parallel */
 
-        } /* for n in n[tau] : n[tau+tauBand] */
+  if ( errnum != 0 ) {
+    goto failed;
+  }
 
-    } /* for m in m[t0] : m[t0+t0Band] */
+  /* find loudest F-stat value over the m x n matrix, picking the first one in {m,n} order as a serial scan would */
+  ret->maxF = -1.0;
+  UINT4 m_ML = 0;
+  for ( n = 0; n < N_tauRange; n ++ )
+    {
+      if ( maxF_n[n] > ret->maxF || ( maxF_n[n] == ret->maxF && maxF_m[n] < m_ML ) )
+        {
+          ret->maxF = maxF_n[n];
+          m_ML = maxF_m[n];
+          ret->t0_ML  = windowRange.t0 + m_ML * windowRange.dt0;	/* start-time t0 corresponding to Fmax */
+          ret->tau_ML = windowRange.tau + n * windowRange.dtau;	/* timescale tau corresponding to Fmax */
+        }
+    }
 
   /* free internal mem */
+  XLALFree ( maxF_n );
+  XLALFree ( maxF_m );
+  XLALFree ( prefixSums );
   XLALDestroyFstatAtomVector ( atoms );
 
   /* return end product: F-stat map */
   return ret;
 
+ failed:
+  XLALFree ( maxF_n );
+  XLALFree ( maxF_m );
+  XLALFree ( prefixSums );
+  XLALDestroyFstatAtomVector ( atoms );
+  XLALDestroyTransientFstatMap ( ret );
+  XLAL_ERROR_NULL ( errnum );
+
 } /* XLALComputeTransientFstatMap() */
 
 
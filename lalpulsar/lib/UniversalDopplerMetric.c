@@ -21,6 +21,7 @@
 
 /*---------- INCLUDES ----------*/
 #include <math.h>
+#include <string.h>
 #ifdef _OPENMP
 #include <omp.h>
 #endif
@@ -247,6 +248,8 @@ typedef struct
   const EphemerisData *edat;		/**< ephemeris data */
   vect3Dlist_t *rOrb_n;			/**< list of orbital-radius derivatives at refTime of order n = 0, 1, ... */
   BOOLEAN approxPhase;			/**< use an approximate phase-model, neglecting Roemer delay in spindown coordinates (or orders \>= 1) */
+  const PosVel3D_t *spin_posvel;	/**< if non-NULL: precomputed detector spin motion at the requested time, in units of LAL_C_SI */
+  const PosVel3D_t *orbit_posvel;	/**< if non-NULL: precomputed detector orbital motion at the requested time, in units of LAL_C_SI */
 } intparams_t;
 
 
@@ -270,6 +273,9 @@ static double XLALCovariance_Phi_ij ( const MultiLALDetector *multiIFO, const Mu
 
 static UINT4 findHighestGCSpinOrder ( const DopplerCoordinateSystem *coordSys );
 
+static int DetectorPosVelFromEarth ( PosVel3D_t *spin_posvel, PosVel3D_t *orbit_posvel, const LIGOTimeGPS *tGPS, const LALDetector *site,
+                                     const EarthState *earth, DetectorMotionType detMotionType );
+
 /*==================== FUNCTION DEFINITIONS ====================*/
 
 
@@ -516,12 +522,17 @@ CW_Phi_i ( double tt, void *params )
 
   /* get current detector position r(t) and velocity v(t) */
   REAL8 ttSI = par->startTime + tt * par->Tspan;	/* current GPS time in seconds */
-  LIGOTimeGPS ttGPS;
-  XLALGPSSetREAL8( &ttGPS, ttSI );
-  if ( XLALDetectorPosVel ( &spin_posvel, &orbit_posvel, &ttGPS, par->site, par->edat, par->detMotionType ) != XLAL_SUCCESS ) {
-    par->errnum = xlalErrno;
-    XLALPrintError ( "%s: Call to XLALDetectorPosVel() failed!\n", __func__);
-    return GSL_NAN;
+  if ( par->spin_posvel != NULL && par->orbit_posvel != NULL ) {
+    spin_posvel = (*par->spin_posvel);
+    orbit_posvel = (*par->orbit_posvel);
+  } else {
+    LIGOTimeGPS ttGPS;
+    XLALGPSSetREAL8( &ttGPS, ttSI );
+    if ( XLALDetectorPosVel ( &spin_posvel, &orbit_posvel, &ttGPS, par->site, par->edat, par->detMotionType ) != XLAL_SUCCESS ) {
+      par->errnum = xlalErrno;
+      XLALPrintError ( "%s: Call to XLALDetectorPosVel() failed!\n", __func__);
+      return GSL_NAN;
+    }
   }
 
   /* XLALDetectorPosVel() returns detector positions and velocities from XLALBarycenter(),
@@ -773,12 +784,6 @@ XLALDetectorPosVel ( PosVel3D_t *spin_posvel,		/**< [out] instantaneous sidereal
                      )
 {
   EarthState earth;
-  BarycenterInput XLAL_INIT_DECL(baryinput);
-  EmissionTime XLAL_INIT_DECL(emit);
-  PosVel3D_t Det_wrt_Earth;
-  PosVel3D_t PtoleOrbit;
-  PosVel3D_t Spin_z, Spin_xy;
-  const vect3D_t eZ = {0, -LAL_SINIEARTH, LAL_COSIEARTH};       /* ecliptic z-axis in equatorial coordinates */
 
   XLAL_CHECK( tGPS, XLAL_EFAULT );
   XLAL_CHECK( site, XLAL_EFAULT );
@@ -789,18 +794,47 @@ XLALDetectorPosVel ( PosVel3D_t *spin_posvel,		/**< [out] instantaneous sidereal
   /* ----- find ephemeris-based position of Earth wrt to SSB at this moment */
   XLAL_CHECK( XLALBarycenterEarth( &earth, tGPS, edat ) == XLAL_SUCCESS, XLAL_EFUNC );
 
+  /* ----- find position of detector given that of the Earth */
+  XLAL_CHECK( DetectorPosVelFromEarth( spin_posvel, orbit_posvel, tGPS, site, &earth, detMotionType ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  return XLAL_SUCCESS;
+
+} /* XLALDetectorPosVel() */
+
+
+/**
+ * Compute the detector position and velocity at a given GPS time from a precomputed Earth state,
+ * as returned by XLALBarycenterEarth() for the same time; used by XLALDetectorPosVel(), and to share
+ * one Earth state between several detectors.
+ */
+static int
+DetectorPosVelFromEarth ( PosVel3D_t *spin_posvel,		/**< [out] instantaneous sidereal position and velocity vector */
+                          PosVel3D_t *orbit_posvel,		/**< [out] instantaneous orbital position and velocity vector */
+                          const LIGOTimeGPS *tGPS,		/**< [in] GPS time */
+                          const LALDetector *site,		/**< [in] detector info */
+                          const EarthState *earth,		/**< [in] Earth state at time tGPS */
+                          DetectorMotionType detMotionType	/**< [in] detector motion type */
+                          )
+{
+  BarycenterInput XLAL_INIT_DECL(baryinput);
+  EmissionTime XLAL_INIT_DECL(emit);
+  PosVel3D_t Det_wrt_Earth;
+  PosVel3D_t PtoleOrbit;
+  PosVel3D_t Spin_z, Spin_xy;
+  const vect3D_t eZ = {0, -LAL_SINIEARTH, LAL_COSIEARTH};       /* ecliptic z-axis in equatorial coordinates */
+
   /* ----- find ephemeris-based position of detector wrt to SSB */
   baryinput.tgps = *tGPS;
   baryinput.site = *site;
   baryinput.site.location[0] /= LAL_C_SI; baryinput.site.location[1] /= LAL_C_SI; baryinput.site.location[2] /= LAL_C_SI;
   baryinput.alpha = 0; baryinput.delta = 0; baryinput.dInv = 0;
-  XLAL_CHECK( XLALBarycenter ( &emit, &baryinput, &earth ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLALBarycenter ( &emit, &baryinput, earth ) == XLAL_SUCCESS, XLAL_EFUNC );
 
   /* ----- determine position-vector of detector wrt center of Earth */
   COPY_VECT(Det_wrt_Earth.pos, emit.rDetector);
-  SUB_VECT(Det_wrt_Earth.pos, earth.posNow);
+  SUB_VECT(Det_wrt_Earth.pos, earth->posNow);
   COPY_VECT(Det_wrt_Earth.vel, emit.vDetector);
-  SUB_VECT(Det_wrt_Earth.vel, earth.velNow);
+  SUB_VECT(Det_wrt_Earth.vel, earth->velNow);
 
   /* compute ecliptic-z projected spin motion */
   REAL8 pz = DOT_VECT ( Det_wrt_Earth.pos, eZ );
@@ -859,8 +893,8 @@ XLALDetectorPosVel ( PosVel3D_t *spin_posvel,		/**< [out] instantaneous sidereal
       break;
 
     case DETMOTION_ORBIT:   /**< Ephemeris-based orbital motion */
-      COPY_VECT(orbit_posvel->pos, earth.posNow);
-      COPY_VECT(orbit_posvel->vel, earth.velNow);
+      COPY_VECT(orbit_posvel->pos, earth->posNow);
+      COPY_VECT(orbit_posvel->vel, earth->velNow);
       break;
 
     case DETMOTION_PTOLEORBIT:   /**< Ptolemaic (circular) orbital motion */
@@ -876,7 +910,7 @@ XLALDetectorPosVel ( PosVel3D_t *spin_posvel,		/**< [out] instantaneous sidereal
 
   return XLAL_SUCCESS;
 
-} /* XLALDetectorPosVel() */
+} /* DetectorPosVelFromEarth() */
 
 
 
@@ -1441,6 +1475,256 @@ XLALDestroyDopplerPhaseMetric ( DopplerPhaseMetric *metric )
 } /* XLALDestroyDopplerPhaseMetric() */
 
 
+/**
+ * Evaluate all phase derivatives \f$\phi_i\f$, for i = 0 ... dim-1, at sample \a s of \a M uniform intervals
+ * spanning the segment starting at \a segStart, for each of \a numDet detectors. The Earth state is computed once,
+ * and shared between the detectors. Phase derivatives of detector X are returned in phi[X*dim + i].
+ */
+static int
+SampledPhaseDerivatives ( REAL8 *phi,				/**< [out] phase derivatives, in physical units */
+                          intparams_t *par,			/**< [in] phase-derivative parameters */
+                          const LIGOTimeGPS *segStart,		/**< [in] segment start time */
+                          UINT4 s,				/**< [in] sample index, from 0 to M */
+                          UINT4 M,				/**< [in] number of sample intervals */
+                          UINT4 numDet,				/**< [in] number of detectors */
+                          const LALDetector *sites		/**< [in] detector sites */
+                          )
+{
+  const UINT4 dim = par->coordSys->dim;
+  const double tt = ((double) s) / M;
+  LIGOTimeGPS tGPS = *segStart;
+  XLALGPSAdd ( &tGPS, s * par->Tspan / M );
+
+  EarthState earth;
+  XLAL_CHECK ( XLALBarycenterEarth ( &earth, &tGPS, par->edat ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  int errnum = XLAL_SUCCESS;
+  for ( UINT4 X = 0; X < numDet && errnum == XLAL_SUCCESS; ++X ) {
+    PosVel3D_t spin_posvel, orbit_posvel;
+    XLAL_CHECK ( DetectorPosVelFromEarth ( &spin_posvel, &orbit_posvel, &tGPS, &sites[X], &earth, par->detMotionType ) == XLAL_SUCCESS, XLAL_EFUNC );
+    par->spin_posvel = &spin_posvel;
+    par->orbit_posvel = &orbit_posvel;
+    for ( UINT4 i = 0; i < dim; ++i ) {
+      par->coord = i;
+      phi[X * dim + i] = GET_COORD_SCALE(par->coordSys, i) * CW_Phi_i ( tt, par );
+      if ( par->errnum ) {
+        errnum = par->errnum;
+        break;
+      }
+    }
+    par->spin_posvel = NULL;
+    par->orbit_posvel = NULL;
+  }
+
+  return errnum;
+} /* SampledPhaseDerivatives() */
+
+
+/**
+ * Compute the phase metric of each segment in \a metricParams->segmentList separately, i.e.\ the metrics
+ * which XLALComputeDopplerPhaseMetric() would return for each segment on its own. Metric components are
+ * referred to the reference time \a metricParams->signalParams.Doppler.refTime, and projected if
+ * \a metricParams->projectCoord is set. The per-segment metrics are returned in \a g_ij_seg, an array of
+ * length \a metricParams->segmentList.length; any NULL elements are allocated.
+ *
+ * Instead of integrating each metric component with adaptive quadrature, the detector motion is sampled
+ * at uniform steps of at most \a sampleStep seconds in each segment, and all phase derivatives are
+ * evaluated in a single pass over the samples; time averages are then computed with Simpson's rule.
+ * The default step (\a sampleStep = 0) of 300 seconds, or 1/64 of the binary orbital period if shorter,
+ * resolves the daily detector motion to far better than the tolerances of XLALComputeDopplerPhaseMetric().
+ * At each sample the Earth state is computed once, and shared between detectors. Segments are processed
+ * in parallel using \a numThreads threads (0 = OpenMP default), if OpenMP is enabled.
+ *
+ * To avoid cancellation in the covariances \f$[\phi_i, \phi_j]\f$, each segment metric is computed at
+ * the segment mid-time, relative to the phase derivatives at the segment mid-time, and then transformed to
+ * the reference time with XLALChangeMetricReferenceTime().
+ */
+int
+XLALComputeDopplerPhaseMetricSegments ( gsl_matrix **g_ij_seg,				/**< [out] per-segment phase metrics */
+                                        const DopplerMetricParams *metricParams,	/**< [in] input parameters determining the metric calculation */
+                                        const EphemerisData *edat,			/**< [in] ephemeris data */
+                                        REAL8 sampleStep,				/**< [in] maximum time step between samples, in seconds (0 = default) */
+                                        UINT4 numThreads				/**< [in] number of threads to use, if OpenMP is enabled */
+                                        )
+{
+  /* ---------- sanity/consistency checks ---------- */
+  XLAL_CHECK ( g_ij_seg != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( metricParams != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( edat != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( XLALSegListIsInitialized ( &(metricParams->segmentList) ), XLAL_EINVAL, "Passed un-initialzied segment list 'metricParams->segmentList'\n");
+  XLAL_CHECK ( sampleStep >= 0, XLAL_EINVAL );
+  const LALSegList *segList = &(metricParams->segmentList);
+  const UINT4 Nseg = segList->length;
+  XLAL_CHECK ( Nseg > 0, XLAL_EINVAL );
+
+  const DopplerCoordinateSystem *coordSys = &(metricParams->coordSys);
+  const UINT4 dim = coordSys->dim;
+  XLAL_CHECK ( dim > 0, XLAL_EINVAL );
+  XLAL_CHECK ( metricParams->projectCoord < (INT4)dim, XLAL_EINVAL );
+  XLAL_CHECK ( metricParams->detMotionType > 0, XLAL_EINVAL, "Invalid detector motion type '%d'", metricParams->detMotionType );
+
+  // ----- check that {n2x_equ, n2y_equ} are not used at the equator (delta=0), as metric is undefined there
+  BOOLEAN have_n2xy = 0;
+  for ( UINT4 i = 0; i < dim; i ++ ) {
+    if ( (coordSys->coordIDs[i] == DOPPLERCOORD_N2X_EQU) || ( coordSys->coordIDs[i] == DOPPLERCOORD_N2Y_EQU) ) {
+      have_n2xy = 1;
+    }
+  }
+  BOOLEAN at_equator = (metricParams->signalParams.Doppler.Delta == 0);
+  XLAL_CHECK ( !(at_equator && have_n2xy), XLAL_EINVAL, "Can't use 'n2x_equ','n2y_equ' at equator (Delta=0): metric is singular there");
+
+  // ----- detectors and noise weights, as in XLALCovariance_Phi_ij()
+  const MultiLALDetector *multiIFO = &(metricParams->multiIFO);
+  const UINT4 numDet = multiIFO->length;
+  XLAL_CHECK ( numDet > 0, XLAL_EINVAL );
+  const BOOLEAN haveNoiseWeights = ( metricParams->multiNoiseFloor.length > 0 );
+  XLAL_CHECK ( !haveNoiseWeights || (metricParams->multiNoiseFloor.length == numDet), XLAL_EINVAL );
+  REAL8 total_weight = 0.0, weights[numDet];
+  for ( UINT4 X = 0; X < numDet; X ++ ) {
+    weights[X] = haveNoiseWeights ? metricParams->multiNoiseFloor.sqrtSn[X] : 1.0;
+    total_weight += weights[X];
+  }
+  XLAL_CHECK ( total_weight > 0, XLAL_EDOM, "Detectors noise-floors given but all zero!" );
+
+#ifdef _OPENMP
+  if ( numThreads == 0 ) {
+    numThreads = omp_get_max_threads();
+  }
+#else
+  (void) numThreads;
+  numThreads = 1;
+#endif
+
+  // ----- choose sampling step, resolving the binary orbit if any
+  if ( sampleStep == 0 ) {
+    sampleStep = 300;
+    if ( metricParams->signalParams.Doppler.period > 0 ) {
+      sampleStep = MYMIN ( sampleStep, metricParams->signalParams.Doppler.period / 64 );
+    }
+  }
+
+  // ----- check segment lengths
+  for ( UINT4 k = 0; k < Nseg; ++k ) {
+    const REAL8 Tspan = XLALGPSDiff ( &(segList->segs[k].end), &(segList->segs[k].start) );
+    XLAL_CHECK ( Tspan > 0, XLAL_EINVAL, "Segment %u has non-positive length %g", k, Tspan );
+  }
+
+  /* ---------- prepare output metrics ---------- */
+  for ( UINT4 k = 0; k < Nseg; ++k ) {
+    if ( g_ij_seg[k] == NULL ) {
+      XLAL_CHECK ( (g_ij_seg[k] = gsl_matrix_alloc ( dim, dim )) != NULL, XLAL_ENOMEM );
+    } else {
+      XLAL_CHECK ( g_ij_seg[k]->size1 == dim && g_ij_seg[k]->size2 == dim, XLAL_EINVAL );
+    }
+  }
+
+  /* ---------- set up phase-derivative parameters ---------- */
+  intparams_t XLAL_INIT_DECL(intparams);
+  intparams.coordSys = coordSys;
+  intparams.edat = edat;
+  intparams.dopplerPoint = &(metricParams->signalParams.Doppler);
+  intparams.detMotionType = metricParams->detMotionType;
+  intparams.approxPhase = metricParams->approxPhase;
+  intparams.amcomp1 = AMCOMP_NONE;
+  intparams.amcomp2 = AMCOMP_NONE;
+
+  /* if using 'global correlation' frequency variables, compute rOrb(t) derivatives at reference time */
+  UINT4 maxorder = findHighestGCSpinOrder ( coordSys );
+  if ( maxorder > 0 ) {
+    XLAL_CHECK ( (intparams.rOrb_n = XLALComputeOrbitalDerivatives ( maxorder, &intparams.dopplerPoint->refTime, edat )) != NULL, XLAL_EFUNC );
+  }
+
+  /* ---------- compute segment metrics in parallel ---------- */
+  const REAL8 refTime = XLALGPSGetREAL8 ( &(metricParams->signalParams.Doppler.refTime) );
+  int errnum = 0;
+#pragma omp parallel for schedule(dynamic) num_threads(numThreads) if(numThreads > 1)
+  for ( INT4 k = 0; k < (INT4)Nseg; ++k )
+    {
+      intparams_t par = intparams;	/* struct-copy, as the 'coord' and detector-motion fields have to be changeable */
+      par.startTime = XLALGPSGetREAL8 ( &(segList->segs[k].start) );
+      par.Tspan = XLALGPSDiff ( &(segList->segs[k].end), &(segList->segs[k].start) );
+      par.refTime = par.startTime + 0.5 * par.Tspan;	/* compute metric at segment mid-time, transform to refTime later */
+
+      /* number of (an even number of) Simpson's rule intervals */
+      const UINT4 M = 2 * ( (UINT4) MYMAX ( 32, ceil ( 0.5 * par.Tspan / sampleStep ) ) );
+
+      /* phase derivatives at the segment mid-time (and first detector), subtracted from all samples */
+      REAL8 phi_mid[dim], phi[dim];
+      if ( SampledPhaseDerivatives ( phi_mid, &par, &(segList->segs[k].start), M/2, M, 1, &multiIFO->sites[0] ) != XLAL_SUCCESS ) {
+#pragma omp critical (XLALComputeDopplerPhaseMetricSegments)
+        errnum = XLAL_EFUNC;
+        continue;
+      }
+
+      /* accumulate <phi_i> and <phi_i phi_j> over samples and detectors */
+      REAL8 av_i[dim], av_ij[dim][dim];
+      memset ( av_i, 0, sizeof(av_i) );
+      memset ( av_ij, 0, sizeof(av_ij) );
+      BOOLEAN failed = 0;
+      for ( UINT4 s = 0; s <= M && !failed; ++s ) {
+        const REAL8 simpson = ( s == 0 || s == M ) ? 1.0 : ( ( s % 2 == 1 ) ? 4.0 : 2.0 );
+        REAL8 phi_X[numDet][dim];
+        if ( SampledPhaseDerivatives ( &phi_X[0][0], &par, &(segList->segs[k].start), s, M, numDet, multiIFO->sites ) != XLAL_SUCCESS ) {
+          failed = 1;
+          break;
+        }
+        for ( UINT4 X = 0; X < numDet; ++X ) {
+          const REAL8 w = weights[X] * simpson / ( 3.0 * M * total_weight );
+          for ( UINT4 i = 0; i < dim; ++i ) {
+            phi[i] = phi_X[X][i] - phi_mid[i];
+          }
+          for ( UINT4 i = 0; i < dim; ++i ) {
+            av_i[i] += w * phi[i];
+            for ( UINT4 j = i; j < dim; ++j ) {
+              av_ij[i][j] += w * phi[i] * phi[j];
+            }
+          }
+        }
+      }
+      if ( failed ) {
+#pragma omp critical (XLALComputeDopplerPhaseMetricSegments)
+        errnum = XLAL_EFUNC;
+        continue;
+      }
+
+      /* g_ij = [Phi_i, Phi_j] */
+      for ( UINT4 i = 0; i < dim; ++i ) {
+        for ( UINT4 j = i; j < dim; ++j ) {
+          const REAL8 gg = av_ij[i][j] - av_i[i] * av_i[j];
+          gsl_matrix_set ( g_ij_seg[k], i, j, gg );
+          gsl_matrix_set ( g_ij_seg[k], j, i, gg );
+        }
+      }
+
+      /* transform phase metric reference time from segment mid-time to refTime, and if requested project g_ij onto coordinate 'projectCoord' */
+      if ( XLALChangeMetricReferenceTime ( &g_ij_seg[k], NULL, g_ij_seg[k], coordSys, refTime - par.refTime ) != XLAL_SUCCESS
+           || ( metricParams->projectCoord >= 0 && XLALProjectMetric ( &g_ij_seg[k], g_ij_seg[k], (UINT4)metricParams->projectCoord ) != XLAL_SUCCESS ) ) {
+#pragma omp critical (XLALComputeDopplerPhaseMetricSegments)
+        errnum = XLAL_EFUNC;
+        continue;
+      }
+
+    } /* for k < Nseg */
+
+  /* free memory */
+  XLALDestroyVect3Dlist ( intparams.rOrb_n );
+
+  XLAL_CHECK ( errnum == 0, errnum, "Computation of segment phase metrics failed" );
+
+  /* ---- check that metrics are positive definite, by checking determinants of submatrices */
+  for ( UINT4 k = 0; k < Nseg; ++k ) {
+    for ( size_t n = 1; n <= dim; ++n ) {
+      gsl_matrix_view g_ij_n = gsl_matrix_submatrix( g_ij_seg[k], 0, 0, n, n );
+      const double det_n = XLALMetricDeterminant( &g_ij_n.matrix );
+      XLAL_CHECK ( det_n > 0, XLAL_EFAILED, "%s: could not compute a positive-definite phase metric (segment=%u, n=%zu, det_n=%0.3e)", __func__, k, n, det_n );
+    }
+  }
+
+  return XLAL_SUCCESS;
+
+} /* XLALComputeDopplerPhaseMetricSegments() */
+
+
 /**
  * Calculate the general (single-segment coherent, or multi-segment semi-coherent)
  * *full* (multi-IFO) Fstat-metrix and the Fisher-matrix derived in \cite Prix07 .
@@ -260,6 +260,10 @@ void XLALDestroyDopplerFstatMetric ( DopplerFstatMetric *metric );
 
 DopplerPhaseMetric* XLALComputeDopplerPhaseMetric ( const DopplerMetricParams *metricParams, const EphemerisData *edat );
 void XLALDestroyDopplerPhaseMetric ( DopplerPhaseMetric *metric );
+#ifndef SWIG // exclude from SWIG interface; array of gsl_matrix pointers
+int XLALComputeDopplerPhaseMetricSegments ( gsl_matrix **g_ij_seg, const DopplerMetricParams *metricParams, const EphemerisData *edat,
+                                            REAL8 sampleStep, UINT4 numThreads );
+#endif
 
 FmetricAtoms_t*
 XLALComputeAtomsForFmetric ( const DopplerMetricParams *metricParams,
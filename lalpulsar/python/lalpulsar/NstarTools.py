@@ -206,7 +206,7 @@ def get_Nstar_estimate(
         SSkyMetric = lalpulsar.ComputeSuperskyMetrics(
             lalpulsar.SUPERSKY_METRIC_TYPE, spindowns, ref_time, segments,
             fiducial_freq, detectors, detector_weights, detector_motion,
-            ephemeris)
+            ephemeris, 1)
     except RuntimeError as e:
         logging.warning('Encountered run-time error {}'.format(e))
         raise RuntimeError("Calculation of the SSkyMetric failed")
@@ -32,7 +32,7 @@
  * \author Reinhard Prix
  * \file
  * \ingroup lalpulsar_coh
- * \brief Tests for XLALAdd[Multi]BinaryTimes()
+ * \brief Tests for XLALAdd[Multi]BinaryTimes() and XLALGetMultiSSBtimesBatch()
  *
  * We simply compare the results to the old+obsolete LAL functions LALGet[Multi]Binarytimes(),
  * which have been moved here, and only serve for this comparison.
@@ -195,7 +195,31 @@ main ( int argc, char *argv[] )
   XLAL_CHECK ( err_DeltaT < tolerance, XLAL_ETOL, "error(DeltaT) = %g exceeds tolerance of %g\n", err_DeltaT, tolerance );
   XLAL_CHECK ( err_Tdot   < tolerance, XLAL_ETOL, "error(Tdot) = %g exceeds tolerance of %g\n", err_Tdot, tolerance );
 
-  // ---- step 4: clean-up memory
+  // ----- step 4: compare isolated-NS SSB times from batched XLALGetMultiSSBtimesBatch() at a few sky positions;
+  // these can only differ by nanosecond-rounding of the emission time, as seen through the REAL8 resolution of GPS times
+  MultiSSBtimesBatch *multiSSBBatch = XLALCreateMultiSSBtimesBatch ( multiDetStates );
+  XLAL_CHECK ( multiSSBBatch != NULL, XLAL_EFUNC, "XLALCreateMultiSSBtimesBatch() failed.\n");
+  MultiSSBtimes *multiSSBTest = NULL;
+  for ( UINT4 k = 0; k < 4; k ++ )
+    {
+      SkyPosition skypos_k = skypos;
+      skypos_k.longitude = fmod ( skypos.longitude + k * 1.3, LAL_TWOPI );
+      skypos_k.latitude = skypos.latitude * ( 1.0 - 0.5 * k );
+      MultiSSBtimes *multiSSBRef = XLALGetMultiSSBtimes ( multiDetStates, skypos_k, refTime, SSBPREC_RELATIVISTICOPT );
+      XLAL_CHECK ( multiSSBRef != NULL, XLAL_EFUNC, "XLALGetMultiSSBtimes() failed.\n");
+      XLAL_CHECK ( XLALGetMultiSSBtimesBatch ( &multiSSBTest, multiSSBBatch, skypos_k, refTime, ( k % 2 == 0 ) ? 1 : 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+      XLAL_CHECK ( XLALCompareMultiSSBtimes ( &err_DeltaT, &err_Tdot, multiSSBRef, multiSSBTest ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLALPrintWarning ( "INFO: batched SSB times: err(DeltaT) = %g, err(Tdot) = %g\n", err_DeltaT, err_Tdot );
+      XLAL_CHECK ( err_DeltaT < 1e-6, XLAL_ETOL, "error(DeltaT) = %g exceeds tolerance of %g\n", err_DeltaT, 1e-6 );
+      XLAL_CHECK ( err_Tdot   < tolerance, XLAL_ETOL, "error(Tdot) = %g exceeds tolerance of %g\n", err_Tdot, tolerance );
+
+      XLALDestroyMultiSSBtimes ( multiSSBRef );
+    }
+  XLALDestroyMultiSSBtimes ( multiSSBTest );
+  XLALDestroyMultiSSBtimesBatch ( multiSSBBatch );
+
+  // ---- step 5: clean-up memory
   XLALDestroyUserVars();
   XLALDestroyEphemerisData ( edat );
   XLALDestroyMultiSSBtimes ( multiBinary_test );
@@ -279,6 +279,133 @@ main ( int argc, char *argv[] )
       XLAL_ERROR ( XLAL_EFUNC );
     }
 
+  // ----- test that multi-threaded F-statistic results are identical to serial results
+  const FstatQuantities whatToComputeThreads[2] = { FSTATQ_2F | FSTATQ_FAFB | FSTATQ_2F_PER_DET, FSTATQ_2F | FSTATQ_FAFB_PER_DET };
+  for ( UINT4 iMethod = FMETHOD_START; iMethod < FMETHOD_END; iMethod ++ )
+    {
+      if ( !XLALFstatMethodIsAvailable(iMethod) || (iMethod == FMETHOD_DEMOD_BEST) || (iMethod == FMETHOD_RESAMP_BEST) ) {
+        continue;
+      }
+      FstatInput *input_serial = NULL, *input_threads = NULL;
+      FstatResults *results_serial = NULL, *results_threads = NULL;
+      optionalArgs.FstatMethod = iMethod;
+      optionalArgs.prevInput = NULL;
+      optionalArgs.numThreads = 1;
+      XLAL_CHECK ( (input_serial = XLALCreateFstatInput ( catalog, minCoverFreq, maxCoverFreq, dFreq, ephem, &optionalArgs )) != NULL, XLAL_EFUNC );
+      optionalArgs.numThreads = 3;
+      XLAL_CHECK ( (input_threads = XLALCreateFstatInput ( catalog, minCoverFreq, maxCoverFreq, dFreq, ephem, &optionalArgs )) != NULL, XLAL_EFUNC );
+      for ( UINT4 i = 0; i < XLAL_NUM_ELEM(whatToComputeThreads); ++i )
+        {
+          XLAL_CHECK ( XLALComputeFstat ( &results_serial, input_serial, &Doppler, numFreqBins, whatToComputeThreads[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
+          XLAL_CHECK ( XLALComputeFstat ( &results_threads, input_threads, &Doppler, numFreqBins, whatToComputeThreads[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
+          XLALPrintInfo ( "Comparing serial and multi-threaded results for method '%s'\n", XLALGetFstatInputMethodName(input_serial) );
+          if ( whatToComputeThreads[i] & FSTATQ_2F ) {
+            XLAL_CHECK ( memcmp ( results_serial->twoF, results_threads->twoF, numFreqBins * sizeof(results_serial->twoF[0]) ) == 0, XLAL_EFAILED, "Multi-threaded 2F differs for method '%s'", XLALGetFstatInputMethodName(input_serial) );
+          }
+          if ( whatToComputeThreads[i] & FSTATQ_FAFB ) {
+            XLAL_CHECK ( memcmp ( results_serial->Fa, results_threads->Fa, numFreqBins * sizeof(results_serial->Fa[0]) ) == 0, XLAL_EFAILED, "Multi-threaded Fa differs for method '%s'", XLALGetFstatInputMethodName(input_serial) );
+            XLAL_CHECK ( memcmp ( results_serial->Fb, results_threads->Fb, numFreqBins * sizeof(results_serial->Fb[0]) ) == 0, XLAL_EFAILED, "Multi-threaded Fb differs for method '%s'", XLALGetFstatInputMethodName(input_serial) );
+          }
+          for ( UINT4 X = 0; X < numDetectors; X ++ )
+            {
+              if ( whatToComputeThreads[i] & FSTATQ_2F_PER_DET ) {
+                XLAL_CHECK ( memcmp ( results_serial->twoFPerDet[X], results_threads->twoFPerDet[X], numFreqBins * sizeof(results_serial->twoFPerDet[X][0]) ) == 0, XLAL_EFAILED, "Multi-threaded 2F^X differs for method '%s'", XLALGetFstatInputMethodName(input_serial) );
+              }
+              if ( whatToComputeThreads[i] & FSTATQ_FAFB_PER_DET ) {
+                XLAL_CHECK ( memcmp ( results_serial->FaPerDet[X], results_threads->FaPerDet[X], numFreqBins * sizeof(results_serial->FaPerDet[X][0]) ) == 0, XLAL_EFAILED, "Multi-threaded Fa^X differs for method '%s'", XLALGetFstatInputMethodName(input_serial) );
+                XLAL_CHECK ( memcmp ( results_serial->FbPerDet[X], results_threads->FbPerDet[X], numFreqBins * sizeof(results_serial->FbPerDet[X][0]) ) == 0, XLAL_EFAILED, "Multi-threaded Fb^X differs for method '%s'", XLALGetFstatInputMethodName(input_serial) );
+              }
+            }
+        }
+      XLALDestroyFstatInput ( input_serial );
+      XLALDestroyFstatInput ( input_threads );
+      XLALDestroyFstatResults ( results_serial );
+      XLALDestroyFstatResults ( results_threads );
+    } // for iMethod < FMETHOD_END
+  optionalArgs.numThreads = 1;
+
+  // ----- test that F-statistic results computed for a batch of templates are the same as for one template at a time
+  {
+    const UINT4 numBatchTemplates = 9;
+    PulsarDopplerParams batchDopplers[9];
+    FstatResults *results_batch[9], *results_single = NULL;
+    for ( UINT4 i = 0; i < numBatchTemplates; ++i )
+      {
+        // 5 spindowns at one sky position, then 4 spindowns at another
+        batchDopplers[i] = Doppler;
+        batchDopplers[i].fkdot[1] += ( i % 5 ) * 0.25 * df1dot;
+        if ( i >= 5 ) {
+          batchDopplers[i].Alpha += dSky;
+        }
+        results_batch[i] = NULL;
+      }
+    for ( UINT4 iMethod = FMETHOD_START; iMethod < FMETHOD_END; iMethod ++ )
+      {
+        if ( !XLALFstatMethodIsAvailable(iMethod) || (iMethod == FMETHOD_DEMOD_BEST) || (iMethod == FMETHOD_RESAMP_BEST) ) {
+          continue;
+        }
+        XLALPrintInfo ( "Comparing batch and single-template results for method '%s'\n", XLALGetFstatInputMethodName(input_seg1[iMethod]) );
+        XLAL_CHECK ( XLALComputeFstatBatch ( results_batch, input_seg1[iMethod], batchDopplers, numBatchTemplates, numFreqBins, whatToCompute ) == XLAL_SUCCESS, XLAL_EFUNC );
+        for ( UINT4 i = 0; i < numBatchTemplates; ++i )
+          {
+            XLAL_CHECK ( XLALComputeFstat ( &results_single, input_seg1[iMethod], &batchDopplers[i], numFreqBins, whatToCompute ) == XLAL_SUCCESS, XLAL_EFUNC );
+            XLAL_CHECK ( compareFstatResults ( results_single, results_batch[i] ) == XLAL_SUCCESS, XLAL_EFUNC, "Comparison between batch and single-template results failed for method '%s', template %d\n", XLALGetFstatInputMethodName(input_seg1[iMethod]), i );
+          }
+      } // for iMethod < FMETHOD_END
+    for ( UINT4 i = 0; i < numBatchTemplates; ++i ) {
+      XLALDestroyFstatResults ( results_batch[i] );
+    }
+    XLALDestroyFstatResults ( results_single );
+  }
+
+  // ----- test that Resamp FstatInputs sharing a workspace re-use its FFT plan and give the same results
+  {
+    FstatInput *input_ws1 = NULL, *input_ws2 = NULL;
+    FstatResults *results_ws0 = NULL, *results_ws2 = NULL;
+    FstatTimingGeneric XLAL_INIT_DECL(timingGeneric);
+    FstatTimingModel XLAL_INIT_DECL(timingModel);
+    optionalArgs.FstatMethod = FMETHOD_RESAMP_GENERIC;
+    optionalArgs.collectTiming = 1;
+    optionalArgs.resampMaxWorkspaceMB = 1024;
+    optionalArgs.prevInput = NULL;
+    XLAL_CHECK ( (input_ws1 = XLALCreateFstatInput ( catalog, minCoverFreq, maxCoverFreq, dFreq, ephem, &optionalArgs )) != NULL, XLAL_EFUNC );
+    optionalArgs.prevInput = input_ws1;
+    XLAL_CHECK ( (input_ws2 = XLALCreateFstatInput ( catalog, minCoverFreq, maxCoverFreq, dFreq, ephem, &optionalArgs )) != NULL, XLAL_EFUNC );
+    XLAL_CHECK ( XLALComputeFstat ( &results_ws2, input_ws2, &Doppler, numFreqBins, whatToCompute ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK ( XLALGetFstatTiming ( input_ws2, &timingGeneric, &timingModel ) == XLAL_SUCCESS, XLAL_EFUNC );
+    REAL4 NFFTplans = -1, FFTplanReused = -1;
+    for ( UINT4 i = 0; i < timingModel.numVariables; ++i )
+      {
+        if ( strcmp ( timingModel.names[i], "NFFTplans" ) == 0 ) {
+          NFFTplans = timingModel.values[i];
+        } else if ( strcmp ( timingModel.names[i], "FFTplanReused" ) == 0 ) {
+          FFTplanReused = timingModel.values[i];
+        }
+      }
+    XLAL_CHECK ( NFFTplans == 1 && FFTplanReused == 1, XLAL_EFAILED, "Expected 1 re-used FFT plan in shared Resamp workspace, got NFFTplans = %g, FFTplanReused = %g\n", NFFTplans, FFTplanReused );
+    XLALPrintInfo ( "Comparing results between Resamp with shared and non-shared workspace\n" );
+    XLAL_CHECK ( XLALComputeFstat ( &results_ws0, input_seg1[FMETHOD_RESAMP_GENERIC], &Doppler, numFreqBins, whatToCompute ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK ( compareFstatResults ( results_ws0, results_ws2 ) == XLAL_SUCCESS, XLAL_EFUNC, "Comparison between Resamp with shared and non-shared workspace failed\n" );
+    XLALDestroyFstatInput ( input_ws1 );
+    XLALDestroyFstatInput ( input_ws2 );
+    XLALDestroyFstatResults ( results_ws0 );
+    XLALDestroyFstatResults ( results_ws2 );
+    optionalArgs.prevInput = NULL;
+    optionalArgs.collectTiming = 0;
+    optionalArgs.resampMaxWorkspaceMB = 0;
+  }
+
+  // ----- test that a Resamp FstatInput fails with XLAL_ENOMEM if its workspace exceeds the memory budget
+  {
+    FstatInput *input_small = NULL;
+    int errnum = 0;
+    optionalArgs.FstatMethod = FMETHOD_RESAMP_GENERIC;
+    optionalArgs.resampMaxWorkspaceMB = 1e-3;
+    XLAL_TRY_SILENT ( input_small = XLALCreateFstatInput ( catalog, minCoverFreq, maxCoverFreq, dFreq, ephem, &optionalArgs ), errnum );
+    XLAL_CHECK ( input_small == NULL && ( errnum & ~XLAL_EFUNC ) == XLAL_ENOMEM, XLAL_EFAILED, "Expected Resamp workspace exceeding memory budget to fail with XLAL_ENOMEM, got errnum = %i\n", errnum );
+    optionalArgs.resampMaxWorkspaceMB = 0;
+  }
+
   // free remaining memory
   for ( UINT4 iMethod=FMETHOD_START; iMethod < FMETHOD_END; iMethod ++ )
     {
@@ -46,7 +46,7 @@
  * ### Usage ###
  *
  * \code
- * TestDriveHough [-d debuglevel] [-o outfile] [-f f0] [-p alpha delta]
+ * TestDriveHough [-d debuglevel] [-o outfile] [-f f0] [-p alpha delta] [-b nloops]
  * \endcode
  *
  * ### Description ###
@@ -74,6 +74,11 @@
  * <b>-f</b> option sets the intrinsic frequency \c f0 at which build the <tt>lut</tt>.
  * The <b>-p</b> option sets the velocity orientation of the detector
  * \c alpha, \c delta (in radians) for the first \c lut (time-stamp).
+ * The <b>-b</b> option times \c nloops constructions of the weighted Hough maps
+ * with LALHOUGHConstructHMT_W() and XLALHOUGHConstructHMTs_W(). With the default
+ * \c MOBSCOH time stamps and \c NMAPS maps the cost is dominated by integrating the
+ * maps, and XLALHOUGHConstructHMTs_W() is not faster on a single thread; \c MOBSCOH and
+ * \c NMAPS must be increased to benchmark realistic numbers of time stamps and maps.
  *
  * ### Uses ###
  *
@@ -84,6 +89,8 @@
  * LALHOUGHupdateSpacePHMDup()
  * LALHOUGHInitializeHT()
  * LALHOUGHConstructHMT()
+ * LALHOUGHConstructHMT_W()
+ * XLALHOUGHConstructHMTs_W()
  * LALPrintError()
  * LALMalloc()
  * LALFree()
@@ -94,6 +101,7 @@
 
 
 #include <lal/LALHough.h>
+#include <lal/LogPrintf.h>
 
 /* Error codes and messages */
 
@@ -127,9 +135,11 @@
 #define NFSIZE  5
 #define STEPALPHA 0.005
 #define PIXELFACTOR 2
+#define NMAPS 12          /* number of Hough maps for XLALHOUGHConstructHMTs_W() */
+#define NBINS 4           /* number of frequency bins of the Hough maps */
 /* Usage format string. */
 
-#define USAGE "Usage: %s [-d debuglevel] [-o outfile] [-f f0] [-p alpha delta] [-s patchSizeX patchSizeY]\n"
+#define USAGE "Usage: %s [-d debuglevel] [-o outfile] [-f f0] [-p alpha delta] [-s patchSizeX patchSizeY] [-b nloops]\n"
 
 /*********************************************************************/
 /* Macros for printing errors & testing subroutines (from Creighton) */
@@ -179,6 +189,8 @@ int main(int argc, char *argv[]){
   static HOUGHDemodPar   parDem;  /* demodulation parameters */
   static HOUGHSizePar    parSize;
   static HOUGHMapTotal   ht;   /* the total Hough map */
+  static HOUGHMapTotal   htW[NMAPS];   /* weighted total Hough maps */
+  static UINT8FrequencyIndexVector freqIndW[NMAPS];
   /* ------------------------------------------------------- */
 
   UINT2  maxNBins, maxNBorders;
@@ -196,6 +208,7 @@ int main(int argc, char *argv[]){
   INT4 k;
   REAL8 f0, alpha, delta, veloMod;
   REAL8 patchSizeX, patchSizeY;
+  INT4 nloops = 0;
 
   /************************************************************/
   /* Set up the default parameters. */
@@ -298,6 +311,17 @@ int main(int argc, char *argv[]){
         return TESTDRIVEHOUGHC_EARG;
       }
     }
+    /* Parse benchmark option. */
+    else if ( !strcmp( argv[arg], "-b" ) ) {
+      if ( argc > arg + 1 ) {
+        arg++;
+	nloops = atoi(argv[arg++]);
+      } else {
+        ERROR( TESTDRIVEHOUGHC_EARG, TESTDRIVEHOUGHC_MSGEARG, 0 );
+        XLALPrintError( USAGE, *argv );
+        return TESTDRIVEHOUGHC_EARG;
+      }
+    }
     /* Unrecognized option. */
     else {
       ERROR( TESTDRIVEHOUGHC_EARG, TESTDRIVEHOUGHC_MSGEARG, 0 );
@@ -490,6 +514,93 @@ int main(int argc, char *argv[]){
   fclose( fp );
 
 
+  /******************************************************************/
+  /* compare weighted Hough maps from LALHOUGHConstructHMT_W() and  */
+  /* XLALHOUGHConstructHMTs_W()                                     */
+  /******************************************************************/
+
+  {
+    REAL8Vector *weightV = XLALCreateREAL8Vector( MOBSCOH );
+    if ( weightV == NULL ) {
+      ERROR( TESTDRIVEHOUGHC_ESUB, TESTDRIVEHOUGHC_MSGESUB, "XLALCreateREAL8Vector() failed:" );
+      return TESTDRIVEHOUGHC_ESUB;
+    }
+    for (j=0;j< MOBSCOH;++j){
+      weightV->data[j] = 1.0 + 0.1*j;
+    }
+    SUB( LALHOUGHWeighSpacePHMD( &status, &phmdVS, weightV ), &status );
+    XLALDestroyREAL8Vector( weightV );
+
+    /* Hough maps cycle through the frequency bins, so that blocks of maps
+       accumulated together do not all have the same trajectory */
+    HOUGHMapTotal *htWP[NMAPS];
+    const UINT8FrequencyIndexVector *freqIndWP[NMAPS];
+    const PHMDVectorSequence *phmdVSP[NMAPS];
+    for (j=0; j<NMAPS; ++j){
+      htW[j].xSide = xSide;
+      htW[j].ySide = ySide;
+      htW[j].map = (HoughTT *)LALMalloc(xSide*ySide*sizeof(HoughTT));
+      freqIndW[j].length = MOBSCOH;
+      freqIndW[j].deltaF = DF;
+      freqIndW[j].data = (UINT8 *)LALMalloc(MOBSCOH*sizeof(UINT8));
+      for (i=0; i<MOBSCOH; ++i){
+        freqIndW[j].data[i] = freqInd.data[i] + (j % NBINS);
+      }
+      htWP[j] = &htW[j];
+      freqIndWP[j] = &freqIndW[j];
+      phmdVSP[j] = &phmdVS;
+    }
+
+    /* compute Hough maps in parallel and serially */
+    for (k=0; k<2; ++k){
+      if ( XLALHOUGHConstructHMTs_W( htWP, NMAPS, freqIndWP, phmdVSP, k ) != XLAL_SUCCESS ) {
+        ERROR( TESTDRIVEHOUGHC_ESUB, TESTDRIVEHOUGHC_MSGESUB, "XLALHOUGHConstructHMTs_W() failed:" );
+        return TESTDRIVEHOUGHC_ESUB;
+      }
+      for (j=0; j<NMAPS; ++j){
+        SUB( LALHOUGHConstructHMT_W( &status, &ht, &freqIndW[j], &phmdVS ), &status );
+        for (i=0; i<(UINT4)xSide*ySide; ++i){
+          if ( fabs( htW[j].map[i] - ht.map[i] ) > 1e-10 * ( 1.0 + fabs( ht.map[i] ) ) ) {
+            ERROR( TESTDRIVEHOUGHC_EBAD, TESTDRIVEHOUGHC_MSGEBAD, "XLALHOUGHConstructHMTs_W() differs from LALHOUGHConstructHMT_W():" );
+            return TESTDRIVEHOUGHC_EBAD;
+          }
+        }
+      }
+    }
+
+    /* benchmark construction of Hough maps, if requested */
+    if ( nloops > 0 ) {
+      REAL8 tic = XLALGetTimeOfDay();
+      for (INT4 l=0; l<nloops; ++l){
+        for (j=0; j<NMAPS; ++j){
+          SUB( LALHOUGHConstructHMT_W( &status, &ht, &freqIndW[j], &phmdVS ), &status );
+        }
+      }
+      const REAL8 timeLAL = ( XLALGetTimeOfDay() - tic ) / nloops;
+      REAL8 timeXLAL[2];
+      for (k=0; k<2; ++k){
+        tic = XLALGetTimeOfDay();
+        for (INT4 l=0; l<nloops; ++l){
+          if ( XLALHOUGHConstructHMTs_W( htWP, NMAPS, freqIndWP, phmdVSP, k ) != XLAL_SUCCESS ) {
+            ERROR( TESTDRIVEHOUGHC_ESUB, TESTDRIVEHOUGHC_MSGESUB, "XLALHOUGHConstructHMTs_W() failed:" );
+            return TESTDRIVEHOUGHC_ESUB;
+          }
+        }
+        timeXLAL[k] = ( XLALGetTimeOfDay() - tic ) / nloops;
+      }
+      printf( "Time to construct %i weighted Hough maps (%ix%i pixels):\n", NMAPS, xSide, ySide );
+      printf( "  LALHOUGHConstructHMT_W():              %.3e s\n", timeLAL );
+      printf( "  XLALHOUGHConstructHMTs_W(), 1 thread:  %.3e s (speedup %.2f)\n", timeXLAL[1], timeLAL / timeXLAL[1] );
+      printf( "  XLALHOUGHConstructHMTs_W(), N threads: %.3e s (speedup %.2f)\n", timeXLAL[0], timeLAL / timeXLAL[0] );
+    }
+
+    for (j=0; j<NMAPS; ++j){
+      LALFree( htW[j].map );
+      LALFree( freqIndW[j].data );
+    }
+  }
+
+
   /******************************************************************/
   /* Free memory and exit */
   /******************************************************************/
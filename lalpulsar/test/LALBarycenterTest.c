@@ -45,6 +45,8 @@
  *
  */
 
+#include <string.h>
+
 #include <lal/LALBarycenter.h>
 #include <lal/LALInitBarycenter.h>
 #include <lal/DetectorSite.h>
@@ -210,6 +212,50 @@ main( void )
   XLALPrintError ("XLALBarycenter() 	%g s\n", tau / counter );
   XLALPrintError ("XLALBarycenterOpt()	%g s (= %.1f %%)\n", tau_opt / counter,  - 100 * (tau - tau_opt ) / tau );
 
+  /* ===== test binary ephemeris files ===== */
+  XLALPrintInfo("\n\nTesting binary ephemeris files ... ");
+  {
+    const char eEphFileBin[] = "LALBarycenterTest-earth98.bin";
+    const char sEphFileBin[] = "LALBarycenterTest-sun98.bin";
+    XLAL_CHECK( XLALWriteBinaryEphemerisFiles( edat, eEphFileBin, sEphFileBin ) == XLAL_SUCCESS, XLAL_EFUNC );
+    EphemerisData *edatBin = XLALInitBarycenter( eEphFileBin, sEphFileBin );
+    XLAL_CHECK( edatBin != NULL, XLAL_EFUNC );
+    XLAL_CHECK( edatBin->etype == edat->etype, XLAL_EFAILED, "\nTest FAILED: etype %d != %d\n", edatBin->etype, edat->etype );
+    XLAL_CHECK( compare_ephemeris( edat, edatBin ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    /* a binary Earth file must not be accepted as a Sun file */
+    XLAL_CHECK( XLALInitBarycenter( eEphFileBin, eEphFileBin ) == NULL, XLAL_EFAILED, "\nTest FAILED: expected XLALInitBarycenter( '%s', '%s' ) to fail!\n", eEphFileBin, eEphFileBin );
+    XLALClearErrno();
+
+    /* restricting a memory-mapped ephemeris must give the same tables as restricting a parsed one */
+    EphemerisData *edatCopy = XLALInitBarycenter( eEphFile, sEphFile );
+    XLAL_CHECK( edatCopy != NULL, XLAL_EFUNC );
+    LIGOTimeGPS startGPS, endGPS;
+    XLAL_CHECK( XLALGPSSetREAL8( &startGPS, edat->ephemE[17].gps + 0.3 * edat->dtEtable ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK( XLALGPSSetREAL8( &endGPS, edat->ephemE[edat->nentriesE - 23].gps ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK( XLALRestrictEphemerisData( edatCopy, &startGPS, &endGPS ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( XLALRestrictEphemerisData( edatBin, &startGPS, &endGPS ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( compare_ephemeris( edatCopy, edatBin ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLALDestroyEphemerisData( edatCopy );
+    XLALDestroyEphemerisData( edatBin );
+
+    /* time correction files */
+    const char tCorrFile[] = TEST_PKG_DATA_DIR "te405_2000-2019.dat.gz";
+    const char tCorrFileBin[] = "LALBarycenterTest-te405.bin";
+    TimeCorrectionData *tdat = XLALInitTimeCorrections( tCorrFile );
+    XLAL_CHECK( tdat != NULL, XLAL_EFUNC );
+    XLAL_CHECK( XLALWriteBinaryTimeCorrectionFile( tdat, tCorrFileBin ) == XLAL_SUCCESS, XLAL_EFUNC );
+    TimeCorrectionData *tdatBin = XLALInitTimeCorrections( tCorrFileBin );
+    XLAL_CHECK( tdatBin != NULL, XLAL_EFUNC );
+    XLAL_CHECK( tdatBin->nentriesT == tdat->nentriesT && tdatBin->dtTtable == tdat->dtTtable && tdatBin->timeCorrStart == tdat->timeCorrStart,
+                XLAL_EFAILED, "\nTest FAILED: inconsistent time correction table headers\n" );
+    XLAL_CHECK( memcmp( tdatBin->timeCorrs, tdat->timeCorrs, tdat->nentriesT * sizeof( tdat->timeCorrs[0] ) ) == 0,
+                XLAL_EFAILED, "\nTest FAILED: inconsistent time correction tables\n" );
+    XLALDestroyTimeCorrectionData( tdatBin );
+    XLALDestroyTimeCorrectionData( tdat );
+  }
+  XLALPrintInfo("PASSED\n\n");
+
   /* ===== test XLALRestrictEphemerisData() ===== */
   XLALPrintInfo("\n\nTesting XLALRestrictEphemerisData() ... ");
   {
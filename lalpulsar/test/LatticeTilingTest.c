@@ -171,6 +171,228 @@ static int SerialisationTest(
 
 }
 
+static int BlockTest(
+  const LatticeTiling *tiling,
+  const size_t itr_ndim,
+  const gsl_matrix *points
+  )
+{
+
+  const double value_tol = 1000 * LAL_REAL8_EPS;
+  const size_t n = XLALTotalLatticeTilingDimensions( tiling );
+  const UINT8 total = points->size2;
+
+  // Get all points in blocks, with unpartitioned and partitioned iterators, check for consistency
+  const UINT4 partition_counts[] = { 1, 3 };
+  for ( size_t p = 0; p < XLAL_NUM_ELEM( partition_counts ); ++p ) {
+    UINT8 total_block = 0, prev_first_index = 0;
+    for ( UINT4 partition_index = 0; partition_index < partition_counts[p]; ++partition_index ) {
+      LatticeTilingIterator *itr = XLALCreateLatticeTilingIterator( tiling, itr_ndim );
+      XLAL_CHECK( itr != NULL, XLAL_EFUNC );
+      XLAL_CHECK( XLALSetLatticeTilingIteratorPartition( itr, partition_counts[p], partition_index ) == XLAL_SUCCESS, XLAL_EFUNC );
+      gsl_matrix *block = NULL;
+      UINT8 first_index = 0;
+      int num_points = 0;
+      bool first_block = true;
+      while ( ( num_points = XLALNextLatticeTilingBlock( itr, &block, &first_index ) ) > 0 ) {
+        XLAL_CHECK( first_index + num_points <= total, XLAL_EFAILED, "first_index + num_points = %" LAL_UINT8_FORMAT " + %i > %" LAL_UINT8_FORMAT " = total", first_index, num_points, total );
+        XLAL_CHECK( first_block || first_index > prev_first_index, XLAL_EFAILED, "first_index = %" LAL_UINT8_FORMAT " <= %" LAL_UINT8_FORMAT " = prev_first_index", first_index, prev_first_index );
+        for ( int k = 0; k < num_points; ++k ) {
+          for ( size_t j = 0; j < n; ++j ) {
+            const double block_j_k = gsl_matrix_get( block, j, k );
+            const double point_j_k = gsl_matrix_get( points, j, first_index + k );
+            XLAL_CHECK( fabs( block_j_k - point_j_k ) <= value_tol, XLAL_EFAILED, "block[%zu,%i] = %.10g != %.10g = points[%zu,%" LAL_UINT8_FORMAT "]", j, k, block_j_k, point_j_k, j, first_index + k );
+          }
+        }
+        total_block += num_points;
+        prev_first_index = first_index;
+        first_block = false;
+      }
+      XLAL_CHECK( num_points == 0, XLAL_EFUNC );
+      XLALDestroyLatticeTilingIterator( itr );
+      GFMAT( block );
+    }
+    XLAL_CHECK( total_block == total, XLAL_EFAILED, "total_block = %" LAL_UINT8_FORMAT " != %" LAL_UINT8_FORMAT " = total, partition count = %u", total_block, total, partition_counts[p] );
+  }
+
+  return XLAL_SUCCESS;
+
+}
+
+static int OuterPartitionTest(
+  const LatticeTiling *tiling,
+  const size_t itr_ndim,
+  const gsl_matrix *points
+  )
+{
+
+  const double value_tol = 1000 * LAL_REAL8_EPS;
+  const size_t n = XLALTotalLatticeTilingDimensions( tiling );
+  const UINT8 total = points->size2;
+
+  // Outer partitions require at least one iterated-over tiled dimension
+  bool tiled = false;
+  for ( size_t i = 0; i < itr_ndim; ++i ) {
+    tiled = tiled || XLALIsTiledLatticeTilingDimension( tiling, i );
+  }
+  if ( !tiled ) {
+    return XLAL_SUCCESS;
+  }
+
+  // Get all points with partitioned iterators; partitions are contiguous ranges of the outermost
+  // tiled dimension, so points from each partition in turn should be the same as all points
+  gsl_vector *GAVEC( point, n );
+  const UINT4 partition_counts[] = { 1, 3, 1000 };
+  for ( size_t p = 0; p < XLAL_NUM_ELEM( partition_counts ); ++p ) {
+    UINT8 k = 0;
+    for ( UINT4 partition_index = 0; partition_index < partition_counts[p]; ++partition_index ) {
+      LatticeTilingIterator *itr = XLALCreateLatticeTilingIterator( tiling, itr_ndim );
+      XLAL_CHECK( itr != NULL, XLAL_EFUNC );
+      XLAL_CHECK( XLALSetLatticeTilingIteratorOuterPartition( itr, partition_counts[p], partition_index ) == XLAL_SUCCESS, XLAL_EFUNC );
+      int retn = 0;
+      while ( ( retn = XLALNextLatticeTilingPoint( itr, point ) ) > 0 ) {
+        XLAL_CHECK( k < total, XLAL_EFAILED, "k = %" LAL_UINT8_FORMAT " >= %" LAL_UINT8_FORMAT " = total", k, total );
+        const UINT8 itr_index = XLALCurrentLatticeTilingIndex( itr );
+        XLAL_CHECK( k == itr_index, XLAL_EFAILED, "k = %" LAL_UINT8_FORMAT " != %" LAL_UINT8_FORMAT " = itr_index", k, itr_index );
+        for ( size_t j = 0; j < n; ++j ) {
+          const double point_j = gsl_vector_get( point, j );
+          const double points_j_k = gsl_matrix_get( points, j, k );
+          XLAL_CHECK( fabs( point_j - points_j_k ) <= value_tol, XLAL_EFAILED, "point[%zu] = %.10g != %.10g = points[%zu,%" LAL_UINT8_FORMAT "]", j, point_j, points_j_k, j, k );
+        }
+        ++k;
+      }
+      XLAL_CHECK( retn == 0, XLAL_EFUNC );
+      XLALDestroyLatticeTilingIterator( itr );
+    }
+    XLAL_CHECK( k == total, XLAL_EFAILED, "k = %" LAL_UINT8_FORMAT " != %" LAL_UINT8_FORMAT " = total, partition count = %u", k, total, partition_counts[p] );
+  }
+  GFVEC( point );
+
+  return XLAL_SUCCESS;
+
+}
+
+static LatticeTiling *BasicTiling(
+  const size_t n,
+  const int *bound_on,
+  const TilingLattice lattice,
+  const double max_mismatch
+  )
+{
+
+  // Create lattice tiling
+  LatticeTiling *tiling = XLALCreateLatticeTiling( n );
+  XLAL_CHECK_NULL( tiling != NULL, XLAL_EFUNC );
+
+  // Add bounds
+  for ( size_t i = 0; i < n; ++i ) {
+    XLAL_CHECK_NULL( bound_on[i] == 0 || bound_on[i] == 1, XLAL_EFAILED );
+    XLAL_CHECK_NULL( XLALSetLatticeTilingConstantBound( tiling, i, 0.0, bound_on[i] * pow( 100.0, 1.0/n ) ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  // Set metric to the Lehmer matrix
+  gsl_matrix *GAMAT_NULL( metric, n, n );
+  for ( size_t i = 0; i < n; ++i ) {
+    for ( size_t j = 0; j < n; ++j ) {
+      const double ii = i+1, jj = j+1;
+      gsl_matrix_set( metric, i, j, jj >= ii ? ii/jj : jj/ii );
+    }
+  }
+  XLAL_CHECK_NULL( XLALSetTilingLatticeAndMetric( tiling, lattice, metric, max_mismatch ) == XLAL_SUCCESS, XLAL_EFUNC );
+  GFMAT( metric );
+
+  return tiling;
+
+}
+
+static int CountsTest(
+  const LatticeTiling *tiling,
+  const size_t n,
+  const int *bound_on,
+  const TilingLattice lattice,
+  const double max_mismatch
+  )
+{
+
+  // Create identical lattice tiling, and perform callbacks in parallel
+  LatticeTiling *tiling_par = BasicTiling( n, bound_on, lattice, max_mismatch );
+  XLAL_CHECK( tiling_par != NULL, XLAL_EFUNC );
+  XLAL_CHECK( XLALSetLatticeTilingCallbackThreads( tiling_par, 3 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLALPerformLatticeTilingCallbacks( tiling_par ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Check that statistics are identical
+  for ( size_t j = 0; j < n; ++j ) {
+    const LatticeTilingStats *stats = XLALLatticeTilingStatistics( tiling, j );
+    XLAL_CHECK( stats != NULL, XLAL_EFUNC );
+    const LatticeTilingStats *stats_par = XLALLatticeTilingStatistics( tiling_par, j );
+    XLAL_CHECK( stats_par != NULL, XLAL_EFUNC );
+    XLAL_CHECK( stats_par->total_points == stats->total_points, XLAL_EFAILED, "stats_par[%zu]->total_points = %" LAL_UINT8_FORMAT " != %" LAL_UINT8_FORMAT " = stats[%zu]->total_points", j, stats_par->total_points, stats->total_points, j );
+    XLAL_CHECK( stats_par->min_points == stats->min_points, XLAL_EFAILED, "stats_par[%zu]->min_points = %u != %u = stats[%zu]->min_points", j, stats_par->min_points, stats->min_points, j );
+    XLAL_CHECK( stats_par->max_points == stats->max_points, XLAL_EFAILED, "stats_par[%zu]->max_points = %u != %u = stats[%zu]->max_points", j, stats_par->max_points, stats->max_points, j );
+    XLAL_CHECK( stats_par->min_value == stats->min_value, XLAL_EFAILED, "stats_par[%zu]->min_value = %.10g != %.10g = stats[%zu]->min_value", j, stats_par->min_value, stats->min_value, j );
+    XLAL_CHECK( stats_par->max_value == stats->max_value, XLAL_EFAILED, "stats_par[%zu]->max_value = %.10g != %.10g = stats[%zu]->max_value", j, stats_par->max_value, stats->max_value, j );
+  }
+
+#if !defined(HAVE_LIBCFITSIO)
+  printf( " skipping serialisation (CFITSIO library is not available) ..." );
+#else // defined(HAVE_LIBCFITSIO)
+
+  // Save point counts to a FITS file
+  {
+    FITSFile *file = XLALFITSFileOpenWrite( "LatticeTilingTest.fits" );
+    XLAL_CHECK( file != NULL, XLAL_EFUNC );
+    XLAL_CHECK( XLALSaveLatticeTilingPointCounts( tiling_par, file, "counts" ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLALFITSFileClose( file );
+  }
+
+  // Create identical lattice tiling, and restore point counts from a FITS file
+  LatticeTiling *tiling_res = BasicTiling( n, bound_on, lattice, max_mismatch );
+  XLAL_CHECK( tiling_res != NULL, XLAL_EFUNC );
+  {
+    FITSFile *file = XLALFITSFileOpenRead( "LatticeTilingTest.fits" );
+    XLAL_CHECK( file != NULL, XLAL_EFUNC );
+    XLAL_CHECK( XLALRestoreLatticeTilingPointCounts( tiling_res, file, "counts" ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLALFITSFileClose( file );
+  }
+
+  // Check that total numbers of points, and partitions of iterators, are identical
+  for ( size_t i = 0; i < n; ++i ) {
+    if ( !XLALIsTiledLatticeTilingDimension( tiling, i ) ) {
+      continue;
+    }
+    const UINT4 partition_count = 3;
+    for ( UINT4 partition_index = 0; partition_index < partition_count; ++partition_index ) {
+      LatticeTilingIterator *itr = XLALCreateLatticeTilingIterator( tiling, i+1 );
+      XLAL_CHECK( itr != NULL, XLAL_EFUNC );
+      XLAL_CHECK( XLALSetLatticeTilingIteratorOuterPartition( itr, partition_count, partition_index ) == XLAL_SUCCESS, XLAL_EFUNC );
+      LatticeTilingIterator *itr_res = XLALCreateLatticeTilingIterator( tiling_res, i+1 );
+      XLAL_CHECK( itr_res != NULL, XLAL_EFUNC );
+      XLAL_CHECK( XLALSetLatticeTilingIteratorOuterPartition( itr_res, partition_count, partition_index ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK( XLALTotalLatticeTilingPoints( itr_res ) == XLALTotalLatticeTilingPoints( itr ), XLAL_EFAILED );
+      int retn = 0;
+      while ( ( retn = XLALNextLatticeTilingPoint( itr, NULL ) ) > 0 ) {
+        XLAL_CHECK( XLALNextLatticeTilingPoint( itr_res, NULL ) > 0, XLAL_EFAILED );
+        XLAL_CHECK( XLALCurrentLatticeTilingIndex( itr_res ) == XLALCurrentLatticeTilingIndex( itr ), XLAL_EFAILED );
+      }
+      XLAL_CHECK( retn == 0, XLAL_EFUNC );
+      XLAL_CHECK( XLALNextLatticeTilingPoint( itr_res, NULL ) == 0, XLAL_EFAILED );
+      XLALDestroyLatticeTilingIterator( itr );
+      XLALDestroyLatticeTilingIterator( itr_res );
+    }
+  }
+
+  // Cleanup
+  XLALDestroyLatticeTiling( tiling_res );
+
+#endif // !defined(HAVE_LIBCFITSIO)
+
+  // Cleanup
+  XLALDestroyLatticeTiling( tiling_par );
+
+  return XLAL_SUCCESS;
+
+}
+
 static int BasicTest(
   const size_t n,
   const int bound_on_0,
@@ -191,28 +413,11 @@ static int BasicTest(
   const int bound_on[4] = {bound_on_0, bound_on_1, bound_on_2, bound_on_3};
   const UINT8 total_ref[4] = {total_ref_0, total_ref_1, total_ref_2, total_ref_3};
 
-  // Create lattice tiling
-  LatticeTiling *tiling = XLALCreateLatticeTiling( n );
-  XLAL_CHECK( tiling != NULL, XLAL_EFUNC );
-
-  // Add bounds
-  for ( size_t i = 0; i < n; ++i ) {
-    XLAL_CHECK( bound_on[i] == 0 || bound_on[i] == 1, XLAL_EFAILED );
-    XLAL_CHECK( XLALSetLatticeTilingConstantBound( tiling, i, 0.0, bound_on[i] * pow( 100.0, 1.0/n ) ) == XLAL_SUCCESS, XLAL_EFUNC );
-  }
-
-  // Set metric to the Lehmer matrix
+  // Create lattice tiling, with the Lehmer matrix as metric
   const double max_mismatch = 0.3;
+  LatticeTiling *tiling = BasicTiling( n, bound_on, lattice, max_mismatch );
+  XLAL_CHECK( tiling != NULL, XLAL_EFUNC );
   {
-    gsl_matrix *GAMAT( metric, n, n );
-    for ( size_t i = 0; i < n; ++i ) {
-      for ( size_t j = 0; j < n; ++j ) {
-        const double ii = i+1, jj = j+1;
-        gsl_matrix_set( metric, i, j, jj >= ii ? ii/jj : jj/ii );
-      }
-    }
-    XLAL_CHECK( XLALSetTilingLatticeAndMetric( tiling, lattice, metric, max_mismatch ) == XLAL_SUCCESS, XLAL_EFUNC );
-    GFMAT( metric );
     printf( "Number of (tiled) dimensions: %zu (%zu)\n", XLALTotalLatticeTilingDimensions( tiling ), XLALTiledLatticeTilingDimensions( tiling ) );
     printf( "  Bounds: %i %i %i %i\n", bound_on_0, bound_on_1, bound_on_2, bound_on_3 );
     printf( "  Lattice type: %i\n", lattice );
@@ -284,6 +489,16 @@ static int BasicTest(
       }
     }
 
+    // Get all points in blocks, check for consistency
+    printf( "  Testing XLALNextLatticeTilingBlock() ..." );
+    XLAL_CHECK( BlockTest( tiling, i+1, points ) == XLAL_SUCCESS, XLAL_EFUNC );
+    printf( " done\n" );
+
+    // Get all points with outer partitions, check for consistency
+    printf( "  Testing XLALSetLatticeTilingIteratorOuterPartition() ..." );
+    XLAL_CHECK( OuterPartitionTest( tiling, i+1, points ) == XLAL_SUCCESS, XLAL_EFUNC );
+    printf( " done\n" );
+
     // Get nearest points to each template, check for consistency
     printf( "  Testing XLALNearestLatticeTiling{Point|Block}() ..." );
     gsl_vector *GAVEC( nearest, n );
@@ -351,6 +566,11 @@ static int BasicTest(
 
   }
 
+  // Perform parallel callbacks and point counts test
+  printf( "Testing XLALSetLatticeTilingCallbackThreads() and XLAL{Save|Restore}LatticeTilingPointCounts() ..." );
+  XLAL_CHECK( CountsTest( tiling, n, bound_on, lattice, max_mismatch ) == XLAL_SUCCESS, XLAL_EFUNC );
+  printf( " done\n" );
+
   // Perform serialisation test
   XLAL_CHECK( SerialisationTest( tiling, total_ref[n-1], total_tol, total_ref_0, total_ref_1, total_ref_2, total_ref_3 ) == XLAL_SUCCESS, XLAL_EFUNC );
 
@@ -676,7 +896,7 @@ static int SuperskyTests(
                                             TEST_PKG_DATA_DIR "sun00-19-DE405.dat.gz" );
   XLAL_CHECK( edat != NULL, XLAL_EFUNC );
   const double freq_max = 40.0;
-  SuperskyMetrics *metrics = XLALComputeSuperskyMetrics( SUPERSKY_METRIC_TYPE, 1, &ref_time, &segments, freq_max, &detectors, NULL, DETMOTION_SPIN | DETMOTION_PTOLEORBIT, edat );
+  SuperskyMetrics *metrics = XLALComputeSuperskyMetrics( SUPERSKY_METRIC_TYPE, 1, &ref_time, &segments, freq_max, &detectors, NULL, DETMOTION_SPIN | DETMOTION_PTOLEORBIT, edat, 1 );
   XLAL_CHECK( metrics != NULL, XLAL_EFUNC );
   XLAL_CHECK( metrics->num_segments == segments.length, XLAL_EFAILED );
 
@@ -0,0 +1,321 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+/**
+ * \file
+ * \brief Tests for the cross-correlation statistic engines in PulsarCrossCorr_v2.h
+ *
+ * Checks that XLALCalculatePulsarCrossCorrStatisticEngine() agrees with XLALCalculatePulsarCrossCorrStatistic() for
+ * random SFT data, phases and sinc factors, and that XLALCalculatePulsarCrossCorrStatisticResampEngine() agrees with
+ * XLALCalculatePulsarCrossCorrStatisticResamp() for resampled time series of simulated Gaussian noise and a binary
+ * signal, for the same templates and with one and several threads.
+ */
+
+#include <math.h>
+#include <stdlib.h>
+
+#include <lal/LALInitBarycenter.h>
+#include <lal/ComputeFstat.h>
+#include <lal/PulsarCrossCorr_v2.h>
+
+static int test_pair_engine ( void );
+static int test_resamp_engine ( void );
+
+int main( void )
+{
+
+  XLAL_CHECK_MAIN ( test_pair_engine() == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN ( test_resamp_engine() == XLAL_SUCCESS, XLAL_EFUNC );
+
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+
+}
+
+/* Compare XLALCalculatePulsarCrossCorrStatisticEngine() against XLALCalculatePulsarCrossCorrStatistic() */
+static int test_pair_engine ( void )
+{
+
+  const UINT4 numDetectors = 2;
+  const UINT4 numSFTsPerDet = 40;
+  const UINT4 numSFTBins = 64;
+  const REAL8 Tsft = 1800;
+  const REAL8 maxLag = 3 * Tsft;
+  const REAL8 tolerance = 1e-5;
+
+  /* create SFTs of random data */
+  srand ( 1618 );
+  UINT4Vector *numSFTs = XLALCreateUINT4Vector ( numDetectors );
+  XLAL_CHECK ( numSFTs != NULL, XLAL_EFUNC );
+  for ( UINT4 X = 0; X < numDetectors; ++X ) {
+    numSFTs->data[X] = numSFTsPerDet - X;
+  }
+  MultiSFTVector *inputSFTs = XLALCreateMultiSFTVector ( numSFTBins, numSFTs );
+  XLAL_CHECK ( inputSFTs != NULL, XLAL_EFUNC );
+  for ( UINT4 X = 0; X < numDetectors; ++X ) {
+    for ( UINT4 i = 0; i < inputSFTs->data[X]->length; ++i ) {
+      SFTtype *sft = &inputSFTs->data[X]->data[i];
+      sft->epoch.gpsSeconds = 800000000 + ( i + X ) * Tsft;
+      sft->deltaF = 1.0 / Tsft;
+      for ( UINT4 k = 0; k < numSFTBins; ++k ) {
+        sft->data->data[k] = crectf ( 2.0 * rand() / RAND_MAX - 1.0, 2.0 * rand() / RAND_MAX - 1.0 );
+      }
+    }
+  }
+
+  /* create lists of SFTs and SFT pairs */
+  SFTIndexList *sftIndices = NULL;
+  XLAL_CHECK ( XLALCreateSFTIndexListFromMultiSFTVect ( &sftIndices, inputSFTs ) == XLAL_SUCCESS, XLAL_EFUNC );
+  SFTPairIndexList *sftPairs = NULL;
+  XLAL_CHECK ( XLALCreateSFTPairIndexList ( &sftPairs, sftIndices, inputSFTs, maxLag, 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  const UINT4 numAllSFTs = sftIndices->length;
+  const UINT4 numPairs = sftPairs->length;
+  XLAL_CHECK ( numPairs > 0, XLAL_EFAILED );
+
+  /* random curly G amplitudes, and normalization */
+  REAL8Vector *curlyGAmp = XLALCreateREAL8Vector ( numPairs );
+  XLAL_CHECK ( curlyGAmp != NULL, XLAL_EFUNC );
+  for ( UINT4 alpha = 0; alpha < numPairs; ++alpha ) {
+    curlyGAmp->data[alpha] = 2.0 * rand() / RAND_MAX - 1.0;
+  }
+  MultiNoiseWeights XLAL_INIT_DECL( multiWeights );
+  multiWeights.Sinv_Tsft = 0.7;
+
+  COMPLEX8Vector *expSignalPhases = XLALCreateCOMPLEX8Vector ( numAllSFTs );
+  XLAL_CHECK ( expSignalPhases != NULL, XLAL_EFUNC );
+  UINT4Vector *lowestBins = XLALCreateUINT4Vector ( numAllSFTs );
+  XLAL_CHECK ( lowestBins != NULL, XLAL_EFUNC );
+
+  for ( UINT4 numBins = 1; numBins <= 4; ++numBins ) {
+
+    /* random signal phases, lowest bins and sinc factors for one template */
+    REAL8VectorSequence *sincList = XLALCreateREAL8VectorSequence ( numAllSFTs, numBins );
+    XLAL_CHECK ( sincList != NULL, XLAL_EFUNC );
+    for ( UINT4 sftNum = 0; sftNum < numAllSFTs; ++sftNum ) {
+      const REAL8 phase = LAL_TWOPI * rand() / RAND_MAX;
+      expSignalPhases->data[sftNum] = crectf ( cos ( phase ), sin ( phase ) );
+      lowestBins->data[sftNum] = rand() % ( numSFTBins - numBins + 1 );
+      for ( UINT4 j = 0; j < numBins; ++j ) {
+        sincList->data[sftNum * numBins + j] = 2.0 * rand() / RAND_MAX - 1.0;
+      }
+    }
+
+    /* reference statistic */
+    REAL8 refCCStat = 0, refEvSquared = 0;
+    XLAL_CHECK ( XLALCalculatePulsarCrossCorrStatistic ( &refCCStat, &refEvSquared, curlyGAmp, expSignalPhases, lowestBins, sincList, sftPairs, sftIndices, inputSFTs, &multiWeights, numBins ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    /* engine statistic, with one and several threads */
+    for ( UINT4 numThreads = 1; numThreads <= 3; ++numThreads ) {
+      CrossCorrPairEngine *engine = NULL;
+      XLAL_CHECK ( XLALCreateCrossCorrPairEngine ( &engine, sftPairs, sftIndices, inputSFTs, curlyGAmp, numThreads ) == XLAL_SUCCESS, XLAL_EFUNC );
+      REAL8 ccStat = 0, evSquared = 0;
+      XLAL_CHECK ( XLALCalculatePulsarCrossCorrStatisticEngine ( &ccStat, &evSquared, engine, expSignalPhases, lowestBins, sincList, &multiWeights, numBins ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLALDestroyCrossCorrPairEngine ( engine );
+      const REAL8 errCCStat = fabs ( ccStat - refCCStat ) / fmax ( 1.0, fabs ( refCCStat ) );
+      const REAL8 errEvSquared = fabs ( evSquared - refEvSquared ) / refEvSquared;
+      printf ( "pair engine, numBins=%u, numThreads=%u: rho = %.10g (reference %.10g), E[rho]^2/h0^4 = %.10g (reference %.10g)\n", numBins, numThreads, ccStat, refCCStat, evSquared, refEvSquared );
+      XLAL_CHECK ( errCCStat <= tolerance, XLAL_ETOL, "Engine rho = %.10g differs from reference %.10g by %g > %g", ccStat, refCCStat, errCCStat, tolerance );
+      XLAL_CHECK ( errEvSquared <= tolerance, XLAL_ETOL, "Engine E[rho]^2/h0^4 = %.10g differs from reference %.10g by %g > %g", evSquared, refEvSquared, errEvSquared, tolerance );
+    }
+
+    XLALDestroyREAL8VectorSequence ( sincList );
+
+  }
+
+  /* cleanup */
+  XLALDestroyCOMPLEX8Vector ( expSignalPhases );
+  XLALDestroyUINT4Vector ( lowestBins );
+  XLALDestroyREAL8Vector ( curlyGAmp );
+  XLALDestroySFTPairIndexList ( sftPairs );
+  XLALDestroySFTIndexList ( sftIndices );
+  XLALDestroyMultiSFTVector ( inputSFTs );
+  XLALDestroyUINT4Vector ( numSFTs );
+
+  return XLAL_SUCCESS;
+
+}
+
+/* Compare XLALCalculatePulsarCrossCorrStatisticResampEngine() against XLALCalculatePulsarCrossCorrStatisticResamp() */
+static int test_resamp_engine ( void )
+{
+
+  const REAL8 Tsft = 180;
+  const REAL8 Tspan = 6 * 3600;
+  const REAL8 maxLag = Tsft;
+  const LIGOTimeGPS startTime = { 827884814, 0 };
+  const REAL8 fStart = 149.9995, fBand = 0.001, dFreqMetric = 1e-4;
+  const REAL8 asini = 1.40, asiniBand = 0.10, period = 68023.7136, tAsc = 1245967374;
+  const UINT4 numFreqBins = ( UINT4 ) round ( fBand / dFreqMetric ) + 1;
+  const REAL8 tolerance = 1e-4;
+
+  /* load ephemerides */
+  EphemerisData *edat = XLALInitBarycenter ( TEST_PKG_DATA_DIR "earth00-19-DE405.dat.gz", TEST_PKG_DATA_DIR "sun00-19-DE405.dat.gz" );
+  XLAL_CHECK ( edat != NULL, XLAL_EFUNC );
+
+  /* create a catalog of fake SFTs for two detectors, with the same timestamps */
+  LALStringVector *detNames = XLALCreateStringVector ( "H1", "L1", NULL );
+  XLAL_CHECK ( detNames != NULL, XLAL_EFUNC );
+  MultiLIGOTimeGPSVector *multiTimes = XLALMakeMultiTimestamps ( startTime, Tspan, Tsft, 0, detNames->length );
+  XLAL_CHECK ( multiTimes != NULL, XLAL_EFUNC );
+  SFTCatalog *catalog = XLALMultiAddToFakeSFTCatalog ( NULL, detNames, multiTimes );
+  XLAL_CHECK ( catalog != NULL, XLAL_EFUNC );
+
+  /* inject Gaussian noise and a binary signal */
+  PulsarParamsVector *injectSources = XLALCreatePulsarParamsVector ( 1 );
+  XLAL_CHECK ( injectSources != NULL, XLAL_EFUNC );
+  injectSources->data[0].Amp.aPlus = 3.0;
+  injectSources->data[0].Amp.aCross = 0;
+  injectSources->data[0].Amp.psi = 0;
+  injectSources->data[0].Amp.phi0 = 0;
+  injectSources->data[0].Doppler.Alpha = 4.2756992385;
+  injectSources->data[0].Doppler.Delta = -0.272973858335;
+  injectSources->data[0].Doppler.fkdot[0] = fStart + 0.5 * fBand;
+  injectSources->data[0].Doppler.refTime = startTime;
+  injectSources->data[0].Doppler.asini = asini + 0.5 * asiniBand;
+  injectSources->data[0].Doppler.period = period;
+  XLALGPSSetREAL8 ( &injectSources->data[0].Doppler.tp, tAsc );
+  MultiNoiseFloor XLAL_INIT_DECL( injectSqrtSX );
+  injectSqrtSX.length = detNames->length;
+  for ( UINT4 X = 0; X < injectSqrtSX.length; ++X ) {
+    injectSqrtSX.sqrtSn[X] = 1.0;
+  }
+
+  /* create resampling F-statistic input, covering the band of a signal with the given binary orbits */
+  XLAL_CHECK ( setenv ( "LAL_FSTAT_FFT_PLAN_MODE", "ESTIMATE", 1 ) == 0, XLAL_ESYS );
+  FstatOptionalArgs optionalArgs = FstatOptionalArgsDefaults;
+  optionalArgs.Dterms = 8;
+  optionalArgs.FstatMethod = FMETHOD_RESAMP_BEST;
+  optionalArgs.runningMedianWindow = 100;
+  optionalArgs.resampFFTPowerOf2 = 0;
+  optionalArgs.randSeed = 2718;
+  optionalArgs.injectSources = injectSources;
+  optionalArgs.injectSqrtSX = &injectSqrtSX;
+  REAL8 extraPerFreq = 1.05 * LAL_TWOPI / LAL_C_SI * ( ( LAL_AU_SI / LAL_YRSID_SI ) + ( LAL_REARTH_SI / LAL_DAYSID_SI ) );
+  extraPerFreq += LAL_TWOPI / period * ( asini + asiniBand );
+  const REAL8 fCoverMin = fStart * ( 1.0 - extraPerFreq );
+  const REAL8 fCoverMax = ( fStart + fBand ) * ( 1.0 + extraPerFreq );
+  FstatInput *input = XLALCreateFstatInput ( catalog, fCoverMin, fCoverMax, 1.0 / Tspan, edat, &optionalArgs );
+  XLAL_CHECK ( input != NULL, XLAL_EFUNC );
+
+  /* create resampling list of SFT pairs, with tShort equal to Tsft */
+  MultiResampSFTPairMultiIndexList *resampMultiPairs = NULL;
+  XLAL_CHECK ( XLALCreateSFTPairIndexListShortResamp ( &resampMultiPairs, maxLag, 0, 1, Tsft, multiTimes ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK ( resampMultiPairs->allPairCount > 0, XLAL_EFAILED );
+
+  /* random curly G amplitudes, and normalization */
+  srand ( 3141 );
+  REAL8Vector *resampCurlyGAmp = XLALCreateREAL8Vector ( resampMultiPairs->allPairCount );
+  XLAL_CHECK ( resampCurlyGAmp != NULL, XLAL_EFUNC );
+  for ( UINT4 alpha = 0; alpha < resampCurlyGAmp->length; ++alpha ) {
+    resampCurlyGAmp->data[alpha] = 0.5 + 1.0 * rand() / RAND_MAX;
+  }
+  MultiNoiseWeights XLAL_INIT_DECL( multiWeights );
+  multiWeights.Sinv_Tsft = 0.7;
+
+  /* create workspace, with the Fa/Fb holders used by XLALCalculatePulsarCrossCorrStatisticResamp() */
+  PulsarDopplerParams XLAL_INIT_DECL( binaryTemplateSpacings );
+  binaryTemplateSpacings.fkdot[0] = dFreqMetric;
+  ResampCrossCorrWorkspace *ws = NULL;
+  COMPLEX8 *ws1KFaX_k = NULL, *ws1KFbX_k = NULL, *ws2LFaX_k = NULL, *ws2LFbX_k = NULL;
+  MultiCOMPLEX8TimeSeries *multiTimeSeries_SRC_a = NULL, *multiTimeSeries_SRC_b = NULL;
+  XLAL_CHECK ( XLALCreateCrossCorrWorkspace ( &ws, &ws1KFaX_k, &ws1KFbX_k, &ws2LFaX_k, &ws2LFbX_k, &multiTimeSeries_SRC_a, &multiTimeSeries_SRC_b, binaryTemplateSpacings, input, numFreqBins, 2 * maxLag + Tsft, 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  /* create engines with one and several threads */
+  const UINT4 numEngines = 3;
+  ResampCrossCorrEngine *engines[numEngines];
+  for ( UINT4 e = 0; e < numEngines; ++e ) {
+    engines[e] = NULL;
+    XLAL_CHECK ( XLALCreateResampCrossCorrEngine ( &engines[e], ws, resampMultiPairs, resampCurlyGAmp, e + 1 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  REAL8Vector *refCCStat = XLALCreateREAL8Vector ( numFreqBins );
+  REAL8Vector *refEvSquared = XLALCreateREAL8Vector ( numFreqBins );
+  REAL8Vector *ccStat = XLALCreateREAL8Vector ( numFreqBins );
+  REAL8Vector *evSquared = XLALCreateREAL8Vector ( numFreqBins );
+  REAL8Vector *numeEquivAve = XLALCreateREAL8Vector ( numFreqBins );
+  REAL8Vector *numeEquivCirc = XLALCreateREAL8Vector ( numFreqBins );
+  XLAL_CHECK ( refCCStat != NULL && refEvSquared != NULL && ccStat != NULL && evSquared != NULL && numeEquivAve != NULL && numeEquivCirc != NULL, XLAL_EFUNC );
+
+  /* compare statistics for templates with different binary orbits */
+  FstatResults *Fstats = NULL;
+  for ( UINT4 a = 0; a < 3; ++a ) {
+
+    PulsarDopplerParams XLAL_INIT_DECL( dopplerpos );
+    dopplerpos.Alpha = injectSources->data[0].Doppler.Alpha;
+    dopplerpos.Delta = injectSources->data[0].Doppler.Delta;
+    dopplerpos.fkdot[0] = fStart;
+    dopplerpos.refTime = startTime;
+    dopplerpos.asini = asini + 0.5 * a * asiniBand;
+    dopplerpos.period = period;
+    XLALGPSSetREAL8 ( &dopplerpos.tp, tAsc );
+
+    /* compute resampled time series */
+    XLAL_CHECK ( XLALComputeFstat ( &Fstats, input, &dopplerpos, numFreqBins, FSTATQ_NONE ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK ( XLALExtractResampledTimeseries ( &multiTimeSeries_SRC_a, &multiTimeSeries_SRC_b, input ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    /* reference statistic */
+    XLAL_CHECK ( XLALCalculatePulsarCrossCorrStatisticResamp ( refCCStat, refEvSquared, numeEquivAve, numeEquivCirc, resampCurlyGAmp, resampMultiPairs, &multiWeights, &binaryTemplateSpacings, &dopplerpos, multiTimeSeries_SRC_a, multiTimeSeries_SRC_b, ws, ws1KFaX_k, ws1KFbX_k, ws2LFaX_k, ws2LFbX_k ) == XLAL_SUCCESS, XLAL_EFUNC );
+    REAL8 maxRefCCStat = 0;
+    for ( UINT4 j = 0; j < numFreqBins; ++j ) {
+      maxRefCCStat = fmax ( maxRefCCStat, fabs ( refCCStat->data[j] ) );
+    }
+    XLAL_CHECK ( maxRefCCStat > 0, XLAL_EFAILED );
+
+    /* engine statistics */
+    for ( UINT4 e = 0; e < numEngines; ++e ) {
+      XLAL_CHECK ( XLALCalculatePulsarCrossCorrStatisticResampEngine ( ccStat, evSquared, numeEquivAve, numeEquivCirc, engines[e], &multiWeights, &binaryTemplateSpacings, &dopplerpos, multiTimeSeries_SRC_a, multiTimeSeries_SRC_b ) == XLAL_SUCCESS, XLAL_EFUNC );
+      REAL8 maxErrCCStat = 0, maxErrEvSquared = 0;
+      for ( UINT4 j = 0; j < numFreqBins; ++j ) {
+        maxErrCCStat = fmax ( maxErrCCStat, fabs ( ccStat->data[j] - refCCStat->data[j] ) / maxRefCCStat );
+        maxErrEvSquared = fmax ( maxErrEvSquared, fabs ( evSquared->data[j] - refEvSquared->data[j] ) / refEvSquared->data[j] );
+      }
+      printf ( "resampling engine, asini=%g, numThreads=%u: max. rho = %.10g, max. relative error in rho = %.3g, in E[rho]^2/h0^4 = %.3g\n", dopplerpos.asini, e + 1, maxRefCCStat, maxErrCCStat, maxErrEvSquared );
+      XLAL_CHECK ( maxErrCCStat <= tolerance, XLAL_ETOL, "Engine rho differs from reference by %g > %g", maxErrCCStat, tolerance );
+      XLAL_CHECK ( maxErrEvSquared <= tolerance, XLAL_ETOL, "Engine E[rho]^2/h0^4 differs from reference by %g > %g", maxErrEvSquared, tolerance );
+    }
+
+  }
+
+  /* cleanup */
+  XLALDestroyREAL8Vector ( refCCStat );
+  XLALDestroyREAL8Vector ( refEvSquared );
+  XLALDestroyREAL8Vector ( ccStat );
+  XLALDestroyREAL8Vector ( evSquared );
+  XLALDestroyREAL8Vector ( numeEquivAve );
+  XLALDestroyREAL8Vector ( numeEquivCirc );
+  for ( UINT4 e = 0; e < numEngines; ++e ) {
+    XLALDestroyResampCrossCorrEngine ( engines[e] );
+  }
+  XLALDestroyResampCrossCorrWorkspace ( ws );
+  fftw_free ( ws1KFaX_k );
+  fftw_free ( ws1KFbX_k );
+  fftw_free ( ws2LFaX_k );
+  fftw_free ( ws2LFbX_k );
+  XLALDestroyFstatResults ( Fstats );
+  XLALDestroyREAL8Vector ( resampCurlyGAmp );
+  XLALDestroyMultiResampSFTPairMultiIndexList ( resampMultiPairs );
+  XLALDestroyFstatInput ( input );
+  XLALDestroyPulsarParamsVector ( injectSources );
+  XLALDestroySFTCatalog ( catalog );
+  XLALDestroyMultiTimestamps ( multiTimes );
+  XLALDestroyStringVector ( detNames );
+  XLALDestroyEphemerisData ( edat );
+
+  return XLAL_SUCCESS;
+
+}
@@ -25,6 +25,7 @@
 #include <lal/SFTfileIO.h>
 #include <lal/SFTutils.h>
 #include <lal/Units.h>
+#include <lal/LogPrintf.h>
 
 /*---------- DEFINES ----------*/
 /**
@@ -45,6 +46,25 @@
 /* ----------------------------------------------------------------------*/
 
 static int CompareSFTVectors(SFTVector *sft_vect, SFTVector *sft_vect2);
+static UINT8 ReferenceCRC64(const unsigned char *data, UINT4 length, UINT8 crc);
+
+/* reference byte-at-a-time CRC64, as given in the SFTv2 specification */
+static UINT8 ReferenceCRC64(const unsigned char *data, UINT4 length, UINT8 crc)
+{
+  UINT8 CRCTable[256];
+  for (UINT4 i = 0; i < 256; i++) {
+    UINT8 part = i;
+    for (UINT4 j = 0; j < 8; j++) {
+      part = (part & 1) ? (part >> 1) ^ 0xd800000000000000ULL : (part >> 1);
+    }
+    CRCTable[i] = part;
+  }
+  for (UINT4 i = 0; i < length; i++) {
+    crc = (crc >> 8) ^ CRCTable[(crc ^ data[i]) & 0xff];
+  }
+  return crc;
+}
+
 static int CompareSFTVectors(SFTVector *sft_vect, SFTVector *sft_vect2)
 {
   UINT4 sft,bin;
@@ -152,6 +172,62 @@ int main( void )
       return EXIT_FAILURE;
     }
 
+  /* ---------- check fast CRC64 against reference implementation, and time it ---------- */
+  {
+    const UINT4 len = 1 << 20;
+    unsigned char *buf = XLALCalloc ( len, 1 );
+    XLAL_CHECK_MAIN ( buf != NULL, XLAL_ENOMEM );
+    srand ( 1234 );
+    for ( UINT4 i = 0; i < len; i ++ ) {
+      buf[i] = rand() & 0xff;
+    }
+
+    /* check all alignments and short lengths, and data checksummed in chunks */
+    for ( UINT4 off = 0; off < 8; off ++ ) {
+      for ( UINT4 n = 0; n < 64; n ++ ) {
+        XLAL_CHECK_MAIN ( XLALComputeCRC64 ( buf + off, n, ~(0ULL) ) == ReferenceCRC64 ( buf + off, n, ~(0ULL) ), XLAL_EFAILED,
+                          "XLALComputeCRC64() differs from reference for offset=%u, length=%u\n", off, n );
+      }
+    }
+    UINT8 crc_ref = ReferenceCRC64 ( buf, len, ~(0ULL) );
+    UINT8 crc_chunk = ~(0ULL);
+    for ( UINT4 i = 0, n = 1; i < len; i += n, n = 3*n + 1 ) {
+      crc_chunk = XLALComputeCRC64 ( buf + i, ( i + n < len ) ? n : len - i, crc_chunk );
+    }
+    XLAL_CHECK_MAIN ( crc_chunk == crc_ref, XLAL_EFAILED, "Chunked XLALComputeCRC64() differs from reference\n" );
+
+    /* time reference and fast CRC64, checksumming the buffer repeatedly as one data stream */
+    const UINT4 Nrep = 20;
+    UINT8 crc_fast = ~(0ULL);
+    crc_ref = ~(0ULL);
+    REAL8 tic = XLALGetCPUTime();
+    for ( UINT4 r = 0; r < Nrep; r ++ ) {
+      crc_ref = ReferenceCRC64 ( buf, len, crc_ref );
+    }
+    REAL8 toc = XLALGetCPUTime();
+    const REAL8 time_ref = ( toc - tic ) / Nrep;
+    tic = XLALGetCPUTime();
+    for ( UINT4 r = 0; r < Nrep; r ++ ) {
+      crc_fast = XLALComputeCRC64 ( buf, len, crc_fast );
+    }
+    toc = XLALGetCPUTime();
+    const REAL8 time_fast = ( toc - tic ) / Nrep;
+    XLAL_CHECK_MAIN ( crc_fast == crc_ref, XLAL_EFAILED, "XLALComputeCRC64() differs from reference\n" );
+    XLALPrintInfo ( "CRC64 of %u MB: reference %.3g s (%.3g MB/s), XLALComputeCRC64() %.3g s (%.3g MB/s)\n",
+                    len >> 20, time_ref, ( len >> 20 ) / time_ref, time_fast, ( len >> 20 ) / time_fast );
+
+    XLALFree ( buf );
+
+    /* time CRC validation of a catalog */
+    XLAL_CHECK_MAIN ( ( catalog = XLALSFTdataFind ( TEST_DATA_DIR "SFT-test[1235]*", NULL ) ) != NULL, XLAL_EFUNC );
+    tic = XLALGetTimeOfDay();
+    XLAL_CHECK_MAIN ( XLALCheckCRCSFTCatalog (&crc_check, catalog ) == XLAL_SUCCESS, XLAL_EFUNC );
+    toc = XLALGetTimeOfDay();
+    XLAL_CHECK_MAIN ( crc_check, XLAL_EFAILED, "XLALCheckCRCSFTCatalog() failed on valid SFTs 'SFT-test[1235]*'\n" );
+    XLALPrintInfo ( "XLALCheckCRCSFTCatalog() of %u SFTs: %.3g s\n", catalog->length, toc - tic );
+    XLALDestroySFTCatalog(catalog);
+  }
+
   /* check that proper v2-SFTs are read-in properly */
   XLAL_CHECK_MAIN ( ( catalog = XLALSFTdataFind ( TEST_DATA_DIR "SFT-test1", NULL ) ) != NULL, XLAL_EFUNC ); XLALClearErrno();
   XLALDestroySFTCatalog(catalog);
@@ -218,6 +294,64 @@ int main( void )
       } /* for X < numIFOs */
   } /* ------ */
 
+  /* compare results from XLALLoadMultiSFTs() and the memory-mapped loaders, over the full band and a sub-band */
+  {
+    MultiSFTVector *multsft_mapped = NULL, *multsft_band = NULL, *multsft_band_mapped = NULL;
+    MappedSFTVector *mapped_view = NULL;
+    XLAL_CHECK_MAIN ( ( catalog = XLALSFTdataFind ( TEST_DATA_DIR "SFT-test[123]*;" TEST_DATA_DIR "SFT-test[5]*", NULL ) ) != NULL, XLAL_EFUNC );
+    const REAL8 fMin = catalog->data[0].header.f0 + catalog->data[0].header.deltaF;
+    const REAL8 fMax = catalog->data[0].header.f0 + 2 * catalog->data[0].header.deltaF;
+    XLAL_CHECK_MAIN ( ( multsft_mapped = XLALLoadMultiSFTsMapped ( catalog, -1, -1 ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN ( ( multsft_band = XLALLoadMultiSFTs ( catalog, fMin, fMax ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN ( ( multsft_band_mapped = XLALLoadMultiSFTsMapped ( catalog, fMin, fMax ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN ( ( sft_vect2 = XLALLoadSFTsMapped ( catalog, -1, -1 ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN ( ( mapped_view = XLALMapSFTs ( catalog, -1, -1 ) ) != NULL, XLAL_EFUNC );
+    XLALDestroySFTCatalog(catalog);
+
+    XLAL_CHECK_MAIN ( CompareSFTVectors ( sft_vect, sft_vect2 ) == 0, XLAL_EFAILED, "XLALLoadSFTsMapped() differs from XLALLoadSFTs()" );
+    XLAL_CHECK_MAIN ( CompareSFTVectors ( sft_vect, mapped_view->sfts ) == 0, XLAL_EFAILED, "XLALMapSFTs() differs from XLALLoadSFTs()" );
+    XLAL_CHECK_MAIN ( multsft_mapped->length == multsft_vect->length, XLAL_EFAILED );
+    XLAL_CHECK_MAIN ( multsft_band_mapped->length == multsft_band->length, XLAL_EFAILED );
+    for ( UINT4 X = 0; X < multsft_vect->length; X ++ )
+      {
+        XLAL_CHECK_MAIN ( CompareSFTVectors ( multsft_vect->data[X], multsft_mapped->data[X] ) == 0, XLAL_EFAILED, "XLALLoadMultiSFTsMapped(): sft-vectors differ for X=%d", X );
+        XLAL_CHECK_MAIN ( CompareSFTVectors ( multsft_band->data[X], multsft_band_mapped->data[X] ) == 0, XLAL_EFAILED, "XLALLoadMultiSFTsMapped(): band sft-vectors differ for X=%d", X );
+      }
+
+    XLALDestroySFTVector ( sft_vect2 );
+    sft_vect2 = NULL;
+    XLALDestroyMappedSFTVector ( mapped_view );
+    XLALDestroyMultiSFTVector ( multsft_mapped );
+    XLALDestroyMultiSFTVector ( multsft_band );
+    XLALDestroyMultiSFTVector ( multsft_band_mapped );
+  }
+
+  /* check that SFTs found through an SFT catalog index are identical */
+  {
+    SFTCatalog *index_catalog = NULL;
+    XLAL_CHECK_MAIN ( ( catalog = XLALSFTdataFind ( TEST_DATA_DIR "SFT-test[123]*;" TEST_DATA_DIR "SFT-test[5]*", NULL ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN ( XLALWriteSFTCatalogIndex ( catalog, "SFTfileIOTest-index.txt" ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN ( ( index_catalog = XLALSFTdataFind ( "index:SFTfileIOTest-index.txt", NULL ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN ( index_catalog->length == catalog->length, XLAL_EFAILED );
+    for ( UINT4 i = 0; i < catalog->length; i ++ )
+      {
+        const SFTDescriptor *desc1 = &(catalog->data[i]), *desc2 = &(index_catalog->data[i]);
+        CHAR locator1[512];
+        XLAL_CHECK_MAIN ( snprintf ( locator1, sizeof(locator1), "%s", XLALshowSFTLocator ( desc1->locator ) ) < (int)sizeof(locator1), XLAL_EFAILED );
+        XLAL_CHECK_MAIN ( strcmp ( locator1, XLALshowSFTLocator ( desc2->locator ) ) == 0, XLAL_EFAILED );
+        XLAL_CHECK_MAIN ( strcmp ( desc1->header.name, desc2->header.name ) == 0, XLAL_EFAILED );
+        XLAL_CHECK_MAIN ( desc1->header.epoch.gpsSeconds == desc2->header.epoch.gpsSeconds && desc1->header.epoch.gpsNanoSeconds == desc2->header.epoch.gpsNanoSeconds, XLAL_EFAILED );
+        XLAL_CHECK_MAIN ( desc1->header.f0 == desc2->header.f0 && desc1->header.deltaF == desc2->header.deltaF, XLAL_EFAILED );
+        XLAL_CHECK_MAIN ( desc1->numBins == desc2->numBins && desc1->version == desc2->version && desc1->crc64 == desc2->crc64, XLAL_EFAILED );
+        /* a missing or empty comment is recorded as missing */
+        const CHAR *comment1 = ( desc1->comment != NULL ) ? desc1->comment : "";
+        const CHAR *comment2 = ( desc2->comment != NULL ) ? desc2->comment : "";
+        XLAL_CHECK_MAIN ( strcmp ( comment1, comment2 ) == 0, XLAL_EFAILED );
+      }
+    XLALDestroySFTCatalog ( index_catalog );
+    XLALDestroySFTCatalog ( catalog );
+  }
+
   /* ----- v2 SFT writing ----- */
   /* write v2-SFT to disk */
   XLAL_CHECK_MAIN ( XLALWriteSFT2file(&(multsft_vect->data[0]->data[0]), "outputsftv2_r1.sft", "A v2-SFT file for testing!") == XLAL_SUCCESS, XLAL_EFUNC );
@@ -0,0 +1,191 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+/**
+ * \file
+ * \brief Test for XLALStreamingHeterodyneProcess().
+ *
+ * Signals from two pulsars, whose phases are computed by barycentring every sample with
+ * XLALHeterodynedPulsarPhaseDifference(), are heterodyned and decimated in unevenly-sized chunks. The output for each
+ * pulsar must be constant and equal to its complex amplitude, and must not depend on the chunking or the number of
+ * threads.
+ */
+
+#include <math.h>
+#include <string.h>
+#include <complex.h>
+
+#include <lal/Date.h>
+#include <lal/AVFactories.h>
+#include <lal/TimeSeries.h>
+#include <lal/Units.h>
+#include <lal/LALInitBarycenter.h>
+#include <lal/HeterodynedPulsarModel.h>
+#include <lal/StreamingHeterodyne.h>
+
+#define NUM_PULSARS 2
+
+static int RunHeterodyne( COMPLEX16 **out, UINT4 *numOut, LIGOTimeGPS *outEpoch, PulsarParameters **pulsars, const LALDetector *det,
+                          const EphemerisData *edat, const TimeCorrectionData *tdat, const REAL8TimeSeries *data, UINT4 decimation,
+                          const UINT4 *chunks, UINT4 numChunks, UINT4 numThreads );
+
+int main( void )
+{
+
+  const LIGOTimeGPS t0 = { 900000000, 0 };
+  const REAL8 Tdata = 3600;
+  const REAL8 deltaT = 1.0 / 128;
+  const UINT4 decimation = 128;
+  const REAL8 freqFactor = 2.0;
+
+  EphemerisData *edat;
+  XLAL_CHECK_MAIN( ( edat = XLALInitBarycenter( TEST_PKG_DATA_DIR "earth00-19-DE405.dat.gz", TEST_PKG_DATA_DIR "sun00-19-DE405.dat.gz" ) ) != NULL, XLAL_EFUNC );
+  TimeCorrectionData *tdat;
+  XLAL_CHECK_MAIN( ( tdat = XLALInitTimeCorrections( TEST_PKG_DATA_DIR "te405_2000-2019.dat.gz" ) ) != NULL, XLAL_EFUNC );
+  const LALDetector *det = &lalCachedDetectors[LAL_LHO_4K_DETECTOR];
+
+  /* two isolated pulsars, with signals well separated in frequency */
+  const REAL8 F0[NUM_PULSARS] = { 12.3, 31.7 };
+  const REAL8 F1[NUM_PULSARS] = { -1e-11, -3e-10 };
+  const REAL8 ra[NUM_PULSARS] = { 1.2, 4.5 };
+  const REAL8 dec[NUM_PULSARS] = { -0.3, 0.8 };
+  const COMPLEX16 amp[NUM_PULSARS] = { 0.5 * cexp( 0.3 * I ), 0.25 * cexp( -2.0 * I ) };
+  PulsarParameters *pulsars[NUM_PULSARS];
+  for ( UINT4 p = 0; p < NUM_PULSARS; p++ ) {
+    XLAL_CHECK_MAIN( ( pulsars[p] = XLALCalloc( 1, sizeof( *pulsars[p] ) ) ) != NULL, XLAL_ENOMEM );
+    REAL8Vector *freqs = XLALCreateREAL8Vector( 2 );
+    XLAL_CHECK_MAIN( freqs != NULL, XLAL_EFUNC );
+    freqs->data[0] = F0[p];
+    freqs->data[1] = F1[p];
+    PulsarAddREAL8VectorParam( pulsars[p], "F", freqs );
+    XLALDestroyREAL8Vector( freqs );
+    PulsarAddREAL8Param( pulsars[p], "PEPOCH", XLALGPSGetREAL8( &t0 ) - 86400 );
+    PulsarAddREAL8Param( pulsars[p], "RA", ra[p] );
+    PulsarAddREAL8Param( pulsars[p], "DEC", dec[p] );
+  }
+
+  /* simulate data, barycentring every sample */
+  const UINT4 length = (UINT4) round( Tdata / deltaT );
+  REAL8TimeSeries *data = XLALCreateREAL8TimeSeries( "data", &t0, 0, deltaT, &lalStrainUnit, length );
+  XLAL_CHECK_MAIN( data != NULL, XLAL_EFUNC );
+  LIGOTimeGPSVector *times = XLALCreateTimestampVector( length );
+  XLAL_CHECK_MAIN( times != NULL, XLAL_EFUNC );
+  for ( UINT4 i = 0; i < length; i++ ) {
+    times->data[i] = t0;
+    XLALGPSAdd( &times->data[i], i * deltaT );
+    data->data->data[i] = 0;
+  }
+  for ( UINT4 p = 0; p < NUM_PULSARS; p++ ) {
+    REAL8Vector *phis = XLALHeterodynedPulsarPhaseDifference( pulsars[p], NULL, times, freqFactor, NULL, 1, NULL, 0, NULL, 0, NULL, 0,
+                                                              det, edat, tdat, TIMECORRECTION_TEMPO );
+    XLAL_CHECK_MAIN( phis != NULL, XLAL_EFUNC );
+    for ( UINT4 i = 0; i < length; i++ ) {
+      /* phis is minus the signal phase */
+      data->data->data[i] += 2 * creal( amp[p] * cexp( -LAL_TWOPI * I * phis->data[i] ) );
+    }
+    XLALDestroyREAL8Vector( phis );
+  }
+  XLALDestroyTimestampVector( times );
+
+  /* heterodyne in one chunk, and in unevenly-sized chunks with several threads */
+  COMPLEX16 *out1[NUM_PULSARS], *out2[NUM_PULSARS];
+  UINT4 numOut1 = 0, numOut2 = 0;
+  LIGOTimeGPS epoch1, epoch2;
+  const UINT4 chunks[] = { 1000, 37, 50000, 128, 1, 12345, 127 };
+  XLAL_CHECK_MAIN( RunHeterodyne( out1, &numOut1, &epoch1, pulsars, det, edat, tdat, data, decimation, NULL, 0, 1 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( RunHeterodyne( out2, &numOut2, &epoch2, pulsars, det, edat, tdat, data, decimation, chunks, XLAL_NUM_ELEM( chunks ), 2 ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  /* output is the expected length, and starts after the filter half-length */
+  const UINT4 filterHalfLength = StreamingHeterodyneOptionalArgsDefaults.filterHalfLength;
+  XLAL_CHECK_MAIN( numOut1 == length / decimation - 2 * filterHalfLength, XLAL_EFAILED, "numOut1 = %u", numOut1 );
+  XLAL_CHECK_MAIN( numOut2 == numOut1, XLAL_EFAILED, "numOut2 = %u != numOut1 = %u", numOut2, numOut1 );
+  XLAL_CHECK_MAIN( XLALGPSDiff( &epoch1, &t0 ) == filterHalfLength * decimation * deltaT, XLAL_EFAILED );
+  XLAL_CHECK_MAIN( XLALGPSCmp( &epoch1, &epoch2 ) == 0, XLAL_EFAILED );
+
+  for ( UINT4 p = 0; p < NUM_PULSARS; p++ ) {
+    REAL8 maxErr = 0, maxDiff = 0;
+    for ( UINT4 m = 0; m < numOut1; m++ ) {
+      maxErr = fmax( maxErr, cabs( out1[p][m] - amp[p] ) / cabs( amp[p] ) );
+      maxDiff = fmax( maxDiff, cabs( out2[p][m] - out1[p][m] ) / cabs( amp[p] ) );
+    }
+    printf( "pulsar %u: maximum relative error = %.3e, maximum relative difference between chunkings = %.3e\n", p, maxErr, maxDiff );
+    XLAL_CHECK_MAIN( maxErr < 1e-4, XLAL_ETOL, "Pulsar %u: maximum relative error %g exceeds tolerance", p, maxErr );
+    XLAL_CHECK_MAIN( maxDiff < 1e-12, XLAL_ETOL, "Pulsar %u: output depends on chunking (maximum relative difference %g)", p, maxDiff );
+    XLALFree( out1[p] );
+    XLALFree( out2[p] );
+  }
+
+  /* cleanup */
+  for ( UINT4 p = 0; p < NUM_PULSARS; p++ ) {
+    PulsarFreeParams( pulsars[p] );
+  }
+  XLALDestroyREAL8TimeSeries( data );
+  XLALDestroyTimeCorrectionData( tdat );
+  XLALDestroyEphemerisData( edat );
+
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+
+}
+
+/* heterodyne data in chunks of the given lengths (cycled through), and concatenate the output */
+static int RunHeterodyne( COMPLEX16 **out, UINT4 *numOut, LIGOTimeGPS *outEpoch, PulsarParameters **pulsars, const LALDetector *det,
+                          const EphemerisData *edat, const TimeCorrectionData *tdat, const REAL8TimeSeries *data, UINT4 decimation,
+                          const UINT4 *chunks, UINT4 numChunks, UINT4 numThreads )
+{
+  StreamingHeterodyneOptionalArgs optArgs = StreamingHeterodyneOptionalArgsDefaults;
+  optArgs.numThreads = numThreads;
+  StreamingHeterodyne *het = XLALCreateStreamingHeterodyne( pulsars, NUM_PULSARS, det, edat, tdat, TIMECORRECTION_TEMPO, data->deltaT, decimation, &optArgs );
+  XLAL_CHECK( het != NULL, XLAL_EFUNC );
+
+  const UINT4 length = data->data->length;
+  for ( UINT4 p = 0; p < NUM_PULSARS; p++ ) {
+    XLAL_CHECK( ( out[p] = XLALCalloc( length / decimation, sizeof( out[p][0] ) ) ) != NULL, XLAL_ENOMEM );
+  }
+  *numOut = 0;
+
+  COMPLEX16TimeSeries *outputs[NUM_PULSARS] = { NULL };
+  UINT4 start = 0, c = 0;
+  while ( start < length ) {
+    UINT4 chunkLength = ( numChunks > 0 ) ? chunks[c++ % numChunks] : length;
+    if ( chunkLength > length - start ) {
+      chunkLength = length - start;
+    }
+    REAL8TimeSeries *chunk = XLALCutREAL8TimeSeries( data, start, chunkLength );
+    XLAL_CHECK( chunk != NULL, XLAL_EFUNC );
+    XLAL_CHECK( XLALStreamingHeterodyneProcess( het, outputs, chunk ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLALDestroyREAL8TimeSeries( chunk );
+    for ( UINT4 p = 0; p < NUM_PULSARS; p++ ) {
+      if ( *numOut == 0 && p == 0 ) {
+        *outEpoch = outputs[p]->epoch;
+      }
+      if ( outputs[p]->data->length > 0 ) {
+        memcpy( out[p] + *numOut, outputs[p]->data->data, outputs[p]->data->length * sizeof( out[p][0] ) );
+      }
+    }
+    *numOut += outputs[0]->data->length;
+    start += chunkLength;
+  }
+
+  for ( UINT4 p = 0; p < NUM_PULSARS; p++ ) {
+    XLALDestroyCOMPLEX16TimeSeries( outputs[p] );
+  }
+  XLALDestroyStreamingHeterodyne( het );
+
+  return XLAL_SUCCESS;
+}
@@ -0,0 +1,289 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+/**
+ * \file
+ * \brief Test for XLALStreamingSFTsProcess().
+ *
+ * Overlapping SFTs are created from noise in unevenly-sized chunks, and must equal those created by
+ * XLALMakeSFTsFromREAL8TimeSeries(), independently of the chunking, batch size, and number of threads. With the
+ * high-pass filter enabled, a sinusoid below the knee frequency must be suppressed while one above it is kept, and
+ * the output must still not depend on the chunking. A gap in the data must start a new segment of SFTs. SFTs
+ * written by a writer thread must equal those returned, and its write errors must be reported. The achieved
+ * throughput in SFTs/second per thread is printed.
+ */
+
+#include <math.h>
+#include <string.h>
+#include <complex.h>
+
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_randist.h>
+
+#include <lal/Date.h>
+#include <lal/TimeSeries.h>
+#include <lal/Units.h>
+#include <lal/LogPrintf.h>
+#include <lal/CWMakeFakeData.h>
+#include <lal/SFTfileIO.h>
+#include <lal/StreamingSFTs.h>
+
+static int RunStreamingSFTs( SFTVector **sfts, REAL8 *wallTime, const REAL8TimeSeries *data, REAL8 Tsft, const StreamingSFTsOptionalArgs *optArgs,
+                             const UINT4 *chunks, UINT4 numChunks );
+static REAL8 CompareSFTs( const SFTVector *sfts1, const SFTVector *sfts2, UINT4 binOffset );
+
+int main( void )
+{
+
+  const LIGOTimeGPS t0 = { 900000000, 0 };
+  const REAL8 deltaT = 1.0 / 256;
+  const REAL8 Tsft = 64;
+  const REAL8 Tdata = 20 * Tsft;
+  const REAL8 overlapFraction = 0.5;
+  const UINT4 chunks[] = { 10000, 37, 65537, 128, 1, 123457, 32768 };
+
+  /* simulate Gaussian noise */
+  const UINT4 length = (UINT4) round( Tdata / deltaT );
+  REAL8TimeSeries *data = XLALCreateREAL8TimeSeries( "H1:data", &t0, 0, deltaT, &lalStrainUnit, length );
+  XLAL_CHECK_MAIN( data != NULL, XLAL_EFUNC );
+  gsl_rng *rng = gsl_rng_alloc( gsl_rng_mt19937 );
+  XLAL_CHECK_MAIN( rng != NULL, XLAL_ENOMEM );
+  for ( UINT4 i = 0; i < length; i++ ) {
+    data->data->data[i] = gsl_ran_gaussian( rng, 1.0 );
+  }
+  gsl_rng_free( rng );
+
+  /* reference SFTs */
+  const REAL8 Tstep = ( 1.0 - overlapFraction ) * Tsft;
+  const UINT4 numSFTs = (UINT4) floor( ( Tdata - Tsft ) / Tstep ) + 1;
+  LIGOTimeGPSVector *timestamps = XLALCreateTimestampVector( numSFTs );
+  XLAL_CHECK_MAIN( timestamps != NULL, XLAL_EFUNC );
+  timestamps->deltaT = Tsft;
+  for ( UINT4 n = 0; n < numSFTs; n++ ) {
+    timestamps->data[n] = t0;
+    XLALGPSAdd( &timestamps->data[n], n * Tstep );
+  }
+  SFTVector *refSFTs = XLALMakeSFTsFromREAL8TimeSeries( data, timestamps, "tukey", 0.001 );
+  XLAL_CHECK_MAIN( refSFTs != NULL, XLAL_EFUNC );
+  XLALDestroyTimestampVector( timestamps );
+
+  /* streamed SFTs, without high-pass filter */
+  {
+    StreamingSFTsOptionalArgs optArgs = StreamingSFTsOptionalArgsDefaults;
+    optArgs.overlapFraction = overlapFraction;
+    optArgs.windowType = "tukey";
+    optArgs.windowBeta = 0.001;
+
+    SFTVector *sfts1 = NULL, *sfts2 = NULL, *sfts3 = NULL;
+    REAL8 wallTime1 = 0, wallTime2 = 0;
+    XLAL_CHECK_MAIN( RunStreamingSFTs( &sfts1, &wallTime1, data, Tsft, &optArgs, NULL, 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    optArgs.batchSize = 3;
+    optArgs.numThreads = 2;
+    XLAL_CHECK_MAIN( RunStreamingSFTs( &sfts2, &wallTime2, data, Tsft, &optArgs, chunks, XLAL_NUM_ELEM( chunks ) ) == XLAL_SUCCESS, XLAL_EFUNC );
+    optArgs.fMin = 10.3;
+    optArgs.Band = 20.1;
+    XLAL_CHECK_MAIN( RunStreamingSFTs( &sfts3, NULL, data, Tsft, &optArgs, chunks, XLAL_NUM_ELEM( chunks ) ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    XLAL_CHECK_MAIN( sfts1->length == numSFTs, XLAL_EFAILED, "sfts1->length = %u != numSFTs = %u", sfts1->length, numSFTs );
+    XLAL_CHECK_MAIN( sfts2->length == numSFTs, XLAL_EFAILED, "sfts2->length = %u != numSFTs = %u", sfts2->length, numSFTs );
+    const REAL8 err1 = CompareSFTs( sfts1, refSFTs, 0 );
+    const REAL8 err2 = CompareSFTs( sfts2, refSFTs, 0 );
+    printf( "no high-pass: maximum relative difference from reference SFTs = %.3e (one chunk), %.3e (uneven chunks, 2 threads)\n", err1, err2 );
+    XLAL_CHECK_MAIN( err1 < 1e-5, XLAL_ETOL, "SFTs differ from reference SFTs (maximum relative difference %g)", err1 );
+    XLAL_CHECK_MAIN( err2 < 1e-5, XLAL_ETOL, "SFTs differ from reference SFTs (maximum relative difference %g)", err2 );
+
+    /* band starts at bin round(fMin*Tsft) and covers the requested band */
+    XLAL_CHECK_MAIN( sfts3->length == numSFTs, XLAL_EFAILED );
+    const UINT4 firstBin = (UINT4) round( sfts3->data[0].f0 * Tsft );
+    XLAL_CHECK_MAIN( firstBin <= 10.3 * Tsft && ( firstBin + sfts3->data[0].data->length - 1 ) >= 30.4 * Tsft, XLAL_EFAILED,
+                     "SFT band [%g, %g] Hz does not cover requested band", sfts3->data[0].f0, sfts3->data[0].f0 + ( sfts3->data[0].data->length - 1 ) / Tsft );
+    const REAL8 err3 = CompareSFTs( sfts3, refSFTs, firstBin );
+    XLAL_CHECK_MAIN( err3 < 1e-5, XLAL_ETOL, "Band-limited SFTs differ from reference SFTs (maximum relative difference %g)", err3 );
+
+    printf( "throughput: %.1f SFTs/second per thread (1 thread), %.1f SFTs/second per thread (2 threads)\n",
+            numSFTs / wallTime1, numSFTs / wallTime2 / 2 );
+
+    XLALDestroySFTVector( sfts1 );
+    XLALDestroySFTVector( sfts2 );
+    XLALDestroySFTVector( sfts3 );
+  }
+
+  /* streamed SFTs, with high-pass filter, of data containing sinusoids below and above the knee frequency */
+  {
+    const REAL8 fLow = 2.0, fHigh = 50.0, fKnee = 10.0;
+    REAL8TimeSeries *sines = XLALCreateREAL8TimeSeries( "H1:sines", &t0, 0, deltaT, &lalStrainUnit, length );
+    XLAL_CHECK_MAIN( sines != NULL, XLAL_EFUNC );
+    for ( UINT4 i = 0; i < length; i++ ) {
+      sines->data->data[i] = sin( LAL_TWOPI * fLow * i * deltaT ) + sin( LAL_TWOPI * fHigh * i * deltaT );
+    }
+
+    StreamingSFTsOptionalArgs optArgs = StreamingSFTsOptionalArgsDefaults;
+    optArgs.overlapFraction = overlapFraction;
+    optArgs.highPassFreq = fKnee;
+    optArgs.highPassOrder = 8;
+    SFTVector *sfts1 = NULL, *sfts2 = NULL;
+    XLAL_CHECK_MAIN( RunStreamingSFTs( &sfts1, NULL, sines, Tsft, &optArgs, NULL, 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    optArgs.batchSize = 2;
+    optArgs.numThreads = 3;
+    XLAL_CHECK_MAIN( RunStreamingSFTs( &sfts2, NULL, sines, Tsft, &optArgs, chunks, XLAL_NUM_ELEM( chunks ) ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( sfts1->length == numSFTs && sfts2->length == numSFTs, XLAL_EFAILED );
+    const REAL8 diff = CompareSFTs( sfts2, sfts1, 0 );
+    XLAL_CHECK_MAIN( diff < 1e-10, XLAL_ETOL, "High-passed SFTs depend on chunking (maximum relative difference %g)", diff );
+
+    /* ignore first SFT, which contains the start-up transient of the filter */
+    const UINT4 binLow = (UINT4) round( fLow * Tsft ), binHigh = (UINT4) round( fHigh * Tsft );
+    const REAL8 unfiltered = 0.5 * Tsft;
+    REAL8 maxRatioLow = 0, minRatioHigh = 1;
+    for ( UINT4 n = 1; n < numSFTs; n++ ) {
+      maxRatioLow = fmax( maxRatioLow, cabs( sfts1->data[n].data->data[binLow] ) / unfiltered );
+      minRatioHigh = fmin( minRatioHigh, cabs( sfts1->data[n].data->data[binHigh] ) / unfiltered );
+    }
+    printf( "high-pass: amplitude at %g Hz = %.3e, at %g Hz = %.6f, relative to unfiltered\n", fLow, maxRatioLow, fHigh, minRatioHigh );
+    XLAL_CHECK_MAIN( maxRatioLow < 1e-4, XLAL_ETOL, "Sinusoid below knee frequency not suppressed (amplitude ratio %g)", maxRatioLow );
+    XLAL_CHECK_MAIN( minRatioHigh > 0.99, XLAL_ETOL, "Sinusoid above knee frequency not kept (amplitude ratio %g)", minRatioHigh );
+
+    XLALDestroySFTVector( sfts1 );
+    XLALDestroySFTVector( sfts2 );
+    XLALDestroyREAL8TimeSeries( sines );
+  }
+
+  /* a gap in the data starts a new segment of SFTs */
+  {
+    const UINT4 sftLength = (UINT4) round( Tsft / deltaT );
+    const UINT4 gapStart = 3 * sftLength + 100, gapEnd = 5 * sftLength + 12345;
+    StreamingSFTs *stream = XLALCreateStreamingSFTs( deltaT, Tsft, NULL );
+    XLAL_CHECK_MAIN( stream != NULL, XLAL_EFUNC );
+    SFTVector *sfts = NULL;
+    REAL8TimeSeries *chunk = XLALCutREAL8TimeSeries( data, 0, gapStart );
+    XLAL_CHECK_MAIN( chunk != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALStreamingSFTsProcess( stream, &sfts, chunk ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLALDestroyREAL8TimeSeries( chunk );
+    XLAL_CHECK_MAIN( sfts->length == 3, XLAL_EFAILED, "sfts->length = %u before gap", sfts->length );
+    chunk = XLALCutREAL8TimeSeries( data, gapEnd, length - gapEnd );
+    XLAL_CHECK_MAIN( chunk != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALStreamingSFTsProcess( stream, &sfts, chunk ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( sfts->length == ( length - gapEnd ) / sftLength, XLAL_EFAILED, "sfts->length = %u after gap", sfts->length );
+    XLAL_CHECK_MAIN( XLALGPSCmp( &sfts->data[0].epoch, &chunk->epoch ) == 0, XLAL_EFAILED, "First SFT after gap does not start at end of gap" );
+    XLALDestroyREAL8TimeSeries( chunk );
+    XLALDestroySFTVector( sfts );
+    XLALDestroyStreamingSFTs( stream );
+  }
+
+  /* SFTs written to files, by a writer thread if LAL was built with pthreads */
+  {
+    StreamingSFTsOptionalArgs optArgs = StreamingSFTsOptionalArgsDefaults;
+    optArgs.overlapFraction = overlapFraction;
+    optArgs.batchSize = 2;
+    optArgs.numThreads = 2;
+    optArgs.writeQueueLength = 3;
+    optArgs.outputDir = ".";
+    optArgs.Misc = "StreamingSFTsTest";
+    SFTVector *sfts = NULL;
+    XLAL_CHECK_MAIN( RunStreamingSFTs( &sfts, NULL, data, Tsft, &optArgs, chunks, XLAL_NUM_ELEM( chunks ) ) == XLAL_SUCCESS, XLAL_EFUNC );
+    SFTCatalog *catalog = XLALSFTdataFind( "./*_StreamingSFTsTest-*.sft", NULL );
+    XLAL_CHECK_MAIN( catalog != NULL, XLAL_EFUNC );
+    SFTVector *written = XLALLoadSFTs( catalog, -1, -1 );
+    XLAL_CHECK_MAIN( written != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( written->length == numSFTs && sfts->length == numSFTs, XLAL_EFAILED, "written->length = %u != numSFTs = %u", written->length, numSFTs );
+    const REAL8 diff = CompareSFTs( written, sfts, 0 );
+    XLAL_CHECK_MAIN( diff == 0, XLAL_ETOL, "Written SFTs differ from returned SFTs (maximum relative difference %g)", diff );
+    XLALDestroySFTVector( written );
+    XLALDestroySFTCatalog( catalog );
+    XLALDestroySFTVector( sfts );
+
+    /* a write error is returned either by XLALStreamingSFTsProcess(), or by XLALStreamingSFTsFlush() */
+    optArgs.outputDir = "no-such-directory";
+    StreamingSFTs *stream = XLALCreateStreamingSFTs( deltaT, Tsft, &optArgs );
+    XLAL_CHECK_MAIN( stream != NULL, XLAL_EFUNC );
+    int errnum = 0, retn = XLAL_SUCCESS;
+    XLAL_TRY_SILENT( retn = XLALStreamingSFTsProcess( stream, NULL, data ), errnum );
+    if ( retn == XLAL_SUCCESS ) {
+      XLAL_TRY_SILENT( retn = XLALStreamingSFTsFlush( stream ), errnum );
+    }
+    XLAL_CHECK_MAIN( retn != XLAL_SUCCESS && errnum != 0, XLAL_EFAILED, "Failure to write SFTs was not reported" );
+    XLALDestroyStreamingSFTs( stream );
+  }
+
+  /* cleanup */
+  XLALDestroySFTVector( refSFTs );
+  XLALDestroyREAL8TimeSeries( data );
+
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+
+}
+
+/* create SFTs from data in chunks of the given lengths (cycled through), and concatenate the output */
+static int RunStreamingSFTs( SFTVector **sfts, REAL8 *wallTime, const REAL8TimeSeries *data, REAL8 Tsft, const StreamingSFTsOptionalArgs *optArgs,
+                             const UINT4 *chunks, UINT4 numChunks )
+{
+  const REAL8 startTime = XLALGetTimeOfDay();
+
+  StreamingSFTs *stream = XLALCreateStreamingSFTs( data->deltaT, Tsft, optArgs );
+  XLAL_CHECK( stream != NULL, XLAL_EFUNC );
+
+  XLAL_CHECK( ( *sfts = XLALCalloc( 1, sizeof( **sfts ) ) ) != NULL, XLAL_ENOMEM );
+  SFTVector *output = NULL;
+  const UINT4 length = data->data->length;
+  UINT4 start = 0, c = 0;
+  while ( start < length ) {
+    UINT4 chunkLength = ( numChunks > 0 ) ? chunks[c++ % numChunks] : length;
+    if ( chunkLength > length - start ) {
+      chunkLength = length - start;
+    }
+    REAL8TimeSeries *chunk = XLALCutREAL8TimeSeries( data, start, chunkLength );
+    XLAL_CHECK( chunk != NULL, XLAL_EFUNC );
+    XLAL_CHECK( XLALStreamingSFTsProcess( stream, &output, chunk ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLALDestroyREAL8TimeSeries( chunk );
+    for ( UINT4 n = 0; n < output->length; n++ ) {
+      XLAL_CHECK( XLALAppendSFT2Vector( *sfts, &output->data[n] ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+    start += chunkLength;
+  }
+
+  XLAL_CHECK( XLALStreamingSFTsFlush( stream ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLALDestroySFTVector( output );
+  XLALDestroyStreamingSFTs( stream );
+
+  if ( wallTime != NULL ) {
+    *wallTime = XLALGetTimeOfDay() - startTime;
+  }
+
+  return XLAL_SUCCESS;
+}
+
+/* maximum difference between SFTs, relative to the RMS of the reference SFT; 'sfts1' may start at bin 'binOffset' of 'sfts2' */
+static REAL8 CompareSFTs( const SFTVector *sfts1, const SFTVector *sfts2, UINT4 binOffset )
+{
+  REAL8 maxDiff = 0;
+  for ( UINT4 n = 0; n < sfts1->length; n++ ) {
+    const SFTtype *sft1 = &sfts1->data[n], *sft2 = &sfts2->data[n];
+    if ( XLALGPSCmp( &sft1->epoch, &sft2->epoch ) != 0 || fabs( sft1->deltaF - sft2->deltaF ) > 1e-10 * sft2->deltaF ) {
+      return INFINITY;
+    }
+    REAL8 rms = 0;
+    for ( UINT4 k = 0; k < sft2->data->length; k++ ) {
+      rms += pow( cabs( sft2->data->data[k] ), 2 );
+    }
+    rms = sqrt( rms / sft2->data->length );
+    for ( UINT4 k = 0; k < sft1->data->length; k++ ) {
+      maxDiff = fmax( maxDiff, cabs( sft1->data->data[k] - sft2->data->data[k + binOffset] ) / rms );
+    }
+  }
+  return maxDiff;
+}
@@ -338,7 +338,7 @@ int main( void )
   {
     const LIGOTimeGPS ref_time = REF_TIME;
     const MultiLALDetector detectors = { .length = 1, .sites = { lalCachedDetectors[LAL_LLO_4K_DETECTOR] } };
-    metrics = XLALComputeSuperskyMetrics( SUPERSKY_METRIC_TYPE, 1, &ref_time, &segments, FIDUCIAL_FREQ, &detectors, NULL, DETMOTION_SPIN | DETMOTION_PTOLEORBIT, edat );
+    metrics = XLALComputeSuperskyMetrics( SUPERSKY_METRIC_TYPE, 1, &ref_time, &segments, FIDUCIAL_FREQ, &detectors, NULL, DETMOTION_SPIN | DETMOTION_PTOLEORBIT, edat, 0 );
   }
   XLAL_CHECK_MAIN( metrics != NULL, XLAL_EFUNC );
 
@@ -356,6 +356,22 @@ int main( void )
                      semi_phys_mismatch, 3e-2
                      ) == XLAL_SUCCESS, XLAL_EFUNC );
 
+  // Check that metrics computed with a single thread are the same
+  {
+    const LIGOTimeGPS ref_time = REF_TIME;
+    const MultiLALDetector detectors = { .length = 1, .sites = { lalCachedDetectors[LAL_LLO_4K_DETECTOR] } };
+    SuperskyMetrics *metrics_1thread = XLALComputeSuperskyMetrics( SUPERSKY_METRIC_TYPE, 1, &ref_time, &segments, FIDUCIAL_FREQ, &detectors, NULL, DETMOTION_SPIN | DETMOTION_PTOLEORBIT, edat, 1 );
+    XLAL_CHECK_MAIN( metrics_1thread != NULL, XLAL_EFUNC );
+    const double err_tol = 1e-12;
+    for ( size_t n = 0; n < NUM_SEGS; ++n ) {
+      const double err = XLALCompareMetrics( metrics_1thread->coh_rssky_metric[n], metrics->coh_rssky_metric[n] );
+      XLAL_CHECK_MAIN( err <= err_tol, XLAL_ETOL, "'coh_rssky_metric[%zu]' 1-thread check failed: err = %0.3e > %0.3e = err_tol", n, err, err_tol );
+    }
+    const double err = XLALCompareMetrics( metrics_1thread->semi_rssky_metric, metrics->semi_rssky_metric );
+    XLAL_CHECK_MAIN( err <= err_tol, XLAL_ETOL, "'semi_rssky_metric' 1-thread check failed: err = %0.3e > %0.3e = err_tol", err, err_tol );
+    XLALDestroySuperskyMetrics( metrics_1thread );
+  }
+
   // Check semicoherent metric after round-trip frequency rescaling
   XLAL_CHECK_MAIN( XLALScaleSuperskyMetricsFiducialFreq( metrics, 257.52 ) == XLAL_SUCCESS, XLAL_EFUNC );
   {
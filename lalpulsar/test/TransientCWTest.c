@@ -0,0 +1,205 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+/**
+ * \file
+ * \brief Test for XLALComputeTransientFstatMap().
+ *
+ * Transient F-statistic maps over {t0, tau} are computed from random F-statistic atoms of two detectors, one of
+ * which has a gap, for rectangular and exponential windows and for no window. They are compared against a reference
+ * map computed by explicitly summing the windowed atoms for every {t0, tau}, as XLALComputeTransientFstatMap() did
+ * before it used prefix sums and geometric series, and the loudest point must agree.
+ */
+
+#include <math.h>
+#include <stdlib.h>
+
+#include <gsl/gsl_math.h>
+
+#include <lal/LALComputeAM.h>
+#include <lal/ComputeFstat.h>
+#include <lal/TransientCW_utils.h>
+
+static transientFstatMap_t *ReferenceTransientFstatMap ( const MultiFstatAtomVector *multiFstatAtoms, transientWindowRange_t windowRange, BOOLEAN useFReg );
+
+int main( void )
+{
+
+  const UINT4 TAtom = 1800;
+  const UINT4 numAtoms = 240;
+  const UINT4 tStart = 900000000;
+  const REAL8 tolerance = 1e-5;
+
+  /* create random F-statistic atoms of two detectors, the second one with a gap */
+  srand ( 2718 );
+  MultiFstatAtomVector *multiAtoms = XLALCreateMultiFstatAtomVector ( 2 );
+  XLAL_CHECK_MAIN ( multiAtoms != NULL, XLAL_EFUNC );
+  for ( UINT4 X = 0; X < multiAtoms->length; ++X )
+    {
+      const UINT4 gapStart = ( X == 0 ) ? numAtoms : 100, gapLength = 30;
+      XLAL_CHECK_MAIN ( ( multiAtoms->data[X] = XLALCreateFstatAtomVector ( ( X == 0 ) ? numAtoms : numAtoms - gapLength ) ) != NULL, XLAL_EFUNC );
+      multiAtoms->data[X]->TAtom = TAtom;
+      for ( UINT4 i = 0, j = 0; i < numAtoms; ++i )
+        {
+          if ( i >= gapStart && i < gapStart + gapLength ) {
+            continue;
+          }
+          FstatAtom *atom = &multiAtoms->data[X]->data[j++];
+          const REAL4 a = 2.0 * rand() / RAND_MAX - 1.0, b = 2.0 * rand() / RAND_MAX - 1.0;
+          atom->timestamp = tStart + i * TAtom;
+          atom->a2_alpha = a * a;
+          atom->b2_alpha = b * b;
+          atom->ab_alpha = a * b;
+          atom->Fa_alpha = crectf ( 2.0 * rand() / RAND_MAX - 1.0, 2.0 * rand() / RAND_MAX - 1.0 ) * 50;
+          atom->Fb_alpha = crectf ( 2.0 * rand() / RAND_MAX - 1.0, 2.0 * rand() / RAND_MAX - 1.0 ) * 50;
+        }
+    }
+
+  /* compare transient F-statistic maps for different window types */
+  const transientWindowType_t windowTypes[] = { TRANSIENT_RECTANGULAR, TRANSIENT_EXPONENTIAL, TRANSIENT_NONE };
+  for ( UINT4 w = 0; w < XLAL_NUM_ELEM( windowTypes ); ++w )
+    {
+      for ( UINT4 useFReg = 0; useFReg <= 1; ++useFReg )
+        {
+          transientWindowRange_t XLAL_INIT_DECL( windowRange );
+          windowRange.type = windowTypes[w];
+          windowRange.t0 = tStart + 3 * TAtom;
+          windowRange.t0Band = 100 * TAtom;
+          windowRange.dt0 = 2 * TAtom;
+          windowRange.tau = 2 * TAtom;
+          windowRange.tauBand = 120 * TAtom;
+          windowRange.dtau = 5 * TAtom;
+
+          transientFstatMap_t *FstatMap = XLALComputeTransientFstatMap ( multiAtoms, windowRange, useFReg );
+          XLAL_CHECK_MAIN ( FstatMap != NULL, XLAL_EFUNC );
+          transientFstatMap_t *refFstatMap = ReferenceTransientFstatMap ( multiAtoms, windowRange, useFReg );
+          XLAL_CHECK_MAIN ( refFstatMap != NULL, XLAL_EFUNC );
+
+          XLAL_CHECK_MAIN ( FstatMap->F_mn->size1 == refFstatMap->F_mn->size1 && FstatMap->F_mn->size2 == refFstatMap->F_mn->size2, XLAL_EFAILED );
+          REAL8 maxErr = 0;
+          for ( size_t m = 0; m < FstatMap->F_mn->size1; ++m )
+            {
+              for ( size_t n = 0; n < FstatMap->F_mn->size2; ++n )
+                {
+                  const REAL8 F = gsl_matrix_get ( FstatMap->F_mn, m, n ), refF = gsl_matrix_get ( refFstatMap->F_mn, m, n );
+                  const REAL8 err = fabs ( F - refF ) / fmax ( 1.0, fabs ( refF ) );
+                  if ( err > maxErr ) {
+                    maxErr = err;
+                  }
+                }
+            }
+          printf ( "window type %d, useFReg=%d: %zu x %zu map, max. relative error = %.3g, maxF = %g (reference %g) at t0 = %u, tau = %u\n",
+                   windowTypes[w], useFReg, FstatMap->F_mn->size1, FstatMap->F_mn->size2, maxErr, FstatMap->maxF, refFstatMap->maxF, FstatMap->t0_ML, FstatMap->tau_ML );
+          XLAL_CHECK_MAIN ( maxErr <= tolerance, XLAL_ETOL, "Transient F-statistic map differs from reference by %g > %g", maxErr, tolerance );
+          XLAL_CHECK_MAIN ( fabs ( FstatMap->maxF - refFstatMap->maxF ) <= tolerance * refFstatMap->maxF, XLAL_ETOL );
+          XLAL_CHECK_MAIN ( FstatMap->t0_ML == refFstatMap->t0_ML && FstatMap->tau_ML == refFstatMap->tau_ML, XLAL_ETOL,
+                            "Loudest point {t0=%u, tau=%u} differs from reference {t0=%u, tau=%u}", FstatMap->t0_ML, FstatMap->tau_ML, refFstatMap->t0_ML, refFstatMap->tau_ML );
+
+          XLALDestroyTransientFstatMap ( FstatMap );
+          XLALDestroyTransientFstatMap ( refFstatMap );
+        }
+    }
+
+  /* cleanup */
+  XLALDestroyMultiFstatAtomVector ( multiAtoms );
+  XLALDestroyExpLUT();
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+
+}
+
+/* Compute the transient F-statistic map by summing the windowed atoms for every {t0, tau} */
+static transientFstatMap_t *ReferenceTransientFstatMap ( const MultiFstatAtomVector *multiFstatAtoms, transientWindowRange_t windowRange, BOOLEAN useFReg )
+{
+
+  const UINT4 TAtom = multiFstatAtoms->data[0]->TAtom;
+  FstatAtomVector *atoms = XLALmergeMultiFstatAtomsBinned ( multiFstatAtoms, TAtom );
+  XLAL_CHECK_NULL ( atoms != NULL, XLAL_EFUNC );
+  const UINT4 numAtoms = atoms->length;
+  const UINT4 t0_data = atoms->data[0].timestamp;
+
+  if ( windowRange.type == TRANSIENT_NONE ) {
+    windowRange.type = TRANSIENT_RECTANGULAR;
+    windowRange.t0 = t0_data;
+    windowRange.t0Band = 0;
+    windowRange.dt0 = TAtom;
+    windowRange.tau = numAtoms * TAtom;
+    windowRange.tauBand = 0;
+    windowRange.dtau = TAtom;
+  }
+
+  const UINT4 N_t0Range = ( UINT4 ) floor ( windowRange.t0Band / windowRange.dt0 ) + 1;
+  const UINT4 N_tauRange = ( UINT4 ) floor ( windowRange.tauBand / windowRange.dtau ) + 1;
+  transientFstatMap_t *ret = XLALCalloc ( 1, sizeof( *ret ) );
+  XLAL_CHECK_NULL ( ret != NULL, XLAL_ENOMEM );
+  XLAL_CHECK_NULL ( ( ret->F_mn = gsl_matrix_calloc ( N_t0Range, N_tauRange ) ) != NULL, XLAL_ENOMEM );
+
+  ret->maxF = -1.0;
+  for ( UINT4 m = 0; m < N_t0Range; ++m )
+    {
+      for ( UINT4 n = 0; n < N_tauRange; ++n )
+        {
+          transientWindow_t win;
+          win.type = windowRange.type;
+          win.t0 = windowRange.t0 + m * windowRange.dt0;
+          win.tau = windowRange.tau + n * windowRange.dtau;
+          UINT4 t0, t1;
+          XLAL_CHECK_NULL ( XLALGetTransientWindowTimespan ( &t0, &t1, win ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+          /* atoms-indices [i_t0, i_t1] spanning this window */
+          INT4 i_tmp = ( win.t0 - t0_data + TAtom / 2 ) / TAtom;
+          const UINT4 i_t0 = ( i_tmp < 0 ) ? 0 : GSL_MIN ( ( UINT4 ) i_tmp, numAtoms - 1 );
+          i_tmp = ( t1 - t0_data + TAtom / 2 ) / TAtom - 1;
+          const UINT4 i_t1 = ( i_tmp < 0 ) ? 0 : GSL_MIN ( ( UINT4 ) i_tmp, numAtoms - 1 );
+
+          /* sum windowed atoms, with exact exponential window values */
+          REAL8 Ad = 0, Bd = 0, Cd = 0;
+          COMPLEX16 Fa = 0, Fb = 0;
+          for ( UINT4 i = i_t0; i <= i_t1; ++i )
+            {
+              const FstatAtom *atom = &atoms->data[i];
+              REAL8 win_i = 1.0;
+              if ( win.type == TRANSIENT_EXPONENTIAL ) {
+                win_i = ( atom->timestamp < t0 || atom->timestamp > t1 ) ? 0.0 : exp ( - 1.0 * ( atom->timestamp - t0 ) / win.tau );
+              }
+              Ad += atom->a2_alpha * win_i * win_i;
+              Bd += atom->b2_alpha * win_i * win_i;
+              Cd += atom->ab_alpha * win_i * win_i;
+              Fa += atom->Fa_alpha * win_i;
+              Fb += atom->Fb_alpha * win_i;
+            }
+
+          const REAL4 DdInv = 1.0f / XLALComputeAntennaPatternSqrtDeterminant ( Ad, Bd, Cd, 0 );
+          REAL4 F = 0.5 * XLALComputeFstatFromFaFb ( Fa, Fb, Ad, Bd, Cd, 0, DdInv );
+          if ( F > ret->maxF ) {
+            ret->maxF = F;
+            ret->t0_ML = win.t0;
+            ret->tau_ML = win.tau;
+          }
+          if ( useFReg ) {
+            F += log ( DdInv );
+          }
+          gsl_matrix_set ( ret->F_mn, m, n, F );
+        }
+    }
+
+  XLALDestroyFstatAtomVector ( atoms );
+
+  return ret;
+
+}
@@ -20,6 +20,7 @@
  */
 
 #include <math.h>
+#include <string.h>
 #include <sys/times.h>
 
 #include <lal/LALMalloc.h>
@@ -507,6 +508,76 @@ test_XLALComputeDopplerMetrics ( void )
   } // end: Round 6 + 7 (binary orbital metrics)
 
 
+  XLALPrintWarning("\n---------- ROUND 8: multi-IFO, per-segment phase metrics from XLALComputeDopplerPhaseMetricSegments() ----------\n");
+  {
+    const REAL8 tolSeg = 1e-5;		// limited by accuracy of adaptive quadrature in XLALComputeDopplerPhaseMetric()
+    const REAL8 tolSegStep = 1e-7;	// convergence of Simpson's rule in XLALComputeDopplerPhaseMetricSegments()
+    DopplerMetricParams pars2 = master_pars2;
+
+    const UINT4 Nseg = 5;
+    LALSegList XLAL_INIT_DECL(NsegList);
+    ret = XLALSegListInitSimpleSegments ( &NsegList, startTimeGPS, Nseg, Tseg );
+    XLAL_CHECK ( ret == XLAL_SUCCESS, XLAL_EFUNC, "XLALSegListInitSimpleSegments() failed with xlalErrno = %d\n", xlalErrno );
+    pars2.segmentList = NsegList;
+
+    // 1) compute per-segment metrics in one pass, with 2 threads if available
+    gsl_matrix *g_ij_seg[Nseg];
+    memset ( g_ij_seg, 0, sizeof(g_ij_seg) );
+    XLAL_CHECK ( XLALComputeDopplerPhaseMetricSegments ( g_ij_seg, &pars2, edat, 0, 2 ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    // 2) check convergence by comparing against per-segment metrics computed with a quarter of the default sampling step
+    {
+      gsl_matrix *g_ij_seg_fine[Nseg];
+      memset ( g_ij_seg_fine, 0, sizeof(g_ij_seg_fine) );
+      XLAL_CHECK ( XLALComputeDopplerPhaseMetricSegments ( g_ij_seg_fine, &pars2, edat, 75, 1 ) == XLAL_SUCCESS, XLAL_EFUNC );
+      for ( UINT4 k = 0; k < Nseg; ++k ) {
+        REAL8 diff_step;
+        XLAL_CHECK ( (diff_step = XLALCompareMetrics ( g_ij_seg[k], g_ij_seg_fine[k] )) < tolSegStep, XLAL_ETOL, "Error(gSeg,gSegFine)= %g exceeds tolerance of %g (segment %u)\n", diff_step, tolSegStep, k );
+        XLALPrintWarning ("diff_step[%u] = %e\n", k, diff_step );
+        gsl_matrix_free ( g_ij_seg_fine[k] );
+      }
+    }
+
+    // 3) compare first segment against XLALComputeDopplerPhaseMetric() for that segment alone
+    {
+      DopplerMetricParams pars2_0 = pars2;
+      LALSegList XLAL_INIT_DECL(segList_0);
+      ret = XLALSegListInitSimpleSegments ( &segList_0, startTimeGPS, 1, Tseg );
+      XLAL_CHECK ( ret == XLAL_SUCCESS, XLAL_EFUNC );
+      pars2_0.segmentList = segList_0;
+      DopplerPhaseMetric *metric2P_0;
+      XLAL_CHECK ( (metric2P_0 = XLALComputeDopplerPhaseMetric ( &pars2_0, edat )) != NULL, XLAL_EFUNC );
+      REAL8 diff_0;
+      XLAL_CHECK ( (diff_0 = XLALCompareMetrics ( g_ij_seg[0], metric2P_0->g_ij )) < tolSeg, XLAL_ETOL, "Error(gSeg,g2)= %g exceeds tolerance of %g\n", diff_0, tolSeg );
+      XLALPrintWarning ("diff_0 = %e\n", diff_0 );
+      XLALDestroyDopplerPhaseMetric ( metric2P_0 );
+      XLALSegListClear ( &segList_0 );
+    }
+
+    // 4) compare average of per-segment metrics against segment-averaged XLALComputeDopplerPhaseMetric()
+    {
+      DopplerPhaseMetric *metric2P;
+      XLAL_CHECK ( (metric2P = XLALComputeDopplerPhaseMetric ( &pars2, edat )) != NULL, XLAL_EFUNC );
+      gsl_matrix *g_ij_avg = gsl_matrix_calloc ( coordSys.dim, coordSys.dim );
+      XLAL_CHECK ( g_ij_avg != NULL, XLAL_ENOMEM );
+      for ( UINT4 k = 0; k < Nseg; ++k ) {
+        gsl_matrix_add ( g_ij_avg, g_ij_seg[k] );
+      }
+      gsl_matrix_scale ( g_ij_avg, 1.0 / Nseg );
+      REAL8 diff_avg;
+      XLAL_CHECK ( (diff_avg = XLALCompareMetrics ( g_ij_avg, metric2P->g_ij )) < tolSeg, XLAL_ETOL, "Error(gAvg,g2)= %g exceeds tolerance of %g\n", diff_avg, tolSeg );
+      XLALPrintWarning ("diff_avg = %e\n", diff_avg );
+      gsl_matrix_free ( g_ij_avg );
+      XLALDestroyDopplerPhaseMetric ( metric2P );
+    }
+
+    for ( UINT4 k = 0; k < Nseg; ++k ) {
+      gsl_matrix_free ( g_ij_seg[k] );
+    }
+    XLALSegListClear ( &NsegList );
+  }
+
+
   // ----- clean up memory
   XLALSegListClear ( &segList );
   XLALDestroyEphemerisData ( edat );
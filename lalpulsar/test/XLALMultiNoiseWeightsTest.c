@@ -34,6 +34,10 @@
  * PSDs are calculated using the test SFTs created for
  * SFTfileIOTest.c
  *
+ * Also checks that XLALNormalizeMultiSFTVectAndNoiseWeights() returns identical normalized SFTs,
+ * PSDs and weights to XLALNormalizeMultiSFTVect() followed by XLALComputeMultiNoiseWeights(),
+ * with and without multiple threads.
+ *
  */
 
 /*---------- macros ---------- */
@@ -41,6 +45,7 @@
 
 /* ----- internal prototypes ---------- */
 int XLALCompareMultiNoiseWeights ( MultiNoiseWeights *multiWeights1, MultiNoiseWeights *multiWeights2, REAL8 tolerance );
+int XLALCompareMultiSFTAndPSDVectors ( const MultiSFTVector *multiSFTs1, const MultiPSDVector *multiPSDs1, const MultiSFTVector *multiSFTs2, const MultiPSDVector *multiPSDs2 );
 
 /* ----- function definitions ---------- */
 int
@@ -87,6 +92,26 @@ main (  void )
   /* Compare XLAL weights to reference */
   XLAL_CHECK ( XLALCompareMultiNoiseWeights ( multiWeightsXLAL, multiWeightsCorrect, tolerance ) == XLAL_SUCCESS, XLAL_EFAILED, "Comparison between XLAL and reference MultiNoiseWeights failed\n" );
 
+  /* Normalize the SFTs and get weights in a single pass, using different numbers of threads, with and without returning PSDs */
+  const UINT4 numThreadsTest[] = { 1, 3, 0 };
+  const BOOLEAN returnPSDsTest[] = { 1, 0, 1 };
+  for ( UINT4 i = 0; i < XLAL_NUM_ELEM( numThreadsTest ); i++ )
+    {
+      MultiSFTVector *multiSFTs2 = NULL;
+      MultiPSDVector *multiPSDs2 = NULL;
+      MultiNoiseWeights *multiWeights2 = NULL;
+      REAL8 wallTime = 0;
+      XLAL_CHECK ( ( multiSFTs2 = XLALLoadMultiSFTs ( catalog, -1, -1 ) ) != NULL, XLAL_EFUNC, " XLALLoadMultiSFTs failed\n" );
+      XLAL_CHECK ( XLALNormalizeMultiSFTVectAndNoiseWeights ( returnPSDsTest[i] ? &multiPSDs2 : NULL, &multiWeights2, multiSFTs2, rngmedBins, NULL, 0, numThreadsTest[i], &wallTime ) == XLAL_SUCCESS,
+                   XLAL_EFUNC, " XLALNormalizeMultiSFTVectAndNoiseWeights failed\n" );
+      XLALPrintInfo ( "XLALNormalizeMultiSFTVectAndNoiseWeights(numThreads=%d) took %g s\n", numThreadsTest[i], wallTime );
+      XLAL_CHECK ( XLALCompareMultiSFTAndPSDVectors ( multiSFTs, multiPSDs, multiSFTs2, multiPSDs2 ) == XLAL_SUCCESS, XLAL_EFAILED, "Comparison of normalized SFTs and PSDs with numThreads=%d failed\n", numThreadsTest[i] );
+      XLAL_CHECK ( XLALCompareMultiNoiseWeights ( multiWeights2, multiWeightsXLAL, 0 ) == XLAL_SUCCESS, XLAL_EFAILED, "Comparison of MultiNoiseWeights with numThreads=%d failed\n", numThreadsTest[i] );
+      XLALDestroyMultiNoiseWeights ( multiWeights2 );
+      XLALDestroyMultiPSDVector ( multiPSDs2 );
+      XLALDestroyMultiSFTVector ( multiSFTs2 );
+    }
+
   /* Clean up memory */
   XLALDestroyMultiNoiseWeights ( multiWeightsCorrect );
   XLALDestroyMultiNoiseWeights ( multiWeightsXLAL );
@@ -132,3 +157,38 @@ XLALCompareMultiNoiseWeights ( MultiNoiseWeights *multiWeights1, MultiNoiseWeigh
   return XLAL_SUCCESS;
 
 } /* XLALCompareMultiNoiseWeights() */
+
+/**
+ * Comparison function for two sets of normalized SFTs and (optional) PSDs, which must be identical.
+ *
+ */
+int
+XLALCompareMultiSFTAndPSDVectors ( const MultiSFTVector *multiSFTs1, const MultiPSDVector *multiPSDs1, const MultiSFTVector *multiSFTs2, const MultiPSDVector *multiPSDs2 )
+{
+
+  XLAL_CHECK( multiSFTs1->length == multiSFTs2->length, XLAL_EFAILED, "%s: numbers of detectors differ multiSFTs1 = %d, multiSFTs2 = %d\n", __func__, multiSFTs1->length, multiSFTs2->length );
+  UINT4 numIFOs = multiSFTs1->length;
+  for ( UINT4 X = 0; X < numIFOs; X++)
+    {
+      XLAL_CHECK( multiSFTs1->data[X]->length == multiSFTs2->data[X]->length, XLAL_EFAILED, "%s: numbers of SFTs for detector %d differ\n", __func__, X );
+      UINT4 numSFTs = multiSFTs1->data[X]->length;
+
+      for ( UINT4 alpha = 0; alpha < numSFTs; alpha++)
+	{
+	  const COMPLEX8Vector *sft1 = multiSFTs1->data[X]->data[alpha].data;
+	  const COMPLEX8Vector *sft2 = multiSFTs2->data[X]->data[alpha].data;
+	  XLAL_CHECK ( sft1->length == sft2->length && memcmp ( sft1->data, sft2->data, sft1->length * sizeof(sft1->data[0]) ) == 0, XLAL_EFAILED,
+		       "%s: normalized SFTs for IFO %d, SFT %d differ\n", __func__, X, alpha );
+	  if ( multiPSDs2 != NULL )
+	    {
+	      const REAL8Vector *psd1 = multiPSDs1->data[X]->data[alpha].data;
+	      const REAL8Vector *psd2 = multiPSDs2->data[X]->data[alpha].data;
+	      XLAL_CHECK ( psd1->length == psd2->length && memcmp ( psd1->data, psd2->data, psd1->length * sizeof(psd1->data[0]) ) == 0, XLAL_EFAILED,
+			   "%s: PSDs for IFO %d, SFT %d differ\n", __func__, X, alpha );
+	    }
+	}
+    }
+
+  return XLAL_SUCCESS;
+
+} /* XLALCompareMultiSFTAndPSDVectors() */